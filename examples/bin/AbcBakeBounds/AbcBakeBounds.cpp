@@ -0,0 +1,128 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// abcbakebounds computes the bounds of every object of an archive, at every
+// time its xforms or geometry are sampled, spread across threads, and
+// writes them to a bounds only sidecar archive which mirrors its hierarchy.
+
+#include <Alembic/AbcCoreFactory/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcGeom/All.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace Abc  = ::Alembic::Abc;
+namespace AbcF = ::Alembic::AbcCoreFactory;
+namespace AbcG = ::Alembic::AbcGeom;
+namespace AbcO = ::Alembic::AbcCoreOgawa;
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string desc(
+    "abcbakebounds [OPTION] inFile.abc outFile.abc\n"
+    "Writes the bounds of every object of inFile.abc, and of its descendants,\n"
+    "at every time inFile.abc is sampled, into outFile.abc, an Ogawa archive\n"
+    "with the same hierarchy and only bounds in it.\n"
+    "\n"
+    "  -threads N   bake with N threads, 4 by default\n"
+    "  -h, --help   show this help message\n"
+    );
+
+    AbcG::BakeBoundsOptions options;
+    std::vector< std::string > files;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+
+        if ( arg == "-h" || arg == "--help" )
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+        else if ( arg == "-threads" && i + 1 < argc )
+        {
+            int numThreads = atoi( argv[++i] );
+            if ( numThreads < 1 )
+            {
+                std::cerr << "-threads needs a number above 0" << std::endl;
+                return 1;
+            }
+            options.numThreads = numThreads;
+        }
+        else if ( !arg.empty() && arg[0] == '-' )
+        {
+            std::cerr << "Unknown option: " << arg << std::endl << std::endl
+                      << desc << std::endl;
+            return 1;
+        }
+        else
+        {
+            files.push_back( arg );
+        }
+    }
+
+    if ( files.size() != 2 )
+    {
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        // a stream for each thread so they don't wait on each other
+        AbcF::IFactory factory;
+        factory.setOgawaNumStreams( options.numThreads );
+        Abc::IArchive archive = factory.getArchive( files[0] );
+        if ( !archive.valid() )
+        {
+            std::cerr << "Could not open: " << files[0] << std::endl;
+            return 1;
+        }
+
+        Abc::OArchive sidecar( AbcO::WriteArchive(), files[1] );
+        AbcG::BakeBounds( archive, sidecar, options );
+    }
+    catch ( std::exception & e )
+    {
+        std::cerr << "abcbakebounds failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,1170 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+// abcbench writes a set of synthetic archives with each core and then times
+// a fixed set of read and write workloads against them.  Every workload
+// reports per operation latency percentiles, throughput and the number of
+// heap allocations made per operation, so that runs before and after a change
+// can be compared directly.
+
+#include <Alembic/AbcGeom/All.h>
+#include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcCoreFactory/All.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#ifndef _MSC_VER
+#include <sys/time.h>
+#endif
+
+namespace Abc  = ::Alembic::Abc;
+namespace AbcA = ::Alembic::AbcCoreAbstract;
+namespace AbcF = ::Alembic::AbcCoreFactory;
+namespace AbcG = ::Alembic::AbcGeom;
+namespace AbcU = ::Alembic::Util;
+
+using AbcA::index_t;
+
+//-*****************************************************************************
+// Allocation counting.
+// Every operator new in the process goes through here so that the number of
+// heap allocations made by a workload can be reported per operation.
+//-*****************************************************************************
+
+static volatile long g_numAllocs = 0;
+
+#if __cplusplus >= 201103L
+#define ABCBENCH_NEW_THROW
+#define ABCBENCH_DELETE_THROW noexcept
+#else
+#define ABCBENCH_NEW_THROW throw( std::bad_alloc )
+#define ABCBENCH_DELETE_THROW throw()
+#endif
+
+static void countAlloc()
+{
+#ifdef _MSC_VER
+    InterlockedIncrement( &g_numAllocs );
+#else
+    __sync_fetch_and_add( &g_numAllocs, 1 );
+#endif
+}
+
+static long getNumAllocs()
+{
+#ifdef _MSC_VER
+    return InterlockedCompareExchange( &g_numAllocs, 0, 0 );
+#else
+    return __sync_fetch_and_add( &g_numAllocs, 0 );
+#endif
+}
+
+void * operator new( std::size_t iSize ) ABCBENCH_NEW_THROW
+{
+    countAlloc();
+    void * p = malloc( iSize ? iSize : 1 );
+    if ( !p ) { throw std::bad_alloc(); }
+    return p;
+}
+
+void * operator new[]( std::size_t iSize ) ABCBENCH_NEW_THROW
+{
+    countAlloc();
+    void * p = malloc( iSize ? iSize : 1 );
+    if ( !p ) { throw std::bad_alloc(); }
+    return p;
+}
+
+void operator delete( void * iPtr ) ABCBENCH_DELETE_THROW
+{
+    free( iPtr );
+}
+
+void operator delete[]( void * iPtr ) ABCBENCH_DELETE_THROW
+{
+    free( iPtr );
+}
+
+//-*****************************************************************************
+// Timing and threads
+//-*****************************************************************************
+
+static double getTimeSec()
+{
+#ifdef _MSC_VER
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency( &freq );
+    QueryPerformanceCounter( &count );
+    return ( double ) count.QuadPart / ( double ) freq.QuadPart;
+#else
+    timeval t;
+    gettimeofday( &t, 0 );
+    return ( double ) t.tv_sec + ( double ) t.tv_usec / 1000000.0;
+#endif
+}
+
+typedef void ( *ThreadFunc )( void * );
+
+struct ThreadStart
+{
+    ThreadFunc func;
+    void * data;
+};
+
+static void * threadEntry( void * iData )
+{
+    ThreadStart * start = ( ThreadStart * ) iData;
+    start->func( start->data );
+    return 0;
+}
+
+// runs iFunc once per entry in iData, each on its own thread, and waits for
+// all of them to finish
+template <class T>
+void runThreads( ThreadFunc iFunc, std::vector<T> & iData )
+{
+    std::vector<ThreadStart> starts( iData.size() );
+    std::vector<Alembic::Util::thread *> threads( iData.size() );
+
+    for ( std::size_t i = 0; i < iData.size(); ++i )
+    {
+        starts[i].func = iFunc;
+        starts[i].data = &iData[i];
+        threads[i] = new Alembic::Util::thread( threadEntry, &starts[i] );
+    }
+
+    for ( std::size_t i = 0; i < iData.size(); ++i )
+    {
+        if ( threads[i]->valid() )
+        {
+            threads[i]->join();
+        }
+        else
+        {
+            // couldn't start it, so do its share here
+            threadEntry( &starts[i] );
+        }
+        delete threads[i];
+    }
+}
+
+//-*****************************************************************************
+// Results
+//-*****************************************************************************
+
+struct Result
+{
+    Result() : threads( 1 ), wallTime( 0.0 ), bytes( 0 ), allocs( 0 ) {}
+
+    std::string core;
+    std::string scenario;
+    std::string workload;
+    int threads;
+
+    // seconds per operation
+    std::vector<double> latencies;
+    double wallTime;
+    AbcU::uint64_t bytes;
+    long allocs;
+};
+
+static double percentile( const std::vector<double> & iSorted, double iPct )
+{
+    if ( iSorted.empty() )
+    {
+        return 0.0;
+    }
+
+    std::size_t idx = ( std::size_t )( iPct * ( iSorted.size() - 1 ) + 0.5 );
+    return iSorted[ std::min( idx, iSorted.size() - 1 ) ];
+}
+
+static void printHeader()
+{
+    printf( "%-6s %-10s %-9s %3s %8s %10s %10s %10s %10s %9s %10s\n",
+            "core", "scenario", "workload", "thr", "ops", "p50(us)",
+            "p90(us)", "p99(us)", "max(us)", "MB/s", "allocs/op" );
+}
+
+static void printResult( Result & ioResult )
+{
+    std::vector<double> & lat = ioResult.latencies;
+    std::sort( lat.begin(), lat.end() );
+
+    double mbs = 0.0;
+    if ( ioResult.wallTime > 0.0 )
+    {
+        mbs = ( ( double ) ioResult.bytes / ( 1024.0 * 1024.0 ) ) /
+            ioResult.wallTime;
+    }
+
+    double allocsPerOp = 0.0;
+    if ( !lat.empty() )
+    {
+        allocsPerOp = ( double ) ioResult.allocs / ( double ) lat.size();
+    }
+
+    printf( "%-6s %-10s %-9s %3d %8lu %10.1f %10.1f %10.1f %10.1f %9.1f %10.1f\n",
+            ioResult.core.c_str(), ioResult.scenario.c_str(),
+            ioResult.workload.c_str(), ioResult.threads,
+            ( unsigned long ) lat.size(),
+            percentile( lat, 0.5 ) * 1e6, percentile( lat, 0.9 ) * 1e6,
+            percentile( lat, 0.99 ) * 1e6,
+            ( lat.empty() ? 0.0 : lat.back() * 1e6 ), mbs, allocsPerOp );
+    fflush( stdout );
+}
+
+//-*****************************************************************************
+// Synthetic scenarios
+// Each scenario builds its hierarchy in setup() and then writes one frame of
+// animated data per call to writeFrame(), so that the write workload can time
+// every frame on its own.
+//-*****************************************************************************
+
+class Scenario
+{
+public:
+    Scenario( int iScale ) : m_scale( iScale ) {}
+    virtual ~Scenario() {}
+
+    virtual const char * name() const = 0;
+    virtual std::size_t numFrames() const { return 24; }
+
+    virtual void setup( Abc::OArchive & iArchive ) = 0;
+
+    // returns the number of sample bytes handed to the library
+    virtual AbcU::uint64_t writeFrame( std::size_t iFrame ) = 0;
+
+    // drops every writer so the archive can be closed
+    virtual void teardown() = 0;
+
+protected:
+    AbcU::uint32_t addUniformTime( Abc::OArchive & iArchive )
+    {
+        AbcA::TimeSampling ts( 1.0 / 24.0, 0.0 );
+        return iArchive.addTimeSampling( ts );
+    }
+
+    int m_scale;
+};
+
+//-*****************************************************************************
+// a single chain of animated transforms
+class DeepScenario : public Scenario
+{
+public:
+    DeepScenario( int iScale ) : Scenario( iScale ) {}
+
+    const char * name() const { return "deep"; }
+
+    void setup( Abc::OArchive & iArchive )
+    {
+        AbcU::uint32_t tsIdx = addUniformTime( iArchive );
+        Abc::OObject parent = iArchive.getTop();
+        for ( int i = 0; i < 64 * m_scale; ++i )
+        {
+            std::ostringstream strm;
+            strm << "xform" << i;
+            AbcG::OXform xform( parent, strm.str(), tsIdx );
+            m_xforms.push_back( xform );
+            parent = xform;
+        }
+    }
+
+    AbcU::uint64_t writeFrame( std::size_t iFrame )
+    {
+        AbcG::XformSample samp;
+        samp.setTranslation( Abc::V3d( 0.0, 1.0, 0.1 * iFrame ) );
+        samp.setRotation( Abc::V3d( 0.0, 1.0, 0.0 ), 2.0 * iFrame );
+        for ( std::size_t i = 0; i < m_xforms.size(); ++i )
+        {
+            m_xforms[i].getSchema().set( samp );
+        }
+
+        return m_xforms.size() * 2 * sizeof( Abc::V3d );
+    }
+
+    void teardown() { m_xforms.clear(); }
+
+private:
+    std::vector<AbcG::OXform> m_xforms;
+};
+
+//-*****************************************************************************
+// builds a iRes x iRes grid of quads in the XZ plane
+static void buildGrid( int iRes, std::vector<Abc::V3f> & oP,
+                       std::vector<AbcU::int32_t> & oIndices,
+                       std::vector<AbcU::int32_t> & oCounts )
+{
+    oP.clear();
+    oIndices.clear();
+    oCounts.clear();
+
+    for ( int z = 0; z <= iRes; ++z )
+    {
+        for ( int x = 0; x <= iRes; ++x )
+        {
+            oP.push_back( Abc::V3f( ( float ) x, 0.0f, ( float ) z ) );
+        }
+    }
+
+    for ( int z = 0; z < iRes; ++z )
+    {
+        for ( int x = 0; x < iRes; ++x )
+        {
+            AbcU::int32_t v = z * ( iRes + 1 ) + x;
+            oIndices.push_back( v );
+            oIndices.push_back( v + iRes + 1 );
+            oIndices.push_back( v + iRes + 2 );
+            oIndices.push_back( v + 1 );
+            oCounts.push_back( 4 );
+        }
+    }
+}
+
+// moves every point of iBase up and down, writing the result into oP
+static void deformGrid( const std::vector<Abc::V3f> & iBase,
+                        std::size_t iFrame, std::vector<Abc::V3f> & oP )
+{
+    oP.resize( iBase.size() );
+    float phase = 0.25f * ( float ) iFrame;
+    for ( std::size_t i = 0; i < iBase.size(); ++i )
+    {
+        oP[i] = iBase[i];
+        oP[i].y = sinf( phase + 0.1f * iBase[i].x ) *
+            cosf( phase + 0.1f * iBase[i].z );
+    }
+}
+
+//-*****************************************************************************
+// a wide, flat hierarchy of small animated meshes
+class WideScenario : public Scenario
+{
+public:
+    WideScenario( int iScale ) : Scenario( iScale ) {}
+
+    const char * name() const { return "wide"; }
+
+    void setup( Abc::OArchive & iArchive )
+    {
+        AbcU::uint32_t tsIdx = addUniformTime( iArchive );
+        Abc::OObject top = iArchive.getTop();
+        for ( int i = 0; i < 256 * m_scale; ++i )
+        {
+            std::ostringstream strm;
+            strm << "mesh" << i;
+            m_meshes.push_back( AbcG::OPolyMesh( top, strm.str(), tsIdx ) );
+        }
+
+        buildGrid( 4, m_base, m_indices, m_counts );
+    }
+
+    AbcU::uint64_t writeFrame( std::size_t iFrame )
+    {
+        AbcU::uint64_t bytes = 0;
+        for ( std::size_t i = 0; i < m_meshes.size(); ++i )
+        {
+            deformGrid( m_base, iFrame + i, m_P );
+            Abc::P3fArraySample pSamp( m_P );
+            AbcG::OPolyMeshSchema::Sample samp( pSamp );
+            bytes += m_P.size() * sizeof( Abc::V3f );
+
+            if ( iFrame == 0 )
+            {
+                samp.setFaceIndices( Abc::Int32ArraySample( m_indices ) );
+                samp.setFaceCounts( Abc::Int32ArraySample( m_counts ) );
+                bytes += ( m_indices.size() + m_counts.size() ) *
+                    sizeof( AbcU::int32_t );
+            }
+            m_meshes[i].getSchema().set( samp );
+        }
+
+        return bytes;
+    }
+
+    void teardown() { m_meshes.clear(); }
+
+private:
+    std::vector<AbcG::OPolyMesh> m_meshes;
+    std::vector<Abc::V3f> m_base;
+    std::vector<Abc::V3f> m_P;
+    std::vector<AbcU::int32_t> m_indices;
+    std::vector<AbcU::int32_t> m_counts;
+};
+
+//-*****************************************************************************
+// one large mesh with animated positions
+class BigMeshScenario : public Scenario
+{
+public:
+    BigMeshScenario( int iScale ) : Scenario( iScale ) {}
+
+    const char * name() const { return "bigmesh"; }
+
+    void setup( Abc::OArchive & iArchive )
+    {
+        AbcU::uint32_t tsIdx = addUniformTime( iArchive );
+        m_mesh = AbcG::OPolyMesh( iArchive.getTop(), "bigmesh", tsIdx );
+
+        // roughly 100k points per unit of scale
+        int res = ( int ) ( 316.0 * sqrt( ( double ) m_scale ) );
+        buildGrid( res, m_base, m_indices, m_counts );
+    }
+
+    AbcU::uint64_t writeFrame( std::size_t iFrame )
+    {
+        deformGrid( m_base, iFrame, m_P );
+        Abc::P3fArraySample pSamp( m_P );
+        AbcG::OPolyMeshSchema::Sample samp( pSamp );
+        AbcU::uint64_t bytes = m_P.size() * sizeof( Abc::V3f );
+
+        if ( iFrame == 0 )
+        {
+            samp.setFaceIndices( Abc::Int32ArraySample( m_indices ) );
+            samp.setFaceCounts( Abc::Int32ArraySample( m_counts ) );
+            bytes += ( m_indices.size() + m_counts.size() ) *
+                sizeof( AbcU::int32_t );
+        }
+        m_mesh.getSchema().set( samp );
+        return bytes;
+    }
+
+    void teardown() { m_mesh.reset(); }
+
+private:
+    AbcG::OPolyMesh m_mesh;
+    std::vector<Abc::V3f> m_base;
+    std::vector<Abc::V3f> m_P;
+    std::vector<AbcU::int32_t> m_indices;
+    std::vector<AbcU::int32_t> m_counts;
+};
+
+//-*****************************************************************************
+// lots of tiny animated scalar properties on a handful of objects
+class SmallPropsScenario : public Scenario
+{
+public:
+    SmallPropsScenario( int iScale ) : Scenario( iScale ) {}
+
+    const char * name() const { return "smallprops"; }
+    std::size_t numFrames() const { return 48; }
+
+    void setup( Abc::OArchive & iArchive )
+    {
+        AbcU::uint32_t tsIdx = addUniformTime( iArchive );
+        Abc::OObject top = iArchive.getTop();
+        for ( int o = 0; o < 8; ++o )
+        {
+            std::ostringstream objName;
+            objName << "node" << o;
+            Abc::OObject obj( top, objName.str() );
+            Abc::OCompoundProperty props = obj.getProperties();
+            for ( int i = 0; i < 64 * m_scale; ++i )
+            {
+                std::ostringstream strm;
+                strm << "attr" << i;
+                if ( i % 2 )
+                {
+                    m_floats.push_back( Abc::OFloatProperty( props,
+                        strm.str(), tsIdx ) );
+                }
+                else
+                {
+                    m_ints.push_back( Abc::OInt32Property( props,
+                        strm.str(), tsIdx ) );
+                }
+            }
+        }
+    }
+
+    AbcU::uint64_t writeFrame( std::size_t iFrame )
+    {
+        for ( std::size_t i = 0; i < m_floats.size(); ++i )
+        {
+            m_floats[i].set( 0.5f * ( float ) ( iFrame + i ) );
+        }
+
+        for ( std::size_t i = 0; i < m_ints.size(); ++i )
+        {
+            m_ints[i].set( ( AbcU::int32_t ) ( iFrame * i ) );
+        }
+
+        return m_floats.size() * sizeof( float ) +
+            m_ints.size() * sizeof( AbcU::int32_t );
+    }
+
+    void teardown()
+    {
+        m_floats.clear();
+        m_ints.clear();
+    }
+
+private:
+    std::vector<Abc::OFloatProperty> m_floats;
+    std::vector<Abc::OInt32Property> m_ints;
+};
+
+//-*****************************************************************************
+// points written with irregular, acyclic sample times
+class AcyclicScenario : public Scenario
+{
+public:
+    AcyclicScenario( int iScale ) : Scenario( iScale ) {}
+
+    const char * name() const { return "acyclic"; }
+    std::size_t numFrames() const { return 48; }
+
+    void setup( Abc::OArchive & iArchive )
+    {
+        std::vector<double> times;
+        double t = 0.0;
+        for ( std::size_t i = 0; i < numFrames(); ++i )
+        {
+            times.push_back( t );
+            t += ( i % 3 == 0 ) ? 0.01 : 1.0 / 24.0;
+        }
+
+        AbcA::TimeSampling ts( AbcA::TimeSamplingType(
+            AbcA::TimeSamplingType::kAcyclic ), times );
+        AbcU::uint32_t tsIdx = iArchive.addTimeSampling( ts );
+
+        m_points = AbcG::OPoints( iArchive.getTop(), "points", tsIdx );
+
+        std::size_t numPoints = 10000 * m_scale;
+        m_P.resize( numPoints );
+        m_ids.resize( numPoints );
+        for ( std::size_t i = 0; i < numPoints; ++i )
+        {
+            m_ids[i] = i;
+        }
+    }
+
+    AbcU::uint64_t writeFrame( std::size_t iFrame )
+    {
+        for ( std::size_t i = 0; i < m_P.size(); ++i )
+        {
+            float f = ( float ) ( i + iFrame );
+            m_P[i] = Abc::V3f( sinf( f ), cosf( f * 0.5f ), 0.01f * f );
+        }
+
+        Abc::P3fArraySample pSamp( m_P );
+        Abc::UInt64ArraySample idSamp( m_ids );
+        AbcG::OPointsSchema::Sample samp( pSamp, idSamp );
+        m_points.getSchema().set( samp );
+
+        return m_P.size() * sizeof( Abc::V3f ) +
+            m_ids.size() * sizeof( AbcU::uint64_t );
+    }
+
+    void teardown() { m_points.reset(); }
+
+private:
+    AbcG::OPoints m_points;
+    std::vector<Abc::V3f> m_P;
+    std::vector<AbcU::uint64_t> m_ids;
+};
+
+//-*****************************************************************************
+static Scenario * makeScenario( const std::string & iName, int iScale )
+{
+    if ( iName == "deep" )       { return new DeepScenario( iScale ); }
+    if ( iName == "wide" )       { return new WideScenario( iScale ); }
+    if ( iName == "bigmesh" )    { return new BigMeshScenario( iScale ); }
+    if ( iName == "smallprops" ) { return new SmallPropsScenario( iScale ); }
+    if ( iName == "acyclic" )    { return new AcyclicScenario( iScale ); }
+    return NULL;
+}
+
+//-*****************************************************************************
+// Write workload
+//-*****************************************************************************
+
+static AbcU::uint64_t fileSize( const std::string & iFileName )
+{
+    std::ifstream strm( iFileName.c_str(), std::ios::binary | std::ios::ate );
+    if ( !strm )
+    {
+        return 0;
+    }
+    return ( AbcU::uint64_t ) strm.tellg();
+}
+
+// one operation per frame, the archive close is counted against the wall time
+static void benchWrite( const std::string & iCore,
+                        const std::string & iFileName,
+                        Scenario & iScenario, Result & oResult )
+{
+    oResult.workload = "write";
+
+    long allocStart = getNumAllocs();
+    double start = getTimeSec();
+    {
+        Abc::OArchive archive;
+        if ( iCore == "hdf5" )
+        {
+            archive = Abc::OArchive( Alembic::AbcCoreHDF5::WriteArchive(),
+                                     iFileName );
+        }
+        else
+        {
+            archive = Abc::OArchive( Alembic::AbcCoreOgawa::WriteArchive(),
+                                     iFileName );
+        }
+
+        iScenario.setup( archive );
+
+        for ( std::size_t f = 0; f < iScenario.numFrames(); ++f )
+        {
+            double frameStart = getTimeSec();
+            iScenario.writeFrame( f );
+            oResult.latencies.push_back( getTimeSec() - frameStart );
+        }
+
+        iScenario.teardown();
+    }
+    oResult.wallTime = getTimeSec() - start;
+    oResult.allocs = getNumAllocs() - allocStart;
+    oResult.bytes = fileSize( iFileName );
+}
+
+//-*****************************************************************************
+// Read workloads
+//-*****************************************************************************
+
+static Abc::IArchive openArchive( const std::string & iFileName,
+                                  int iNumStreams )
+{
+    AbcF::IFactory factory;
+    factory.setOgawaNumStreams( iNumStreams );
+    AbcF::IFactory::CoreType coreType;
+    return factory.getArchive( iFileName, coreType );
+}
+
+//-*****************************************************************************
+// every property in an archive which has at least one sample
+struct PropertyList
+{
+    std::vector<Abc::IScalarProperty> scalars;
+    std::vector<Abc::IArrayProperty> arrays;
+    std::size_t maxNumSamples;
+};
+
+static void collectProperties( Abc::ICompoundProperty & iParent,
+                               PropertyList & oList )
+{
+    for ( std::size_t i = 0; i < iParent.getNumProperties(); ++i )
+    {
+        const AbcA::PropertyHeader & header = iParent.getPropertyHeader( i );
+        if ( header.isScalar() )
+        {
+            Abc::IScalarProperty prop( iParent, header.getName() );
+            if ( prop.getNumSamples() > 0 )
+            {
+                oList.scalars.push_back( prop );
+                oList.maxNumSamples = std::max( oList.maxNumSamples,
+                                                prop.getNumSamples() );
+            }
+        }
+        else if ( header.isArray() )
+        {
+            Abc::IArrayProperty prop( iParent, header.getName() );
+            if ( prop.getNumSamples() > 0 )
+            {
+                oList.arrays.push_back( prop );
+                oList.maxNumSamples = std::max( oList.maxNumSamples,
+                                                prop.getNumSamples() );
+            }
+        }
+        else
+        {
+            Abc::ICompoundProperty prop( iParent, header.getName() );
+            collectProperties( prop, oList );
+        }
+    }
+}
+
+// returns the number of objects visited
+static std::size_t walkObjects( Abc::IObject & iParent,
+                                PropertyList * oList )
+{
+    std::size_t count = 1;
+    for ( std::size_t i = 0; i < iParent.getNumChildren(); ++i )
+    {
+        Abc::IObject child( iParent, iParent.getChildHeader( i ).getName() );
+        Abc::ICompoundProperty props = child.getProperties();
+
+        if ( oList )
+        {
+            collectProperties( props, *oList );
+        }
+        else
+        {
+            // touch every property header, as a reader would
+            for ( std::size_t p = 0; p < props.getNumProperties(); ++p )
+            {
+                props.getPropertyHeader( p );
+            }
+        }
+
+        count += walkObjects( child, oList );
+    }
+    return count;
+}
+
+//-*****************************************************************************
+// reads one sample of one property, returns the number of bytes read
+class SampleReader
+{
+public:
+    AbcU::uint64_t readScalar( Abc::IScalarProperty & iProp, index_t iIndex )
+    {
+        const AbcA::DataType & dt = iProp.getDataType();
+        Abc::ISampleSelector iss( iIndex );
+
+        if ( dt.getPod() == AbcU::kStringPOD )
+        {
+            m_strings.resize( dt.getExtent() );
+            iProp.get( &m_strings.front(), iss );
+            return m_strings.front().size();
+        }
+        else if ( dt.getPod() == AbcU::kWstringPOD )
+        {
+            m_wstrings.resize( dt.getExtent() );
+            iProp.get( &m_wstrings.front(), iss );
+            return m_wstrings.front().size() * sizeof( wchar_t );
+        }
+
+        if ( m_scratch.size() < dt.getNumBytes() )
+        {
+            m_scratch.resize( dt.getNumBytes() );
+        }
+
+        iProp.get( &m_scratch.front(), iss );
+        return dt.getNumBytes();
+    }
+
+    AbcU::uint64_t readArray( Abc::IArrayProperty & iProp, index_t iIndex )
+    {
+        AbcA::ArraySamplePtr samp;
+        iProp.get( samp, Abc::ISampleSelector( iIndex ) );
+        if ( !samp )
+        {
+            return 0;
+        }
+        return samp->size() * samp->getDataType().getNumBytes();
+    }
+
+private:
+    std::vector<char> m_scratch;
+    std::vector<std::string> m_strings;
+    std::vector<std::wstring> m_wstrings;
+};
+
+//-*****************************************************************************
+struct RandomRead
+{
+    bool isArray;
+    std::size_t prop;
+    index_t index;
+};
+
+struct RandomReadTask
+{
+    PropertyList * props;
+    const std::vector<RandomRead> * reads;
+    std::size_t begin;
+    std::size_t end;
+
+    std::vector<double> latencies;
+    AbcU::uint64_t bytes;
+};
+
+static void randomReadThread( void * iData )
+{
+    RandomReadTask & task = *( ( RandomReadTask * ) iData );
+    SampleReader reader;
+
+    task.latencies.reserve( task.end - task.begin );
+    for ( std::size_t i = task.begin; i < task.end; ++i )
+    {
+        const RandomRead & r = ( *task.reads )[i];
+        double start = getTimeSec();
+        if ( r.isArray )
+        {
+            task.bytes += reader.readArray( task.props->arrays[r.prop],
+                                            r.index );
+        }
+        else
+        {
+            task.bytes += reader.readScalar( task.props->scalars[r.prop],
+                                             r.index );
+        }
+        task.latencies.push_back( getTimeSec() - start );
+    }
+}
+
+// a small deterministic generator, so every run reads the same samples
+static AbcU::uint32_t nextRandom( AbcU::uint32_t & ioState )
+{
+    ioState = ioState * 1664525u + 1013904223u;
+    return ioState >> 8;
+}
+
+static void benchRandomRead( const std::string & iFileName, int iNumThreads,
+                             std::size_t iNumReads, Result & oResult )
+{
+    oResult.workload = "random";
+    oResult.threads = iNumThreads;
+
+    Abc::IArchive archive = openArchive( iFileName, iNumThreads );
+    PropertyList props;
+    props.maxNumSamples = 0;
+    Abc::IObject top = archive.getTop();
+    walkObjects( top, &props );
+
+    std::size_t numProps = props.scalars.size() + props.arrays.size();
+    if ( numProps == 0 )
+    {
+        return;
+    }
+
+    std::vector<RandomRead> reads( iNumReads );
+    AbcU::uint32_t state = 12345;
+    for ( std::size_t i = 0; i < iNumReads; ++i )
+    {
+        std::size_t p = nextRandom( state ) % numProps;
+        RandomRead & r = reads[i];
+        r.isArray = p >= props.scalars.size();
+        r.prop = r.isArray ? p - props.scalars.size() : p;
+
+        std::size_t numSamples = r.isArray ?
+            props.arrays[r.prop].getNumSamples() :
+            props.scalars[r.prop].getNumSamples();
+        r.index = nextRandom( state ) % numSamples;
+    }
+
+    std::vector<RandomReadTask> tasks( iNumThreads );
+    std::size_t perThread = iNumReads / iNumThreads;
+    for ( int t = 0; t < iNumThreads; ++t )
+    {
+        tasks[t].props = &props;
+        tasks[t].reads = &reads;
+        tasks[t].begin = t * perThread;
+        tasks[t].end = ( t + 1 == iNumThreads ) ? iNumReads :
+            ( t + 1 ) * perThread;
+        tasks[t].bytes = 0;
+    }
+
+    long allocStart = getNumAllocs();
+    double start = getTimeSec();
+    runThreads( randomReadThread, tasks );
+    oResult.wallTime = getTimeSec() - start;
+    oResult.allocs = getNumAllocs() - allocStart;
+
+    for ( int t = 0; t < iNumThreads; ++t )
+    {
+        oResult.bytes += tasks[t].bytes;
+        oResult.latencies.insert( oResult.latencies.end(),
+                                  tasks[t].latencies.begin(),
+                                  tasks[t].latencies.end() );
+    }
+}
+
+//-*****************************************************************************
+static void benchOpen( const std::string & iFileName, std::size_t iIters,
+                       Result & oResult )
+{
+    oResult.workload = "open";
+
+    long allocStart = getNumAllocs();
+    double start = getTimeSec();
+    for ( std::size_t i = 0; i < iIters; ++i )
+    {
+        double openStart = getTimeSec();
+        Abc::IArchive archive = openArchive( iFileName, 1 );
+        oResult.latencies.push_back( getTimeSec() - openStart );
+    }
+    oResult.wallTime = getTimeSec() - start;
+    oResult.allocs = getNumAllocs() - allocStart;
+}
+
+//-*****************************************************************************
+// opens the archive each iteration so that nothing is already cached
+static void benchWalk( const std::string & iFileName, std::size_t iIters,
+                       Result & oResult )
+{
+    oResult.workload = "walk";
+
+    long allocs = 0;
+    double start = getTimeSec();
+    for ( std::size_t i = 0; i < iIters; ++i )
+    {
+        Abc::IArchive archive = openArchive( iFileName, 1 );
+        Abc::IObject top = archive.getTop();
+
+        long allocStart = getNumAllocs();
+        double walkStart = getTimeSec();
+        walkObjects( top, NULL );
+        oResult.latencies.push_back( getTimeSec() - walkStart );
+        allocs += getNumAllocs() - allocStart;
+    }
+    oResult.wallTime = getTimeSec() - start;
+    oResult.allocs = allocs;
+}
+
+//-*****************************************************************************
+// reads every animated property one frame at a time, one operation per frame
+static void benchPlayback( const std::string & iFileName, Result & oResult )
+{
+    oResult.workload = "playback";
+
+    Abc::IArchive archive = openArchive( iFileName, 1 );
+    PropertyList props;
+    props.maxNumSamples = 0;
+    Abc::IObject top = archive.getTop();
+    walkObjects( top, &props );
+
+    SampleReader reader;
+    long allocStart = getNumAllocs();
+    double start = getTimeSec();
+    for ( std::size_t f = 0; f < props.maxNumSamples; ++f )
+    {
+        double frameStart = getTimeSec();
+        for ( std::size_t i = 0; i < props.scalars.size(); ++i )
+        {
+            Abc::IScalarProperty & prop = props.scalars[i];
+            if ( f < prop.getNumSamples() )
+            {
+                oResult.bytes += reader.readScalar( prop, f );
+            }
+        }
+
+        for ( std::size_t i = 0; i < props.arrays.size(); ++i )
+        {
+            Abc::IArrayProperty & prop = props.arrays[i];
+            if ( f < prop.getNumSamples() )
+            {
+                oResult.bytes += reader.readArray( prop, f );
+            }
+        }
+        oResult.latencies.push_back( getTimeSec() - frameStart );
+    }
+    oResult.wallTime = getTimeSec() - start;
+    oResult.allocs = getNumAllocs() - allocStart;
+}
+
+//-*****************************************************************************
+static std::vector<std::string> splitList( const std::string & iList )
+{
+    std::vector<std::string> ret;
+    std::stringstream strm( iList );
+    std::string item;
+    while ( std::getline( strm, item, ',' ) )
+    {
+        if ( !item.empty() )
+        {
+            ret.push_back( item );
+        }
+    }
+    return ret;
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string desc( "abcbench [OPTION]\n"
+    "  -cores LIST       comma separated cores to test (default ogawa,hdf5)\n"
+    "  -scenarios LIST   comma separated scenarios to test (default\n"
+    "                    deep,wide,bigmesh,smallprops,acyclic)\n"
+    "  -scale N          multiplies the size of every scenario (default 1)\n"
+    "  -threads N        random reads are timed at 1, 2, 4 ... N threads\n"
+    "                    (default 4, hdf5 is always single threaded)\n"
+    "  -reads N          random sample reads per thread (default 10000)\n"
+    "  -iters N          repetitions of the open and walk workloads\n"
+    "                    (default 20)\n"
+    "  -dir DIR          where the synthetic archives are written (default .)\n"
+    "  -keep             don't remove the synthetic archives when done\n"
+    "  -h, --help        show this help message\n"
+    "\n"
+    "Latencies are per operation: one frame for write and playback, one\n"
+    "archive for open and walk, one sample for random.  MB/s is file bytes\n"
+    "for write and decoded sample bytes for reads.\n"
+    );
+
+    std::vector<std::string> cores = splitList( "ogawa,hdf5" );
+    std::vector<std::string> scenarios =
+        splitList( "deep,wide,bigmesh,smallprops,acyclic" );
+    int scale = 1;
+    int maxThreads = 4;
+    std::size_t numReads = 10000;
+    std::size_t iters = 20;
+    std::string dir = ".";
+    bool keep = false;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if ( arg == "-h" || arg == "--help" )
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+        else if ( arg == "-keep" )
+        {
+            keep = true;
+        }
+        else if ( arg == "-cores" && hasValue )
+        {
+            cores = splitList( argv[++i] );
+        }
+        else if ( arg == "-scenarios" && hasValue )
+        {
+            scenarios = splitList( argv[++i] );
+        }
+        else if ( arg == "-scale" && hasValue )
+        {
+            scale = std::max( 1, atoi( argv[++i] ) );
+        }
+        else if ( arg == "-threads" && hasValue )
+        {
+            maxThreads = std::max( 1, atoi( argv[++i] ) );
+        }
+        else if ( arg == "-reads" && hasValue )
+        {
+            numReads = std::max( 1, atoi( argv[++i] ) );
+        }
+        else if ( arg == "-iters" && hasValue )
+        {
+            iters = std::max( 1, atoi( argv[++i] ) );
+        }
+        else if ( arg == "-dir" && hasValue )
+        {
+            dir = argv[++i];
+        }
+        else
+        {
+            std::cerr << "Unknown option: " << arg << std::endl << std::endl
+                      << desc << std::endl;
+            return 1;
+        }
+    }
+
+    printHeader();
+
+    for ( std::size_t c = 0; c < cores.size(); ++c )
+    {
+        const std::string & core = cores[c];
+        if ( core != "ogawa" && core != "hdf5" )
+        {
+            std::cerr << "Unknown core: " << core << std::endl;
+            return 1;
+        }
+
+        for ( std::size_t s = 0; s < scenarios.size(); ++s )
+        {
+            Scenario * scenario = makeScenario( scenarios[s], scale );
+            if ( !scenario )
+            {
+                std::cerr << "Unknown scenario: " << scenarios[s]
+                          << std::endl;
+                return 1;
+            }
+
+            std::string fileName = dir + "/abcbench_" + scenarios[s] +
+                "_" + core + ".abc";
+
+            try
+            {
+                Result base;
+                base.core = core;
+                base.scenario = scenarios[s];
+
+                Result write = base;
+                benchWrite( core, fileName, *scenario, write );
+                printResult( write );
+
+                Result open = base;
+                benchOpen( fileName, iters, open );
+                printResult( open );
+
+                Result walk = base;
+                benchWalk( fileName, iters, walk );
+                printResult( walk );
+
+                // the HDF5 core serializes all access, so only one
+                // thread is timed
+                int threadLimit = ( core == "hdf5" ) ? 1 : maxThreads;
+                for ( int t = 1; t <= threadLimit; t *= 2 )
+                {
+                    Result random = base;
+                    benchRandomRead( fileName, t, numReads * t, random );
+                    printResult( random );
+
+                    if ( t < threadLimit && t * 2 > threadLimit )
+                    {
+                        t = threadLimit / 2;
+                    }
+                }
+
+                Result playback = base;
+                benchPlayback( fileName, playback );
+                printResult( playback );
+            }
+            catch ( std::exception & e )
+            {
+                std::cerr << core << " " << scenarios[s] << " failed: "
+                          << e.what() << std::endl;
+            }
+
+            delete scenario;
+
+            if ( !keep )
+            {
+                remove( fileName.c_str() );
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,252 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// abcmeshbench times the CPU side of drawing the meshes of an archive, the
+// reading of their samples and the triangulating and normal computing done
+// by AbcOpenGL's MeshDrwHelper, frame by frame.  Nothing is drawn, so no GL
+// context is needed.
+
+#include <AbcOpenGL/MeshDrwHelper.h>
+#include <Alembic/Util/Timer.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+namespace AbcF = ::Alembic::AbcCoreFactory;
+namespace AbcG = ::Alembic::AbcGeom;
+namespace AOGL = ::AbcOpenGL;
+
+//-*****************************************************************************
+// a mesh of the archive, PolyMesh or SubD, and what draws it
+struct Mesh
+{
+    AbcG::IP3fArrayProperty P;
+    AbcG::IInt32ArrayProperty indices;
+    AbcG::IInt32ArrayProperty counts;
+    AOGL::MeshDrwHelper *helper;
+};
+
+//-*****************************************************************************
+static void findMeshes( AbcG::IObject iObj, std::vector< Mesh > & oMeshes )
+{
+    const AbcG::MetaData & md = iObj.getMetaData();
+    AbcG::ICompoundProperty schema;
+    if ( AbcG::IPolyMesh::matches( md ) )
+    {
+        schema = AbcG::IPolyMesh( iObj, AbcG::kWrapExisting ).getSchema();
+    }
+    else if ( AbcG::ISubD::matches( md ) )
+    {
+        schema = AbcG::ISubD( iObj, AbcG::kWrapExisting ).getSchema();
+    }
+
+    if ( schema.valid() )
+    {
+        Mesh mesh;
+        mesh.P = AbcG::IP3fArrayProperty( schema, "P" );
+        mesh.indices = AbcG::IInt32ArrayProperty( schema, ".faceIndices" );
+        mesh.counts = AbcG::IInt32ArrayProperty( schema, ".faceCounts" );
+        mesh.helper = new AOGL::MeshDrwHelper();
+        oMeshes.push_back( mesh );
+    }
+
+    for ( size_t i = 0; i < iObj.getNumChildren(); ++i )
+    {
+        findMeshes( iObj.getChild( i ), oMeshes );
+    }
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string desc(
+    "abcmeshbench [OPTION] file.abc\n"
+    "Steps through the frames of file.abc, reading every PolyMesh and SubD\n"
+    "and getting it ready to draw as the viewer would, without drawing it.\n"
+    "\n"
+    "  -threads N   compute normals with up to N threads, 1 by default\n"
+    "  -fps N       step through the archive at N frames per second,\n"
+    "               24 by default\n"
+    "  -h, --help   show this help message\n"
+    "\n"
+    "Prints the time spent reading samples and updating meshes, and how\n"
+    "often meshes could share a triangulation.\n"
+    );
+
+    size_t numThreads = 1;
+    double fps = 24.0;
+    std::string fileName;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+
+        if ( arg == "-h" || arg == "--help" )
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+        else if ( arg == "-threads" && i + 1 < argc )
+        {
+            int threads = atoi( argv[++i] );
+            if ( threads < 1 )
+            {
+                std::cerr << "-threads needs a number above 0" << std::endl;
+                return 1;
+            }
+            numThreads = threads;
+        }
+        else if ( arg == "-fps" && i + 1 < argc )
+        {
+            fps = atof( argv[++i] );
+            if ( fps <= 0.0 )
+            {
+                std::cerr << "-fps needs a number above 0" << std::endl;
+                return 1;
+            }
+        }
+        else if ( fileName.empty() && !arg.empty() && arg[0] != '-' )
+        {
+            fileName = arg;
+        }
+        else
+        {
+            std::cerr << desc << std::endl;
+            return 1;
+        }
+    }
+
+    if ( fileName.empty() )
+    {
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    AbcF::IFactory factory;
+    AbcF::IFactory::CoreType coreType;
+    AbcG::IArchive archive = factory.getArchive( fileName, coreType );
+    if ( !archive.valid() )
+    {
+        std::cerr << "Could not open " << fileName << std::endl;
+        return 1;
+    }
+
+    std::vector< Mesh > meshes;
+    findMeshes( archive.getTop(), meshes );
+
+    // the frames run from the first sample of any mesh to the last
+    double minTime = 0.0;
+    double maxTime = 0.0;
+    bool haveTime = false;
+    for ( size_t i = 0; i < meshes.size(); ++i )
+    {
+        size_t numSamples = meshes[i].P.getNumSamples();
+        if ( numSamples == 0 )
+        {
+            continue;
+        }
+
+        AbcG::TimeSamplingPtr ts = meshes[i].P.getTimeSampling();
+        double first = ts->getSampleTime( 0 );
+        double last = ts->getSampleTime( numSamples - 1 );
+        minTime = haveTime ? std::min( minTime, first ) : first;
+        maxTime = haveTime ? std::max( maxTime, last ) : last;
+        haveTime = true;
+    }
+
+    size_t numFrames = 1 + size_t( ( maxTime - minTime ) * fps + 0.5 );
+
+    AOGL::ResetTriangulationCacheStats();
+
+    double readTime = 0.0;
+    double updateTime = 0.0;
+    size_t numTriangles = 0;
+    Alembic::Util::Timer timer;
+
+    for ( size_t f = 0; f < numFrames; ++f )
+    {
+        AbcG::ISampleSelector ss( minTime + f / fps );
+        for ( size_t i = 0; i < meshes.size(); ++i )
+        {
+            Mesh & mesh = meshes[i];
+
+            timer.start();
+            AbcG::P3fArraySamplePtr P = mesh.P.getValue( ss );
+            AbcG::Int32ArraySamplePtr indices = mesh.indices.getValue( ss );
+            AbcG::Int32ArraySamplePtr counts = mesh.counts.getValue( ss );
+            readTime += timer.elapsed();
+
+            timer.start();
+            mesh.helper->setNumThreads( numThreads );
+            mesh.helper->update( P, AbcG::V3fArraySamplePtr(), indices,
+                                 counts );
+            updateTime += timer.elapsed();
+
+            if ( f == 0 && mesh.helper->valid() )
+            {
+                // the faces are triangulated into fans
+                for ( size_t c = 0; c < counts->size(); ++c )
+                {
+                    numTriangles += std::max( ( *counts )[c] - 2, 0 );
+                }
+            }
+        }
+    }
+
+    AOGL::TriangulationCacheStats stats = AOGL::GetTriangulationCacheStats();
+
+    printf( "%s: %llu meshes, %llu triangles, %llu frames\n",
+            fileName.c_str(), ( unsigned long long ) meshes.size(),
+            ( unsigned long long ) numTriangles,
+            ( unsigned long long ) numFrames );
+    printf( "  read    %8.3f s  %8.3f ms/frame\n", readTime,
+            1000.0 * readTime / numFrames );
+    printf( "  update  %8.3f s  %8.3f ms/frame  (%llu threads)\n",
+            updateTime, 1000.0 * updateTime / numFrames,
+            ( unsigned long long ) numThreads );
+    printf( "  triangulations shared %llu, made %llu, %llu topologies held\n",
+            ( unsigned long long ) stats.hits,
+            ( unsigned long long ) stats.misses,
+            ( unsigned long long ) stats.size );
+
+    for ( size_t i = 0; i < meshes.size(); ++i )
+    {
+        delete meshes[i].helper;
+    }
+
+    return 0;
+}
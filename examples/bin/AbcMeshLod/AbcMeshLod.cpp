@@ -0,0 +1,153 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// abcmeshlod copies an archive, storing decimated levels of detail with each
+// of its polymeshes and subds, for readers to pick from by screen size.
+
+#include <Alembic/AbcCoreFactory/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcGeom/All.h>
+
+#include <cstdlib>
+#include <iostream>
+
+namespace Abc  = ::Alembic::Abc;
+namespace AbcF = ::Alembic::AbcCoreFactory;
+namespace AbcG = ::Alembic::AbcGeom;
+namespace AbcO = ::Alembic::AbcCoreOgawa;
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string desc(
+    "abcmeshlod [OPTION] inFile.abc outFile.abc\n"
+    "Copies inFile.abc into outFile.abc, an Ogawa archive, giving each\n"
+    "polymesh and subd decimated levels of detail.  Level N keeps roughly\n"
+    "a fraction of the positions of the mesh, and is meant for when the mesh\n"
+    "is less than a screen size across, in pixels.  By default the levels\n"
+    "keep 0.5, 0.25 and 0.125 of the positions, below 400, 200 and 100.\n"
+    "\n"
+    "  -level F S   a level keeping F of the positions, below S pixels,\n"
+    "               replacing the defaults, and given coarsest last\n"
+    "  -min N       leave meshes with fewer than N positions alone, 64 by\n"
+    "               default\n"
+    "  -h, --help   show this help message\n"
+    );
+
+    AbcG::MeshLodOptions options;
+    std::vector< float > fractions;
+    std::vector< float > screenSizes;
+    std::vector< std::string > files;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+
+        if ( arg == "-h" || arg == "--help" )
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+        else if ( arg == "-level" && i + 2 < argc )
+        {
+            float fraction = atof( argv[++i] );
+            float screenSize = atof( argv[++i] );
+            if ( fraction <= 0.0f || fraction >= 1.0f || screenSize <= 0.0f ||
+                 ( !screenSizes.empty() && screenSize >= screenSizes.back() ) )
+            {
+                std::cerr << "-level needs a fraction between 0 and 1, and "
+                          << "a screen size below the last one" << std::endl;
+                return 1;
+            }
+            fractions.push_back( fraction );
+            screenSizes.push_back( screenSize );
+        }
+        else if ( arg == "-min" && i + 1 < argc )
+        {
+            int minPositions = atoi( argv[++i] );
+            if ( minPositions < 0 )
+            {
+                std::cerr << "-min needs a number of at least 0" << std::endl;
+                return 1;
+            }
+            options.minPositions = minPositions;
+        }
+        else if ( !arg.empty() && arg[0] == '-' )
+        {
+            std::cerr << "Unknown option: " << arg << std::endl << std::endl
+                      << desc << std::endl;
+            return 1;
+        }
+        else
+        {
+            files.push_back( arg );
+        }
+    }
+
+    if ( files.size() != 2 || files[0] == files[1] )
+    {
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    if ( !fractions.empty() )
+    {
+        options.fractions = fractions;
+        options.screenSizes = screenSizes;
+    }
+
+    try
+    {
+        AbcF::IFactory factory;
+        Abc::IArchive archive = factory.getArchive( files[0] );
+        if ( !archive.valid() )
+        {
+            std::cerr << "Could not open: " << files[0] << std::endl;
+            return 1;
+        }
+
+        Abc::OArchive out( AbcO::WriteArchive(), files[1],
+                           archive.getTop().getMetaData() );
+        AbcG::BuildMeshLods( archive, out, options );
+    }
+    catch ( std::exception & e )
+    {
+        std::cerr << "abcmeshlod failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,306 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// abcmigrate converts HDF5 archives into Ogawa archives in bulk.  Each
+// archive is copied by AbcCoreOgawa::MigrateArchive, reading and writing
+// with several threads, into a temporary file which is renamed once it is
+// complete, so that a run which is stopped can be started again and only
+// redo the archives which weren't finished.
+
+#include <Alembic/AbcCoreFactory/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Util/Timer.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace Abc  = ::Alembic::Abc;
+namespace AbcF = ::Alembic::AbcCoreFactory;
+namespace AbcO = ::Alembic::AbcCoreOgawa;
+
+//-*****************************************************************************
+// prints how far along the current archive is, at most a few times a second
+struct Progress
+{
+    Progress() : lastPrint( -1.0 ) {}
+
+    Alembic::Util::Timer timer;
+    double lastPrint;
+};
+
+static void printProgress( const AbcO::MigrateStats & iStats, void * iData )
+{
+    Progress & progress = *( static_cast< Progress * >( iData ) );
+    double now = progress.timer.elapsed();
+    if ( now - progress.lastPrint < 0.5 &&
+         iStats.numSamples < iStats.totalSamples )
+    {
+        return;
+    }
+    progress.lastPrint = now;
+
+    double mb = iStats.bytesCopied / ( 1024.0 * 1024.0 );
+    fprintf( stderr, "\r  %llu / %llu samples  %.1f MB  %.1f MB/s   ",
+             ( unsigned long long ) iStats.numSamples,
+             ( unsigned long long ) iStats.totalSamples, mb,
+             iStats.seconds > 0.0 ? mb / iStats.seconds : 0.0 );
+    if ( iStats.numSamples == iStats.totalSamples )
+    {
+        fprintf( stderr, "\n" );
+    }
+}
+
+//-*****************************************************************************
+static bool exists( const std::string & iFileName )
+{
+    std::ifstream file( iFileName.c_str() );
+    return file.good();
+}
+
+//-*****************************************************************************
+static std::string baseName( const std::string & iFileName )
+{
+    std::size_t slash = iFileName.find_last_of( "/\\" );
+    if ( slash == std::string::npos )
+    {
+        return iFileName;
+    }
+    return iFileName.substr( slash + 1 );
+}
+
+//-*****************************************************************************
+// returns false if the archive couldn't be migrated
+static bool migrate( const std::string & iInFile, const std::string & iOutFile,
+                     const AbcO::MigrateOptions & iOptions, bool iForce,
+                     bool iQuiet, AbcO::MigrateStats & ioTotal )
+{
+    // an output which is there and intact was finished by an earlier run
+    if ( !iForce && exists( iOutFile ) )
+    {
+        AbcO::VerifyOptions verifyOptions;
+        verifyOptions.numThreads = iOptions.numThreads;
+        if ( AbcO::VerifyArchive( iOutFile, verifyOptions ).ok() )
+        {
+            printf( "%s: already migrated to %s\n", iInFile.c_str(),
+                    iOutFile.c_str() );
+            return true;
+        }
+    }
+
+    std::string partFile = iOutFile + ".partial";
+    AbcO::MigrateStats stats;
+    try
+    {
+        AbcF::IFactory factory;
+        factory.setHDF5CacheHierarchy( true );
+        factory.setOgawaNumStreams( iOptions.numThreads );
+
+        AbcF::IFactory::CoreType coreType;
+        Abc::IArchive archive = factory.getArchive( iInFile, coreType );
+        if ( !archive.valid() )
+        {
+            printf( "%s: could not be opened\n", iInFile.c_str() );
+            return false;
+        }
+
+        if ( coreType == AbcF::IFactory::kOgawa )
+        {
+            printf( "%s: already an Ogawa archive\n", iInFile.c_str() );
+            return true;
+        }
+
+        Progress progress;
+        AbcO::MigrateOptions options = iOptions;
+        if ( !iQuiet )
+        {
+            printf( "%s\n", iInFile.c_str() );
+            fflush( stdout );
+            options.progress = printProgress;
+            options.progressData = &progress;
+        }
+
+        stats = AbcO::MigrateArchive( archive.getPtr(), partFile, options );
+    }
+    catch ( std::exception & e )
+    {
+        printf( "%s: failed, %s\n", iInFile.c_str(), e.what() );
+        remove( partFile.c_str() );
+        return false;
+    }
+
+    // renaming onto an existing file fails on some platforms
+    remove( iOutFile.c_str() );
+    if ( rename( partFile.c_str(), iOutFile.c_str() ) != 0 )
+    {
+        printf( "%s: could not rename %s to %s\n", iInFile.c_str(),
+                partFile.c_str(), iOutFile.c_str() );
+        return false;
+    }
+
+    double mb = stats.bytesCopied / ( 1024.0 * 1024.0 );
+    double seconds = stats.seconds > 0.0 ? stats.seconds : 1.0;
+    printf( "%s: %llu objects, %llu samples, %.2f MB in %.2f s, "
+            "%.1f MB/s, %.0f samples/s\n", iOutFile.c_str(),
+            ( unsigned long long ) stats.numObjects,
+            ( unsigned long long ) stats.numSamples, mb, stats.seconds,
+            mb / seconds, stats.numSamples / seconds );
+
+    ioTotal.numObjects += stats.numObjects;
+    ioTotal.numSamples += stats.numSamples;
+    ioTotal.bytesCopied += stats.bytesCopied;
+    ioTotal.seconds += stats.seconds;
+    return true;
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string desc(
+    "abcmigrate [OPTION] -o outDir in.abc [in.abc ...]\n"
+    "Converts HDF5 archives into Ogawa archives of the same name in outDir,\n"
+    "reading, hashing and writing with several threads.\n"
+    "\n"
+    "  -o DIR       where the Ogawa archives are written, required\n"
+    "  -threads N   copy with N threads, 4 by default\n"
+    "  -batch MB    read up to MB megabytes of a property's samples before\n"
+    "               writing them, 64 by default\n"
+    "  -force       migrate again even when outDir already has an intact\n"
+    "               copy\n"
+    "  -q           don't print progress\n"
+    "  -h, --help   show this help message\n"
+    "\n"
+    "Each archive is written to a .partial file which is renamed when it is\n"
+    "complete.  Archives already in outDir which pass abcverify are skipped,\n"
+    "so an interrupted run can be started again with the same arguments.\n"
+    "Archives which are already Ogawa are skipped too.\n"
+    "Exits with 1 if any archive couldn't be migrated.\n"
+    );
+
+    AbcO::MigrateOptions options;
+    std::string outDir;
+    bool force = false;
+    bool quiet = false;
+    std::vector< std::string > files;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+
+        if ( arg == "-h" || arg == "--help" )
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+        else if ( arg == "-o" && i + 1 < argc )
+        {
+            outDir = argv[++i];
+        }
+        else if ( arg == "-threads" && i + 1 < argc )
+        {
+            int numThreads = atoi( argv[++i] );
+            if ( numThreads < 1 )
+            {
+                std::cerr << "-threads needs a number above 0" << std::endl;
+                return 1;
+            }
+            options.numThreads = numThreads;
+        }
+        else if ( arg == "-batch" && i + 1 < argc )
+        {
+            int mb = atoi( argv[++i] );
+            if ( mb < 1 )
+            {
+                std::cerr << "-batch needs a number above 0" << std::endl;
+                return 1;
+            }
+            options.batchBytes = Alembic::Util::uint64_t( mb ) * 1024 * 1024;
+        }
+        else if ( arg == "-force" )
+        {
+            force = true;
+        }
+        else if ( arg == "-q" )
+        {
+            quiet = true;
+        }
+        else if ( !arg.empty() && arg[0] == '-' )
+        {
+            std::cerr << "Unknown option: " << arg << std::endl << std::endl
+                      << desc << std::endl;
+            return 1;
+        }
+        else
+        {
+            files.push_back( arg );
+        }
+    }
+
+    if ( files.empty() || outDir.empty() )
+    {
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    bool allOk = true;
+    AbcO::MigrateStats total;
+    for ( std::size_t i = 0; i < files.size(); ++i )
+    {
+        std::string outFile = outDir + "/" + baseName( files[i] );
+        if ( outFile == files[i] )
+        {
+            printf( "%s: would be migrated onto itself\n", files[i].c_str() );
+            allOk = false;
+            continue;
+        }
+
+        allOk = migrate( files[i], outFile, options, force, quiet, total ) &&
+            allOk;
+    }
+
+    if ( files.size() > 1 && total.seconds > 0.0 )
+    {
+        double mb = total.bytesCopied / ( 1024.0 * 1024.0 );
+        printf( "total: %llu objects, %llu samples, %.2f MB in %.2f s, "
+                "%.1f MB/s, %.0f samples/s\n",
+                ( unsigned long long ) total.numObjects,
+                ( unsigned long long ) total.numSamples, mb, total.seconds,
+                mb / total.seconds, total.numSamples / total.seconds );
+    }
+
+    return allOk ? 0 : 1;
+}
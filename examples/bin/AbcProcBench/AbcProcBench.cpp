@@ -0,0 +1,260 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// abcprocbench expands an archive the way a render procedural would, into an
+// emitter which only counts and checksums what it is given, first on one
+// thread and then on several, so the two can be timed and compared.
+
+#include <Alembic/AbcCoreFactory/All.h>
+#include <Alembic/AbcProcedural/All.h>
+#include <Alembic/Util/Timer.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+namespace AbcF = ::Alembic::AbcCoreFactory;
+namespace AbcG = ::Alembic::AbcGeom;
+namespace AbcP = ::Alembic::AbcProcedural;
+
+//-*****************************************************************************
+static void printRun( const char *iName, const AbcP::ExpandStats &iStats,
+                      const AbcP::MockEmitter &iEmitter )
+{
+    printf( "  %-8s total %8.3f s  walk %8.3f s  read %8.3f s  "
+            "emit %8.3f s  checksum %016llx\n", iName, iStats.totalTime,
+            iStats.walkTime, iStats.readTime, iStats.emitTime,
+            ( unsigned long long ) iEmitter.getChecksum() );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string desc(
+    "abcprocbench [OPTION] file.abc\n"
+    "Expands every transform, mesh, curve and point cloud of file.abc the\n"
+    "way a render procedural would, once on a single thread and once on\n"
+    "several, without a renderer.\n"
+    "\n"
+    "  -threads N       read with N threads, 4 by default\n"
+    "  -batch N         read up to N objects ahead, 256 by default\n"
+    "  -frame N         expand frame N, 0 by default\n"
+    "  -fps N           24 by default\n"
+    "  -shutter O C     shutter open and close, relative to the frame\n"
+    "  -objectpath P    only expand beneath P\n"
+    "  -defer N         also plan deferred stubs of at most N objects, and\n"
+    "                   expand them one at a time\n"
+    "  -h, --help       show this help message\n"
+    "\n"
+    "Prints the time spent walking, reading and emitting for each run, and\n"
+    "whether both runs emitted the same things in the same order.  With\n"
+    "-defer, prints how long planning took and how many stubs it made.\n"
+    );
+
+    AbcP::ExpandArgs args;
+    AbcP::DeferArgs deferArgs;
+    bool defer = false;
+    std::size_t numThreads = 4;
+    std::string fileName;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+
+        if ( arg == "-h" || arg == "--help" )
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+        else if ( arg == "-threads" && i + 1 < argc )
+        {
+            int threads = atoi( argv[++i] );
+            if ( threads < 1 )
+            {
+                std::cerr << "-threads needs a number above 0" << std::endl;
+                return 1;
+            }
+            numThreads = threads;
+        }
+        else if ( arg == "-batch" && i + 1 < argc )
+        {
+            int batch = atoi( argv[++i] );
+            if ( batch < 1 )
+            {
+                std::cerr << "-batch needs a number above 0" << std::endl;
+                return 1;
+            }
+            args.batchSize = batch;
+        }
+        else if ( arg == "-frame" && i + 1 < argc )
+        {
+            args.frame = atof( argv[++i] );
+        }
+        else if ( arg == "-fps" && i + 1 < argc )
+        {
+            args.fps = atof( argv[++i] );
+            if ( args.fps <= 0.0 )
+            {
+                std::cerr << "-fps needs a number above 0" << std::endl;
+                return 1;
+            }
+        }
+        else if ( arg == "-shutter" && i + 2 < argc )
+        {
+            args.shutterOpen = atof( argv[++i] );
+            args.shutterClose = atof( argv[++i] );
+        }
+        else if ( arg == "-objectpath" && i + 1 < argc )
+        {
+            args.objectpath = argv[++i];
+        }
+        else if ( arg == "-defer" && i + 1 < argc )
+        {
+            int maxObjects = atoi( argv[++i] );
+            if ( maxObjects < 1 )
+            {
+                std::cerr << "-defer needs a number above 0" << std::endl;
+                return 1;
+            }
+            deferArgs.maxObjectsPerStub = maxObjects;
+            defer = true;
+        }
+        else if ( fileName.empty() && !arg.empty() && arg[0] != '-' )
+        {
+            fileName = arg;
+        }
+        else
+        {
+            std::cerr << desc << std::endl;
+            return 1;
+        }
+    }
+
+    if ( fileName.empty() )
+    {
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    AbcF::IFactory factory;
+    AbcF::IFactory::CoreType coreType;
+    AbcG::IArchive archive = factory.getArchive( fileName, coreType );
+    if ( !archive.valid() )
+    {
+        std::cerr << "Could not open " << fileName << std::endl;
+        return 1;
+    }
+
+    // separate runs of separate emitters, so each starts from nothing
+    args.numThreads = 1;
+    AbcP::MockEmitter serialEmitter;
+    AbcP::ExpandStats serial =
+        AbcP::Expand( archive.getTop(), args, serialEmitter );
+
+    args.numThreads = numThreads;
+    AbcP::MockEmitter threadedEmitter;
+    AbcP::ExpandStats threaded =
+        AbcP::Expand( archive.getTop(), args, threadedEmitter );
+
+    printf( "%s: %llu objects, %llu xforms, %llu polymeshes, %llu subds, "
+            "%llu curves, %llu points\n", fileName.c_str(),
+            ( unsigned long long ) serial.numObjects,
+            ( unsigned long long ) serial.numXforms,
+            ( unsigned long long ) serial.numPolyMeshes,
+            ( unsigned long long ) serial.numSubDs,
+            ( unsigned long long ) serial.numCurves,
+            ( unsigned long long ) serial.numPoints );
+    printf( "  %llu samples, %llu faces, %llu points\n",
+            ( unsigned long long ) serial.numSamples,
+            ( unsigned long long ) serialEmitter.getNumFaces(),
+            ( unsigned long long ) serialEmitter.getNumPoints() );
+
+    printRun( "serial", serial, serialEmitter );
+
+    std::ostringstream name;
+    name << numThreads << " thr";
+    printRun( name.str().c_str(), threaded, threadedEmitter );
+
+    if ( threaded.totalTime > 0.0 )
+    {
+        printf( "  speedup %.2fx\n", serial.totalTime / threaded.totalTime );
+    }
+
+    if ( defer )
+    {
+        Alembic::Util::Timer timer;
+        AbcP::DeferredStubList stubs;
+        AbcP::PlanDeferred( archive.getTop(), args, deferArgs, stubs );
+        double planTime = timer.elapsed();
+
+        // as a renderer would, if every stub turned out to be needed
+        timer.start();
+        std::size_t numGeometry = 0;
+        std::size_t numUnbounded = 0;
+        for ( std::size_t i = 0; i < stubs.size(); ++i )
+        {
+            AbcP::MockEmitter emitter;
+            emitter.setParentXforms( stubs[i].parentXforms );
+            AbcP::Expand( stubs[i], args, emitter );
+            numGeometry += emitter.getNumGeometry();
+            numUnbounded += stubs[i].bounds.isEmpty() ? 1 : 0;
+        }
+        double expandTime = timer.elapsed();
+
+        printf( "  deferred %llu stubs, %llu without bounds, planned in "
+                "%.3f s, all expanded in %.3f s\n",
+                ( unsigned long long ) stubs.size(),
+                ( unsigned long long ) numUnbounded, planTime, expandTime );
+
+        if ( numGeometry != serialEmitter.getNumGeometry() )
+        {
+            std::cerr << "The stubs expanded to different geometry from "
+                      << "the whole archive." << std::endl;
+            return 1;
+        }
+    }
+
+    if ( serialEmitter.getChecksum() != threadedEmitter.getChecksum() )
+    {
+        std::cerr << "The threaded run emitted something different from "
+                  << "the serial one." << std::endl;
+        return 1;
+    }
+
+    printf( "  checksums match\n" );
+    return 0;
+}
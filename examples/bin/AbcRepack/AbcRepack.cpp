@@ -0,0 +1,187 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// abcrepack copies an archive into a new Ogawa archive with its sample data
+// laid out a frame at a time, so that playing it back reads the file mostly
+// front to back instead of jumping between objects.  It reports how many
+// seeks playing back the archive took before and after.
+
+#include <Alembic/AbcCoreFactory/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+
+#include <cstdio>
+#include <iostream>
+
+namespace Abc  = ::Alembic::Abc;
+namespace AbcA = ::Alembic::AbcCoreAbstract;
+namespace AbcF = ::Alembic::AbcCoreFactory;
+namespace AbcO = ::Alembic::AbcCoreOgawa;
+
+//-*****************************************************************************
+static void printPlayback( const std::string & iLabel,
+                           const AbcO::PlaybackStats & iStats )
+{
+    printf( "%-10s %8llu frames %10llu samples %10llu reads %10llu seeks "
+            "%12.2f MB sought\n", iLabel.c_str(),
+            ( unsigned long long ) iStats.numFrames,
+            ( unsigned long long ) iStats.numSamples,
+            ( unsigned long long ) iStats.numReads,
+            ( unsigned long long ) iStats.numSeeks,
+            iStats.seekDistance / ( 1024.0 * 1024.0 ) );
+}
+
+//-*****************************************************************************
+static double reduction( Alembic::Util::uint64_t iBefore,
+                         Alembic::Util::uint64_t iAfter )
+{
+    if ( iBefore == 0 )
+    {
+        return 0.0;
+    }
+    return 100.0 * ( double( iBefore ) - double( iAfter ) ) / iBefore;
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string desc(
+    "abcrepack [OPTION] inFile.abc outFile.abc\n"
+    "Copies inFile.abc, which may be HDF5 or Ogawa, into outFile.abc as an\n"
+    "Ogawa archive with each frame's sample data stored together.\n"
+    "\n"
+    "  -interleaveConstants  write the samples of properties which never\n"
+    "                        change with their first frame, instead of all\n"
+    "                        of them ahead of the first frame\n"
+    "  -noMeasure            don't play back both archives to report the\n"
+    "                        seeks saved\n"
+    "  -h, --help            show this help message\n"
+    "\n"
+    "Seeks are counted while reading every frame in hierarchy order, only\n"
+    "HDF5 archives can't be measured.\n"
+    );
+
+    AbcO::RepackOptions options;
+    bool measure = true;
+    std::vector< std::string > files;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+
+        if ( arg == "-h" || arg == "--help" )
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+        else if ( arg == "-interleaveConstants" )
+        {
+            options.constantsFirst = false;
+        }
+        else if ( arg == "-noMeasure" )
+        {
+            measure = false;
+        }
+        else if ( !arg.empty() && arg[0] == '-' )
+        {
+            std::cerr << "Unknown option: " << arg << std::endl << std::endl
+                      << desc << std::endl;
+            return 1;
+        }
+        else
+        {
+            files.push_back( arg );
+        }
+    }
+
+    if ( files.size() != 2 )
+    {
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        AbcO::PlaybackStats before;
+        AbcO::PlaybackStats after;
+        bool measuredBefore = false;
+
+        {
+            AbcF::IFactory factory;
+            AbcF::IFactory::CoreType coreType;
+            Abc::IArchive archive = factory.getArchive( files[0], coreType );
+            if ( !archive.valid() )
+            {
+                std::cerr << "Could not open: " << files[0] << std::endl;
+                return 1;
+            }
+
+            AbcO::RepackArchive( archive.getPtr(), files[1], options );
+
+            if ( measure && coreType == AbcF::IFactory::kOgawa )
+            {
+                // a fresh open, so nothing from the copy is in memory
+                before = AbcO::MeasurePlayback(
+                    AbcO::ReadArchive()( files[0] ) );
+                measuredBefore = true;
+            }
+        }
+
+        if ( measure )
+        {
+            after = AbcO::MeasurePlayback( AbcO::ReadArchive()( files[1] ) );
+
+            if ( measuredBefore )
+            {
+                printPlayback( "before", before );
+            }
+            printPlayback( "after", after );
+
+            if ( measuredBefore )
+            {
+                printf( "seeks reduced by %.1f%%, distance sought by %.1f%%\n",
+                        reduction( before.numSeeks, after.numSeeks ),
+                        reduction( before.seekDistance, after.seekDistance ) );
+            }
+        }
+    }
+    catch ( std::exception & e )
+    {
+        std::cerr << "abcrepack failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+// abcverify checks Ogawa archives for damage: it hashes the data of every
+// sample again, spread across threads, and compares it with the key stored
+// with the sample, after checking the file's header and offsets.  It exits
+// with 1 if any archive is damaged.
+
+#include <Alembic/AbcCoreOgawa/All.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+namespace AbcO = ::Alembic::AbcCoreOgawa;
+
+//-*****************************************************************************
+static bool verify( const std::string & iFileName,
+                    const AbcO::VerifyOptions & iOptions, bool iVerbose )
+{
+    AbcO::VerifyReport report = AbcO::VerifyArchive( iFileName, iOptions );
+
+    printf( "%s: %s\n", iFileName.c_str(), report.ok() ? "ok" : "CORRUPT" );
+
+    if ( iVerbose || !report.ok() )
+    {
+        printf( "  %llu objects, %llu properties, %llu samples, "
+                "%.2f MB checked\n",
+                ( unsigned long long ) report.numObjects,
+                ( unsigned long long ) report.numProperties,
+                ( unsigned long long ) report.numSamples,
+                report.bytesChecked / ( 1024.0 * 1024.0 ) );
+    }
+
+    if ( !report.ok() )
+    {
+        printf( "  %llu corrupt samples, %llu corrupt bytes\n",
+                ( unsigned long long ) report.numCorruptSamples,
+                ( unsigned long long ) report.corruptBytes );
+
+        for ( std::size_t i = 0; i < report.corruptObjects.size(); ++i )
+        {
+            printf( "  corrupt object: %s\n",
+                    report.corruptObjects[i].c_str() );
+        }
+
+        for ( std::size_t i = 0; i < report.errors.size(); ++i )
+        {
+            printf( "  %s\n", report.errors[i].c_str() );
+        }
+    }
+
+    return report.ok();
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string desc(
+    "abcverify [OPTION] file.abc [file.abc ...]\n"
+    "Checks that the Ogawa archives given haven't been damaged since they\n"
+    "were written, by hashing every sample again and comparing it to the\n"
+    "key stored with it.\n"
+    "\n"
+    "  -threads N   hash with N threads, each reading with its own stream,\n"
+    "               4 by default\n"
+    "  -v           print what was checked for good archives too\n"
+    "  -h, --help   show this help message\n"
+    "\n"
+    "Exits with 1 if any archive is damaged or couldn't be read.\n"
+    );
+
+    AbcO::VerifyOptions options;
+    bool verbose = false;
+    std::vector< std::string > files;
+
+    for ( int i = 1; i < argc; ++i )
+    {
+        std::string arg = argv[i];
+
+        if ( arg == "-h" || arg == "--help" )
+        {
+            std::cout << desc << std::endl;
+            return 0;
+        }
+        else if ( arg == "-threads" && i + 1 < argc )
+        {
+            int numThreads = atoi( argv[++i] );
+            if ( numThreads < 1 )
+            {
+                std::cerr << "-threads needs a number above 0" << std::endl;
+                return 1;
+            }
+            options.numThreads = numThreads;
+        }
+        else if ( arg == "-v" )
+        {
+            verbose = true;
+        }
+        else if ( !arg.empty() && arg[0] == '-' )
+        {
+            std::cerr << "Unknown option: " << arg << std::endl << std::endl
+                      << desc << std::endl;
+            return 1;
+        }
+        else
+        {
+            files.push_back( arg );
+        }
+    }
+
+    if ( files.empty() )
+    {
+        std::cerr << desc << std::endl;
+        return 1;
+    }
+
+    bool allOk = true;
+    for ( std::size_t i = 0; i < files.size(); ++i )
+    {
+        allOk = verify( files[i], options, verbose ) && allOk;
+    }
+
+    return allOk ? 0 : 1;
+}
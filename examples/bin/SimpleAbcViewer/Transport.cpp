@@ -42,11 +42,10 @@ using namespace AbcOpenGL;
 
 //-*****************************************************************************
 Transport::Transport( const std::string &iAbcFileName,
-                      chrono_t iFramesPerSecond )
-  : m_scene( iAbcFileName )
-  , m_framesPerSecond( iFramesPerSecond )
-  , m_secondsPerFrame( 1.0f / iFramesPerSecond )
-  , m_currentSeconds( m_scene.getMinTime() )
+                      chrono_t iFramesPerSecond,
+                      size_t iCacheFrames,
+                      size_t iNumThreads )
+  : m_playback( iAbcFileName, iFramesPerSecond, iCacheFrames, iNumThreads )
 {
     // Nothing
 }
@@ -44,65 +44,63 @@ namespace SimpleAbcViewer {
 using namespace AbcOpenGL;
 
 //-*****************************************************************************
+// Frames are loaded ahead of the playhead by AbcOpenGL::Playback, so that
+// playing back doesn't wait on reading the archive.
 class Transport
 {
 public:
     Transport( const std::string &iAbcFileName,
-               chrono_t iFps );
+               chrono_t iFps,
+               size_t iCacheFrames = 8,
+               size_t iNumThreads = 2 );
 
     void draw( SceneState &iState )
     {
-        return m_scene.draw( iState );
+        return m_playback.draw( iState );
     }
     
     Box3d getBounds() const
     {
-        return m_scene.getBounds();
+        return m_playback.getBounds();
     }
 
     void tickForward()
     {
-        if ( m_scene.isConstant() ) { return; }
-        
-        m_currentSeconds += m_secondsPerFrame;                           
-        
-        if ( m_currentSeconds > m_scene.getMaxTime() )
-        {
-            m_currentSeconds = m_scene.getMinTime();
-        }
-
-        m_scene.setTime( m_currentSeconds );
+        m_playback.step( 1 );
     }
     
     void tickBackward()
     {
-        if ( m_scene.isConstant() ) { return; }
-        
-        m_currentSeconds -= m_secondsPerFrame;                           
-        
-        if ( m_currentSeconds < m_scene.getMinTime() )
-        {
-            m_currentSeconds = m_scene.getMaxTime();
-        }
+        m_playback.step( -1 );
+    }
+
+    // 1 plays forward, -1 backward and 0 stops
+    void play( int iDirection )
+    {
+        m_playback.setDirection( iDirection );
+    }
+
+    // Returns true when there is a new frame to draw.
+    bool update()
+    {
+        return m_playback.update();
+    }
 
-        m_scene.setTime( m_currentSeconds );
+    PlaybackStats getStats() const
+    {
+        return m_playback.getStats();
     }
 
     const std::string &getFileName() const
-    { return m_scene.getFileName(); }
+    { return m_playback.getFileName(); }
     
     int getCurrentFrame() const
     {
-        return ( int )floor( 0.5 +
-                             ( m_currentSeconds * m_framesPerSecond ) );
+        return m_playback.getCurrentFrame();
     }
     
 protected:
-    Scene m_scene;
-    
-    chrono_t m_framesPerSecond;
-    chrono_t m_secondsPerFrame;
-    chrono_t m_currentSeconds;
+    Playback m_playback;
 };
 
 } // End namespace SimpleAbcViewer
@@ -49,7 +49,7 @@ namespace SimpleAbcViewer {
 //-*****************************************************************************
 static State g_state;
 
-static Timer g_playbackTimer;
+static AbcOpenGL::Timer g_playbackTimer;
 
 //-*****************************************************************************
 void overlay();
@@ -70,7 +70,31 @@ void init_surface( void )
         delete g_transport;
         g_transport = NULL;
     }
-    g_transport = new Transport( g_state.abcFileName, g_state.fps );
+    g_transport = new Transport( g_state.abcFileName, g_state.fps,
+                                 g_state.cacheFrames, g_state.numThreads );
+}
+
+//-*****************************************************************************
+void updateTitle()
+{
+    std::ostringstream titleStream;
+    titleStream << "Archive = " 
+                << g_transport->getFileName()
+                << " | Frame = "
+                << g_transport->getCurrentFrame();
+
+    if ( g_state.showStats )
+    {
+        PlaybackStats stats = g_transport->getStats();
+        titleStream << " | Cache = "
+                    << stats.cacheFilled << "/" << stats.cacheSize
+                    << " | Decode = "
+                    << ( int )( stats.meanDecodeTime * 1000.0 + 0.5 )
+                    << " ms | Dropped = "
+                    << stats.framesDropped;
+    }
+
+    glutSetWindowTitle( titleStream.str().c_str() );
 }
 
 //-*****************************************************************************
@@ -125,12 +149,7 @@ void init( void )
 
     g_state.scene.cam.frame( g_transport->getBounds() );
 
-    std::ostringstream titleStream;
-    titleStream << "Archive = " 
-                << g_transport->getFileName()
-                << " | Frame = "
-                << g_transport->getCurrentFrame();
-    glutSetWindowTitle( titleStream.str().c_str() );
+    updateTitle();
 }
 
 //-*****************************************************************************
@@ -139,12 +158,7 @@ static void TickForward()
 {
     g_transport->tickForward();
 
-    std::ostringstream titleStream;
-    titleStream << "Archive = " 
-                << g_transport->getFileName()
-                << " | Frame = "
-                << g_transport->getCurrentFrame();
-    glutSetWindowTitle( titleStream.str().c_str() );
+    updateTitle();
     
     g_state.scene.cam.autoSetClippingPlanes( g_transport->getBounds() );
     glutPostRedisplay();
@@ -155,12 +169,7 @@ static void TickBackward()
 {
     g_transport->tickBackward();
     
-    std::ostringstream titleStream;
-    titleStream << "Archive = " 
-                << g_transport->getFileName()
-                << " | Frame = "
-                << g_transport->getCurrentFrame();
-    glutSetWindowTitle( titleStream.str().c_str() );
+    updateTitle();
 
     g_state.scene.cam.autoSetClippingPlanes( g_transport->getBounds() );
     glutPostRedisplay();
@@ -179,22 +188,15 @@ void turntableIdle()
 }
 
 //-*****************************************************************************
-void playFwdIdle()
+// The transport loads frames ahead on its own threads and keeps time, so
+// this only redraws when it has a new frame.
+void playIdle()
 {
-    if ( g_playbackTimer.elapsed() > 1.0/g_state.fps )
+    if ( g_transport->update() )
     {
-        g_playbackTimer.restart();
-        TickForward();
-    }
-}
-
-//-*****************************************************************************
-void playBwdIdle()
-{
-    if ( g_playbackTimer.elapsed() > 1.0/g_state.fps )
-    {
-        g_playbackTimer.restart();
-        TickBackward();
+        updateTitle();
+        g_state.scene.cam.autoSetClippingPlanes( g_transport->getBounds() );
+        glutPostRedisplay();
     }
 }
 
@@ -350,12 +352,14 @@ void keyboard( unsigned char key, int x, int y )
         if ( g_state.playback == kForward )
         {
             g_state.playback = kStopped;
+            g_transport->play( 0 );
             glutIdleFunc( NULL );
         }
         else
         {
             g_state.playback = kForward;
-            glutIdleFunc( playFwdIdle );
+            g_transport->play( 1 );
+            glutIdleFunc( playIdle );
         }
         break;
     case '<':
@@ -363,16 +367,19 @@ void keyboard( unsigned char key, int x, int y )
         if ( g_state.playback == kBackward )
         {
             g_state.playback = kStopped;
+            g_transport->play( 0 );
             glutIdleFunc( NULL );
         }
         else
         {
             g_state.playback = kBackward;
-            glutIdleFunc( playBwdIdle );
+            g_transport->play( -1 );
+            glutIdleFunc( playIdle );
         }
         break;
     case 't':
     case 'T':
+        g_transport->play( 0 );
         if ( g_state.playback == kTurntable )
         {
             g_state.playback = kStopped;
@@ -384,6 +391,11 @@ void keyboard( unsigned char key, int x, int y )
             glutIdleFunc( turntableIdle );
         }
         break;
+    case 's':
+    case 'S':
+        g_state.showStats = !g_state.showStats;
+        updateTitle();
+        break;
     case 'r':
     case 'R':
         RenderIt();
@@ -520,9 +532,13 @@ int SimpleViewScene( int argc, char *argv[] )
     "  -h [ --help ]         prints this help message\n"
     "  -f [ --file ] arg     abc file name\n"
     "  --fps arg             frames per second for playback (default=24.0)\n"
+    "  --cache arg           frames loaded ahead of playback (default=8)\n"
+    "  --threads arg         threads loading frames ahead (default=2)\n"
     "  -P [ --riPlugin ] arg full path to AlembicRiPlugin.so\n"
     "  --rndrScript arg      full path to Render Script" );
     float fps = 24.0f;
+    int cacheFrames = 8;
+    int numThreads = 2;
 
     // help
     if ( argc < 2 ||
@@ -565,6 +581,16 @@ int SimpleViewScene( int argc, char *argv[] )
                     getOption( argv, argv + argc, "--fps" ) ).c_str() 
                 );
 
+    if ( optionExists( argv, argv + argc, "--cache" ) )
+        cacheFrames = std::atoi( string( 
+                    getOption( argv, argv + argc, "--cache" ) ).c_str() 
+                );
+
+    if ( optionExists( argv, argv + argc, "--threads" ) )
+        numThreads = std::atoi( string( 
+                    getOption( argv, argv + argc, "--threads" ) ).c_str() 
+                );
+
     if ( optionExists( argv, argv + argc, "--rndrScript" ) )
         RenderScript = string( 
                 getOption( argv, argv + argc, "--rndrScript" ) 
@@ -577,6 +603,9 @@ int SimpleViewScene( int argc, char *argv[] )
         // Set up the state.
         g_state.abcFileName = abcFileName;
         g_state.fps = fps;
+        g_state.cacheFrames = std::max( cacheFrames, 2 );
+        g_state.numThreads = std::max( numThreads, 0 );
+        g_state.showStats = false;
         g_state.playback = kStopped;
         g_state.AlembicRiPluginDsoPath = AlembicRiPluginDsoPath;
         g_state.RenderScript = RenderScript;
@@ -67,6 +67,11 @@ struct State
     std::string abcFileName;
     chrono_t fps;
 
+    // Playback frame cache.
+    size_t cacheFrames;
+    size_t numThreads;
+    bool showStats;
+
     PlaybackState playback;
 
     SceneState scene;
@@ -49,6 +49,7 @@
 #include <AbcOpenGL/ISubDDrw.h>
 #include <AbcOpenGL/IXformDrw.h>
 #include <AbcOpenGL/MeshDrwHelper.h>
+#include <AbcOpenGL/Playback.h>
 #include <AbcOpenGL/Scene.h>
 #include <AbcOpenGL/SceneWrapper.h>
 
@@ -73,6 +73,15 @@ public:
     //! to a new time, in seconds.
     virtual void setTime( chrono_t iSeconds ) = 0;
 
+    //! This function returns whether neither the drawable nor any of
+    //! its children change over time, so that once any time has been
+    //! set, setting another one changes nothing.
+    virtual bool isConstant() { return getMinTime() >= getMaxTime(); }
+
+    //! This function sets how many threads setTime may use to update
+    //! the children.  Drawables without children ignore it.
+    virtual void setNumThreads( size_t iNumThreads ) {}
+
     //! This function gets the bounding box at the
     //! currently set time.
     virtual Box3d getBounds() = 0;
@@ -90,6 +99,13 @@ public:
 typedef Alembic::Util::shared_ptr<Drawable> DrawablePtr;
 typedef std::vector<DrawablePtr> DrawablePtrVec;
 
+//-*****************************************************************************
+//! The threads setTime runs on, shared by every drawable, whether updating
+//! children or splitting up the work of one drawable, so that setTime doesn't
+//! start and stop threads.  It grows to the most threads any drawable has
+//! been given.
+Alembic::Util::WorkerPool &GetUpdatePool();
+
 } // End namespace ABCOPENGL_VERSION_NS
 
 using namespace ABCOPENGL_VERSION_NS;
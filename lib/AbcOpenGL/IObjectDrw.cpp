@@ -43,9 +43,29 @@
 #include "INuPatchDrw.h"
 #include "Scene.h"
 
+#include <Alembic/Util/WorkerPool.h>
+
 namespace AbcOpenGL {
 namespace ABCOPENGL_VERSION_NS {
 
+namespace {
+
+//-*****************************************************************************
+Alembic::Util::WorkerPool g_updatePool;
+
+// With fewer animated children than this they are updated one after the
+// other on the calling thread, which then hands all of its threads on to
+// each child in turn.
+const size_t kMinParallelUpdates = 4;
+
+} // End namespace
+
+//-*****************************************************************************
+Alembic::Util::WorkerPool &GetUpdatePool()
+{
+    return g_updatePool;
+}
+
 //-*****************************************************************************
 int pushName( IObject &iObj )
 {
@@ -79,6 +99,7 @@ IObjectDrw::IObjectDrw( IObject &iObj, bool iResetIfNoChildren )
   : m_object( iObj )
   , m_minTime( ( chrono_t )FLT_MAX )
   , m_maxTime( ( chrono_t )-FLT_MAX )
+  , m_numThreads( 1 )
 {
     // If not valid, just bail.
     if ( !m_object ) { return; }
@@ -156,6 +177,25 @@ IObjectDrw::IObjectDrw( IObject &iObj, bool iResetIfNoChildren )
         }
     }
 
+    // An animated visibility makes the object animated too, otherwise
+    // it would be skipped when the time changes.
+    Abc::ICompoundProperty props = m_object.getProperties();
+    const Abc::PropertyHeader *visHeader = props.getPropertyHeader( "visible" );
+    if ( visHeader != NULL && visHeader->isScalar() )
+    {
+        Abc::IScalarProperty visible( props, "visible" );
+        size_t numSamps = visible.getNumSamples();
+        if ( !visible.isConstant() && numSamps > 0 )
+        {
+            TimeSamplingPtr iTsmp = visible.getTimeSampling();
+            m_minTime = std::min( m_minTime, iTsmp->getSampleTime( 0 ) );
+            m_maxTime = std::max( m_maxTime,
+                                  iTsmp->getSampleTime( numSamps-1 ) );
+        }
+    }
+
+    m_childLoaded.resize( m_children.size(), 0 );
+
     // Make the bounds empty to start
     m_bounds.makeEmpty();
 
@@ -199,17 +239,214 @@ void IObjectDrw::setTime( chrono_t iTime )
     m_currentTime = iTime;
 
     // Object itself has no properties to worry about.
-    m_bounds.makeEmpty();
-    for ( DrawablePtrVec::iterator iter = m_children.begin();
-          iter != m_children.end(); ++iter )
+    Box3d nonInheritedBounds;
+    updateChildren( iTime, m_bounds, nonInheritedBounds );
+}
+
+//-*****************************************************************************
+void IObjectDrw::setNumThreads( size_t iNumThreads )
+{
+    m_numThreads = std::max( iNumThreads, ( size_t )1 );
+}
+
+//-*****************************************************************************
+// What the threads updating the children of one drawable share, everything
+// but the children themselves is guarded by lock.
+struct IObjectDrw::UpdateWork
+{
+    UpdateWork( IObjectDrw *iDrw, const std::vector<char> &iUpdate,
+                chrono_t iTime, size_t iChunk )
+      : drw( iDrw ), update( iUpdate ), time( iTime ), chunk( iChunk )
+      , next( 0 )
     {
-        DrawablePtr dptr = (*iter);
-        if ( dptr )
+        bounds.makeEmpty();
+        nonInheritedBounds.makeEmpty();
+    }
+
+    IObjectDrw *drw;
+    const std::vector<char> &update;
+    chrono_t time;
+    size_t chunk;
+
+    Alembic::Util::mutex lock;
+    size_t next;
+    Box3d bounds;
+    Box3d nonInheritedBounds;
+
+    // the first thing to go wrong, which stops every thread
+    std::string error;
+};
+
+//-*****************************************************************************
+void IObjectDrw::updateChildrenTask( void *iWork )
+{
+    UpdateWork &work = *( static_cast<UpdateWork *>( iWork ) );
+    DrawablePtrVec &children = work.drw->m_children;
+
+    // each thread gathers the bounds of the children it took, then they
+    // are combined once at the end
+    Box3d bounds;
+    bounds.makeEmpty();
+    Box3d nonInheritedBounds;
+    nonInheritedBounds.makeEmpty();
+
+    for ( ;; )
+    {
+        size_t begin = 0;
+        size_t end = 0;
+        {
+            Alembic::Util::scoped_lock l( work.lock );
+            if ( work.next == children.size() )
+            {
+                break;
+            }
+            begin = work.next;
+            end = std::min( begin + work.chunk, children.size() );
+            work.next = end;
+        }
+
+        try
+        {
+            for ( size_t i = begin; i < end; ++i )
+            {
+                DrawablePtr dptr = children[i];
+                if ( !dptr )
+                {
+                    continue;
+                }
+
+                if ( work.update[i] )
+                {
+                    dptr->setTime( work.time );
+                }
+                work.drw->addChildBounds( *dptr, bounds, nonInheritedBounds );
+            }
+        }
+        catch ( std::exception &e )
+        {
+            Alembic::Util::scoped_lock l( work.lock );
+            if ( work.error.empty() )
+            {
+                work.error = e.what();
+            }
+            work.next = children.size();
+        }
+    }
+
+    Alembic::Util::scoped_lock l( work.lock );
+    work.bounds.extendBy( bounds );
+    work.nonInheritedBounds.extendBy( nonInheritedBounds );
+}
+
+//-*****************************************************************************
+void IObjectDrw::updateChildren( chrono_t iTime, Box3d &oBounds,
+                                 Box3d &oNonInheritedBounds )
+{
+    // Constant children only need their one sample read, the first time.
+    std::vector<char> update( m_children.size(), 0 );
+    size_t numUpdates = 0;
+    for ( size_t i = 0; i < m_children.size(); ++i )
+    {
+        if ( m_children[i] &&
+             ( !m_childLoaded[i] || !m_children[i]->isConstant() ) )
+        {
+            update[i] = 1;
+            ++numUpdates;
+
+            // only ever written once, so that shareConstantChildren may
+            // read it while we are being set to another time
+            if ( !m_childLoaded[i] )
+            {
+                m_childLoaded[i] = 1;
+            }
+        }
+    }
+
+    // The threads are shared out between the children being updated, so
+    // a lone animated child gets all of them for its own children.
+    size_t numThreads = std::min( m_numThreads, numUpdates );
+    if ( numUpdates < kMinParallelUpdates )
+    {
+        numThreads = 1;
+    }
+    size_t childThreads = std::max( m_numThreads / numThreads, ( size_t )1 );
+    for ( size_t i = 0; i < m_children.size(); ++i )
+    {
+        if ( update[i] )
+        {
+            m_children[i]->setNumThreads( childThreads );
+        }
+    }
+
+    // Small chunks, so a thread which got slow children isn't left
+    // working alone at the end.
+    size_t chunk = std::max( m_children.size() /
+        ( std::max( numThreads, ( size_t )1 ) * 8 ), ( size_t )1 );
+    UpdateWork work( this, update, iTime, chunk );
+
+    if ( numThreads > 1 )
+    {
+        // This thread works too.
+        g_updatePool.reserve( m_numThreads - 1 );
+        Alembic::Util::TaskGroup group( g_updatePool );
+        for ( size_t i = 1; i < numThreads; ++i )
         {
-            dptr->setTime( iTime );
-            m_bounds.extendBy( dptr->getBounds() );
+            group.run( updateChildrenTask, &work );
         }
+        updateChildrenTask( &work );
+        group.wait();
     }
+    else
+    {
+        updateChildrenTask( &work );
+    }
+
+    ABCA_ASSERT( work.error.empty(), "Could not set the time of the children "
+                 "of " << m_object.getFullName() << ": " << work.error );
+
+    oBounds = work.bounds;
+    oNonInheritedBounds = work.nonInheritedBounds;
+}
+
+//-*****************************************************************************
+void IObjectDrw::shareConstantChildren( IObjectDrw &iOther )
+{
+    // both were made from the same object, so the children line up, unless
+    // one of them has since become invalid
+    if ( m_children.size() != iOther.m_children.size() )
+    {
+        return;
+    }
+
+    for ( size_t i = 0; i < m_children.size(); ++i )
+    {
+        DrawablePtr other = iOther.m_children[i];
+        if ( !other || !m_children[i] )
+        {
+            continue;
+        }
+
+        if ( other->isConstant() && iOther.m_childLoaded[i] )
+        {
+            m_children[i] = other;
+            m_childLoaded[i] = 1;
+            continue;
+        }
+
+        IObjectDrw *child = dynamic_cast<IObjectDrw *>( m_children[i].get() );
+        IObjectDrw *otherChild = dynamic_cast<IObjectDrw *>( other.get() );
+        if ( child && otherChild )
+        {
+            child->shareConstantChildren( *otherChild );
+        }
+    }
+}
+
+//-*****************************************************************************
+void IObjectDrw::addChildBounds( Drawable &iChild, Box3d &ioBounds,
+                                 Box3d &ioNonInheritedBounds )
+{
+    ioBounds.extendBy( iChild.getBounds() );
 }
 
 //-*****************************************************************************
@@ -62,11 +62,33 @@ public:
 
     virtual void setTime( chrono_t iSeconds );
 
+    virtual void setNumThreads( size_t iNumThreads );
+
     virtual Box3d getBounds();
 
     virtual void draw( const DrawContext & iCtx );
 
+    //! Makes the children which never change the very drawables iOther,
+    //! a drawable of the same object which has already been set to a time,
+    //! holds for them, so that their samples are read and held only once.
+    //! The animated children share theirs in turn.
+    void shareConstantChildren( IObjectDrw &iOther );
+
 protected:
+    //! Sets the children to iSeconds, skipping the constant ones once
+    //! they have been set, with the animated ones spread across up to
+    //! m_numThreads threads of a pool shared by every drawable.  The
+    //! bounds of every child are then folded into oBounds and
+    //! oNonInheritedBounds with addChildBounds, which are emptied first.
+    void updateChildren( chrono_t iSeconds, Box3d &oBounds,
+                         Box3d &oNonInheritedBounds );
+
+    //! Folds the bounds of a child, already set to the current time, into
+    //! ioBounds and ioNonInheritedBounds.  This is called from several
+    //! threads at once, each with its own boxes.
+    virtual void addChildBounds( Drawable &iChild, Box3d &ioBounds,
+                                 Box3d &ioNonInheritedBounds );
+
     IObject m_object;
 
     chrono_t m_currentTime;
@@ -76,6 +98,16 @@ protected:
     DrawablePtrVec m_children;
 
     Box3d m_bounds;
+
+    // whether each child has been set to any time yet
+    std::vector<char> m_childLoaded;
+    size_t m_numThreads;
+
+private:
+    struct UpdateWork;
+
+    // what each thread of updateChildren runs
+    static void updateChildrenTask( void *iWork );
 };
 
 } // End namespace ABCOPENGL_VERSION_NS
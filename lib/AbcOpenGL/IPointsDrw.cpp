@@ -80,6 +80,22 @@ IPointsDrw::IPointsDrw( IPoints &iPmesh )
             m_maxTime = std::max( m_maxTime, maxTime );
         }
     }
+
+    // Colors and normals may be animated on their own.
+    std::vector<IArrayProperty> extraProps;
+    if ( m_colorProp ) { extraProps.push_back( m_colorProp ); }
+    if ( m_normalProp ) { extraProps.push_back( m_normalProp ); }
+    for ( size_t i = 0; i < extraProps.size(); ++i )
+    {
+        size_t numSamps = extraProps[i].getNumSamples();
+        if ( !extraProps[i].isConstant() && numSamps > 0 )
+        {
+            iTsmp = extraProps[i].getTimeSampling();
+            m_minTime = std::min( m_minTime, iTsmp->getSampleTime( 0 ) );
+            m_maxTime = std::max( m_maxTime,
+                                  iTsmp->getSampleTime( numSamps-1 ) );
+        }
+    }
 }
 
 //-*****************************************************************************
@@ -124,6 +124,7 @@ void IPolyMeshDrw::setTime( chrono_t iSeconds )
     }
 
     // Update the mesh hoo-ha.
+    m_drwHelper.setNumThreads( m_numThreads );
     m_drwHelper.update( P, V3fArraySamplePtr(),
                         indices, counts, bounds );
 
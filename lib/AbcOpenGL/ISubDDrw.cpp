@@ -122,6 +122,7 @@ void ISubDDrw::setTime( chrono_t iSeconds )
     { bounds = m_boundsProp.getValue( ss ); }
 
     // Update the mesh hoo-ha.
+    m_drwHelper.setNumThreads( m_numThreads );
     m_drwHelper.update( P, V3fArraySamplePtr(),
                         indices, counts, bounds );
 
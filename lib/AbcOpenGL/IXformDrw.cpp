@@ -91,14 +91,16 @@ bool IXformDrw::valid()
 //-*****************************************************************************
 void IXformDrw::setTime( chrono_t iSeconds )
 {
-    // Let the object set the time of all the children
-    IObjectDrw::setTime( iSeconds );
     if ( !valid() )
     {
+        // Let the object set the time of all the children
+        IObjectDrw::setTime( iSeconds );
         m_localToParent.makeIdentity();
         return;
     }
 
+    m_currentTime = iSeconds;
+
     ISampleSelector ss( iSeconds, ISampleSelector::kNearIndex );
 
     m_inherits = m_xform.getSchema().getInheritsXforms( ss );
@@ -112,35 +114,33 @@ void IXformDrw::setTime( chrono_t iSeconds )
         m_localToParent = m_xform.getSchema().getValue( ss ).getMatrix();
     }
 
-    // Okay, now we need to recalculate the bounds.
-    m_bounds.makeEmpty();
-    m_nonInheritedBounds.makeEmpty();
-    for ( DrawablePtrVec::iterator iter = m_children.begin();
-          iter != m_children.end(); ++iter )
+    // The matrix is needed first, the children's bounds are transformed
+    // by it as they are gathered.
+    updateChildren( iSeconds, m_bounds, m_nonInheritedBounds );
+}
+
+//-*****************************************************************************
+void IXformDrw::addChildBounds( Drawable &iChild, Box3d &ioBounds,
+                                Box3d &ioNonInheritedBounds )
+{
+    Box3d bnds = iChild.getBounds();
+    if ( !bnds.isEmpty() )
     {
-        DrawablePtr dptr = (*iter);
-        if ( dptr )
+        bnds = Imath::transform( bnds, m_localToParent );
+        if ( !m_inherits )
         {
-            Box3d bnds = dptr->getBounds();
-            if ( !bnds.isEmpty() )
-            {
-                bnds = Imath::transform( bnds, m_localToParent );
-                if ( !m_inherits )
-                {
-                    m_nonInheritedBounds.extendBy( bnds );
-                }
-                else
-                {
-                    m_bounds.extendBy( bnds );
-                }
-            }
-
-            Box3d ibnds = dptr->getNonInheritedBounds();
-            if ( !ibnds.isEmpty() )
-            {
-                m_nonInheritedBounds.extendBy( ibnds );
-            }
+            ioNonInheritedBounds.extendBy( bnds );
         }
+        else
+        {
+            ioBounds.extendBy( bnds );
+        }
+    }
+
+    Box3d ibnds = iChild.getNonInheritedBounds();
+    if ( !ibnds.isEmpty() )
+    {
+        ioNonInheritedBounds.extendBy( ibnds );
     }
 }
 
@@ -64,6 +64,9 @@ public:
     virtual Box3d getNonInheritedBounds() { return m_nonInheritedBounds; };
 
 protected:
+    virtual void addChildBounds( Drawable &iChild, Box3d &ioBounds,
+                                 Box3d &ioNonInheritedBounds );
+
     IXform m_xform;
     M44d m_localToParent;
     M44d m_staticMatrix;
@@ -41,6 +41,7 @@ namespace ABCOPENGL_VERSION_NS {
 
 //-*****************************************************************************
 MeshDrwHelper::MeshDrwHelper()
+  : m_numThreads( 1 )
 {
     makeInvalid();
 }
@@ -83,7 +84,7 @@ void MeshDrwHelper::update( P3fArraySamplePtr iP,
     m_meshP = iP;
     m_meshIndices = iIndices;
     m_meshCounts = iCounts;
-    m_triangles.clear ();
+    m_triangulation.reset();
 
     // Check stuff.
     if ( !m_meshP ||
@@ -114,68 +115,9 @@ void MeshDrwHelper::update( P3fArraySamplePtr iP,
         return;
     }
 
-    // Make triangles.
-    size_t faceIndexBegin = 0;
-    size_t faceIndexEnd = 0;
-    for ( size_t face = 0; face < numFaces; ++face )
-    {
-        faceIndexBegin = faceIndexEnd;
-        size_t count = (*m_meshCounts)[face];
-        faceIndexEnd = faceIndexBegin + count;
-
-        // Check this face is valid
-        if ( faceIndexEnd > numIndices ||
-             faceIndexEnd < faceIndexBegin )
-        {
-            std::cerr << "Mesh update quitting on face: "
-                      << face
-                      << " because of wonky numbers"
-                      << ", faceIndexBegin = " << faceIndexBegin
-                      << ", faceIndexEnd = " << faceIndexEnd
-                      << ", numIndices = " << numIndices
-                      << ", count = " << count
-                      << std::endl;
-
-            // Just get out, make no more triangles.
-            break;
-        }
-
-        // Checking indices are valid.
-        bool goodFace = true;
-        for ( size_t fidx = faceIndexBegin;
-              fidx < faceIndexEnd; ++fidx )
-        {
-            if ( ( size_t ) ( (*m_meshIndices)[fidx] ) >= numPoints )
-            {
-                std::cout << "Mesh update quitting on face: "
-                          << face
-                          << " because of bad indices"
-                          << ", indexIndex = " << fidx
-                          << ", vertexIndex = " << (*m_meshIndices)[fidx]
-                          << ", numPoints = " << numPoints
-                          << std::endl;
-                goodFace = false;
-                break;
-            }
-        }
-
-        // Make triangles to fill this face.
-        if ( goodFace && count > 2 )
-        {
-            m_triangles.push_back(
-                Tri( ( unsigned int )(*m_meshIndices)[faceIndexBegin+0],
-                     ( unsigned int )(*m_meshIndices)[faceIndexBegin+1],
-                     ( unsigned int )(*m_meshIndices)[faceIndexBegin+2] ) );
-            for ( size_t c = 3; c < count; ++c )
-            {
-                m_triangles.push_back(
-                    Tri( ( unsigned int )(*m_meshIndices)[faceIndexBegin+0],
-                         ( unsigned int )(*m_meshIndices)[faceIndexBegin+c-1],
-                         ( unsigned int )(*m_meshIndices)[faceIndexBegin+c]
-                         ) );
-            }
-        }
-    }
+    // Make triangles, or share those of a mesh with the same topology.
+    m_triangulation = GetTriangulation( m_meshIndices, m_meshCounts,
+                                        numPoints );
 
     // Cool, we made triangles.
     // Pretend the mesh is made...
@@ -193,6 +135,8 @@ void MeshDrwHelper::update( P3fArraySamplePtr iP,
         m_bounds = iBounds;
     }
 
+    // The points or the triangles changed, so computed normals are stale.
+    m_customN.clear();
     updateNormals( iN );
 
     // And that's it.
@@ -223,6 +167,8 @@ void MeshDrwHelper::update( P3fArraySamplePtr iP,
         m_bounds = iBounds;
     }
 
+    // The points moved, so computed normals are stale.
+    m_customN.clear();
     updateNormals( iN );
 }
 
@@ -252,37 +198,21 @@ void MeshDrwHelper::updateNormals( V3fArraySamplePtr iN )
     {
         // Make some custom normals.
         m_meshN.reset();
-        m_customN.resize( numPoints );
-        std::fill( m_customN.begin(), m_customN.end(), V3f( 0.0f ) );
 
         //std::cout << "Recalcing normals for object: "
         //          << m_host.name() << std::endl;
 
-        for ( size_t tidx = 0; tidx < m_triangles.size(); ++tidx )
-        {
-            const Tri &tri = m_triangles[tidx];
-
-            const V3f &A = (*m_meshP)[tri[0]];
-            const V3f &B = (*m_meshP)[tri[1]];
-            const V3f &C = (*m_meshP)[tri[2]];
-
-            V3f AB = B - A;
-            V3f AC = C - A;
-
-            V3f wN = AB.cross( AC );
-            m_customN[tri[0]] += wN;
-            m_customN[tri[1]] += wN;
-            m_customN[tri[2]] += wN;
-        }
-
-        // Normalize normals.
-        for ( size_t nidx = 0; nidx < numPoints; ++nidx )
-        {
-            m_customN[nidx].normalize();
-        }
+        ComputeSmoothNormals( m_meshP->get(), numPoints, *m_triangulation,
+                              m_customN, m_numThreads );
     }
 }
 
+//-*****************************************************************************
+void MeshDrwHelper::setNumThreads( size_t iNumThreads )
+{
+    m_numThreads = std::max( iNumThreads, ( size_t )1 );
+}
+
 //-*****************************************************************************
 void MeshDrwHelper::drawBounds( const DrawContext & iCtx ) const
 {
@@ -355,11 +285,14 @@ void drawBoundingBox( const Box3d bounds, const int mode )
 void MeshDrwHelper::draw( const DrawContext & iCtx ) const
 {
     // Bail if invalid.
-    if ( !m_valid || m_triangles.size() < 1 || !m_meshP )
+    if ( !m_valid || !m_triangulation ||
+         m_triangulation->triangles.size() < 1 || !m_meshP )
     {
         return;
     }
 
+    const std::vector<Tri> &triangles = m_triangulation->triangles;
+
     const V3f *points = m_meshP->get();
     const V3f *normals = NULL;
     if ( m_meshN  && ( m_meshN->size() == m_meshP->size() ) )
@@ -386,9 +319,9 @@ void MeshDrwHelper::draw( const DrawContext & iCtx ) const
                                    ( const GLvoid * )points ) );
 
         GL_NOISY( glDrawElements( GL_TRIANGLES,
-                                  ( GLsizei )m_triangles.size() * 3,
+                                  ( GLsizei )triangles.size() * 3,
                                   GL_UNSIGNED_INT,
-                                  ( const GLvoid * )&(m_triangles[0]) ) );
+                                  ( const GLvoid * )&(triangles[0]) ) );
 
         if ( normals )
         {
@@ -399,9 +332,9 @@ void MeshDrwHelper::draw( const DrawContext & iCtx ) const
 #else
     glBegin( GL_TRIANGLES );
 
-    for ( size_t i = 0; i < m_triangles.size(); ++i )
+    for ( size_t i = 0; i < triangles.size(); ++i )
     {
-        const Tri &tri = m_triangles[i];
+        const Tri &tri = triangles[i];
         const V3f &vertA = points[tri[0]];
         const V3f &vertB = points[tri[1]];
         const V3f &vertC = points[tri[2]];
@@ -455,7 +388,7 @@ void MeshDrwHelper::makeInvalid()
     m_customN.clear();
     m_valid = false;
     m_bounds.makeEmpty();
-    m_triangles.clear();
+    m_triangulation.reset();
 }
 
 //-*****************************************************************************
@@ -39,6 +39,7 @@
 
 #include "Foundation.h"
 #include "DrawContext.h"
+#include "Triangulation.h"
 
 namespace AbcOpenGL {
 namespace ABCOPENGL_VERSION_NS {
@@ -74,6 +75,9 @@ public:
     // Update just normals
     void updateNormals( V3fArraySamplePtr iN );
 
+    // Computed normals of big meshes are split across this many threads.
+    void setNumThreads( size_t iNumThreads );
+
     // This returns validity.
     bool valid() const { return m_valid; }
 
@@ -92,8 +96,7 @@ public:
 protected:
     void computeBounds();
 
-    typedef Imath::Vec3<unsigned int> Tri;
-    typedef std::vector<Tri> TriArray;
+    typedef Triangulation::Tri Tri;
 
     P3fArraySamplePtr m_meshP;
     V3fArraySamplePtr m_meshN;
@@ -106,7 +109,10 @@ protected:
 
     Box3d m_bounds;
 
-    TriArray m_triangles;
+    // Shared with every other mesh of the same topology.
+    TriangulationPtr m_triangulation;
+
+    size_t m_numThreads;
 };
 
 } // End namespace ABCOPENGL_VERSION_NS
@@ -0,0 +1,542 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2009-2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include "Playback.h"
+
+namespace AbcOpenGL {
+namespace ABCOPENGL_VERSION_NS {
+
+namespace {
+
+//-*****************************************************************************
+// holds a monitor locked until it goes out of scope
+class MonitorLock : private Alembic::Util::noncopyable
+{
+public:
+    MonitorLock( Alembic::Util::monitor &iMonitor ) : m_monitor( iMonitor )
+    {
+        m_monitor.lock();
+    }
+
+    ~MonitorLock() { m_monitor.unlock(); }
+
+private:
+    Alembic::Util::monitor &m_monitor;
+};
+
+} // End namespace
+
+//-*****************************************************************************
+Playback::Playback( const std::string &iFileName,
+                    chrono_t iFps,
+                    size_t iCacheFrames,
+                    size_t iNumThreads )
+  : m_fileName( iFileName )
+  , m_fps( iFps )
+  , m_numFrames( 1 )
+  , m_monitor( NULL )
+  , m_stop( false )
+  , m_slots( std::max( iCacheFrames, ( size_t )2 ) )
+  , m_shown( 0 )
+  , m_playhead( 0 )
+  , m_direction( 0 )
+  , m_clockFrame( 0 )
+  , m_totalDecodeTime( 0.0 )
+{
+    ABCA_ASSERT( m_fps > 0.0, "Invalid frames per second: " << m_fps );
+
+    m_slots[0].scene = new Scene( m_fileName );
+    m_slots[0].state = kReady;
+
+    m_minTime = m_slots[0].scene->getMinTime();
+    m_maxTime = m_slots[0].scene->getMaxTime();
+    if ( !m_slots[0].scene->isConstant() )
+    {
+        m_numFrames = 1 + ( size_t )floor(
+            ( m_maxTime - m_minTime ) * m_fps + 1.0e-6 );
+    }
+
+    m_monitor = new Alembic::Util::monitor();
+
+    // nothing to load ahead of a single frame
+    for ( size_t i = 0; m_numFrames > 1 && i < iNumThreads; ++i )
+    {
+        Alembic::Util::thread *thread =
+            new Alembic::Util::thread( workThread, this );
+        if ( thread->valid() )
+        {
+            m_threads.push_back( thread );
+        }
+        else
+        {
+            delete thread;
+        }
+    }
+
+    // each frame is loaded by one thread, they are spread across frames
+    // instead
+    if ( !m_threads.empty() )
+    {
+        m_slots[0].scene->setNumThreads( 1 );
+    }
+}
+
+//-*****************************************************************************
+Playback::~Playback()
+{
+    {
+        MonitorLock l( *m_monitor );
+        m_stop = true;
+        m_monitor->notify_all();
+    }
+
+    for ( size_t i = 0; i < m_threads.size(); ++i )
+    {
+        m_threads[i]->join();
+        delete m_threads[i];
+    }
+
+    for ( size_t i = 0; i < m_slots.size(); ++i )
+    {
+        delete m_slots[i].scene;
+    }
+
+    delete m_monitor;
+}
+
+//-*****************************************************************************
+void *Playback::workThread( void *iPlayback )
+{
+    static_cast<Playback *>( iPlayback )->work();
+    return NULL;
+}
+
+//-*****************************************************************************
+void Playback::work()
+{
+    MonitorLock l( *m_monitor );
+
+    for ( ;; )
+    {
+        size_t slot = 0;
+        size_t frame = 0;
+        while ( !m_stop && !findWork( slot, frame ) )
+        {
+            m_monitor->wait();
+        }
+
+        if ( m_stop )
+        {
+            return;
+        }
+
+        m_slots[slot].state = kDecoding;
+        m_slots[slot].frame = frame;
+
+        m_monitor->unlock();
+        decode( slot, frame );
+        m_monitor->lock();
+
+        m_monitor->notify_all();
+    }
+}
+
+//-*****************************************************************************
+void Playback::decode( size_t iSlot, size_t iFrame )
+{
+    std::string error;
+    double seconds = 0.0;
+
+    // no other thread touches a slot which is being loaded
+    Slot &slot = m_slots[iSlot];
+    try
+    {
+        Alembic::Util::Timer timer;
+        chrono_t time = m_minTime + iFrame / m_fps;
+        if ( slot.scene )
+        {
+            slot.scene->setTime( time );
+        }
+        else
+        {
+            // the first scene is never let go, and is the one which holds
+            // the drawables every scene shares
+            slot.scene = new Scene( *m_slots[0].scene, time );
+        }
+        seconds = timer.elapsed();
+    }
+    catch ( std::exception &e )
+    {
+        error = e.what();
+    }
+    catch ( ... )
+    {
+        error = "Unknown error loading frame";
+    }
+
+    m_monitor->lock();
+    if ( error.empty() )
+    {
+        slot.state = kReady;
+        ++m_stats.framesDecoded;
+        m_stats.lastDecodeTime = seconds;
+        m_totalDecodeTime += seconds;
+        m_stats.meanDecodeTime = m_totalDecodeTime / m_stats.framesDecoded;
+    }
+    else
+    {
+        slot.state = kEmpty;
+        if ( m_error.empty() )
+        {
+            m_error = error;
+        }
+    }
+    m_monitor->unlock();
+}
+
+//-*****************************************************************************
+size_t Playback::framesAhead( size_t iFrame ) const
+{
+    if ( m_direction < 0 )
+    {
+        return ( m_playhead + m_numFrames - iFrame ) % m_numFrames;
+    }
+    return ( iFrame + m_numFrames - m_playhead ) % m_numFrames;
+}
+
+//-*****************************************************************************
+bool Playback::isWanted( size_t iFrame ) const
+{
+    if ( m_direction == 0 )
+    {
+        // the neighbours, for stepping
+        return iFrame == m_playhead ||
+            iFrame == ( m_playhead + 1 ) % m_numFrames ||
+            iFrame == ( m_playhead + m_numFrames - 1 ) % m_numFrames;
+    }
+    return framesAhead( iFrame ) < m_slots.size();
+}
+
+//-*****************************************************************************
+size_t Playback::findSlot( size_t iFrame ) const
+{
+    for ( size_t i = 0; i < m_slots.size(); ++i )
+    {
+        if ( m_slots[i].state != kEmpty && m_slots[i].frame == iFrame )
+        {
+            return i;
+        }
+    }
+    return m_slots.size();
+}
+
+//-*****************************************************************************
+bool Playback::findWork( size_t &oSlot, size_t &oFrame ) const
+{
+    std::vector<size_t> frames;
+    if ( m_direction == 0 )
+    {
+        frames.push_back( m_playhead );
+        frames.push_back( ( m_playhead + 1 ) % m_numFrames );
+        frames.push_back( ( m_playhead + m_numFrames - 1 ) % m_numFrames );
+    }
+    else
+    {
+        // start far enough ahead that the frame is ready before the
+        // playhead gets to it
+        size_t lead = ( size_t )ceil( m_stats.meanDecodeTime * m_fps );
+        lead = std::min( std::max( lead, ( size_t )1 ), m_slots.size() - 1 );
+        for ( size_t i = lead; i < m_slots.size(); ++i )
+        {
+            frames.push_back( m_direction > 0 ?
+                ( m_playhead + i ) % m_numFrames :
+                ( m_playhead + m_numFrames - i % m_numFrames ) %
+                m_numFrames );
+        }
+    }
+
+    for ( size_t i = 0; i < frames.size(); ++i )
+    {
+        if ( findSlot( frames[i] ) != m_slots.size() )
+        {
+            continue;
+        }
+
+        // the frame under a stopped playhead may push out any other, the
+        // rest only take frames which are no longer wanted
+        bool urgent = ( m_direction == 0 && i == 0 );
+        for ( size_t s = 0; s < m_slots.size(); ++s )
+        {
+            const Slot &slot = m_slots[s];
+            if ( s != m_shown && slot.state != kDecoding &&
+                 ( urgent || slot.state == kEmpty ||
+                   !isWanted( slot.frame ) ) )
+            {
+                oSlot = s;
+                oFrame = frames[i];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    return false;
+}
+
+//-*****************************************************************************
+void Playback::show( size_t iSlot )
+{
+    if ( m_direction != 0 )
+    {
+        size_t from = m_slots[m_shown].frame;
+        size_t to = m_slots[iSlot].frame;
+        size_t skipped = ( m_direction > 0 ?
+            to + m_numFrames - from : from + m_numFrames - to ) % m_numFrames;
+        if ( skipped > 1 )
+        {
+            m_stats.framesDropped += skipped - 1;
+        }
+    }
+
+    m_shown = iSlot;
+    ++m_stats.framesShown;
+}
+
+//-*****************************************************************************
+void Playback::advance()
+{
+    size_t ticks = ( size_t )floor( m_clock.elapsed() * m_fps );
+    size_t playhead = m_direction > 0 ?
+        ( m_clockFrame + ticks ) % m_numFrames :
+        ( m_clockFrame + m_numFrames - ticks % m_numFrames ) % m_numFrames;
+
+    if ( playhead != m_playhead )
+    {
+        m_playhead = playhead;
+        m_monitor->notify_all();
+    }
+}
+
+//-*****************************************************************************
+void Playback::setDirection( int iDirection )
+{
+    MonitorLock l( *m_monitor );
+
+    m_direction = iDirection > 0 ? 1 : ( iDirection < 0 ? -1 : 0 );
+    m_playhead = m_clockFrame = m_slots[m_shown].frame;
+    m_clock.start();
+    m_monitor->notify_all();
+}
+
+//-*****************************************************************************
+size_t Playback::load( size_t iFrame )
+{
+    // wait for the frame as if stopped, so it is the first to be loaded
+    int direction = m_direction;
+    m_direction = 0;
+    m_playhead = iFrame;
+    m_monitor->notify_all();
+
+    size_t slot = findSlot( iFrame );
+    while ( m_error.empty() &&
+            ( slot == m_slots.size() || m_slots[slot].state != kReady ) )
+    {
+        if ( m_threads.empty() )
+        {
+            // nobody else to load it
+            size_t s = 0;
+            size_t f = 0;
+            findWork( s, f );
+            m_slots[s].state = kDecoding;
+            m_slots[s].frame = f;
+            m_monitor->unlock();
+            decode( s, f );
+            m_monitor->lock();
+        }
+        else
+        {
+            m_monitor->wait();
+        }
+        slot = findSlot( iFrame );
+    }
+
+    m_direction = direction;
+
+    if ( !m_error.empty() )
+    {
+        std::string error = m_error;
+        m_error.clear();
+        ABCA_THROW( error );
+    }
+
+    return slot;
+}
+
+//-*****************************************************************************
+void Playback::step( int iFrames )
+{
+    if ( m_numFrames < 2 )
+    {
+        return;
+    }
+
+    MonitorLock l( *m_monitor );
+
+    long frame = ( ( long )m_slots[m_shown].frame + iFrames ) %
+        ( long )m_numFrames;
+    if ( frame < 0 )
+    {
+        frame += m_numFrames;
+    }
+
+    size_t slot = load( frame );
+
+    // a step isn't a drop, and playback carries on from here
+    int direction = m_direction;
+    m_direction = 0;
+    show( slot );
+    m_direction = direction;
+
+    m_clockFrame = frame;
+    m_clock.start();
+    m_monitor->notify_all();
+}
+
+//-*****************************************************************************
+bool Playback::update()
+{
+    if ( m_direction == 0 || m_numFrames < 2 )
+    {
+        return false;
+    }
+
+    MonitorLock l( *m_monitor );
+
+    if ( !m_error.empty() )
+    {
+        std::string error = m_error;
+        m_error.clear();
+        ABCA_THROW( error );
+    }
+
+    advance();
+
+    size_t shownFrame = m_slots[m_shown].frame;
+    if ( m_threads.empty() )
+    {
+        // without workers each frame is loaded when it is needed
+        if ( m_playhead == shownFrame )
+        {
+            return false;
+        }
+        show( load( m_playhead ) );
+        return true;
+    }
+
+    // the newest ready frame between the one shown and the playhead
+    size_t toPlayhead = framesAhead( shownFrame );
+    toPlayhead = toPlayhead == 0 ? 0 : m_numFrames - toPlayhead;
+
+    size_t best = m_slots.size();
+    size_t bestDistance = 0;
+    for ( size_t s = 0; s < m_slots.size(); ++s )
+    {
+        if ( s == m_shown || m_slots[s].state != kReady )
+        {
+            continue;
+        }
+
+        size_t distance = m_direction > 0 ?
+            ( m_slots[s].frame + m_numFrames - shownFrame ) :
+            ( shownFrame + m_numFrames - m_slots[s].frame );
+        distance %= m_numFrames;
+
+        if ( distance > bestDistance && distance <= toPlayhead )
+        {
+            best = s;
+            bestDistance = distance;
+        }
+    }
+
+    if ( best == m_slots.size() )
+    {
+        return false;
+    }
+
+    show( best );
+    m_monitor->notify_all();
+    return true;
+}
+
+//-*****************************************************************************
+void Playback::draw( SceneState &iState )
+{
+    m_slots[m_shown].scene->draw( iState );
+}
+
+//-*****************************************************************************
+Box3d Playback::getBounds() const
+{
+    return m_slots[m_shown].scene->getBounds();
+}
+
+//-*****************************************************************************
+int Playback::getCurrentFrame() const
+{
+    chrono_t seconds = m_minTime + m_slots[m_shown].frame / m_fps;
+    return ( int )floor( 0.5 + ( seconds * m_fps ) );
+}
+
+//-*****************************************************************************
+PlaybackStats Playback::getStats() const
+{
+    MonitorLock l( *m_monitor );
+
+    PlaybackStats stats = m_stats;
+    stats.cacheSize = m_slots.size();
+    for ( size_t s = 0; s < m_slots.size(); ++s )
+    {
+        if ( s != m_shown && m_slots[s].state == kReady &&
+             isWanted( m_slots[s].frame ) )
+        {
+            ++stats.cacheFilled;
+        }
+    }
+    return stats;
+}
+
+} // End namespace ABCOPENGL_VERSION_NS
+} // End namespace AbcOpenGL
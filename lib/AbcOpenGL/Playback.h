@@ -0,0 +1,219 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2009-2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _AbcOpenGL_Playback_h_
+#define _AbcOpenGL_Playback_h_
+
+#include "Foundation.h"
+#include "Scene.h"
+
+namespace AbcOpenGL {
+namespace ABCOPENGL_VERSION_NS {
+
+//-*****************************************************************************
+//! What a Playback has been doing.
+struct PlaybackStats
+{
+    PlaybackStats()
+      : cacheSize( 0 ), cacheFilled( 0 ), framesDecoded( 0 )
+      , framesShown( 0 ), framesDropped( 0 ), lastDecodeTime( 0.0 )
+      , meanDecodeTime( 0.0 ) {}
+
+    //! How many frames the cache holds, and how many of those are ready
+    //! and still ahead of the playhead.
+    size_t cacheSize;
+    size_t cacheFilled;
+
+    size_t framesDecoded;
+    size_t framesShown;
+
+    //! Frames the playhead passed before they were ready.
+    size_t framesDropped;
+
+    //! Seconds, of wall clock time, to load a frame.
+    double lastDecodeTime;
+    double meanDecodeTime;
+};
+
+//-*****************************************************************************
+//! \brief Plays an archive back at a given frame rate, loading the frames
+//! ahead of the playhead on worker threads.
+//!
+//! The frame cache is a fixed number of Scenes of the archive, which is
+//! opened once.  They share the drawables which never change, so each
+//! only holds the animated samples of its frame.  A worker
+//! takes a Scene which holds no wanted frame, sets it to a frame ahead of
+//! the playhead, and hands it back.  The render thread then only has to
+//! pick which Scene to draw, so no geometry is copied.  The playhead follows
+//! the wall clock, and when the frame under it isn't ready the newest one
+//! that is gets shown instead, so slow frames are dropped rather than
+//! slowing playback down.
+//!
+//! Everything but the workers is meant to be called from the render
+//! thread.
+class Playback : private Alembic::Util::noncopyable
+{
+public:
+    //! Opens the archive, and loads its first frame on the calling thread.
+    Playback( const std::string &iFileName,
+              chrono_t iFps,
+              size_t iCacheFrames = 8,
+              size_t iNumThreads = 2 );
+
+    //! Stops the workers.
+    ~Playback();
+
+    const std::string &getFileName() const { return m_fileName; }
+
+    chrono_t getMinTime() const { return m_minTime; }
+    chrono_t getMaxTime() const { return m_maxTime; }
+    bool isConstant() const { return m_numFrames < 2; }
+
+    //! Plays forward for 1, backward for -1, and stops for 0.  Playing
+    //! starts from the frame being shown.
+    void setDirection( int iDirection );
+    int getDirection() const { return m_direction; }
+
+    //! Moves the playhead by iFrames, wrapping around the ends, and waits
+    //! for that frame to be ready.  Playback, if it was going, carries on
+    //! from there.
+    void step( int iFrames );
+
+    //! Moves the playhead along with the clock, to be called often, for
+    //! instance when the render thread is idle.  Returns true if the frame
+    //! to draw changed.
+    bool update();
+
+    //! Draws the frame being shown.
+    void draw( SceneState &iState );
+
+    //! The bounds of the frame being shown.
+    Box3d getBounds() const;
+
+    //! The frame number being shown.
+    int getCurrentFrame() const;
+
+    PlaybackStats getStats() const;
+
+private:
+    enum SlotState
+    {
+        kEmpty,
+        kDecoding,
+        kReady
+    };
+
+    struct Slot
+    {
+        Slot() : scene( NULL ), frame( 0 ), state( kEmpty ) {}
+
+        Scene *scene;
+        size_t frame;
+        SlotState state;
+    };
+
+    static void *workThread( void *iPlayback );
+
+    // run by each worker until stopped
+    void work();
+
+    // the following must be called with m_monitor locked
+
+    // how many frames iFrame is ahead of the playhead, in the direction of
+    // play
+    size_t framesAhead( size_t iFrame ) const;
+
+    // whether a frame is still to be shown soon
+    bool isWanted( size_t iFrame ) const;
+
+    // the next frame a worker should load into oSlot, false if there is
+    // nothing to do
+    bool findWork( size_t &oSlot, size_t &oFrame ) const;
+
+    // the slot holding iFrame, ready or not, or m_slots.size()
+    size_t findSlot( size_t iFrame ) const;
+
+    // waits until iFrame is ready, loading it on this thread if there are
+    // no workers, and returns its slot
+    size_t load( size_t iFrame );
+
+    // makes iSlot the one drawn, counting the frames skipped over
+    void show( size_t iSlot );
+
+    // moves the playhead with the clock, while playing
+    void advance();
+
+    // loads iFrame into iSlot, which the caller has marked as kDecoding,
+    // with m_monitor unlocked
+    void decode( size_t iSlot, size_t iFrame );
+
+    std::string m_fileName;
+    chrono_t m_fps;
+    chrono_t m_minTime;
+    chrono_t m_maxTime;
+    size_t m_numFrames;
+
+    Alembic::Util::monitor *m_monitor;
+    std::vector<Alembic::Util::thread *> m_threads;
+    bool m_stop;
+
+    std::vector<Slot> m_slots;
+
+    // only changed by the render thread, the workers leave it alone
+    size_t m_shown;
+
+    // the frame which should be on screen now
+    size_t m_playhead;
+    int m_direction;
+
+    // where the playhead was when the clock was started
+    size_t m_clockFrame;
+    Alembic::Util::Timer m_clock;
+
+    PlaybackStats m_stats;
+    double m_totalDecodeTime;
+
+    // the first error a worker ran into, thrown on the render thread
+    std::string m_error;
+};
+
+} // End namespace ABCOPENGL_VERSION_NS
+
+using namespace ABCOPENGL_VERSION_NS;
+
+} // End namespace AbcOpenGL
+
+#endif
@@ -94,10 +94,14 @@ Scene::Scene( const std::string &fileName, bool verbose )
   : m_fileName( fileName )
   , m_minTime( ( chrono_t )FLT_MAX )
   , m_maxTime( ( chrono_t )-FLT_MAX )
+  , m_numThreads( 4 )
 {
     Timer playbackTimer;
 
+    // a stream for each thread setTime uses, so their reads don't wait
+    // on each other
     Alembic::AbcCoreFactory::IFactory factory;
+    factory.setOgawaNumStreams( m_numThreads );
     m_archive = factory.getArchive( fileName );
 
     m_topObject = IObject( m_archive, kTop );
@@ -109,6 +113,7 @@ Scene::Scene( const std::string &fileName, bool verbose )
     m_drawable.reset( new IObjectDrw( m_topObject, false ) );
     ABCA_ASSERT( m_drawable->valid(),
                  "Invalid drawable for archive: " << fileName );
+    m_drawable->setNumThreads( m_numThreads );
 
     if ( verbose )
         std::cout << "Created drawables, getting time range." << std::endl;
@@ -146,6 +151,31 @@ Scene::Scene( const std::string &fileName, bool verbose )
                   << m_bounds.max << std::endl;
 }
 
+//-*****************************************************************************
+Scene::Scene( const Scene &iShareWith, chrono_t iSeconds )
+  : m_fileName( iShareWith.m_fileName )
+  , m_archive( iShareWith.m_archive )
+  , m_topObject( iShareWith.m_topObject )
+  , m_minTime( iShareWith.m_minTime )
+  , m_maxTime( iShareWith.m_maxTime )
+  , m_numThreads( iShareWith.m_numThreads )
+{
+    IObjectDrw *drawable = new IObjectDrw( m_topObject, false );
+    m_drawable.reset( drawable );
+    ABCA_ASSERT( m_drawable->valid(),
+                 "Invalid drawable for archive: " << m_fileName );
+    m_drawable->setNumThreads( m_numThreads );
+
+    IObjectDrw *other =
+        dynamic_cast<IObjectDrw *>( iShareWith.m_drawable.get() );
+    if ( other )
+    {
+        drawable->shareConstantChildren( *other );
+    }
+
+    setTime( iSeconds );
+}
+
 //-*****************************************************************************
 void Scene::setTime( chrono_t iSeconds )
 {
@@ -164,6 +194,16 @@ void Scene::setTime( chrono_t iSeconds )
     m_bounds = m_drawable->getBounds();
 }
 
+//-*****************************************************************************
+void Scene::setNumThreads( size_t iNumThreads )
+{
+    m_numThreads = std::max( iNumThreads, ( size_t )1 );
+    if ( m_drawable )
+    {
+        m_drawable->setNumThreads( m_numThreads );
+    }
+}
+
 //-*****************************************************************************
 int Scene::processHits( GLint hits, GLuint buffer[] )
 {
@@ -81,6 +81,13 @@ public:
     //! ...
     Scene( const std::string &abcFileName, bool verbose = true );
 
+    //! Makes another scene of the archive iShareWith has open, without
+    //! opening it again, and loads it at iSeconds.  The drawables which
+    //! never change are shared with iShareWith rather than read again, so
+    //! only the animated ones are this scene's own.  iShareWith may be set
+    //! to other times meanwhile, but not destroyed.
+    Scene( const Scene &iShareWith, chrono_t iSeconds );
+
     //! Return the filename of the archive
     //! ...
     const std::string &getFileName() const { return m_fileName; }
@@ -98,9 +105,14 @@ public:
     bool isConstant() const { return m_minTime >= m_maxTime; }
 
     //! Cause the drawable state to be loaded to the given time.
-    //! ...
+    //! Only the drawables which are animated are read again, spread
+    //! across the threads given to setNumThreads.
     void setTime( chrono_t newTime );
 
+    //! Set how many threads setTime may use, 4 by default.  An Ogawa
+    //! archive is opened with a stream for each of the default threads.
+    void setNumThreads( size_t iNumThreads );
+
     //! Return the bounds at the current time.
     //! ...
     Box3d getBounds() const { return m_bounds; }
@@ -124,6 +136,7 @@ protected:
     chrono_t m_minTime;
     chrono_t m_maxTime;
     Box3d m_bounds;
+    size_t m_numThreads;
 
     DrawablePtr m_drawable;
 };
@@ -0,0 +1,444 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2009-2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include "Triangulation.h"
+#include "Drawable.h"
+
+namespace AbcOpenGL {
+namespace ABCOPENGL_VERSION_NS {
+
+//-*****************************************************************************
+TriangulationPtr Triangulate( const Int32ArraySample &iIndices,
+                              const Int32ArraySample &iCounts,
+                              size_t iNumPoints )
+{
+    Alembic::Util::shared_ptr<Triangulation> tris( new Triangulation() );
+    std::vector<Triangulation::Tri> &triangles = tris->triangles;
+
+    size_t numFaces = iCounts.size();
+    size_t numIndices = iIndices.size();
+
+    // Make triangles.
+    size_t faceIndexBegin = 0;
+    size_t faceIndexEnd = 0;
+    for ( size_t face = 0; face < numFaces; ++face )
+    {
+        faceIndexBegin = faceIndexEnd;
+        size_t count = iCounts[face];
+        faceIndexEnd = faceIndexBegin + count;
+
+        // Check this face is valid
+        if ( faceIndexEnd > numIndices ||
+             faceIndexEnd < faceIndexBegin )
+        {
+            std::cerr << "Mesh update quitting on face: "
+                      << face
+                      << " because of wonky numbers"
+                      << ", faceIndexBegin = " << faceIndexBegin
+                      << ", faceIndexEnd = " << faceIndexEnd
+                      << ", numIndices = " << numIndices
+                      << ", count = " << count
+                      << std::endl;
+
+            // Just get out, make no more triangles.
+            break;
+        }
+
+        // Checking indices are valid.
+        bool goodFace = true;
+        for ( size_t fidx = faceIndexBegin;
+              fidx < faceIndexEnd; ++fidx )
+        {
+            if ( ( size_t ) ( iIndices[fidx] ) >= iNumPoints )
+            {
+                std::cout << "Mesh update quitting on face: "
+                          << face
+                          << " because of bad indices"
+                          << ", indexIndex = " << fidx
+                          << ", vertexIndex = " << iIndices[fidx]
+                          << ", numPoints = " << iNumPoints
+                          << std::endl;
+                goodFace = false;
+                break;
+            }
+        }
+
+        // Make triangles to fill this face.
+        if ( goodFace && count > 2 )
+        {
+            triangles.push_back(
+                Triangulation::Tri(
+                    ( unsigned int )iIndices[faceIndexBegin+0],
+                    ( unsigned int )iIndices[faceIndexBegin+1],
+                    ( unsigned int )iIndices[faceIndexBegin+2] ) );
+            for ( size_t c = 3; c < count; ++c )
+            {
+                triangles.push_back(
+                    Triangulation::Tri(
+                        ( unsigned int )iIndices[faceIndexBegin+0],
+                        ( unsigned int )iIndices[faceIndexBegin+c-1],
+                        ( unsigned int )iIndices[faceIndexBegin+c] ) );
+            }
+        }
+    }
+
+    // Count the triangles of each point, then fill them in, in triangle
+    // order.
+    std::vector<unsigned int> &offsets = tris->pointOffsets;
+    offsets.assign( iNumPoints + 1, 0 );
+    for ( size_t t = 0; t < triangles.size(); ++t )
+    {
+        for ( size_t v = 0; v < 3; ++v )
+        {
+            ++offsets[ triangles[t][v] + 1 ];
+        }
+    }
+    for ( size_t p = 0; p < iNumPoints; ++p )
+    {
+        offsets[p + 1] += offsets[p];
+    }
+
+    tris->pointTriangles.resize( offsets[iNumPoints] );
+    std::vector<unsigned int> next( offsets.begin(), offsets.end() - 1 );
+    for ( size_t t = 0; t < triangles.size(); ++t )
+    {
+        for ( size_t v = 0; v < 3; ++v )
+        {
+            tris->pointTriangles[ next[ triangles[t][v] ]++ ] =
+                ( unsigned int )t;
+        }
+    }
+
+    return tris;
+}
+
+//-*****************************************************************************
+namespace {
+
+struct TopologyKey : public Alembic::Util::totally_ordered<TopologyKey>
+{
+    Alembic::Util::Digest indices;
+    Alembic::Util::Digest counts;
+    size_t numIndices;
+    size_t numFaces;
+    size_t numPoints;
+
+    bool operator==( const TopologyKey &iRhs ) const
+    {
+        return indices == iRhs.indices && counts == iRhs.counts &&
+            numIndices == iRhs.numIndices && numFaces == iRhs.numFaces &&
+            numPoints == iRhs.numPoints;
+    }
+
+    bool operator<( const TopologyKey &iRhs ) const
+    {
+        if ( indices != iRhs.indices ) { return indices < iRhs.indices; }
+        if ( counts != iRhs.counts ) { return counts < iRhs.counts; }
+        if ( numIndices != iRhs.numIndices )
+        {
+            return numIndices < iRhs.numIndices;
+        }
+        if ( numFaces != iRhs.numFaces ) { return numFaces < iRhs.numFaces; }
+        return numPoints < iRhs.numPoints;
+    }
+};
+
+typedef Alembic::Util::weak_ptr<const Triangulation> TriangulationWeakPtr;
+typedef std::map<TopologyKey, TriangulationWeakPtr> TriangulationMap;
+
+// shared by every mesh, guarded by g_lock
+Alembic::Util::mutex g_lock;
+TriangulationMap g_triangulations;
+size_t g_pruneSize = 64;
+TriangulationCacheStats g_stats;
+
+//-*****************************************************************************
+Alembic::Util::Digest digestOf( const Int32ArraySample &iSample )
+{
+    Alembic::Util::Digest digest;
+    Alembic::Util::MurmurHash3_x64_128( iSample.getData(),
+        iSample.size() * sizeof( Alembic::Util::int32_t ),
+        sizeof( Alembic::Util::int32_t ), digest.words );
+    return digest;
+}
+
+} // End namespace
+
+//-*****************************************************************************
+TriangulationPtr GetTriangulation( Int32ArraySamplePtr iIndices,
+                                   Int32ArraySamplePtr iCounts,
+                                   size_t iNumPoints )
+{
+    TopologyKey key;
+    key.indices = digestOf( *iIndices );
+    key.counts = digestOf( *iCounts );
+    key.numIndices = iIndices->size();
+    key.numFaces = iCounts->size();
+    key.numPoints = iNumPoints;
+
+    {
+        Alembic::Util::scoped_lock l( g_lock );
+        TriangulationMap::iterator it = g_triangulations.find( key );
+        if ( it != g_triangulations.end() )
+        {
+            TriangulationPtr tris = it->second.lock();
+            if ( tris )
+            {
+                ++g_stats.hits;
+                return tris;
+            }
+        }
+        ++g_stats.misses;
+    }
+
+    // Triangulated without the lock, so other meshes don't wait on it.
+    TriangulationPtr tris = Triangulate( *iIndices, *iCounts, iNumPoints );
+
+    Alembic::Util::scoped_lock l( g_lock );
+
+    // Another thread may have triangulated the same topology meanwhile.
+    TriangulationWeakPtr &entry = g_triangulations[key];
+    TriangulationPtr existing = entry.lock();
+    if ( existing )
+    {
+        return existing;
+    }
+    entry = tris;
+
+    // Let go of the topologies no mesh is using any more, once in a while.
+    if ( g_triangulations.size() >= g_pruneSize )
+    {
+        TriangulationMap::iterator it = g_triangulations.begin();
+        while ( it != g_triangulations.end() )
+        {
+            if ( it->second.expired() )
+            {
+                g_triangulations.erase( it++ );
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        g_pruneSize = std::max( g_triangulations.size() * 2, ( size_t )64 );
+    }
+
+    return tris;
+}
+
+//-*****************************************************************************
+TriangulationCacheStats GetTriangulationCacheStats()
+{
+    Alembic::Util::scoped_lock l( g_lock );
+
+    TriangulationCacheStats stats = g_stats;
+    stats.size = 0;
+    for ( TriangulationMap::iterator it = g_triangulations.begin();
+          it != g_triangulations.end(); ++it )
+    {
+        if ( !it->second.expired() )
+        {
+            ++stats.size;
+        }
+    }
+    return stats;
+}
+
+//-*****************************************************************************
+void ResetTriangulationCacheStats()
+{
+    Alembic::Util::scoped_lock l( g_lock );
+    g_stats = TriangulationCacheStats();
+}
+
+//-*****************************************************************************
+namespace {
+
+// Below this many triangles a part costs more than it saves.
+const size_t kTrianglesPerPart = 65536;
+
+struct NormalsWork
+{
+    const V3f *P;
+    const Triangulation *tris;
+    V3f *triN;
+    V3f *N;
+    size_t numPoints;
+
+    // which pass, and how many parts it is split into
+    bool perPoint;
+    size_t numParts;
+};
+
+struct NormalsPart
+{
+    NormalsWork *work;
+    size_t part;
+};
+
+//-*****************************************************************************
+// the normal of each triangle, its length twice the triangle's area
+void triangleNormals( const V3f *iP, const Triangulation::Tri *iTris,
+                      size_t iBegin, size_t iEnd, V3f *oN )
+{
+    for ( size_t t = iBegin; t < iEnd; ++t )
+    {
+        const V3f &A = iP[ iTris[t][0] ];
+        const V3f &B = iP[ iTris[t][1] ];
+        const V3f &C = iP[ iTris[t][2] ];
+
+        float abx = B.x - A.x, aby = B.y - A.y, abz = B.z - A.z;
+        float acx = C.x - A.x, acy = C.y - A.y, acz = C.z - A.z;
+
+        oN[t].x = aby * acz - abz * acy;
+        oN[t].y = abz * acx - abx * acz;
+        oN[t].z = abx * acy - aby * acx;
+    }
+}
+
+//-*****************************************************************************
+void pointNormals( const V3f *iTriN, const unsigned int *iOffsets,
+                   const unsigned int *iTriangles, size_t iBegin,
+                   size_t iEnd, V3f *oN )
+{
+    for ( size_t p = iBegin; p < iEnd; ++p )
+    {
+        V3f sum( 0.0f );
+        for ( unsigned int i = iOffsets[p]; i < iOffsets[p + 1]; ++i )
+        {
+            sum += iTriN[ iTriangles[i] ];
+        }
+        oN[p] = sum.normalize();
+    }
+}
+
+//-*****************************************************************************
+void normalsTask( void *iPart )
+{
+    NormalsPart &part = *( static_cast<NormalsPart *>( iPart ) );
+    NormalsWork &work = *part.work;
+
+    size_t size = work.perPoint ? work.numPoints :
+        work.tris->triangles.size();
+    size_t begin = size * part.part / work.numParts;
+    size_t end = size * ( part.part + 1 ) / work.numParts;
+
+    if ( work.perPoint )
+    {
+        pointNormals( work.triN, &work.tris->pointOffsets.front(),
+                      work.tris->pointTriangles.empty() ? NULL :
+                      &work.tris->pointTriangles.front(),
+                      begin, end, work.N );
+    }
+    else
+    {
+        triangleNormals( work.P, &work.tris->triangles.front(), begin, end,
+                         work.triN );
+    }
+}
+
+//-*****************************************************************************
+void runNormalsPass( NormalsWork &iWork )
+{
+    std::vector<NormalsPart> parts( iWork.numParts );
+    for ( size_t i = 0; i < iWork.numParts; ++i )
+    {
+        parts[i].work = &iWork;
+        parts[i].part = i;
+    }
+
+    if ( iWork.numParts == 1 )
+    {
+        normalsTask( &parts[0] );
+        return;
+    }
+
+    // This thread does the first part, and whichever of the others the
+    // pool hasn't started on by the time it waits.
+    Alembic::Util::TaskGroup group( GetUpdatePool() );
+    for ( size_t i = 1; i < iWork.numParts; ++i )
+    {
+        group.run( normalsTask, &parts[i] );
+    }
+    normalsTask( &parts[0] );
+    group.wait();
+}
+
+} // End namespace
+
+//-*****************************************************************************
+void ComputeSmoothNormals( const V3f *iP, size_t iNumPoints,
+                           const Triangulation &iTriangulation,
+                           std::vector<V3f> &oN,
+                           size_t iNumThreads )
+{
+    oN.resize( iNumPoints );
+    if ( iNumPoints == 0 )
+    {
+        return;
+    }
+
+    size_t numTris = iTriangulation.triangles.size();
+    if ( numTris == 0 )
+    {
+        std::fill( oN.begin(), oN.end(), V3f( 0.0f ) );
+        return;
+    }
+
+    std::vector<V3f> triN( numTris );
+
+    NormalsWork work;
+    work.P = iP;
+    work.tris = &iTriangulation;
+    work.triN = &triN.front();
+    work.N = &oN.front();
+    work.numPoints = iNumPoints;
+    work.numParts = std::max( std::min( iNumThreads,
+        numTris / kTrianglesPerPart ), ( size_t )1 );
+    if ( work.numParts > 1 )
+    {
+        GetUpdatePool().reserve( iNumThreads - 1 );
+    }
+
+    work.perPoint = false;
+    runNormalsPass( work );
+
+    work.perPoint = true;
+    runNormalsPass( work );
+}
+
+} // End namespace ABCOPENGL_VERSION_NS
+} // End namespace AbcOpenGL
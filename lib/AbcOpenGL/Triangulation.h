@@ -0,0 +1,113 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2009-2013,
+//  Sony Pictures Imageworks, Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _AbcOpenGL_Triangulation_h_
+#define _AbcOpenGL_Triangulation_h_
+
+#include "Foundation.h"
+
+namespace AbcOpenGL {
+namespace ABCOPENGL_VERSION_NS {
+
+//-*****************************************************************************
+//! The triangles the faces of a mesh are split into, and for each point
+//! the triangles which use it.  Both only depend on the topology, so
+//! meshes with the same face indices, counts and number of points share
+//! one, see GetTriangulation.
+struct Triangulation
+{
+    typedef Imath::Vec3<unsigned int> Tri;
+
+    std::vector<Tri> triangles;
+
+    //! The triangles using point i are pointTriangles[ pointOffsets[i] ]
+    //! up to pointTriangles[ pointOffsets[i+1] ], in increasing order.
+    std::vector<unsigned int> pointOffsets;
+    std::vector<unsigned int> pointTriangles;
+};
+
+typedef Alembic::Util::shared_ptr<const Triangulation> TriangulationPtr;
+
+//-*****************************************************************************
+//! Splits each face into a fan of triangles.  Faces using a point past
+//! iNumPoints are dropped, and so is every face from the first whose count
+//! runs past the end of the indices.
+TriangulationPtr Triangulate( const Int32ArraySample &iIndices,
+                              const Int32ArraySample &iCounts,
+                              size_t iNumPoints );
+
+//! Returns the triangulation of the given topology, which is identified by
+//! a digest of the indices and counts.  It is shared with every other mesh
+//! of the same topology, and only triangulated when no mesh is holding on
+//! to one already.  This is safe to call from many threads.
+TriangulationPtr GetTriangulation( Int32ArraySamplePtr iIndices,
+                                   Int32ArraySamplePtr iCounts,
+                                   size_t iNumPoints );
+
+//-*****************************************************************************
+//! How often GetTriangulation found a triangulation to share.
+struct TriangulationCacheStats
+{
+    TriangulationCacheStats() : hits( 0 ), misses( 0 ), size( 0 ) {}
+
+    size_t hits;
+    size_t misses;
+
+    //! Topologies currently held by some mesh.
+    size_t size;
+};
+
+TriangulationCacheStats GetTriangulationCacheStats();
+void ResetTriangulationCacheStats();
+
+//-*****************************************************************************
+//! Computes area weighted smooth normals of iP into oN, in two passes: the
+//! normal of every triangle, then for every point the sum of the normals of
+//! its triangles, normalized.  Big meshes have each pass split across up to
+//! iNumThreads threads of GetUpdatePool.  The sums are always taken in the
+//! same order, so the normals don't depend on the number of threads.
+void ComputeSmoothNormals( const V3f *iP, size_t iNumPoints,
+                           const Triangulation &iTriangulation,
+                           std::vector<V3f> &oN,
+                           size_t iNumThreads = 1 );
+
+} // End namespace ABCOPENGL_VERSION_NS
+
+using namespace ABCOPENGL_VERSION_NS;
+
+} // End namespace AbcOpenGL
+
+#endif
@@ -36,6 +36,8 @@
 
 #include <Alembic/Abc/IArchive.h>
 #include <Alembic/Abc/IObject.h>
+#include <Alembic/Abc/IArrayProperty.h>
+#include <Alembic/Abc/ICompoundProperty.h>
 
 namespace Alembic {
 namespace Abc {
@@ -152,6 +154,199 @@ void IArchive::setReadArraySampleCachePtr( AbcA::ReadArraySampleCachePtr iPtr )
     ALEMBIC_ABC_SAFE_CALL_END();
 }
 
+//-*****************************************************************************
+void IArchive::setArraySampleAllocator(
+    AbcA::ArraySampleAllocatorPtr iAllocator )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::setArraySampleAllocator" );
+
+    m_archive->setArraySampleAllocator( iAllocator );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+AbcA::ArraySampleAllocatorPtr IArchive::getArraySampleAllocator()
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::getArraySampleAllocator" );
+
+    return m_archive->getArraySampleAllocator();
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw, so here is a default behavior.
+    return AbcA::ArraySampleAllocatorPtr();
+}
+
+//-*****************************************************************************
+void IArchive::setStatsEnabled( bool iEnabled )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::setStatsEnabled" );
+
+    m_archive->setStatsEnabled( iEnabled );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+bool IArchive::getStats( AbcA::ArchiveStats & oStats )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::getStats" );
+
+    return m_archive->getStats( oStats );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw, so here is a default behavior.
+    return false;
+}
+
+//-*****************************************************************************
+void IArchive::resetStats()
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::resetStats" );
+
+    m_archive->resetStats();
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+AbcA::ReadContextPtr IArchive::createReadContext()
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::createReadContext" );
+
+    return m_archive->createReadContext();
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw, so here is a default behavior.
+    return AbcA::ReadContextPtr();
+}
+
+//-*****************************************************************************
+namespace {
+
+void CollectArrayProperties( AbcA::CompoundPropertyReaderPtr iParent,
+                             std::vector< AbcA::ArrayPropertyReaderPtr > & oProps )
+{
+    for ( size_t i = 0; i < iParent->getNumProperties(); ++i )
+    {
+        const AbcA::PropertyHeader & header = iParent->getPropertyHeader( i );
+        if ( header.isArray() )
+        {
+            oProps.push_back( iParent->getArrayProperty( header.getName() ) );
+        }
+        else if ( header.isCompound() )
+        {
+            CollectArrayProperties(
+                iParent->getCompoundProperty( header.getName() ), oProps );
+        }
+    }
+}
+
+void CollectArrayProperties( AbcA::ObjectReaderPtr iObject,
+                             std::vector< AbcA::ArrayPropertyReaderPtr > & oProps )
+{
+    CollectArrayProperties( iObject->getProperties(), oProps );
+    for ( size_t i = 0; i < iObject->getNumChildren(); ++i )
+    {
+        CollectArrayProperties( iObject->getChild( i ), oProps );
+    }
+}
+
+} // End namespace
+
+//-*****************************************************************************
+uint64_t IArchive::prefetch( const std::vector< IObject > & iObjects,
+                             chrono_t iStartTime, chrono_t iEndTime,
+                             int32_t iPriority )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::prefetch(objects)" );
+
+    std::vector< AbcA::ArrayPropertyReaderPtr > props;
+    for ( size_t i = 0; i < iObjects.size(); ++i )
+    {
+        if ( iObjects[i].valid() )
+        {
+            CollectArrayProperties(
+                iObjects[i].getPtr(), props );
+        }
+    }
+
+    return m_archive->prefetch( props, iStartTime, iEndTime, iPriority );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw, so here is a default behavior.
+    return 0;
+}
+
+//-*****************************************************************************
+uint64_t IArchive::prefetch( const std::vector< IArrayProperty > & iProperties,
+                             chrono_t iStartTime, chrono_t iEndTime,
+                             int32_t iPriority )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::prefetch(properties)" );
+
+    std::vector< AbcA::ArrayPropertyReaderPtr > props;
+    for ( size_t i = 0; i < iProperties.size(); ++i )
+    {
+        if ( iProperties[i].valid() )
+        {
+            props.push_back( iProperties[i].getPtr() );
+        }
+    }
+
+    return m_archive->prefetch( props, iStartTime, iEndTime, iPriority );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw, so here is a default behavior.
+    return 0;
+}
+
+//-*****************************************************************************
+void IArchive::cancelPrefetch( uint64_t iRequest )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::cancelPrefetch" );
+
+    m_archive->cancelPrefetch( iRequest );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void IArchive::cancelAllPrefetches()
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::cancelAllPrefetches" );
+
+    m_archive->cancelAllPrefetches();
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void IArchive::waitForPrefetch( uint64_t iRequest )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::waitForPrefetch" );
+
+    m_archive->waitForPrefetch( iRequest );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void IArchive::setPrefetchLimits( std::size_t iNumThreads,
+                                  std::size_t iMaxBytes )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArchive::setPrefetchLimits" );
+
+    m_archive->setPrefetchLimits( iNumThreads, iMaxBytes );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace Abc
 } // End namespace Alembic
@@ -46,6 +46,7 @@ namespace Abc {
 namespace ALEMBIC_VERSION_NS {
 
 class IObject;
+class IArrayProperty;
 
 //-*****************************************************************************
 class IArchive : public Base
@@ -131,6 +132,64 @@ public:
     //! will be disabled if a NULL cache is passed here.
     void setReadArraySampleCachePtr( AbcA::ReadArraySampleCachePtr iPtr );
 
+    //! Set where the data of the array samples read from this archive
+    //! comes from.  It may be a NULL pointer, which uses new and delete.
+    //! Allocators can be shared amongst separate archives.
+    void setArraySampleAllocator( AbcA::ArraySampleAllocatorPtr iAllocator );
+
+    //! Get the array sample allocator, it may be a NULL pointer.
+    AbcA::ArraySampleAllocatorPtr getArraySampleAllocator();
+
+    //! Turns the gathering of I/O and cache statistics on or off.  It is off
+    //! by default, and costs little more than a check per read when off.
+    void setStatsEnabled( bool iEnabled );
+
+    //! Fills oStats with what has been gathered since the stats were last
+    //! reset.  Returns false if the underlying implementation doesn't
+    //! gather statistics.
+    bool getStats( AbcA::ArchiveStats & oStats );
+
+    //! Zeroes the gathered statistics.
+    void resetStats();
+
+    //! Creates a context that a single thread can hand to its reads,
+    //! through ISampleSelector::setReadContext, so that per sample setup is
+    //! done once instead of on every read.  Returns an empty pointer if the
+    //! underlying implementation has no use for one.
+    //! A context must not be shared by threads reading at the same time.
+    AbcA::ReadContextPtr createReadContext();
+
+    //! Starts reading the array samples of iObjects, their descendants, and
+    //! their compound properties, that fall between iStartTime and
+    //! iEndTime on background threads.  Reads of those samples made after
+    //! they have arrived don't wait on I/O.  Requests with a higher
+    //! iPriority are read first.  Returns an id for cancelPrefetch and
+    //! waitForPrefetch, or 0 if the underlying implementation doesn't
+    //! prefetch.
+    uint64_t prefetch( const std::vector< IObject > & iObjects,
+                       chrono_t iStartTime, chrono_t iEndTime,
+                       int32_t iPriority = 0 );
+
+    //! The same as above, for just the given array properties.
+    uint64_t prefetch( const std::vector< IArrayProperty > & iProperties,
+                       chrono_t iStartTime, chrono_t iEndTime,
+                       int32_t iPriority = 0 );
+
+    //! Drops the reads of a prefetch which haven't started yet, samples
+    //! already read stay available.
+    void cancelPrefetch( uint64_t iRequest );
+
+    //! Drops every prefetch read which hasn't started, for instance when
+    //! the playhead jumps somewhere else.
+    void cancelAllPrefetches();
+
+    //! Blocks until the reads of a prefetch are done or cancelled.
+    void waitForPrefetch( uint64_t iRequest );
+
+    //! Sets the number of prefetch threads, and how many bytes of
+    //! prefetched samples may be held before the oldest are let go.
+    void setPrefetchLimits( std::size_t iNumThreads, std::size_t iMaxBytes );
+
     //-*************************************************************************
     // ABC BASE MECHANISMS
     // These functions are used by Abc to deal with errors, rewrapping,
@@ -108,7 +108,7 @@ void IArrayProperty::get( AbcA::ArraySamplePtr& oSamp,
     m_property->getSample(
         iSS.getIndex( m_property->getTimeSampling(),
                       m_property->getNumSamples() ),
-        oSamp );
+        oSamp, iSS.getReadContext() );
 
     ALEMBIC_ABC_SAFE_CALL_END();
 }
@@ -123,7 +123,8 @@ void IArrayProperty::getAs( void * oSample,
     m_property->getAs( iSS.getIndex( m_property->getTimeSampling(),
                                      m_property->getNumSamples() ),
                        oSample,
-                       iPod
+                       iPod,
+                       iSS.getReadContext()
                      );
 
     ALEMBIC_ABC_SAFE_CALL_END();
@@ -138,7 +139,8 @@ void IArrayProperty::getAs( void * oSample,
     m_property->getAs( iSS.getIndex( m_property->getTimeSampling(),
                                      m_property->getNumSamples() ),
                        oSample,
-                       m_property->getDataType().getPod()
+                       m_property->getDataType().getPod(),
+                       iSS.getReadContext()
                      );
 
     ALEMBIC_ABC_SAFE_CALL_END();
@@ -153,7 +155,7 @@ bool IArrayProperty::getKey( AbcA::ArraySampleKey& oKey,
     return m_property->getKey(
         iSS.getIndex( m_property->getTimeSampling(),
                       m_property->getNumSamples() ),
-        oKey );
+        oKey, iSS.getReadContext() );
 
     ALEMBIC_ABC_SAFE_CALL_END();
 
@@ -170,7 +172,67 @@ void IArrayProperty::getDimensions( Util::Dimensions & oDim,
     m_property->getDimensions(
         iSS.getIndex( m_property->getTimeSampling(),
                       m_property->getNumSamples() ),
-        oDim );
+        oDim, iSS.getReadContext() );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+size_t IArrayProperty::getInto( void * oBuffer, size_t iCapacity,
+                                const ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArrayProperty::getInto()" );
+
+    index_t index = iSS.getIndex( m_property->getTimeSampling(),
+                                  m_property->getNumSamples() );
+
+    Util::Dimensions dims;
+    m_property->getDimensions( index, dims, iSS.getReadContext() );
+
+    size_t numPoints = dims.numPoints();
+    if ( numPoints > 0 && numPoints <= iCapacity )
+    {
+        ABCA_ASSERT( oBuffer, "NULL buffer passed to getInto" );
+        m_property->getAs( index, oBuffer,
+                           m_property->getDataType().getPod(),
+                           iSS.getReadContext() );
+    }
+
+    return numPoints;
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // for error handler that don't throw
+    return 0;
+}
+
+//-*****************************************************************************
+void IArrayProperty::getRange( void * oBuffer, size_t iStart, size_t iCount,
+                               const ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IArrayProperty::getRange()" );
+
+    m_property->getRangeAs( iSS.getIndex( m_property->getTimeSampling(),
+                                          m_property->getNumSamples() ),
+                            iStart, iCount, oBuffer,
+                            m_property->getDataType().getPod(),
+                            iSS.getReadContext() );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void IArrayProperty::getRangeAs( void * oBuffer, AbcA::PlainOldDataType iPod,
+                                 size_t iStart, size_t iCount,
+                                 const ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN(
+        "IArrayProperty::getRangeAs(PlainOldDataType)" );
+
+    m_property->getRangeAs( iSS.getIndex( m_property->getTimeSampling(),
+                                          m_property->getNumSamples() ),
+                            iStart, iCount, oBuffer, iPod,
+                            iSS.getReadContext() );
 
     ALEMBIC_ABC_SAFE_CALL_END();
 }
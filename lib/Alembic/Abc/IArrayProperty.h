@@ -147,6 +147,28 @@ public:
     void getDimensions( Util::Dimensions & oDim,
                         const ISampleSelector &iSS = ISampleSelector() ) const;
 
+    //! Reads a sample straight into oBuffer, which has room for iCapacity
+    //! elements of this property's DataType, without allocating anything.
+    //! Returns the number of elements in the sample.  If that is more than
+    //! iCapacity nothing is read, so calling this with a capacity of 0 is a
+    //! cheap way to size a buffer.
+    //! String and wstring buffers must hold constructed strings.
+    size_t getInto( void *oBuffer, size_t iCapacity,
+                    const ISampleSelector &iSS = ISampleSelector() ) const;
+
+    //! Reads only iCount elements of a sample, starting at element iStart,
+    //! into oBuffer as the POD type of this array property.  Where the
+    //! underlying implementation can, only that part of the sample is read
+    //! from disk.  A range which isn't inside the sample is an error.
+    //! String and wstring buffers must hold constructed strings.
+    void getRange( void *oBuffer, size_t iStart, size_t iCount,
+                   const ISampleSelector &iSS = ISampleSelector() ) const;
+
+    //! The same as getRange, but as a particular POD type.
+    void getRangeAs( void *oBuffer, AbcA::PlainOldDataType iPod,
+                     size_t iStart, size_t iCount,
+                     const ISampleSelector &iSS = ISampleSelector() ) const;
+
     //! Return the parent compound property, handily wrapped in a
     //! ICompoundProperty wrapper.
     ICompoundProperty getParent() const;
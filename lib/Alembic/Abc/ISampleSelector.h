@@ -57,18 +57,21 @@ public:
     ISampleSelector()
       : m_requestedIndex( 0 ),
         m_requestedTime( 0.0 ),
-        m_requestedTimeIndexType( kNearIndex ) {}
+        m_requestedTimeIndexType( kNearIndex ),
+        m_readContext( NULL ) {}
 
     ISampleSelector( index_t iReqIdx )
       : m_requestedIndex( iReqIdx ),
         m_requestedTime( 0.0 ),
-        m_requestedTimeIndexType( kNearIndex ) {}
+        m_requestedTimeIndexType( kNearIndex ),
+        m_readContext( NULL ) {}
 
     explicit ISampleSelector( chrono_t iReqTime,
                               TimeIndexType iReqIdxType = kNearIndex )
       : m_requestedIndex( -1 ),
         m_requestedTime( iReqTime ),
-        m_requestedTimeIndexType( iReqIdxType ) {}
+        m_requestedTimeIndexType( iReqIdxType ),
+        m_readContext( NULL ) {}
 
     index_t getRequestedIndex() const { return m_requestedIndex; }
     chrono_t getRequestedTime() const { return m_requestedTime; }
@@ -78,10 +81,19 @@ public:
     index_t getIndex( const AbcA::TimeSamplingPtr & iTsmp, index_t
         iNumSamples ) const;
 
+    //! Reads made with this selector will use iContext, which came from
+    //! IArchive::createReadContext on the archive being read.  A context
+    //! from some other archive is ignored.  It is not owned by the selector.
+    void setReadContext( AbcA::ReadContext * iContext )
+    { m_readContext = iContext; }
+
+    AbcA::ReadContext * getReadContext() const { return m_readContext; }
+
 private:
     index_t m_requestedIndex;
     chrono_t m_requestedTime;
     TimeIndexType m_requestedTimeIndexType;
+    AbcA::ReadContext * m_readContext;
 };
 
 } // End namespace ALEMBIC_VERSION_NS
@@ -93,7 +93,7 @@ void IScalarProperty::get( void *oSamp, const ISampleSelector &iSS ) const
 
     AbcA::index_t index = iSS.getIndex( m_property->getTimeSampling(),
                                         m_property->getNumSamples() );
-    m_property->getSample( index, oSamp );
+    m_property->getSample( index, oSamp, iSS.getReadContext() );
 
     ALEMBIC_ABC_SAFE_CALL_END();
 }
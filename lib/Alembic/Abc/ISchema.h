@@ -90,7 +90,7 @@ public:
 
         if ( iMatching == kStrictMatching || iMatching == kSchemaTitleMatching )
         {
-            return iMetaData.get( "schema" ) == getSchemaTitle();
+            return iMetaData.getSchema() == getSchemaTitle();
         }
 
         return false;
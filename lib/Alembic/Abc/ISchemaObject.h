@@ -94,13 +94,13 @@ public:
 
         if ( iMatching == kStrictMatching )
         {
-            return iMetaData.get( "schemaObjTitle" ) == getSchemaObjTitle() ||
-                iMetaData.get( "schema" ) == getSchemaObjTitle();
+            return iMetaData.getSchemaObjTitle() == getSchemaObjTitle() ||
+                iMetaData.getSchema() == getSchemaObjTitle();
         }
 
         if ( iMatching == kSchemaTitleMatching )
         {
-            return iMetaData.get( "schema" ) == getSchemaTitle();
+            return iMetaData.getSchema() == getSchemaTitle();
         }
 
         return false;
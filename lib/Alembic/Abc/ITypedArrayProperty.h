@@ -75,7 +75,7 @@ public:
     {
         if ( iMatching == kStrictMatching )
         {
-            return ( iMetaData.get( "interpretation" ) ==
+            return ( iMetaData.getInterpretation() ==
                      getInterpretation() );
         }
         return true;
@@ -151,6 +151,23 @@ public:
         get( ret, iSS );
         return ret;
     }
+
+    //! Read the sample into iCapacity values of caller owned storage.
+    //! Returns the number of values in the sample, nothing is read if that
+    //! is more than iCapacity.  See IArrayProperty::getInto.
+    size_t getInto( value_type *oBuffer, size_t iCapacity,
+                    const ISampleSelector &iSS = ISampleSelector() ) const
+    {
+        return IArrayProperty::getInto( oBuffer, iCapacity, iSS );
+    }
+
+    //! Read iCount values starting at value iStart into caller owned
+    //! storage.  See IArrayProperty::getRange.
+    void getRange( value_type *oBuffer, size_t iStart, size_t iCount,
+                   const ISampleSelector &iSS = ISampleSelector() ) const
+    {
+        IArrayProperty::getRange( oBuffer, iStart, iCount, iSS );
+    }
 };
 
 //-*****************************************************************************
@@ -72,7 +72,7 @@ public:
     {
         if ( iMatching == kStrictMatching )
         {
-            return ( iMetaData.get( "interpretation" ) ==
+            return ( iMetaData.getInterpretation() ==
                      getInterpretation() );
         }
         return true;
@@ -146,6 +146,39 @@ OObject OArchive::getTop()
     return OObject();
 }
 
+//-*****************************************************************************
+void OArchive::setStatsEnabled( bool iEnabled )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "OArchive::setStatsEnabled" );
+
+    m_archive->setStatsEnabled( iEnabled );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+bool OArchive::getStats( AbcA::ArchiveStats & oStats )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "OArchive::getStats" );
+
+    return m_archive->getStats( oStats );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw, so here is a default behavior.
+    return false;
+}
+
+//-*****************************************************************************
+void OArchive::resetStats()
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "OArchive::resetStats" );
+
+    m_archive->resetStats();
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace Abc
 } // End namespace Alembic
@@ -48,6 +48,10 @@ namespace ALEMBIC_VERSION_NS {
 class OObject;
 
 //-*****************************************************************************
+//! When written through AbcCoreOgawa, separate threads may each create and
+//! write their own objects and properties of one OArchive at the same time,
+//! see AbcCoreOgawa::WriteArchive.  AbcCoreHDF5 archives must only be written
+//! from one thread at a time.
 class OArchive : public Base
 {
 public:
@@ -149,6 +153,18 @@ public:
     //! TimeSampling pool.
     uint32_t getNumTimeSamplings();
 
+    //! Turns the gathering of I/O and cache statistics on or off.  It is off
+    //! by default, and costs little more than a check per read when off.
+    void setStatsEnabled( bool iEnabled );
+
+    //! Fills oStats with what has been gathered since the stats were last
+    //! reset.  Returns false if the underlying implementation doesn't
+    //! gather statistics.
+    bool getStats( AbcA::ArchiveStats & oStats );
+
+    //! Zeroes the gathered statistics.
+    void resetStats();
+
     //-*************************************************************************
     // ABC BASE MECHANISMS
     // These functions are used by Abc to deal with errors, rewrapping,
@@ -90,12 +90,12 @@ public:
         if ( iMatching == kStrictMatching )
         {
 
-            return iMetaData.get( "schemaObjTitle" ) == getSchemaObjTitle();
+            return iMetaData.getSchemaObjTitle() == getSchemaObjTitle();
         }
 
         if ( iMatching == kSchemaTitleMatching )
         {
-            return iMetaData.get( "schema" ) == getSchemaTitle();
+            return iMetaData.getSchema() == getSchemaTitle();
         }
 
         return false;
@@ -72,7 +72,7 @@ public:
     static bool matches( const AbcA::MetaData &iMetaData,
                          SchemaInterpMatching iMatching = kStrictMatching )
     {
-        return ( iMetaData.get( "interpretation" ) ==
+        return ( iMetaData.getInterpretation() ==
                  getInterpretation() );
     }
 
@@ -333,6 +333,12 @@ void readV3fArrayProperty(const std::string &archiveName, bool useOgawa)
     IV3fArrayProperty positions( props, propNames[0] );
     size_t numSamples = positions.getNumSamples();
     std::cout << ".. it has " << numSamples << " samples" << std::endl;
+
+    // read everything ahead of time, only Ogawa does this in the background
+    std::vector< IObject > prefetchObjects( 1, archiveTop );
+    uint64_t request = archive.prefetch( prefetchObjects, 0.0, 1000.0 );
+    TESTING_ASSERT( ( request != 0 ) == useOgawa );
+    archive.waitForPrefetch( request );
     ABCA_ASSERT( numSamples == 5, "Expected 5 samples, found " << numSamples );
 
     TimeSamplingPtr ts = positions.getTimeSampling();
@@ -364,6 +370,42 @@ void readV3fArrayProperty(const std::string &archiveName, bool useOgawa)
                              "Incorrect value read from archive." );
         }
 
+        // the same values read into our own buffer
+        std::vector< V3f > buffer( numPoints + 1, V3f( -1.0f ) );
+        TESTING_ASSERT( positions.getInto( NULL, 0, iss ) == numPoints );
+        if ( numPoints > 1 )
+        {
+            // too small, so nothing gets read
+            TESTING_ASSERT( positions.getInto( &buffer.front(), 1, iss ) ==
+                            numPoints );
+            TESTING_ASSERT( buffer[0] == V3f( -1.0f ) );
+        }
+        TESTING_ASSERT( positions.getInto( &buffer.front(), buffer.size(),
+                                           iss ) == numPoints );
+        for ( size_t jj=0 ; jj<numPoints ; jj++ )
+            TESTING_ASSERT( buffer[jj] == (*samplePtr)[jj] );
+        TESTING_ASSERT( buffer[numPoints] == V3f( -1.0f ) );
+
+        // and just the back half of them
+        size_t half = numPoints / 2;
+        std::vector< V3f > range( numPoints - half + 1, V3f( -1.0f ) );
+        positions.getRange( &range.front(), half, numPoints - half, iss );
+        for ( size_t jj=half ; jj<numPoints ; jj++ )
+            TESTING_ASSERT( range[jj - half] == (*samplePtr)[jj] );
+        TESTING_ASSERT( range[numPoints - half] == V3f( -1.0f ) );
+
+        // as doubles, a V3f is 3 of them
+        if ( numPoints > 0 )
+        {
+            std::vector< double > drange( 3 );
+            positions.getRangeAs( &drange.front(), Alembic::Util::kFloat64POD,
+                                  numPoints - 1, 1, iss );
+            TESTING_ASSERT( drange[2] == (*samplePtr)[numPoints - 1].z );
+        }
+
+        TESTING_ASSERT_THROW( positions.getRange( &range.front(), half,
+                                                  numPoints + 1, iss ),
+                              Alembic::Util::Exception );
     }
     ABCA_ASSERT(
         archive.getMaxNumSamplesForTimeSamplingIndex(1) == (index_t) numSamples,
@@ -39,5 +39,6 @@
 
 #include <Alembic/AbcCollection/ICollections.h>
 #include <Alembic/AbcCollection/OCollections.h>
+#include <Alembic/AbcCollection/CollectionIndex.h>
 
 #endif
@@ -0,0 +1,268 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCollection/CollectionIndex.h>
+
+#include <algorithm>
+
+namespace Alembic {
+namespace AbcCollection {
+namespace ALEMBIC_VERSION_NS {
+
+CollectionIndex::CollectionIndex( Abc::IArchive iArchive,
+                                  const Abc::ISampleSelector &iSS )
+{
+    add( iArchive.getTop(), iSS );
+}
+
+void CollectionIndex::add( Abc::IObject iObject,
+                           const Abc::ISampleSelector &iSS )
+{
+    if ( !iObject.valid() )
+    {
+        return;
+    }
+
+    if ( ICollections::matches( iObject.getHeader() ) )
+    {
+        add( ICollections( iObject, Abc::kWrapExisting ), iSS );
+    }
+
+    size_t numChildren = iObject.getNumChildren();
+    for ( size_t i = 0; i < numChildren; ++i )
+    {
+        add( iObject.getChild( i ), iSS );
+    }
+}
+
+void CollectionIndex::add( ICollections iCollections,
+                           const Abc::ISampleSelector &iSS )
+{
+    ICollectionsSchema & schema = iCollections.getSchema();
+
+    size_t numCollections = schema.getNumCollections();
+    for ( size_t i = 0; i < numCollections; ++i )
+    {
+        Abc::IStringArrayProperty prop = schema.getCollection( i );
+        if ( !prop.valid() || prop.getNumSamples() == 0 )
+        {
+            continue;
+        }
+
+        size_t index = m_collections.size();
+        m_collections.push_back( Collection() );
+        m_collections.back().objectPath = iCollections.getFullName();
+        m_collections.back().name = prop.getName();
+
+        Abc::StringArraySamplePtr samp = prop.getValue( iSS );
+        for ( size_t j = 0; j < samp->size(); ++j )
+        {
+            std::string path = normalizePath( ( *samp )[j] );
+
+            // collections are added in order, so a collection which lists
+            // a path twice can only be at the back
+            IndexVector & indices = m_members[path];
+            if ( indices.empty() )
+            {
+                m_sorted.insert( path );
+            }
+
+            if ( indices.empty() || indices.back() != index )
+            {
+                indices.push_back( index );
+            }
+        }
+    }
+}
+
+const std::string & CollectionIndex::getCollectionName( size_t i ) const
+{
+    ABCA_ASSERT( i < m_collections.size(),
+                 "Invalid collection index: " << i );
+    return m_collections[i].name;
+}
+
+const std::string &
+CollectionIndex::getCollectionsObjectPath( size_t i ) const
+{
+    ABCA_ASSERT( i < m_collections.size(),
+                 "Invalid collection index: " << i );
+    return m_collections[i].objectPath;
+}
+
+size_t CollectionIndex::findCollection( const std::string & iObjectPath,
+                                        const std::string & iName ) const
+{
+    std::string objectPath = normalizePath( iObjectPath );
+    for ( size_t i = 0; i < m_collections.size(); ++i )
+    {
+        if ( m_collections[i].name == iName &&
+             m_collections[i].objectPath == objectPath )
+        {
+            return i;
+        }
+    }
+    return m_collections.size();
+}
+
+const CollectionIndex::IndexVector *
+CollectionIndex::find( const std::string & iNormalizedPath ) const
+{
+    MemberMap::const_iterator it = m_members.find( iNormalizedPath );
+    if ( it == m_members.end() )
+    {
+        return NULL;
+    }
+    return &( it->second );
+}
+
+void CollectionIndex::getCollections( const std::string & iPath,
+    std::vector< size_t > & oCollections ) const
+{
+    oCollections.clear();
+
+    const IndexVector * indices = find( normalizePath( iPath ) );
+    if ( indices )
+    {
+        oCollections = *indices;
+    }
+}
+
+void CollectionIndex::getCollectionsContaining( const std::string & iPath,
+    std::vector< size_t > & oCollections ) const
+{
+    oCollections.clear();
+
+    // look up the path, then each of its parents up to the root
+    std::string path = normalizePath( iPath );
+    while ( true )
+    {
+        const IndexVector * indices = find( path );
+        if ( indices )
+        {
+            oCollections.insert( oCollections.end(), indices->begin(),
+                                 indices->end() );
+        }
+
+        if ( path.size() <= 1 )
+        {
+            break;
+        }
+
+        size_t pos = path.rfind( '/' );
+        path.resize( pos == 0 ? 1 : pos );
+    }
+
+    std::sort( oCollections.begin(), oCollections.end() );
+    oCollections.erase( std::unique( oCollections.begin(),
+                                     oCollections.end() ),
+                        oCollections.end() );
+}
+
+bool CollectionIndex::contains( size_t iCollection,
+                                const std::string & iPath,
+                                bool iSubtree ) const
+{
+    std::vector< size_t > collections;
+    if ( iSubtree )
+    {
+        getCollectionsContaining( iPath, collections );
+    }
+    else
+    {
+        getCollections( iPath, collections );
+    }
+
+    return std::binary_search( collections.begin(), collections.end(),
+                               iCollection );
+}
+
+void CollectionIndex::getMembersUnder( const std::string & iPrefix,
+    std::vector< std::string > & oPaths ) const
+{
+    oPaths.clear();
+
+    std::string prefix = normalizePath( iPrefix );
+
+    // everything sorts after the root
+    if ( prefix == "/" )
+    {
+        oPaths.assign( m_sorted.begin(), m_sorted.end() );
+        return;
+    }
+
+    // the prefix itself sorts first, then the paths beneath it, which all
+    // start with the prefix and a '/'.  Siblings such as "/ab" for "/a"
+    // sort in between, so they are skipped rather than ending the search.
+    std::string under = prefix + "/";
+    std::set< std::string >::const_iterator it = m_sorted.lower_bound( prefix );
+    for ( ; it != m_sorted.end(); ++it )
+    {
+        if ( *it == prefix || it->compare( 0, under.size(), under ) == 0 )
+        {
+            oPaths.push_back( *it );
+        }
+        else if ( it->compare( 0, prefix.size(), prefix ) != 0 )
+        {
+            break;
+        }
+    }
+}
+
+std::string CollectionIndex::normalizePath( const std::string & iPath )
+{
+    std::string path( "/" );
+    path.reserve( iPath.size() + 1 );
+
+    for ( size_t i = 0; i < iPath.size(); ++i )
+    {
+        if ( iPath[i] != '/' || path[path.size() - 1] != '/' )
+        {
+            path += iPath[i];
+        }
+    }
+
+    if ( path.size() > 1 && path[path.size() - 1] == '/' )
+    {
+        path.resize( path.size() - 1 );
+    }
+
+    return path;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCollection
+} // End namespace Alembic
@@ -0,0 +1,152 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcCollections_CollectionIndex_h_
+#define _Alembic_AbcCollections_CollectionIndex_h_
+
+#include <Alembic/AbcCollection/ICollections.h>
+
+#include <set>
+
+namespace Alembic {
+namespace AbcCollection {
+namespace ALEMBIC_VERSION_NS {
+
+//! Answers which collections an object is in without reading and comparing
+//! every collection for every object.
+//!
+//! The members of each collection are read once, and each member path is
+//! hashed to the collections which list it.  A collection member also
+//! stands for everything beneath it, so an object can be looked up either
+//! by its exact path or by its path and all of its parents.
+//!
+//! Paths are compared with repeated and trailing '/' removed, and with a
+//! leading '/' added if missing.
+//!
+//! Once built, an index is only read from, and can be shared by many
+//! threads.  add() must not be called while other threads query it.
+class CollectionIndex : Alembic::Util::noncopyable
+{
+public:
+
+    //! Creates an empty index.
+    CollectionIndex() {}
+
+    //! Indexes every ICollections object in iArchive, reading the
+    //! collections at iSS.
+    explicit CollectionIndex( Abc::IArchive iArchive,
+        const Abc::ISampleSelector &iSS = Abc::ISampleSelector() );
+
+    //! Adds the collections of every ICollections object at or beneath
+    //! iObject.
+    void add( Abc::IObject iObject,
+              const Abc::ISampleSelector &iSS = Abc::ISampleSelector() );
+
+    //! Adds the collections of a single ICollections object.
+    void add( ICollections iCollections,
+              const Abc::ISampleSelector &iSS = Abc::ISampleSelector() );
+
+    //! Returns the number of collections indexed.
+    size_t getNumCollections() const { return m_collections.size(); }
+
+    //! Returns the name of the collection at a given index.
+    const std::string & getCollectionName( size_t i ) const;
+
+    //! Returns the full name of the ICollections object which holds the
+    //! collection at a given index.
+    const std::string & getCollectionsObjectPath( size_t i ) const;
+
+    //! Returns the index of the named collection held by the ICollections
+    //! object at iObjectPath, or getNumCollections() if there is none.
+    size_t findCollection( const std::string & iObjectPath,
+                           const std::string & iName ) const;
+
+    //! Fills oCollections with the indices of the collections which list
+    //! iPath itself, in ascending order.
+    void getCollections( const std::string & iPath,
+                         std::vector< size_t > & oCollections ) const;
+
+    //! Fills oCollections with the indices of the collections which list
+    //! iPath or any of its parents, in ascending order.
+    void getCollectionsContaining( const std::string & iPath,
+        std::vector< size_t > & oCollections ) const;
+
+    //! Returns whether the collection at iCollection lists iPath, or
+    //! when iSubtree is true, iPath or any of its parents.
+    bool contains( size_t iCollection, const std::string & iPath,
+                   bool iSubtree = false ) const;
+
+    //! Fills oPaths with the member paths, of any collection, which are
+    //! iPrefix or lie beneath it, sorted.
+    void getMembersUnder( const std::string & iPrefix,
+                          std::vector< std::string > & oPaths ) const;
+
+    //! Returns iPath as it is compared in the index.
+    static std::string normalizePath( const std::string & iPath );
+
+private:
+
+    struct Collection
+    {
+        std::string objectPath;
+        std::string name;
+    };
+
+    typedef std::vector< size_t > IndexVector;
+    typedef Alembic::Util::unordered_map< std::string, IndexVector >
+        MemberMap;
+
+    const IndexVector * find( const std::string & iNormalizedPath ) const;
+
+    std::vector< Collection > m_collections;
+
+    // member path to the collections that list it, in ascending order
+    MemberMap m_members;
+
+    // the same paths sorted, for matching everything beneath a prefix
+    std::set< std::string > m_sorted;
+};
+
+typedef Util::shared_ptr< CollectionIndex > CollectionIndexPtr;
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCollection
+} // End namespace Alembic
+
+#endif
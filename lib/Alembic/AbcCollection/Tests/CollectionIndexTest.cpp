@@ -0,0 +1,231 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/Abc/All.h>
+#include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/AbcCollection/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <algorithm>
+#include <sstream>
+
+namespace Abc =  Alembic::Abc;
+namespace AbcCol = Alembic::AbcCollection;
+
+void setCollection( AbcCol::OCollections & iGroup, const std::string & iName,
+                    const std::vector< std::string > & iPaths )
+{
+    Abc::OStringArrayProperty prop =
+        iGroup.getSchema().createCollection( iName );
+    prop.set( Abc::StringArraySample( iPaths ) );
+}
+
+void write()
+{
+    Abc::OArchive archive( Alembic::AbcCoreHDF5::WriteArchive(),
+                           "CollectionIndex.abc" );
+
+    Abc::OObject root( archive, Abc::kTop );
+    Abc::OObject layers( root, "layers" );
+    AbcCol::OCollections group( layers, "Group1" );
+    AbcCol::OCollections group2( root, "Group2" );
+
+    std::vector< std::string > paths;
+    paths.push_back( "/set/trees" );
+    paths.push_back( "/char/hero/body" );
+    setCollection( group, "beauty", paths );
+
+    paths.clear();
+    paths.push_back( "/char/hero" );
+    paths.push_back( "char//hero/" );
+    paths.push_back( "/char/heroine" );
+    setCollection( group, "characters", paths );
+
+    paths.clear();
+    paths.push_back( "/set" );
+    paths.push_back( "/set-dressing" );
+    paths.push_back( "/set/trees/oak" );
+    setCollection( group2, "environment", paths );
+
+    // a big one, for comparing against a plain scan of the collections
+    paths.clear();
+    for ( size_t i = 0; i < 500; ++i )
+    {
+        std::ostringstream path;
+        path << "/crowd/agent" << i % 50 << "/part" << i;
+        paths.push_back( path.str() );
+    }
+    setCollection( group2, "crowd", paths );
+}
+
+// which collections hold iPath, reading and comparing every collection
+std::vector< std::string > scan( Abc::IArchive & iArchive,
+                                 const std::string & iPath, bool iSubtree )
+{
+    std::vector< std::string > found;
+
+    Abc::IObject layers( iArchive.getTop(), "layers" );
+    AbcCol::ICollections groups[2] = {
+        AbcCol::ICollections( layers, "Group1" ),
+        AbcCol::ICollections( iArchive.getTop(), "Group2" ) };
+
+    std::string path = AbcCol::CollectionIndex::normalizePath( iPath );
+
+    for ( size_t g = 0; g < 2; ++g )
+    {
+        AbcCol::ICollectionsSchema & schema = groups[g].getSchema();
+        for ( size_t i = 0; i < schema.getNumCollections(); ++i )
+        {
+            Abc::StringArraySamplePtr samp =
+                schema.getCollection( i ).getValue();
+            for ( size_t j = 0; j < samp->size(); ++j )
+            {
+                std::string member =
+                    AbcCol::CollectionIndex::normalizePath( ( *samp )[j] );
+                if ( member == path || ( iSubtree && ( member == "/" ||
+                     path.compare( 0, member.size() + 1, member + "/" )
+                     == 0 ) ) )
+                {
+                    found.push_back( schema.getCollectionName( i ) );
+                    break;
+                }
+            }
+        }
+    }
+
+    std::sort( found.begin(), found.end() );
+    return found;
+}
+
+std::vector< std::string > names( const AbcCol::CollectionIndex & iIndex,
+                                  const std::vector< size_t > & iIndices )
+{
+    std::vector< std::string > found;
+    for ( size_t i = 0; i < iIndices.size(); ++i )
+    {
+        found.push_back( iIndex.getCollectionName( iIndices[i] ) );
+    }
+    std::sort( found.begin(), found.end() );
+    return found;
+}
+
+void read()
+{
+    Abc::IArchive archive( Alembic::AbcCoreHDF5::ReadArchive(),
+                           "CollectionIndex.abc" );
+
+    AbcCol::CollectionIndex index( archive );
+    TESTING_ASSERT( index.getNumCollections() == 4 );
+
+    size_t beauty = index.findCollection( "/layers/Group1", "beauty" );
+    size_t characters = index.findCollection( "layers/Group1/",
+                                              "characters" );
+    size_t environment = index.findCollection( "/Group2", "environment" );
+    TESTING_ASSERT( beauty < index.getNumCollections() );
+    TESTING_ASSERT( characters < index.getNumCollections() );
+    TESTING_ASSERT( environment < index.getNumCollections() );
+    TESTING_ASSERT( index.findCollection( "/Group2", "beauty" ) ==
+                    index.getNumCollections() );
+    TESTING_ASSERT( index.getCollectionsObjectPath( environment ) ==
+                    "/Group2" );
+    TESTING_ASSERT_THROW( index.getCollectionName( 4 ),
+                          Alembic::Util::Exception );
+
+    std::vector< size_t > found;
+    index.getCollections( "/char/hero", found );
+    TESTING_ASSERT( found.size() == 1 && found[0] == characters );
+
+    index.getCollections( "/char/hero/body", found );
+    TESTING_ASSERT( found.size() == 1 && found[0] == beauty );
+
+    index.getCollectionsContaining( "/char/hero/body/", found );
+    TESTING_ASSERT( found.size() == 2 );
+
+    // a member only covers what is beneath it, not names that start alike
+    index.getCollectionsContaining( "/char/heroes", found );
+    TESTING_ASSERT( found.empty() );
+    index.getCollectionsContaining( "/set-dressing/lamp", found );
+    TESTING_ASSERT( found.size() == 1 && found[0] == environment );
+
+    TESTING_ASSERT( index.contains( environment, "/set/trees/pine", true ) );
+    TESTING_ASSERT( !index.contains( environment, "/set/trees/pine" ) );
+    TESTING_ASSERT( index.contains( beauty, "set/trees" ) );
+    TESTING_ASSERT( !index.contains( beauty, "/set" ) );
+
+    std::vector< std::string > members;
+    index.getMembersUnder( "/set", members );
+    TESTING_ASSERT( members.size() == 3 );
+    TESTING_ASSERT( members[0] == "/set" );
+    TESTING_ASSERT( members[1] == "/set/trees" );
+    TESTING_ASSERT( members[2] == "/set/trees/oak" );
+
+    index.getMembersUnder( "/char", members );
+    TESTING_ASSERT( members.size() == 3 );
+
+    index.getMembersUnder( "/crowd/agent7", members );
+    TESTING_ASSERT( members.size() == 10 );
+
+    index.getMembersUnder( "/", members );
+    TESTING_ASSERT( members.size() == 507 );
+
+    // the index agrees with reading every collection
+    const char * queries[] = { "/set/trees/oak/leaf", "/set", "/char",
+        "/char/hero", "/char/heroine/hair", "/crowd/agent3/part53",
+        "/crowd/agent3/part53/mesh", "/crowd/agent3", "/nothing", "/" };
+
+    for ( size_t q = 0; q < sizeof( queries ) / sizeof( queries[0] ); ++q )
+    {
+        index.getCollections( queries[q], found );
+        TESTING_ASSERT( names( index, found ) ==
+                        scan( archive, queries[q], false ) );
+
+        index.getCollectionsContaining( queries[q], found );
+        TESTING_ASSERT( names( index, found ) ==
+                        scan( archive, queries[q], true ) );
+    }
+
+    TESTING_ASSERT( AbcCol::CollectionIndex::normalizePath( "" ) == "/" );
+    TESTING_ASSERT( AbcCol::CollectionIndex::normalizePath( "//a//b/" ) ==
+                    "/a/b" );
+}
+
+int main( int argc, char *argv[] )
+{
+    write();
+    read();
+    return 0;
+}
@@ -38,10 +38,12 @@
 #define _Alembic_AbcCoreAbstract_All_h_
 
 #include <Alembic/AbcCoreAbstract/ArchiveReader.h>
+#include <Alembic/AbcCoreAbstract/ArchiveStats.h>
 #include <Alembic/AbcCoreAbstract/ArchiveWriter.h>
 #include <Alembic/AbcCoreAbstract/ArrayPropertyReader.h>
 #include <Alembic/AbcCoreAbstract/ArrayPropertyWriter.h>
 #include <Alembic/AbcCoreAbstract/ArraySample.h>
+#include <Alembic/AbcCoreAbstract/ArraySampleAllocator.h>
 #include <Alembic/AbcCoreAbstract/ArraySampleKey.h>
 #include <Alembic/AbcCoreAbstract/BasePropertyReader.h>
 #include <Alembic/AbcCoreAbstract/BasePropertyWriter.h>
@@ -55,6 +57,7 @@
 #include <Alembic/AbcCoreAbstract/ObjectReader.h>
 #include <Alembic/AbcCoreAbstract/ObjectWriter.h>
 #include <Alembic/AbcCoreAbstract/PropertyHeader.h>
+#include <Alembic/AbcCoreAbstract/ReadContext.h>
 #include <Alembic/AbcCoreAbstract/ScalarPropertyReader.h>
 #include <Alembic/AbcCoreAbstract/ScalarPropertyWriter.h>
 #include <Alembic/AbcCoreAbstract/ScalarSample.h>
@@ -46,6 +46,82 @@ ArchiveReader::~ArchiveReader()
     // Nothing
 }
 
+//-*****************************************************************************
+void ArchiveReader::setArraySampleAllocator(
+    ArraySampleAllocatorPtr iAllocator )
+{
+    // Nothing
+}
+
+//-*****************************************************************************
+ArraySampleAllocatorPtr ArchiveReader::getArraySampleAllocator()
+{
+    return ArraySampleAllocatorPtr();
+}
+
+//-*****************************************************************************
+bool ArchiveReader::isReentrant() const
+{
+    return true;
+}
+
+//-*****************************************************************************
+void ArchiveReader::setStatsEnabled( bool iEnabled )
+{
+    // Nothing
+}
+
+//-*****************************************************************************
+bool ArchiveReader::getStats( ArchiveStats & oStats )
+{
+    return false;
+}
+
+//-*****************************************************************************
+void ArchiveReader::resetStats()
+{
+    // Nothing
+}
+
+//-*****************************************************************************
+ReadContextPtr ArchiveReader::createReadContext()
+{
+    return ReadContextPtr();
+}
+
+//-*****************************************************************************
+uint64_t ArchiveReader::prefetch(
+    const std::vector< ArrayPropertyReaderPtr > & iProperties,
+    chrono_t iStartTime, chrono_t iEndTime, int32_t iPriority )
+{
+    return 0;
+}
+
+//-*****************************************************************************
+void ArchiveReader::cancelPrefetch( uint64_t iRequest )
+{
+    // Nothing
+}
+
+//-*****************************************************************************
+void ArchiveReader::cancelAllPrefetches()
+{
+    // Nothing
+}
+
+//-*****************************************************************************
+void ArchiveReader::waitForPrefetch( uint64_t iRequest )
+{
+    // Nothing
+}
+
+//-*****************************************************************************
+void ArchiveReader::setPrefetchLimits( std::size_t iNumThreads,
+                                       std::size_t iMaxBytes )
+{
+    // Nothing
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace AbcCoreAbstract
 } // End namespace Alembic
@@ -40,6 +40,9 @@
 #include <Alembic/AbcCoreAbstract/Foundation.h>
 #include <Alembic/AbcCoreAbstract/ForwardDeclarations.h>
 #include <Alembic/AbcCoreAbstract/ReadArraySampleCache.h>
+#include <Alembic/AbcCoreAbstract/ArchiveStats.h>
+#include <Alembic/AbcCoreAbstract/ArraySampleAllocator.h>
+#include <Alembic/AbcCoreAbstract/ReadContext.h>
 
 namespace Alembic {
 namespace AbcCoreAbstract {
@@ -105,6 +108,17 @@ public:
     //! will be disabled if a NULL cache is passed here.
     virtual void setReadArraySampleCachePtr( ReadArraySampleCachePtr iPtr ) = 0;
 
+    //! Sets where the data of array samples read from this archive comes
+    //! from, see ArraySampleAllocator.  An empty pointer, the default, uses
+    //! new and delete.  Allocators can be shared amongst archives.  It
+    //! must be set before any samples are read or prefetched, it isn't
+    //! safe to change while reads are going on in other threads.
+    //! Implementations which don't support allocators ignore it.
+    virtual void setArraySampleAllocator( ArraySampleAllocatorPtr iAllocator );
+
+    //! Returns the allocator set with setArraySampleAllocator, if any.
+    virtual ArraySampleAllocatorPtr getArraySampleAllocator();
+
     //! Returns the TimeSampling at a given index.
     virtual TimeSamplingPtr getTimeSampling( uint32_t iIndex ) = 0;
 
@@ -122,6 +136,60 @@ public:
     //! of this archive file.
     virtual int32_t getArchiveVersion() = 0;
 
+    //! Whether this archive can be read from other threads while other
+    //! archives of the same core are read or written, without the caller
+    //! serializing those calls.  HDF5 archives return false: the HDF5
+    //! library isn't reentrant, and while AbcCoreHDF5 locks its reads
+    //! against each other, its writes don't take that lock.
+    virtual bool isReentrant() const;
+
+    //! Turns the gathering of I/O statistics on or off.  Gathering is off
+    //! by default, and implementations which don't gather statistics
+    //! ignore this.
+    virtual void setStatsEnabled( bool iEnabled );
+
+    //! Fills oStats with the statistics gathered so far and returns true,
+    //! or returns false if this implementation doesn't gather them.
+    virtual bool getStats( ArchiveStats & oStats );
+
+    //! Sets the gathered statistics back to 0.
+    virtual void resetStats();
+
+    //! Creates a context for one thread to pass to the sample reading
+    //! calls of this archive's properties, see ReadContext.  Returns an
+    //! empty pointer if this implementation has no use for one, which may
+    //! also be passed to those calls.  A context may hold a stream for as
+    //! long as it lives, which counts against a limit on the number of
+    //! streams.
+    virtual ReadContextPtr createReadContext();
+
+    //! Schedules the samples of iProperties between iStartTime and iEndTime
+    //! to be read on background threads, so that reading them later
+    //! doesn't wait on I/O.  Requests with a higher iPriority are read
+    //! first, requests of the same priority in the order they were made.
+    //! Returns an id for cancelPrefetch and waitForPrefetch, or 0 if this
+    //! implementation doesn't prefetch, in which case nothing is read.
+    virtual uint64_t prefetch(
+        const std::vector< ArrayPropertyReaderPtr > & iProperties,
+        chrono_t iStartTime, chrono_t iEndTime, int32_t iPriority = 0 );
+
+    //! Drops the reads of the iRequest prefetch which haven't started yet.
+    //! Samples which have already been read stay available.
+    virtual void cancelPrefetch( uint64_t iRequest );
+
+    //! Drops every prefetch read which hasn't started yet, for when the
+    //! frames they were for are no longer wanted.
+    virtual void cancelAllPrefetches();
+
+    //! Blocks until every read of the iRequest prefetch is done or
+    //! cancelled.
+    virtual void waitForPrefetch( uint64_t iRequest );
+
+    //! Sets how many background threads prefetch, and how many bytes of
+    //! prefetched samples are held before the oldest are dropped.
+    virtual void setPrefetchLimits( std::size_t iNumThreads,
+                                    std::size_t iMaxBytes );
+
     //! Return self
     //! ...
     virtual ArchiveReaderPtr asArchivePtr() = 0;
@@ -0,0 +1,104 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <Alembic/AbcCoreAbstract/ArchiveStats.h>
+
+namespace Alembic {
+namespace AbcCoreAbstract {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+void ArchiveStats::reset()
+{
+    streams.clear();
+    numStreamFallbacks = 0;
+    cacheHits = 0;
+    cacheMisses = 0;
+    samplesDecoded = 0;
+    conversionTime = 0.0;
+
+    samplesWritten = 0;
+    bytesWritten = 0;
+    samplesDeduped = 0;
+    bytesDeduped = 0;
+}
+
+//-*****************************************************************************
+void ArchiveStats::writeJSON( std::ostream &oStream ) const
+{
+    std::ios_base::fmtflags flags = oStream.flags();
+    std::streamsize precision = oStream.precision( 9 );
+    oStream.setf( std::ios_base::fixed, std::ios_base::floatfield );
+
+    oStream << "{\"streams\": [";
+    for ( size_t i = 0; i < streams.size(); ++i )
+    {
+        if ( i > 0 )
+        {
+            oStream << ", ";
+        }
+
+        oStream << "{\"numReads\": " << streams[i].numReads
+                << ", \"bytesRead\": " << streams[i].bytesRead
+                << ", \"lockWaitTime\": " << streams[i].lockWaitTime
+                << ", \"numSeeks\": " << streams[i].numSeeks
+                << ", \"seekDistance\": " << streams[i].seekDistance << "}";
+    }
+
+    oStream << "], \"numStreamFallbacks\": " << numStreamFallbacks
+            << ", \"cacheHits\": " << cacheHits
+            << ", \"cacheMisses\": " << cacheMisses
+            << ", \"samplesDecoded\": " << samplesDecoded
+            << ", \"conversionTime\": " << conversionTime
+            << ", \"samplesWritten\": " << samplesWritten
+            << ", \"bytesWritten\": " << bytesWritten
+            << ", \"samplesDeduped\": " << samplesDeduped
+            << ", \"bytesDeduped\": " << bytesDeduped << "}";
+
+    oStream.precision( precision );
+    oStream.flags( flags );
+}
+
+//-*****************************************************************************
+std::string ArchiveStats::toJSON() const
+{
+    std::ostringstream strm;
+    writeJSON( strm );
+    return strm.str();
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreAbstract
+} // End namespace Alembic
@@ -0,0 +1,125 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef _Alembic_AbcCoreAbstract_ArchiveStats_h_
+#define _Alembic_AbcCoreAbstract_ArchiveStats_h_
+
+#include <Alembic/AbcCoreAbstract/Foundation.h>
+
+namespace Alembic {
+namespace AbcCoreAbstract {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! I/O and cache counters gathered by an archive while statistics are
+//! enabled on it via ArchiveReader::setStatsEnabled or
+//! ArchiveWriter::setStatsEnabled.  Gathering is off by default, and an
+//! implementation which doesn't support some counter leaves it at 0.
+//! Times are in seconds.
+struct ArchiveStats
+{
+    //! Counters for one of the streams an archive reads through.
+    struct Stream
+    {
+        Stream() : numReads( 0 ), bytesRead( 0 ), lockWaitTime( 0.0 ),
+            numSeeks( 0 ), seekDistance( 0 ) {}
+
+        uint64_t numReads;
+        uint64_t bytesRead;
+
+        //! Time spent waiting for another thread to finish with the stream.
+        double lockWaitTime;
+
+        //! Seeks a cold read of the file would have made, and how far they
+        //! jumped in bytes.  Each 4k page is counted as fetched the first
+        //! time it is read, and fetching a page other than the one after the
+        //! last fetched is a seek.
+        uint64_t numSeeks;
+        uint64_t seekDistance;
+    };
+
+    ArchiveStats() { reset(); }
+
+    //! Sets every counter back to 0.
+    void reset();
+
+    //! Writes the counters out as a single JSON object.
+    void writeJSON( std::ostream &oStream ) const;
+    std::string toJSON() const;
+
+    //-*************************************************************************
+    // READING
+    //-*************************************************************************
+
+    //! One entry per stream, in stream ID order.
+    std::vector<Stream> streams;
+
+    //! How often a reader had to share the default stream because every
+    //! other stream was in use.  The extra lock waits this causes show up
+    //! on the first stream.
+    uint64_t numStreamFallbacks;
+
+    //! How often an already open object or property reader could be handed
+    //! out again, versus having to be built from the file.
+    uint64_t cacheHits;
+    uint64_t cacheMisses;
+
+    //! The number of samples read and decoded into memory, and the time
+    //! spent converting them after they had been read.
+    uint64_t samplesDecoded;
+    double conversionTime;
+
+    //-*************************************************************************
+    // WRITING
+    //-*************************************************************************
+
+    //! Sample data actually written out.
+    uint64_t samplesWritten;
+    uint64_t bytesWritten;
+
+    //! Sample data which matched something already written, and so was
+    //! stored as a reference instead.
+    uint64_t samplesDeduped;
+    uint64_t bytesDeduped;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreAbstract
+} // End namespace Alembic
+
+#endif
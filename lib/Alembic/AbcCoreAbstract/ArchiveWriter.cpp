@@ -46,6 +46,30 @@ ArchiveWriter::~ArchiveWriter()
     // Nothing
 }
 
+//-*****************************************************************************
+bool ArchiveWriter::isReentrant() const
+{
+    return true;
+}
+
+//-*****************************************************************************
+void ArchiveWriter::setStatsEnabled( bool iEnabled )
+{
+    // Nothing
+}
+
+//-*****************************************************************************
+bool ArchiveWriter::getStats( ArchiveStats & oStats )
+{
+    return false;
+}
+
+//-*****************************************************************************
+void ArchiveWriter::resetStats()
+{
+    // Nothing
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace AbcCoreAbstract
 } // End namespace Alembic
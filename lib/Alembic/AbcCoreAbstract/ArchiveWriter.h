@@ -38,6 +38,7 @@
 #define _Alembic_AbcCoreAbstract_ArchiveWriter_h_
 
 #include <Alembic/AbcCoreAbstract/Foundation.h>
+#include <Alembic/AbcCoreAbstract/ArchiveStats.h>
 #include <Alembic/AbcCoreAbstract/MetaData.h>
 #include <Alembic/AbcCoreAbstract/ForwardDeclarations.h>
 
@@ -138,6 +139,24 @@ public:
     virtual void setMaxNumSamplesForTimeSamplingIndex( uint32_t iIndex,
                                                        index_t iMaxIndex ) = 0;
 
+    //! Whether this archive can be written from other threads while other
+    //! archives of the same core are read or written, without the caller
+    //! serializing those calls.  HDF5 archives return false, see
+    //! ArchiveReader::isReentrant.
+    virtual bool isReentrant() const;
+
+    //! Turns the gathering of I/O statistics on or off.  Gathering is off
+    //! by default, and implementations which don't gather statistics
+    //! ignore this.
+    virtual void setStatsEnabled( bool iEnabled );
+
+    //! Fills oStats with the statistics gathered so far and returns true,
+    //! or returns false if this implementation doesn't gather them.
+    virtual bool getStats( ArchiveStats & oStats );
+
+    //! Sets the gathered statistics back to 0.
+    virtual void resetStats();
+
 private:
     int8_t m_compressionHint;
 };
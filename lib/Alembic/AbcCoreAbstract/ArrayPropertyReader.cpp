@@ -35,6 +35,8 @@
 //-*****************************************************************************
 
 #include <Alembic/AbcCoreAbstract/ArrayPropertyReader.h>
+#include <algorithm>
+#include <cstring>
 
 namespace Alembic {
 namespace AbcCoreAbstract {
@@ -46,6 +48,87 @@ ArrayPropertyReader::~ArrayPropertyReader()
     // Nothing
 }
 
+//-*****************************************************************************
+void ArrayPropertyReader::getSample( index_t iSampleIndex,
+                                     ArraySamplePtr &oSample,
+                                     ReadContext * iContext )
+{
+    getSample( iSampleIndex, oSample );
+}
+
+//-*****************************************************************************
+bool ArrayPropertyReader::getKey( index_t iSampleIndex, ArraySampleKey & oKey,
+                                  ReadContext * iContext )
+{
+    return getKey( iSampleIndex, oKey );
+}
+
+//-*****************************************************************************
+void ArrayPropertyReader::getDimensions( index_t iSampleIndex,
+                                         Dimensions & oDim,
+                                         ReadContext * iContext )
+{
+    getDimensions( iSampleIndex, oDim );
+}
+
+//-*****************************************************************************
+void ArrayPropertyReader::getAs( index_t iSample, void *iIntoLocation,
+                                 PlainOldDataType iPod,
+                                 ReadContext * iContext )
+{
+    getAs( iSample, iIntoLocation, iPod );
+}
+
+//-*****************************************************************************
+void ArrayPropertyReader::getRangeAs( index_t iSample, size_t iStart,
+                                      size_t iCount, void *iIntoLocation,
+                                      PlainOldDataType iPod,
+                                      ReadContext * iContext )
+{
+    Dimensions dims;
+    getDimensions( iSample, dims, iContext );
+
+    ABCA_ASSERT( iStart <= dims.numPoints() &&
+                 iCount <= dims.numPoints() - iStart,
+                 "Range " << iStart << " + " << iCount <<
+                 " is outside of the sample, which has " <<
+                 dims.numPoints() << " elements." );
+
+    if ( iCount == 0 )
+    {
+        return;
+    }
+
+    DataType dtype( iPod, getDataType().getExtent() );
+    ArraySamplePtr whole = AllocateArraySample( dtype, dims );
+    getAs( iSample, const_cast< void * >( whole->getData() ), iPod,
+           iContext );
+
+    size_t first = iStart * dtype.getExtent();
+    size_t num = iCount * dtype.getExtent();
+
+    if ( iPod == kStringPOD )
+    {
+        const std::string * from =
+            static_cast< const std::string * >( whole->getData() ) + first;
+        std::copy( from, from + num,
+                   static_cast< std::string * >( iIntoLocation ) );
+    }
+    else if ( iPod == kWstringPOD )
+    {
+        const std::wstring * from =
+            static_cast< const std::wstring * >( whole->getData() ) + first;
+        std::copy( from, from + num,
+                   static_cast< std::wstring * >( iIntoLocation ) );
+    }
+    else
+    {
+        size_t podBytes = PODNumBytes( iPod );
+        memcpy( iIntoLocation, static_cast< const char * >(
+            whole->getData() ) + first * podBytes, num * podBytes );
+    }
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace AbcCoreAbstract
 } // End namespace Alembic
@@ -40,6 +40,7 @@
 #include <Alembic/AbcCoreAbstract/Foundation.h>
 #include <Alembic/AbcCoreAbstract/BasePropertyReader.h>
 #include <Alembic/AbcCoreAbstract/ArraySample.h>
+#include <Alembic/AbcCoreAbstract/ReadContext.h>
 
 namespace Alembic {
 namespace AbcCoreAbstract {
@@ -139,6 +140,35 @@ public:
     //! and std::wstring as core language-level primitives.
     virtual void getAs( index_t iSample, void *iIntoLocation,
                         PlainOldDataType iPod ) = 0;
+
+    //-*************************************************************************
+    // The same as the above, but given a ReadContext created by the archive
+    // of this property for the calling thread (or NULL).  By default the
+    // context is ignored.
+    //-*************************************************************************
+
+    virtual void getSample( index_t iSampleIndex,
+                            ArraySamplePtr &oSample,
+                            ReadContext * iContext );
+
+    virtual bool getKey( index_t iSampleIndex, ArraySampleKey & oKey,
+                         ReadContext * iContext );
+
+    virtual void getDimensions( index_t iSampleIndex, Dimensions & oDim,
+                                ReadContext * iContext );
+
+    virtual void getAs( index_t iSample, void *iIntoLocation,
+                        PlainOldDataType iPod, ReadContext * iContext );
+
+    //! Like getAs, but only reads iCount elements of the sample starting at
+    //! element iStart.  An element is one DataType, so with an extent of 3
+    //! it is 3 PODs.  A range which isn't inside the sample causes an
+    //! exception to be thrown.
+    //! The default reads the whole sample and copies the range out of it,
+    //! implementations which can read just the range override it.
+    virtual void getRangeAs( index_t iSample, size_t iStart, size_t iCount,
+                             void *iIntoLocation, PlainOldDataType iPod,
+                             ReadContext * iContext = NULL );
 };
 
 } // End namespace ALEMBIC_VERSION_NS
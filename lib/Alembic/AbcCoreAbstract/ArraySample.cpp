@@ -182,6 +182,65 @@ ArraySamplePtr AllocateArraySample( const DataType &iDtype,
     }
 }
 
+//-*****************************************************************************
+namespace {
+
+// hands the data back to the allocator it came from
+class AllocatorDeleter
+{
+public:
+    AllocatorDeleter( const ArraySampleAllocatorPtr &iAllocator,
+                      size_t iNumBytes )
+      : m_allocator( iAllocator ), m_numBytes( iNumBytes ) {}
+
+    void operator()( ArraySample *iSample ) const
+    {
+        if ( iSample )
+        {
+            m_allocator->deallocate( const_cast<void*>( iSample->getData() ),
+                                     m_numBytes );
+        }
+        delete iSample;
+    }
+
+private:
+    ArraySampleAllocatorPtr m_allocator;
+    size_t m_numBytes;
+};
+
+} // End anonymous namespace
+
+//-*****************************************************************************
+ArraySamplePtr AllocateArraySample( const DataType &iDtype,
+                                    const Dimensions &iDims,
+                                    const ArraySampleAllocatorPtr &iAllocator )
+{
+    PlainOldDataType pod = iDtype.getPod();
+    size_t numBytes = iDtype.getNumBytes() * iDims.numPoints();
+
+    // strings need constructing, so they keep coming from new[]
+    if ( !iAllocator || numBytes == 0 || pod == kStringPOD ||
+         pod == kWstringPOD || pod >= kNumPlainOldDataTypes )
+    {
+        return AllocateArraySample( iDtype, iDims );
+    }
+
+    void *data = iAllocator->allocate( numBytes );
+
+    ArraySample *sample = NULL;
+    try
+    {
+        sample = new ArraySample( data, iDtype, iDims );
+    }
+    catch ( ... )
+    {
+        iAllocator->deallocate( data, numBytes );
+        throw;
+    }
+
+    return ArraySamplePtr( sample, AllocatorDeleter( iAllocator, numBytes ) );
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace AbcCoreAbstract
 } // End namespace Alembic
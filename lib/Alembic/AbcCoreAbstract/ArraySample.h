@@ -38,6 +38,7 @@
 #define _Alembic_AbcCoreAbstract_ArraySample_h_
 
 #include <Alembic/AbcCoreAbstract/Foundation.h>
+#include <Alembic/AbcCoreAbstract/ArraySampleAllocator.h>
 #include <Alembic/AbcCoreAbstract/ArraySampleKey.h>
 #include <Alembic/AbcCoreAbstract/DataType.h>
 
@@ -147,6 +148,13 @@ typedef Alembic::Util::shared_ptr<ArraySample> ArraySamplePtr;
 ArraySamplePtr AllocateArraySample( const DataType &iDtype,
                                     const Dimensions &iDims );
 
+//! As above, except that the data of a non-string sample comes from
+//! iAllocator, which the sample holds on to until it is released.  An empty
+//! iAllocator gives the same result as the function above.
+ArraySamplePtr AllocateArraySample( const DataType &iDtype,
+                                    const Dimensions &iDims,
+                                    const ArraySampleAllocatorPtr &iAllocator );
+
 //-*****************************************************************************
 //-*****************************************************************************
 //-*****************************************************************************
@@ -0,0 +1,362 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreAbstract/ArraySampleAllocator.h>
+
+// each thread is given a slot the first time it allocates, which picks the
+// cache it goes through in every pool
+#if defined(_MSC_VER)
+#define ALEMBIC_POOL_TLS __declspec( thread )
+#elif !defined(__APPLE__) && defined(__GNUC__)
+#define ALEMBIC_POOL_TLS __thread
+#endif
+
+namespace Alembic {
+namespace AbcCoreAbstract {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+#ifdef ALEMBIC_POOL_TLS
+// one more than this thread's slot, so that 0 means it hasn't got one yet
+ALEMBIC_POOL_TLS std::size_t g_threadSlot = 0;
+
+Alembic::Util::mutex g_slotMutex;
+std::size_t g_numSlots = 0;
+#endif
+
+//-*****************************************************************************
+// 16 byte steps up to 64 bytes, then four steps for every doubling, which
+// wastes at most a fifth of a block
+std::size_t SizeClass( std::size_t iNumBytes, std::size_t & oBlockBytes )
+{
+    if ( iNumBytes <= 64 )
+    {
+        std::size_t step = ( iNumBytes + 15 ) / 16;
+        if ( step == 0 )
+        {
+            step = 1;
+        }
+
+        oBlockBytes = step * 16;
+        return step - 1;
+    }
+
+    // find p where 2^p < iNumBytes <= 2^(p+1)
+    std::size_t p = 6;
+    while ( ( std::size_t( 1 ) << ( p + 1 ) ) < iNumBytes )
+    {
+        ++p;
+    }
+
+    std::size_t base = std::size_t( 1 ) << p;
+    std::size_t stepBytes = base / 4;
+    std::size_t step = ( iNumBytes - base + stepBytes - 1 ) / stepBytes;
+
+    oBlockBytes = base + step * stepBytes;
+    return 4 + ( p - 6 ) * 4 + step - 1;
+}
+
+} // End anonymous namespace
+
+//-*****************************************************************************
+ArraySampleAllocator::~ArraySampleAllocator()
+{
+    // Nothing
+}
+
+//-*****************************************************************************
+bool ArraySampleAllocator::getStats( ArraySampleAllocatorStats & oStats )
+{
+    return false;
+}
+
+//-*****************************************************************************
+struct PooledArraySampleAllocator::Pool
+{
+    Pool( std::size_t iNumClasses, std::size_t iMaxPooledBytes )
+      : freeLists( iNumClasses ), maxPooledBytes( iMaxPooledBytes ) {}
+
+    Alembic::Util::mutex lock;
+
+    // released blocks, by size class
+    std::vector< std::vector< void * > > freeLists;
+
+    std::size_t maxPooledBytes;
+
+    // the counts for calls which went through this pool
+    ArraySampleAllocatorStats stats;
+};
+
+//-*****************************************************************************
+PooledArraySampleAllocator::PooledArraySampleAllocator(
+    size_t iMaxPooledBytes, size_t iMaxBlockBytes, size_t iNumThreadCaches )
+  : m_maxBlockBytes( iMaxBlockBytes )
+{
+    if ( m_maxBlockBytes < 16 )
+    {
+        m_maxBlockBytes = 16;
+    }
+
+    if ( iNumThreadCaches == 0 )
+    {
+        iNumThreadCaches = 1;
+    }
+
+    std::size_t maxBlock = 0;
+    m_numClasses = SizeClass( m_maxBlockBytes, maxBlock ) + 1;
+
+    // the thread caches get half of what may be pooled between them, the
+    // shared pool gets the rest
+    std::size_t perCache = iMaxPooledBytes / 2 / iNumThreadCaches;
+    m_pool = new Pool( m_numClasses, iMaxPooledBytes - perCache *
+                       iNumThreadCaches );
+
+    m_threadCaches.resize( iNumThreadCaches );
+    for ( std::size_t i = 0; i < iNumThreadCaches; ++i )
+    {
+        m_threadCaches[i] = new Pool( m_numClasses, perCache );
+    }
+}
+
+//-*****************************************************************************
+PooledArraySampleAllocator::~PooledArraySampleAllocator()
+{
+    releasePooled();
+
+    for ( std::size_t i = 0; i < m_threadCaches.size(); ++i )
+    {
+        delete m_threadCaches[i];
+    }
+
+    delete m_pool;
+}
+
+//-*****************************************************************************
+PooledArraySampleAllocator::Pool &
+PooledArraySampleAllocator::getThreadCache()
+{
+#ifdef ALEMBIC_POOL_TLS
+    if ( g_threadSlot == 0 )
+    {
+        Alembic::Util::scoped_lock l( g_slotMutex );
+        g_threadSlot = ++g_numSlots;
+    }
+
+    return *m_threadCaches[ ( g_threadSlot - 1 ) % m_threadCaches.size() ];
+#else
+    // without thread locals every thread goes through the first cache
+    return *m_threadCaches[0];
+#endif
+}
+
+//-*****************************************************************************
+size_t PooledArraySampleAllocator::getBlockSize( size_t iNumBytes ) const
+{
+    if ( iNumBytes > m_maxBlockBytes )
+    {
+        return iNumBytes;
+    }
+
+    std::size_t blockBytes = 0;
+    SizeClass( iNumBytes, blockBytes );
+    return blockBytes;
+}
+
+//-*****************************************************************************
+void * PooledArraySampleAllocator::allocate( size_t iNumBytes )
+{
+    Pool & cache = getThreadCache();
+
+    if ( iNumBytes > m_maxBlockBytes )
+    {
+        {
+            Alembic::Util::scoped_lock l( cache.lock );
+            ++cache.stats.numAllocations;
+            ++cache.stats.numHeapAllocations;
+            cache.stats.bytesInUse += iNumBytes;
+        }
+
+        return ::operator new( iNumBytes );
+    }
+
+    std::size_t blockBytes = 0;
+    std::size_t sizeClass = SizeClass( iNumBytes, blockBytes );
+
+    {
+        Alembic::Util::scoped_lock l( cache.lock );
+        ++cache.stats.numAllocations;
+        cache.stats.bytesInUse += blockBytes;
+
+        std::vector< void * > & freeList = cache.freeLists[sizeClass];
+        if ( !freeList.empty() )
+        {
+            void * block = freeList.back();
+            freeList.pop_back();
+            cache.stats.bytesPooled -= blockBytes;
+            ++cache.stats.numThreadCacheHits;
+            return block;
+        }
+    }
+
+    {
+        Alembic::Util::scoped_lock l( m_pool->lock );
+
+        std::vector< void * > & freeList = m_pool->freeLists[sizeClass];
+        if ( !freeList.empty() )
+        {
+            void * block = freeList.back();
+            freeList.pop_back();
+            m_pool->stats.bytesPooled -= blockBytes;
+            ++m_pool->stats.numPoolHits;
+            return block;
+        }
+
+        ++m_pool->stats.numHeapAllocations;
+    }
+
+    return ::operator new( blockBytes );
+}
+
+//-*****************************************************************************
+void PooledArraySampleAllocator::deallocate( void * iMemory,
+                                             size_t iNumBytes )
+{
+    if ( iMemory == NULL )
+    {
+        return;
+    }
+
+    Pool & cache = getThreadCache();
+
+    if ( iNumBytes > m_maxBlockBytes )
+    {
+        {
+            Alembic::Util::scoped_lock l( cache.lock );
+            ++cache.stats.numDeallocations;
+            ++cache.stats.numHeapFrees;
+            cache.stats.bytesInUse -= iNumBytes;
+        }
+
+        ::operator delete( iMemory );
+        return;
+    }
+
+    std::size_t blockBytes = 0;
+    std::size_t sizeClass = SizeClass( iNumBytes, blockBytes );
+
+    {
+        Alembic::Util::scoped_lock l( cache.lock );
+        ++cache.stats.numDeallocations;
+        cache.stats.bytesInUse -= blockBytes;
+
+        if ( cache.stats.bytesPooled + blockBytes <= cache.maxPooledBytes )
+        {
+            cache.freeLists[sizeClass].push_back( iMemory );
+            cache.stats.bytesPooled += blockBytes;
+            return;
+        }
+    }
+
+    {
+        Alembic::Util::scoped_lock l( m_pool->lock );
+
+        if ( m_pool->stats.bytesPooled + blockBytes <=
+             m_pool->maxPooledBytes )
+        {
+            m_pool->freeLists[sizeClass].push_back( iMemory );
+            m_pool->stats.bytesPooled += blockBytes;
+            return;
+        }
+
+        ++m_pool->stats.numHeapFrees;
+    }
+
+    ::operator delete( iMemory );
+}
+
+//-*****************************************************************************
+bool PooledArraySampleAllocator::getStats( ArraySampleAllocatorStats & oStats )
+{
+    oStats = ArraySampleAllocatorStats();
+
+    for ( std::size_t i = 0; i <= m_threadCaches.size(); ++i )
+    {
+        Pool * pool = ( i < m_threadCaches.size() ) ?
+            m_threadCaches[i] : m_pool;
+
+        Alembic::Util::scoped_lock l( pool->lock );
+        oStats.numAllocations += pool->stats.numAllocations;
+        oStats.numDeallocations += pool->stats.numDeallocations;
+        oStats.numThreadCacheHits += pool->stats.numThreadCacheHits;
+        oStats.numPoolHits += pool->stats.numPoolHits;
+        oStats.numHeapAllocations += pool->stats.numHeapAllocations;
+        oStats.numHeapFrees += pool->stats.numHeapFrees;
+        oStats.bytesInUse += pool->stats.bytesInUse;
+        oStats.bytesPooled += pool->stats.bytesPooled;
+    }
+
+    return true;
+}
+
+//-*****************************************************************************
+void PooledArraySampleAllocator::releasePooled()
+{
+    for ( std::size_t i = 0; i <= m_threadCaches.size(); ++i )
+    {
+        Pool * pool = ( i < m_threadCaches.size() ) ?
+            m_threadCaches[i] : m_pool;
+
+        Alembic::Util::scoped_lock l( pool->lock );
+        for ( std::size_t j = 0; j < pool->freeLists.size(); ++j )
+        {
+            std::vector< void * > & freeList = pool->freeLists[j];
+            pool->stats.numHeapFrees += freeList.size();
+            for ( std::size_t k = 0; k < freeList.size(); ++k )
+            {
+                ::operator delete( freeList[k] );
+            }
+
+            std::vector< void * >().swap( freeList );
+        }
+
+        pool->stats.bytesPooled = 0;
+    }
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreAbstract
+} // End namespace Alembic
@@ -0,0 +1,154 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcCoreAbstract_ArraySampleAllocator_h_
+#define _Alembic_AbcCoreAbstract_ArraySampleAllocator_h_
+
+#include <Alembic/AbcCoreAbstract/Foundation.h>
+
+namespace Alembic {
+namespace AbcCoreAbstract {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! Counters kept by an ArraySampleAllocator.  Byte counts are for the
+//! blocks actually handed out, which a pool may round up.
+struct ArraySampleAllocatorStats
+{
+    ArraySampleAllocatorStats()
+      : numAllocations( 0 ), numDeallocations( 0 ), numThreadCacheHits( 0 ),
+        numPoolHits( 0 ), numHeapAllocations( 0 ), numHeapFrees( 0 ),
+        bytesInUse( 0 ), bytesPooled( 0 ) {}
+
+    uint64_t numAllocations;
+    uint64_t numDeallocations;
+
+    //! Allocations served by the calling thread's cache, by the shared
+    //! pool, and by going to the heap.
+    uint64_t numThreadCacheHits;
+    uint64_t numPoolHits;
+    uint64_t numHeapAllocations;
+
+    //! Released blocks handed back to the heap because the pool was full.
+    uint64_t numHeapFrees;
+
+    //! Bytes currently held by samples, and held in the pool for reuse.
+    int64_t bytesInUse;
+    uint64_t bytesPooled;
+};
+
+//-*****************************************************************************
+//! Provides the memory that the data of array samples is read into.  Set
+//! one on an archive with ArchiveReader::setArraySampleAllocator; samples
+//! hold on to the allocator they came from, so it lives until the last of
+//! them has been released.
+//! Implementations must be safe to call from many threads at once.
+class ArraySampleAllocator : private Alembic::Util::noncopyable
+{
+public:
+    virtual ~ArraySampleAllocator();
+
+    //! Returns iNumBytes of memory, aligned for any plain old data type.
+    virtual void * allocate( size_t iNumBytes ) = 0;
+
+    //! Takes back memory from allocate, iNumBytes is what was asked for.
+    virtual void deallocate( void * iMemory, size_t iNumBytes ) = 0;
+
+    //! Fills oStats and returns true, or returns false if this allocator
+    //! doesn't keep statistics.
+    virtual bool getStats( ArraySampleAllocatorStats & oStats );
+};
+
+//-*****************************************************************************
+//! The default ArraySampleAllocator.  Requests are rounded up to one of a
+//! set of size classes (16 byte steps up to 64 bytes, then four steps per
+//! doubling) and released blocks are kept per class to be handed out again.
+//!
+//! Each thread first goes through a small cache of its own, so that threads
+//! reading at the same time rarely touch the same lock, then through a
+//! shared pool, and finally the heap.  Requests larger than iMaxBlockBytes
+//! always go to the heap.  Between them the caches and the pool hold on to
+//! at most iMaxPooledBytes of released memory, anything beyond that is
+//! freed.
+class PooledArraySampleAllocator : public ArraySampleAllocator
+{
+public:
+    PooledArraySampleAllocator( size_t iMaxPooledBytes = 256 * 1024 * 1024,
+                                size_t iMaxBlockBytes = 16 * 1024 * 1024,
+                                size_t iNumThreadCaches = 16 );
+
+    virtual ~PooledArraySampleAllocator();
+
+    virtual void * allocate( size_t iNumBytes );
+
+    virtual void deallocate( void * iMemory, size_t iNumBytes );
+
+    virtual bool getStats( ArraySampleAllocatorStats & oStats );
+
+    //! Frees everything held for reuse, samples still in use are untouched.
+    void releasePooled();
+
+    //! The number of bytes a request of iNumBytes is rounded up to.
+    size_t getBlockSize( size_t iNumBytes ) const;
+
+private:
+    struct Pool;
+
+    Pool & getThreadCache();
+
+    size_t m_maxBlockBytes;
+    size_t m_numClasses;
+
+    // shared by every thread
+    Pool * m_pool;
+
+    // a thread always goes through the same one of these, threads share
+    // them once there are more threads than caches
+    std::vector< Pool * > m_threadCaches;
+};
+
+//-*****************************************************************************
+typedef Alembic::Util::shared_ptr<ArraySampleAllocator>
+    ArraySampleAllocatorPtr;
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreAbstract
+} // End namespace Alembic
+
+#endif
@@ -49,6 +49,7 @@ namespace ALEMBIC_VERSION_NS {
 //! ...
 class TimeSampling;
 class ArraySample;
+class ArraySampleAllocator;
 
 //-*****************************************************************************
 //! Writer types forward declared.
@@ -69,12 +70,15 @@ class CompoundPropertyReader;
 class ArrayPropertyReader;
 class ScalarPropertyReader;
 class BasePropertyReader;
+class ReadContext;
 
 //-*****************************************************************************
 //! Smart Ptrs to Helper types.
 //! The Ptr suffix in Alembic _ALWAYS_ refers to a shared_ptr of whatever
 //! class name precedes the Ptr suffix.
 typedef Alembic::Util::shared_ptr<ArraySample> ArraySamplePtr;
+typedef Alembic::Util::shared_ptr<ArraySampleAllocator>
+    ArraySampleAllocatorPtr;
 
 //-*****************************************************************************
 //! Smart Ptrs to Writers.
@@ -93,6 +97,7 @@ typedef Alembic::Util::shared_ptr<CompoundPropertyReader> CompoundPropertyReader
 typedef Alembic::Util::shared_ptr<ArrayPropertyReader> ArrayPropertyReaderPtr;
 typedef Alembic::Util::shared_ptr<ScalarPropertyReader> ScalarPropertyReaderPtr;
 typedef Alembic::Util::shared_ptr<BasePropertyReader> BasePropertyReaderPtr;
+typedef Alembic::Util::shared_ptr<ReadContext> ReadContextPtr;
 
 } // End namespace ALEMBIC_VERSION_NS
 
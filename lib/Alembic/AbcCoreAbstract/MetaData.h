@@ -101,14 +101,14 @@ public:
     MetaData() {}
 
     //! Copy constructor copies another MetaData.
-    //! ...
-    MetaData( const MetaData &iCopy ) : m_tokenMap( iCopy.m_tokenMap ) {}
+    //! The contents are shared, not duplicated.
+    MetaData( const MetaData &iCopy ) : m_contents( iCopy.m_contents ) {}
 
     //! Assignment operator copies the contents of another
     //! MetaData instance.
     MetaData& operator=( const MetaData &iCopy )
     {
-        m_tokenMap = iCopy.m_tokenMap;
+        m_contents = iCopy.m_contents;
         return *this;
     }
 
@@ -122,8 +122,16 @@ public:
     //! \internal For library implementation internal use.
     void deserialize( const std::string &iFrom )
     {
-        m_tokenMap.clear();
-        m_tokenMap.setUnique( iFrom, ';', '=', true );
+        if ( iFrom.empty() )
+        {
+            m_contents.reset();
+            return;
+        }
+
+        ContentsPtr contents( new Contents() );
+        contents->tokenMap.setUnique( iFrom, ';', '=', true );
+        contents->cacheTokens();
+        m_contents = contents;
     }
 
     //! Serialization will convert the contents of this MetaData into a
@@ -131,13 +139,13 @@ public:
     //! \internal For library implementation internal use.
     std::string serialize() const
     {
-        return m_tokenMap.get( ';', '=', true );
+        return tokenMap().get( ';', '=', true );
     }
 
     //-*************************************************************************
     // SIZE
     //-*************************************************************************
-    size_t size() const { return m_tokenMap.size(); }
+    size_t size() const { return m_contents ? m_contents->tokenMap.size() : 0; }
     
     //-*************************************************************************
     // ITERATION
@@ -145,19 +153,19 @@ public:
 
     //! Returns a \ref const_iterator corresponding to the beginning of the
     //! MetaData or the end of the MetaData if empty.
-    const_iterator begin() const { return m_tokenMap.begin(); }
+    const_iterator begin() const { return tokenMap().begin(); }
 
     //! Returns a \ref const_iterator corresponding to the end of the
     //! MetaData.
-    const_iterator end() const { return m_tokenMap.end(); }
+    const_iterator end() const { return tokenMap().end(); }
 
     //! Returns a \ref const_reverse_iterator corresponding to the beginning
     //! of the MetaData or the end of the MetaData if empty.
-    const_reverse_iterator rbegin() const { return m_tokenMap.rbegin(); }
+    const_reverse_iterator rbegin() const { return tokenMap().rbegin(); }
 
     //! Returns an \ref const_reverse_iterator corresponding to the end
     //! of the MetaData.
-    const_reverse_iterator rend() const { return m_tokenMap.rend(); }
+    const_reverse_iterator rend() const { return tokenMap().rend(); }
 
     //-*************************************************************************
     // ACCESS/ASSIGNMENT
@@ -167,7 +175,9 @@ public:
     //! This will silently overwrite an existing value.
     void set( const std::string &iKey, const std::string &iData )
     {
-        m_tokenMap.setValue( iKey, iData );
+        Contents &contents = mutableContents();
+        contents.tokenMap.setValue( iKey, iData );
+        contents.cacheTokens();
     }
 
     //! setUnique lets you set a key/data pair,
@@ -176,10 +186,10 @@ public:
     //! \remarks Not the most efficient implementation at the moment.
     void setUnique( const std::string &iKey, const std::string &iData )
     {
-        std::string found = m_tokenMap.value( iKey );
+        std::string found = get( iKey );
         if ( found == "" )
         {
-            m_tokenMap.setValue( iKey, iData );
+            set( iKey, iData );
         }
         else if ( found != iData )
         {
@@ -191,14 +201,14 @@ public:
     //! ...
     std::string get( const std::string &iKey ) const
     {
-        return m_tokenMap.value( iKey );
+        return m_contents ? m_contents->tokenMap.value( iKey ) : std::string();
     }
 
     //! getRequired returns the value, and throws an exception if it is
     //! not found.
     std::string getRequired( const std::string &iKey ) const
     {
-        std::string ret = m_tokenMap.value( iKey );
+        std::string ret = get( iKey );
         if ( ret == "" )
         {
             ABCA_THROW( "Key: " << iKey << " did not exist in MetaData" );
@@ -273,11 +283,98 @@ public:
     //! It is for this reason that we explicitly do not overload the == operator.
     bool matchesExactly( const MetaData &iMetaData ) const
     {
-        return m_tokenMap.exactMatch( iMetaData.m_tokenMap );
+        if ( m_contents == iMetaData.m_contents )
+        {
+            return true;
+        }
+        return tokenMap().exactMatch( iMetaData.tokenMap() );
     }
-    
+
+    //-*************************************************************************
+    // WELL KNOWN TOKENS
+    // These are looked up once when the contents change, rather than on every
+    // schema or interpretation match, and are returned by reference.
+    //-*************************************************************************
+
+    //! Returns the value of "schema", or an empty string.
+    const std::string &getSchema() const
+    { return contents().schema; }
+
+    //! Returns the value of "schemaObjTitle", or an empty string.
+    const std::string &getSchemaObjTitle() const
+    { return contents().schemaObjTitle; }
+
+    //! Returns the value of "schemaBaseType", or an empty string.
+    const std::string &getSchemaBaseType() const
+    { return contents().schemaBaseType; }
+
+    //! Returns the value of "interpretation", or an empty string.
+    const std::string &getInterpretation() const
+    { return contents().interpretation; }
+
+    //! Returns true if iMetaData shares its contents with this instance.
+    //! This is the case for copies that haven't since been modified, such
+    //! as the headers which reference the same indexed meta data in an
+    //! Ogawa archive.
+    bool sharesContents( const MetaData &iMetaData ) const
+    {
+        return m_contents == iMetaData.m_contents;
+    }
+
 private:
-    Alembic::Util::TokenMap m_tokenMap;
+    struct Contents
+    {
+        Alembic::Util::TokenMap tokenMap;
+        std::string schema;
+        std::string schemaObjTitle;
+        std::string schemaBaseType;
+        std::string interpretation;
+
+        void cacheTokens()
+        {
+            schema = tokenMap.value( "schema" );
+            schemaObjTitle = tokenMap.value( "schemaObjTitle" );
+            schemaBaseType = tokenMap.value( "schemaBaseType" );
+            interpretation = tokenMap.value( "interpretation" );
+        }
+    };
+
+    typedef Alembic::Util::shared_ptr<Contents> ContentsPtr;
+
+    static const Contents &emptyContents()
+    {
+        static const Contents sEmpty;
+        return sEmpty;
+    }
+
+    const Contents &contents() const
+    {
+        return m_contents ? *m_contents : emptyContents();
+    }
+
+    const Alembic::Util::TokenMap &tokenMap() const
+    {
+        return contents().tokenMap;
+    }
+
+    //! Copy on write, we only clone the contents when they are shared.
+    Contents &mutableContents()
+    {
+        if ( !m_contents )
+        {
+            m_contents.reset( new Contents() );
+        }
+        else if ( m_contents.use_count() > 1 )
+        {
+            m_contents.reset( new Contents( *m_contents ) );
+        }
+        return *m_contents;
+    }
+
+    //! The contents are treated as immutable once they are shared, so copying
+    //! a MetaData (for instance into every object and property header that
+    //! references the same indexed meta data) is just a reference count.
+    ContentsPtr m_contents;
 };
 
 } // End namespace ALEMBIC_VERSION_NS
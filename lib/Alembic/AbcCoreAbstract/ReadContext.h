@@ -0,0 +1,80 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef _Alembic_AbcCoreAbstract_ReadContext_h_
+#define _Alembic_AbcCoreAbstract_ReadContext_h_
+
+#include <Alembic/AbcCoreAbstract/Foundation.h>
+#include <Alembic/AbcCoreAbstract/ForwardDeclarations.h>
+
+namespace Alembic {
+namespace AbcCoreAbstract {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! A ReadContext is created by ArchiveReader::createReadContext and handed
+//! back to the sample reading calls of that archive's properties.  It lets
+//! the implementation hold on to the per read state (which stream to read
+//! from, scratch memory) for as long as the context lives, instead of
+//! setting it up again for every sample.
+//!
+//! A context may hold on to one of the archive's streams from its first
+//! read until it is destroyed, so that reads through it cost no more than
+//! the read itself.  Streams held this way count against a limit on their
+//! number, so under a policy which waits for a free stream, such as
+//! AbcCoreOgawa's kWaitStreamPolicy, let go of contexts which are done
+//! with.  AbcCoreOgawa never lets contexts hold all of its streams, so the
+//! thread holding one may still read without it.
+//!
+//! A context may only be used by one thread at a time, the usual pattern is
+//! one per worker thread.  Passing it to a property of another archive is
+//! allowed, but the context is then ignored.
+class ReadContext : private Alembic::Util::noncopyable
+{
+public:
+    virtual ~ReadContext();
+
+protected:
+    ReadContext() {}
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreAbstract
+} // End namespace Alembic
+
+#endif
@@ -46,6 +46,14 @@ ScalarPropertyReader::~ScalarPropertyReader()
     // Nothing
 }
 
+//-*****************************************************************************
+void ScalarPropertyReader::getSample( index_t iSample,
+                                      void *iIntoLocation,
+                                      ReadContext * iContext )
+{
+    getSample( iSample, iIntoLocation );
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace AbcCoreAbstract
 } // End namespace Alembic
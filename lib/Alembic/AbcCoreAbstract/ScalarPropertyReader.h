@@ -39,6 +39,7 @@
 
 #include <Alembic/AbcCoreAbstract/Foundation.h>
 #include <Alembic/AbcCoreAbstract/BasePropertyReader.h>
+#include <Alembic/AbcCoreAbstract/ReadContext.h>
 
 namespace Alembic {
 namespace AbcCoreAbstract {
@@ -104,6 +105,13 @@ public:
     //! Find the valid index with the closest time to the given
     //! time. Invalid to call this with zero samples.
     virtual std::pair<index_t, chrono_t> getNearIndex( chrono_t iTime ) = 0;
+
+    //! The same as getSample above, but given a ReadContext created by the
+    //! archive of this property for the calling thread (or NULL).  By default
+    //! the context is ignored.
+    virtual void getSample( index_t iSample,
+                            void *iIntoLocation,
+                            ReadContext * iContext );
 };
 
 } // End namespace ALEMBIC_VERSION_NS
@@ -0,0 +1,157 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_AbcCoreAbstract_Tests_ArchiveCompare_h_
+#define _Alembic_AbcCoreAbstract_Tests_ArchiveCompare_h_
+
+#include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace ABCA = Alembic::AbcCoreAbstract;
+
+//-*****************************************************************************
+// Asserts that two hierarchies hold the same objects and properties, in the
+// same order, with the same samples, for tests of tools which copy or
+// rewrite archives.
+
+//-*****************************************************************************
+inline void checkSame( ABCA::CompoundPropertyReaderPtr iA,
+                ABCA::CompoundPropertyReaderPtr iB )
+{
+    TESTING_ASSERT( iA->getNumProperties() == iB->getNumProperties() );
+    for ( std::size_t i = 0; i < iA->getNumProperties(); ++i )
+    {
+        const ABCA::PropertyHeader & ha = iA->getPropertyHeader( i );
+        const ABCA::PropertyHeader & hb = iB->getPropertyHeader( i );
+        TESTING_ASSERT( ha.getName() == hb.getName() );
+        TESTING_ASSERT( ha.getPropertyType() == hb.getPropertyType() );
+
+        if ( ha.isCompound() )
+        {
+            checkSame( iA->getCompoundProperty( ha.getName() ),
+                       iB->getCompoundProperty( hb.getName() ) );
+            continue;
+        }
+
+        TESTING_ASSERT( ha.getDataType() == hb.getDataType() );
+        TESTING_ASSERT( *ha.getTimeSampling() == *hb.getTimeSampling() );
+
+        if ( ha.isScalar() )
+        {
+            ABCA::ScalarPropertyReaderPtr a =
+                iA->getScalarProperty( ha.getName() );
+            ABCA::ScalarPropertyReaderPtr b =
+                iB->getScalarProperty( hb.getName() );
+            TESTING_ASSERT( a->getNumSamples() == b->getNumSamples() );
+            const ABCA::DataType & dt = ha.getDataType();
+            for ( std::size_t j = 0; j < a->getNumSamples(); ++j )
+            {
+                if ( dt.getPod() == Alembic::Util::kStringPOD )
+                {
+                    std::vector< std::string > va( dt.getExtent() );
+                    std::vector< std::string > vb( dt.getExtent() );
+                    a->getSample( j, &va.front() );
+                    b->getSample( j, &vb.front() );
+                    TESTING_ASSERT( va == vb );
+                }
+                else if ( dt.getPod() == Alembic::Util::kWstringPOD )
+                {
+                    std::vector< std::wstring > va( dt.getExtent() );
+                    std::vector< std::wstring > vb( dt.getExtent() );
+                    a->getSample( j, &va.front() );
+                    b->getSample( j, &vb.front() );
+                    TESTING_ASSERT( va == vb );
+                }
+                else
+                {
+                    std::vector< char > va( dt.getNumBytes(), 0 );
+                    std::vector< char > vb( dt.getNumBytes(), 1 );
+                    a->getSample( j, &va.front() );
+                    b->getSample( j, &vb.front() );
+                    TESTING_ASSERT( va == vb );
+                }
+            }
+            continue;
+        }
+
+        ABCA::ArrayPropertyReaderPtr a = iA->getArrayProperty( ha.getName() );
+        ABCA::ArrayPropertyReaderPtr b = iB->getArrayProperty( hb.getName() );
+        TESTING_ASSERT( a->getNumSamples() == b->getNumSamples() );
+        TESTING_ASSERT( a->isConstant() == b->isConstant() );
+        for ( std::size_t j = 0; j < a->getNumSamples(); ++j )
+        {
+            ABCA::ArraySamplePtr sa, sb;
+            a->getSample( j, sa );
+            b->getSample( j, sb );
+            TESTING_ASSERT( sa->getDimensions() == sb->getDimensions() );
+            if ( ha.getDataType().getPod() == Alembic::Util::kStringPOD )
+            {
+                const std::string * stra =
+                    static_cast< const std::string * >( sa->getData() );
+                const std::string * strb =
+                    static_cast< const std::string * >( sb->getData() );
+                for ( std::size_t k = 0; k < sa->size(); ++k )
+                {
+                    TESTING_ASSERT( stra[k] == strb[k] );
+                }
+            }
+            else
+            {
+                TESTING_ASSERT( memcmp( sa->getData(), sb->getData(),
+                    sa->size() * ha.getDataType().getNumBytes() ) == 0 );
+            }
+        }
+    }
+}
+
+//-*****************************************************************************
+inline void checkSame( ABCA::ObjectReaderPtr iA, ABCA::ObjectReaderPtr iB )
+{
+    TESTING_ASSERT( iA->getName() == iB->getName() );
+    checkSame( iA->getProperties(), iB->getProperties() );
+
+    TESTING_ASSERT( iA->getNumChildren() == iB->getNumChildren() );
+    for ( std::size_t i = 0; i < iA->getNumChildren(); ++i )
+    {
+        checkSame( iA->getChild( i ), iB->getChild( i ) );
+    }
+}
+
+#endif
@@ -0,0 +1,211 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreAbstract/All.h>
+
+#include "Assert.h"
+
+#include <iostream>
+
+//-*****************************************************************************
+namespace AbcA = Alembic::AbcCoreAbstract;
+
+//-*****************************************************************************
+void testBlockSizes()
+{
+    AbcA::PooledArraySampleAllocator pool( 1024 * 1024, 4096, 1 );
+
+    TESTING_ASSERT( pool.getBlockSize( 1 ) == 16 );
+    TESTING_ASSERT( pool.getBlockSize( 16 ) == 16 );
+    TESTING_ASSERT( pool.getBlockSize( 17 ) == 32 );
+    TESTING_ASSERT( pool.getBlockSize( 64 ) == 64 );
+    TESTING_ASSERT( pool.getBlockSize( 65 ) == 80 );
+    TESTING_ASSERT( pool.getBlockSize( 128 ) == 128 );
+    TESTING_ASSERT( pool.getBlockSize( 129 ) == 160 );
+    TESTING_ASSERT( pool.getBlockSize( 1000 ) == 1024 );
+    TESTING_ASSERT( pool.getBlockSize( 4096 ) == 4096 );
+
+    // too big to pool
+    TESTING_ASSERT( pool.getBlockSize( 4097 ) == 4097 );
+
+    for ( size_t i = 1; i < 4096; ++i )
+    {
+        size_t block = pool.getBlockSize( i );
+        TESTING_ASSERT( block >= i );
+        TESTING_ASSERT( block <= pool.getBlockSize( i + 1 ) );
+    }
+}
+
+//-*****************************************************************************
+void testReuse()
+{
+    AbcA::PooledArraySampleAllocator pool( 1024 * 1024, 4096, 1 );
+
+    void * a = pool.allocate( 100 );
+    pool.deallocate( a, 100 );
+
+    // the same size class gets the same block back
+    void * b = pool.allocate( 110 );
+    TESTING_ASSERT( a == b );
+
+    void * big = pool.allocate( 10000 );
+    TESTING_ASSERT( big );
+
+    AbcA::ArraySampleAllocatorStats stats;
+    TESTING_ASSERT( pool.getStats( stats ) );
+    TESTING_ASSERT( stats.numAllocations == 3 );
+    TESTING_ASSERT( stats.numDeallocations == 1 );
+    TESTING_ASSERT( stats.numThreadCacheHits == 1 );
+    TESTING_ASSERT( stats.numHeapAllocations == 2 );
+    TESTING_ASSERT( stats.bytesInUse == 112 + 10000 );
+    TESTING_ASSERT( stats.bytesPooled == 0 );
+
+    pool.deallocate( b, 110 );
+    pool.deallocate( big, 10000 );
+
+    TESTING_ASSERT( pool.getStats( stats ) );
+    TESTING_ASSERT( stats.numDeallocations == 3 );
+    TESTING_ASSERT( stats.numHeapFrees == 1 );
+    TESTING_ASSERT( stats.bytesInUse == 0 );
+    TESTING_ASSERT( stats.bytesPooled == 112 );
+
+    pool.releasePooled();
+    TESTING_ASSERT( pool.getStats( stats ) );
+    TESTING_ASSERT( stats.bytesPooled == 0 );
+}
+
+//-*****************************************************************************
+void testLimit()
+{
+    // half of the 1024 bytes goes to the one thread cache
+    AbcA::PooledArraySampleAllocator pool( 1024, 1024, 1 );
+
+    std::vector< void * > blocks;
+    for ( size_t i = 0; i < 10; ++i )
+    {
+        blocks.push_back( pool.allocate( 256 ) );
+    }
+
+    for ( size_t i = 0; i < blocks.size(); ++i )
+    {
+        pool.deallocate( blocks[i], 256 );
+    }
+
+    AbcA::ArraySampleAllocatorStats stats;
+    TESTING_ASSERT( pool.getStats( stats ) );
+    TESTING_ASSERT( stats.bytesPooled == 1024 );
+    TESTING_ASSERT( stats.numHeapFrees == 6 );
+
+    // the cache is used up first, then the shared pool
+    for ( size_t i = 0; i < 4; ++i )
+    {
+        blocks[i] = pool.allocate( 256 );
+    }
+
+    TESTING_ASSERT( pool.getStats( stats ) );
+    TESTING_ASSERT( stats.numThreadCacheHits == 2 );
+    TESTING_ASSERT( stats.numPoolHits == 2 );
+    TESTING_ASSERT( stats.bytesPooled == 0 );
+
+    for ( size_t i = 0; i < 4; ++i )
+    {
+        pool.deallocate( blocks[i], 256 );
+    }
+}
+
+//-*****************************************************************************
+void testArraySamples()
+{
+    AbcA::ArraySamplePtr floats;
+    AbcA::ArraySamplePtr strings;
+    {
+        AbcA::ArraySampleAllocatorPtr pool(
+            new AbcA::PooledArraySampleAllocator() );
+
+        floats = AbcA::AllocateArraySample(
+            AbcA::DataType( Alembic::Util::kFloat32POD, 3 ),
+            Alembic::Util::Dimensions( 5 ), pool );
+        TESTING_ASSERT( floats->getData() );
+        TESTING_ASSERT( floats->size() == 5 );
+
+        float * data = static_cast< float * >(
+            const_cast< void * >( floats->getData() ) );
+        for ( size_t i = 0; i < 15; ++i )
+        {
+            data[i] = i;
+        }
+
+        // strings still come from new[]
+        strings = AbcA::AllocateArraySample(
+            AbcA::DataType( Alembic::Util::kStringPOD, 1 ),
+            Alembic::Util::Dimensions( 2 ), pool );
+        TESTING_ASSERT( strings->size() == 2 );
+
+        AbcA::ArraySampleAllocatorStats stats;
+        TESTING_ASSERT( pool->getStats( stats ) );
+        TESTING_ASSERT( stats.numAllocations == 1 );
+        TESTING_ASSERT( stats.bytesInUse == 64 );
+
+        // empty samples need nothing
+        AbcA::ArraySamplePtr empty = AbcA::AllocateArraySample(
+            AbcA::DataType( Alembic::Util::kInt32POD, 1 ),
+            Alembic::Util::Dimensions( 0 ), pool );
+        TESTING_ASSERT( empty->getData() == NULL );
+
+        // and an empty allocator is the same as not passing one
+        AbcA::ArraySamplePtr plain = AbcA::AllocateArraySample(
+            AbcA::DataType( Alembic::Util::kInt32POD, 1 ),
+            Alembic::Util::Dimensions( 4 ),
+            AbcA::ArraySampleAllocatorPtr() );
+        TESTING_ASSERT( plain->size() == 4 );
+    }
+
+    // the samples keep the pool alive
+    const float * data = static_cast< const float * >( floats->getData() );
+    TESTING_ASSERT( data[14] == 14.0f );
+    floats.reset();
+    strings.reset();
+}
+
+//-*****************************************************************************
+int main( int, char** )
+{
+    testBlockSizes();
+    testReuse();
+    testLimit();
+    testArraySamples();
+    return 0;
+}
@@ -0,0 +1,110 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <Alembic/AbcCoreAbstract/All.h>
+
+#include "Assert.h"
+
+#include <iostream>
+
+//-*****************************************************************************
+namespace AbcA = Alembic::AbcCoreAbstract;
+
+//-*****************************************************************************
+void testSharing()
+{
+    AbcA::MetaData md;
+    TESTING_ASSERT( md.size() == 0 );
+    TESTING_ASSERT( md.getSchema() == "" );
+    TESTING_ASSERT( md.begin() == md.end() );
+
+    md.deserialize( "schema=AbcGeom_PolyMesh_v1;schemaObjTitle="
+                    "AbcGeom_PolyMesh_v1:.geom;interpretation=point" );
+    TESTING_ASSERT( md.size() == 3 );
+    TESTING_ASSERT( md.getSchema() == "AbcGeom_PolyMesh_v1" );
+    TESTING_ASSERT( md.getSchemaObjTitle() == "AbcGeom_PolyMesh_v1:.geom" );
+    TESTING_ASSERT( md.getInterpretation() == "point" );
+    TESTING_ASSERT( md.getSchemaBaseType() == "" );
+
+    // copies share the same contents
+    AbcA::MetaData copied( md );
+    AbcA::ObjectHeader oh( "foo", md );
+    TESTING_ASSERT( copied.sharesContents( md ) );
+    TESTING_ASSERT( oh.getMetaData().sharesContents( md ) );
+    TESTING_ASSERT( oh.getMetaData().matchesExactly( md ) );
+
+    // until one of them is modified
+    copied.set( "schema", "AbcGeom_Points_v1" );
+    TESTING_ASSERT( !copied.sharesContents( md ) );
+    TESTING_ASSERT( copied.getSchema() == "AbcGeom_Points_v1" );
+    TESTING_ASSERT( md.getSchema() == "AbcGeom_PolyMesh_v1" );
+    TESTING_ASSERT( md.get( "schema" ) == "AbcGeom_PolyMesh_v1" );
+    TESTING_ASSERT( oh.getMetaData().getSchema() == "AbcGeom_PolyMesh_v1" );
+    TESTING_ASSERT( !copied.matchesExactly( md ) );
+    TESTING_ASSERT( copied.matchesOverlap( oh.getMetaData() ) == false );
+
+    // modifying the header doesn't touch the original either
+    oh.getMetaData().set( "schemaBaseType", "AbcGeom_GeomBase_v1" );
+    TESTING_ASSERT( oh.getMetaData().getSchemaBaseType() ==
+                    "AbcGeom_GeomBase_v1" );
+    TESTING_ASSERT( md.getSchemaBaseType() == "" );
+    TESTING_ASSERT( oh.getMetaData().matches( md ) );
+    TESTING_ASSERT( !md.matches( oh.getMetaData() ) );
+
+    // serialization round trips
+    AbcA::MetaData md2;
+    md2.deserialize( md.serialize() );
+    TESTING_ASSERT( md2.matchesExactly( md ) );
+    TESTING_ASSERT( !md2.sharesContents( md ) );
+
+    md2.deserialize( "" );
+    TESTING_ASSERT( md2.size() == 0 );
+    TESTING_ASSERT( md2.getInterpretation() == "" );
+
+    TESTING_ASSERT_THROW( md.setUnique( "schema", "nope" ),
+                          Alembic::Util::Exception );
+
+    // setting the same value again leaves the contents shared
+    AbcA::MetaData again( md );
+    md.setUnique( "schema", "AbcGeom_PolyMesh_v1" );
+    TESTING_ASSERT( again.sharesContents( md ) );
+}
+
+//-*****************************************************************************
+int main( int, char** )
+{
+    testSharing();
+    return 0;
+}
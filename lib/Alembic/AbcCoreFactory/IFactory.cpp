@@ -38,6 +38,9 @@
 #include <Alembic/AbcCoreOgawa/All.h>
 #include <Alembic/AbcCoreFactory/IFactory.h>
 
+#include <cstring>
+#include <fstream>
+
 namespace Alembic {
 namespace AbcCoreFactory {
 namespace ALEMBIC_VERSION_NS {
@@ -46,6 +49,8 @@ IFactory::IFactory()
 {
     m_cacheHierarchy = true;
     m_numStreams = 1;
+    m_maxStreams = 0;
+    m_streamPolicy = Alembic::AbcCoreOgawa::kFallbackStreamPolicy;
     m_policy = Alembic::Abc::ErrorHandler::kThrowPolicy;
 }
 
@@ -56,33 +61,82 @@ IFactory::~IFactory()
 Alembic::Abc::IArchive IFactory::getArchive( const std::string & iFileName,
                                             CoreType & oType )
 {
+    return getArchive( iFileName, getCoreType( iFileName ), oType );
+}
 
-    // try Ogawa first, use kQuietNoop at first in case we fail
-    Alembic::AbcCoreOgawa::ReadArchive ogawa( m_numStreams );
-    Alembic::Abc::IArchive archive( ogawa, iFileName,
-        Alembic::Abc::ErrorHandler::kQuietNoopPolicy, m_cachePtr );
+Alembic::Abc::IArchive IFactory::getArchive( const std::string & iFileName,
+                                            CoreType iType, CoreType & oType )
+{
+    Alembic::Abc::IArchive archive;
 
-    if ( archive.valid() )
+    // try Ogawa first, use kQuietNoop at first in case we fail
+    if ( iType != kHDF5 )
     {
-        oType = kOgawa;
-        archive.getErrorHandler().setPolicy( m_policy );
-        return archive;
+        Alembic::AbcCoreOgawa::ReadArchive ogawa( m_numStreams, m_maxStreams,
+                                                  m_streamPolicy );
+        archive = Alembic::Abc::IArchive( ogawa, iFileName,
+            Alembic::Abc::ErrorHandler::kQuietNoopPolicy, m_cachePtr );
+
+        if ( archive.valid() )
+        {
+            oType = kOgawa;
+            archive.getErrorHandler().setPolicy( m_policy );
+            archive.setArraySampleAllocator( m_allocator );
+            return archive;
+        }
     }
 
-    Alembic::AbcCoreHDF5::ReadArchive hdf( m_cacheHierarchy );
-    archive = Alembic::Abc::IArchive( hdf, iFileName,
-        Alembic::Abc::ErrorHandler::kQuietNoopPolicy, m_cachePtr );
-    if ( archive.valid() )
+    if ( iType != kOgawa )
     {
-        oType = kHDF5;
-        archive.getErrorHandler().setPolicy( m_policy );
-        return archive;
+        Alembic::AbcCoreHDF5::ReadArchive hdf( m_cacheHierarchy );
+        archive = Alembic::Abc::IArchive( hdf, iFileName,
+            Alembic::Abc::ErrorHandler::kQuietNoopPolicy, m_cachePtr );
+        if ( archive.valid() )
+        {
+            oType = kHDF5;
+            archive.getErrorHandler().setPolicy( m_policy );
+            archive.setArraySampleAllocator( m_allocator );
+            return archive;
+        }
     }
 
     oType = kUnknown;
     return Alembic::Abc::IArchive();
 }
 
+IFactory::CoreType IFactory::getCoreType( const std::string & iFileName )
+{
+    std::ifstream file( iFileName.c_str(), std::ios::in | std::ios::binary );
+
+    char magic[8];
+    if ( !file.read( magic, 8 ) )
+    {
+        return kUnknown;
+    }
+
+    if ( std::memcmp( magic, "Ogawa", 5 ) == 0 )
+    {
+        return kOgawa;
+    }
+
+    // HDF5 puts its signature at 0, or after a user block of 512, 1024,
+    // 2048 and so on bytes
+    static const char hdf5[8] = { '\211', 'H', 'D', 'F', '\r', '\n',
+                                  '\032', '\n' };
+    for ( std::streamoff offset = 512; ; offset *= 2 )
+    {
+        if ( std::memcmp( magic, hdf5, 8 ) == 0 )
+        {
+            return kHDF5;
+        }
+
+        if ( !file.seekg( offset ) || !file.read( magic, 8 ) )
+        {
+            return kUnknown;
+        }
+    }
+}
+
 Alembic::Abc::IArchive IFactory::getArchive( const std::string & iFileName )
 {
     CoreType coreType;
@@ -98,6 +152,7 @@ Alembic::Abc::IArchive IFactory::getArchive(
     if ( archive.valid() )
     {
         oType = kOgawa;
+        archive.setArraySampleAllocator( m_allocator );
         return archive;
     }
 
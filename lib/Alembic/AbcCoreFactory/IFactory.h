@@ -38,6 +38,7 @@
 #define _Alembic_AbcCoreFactory_IFactory_h_
 
 #include <Alembic/AbcCoreAbstract/ReadArraySampleCache.h>
+#include <Alembic/AbcCoreOgawa/ReadWrite.h>
 #include <Alembic/Abc/IArchive.h>
 
 namespace Alembic {
@@ -63,6 +64,15 @@ public:
     Alembic::Abc::IArchive getArchive( const std::string & iFileName,
                                        CoreType & oType );
 
+    //! Open a file as iType only, so it isn't opened as another type first.
+    //! With kUnknown each type is tried in turn.  oType is set as above.
+    Alembic::Abc::IArchive getArchive( const std::string & iFileName,
+                                       CoreType iType, CoreType & oType );
+
+    //! Tells the type of a file from its first bytes, without opening it as
+    //! an archive.  kUnknown if the file can't be read or isn't either.
+    static CoreType getCoreType( const std::string & iFileName );
+
     //! Try to open a file and return IArchive.  If the file wasn't a valid
     //! file or known type and invalid archive is returned.
     Alembic::Abc::IArchive getArchive( const std::string & iFileName );
@@ -96,6 +106,23 @@ public:
         return m_cachePtr;
     }
 
+    //! Set what the data of array samples read from the archives this
+    //! factory opens comes from, archives may share one.  The default of an
+    //! empty pointer uses new and delete, see
+    //! Alembic::AbcCoreAbstract::PooledArraySampleAllocator for a pool.
+    void setArraySampleAllocator(
+        Alembic::AbcCoreAbstract::ArraySampleAllocatorPtr iAllocator )
+    {
+        m_allocator = iAllocator;
+    }
+
+    //! Get the array sample allocator
+    Alembic::AbcCoreAbstract::ArraySampleAllocatorPtr
+    getArraySampleAllocator() const
+    {
+        return m_allocator;
+    }
+
     //! Gets the number of streams that will be opened when opening an Ogawa
     //! file
     size_t getOgawaNumStreams() const { return m_numStreams; }
@@ -107,6 +134,31 @@ public:
         m_numStreams = iNumStreams;
     }
 
+    //! Gets the most streams an Ogawa file will be opened with
+    size_t getOgawaMaxStreams() const { return m_maxStreams; }
+
+    //! Sets the most streams an Ogawa file will be opened with.  Past the
+    //! initial number of streams, more are opened as readers contend for
+    //! them.  The default of 0 means it is never opened more than the number
+    //! set via setOgawaNumStreams.
+    void setOgawaMaxStreams( size_t iMaxStreams )
+    {
+        m_maxStreams = iMaxStreams;
+    }
+
+    //! Gets what Ogawa readers do when all the streams are in use
+    Alembic::AbcCoreOgawa::StreamPolicy getOgawaStreamPolicy() const
+    {
+        return m_streamPolicy;
+    }
+
+    //! Sets what Ogawa readers do when all the streams are in use, and no
+    //! more can be opened, the default is kFallbackStreamPolicy
+    void setOgawaStreamPolicy( Alembic::AbcCoreOgawa::StreamPolicy iPolicy )
+    {
+        m_streamPolicy = iPolicy;
+    }
+
     //! Gets the error handler policy
     Alembic::Abc::ErrorHandler::Policy getPolicy() { return m_policy; }
 
@@ -119,7 +171,10 @@ public:
 private:
     bool m_cacheHierarchy;
     size_t m_numStreams;
+    size_t m_maxStreams;
+    Alembic::AbcCoreOgawa::StreamPolicy m_streamPolicy;
     Alembic::AbcCoreAbstract::ReadArraySampleCachePtr m_cachePtr;
+    Alembic::AbcCoreAbstract::ArraySampleAllocatorPtr m_allocator;
     Alembic::Abc::ErrorHandler::Policy m_policy;
 
 };
@@ -91,6 +91,8 @@ void AprImpl::getDimensions( index_t iSampleIndex, Dimensions & oDim )
         parent = m_samplesIGroup;
     }
 
+    HDF5Lock lock;
+
     std::string dimName = sampleName + ".dims";
     if ( AttrExists( parent, dimName.c_str() ) )
     {
@@ -114,6 +116,23 @@ void AprImpl::getAs( index_t iSampleIndex, void *iIntoLocation,
         curPod != kFloat16POD) || ( iPod == curPod ),
         "Cannot convert the data to or from a string, wstring or float16_t." );
 
+    iSampleIndex = verifySampleIndex( iSampleIndex );
+
+    std::string sampleName = getSampleName( m_header->getName(), iSampleIndex );
+    H5Node parent;
+
+    if ( iSampleIndex == 0 )
+    {
+        parent = m_parentGroup;
+    }
+    else
+    {
+        checkSamplesIGroup();
+        parent = m_samplesIGroup;
+    }
+
+    HDF5Lock lock;
+
     hid_t nativeType = -1;
     bool clean = false;
 
@@ -123,6 +142,35 @@ void AprImpl::getAs( index_t iSampleIndex, void *iIntoLocation,
         nativeType = GetNativeH5T(dtype, clean);
     }
 
+    ReadArray( iIntoLocation, parent.getObject(),sampleName,
+               m_header->getDataType(), nativeType );
+
+    if ( clean )
+    {
+        H5Tclose( nativeType );
+    }
+}
+
+//-*****************************************************************************
+void AprImpl::getRangeAs( index_t iSampleIndex, size_t iStart, size_t iCount,
+                          void *iIntoLocation, PlainOldDataType iPod,
+                          AbcA::ReadContext * iContext )
+{
+    PlainOldDataType curPod = m_header->getDataType().getPod();
+
+    // strings are stored in a single blob, so let the base class read it all
+    if ( curPod == kStringPOD || curPod == kWstringPOD )
+    {
+        AbcA::ArrayPropertyReader::getRangeAs( iSampleIndex, iStart, iCount,
+                                               iIntoLocation, iPod,
+                                               iContext );
+        return;
+    }
+
+    ABCA_ASSERT( ( iPod != kStringPOD && iPod != kWstringPOD &&
+        iPod != kFloat16POD && curPod != kFloat16POD ) || ( iPod == curPod ),
+        "Cannot convert the data to or from a string, wstring or float16_t." );
+
     iSampleIndex = verifySampleIndex( iSampleIndex );
 
     std::string sampleName = getSampleName( m_header->getName(), iSampleIndex );
@@ -138,8 +186,25 @@ void AprImpl::getAs( index_t iSampleIndex, void *iIntoLocation,
         parent = m_samplesIGroup;
     }
 
-    ReadArray( iIntoLocation, parent.getObject(),sampleName,
-               m_header->getDataType(), nativeType );
+    HDF5Lock lock;
+
+    bool clean = false;
+    AbcA::DataType dtype( iPod );
+    hid_t nativeType = GetNativeH5T( dtype, clean );
+
+    try
+    {
+        ReadArrayRange( iIntoLocation, parent.getObject(), sampleName,
+                        m_header->getDataType(), nativeType, iStart, iCount );
+    }
+    catch ( ... )
+    {
+        if ( clean )
+        {
+            H5Tclose( nativeType );
+        }
+        throw;
+    }
 
     if ( clean )
     {
@@ -160,11 +225,13 @@ void AprImpl::readSample( hid_t iGroup,
 
     // Read the array sample, possibly from the cache.
     const AbcA::DataType &dataType = m_header->getDataType();
+    AbcA::ArchiveReaderPtr archive = this->getObject()->getArchive();
     AbcA::ReadArraySampleCachePtr cachePtr =
-        this->getObject()->getArchive()->getReadArraySampleCachePtr();
+        archive->getReadArraySampleCachePtr();
     oSamplePtr = ReadArray( cachePtr, iGroup, iSampleName, dataType,
                             m_fileDataType,
-                            m_nativeDataType );
+                            m_nativeDataType,
+                            archive->getArraySampleAllocator() );
 }
 
 //-*****************************************************************************
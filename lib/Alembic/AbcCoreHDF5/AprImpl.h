@@ -62,6 +62,9 @@ public:
     virtual void getDimensions( index_t iSampleIndex, Dimensions & oDim );
     virtual void getAs( index_t iSample, void *iIntoLocation,
                         PlainOldDataType iPod );
+    virtual void getRangeAs( index_t iSample, size_t iStart, size_t iCount,
+                             void *iIntoLocation, PlainOldDataType iPod,
+                             AbcA::ReadContext * iContext );
 protected:
     friend class SimplePrImpl<AbcA::ArrayPropertyReader, AprImpl,
                               AbcA::ArraySamplePtr&>;
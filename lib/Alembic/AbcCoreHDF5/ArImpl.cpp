@@ -39,7 +39,6 @@
 #include <Alembic/AbcCoreHDF5/OrImpl.h>
 #include <Alembic/AbcCoreHDF5/ReadUtil.h>
 #include <Alembic/AbcCoreHDF5/HDF5Util.h>
-#include <Alembic/AbcCoreHDF5/HDF5Util.h>
 #include <Alembic/AbcCoreHDF5/HDF5HierarchyReader.h>
 
 namespace Alembic {
@@ -54,6 +53,8 @@ ArImpl::ArImpl( const std::string &iFileName,
   , m_file( -1 )
   , m_readArraySampleCache( iCache )
 {
+    HDF5Lock lock;
+
     // OPEN THE FILE!
     htri_t exi = H5Fis_hdf5( m_fileName.c_str() );
     ABCA_ASSERT( exi == 1, "Nonexistent or not an Alembic file: "
@@ -186,6 +187,7 @@ AbcA::index_t ArImpl::getMaxNumSamplesForTimeSamplingIndex( uint32_t iIndex )
 //-*****************************************************************************
 ArImpl::~ArImpl()
 {
+    HDF5Lock lock;
 
     m_data.reset();
 
@@ -87,6 +87,18 @@ public:
         m_readArraySampleCache = iPtr;
     }
 
+    //! THIS METHOD IS NOT MULTITHREAD SAFE
+    virtual void
+    setArraySampleAllocator( AbcA::ArraySampleAllocatorPtr iAllocator )
+    {
+        m_allocator = iAllocator;
+    }
+
+    virtual AbcA::ArraySampleAllocatorPtr getArraySampleAllocator()
+    {
+        return m_allocator;
+    }
+
     virtual AbcA::index_t getMaxNumSamplesForTimeSamplingIndex(
         uint32_t iIndex );
 
@@ -100,6 +112,8 @@ public:
         return m_archiveVersion;
     }
 
+    virtual bool isReentrant() const { return false; }
+
 private:
     std::string m_fileName;
     hid_t m_file;
@@ -116,6 +130,8 @@ private:
 
     AbcA::ReadArraySampleCachePtr m_readArraySampleCache;
 
+    AbcA::ArraySampleAllocatorPtr m_allocator;
+
     HDF5Hierarchy m_H5H;
 };
 
@@ -93,6 +93,8 @@ public:
     virtual void setMaxNumSamplesForTimeSamplingIndex( uint32_t iIndex,
                                                       AbcA::index_t iMaxIndex );
 
+    virtual bool isReentrant() const { return false; }
+
 private:
     std::string m_fileName;
     AbcA::MetaData m_metaData;
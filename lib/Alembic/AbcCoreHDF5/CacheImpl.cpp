@@ -55,6 +55,15 @@ CacheImpl::~CacheImpl()
 //-*****************************************************************************
 AbcA::ReadArraySampleID
 CacheImpl::find( const AbcA::ArraySample::Key &iKey )
+{
+    Alembic::Util::scoped_lock l( m_mutex );
+
+    return lookup( iKey );
+}
+
+//-*****************************************************************************
+AbcA::ReadArraySampleID
+CacheImpl::lookup( const AbcA::ArraySample::Key &iKey )
 {
     // Check the locked map! If we have already locked it, just return
     // it locked!
@@ -63,7 +72,13 @@ CacheImpl::find( const AbcA::ArraySample::Key &iKey )
     {
         AbcA::ArraySamplePtr deleterPtr =
             (*foundIter).second.weakDeleter.lock();
-        assert( deleterPtr );
+
+        // Another thread may have let go of its last user and be waiting
+        // to unlock it, so lock it again with a new deleter.
+        if ( !deleterPtr )
+        {
+            deleterPtr = lock( iKey, (*foundIter).second.given );
+        }
 
         return AbcA::ReadArraySampleID( iKey, deleterPtr );
     }
@@ -97,8 +112,10 @@ CacheImpl::store( const AbcA::ArraySample::Key &iKey,
 {
     ABCA_ASSERT( iSamp, "Cannot store a null sample" );
 
+    Alembic::Util::scoped_lock l( m_mutex );
+
     // Check to see if we already have it.
-    AbcA::ReadArraySampleID foundID = find( iKey );
+    AbcA::ReadArraySampleID foundID = lookup( iKey );
     if ( foundID )
     {
         return foundID;
@@ -136,8 +153,12 @@ CacheImpl::lock( const AbcA::ArraySample::Key &iKey,
 //-*****************************************************************************
 void CacheImpl::unlock( const AbcA::ArraySample::Key &iKey )
 {
+    Alembic::Util::scoped_lock l( m_mutex );
+
+    // it may have been locked again since its last user let go of it
     Map::iterator foundIter = m_lockedMap.find( iKey );
-    if ( foundIter != m_lockedMap.end() )
+    if ( foundIter != m_lockedMap.end() &&
+         (*foundIter).second.weakDeleter.expired() )
     {
         AbcA::ArraySamplePtr givenPtr = (*foundIter).second.given;
         assert( givenPtr );
@@ -110,6 +110,7 @@ public:
 
 private:
     friend class RecordDeleter;
+    AbcA::ReadArraySampleID lookup( const AbcA::ArraySample::Key &iKey );
     AbcA::ArraySamplePtr lock( const AbcA::ArraySample::Key &iKey,
                                AbcA::ArraySamplePtr iSamp );
     void unlock( const AbcA::ArraySample::Key &iKey );
@@ -146,6 +147,9 @@ private:
 
     Map m_lockedMap;
     UnlockedMap m_unlockedMap;
+
+    // samples are found, stored and let go of from many threads
+    Alembic::Util::mutex m_mutex;
 };
 
 //-*****************************************************************************
@@ -107,6 +107,8 @@ CprData::CprData( H5Node & iParentGroup, int32_t iArchiveVersion,
                   const std::string &iName )
   : m_subPropertyMutexes( NULL )
 {
+    HDF5Lock lock;
+
     ABCA_ASSERT( iParentGroup.isValidObject(), "invalid parent group" );
 
     // If our group exists, open it. If it does not, this is not a problem!
@@ -182,6 +184,8 @@ CprData::CprData( H5Node & iParentGroup, int32_t iArchiveVersion,
 CprData::~CprData()
 {
     delete[] m_subPropertyMutexes;
+
+    HDF5Lock lock;
     CloseObject( m_group );
 }
 
@@ -210,11 +214,14 @@ CprData::getPropertyHeader( AbcA::CompoundPropertyReaderPtr iParent, size_t i )
         uint32_t tsid = 0;
 
         PropertyHeaderPtr iPtr( new AbcA::PropertyHeader() );
-        ReadPropertyHeader( m_group, m_propertyHeaders[i].name, *iPtr,
-                            m_propertyHeaders[i].isScalarLike,
-                            m_propertyHeaders[i].numSamples,
-                            m_propertyHeaders[i].firstChangedIndex,
-                            m_propertyHeaders[i].lastChangedIndex, tsid );
+        {
+            HDF5Lock lock;
+            ReadPropertyHeader( m_group, m_propertyHeaders[i].name, *iPtr,
+                                m_propertyHeaders[i].isScalarLike,
+                                m_propertyHeaders[i].numSamples,
+                                m_propertyHeaders[i].firstChangedIndex,
+                                m_propertyHeaders[i].lastChangedIndex, tsid );
+        }
 
         if ( iPtr->isSimple() )
         {
@@ -40,6 +40,90 @@ namespace Alembic {
 namespace AbcCoreHDF5 {
 namespace ALEMBIC_VERSION_NS {
 
+//-*****************************************************************************
+//-*****************************************************************************
+// HDF5 LOCK
+//-*****************************************************************************
+//-*****************************************************************************
+namespace {
+
+#ifdef _MSC_VER
+
+// critical sections can already be entered again by their owner
+class RecursiveMutex
+{
+public:
+    RecursiveMutex() { InitializeCriticalSection( &m_section ); }
+    ~RecursiveMutex() { DeleteCriticalSection( &m_section ); }
+
+    void lock() { EnterCriticalSection( &m_section ); }
+    void unlock() { LeaveCriticalSection( &m_section ); }
+
+private:
+    CRITICAL_SECTION m_section;
+};
+
+#else
+
+class RecursiveMutex
+{
+public:
+    RecursiveMutex()
+    {
+        pthread_mutexattr_t attr;
+        pthread_mutexattr_init( &attr );
+        pthread_mutexattr_settype( &attr, PTHREAD_MUTEX_RECURSIVE );
+        pthread_mutex_init( &m_mutex, &attr );
+        pthread_mutexattr_destroy( &attr );
+    }
+
+    ~RecursiveMutex() { pthread_mutex_destroy( &m_mutex ); }
+
+    void lock() { pthread_mutex_lock( &m_mutex ); }
+    void unlock() { pthread_mutex_unlock( &m_mutex ); }
+
+private:
+    pthread_mutex_t m_mutex;
+};
+
+#endif
+
+// never destroyed, archives closed by static destructors still need it
+RecursiveMutex & GetHDF5Mutex()
+{
+    static RecursiveMutex * mutex = new RecursiveMutex();
+    return *mutex;
+}
+
+// made before main, so before any thread could race to make it
+RecursiveMutex & g_hdf5Mutex = GetHDF5Mutex();
+
+} // End namespace
+
+//-*****************************************************************************
+HDF5Lock::HDF5Lock()
+{
+    GetHDF5Mutex().lock();
+}
+
+//-*****************************************************************************
+HDF5Lock::~HDF5Lock()
+{
+    GetHDF5Mutex().unlock();
+}
+
+//-*****************************************************************************
+HDF5Unlock::HDF5Unlock()
+{
+    GetHDF5Mutex().unlock();
+}
+
+//-*****************************************************************************
+HDF5Unlock::~HDF5Unlock()
+{
+    GetHDF5Mutex().lock();
+}
+
 //-*****************************************************************************
 //-*****************************************************************************
 // CREATION ORDER FOR GROUPS
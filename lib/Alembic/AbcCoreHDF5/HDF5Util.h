@@ -47,6 +47,29 @@ namespace ALEMBIC_VERSION_NS {
 //-*****************************************************************************
 typedef ::Alembic::Util::BaseDimensions<hsize_t> HDimensions;
 
+//-*****************************************************************************
+//! HDF5 isn't reentrant, so every call made into it while reading holds
+//! this process wide lock, which lets archives be read from many threads.
+//! Work which doesn't need HDF5, like splitting strings apart or looking
+//! through the cache, is done without it.  The thread holding it may take
+//! it again.
+class HDF5Lock : private Alembic::Util::noncopyable
+{
+public:
+    HDF5Lock();
+    ~HDF5Lock();
+};
+
+//-*****************************************************************************
+//! Lets go of an HDF5Lock held around it, for the length of some work which
+//! doesn't call into HDF5.
+class HDF5Unlock : private Alembic::Util::noncopyable
+{
+public:
+    HDF5Unlock();
+    ~HDF5Unlock();
+};
+
 //-*****************************************************************************
 struct AttrCloser
 {
@@ -71,6 +71,8 @@ OrData::OrData( ObjectHeaderPtr iHeader,
                 int32_t iArchiveVersion )
     : m_children( NULL )
 {
+    HDF5Lock lock;
+
     ABCA_ASSERT( iHeader, "Invalid header" );
     ABCA_ASSERT( iParentGroup.isValidObject(), "Invalid group" );
 
@@ -124,6 +126,8 @@ OrData::OrData( ObjectHeaderPtr iHeader,
 //-*****************************************************************************
 OrData::~OrData()
 {
+    HDF5Lock lock;
+
     CloseObject( m_oldGroup );
     if ( m_children )
     {
@@ -165,9 +169,10 @@ OrData::getChildHeader( AbcA::ObjectReaderPtr iParent, size_t i )
     Alembic::Util::scoped_lock l( m_childObjectsMutex );
     if ( ! m_children[i].loadedMetaData )
     {
+        HDF5Lock lock;
+
         H5Node group = OpenGroup( m_group,
             m_children[i].header->getName().c_str() );
-;
         ABCA_ASSERT( group.isValidObject(),
         "Could not open object group: "
         << m_children[i].header->getFullName() );
@@ -176,6 +181,8 @@ OrData::getChildHeader( AbcA::ObjectReaderPtr iParent, size_t i )
             m_children[i].header->getMetaData() );
 
         CloseObject( group );
+
+        m_children[i].loadedMetaData = true;
     }
 
     return *( m_children[i].header );
@@ -551,7 +551,8 @@ ReadArray( AbcA::ReadArraySampleCachePtr iCache,
            const std::string &iName,
            const AbcA::DataType &iDataType,
            hid_t iFileType,
-           hid_t iNativeType )
+           hid_t iNativeType,
+           const AbcA::ArraySampleAllocatorPtr &iAllocator )
 {
     // Dispatch string stuff.
     if ( iDataType.getPod() == kStringPOD )
@@ -565,6 +566,8 @@ ReadArray( AbcA::ReadArraySampleCachePtr iCache,
     assert( iDataType.getPod() != kStringPOD &&
             iDataType.getPod() != kWstringPOD );
 
+    HDF5Lock lock;
+
     // Open the data set.
     hid_t dsetId = H5Dopen( iParent, iName.c_str(), H5P_DEFAULT );
     ABCA_ASSERT( dsetId >= 0, "Cannot open dataset: " << iName );
@@ -590,7 +593,11 @@ ReadArray( AbcA::ReadArraySampleCachePtr iCache,
 
         foundDigest = ReadKey( dsetId, "key", key );
 
-        AbcA::ReadArraySampleID found = iCache->find( key );
+        AbcA::ReadArraySampleID found;
+        {
+            HDF5Unlock unlock;
+            found = iCache->find( key );
+        }
 
         if ( found )
         {
@@ -651,7 +658,7 @@ ReadArray( AbcA::ReadArraySampleCachePtr iCache,
                      "Degenerate dims in Dataset read" );
 
         // Create a buffer into which we shall read.
-        ret = AbcA::AllocateArraySample( iDataType, dims );
+        ret = AbcA::AllocateArraySample( iDataType, dims, iAllocator );
         assert( ret->getData() );
 
         // And... read into it.
@@ -690,6 +697,7 @@ ReadArray( AbcA::ReadArraySampleCachePtr iCache,
     // Store if there is a cache.
     if ( foundDigest && iCache )
     {
+        HDF5Unlock unlock;
         AbcA::ReadArraySampleID stored = iCache->store( key, ret );
         if ( stored )
         {
@@ -768,6 +776,68 @@ ReadArray( void * iIntoLocation,
     }
 }
 
+//-*****************************************************************************
+void
+ReadArrayRange( void * iIntoLocation,
+                hid_t iParent,
+                const std::string &iName,
+                const AbcA::DataType &iDataType,
+                hid_t iType,
+                size_t iStart,
+                size_t iCount )
+{
+    ABCA_ASSERT( iDataType.getPod() != kStringPOD &&
+                 iDataType.getPod() != kWstringPOD,
+                 "Cannot read a range of a string or wstring data set." );
+
+    if ( iCount == 0 )
+    {
+        return;
+    }
+
+    // Open the data set.
+    hid_t dsetId = H5Dopen( iParent, iName.c_str(), H5P_DEFAULT );
+    ABCA_ASSERT( dsetId >= 0, "Cannot open dataset: " << iName );
+    DsetCloser dsetCloser( dsetId );
+
+    // Read the data space.
+    hid_t dspaceId = H5Dget_space( dsetId );
+    ABCA_ASSERT( dspaceId >= 0, "Could not get dataspace for dataSet: "
+                 << iName );
+    DspaceCloser dspaceCloser( dspaceId );
+
+    H5S_class_t dspaceClass = H5Sget_simple_extent_type( dspaceId );
+    ABCA_ASSERT( dspaceClass == H5S_SIMPLE,
+                 "Range is outside of the sample: " << iName );
+
+    int rank = H5Sget_simple_extent_ndims( dspaceId );
+    ABCA_ASSERT( rank == 1, "H5Sget_simple_extent_ndims() must be 1." );
+
+    hsize_t hdim = 0;
+    rank = H5Sget_simple_extent_dims( dspaceId, &hdim, NULL );
+
+    // the data set is stored as PODs, so scale the range by the extent
+    hsize_t extent = iDataType.getExtent();
+    hsize_t start = iStart * extent;
+    hsize_t count = iCount * extent;
+
+    ABCA_ASSERT( start <= hdim && count <= hdim - start,
+                 "Range is outside of the sample: " << iName );
+
+    herr_t status = H5Sselect_hyperslab( dspaceId, H5S_SELECT_SET, &start,
+                                         NULL, &count, NULL );
+    ABCA_ASSERT( status >= 0, "H5Sselect_hyperslab() failed." );
+
+    hid_t memSpaceId = H5Screate_simple( 1, &count, NULL );
+    ABCA_ASSERT( memSpaceId >= 0, "Could not create memory dataspace." );
+    DspaceCloser memSpaceCloser( memSpaceId );
+
+    status = H5Dread( dsetId, iType, memSpaceId, dspaceId, H5P_DEFAULT,
+                      iIntoLocation );
+
+    ABCA_ASSERT( status >= 0, "H5Dread() failed." );
+}
+
 //-*****************************************************************************
 void
 ReadTimeSamples( hid_t iParent,
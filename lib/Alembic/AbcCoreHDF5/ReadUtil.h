@@ -117,7 +117,9 @@ ReadArray( AbcA::ReadArraySampleCachePtr iCache,
            const std::string &iArrayName,
            const AbcA::DataType &iDataType,
            hid_t iFileType,
-           hid_t iNativeType );
+           hid_t iNativeType,
+           const AbcA::ArraySampleAllocatorPtr &iAllocator =
+               AbcA::ArraySampleAllocatorPtr() );
 
 //-*****************************************************************************
 void
@@ -127,6 +129,18 @@ ReadArray( void * iIntoLocation,
            const AbcA::DataType &iDataType,
            hid_t iType );
 
+//-*****************************************************************************
+// Reads iCount elements starting at element iStart via a hyperslab selection
+// so that only that part of the data set is read.  Strings aren't supported.
+void
+ReadArrayRange( void * iIntoLocation,
+                hid_t iParent,
+                const std::string &iName,
+                const AbcA::DataType &iDataType,
+                hid_t iType,
+                size_t iStart,
+                size_t iCount );
+
 //-*****************************************************************************
 // Fills in oTimeSamples with the different TimeSampling that the archive uses
 // Intrinsically all archives have the first TimeSampling for uniform time 
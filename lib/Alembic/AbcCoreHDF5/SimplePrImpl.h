@@ -194,6 +194,7 @@ SimplePrImpl<ABSTRACT,IMPL,SAMPLE>::SimplePrImpl
     PlainOldDataType POD = m_header->getDataType().getPod();
     if ( POD != kStringPOD && POD != kWstringPOD )
     {
+        HDF5Lock lock;
         m_fileDataType = GetFileH5T( m_header->getDataType(),
                                      m_cleanFileDataType );
         m_nativeDataType = GetNativeH5T( m_header->getDataType(),
@@ -296,6 +297,8 @@ void SimplePrImpl<ABSTRACT,IMPL,SAMPLE>::checkSamplesIGroup()
         if ( m_samplesIGroup.isValidObject() )
             return;
 
+        HDF5Lock lock;
+
         std::string samplesIName =  m_header->getName() + ".smpi";
         ABCA_ASSERT( GroupExists( m_parentGroup, samplesIName ),
                      "Invalid property: " << m_header->getName()
@@ -350,17 +353,20 @@ SimplePrImpl<ABSTRACT,IMPL,SAMPLE>::getSample( index_t iSampleIndex,
         // Sample 0 is always on the parent group, with
         // our name + ".smp0" as the name of it.
         std::string sample0Name = getSampleName( myName, 0 );
-        if ( m_header->getPropertyType() == AbcA::kScalarProperty )
         {
-            ABCA_ASSERT( AttrExists( m_parentGroup, sample0Name.c_str() ),
-                         "Invalid property in SimplePrImpl getSample: "
-                         << myName << ", missing smp0" );
-        }
-        else
-        {
-            ABCA_ASSERT( DatasetExists( m_parentGroup, sample0Name ),
-                         "Invalid propertyin SimplePrImpl getSample: "
-                         << myName << ", missing smp1" );
+            HDF5Lock lock;
+            if ( m_header->getPropertyType() == AbcA::kScalarProperty )
+            {
+                ABCA_ASSERT( AttrExists( m_parentGroup, sample0Name.c_str() ),
+                             "Invalid property in SimplePrImpl getSample: "
+                             << myName << ", missing smp0" );
+            }
+            else
+            {
+                ABCA_ASSERT( DatasetExists( m_parentGroup, sample0Name ),
+                             "Invalid propertyin SimplePrImpl getSample: "
+                             << myName << ", missing smp1" );
+            }
         }
 
         static_cast<IMPL *>( this )->readSample( m_parentGroup.getObject(),
@@ -389,6 +395,14 @@ SimplePrImpl<ABSTRACT,IMPL,SAMPLE>::getKey( index_t iSampleIndex,
 {
     iSampleIndex = verifySampleIndex( iSampleIndex );
 
+    // it takes its own lock before the HDF5 one
+    if ( iSampleIndex != 0 )
+    {
+        checkSamplesIGroup();
+    }
+
+    HDF5Lock lock;
+
     // Get our name.
     const std::string &myName = m_header->getName();
 
@@ -431,6 +445,8 @@ SimplePrImpl<ABSTRACT,IMPL,SAMPLE>::getKey( index_t iSampleIndex,
 template <class ABSTRACT, class IMPL, class SAMPLE>
 SimplePrImpl<ABSTRACT,IMPL,SAMPLE>::~SimplePrImpl()
 {
+    HDF5Lock lock;
+
     // Clean up our samples group, if necessary.
     CloseObject( m_samplesIGroup );
 
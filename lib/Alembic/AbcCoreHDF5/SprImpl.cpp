@@ -57,6 +57,10 @@ void SprImpl::readSample( hid_t iGroup,
     assert( iGroup >= 0 );
     assert( oSampleBytes );
 
+    // scalars are small enough that splitting their strings apart
+    // isn't worth letting go of the lock for
+    HDF5Lock lock;
+
     const AbcA::DataType &dtype = m_header->getDataType();
     uint8_t extent = dtype.getExtent();
     if ( dtype.getPod() == kStringPOD )
@@ -410,6 +410,8 @@ ReadStringArrayT( AbcA::ReadArraySampleCachePtr iCache,
 {
     assert( iDataType.getExtent() > 0 );
 
+    HDF5Lock lock;
+
     // Open the data set.
     hid_t dsetId = H5Dopen( iParent, iName.c_str(), H5P_DEFAULT );
     ABCA_ASSERT( dsetId >= 0, "Cannot open dataset: " << iName );
@@ -440,7 +442,12 @@ ReadStringArrayT( AbcA::ReadArraySampleCachePtr iCache,
             H5Tget_size( dsetFtype );
 
         foundDigest = ReadKey( dsetId, "key", key );
-        AbcA::ReadArraySampleID found = iCache->find( key );
+
+        AbcA::ReadArraySampleID found;
+        {
+            HDF5Unlock unlock;
+            found = iCache->find( key );
+        }
         if ( found )
         {
             AbcA::ArraySamplePtr ret = found.getSample();
@@ -533,6 +540,9 @@ ReadStringArrayT( AbcA::ReadArraySampleCachePtr iCache,
         ABCA_ASSERT( status >= 0,
                      "Could not read string array from data set. Weird." );
 
+        // the rest is done without HDF5, so other threads may use it
+        HDF5Unlock unlock;
+
         // Make an appropriately dimensionalized (and manageable)
         // array of strings using the ArraySamples.
         ret = AbcA::AllocateArraySample( iDataType,
@@ -564,6 +574,7 @@ ReadStringArrayT( AbcA::ReadArraySampleCachePtr iCache,
     // Store if there is a cache.
     if ( foundDigest && iCache )
     {
+        HDF5Unlock unlock;
         AbcA::ReadArraySampleID stored = iCache->store( key, ret );
         if ( stored )
         {
@@ -0,0 +1,223 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/Util/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifndef _MSC_VER
+#include <pthread.h>
+#endif
+
+//-*****************************************************************************
+namespace A5 = Alembic::AbcCoreHDF5;
+
+namespace ABCA = Alembic::AbcCoreAbstract;
+
+static const std::size_t kNumThreads = 8;
+static const std::size_t kNumObjects = 16;
+static const std::size_t kNumSamples = 20;
+
+//-*****************************************************************************
+std::string objectName( std::size_t iObject )
+{
+    std::ostringstream strm;
+    strm << "obj" << iObject;
+    return strm.str();
+}
+
+//-*****************************************************************************
+// values repeat every 4 samples, so that some of them are shared through
+// the cache
+Alembic::Util::int32_t sampleValue( std::size_t iObject, std::size_t iSample )
+{
+    return ( Alembic::Util::int32_t ) ( iObject * 100 + iSample % 4 );
+}
+
+//-*****************************************************************************
+void writeArchive( const std::string & iName )
+{
+    A5::WriteArchive w;
+    ABCA::ArchiveWriterPtr a = w( iName, ABCA::MetaData() );
+    ABCA::ObjectWriterPtr top = a->getTop();
+
+    for ( std::size_t i = 0; i < kNumObjects; ++i )
+    {
+        ABCA::ObjectWriterPtr obj = top->createChild(
+            ABCA::ObjectHeader( objectName( i ), ABCA::MetaData() ) );
+        ABCA::CompoundPropertyWriterPtr props = obj->getProperties();
+
+        ABCA::ArrayPropertyWriterPtr ints = props->createArrayProperty(
+            "ints", ABCA::MetaData(),
+            ABCA::DataType( Alembic::Util::kInt32POD, 1 ), 0 );
+
+        ABCA::ArrayPropertyWriterPtr strs = props->createArrayProperty(
+            "strs", ABCA::MetaData(),
+            ABCA::DataType( Alembic::Util::kStringPOD, 1 ), 0 );
+
+        ABCA::ScalarPropertyWriterPtr scalar = props->createScalarProperty(
+            "scalar", ABCA::MetaData(),
+            ABCA::DataType( Alembic::Util::kStringPOD, 1 ), 0 );
+
+        for ( std::size_t j = 0; j < kNumSamples; ++j )
+        {
+            Alembic::Util::int32_t val = sampleValue( i, j );
+            std::vector< Alembic::Util::int32_t > vals( 64, val );
+            ints->setSample( ABCA::ArraySample( &vals.front(),
+                ABCA::DataType( Alembic::Util::kInt32POD, 1 ),
+                Alembic::Util::Dimensions( vals.size() ) ) );
+
+            std::ostringstream strm;
+            strm << val;
+            std::vector< std::string > names( 3, strm.str() );
+            strs->setSample( ABCA::ArraySample( &names.front(),
+                ABCA::DataType( Alembic::Util::kStringPOD, 1 ),
+                Alembic::Util::Dimensions( names.size() ) ) );
+
+            std::string name = strm.str();
+            scalar->setSample( &name );
+        }
+    }
+}
+
+//-*****************************************************************************
+struct ReaderArgs
+{
+    ABCA::ArchiveReaderPtr archive;
+    std::size_t thread;
+    bool ok;
+};
+
+//-*****************************************************************************
+// every thread walks the same objects, starting at a different one, so
+// they open them, and read the same samples, at the same time
+void * readObjects( void * iArgs )
+{
+    ReaderArgs * args = static_cast< ReaderArgs * >( iArgs );
+    ABCA::ObjectReaderPtr top = args->archive->getTop();
+
+    for ( std::size_t n = 0; n < kNumObjects; ++n )
+    {
+        std::size_t i = ( n + args->thread ) % kNumObjects;
+        ABCA::ObjectReaderPtr obj = top->getChild( objectName( i ) );
+        ABCA::CompoundPropertyReaderPtr props = obj->getProperties();
+        ABCA::ArrayPropertyReaderPtr ints = props->getArrayProperty( "ints" );
+        ABCA::ArrayPropertyReaderPtr strs = props->getArrayProperty( "strs" );
+        ABCA::ScalarPropertyReaderPtr scalar =
+            props->getScalarProperty( "scalar" );
+
+        for ( std::size_t j = 0; j < kNumSamples; ++j )
+        {
+            Alembic::Util::int32_t val = sampleValue( i, j );
+            std::ostringstream strm;
+            strm << val;
+
+            ABCA::ArraySamplePtr samp;
+            ints->getSample( j, samp );
+            const Alembic::Util::int32_t * data =
+                static_cast< const Alembic::Util::int32_t * >(
+                    samp->getData() );
+            args->ok = args->ok && samp->size() == 64 &&
+                data[0] == val && data[63] == val;
+
+            strs->getSample( j, samp );
+            const std::string * names =
+                static_cast< const std::string * >( samp->getData() );
+            args->ok = args->ok && samp->size() == 3 &&
+                names[0] == strm.str() && names[2] == strm.str();
+
+            std::string name;
+            scalar->getSample( j, &name );
+            args->ok = args->ok && name == strm.str();
+
+            ABCA::ArraySampleKey key;
+            args->ok = args->ok && ints->getKey( j, key ) &&
+                key.numBytes == 64 * sizeof( Alembic::Util::int32_t );
+
+            std::vector< double > asDouble( 64 );
+            ints->getAs( j, &asDouble.front(), Alembic::Util::kFloat64POD );
+            args->ok = args->ok && asDouble[10] == ( double ) val;
+        }
+    }
+
+    return NULL;
+}
+
+//-*****************************************************************************
+void testConcurrentRead()
+{
+    std::string archiveName = "concurrentRead.abc";
+    writeArchive( archiveName );
+
+    // a few rounds, so that objects and samples get let go of and read
+    // again while other threads still hold on to theirs
+    for ( std::size_t round = 0; round < 4; ++round )
+    {
+        A5::ReadArchive r;
+        ABCA::ArchiveReaderPtr a = r( archiveName );
+
+        std::vector< ReaderArgs > args( kNumThreads );
+        std::vector< pthread_t > threads( kNumThreads );
+        for ( std::size_t i = 0; i < kNumThreads; ++i )
+        {
+            args[i].archive = a;
+            args[i].thread = i;
+            args[i].ok = true;
+            pthread_create( &threads[i], NULL, readObjects, &args[i] );
+        }
+
+        for ( std::size_t i = 0; i < kNumThreads; ++i )
+        {
+            pthread_join( threads[i], NULL );
+            TESTING_ASSERT( args[i].ok );
+        }
+    }
+}
+
+//-*****************************************************************************
+int main ( int argc, char *argv[] )
+{
+#ifndef _MSC_VER
+    testConcurrentRead();
+#endif
+    return 0;
+}
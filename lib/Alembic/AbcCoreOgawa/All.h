@@ -37,6 +37,9 @@
 #ifndef _Alembic_AbcCoreOgawa_All_h_
 #define _Alembic_AbcCoreOgawa_All_h_
 
+#include <Alembic/AbcCoreOgawa/Migrate.h>
 #include <Alembic/AbcCoreOgawa/ReadWrite.h>
+#include <Alembic/AbcCoreOgawa/Repack.h>
+#include <Alembic/AbcCoreOgawa/Verify.h>
 
 #endif
@@ -35,6 +35,7 @@
 //-*****************************************************************************
 
 #include <Alembic/AbcCoreOgawa/AprImpl.h>
+#include <Alembic/AbcCoreOgawa/ReadContextImpl.h>
 #include <Alembic/AbcCoreOgawa/ReadUtil.h>
 #include <Alembic/AbcCoreOgawa/StreamManager.h>
 #include <Alembic/AbcCoreOgawa/OrImpl.h>
@@ -61,6 +62,9 @@ AprImpl::AprImpl( AbcA::CompoundPropertyReaderPtr iParent,
         ABCA_THROW( "Attempted to create a ArrayPropertyReader from a "
                     "non-array property type" );
     }
+
+    m_archive = dynamic_cast< ArImpl * >( getObject()->getArchive().get() );
+    ABCA_ASSERT( m_archive, "Invalid archive" );
 }
 
 //-*****************************************************************************
@@ -101,17 +105,65 @@ bool AprImpl::isConstant()
 
 //-*****************************************************************************
 void AprImpl::getSample( index_t iSampleIndex, AbcA::ArraySamplePtr &oSample )
+{
+    getSample( iSampleIndex, oSample, NULL );
+}
+
+//-*****************************************************************************
+void AprImpl::getSample( index_t iSampleIndex, AbcA::ArraySamplePtr &oSample,
+                         AbcA::ReadContext * iContext )
+{
+    ReadContextImpl * context = ReadContextImpl::get( iContext, m_archive );
+    if ( context == NULL )
+    {
+        // nothing to reuse, so set one up just for this read
+        ReadContextImpl local( m_archive, m_archive->getStreamID() );
+        getSample( iSampleIndex, oSample, &local );
+        return;
+    }
+
+    ReadContextImpl::Read read( *context );
+    readSample( iSampleIndex, oSample, *context, false );
+}
+
+//-*****************************************************************************
+void AprImpl::prefetchSample( index_t iSampleIndex, std::size_t iStreamID )
+{
+    ReadContextImpl local( m_archive, iStreamID );
+    AbcA::ArraySamplePtr sample;
+    readSample( iSampleIndex, sample, local, true );
+}
+
+//-*****************************************************************************
+void AprImpl::readSample( index_t iSampleIndex,
+                          AbcA::ArraySamplePtr &oSample,
+                          ReadContextImpl & iContext, bool iStore )
 {
     size_t index = m_header->verifyIndex( iSampleIndex ) * 2;
 
-    StreamIDPtr streamId = Alembic::Util::dynamic_pointer_cast< ArImpl,
-        AbcA::ArchiveReader > ( getObject()->getArchive() )->getStreamID();
+    std::size_t id = iContext.getStreamID();
+    Ogawa::IData & dims = iContext.getDims();
+    Ogawa::IData & data = iContext.getData();
+    m_group->getData( index + 1, id, dims );
+    m_group->getData( index, id, data );
+
+    // empty samples are read without any I/O, so they aren't kept
+    Prefetcher & prefetcher = m_archive->getPrefetcher();
+    PrefetchKey key( data.getPos(), dims.getPos(),
+                     m_header->header.getDataType() );
+    if ( data.getSize() > 0 && prefetcher.find( key, oSample ) )
+    {
+        return;
+    }
 
-    std::size_t id = streamId->getID();
-    Ogawa::IDataPtr dims = m_group->getData(index + 1, id);
-    Ogawa::IDataPtr data = m_group->getData(index, id);
+    ReadArraySample( dims, data, id, m_header->header.getDataType(), oSample,
+                     iContext.getScratch(), m_archive->getEnabledReadStats(),
+                     m_archive->getAllocator() );
 
-    ReadArraySample( dims, data, id, m_header->header.getDataType(), oSample );
+    if ( iStore && data.getSize() > 0 )
+    {
+        prefetcher.store( key, oSample );
+    }
 }
 
 //-*****************************************************************************
@@ -138,6 +190,22 @@ std::pair<index_t, chrono_t> AprImpl::getNearIndex( chrono_t iTime )
 //-*****************************************************************************
 bool AprImpl::getKey( index_t iSampleIndex, AbcA::ArraySampleKey & oKey )
 {
+    return getKey( iSampleIndex, oKey, NULL );
+}
+
+//-*****************************************************************************
+bool AprImpl::getKey( index_t iSampleIndex, AbcA::ArraySampleKey & oKey,
+                      AbcA::ReadContext * iContext )
+{
+    ReadContextImpl * context = ReadContextImpl::get( iContext, m_archive );
+    if ( context == NULL )
+    {
+        // nothing to reuse, so set one up just for this read
+        ReadContextImpl local( m_archive, m_archive->getStreamID() );
+        return getKey( iSampleIndex, oKey, &local );
+    }
+
+    ReadContextImpl::Read read( *context );
     oKey.readPOD = m_header->header.getDataType().getPod();
     oKey.origPOD = oKey.readPOD;
     oKey.numBytes = 0;
@@ -145,18 +213,15 @@ bool AprImpl::getKey( index_t iSampleIndex, AbcA::ArraySampleKey & oKey )
     // * 2 for Array properties (since we also write the dimensions)
     size_t index = m_header->verifyIndex( iSampleIndex ) * 2;
 
-    StreamIDPtr streamId = Alembic::Util::dynamic_pointer_cast< ArImpl,
-        AbcA::ArchiveReader > ( getObject()->getArchive() )->getStreamID();
-
-    std::size_t id = streamId->getID();
-    Ogawa::IDataPtr data = m_group->getData( index, id );
+    std::size_t id = context->getStreamID();
+    Ogawa::IData & data = context->getData();
 
-    if ( data )
+    if ( m_group->getData( index, id, data ) )
     {
-        if ( data->getSize() >= 16 )
+        if ( data.getSize() >= 16 )
         {
-            oKey.numBytes = data->getSize() - 16;
-            data->read( 16, oKey.digest.d, 0, id );
+            oKey.numBytes = data.getSize() - 16;
+            data.read( 16, oKey.digest.d, 0, id );
         }
 
         return true;
@@ -165,6 +230,15 @@ bool AprImpl::getKey( index_t iSampleIndex, AbcA::ArraySampleKey & oKey )
     return false;
 }
 
+//-*****************************************************************************
+bool AprImpl::getSampleData( index_t iSampleIndex, ReadContextImpl & iContext,
+                             Ogawa::IData & oData )
+{
+    // * 2 for Array properties (since we also write the dimensions)
+    size_t index = m_header->verifyIndex( iSampleIndex ) * 2;
+    return m_group->getData( index, iContext.getStreamID(), oData );
+}
+
 //-*****************************************************************************
 bool AprImpl::isScalarLike()
 {
@@ -175,31 +249,93 @@ bool AprImpl::isScalarLike()
 void AprImpl::getDimensions( index_t iSampleIndex,
                              Alembic::Util::Dimensions & oDim )
 {
-    size_t index = m_header->verifyIndex( iSampleIndex ) * 2;
+    getDimensions( iSampleIndex, oDim, NULL );
+}
+
+//-*****************************************************************************
+void AprImpl::getDimensions( index_t iSampleIndex,
+                             Alembic::Util::Dimensions & oDim,
+                             AbcA::ReadContext * iContext )
+{
+    ReadContextImpl * context = ReadContextImpl::get( iContext, m_archive );
+    if ( context == NULL )
+    {
+        // nothing to reuse, so set one up just for this read
+        ReadContextImpl local( m_archive, m_archive->getStreamID() );
+        getDimensions( iSampleIndex, oDim, &local );
+        return;
+    }
 
-    StreamIDPtr streamId = Alembic::Util::dynamic_pointer_cast< ArImpl,
-        AbcA::ArchiveReader > ( getObject()->getArchive() )->getStreamID();
+    ReadContextImpl::Read read( *context );
+    size_t index = m_header->verifyIndex( iSampleIndex ) * 2;
 
-    std::size_t id = streamId->getID();
-    Ogawa::IDataPtr dims = m_group->getData(index + 1, id);
-    Ogawa::IDataPtr data = m_group->getData(index, id);
+    std::size_t id = context->getStreamID();
+    Ogawa::IData & dims = context->getDims();
+    Ogawa::IData & data = context->getData();
+    m_group->getData( index + 1, id, dims );
+    m_group->getData( index, id, data );
 
     ReadDimensions( dims, data, id, m_header->header.getDataType(), oDim );
-
 }
 
 //-*****************************************************************************
 void AprImpl::getAs( index_t iSampleIndex, void *iIntoLocation,
                      Alembic::Util::PlainOldDataType iPod )
 {
+    getAs( iSampleIndex, iIntoLocation, iPod, NULL );
+}
+
+//-*****************************************************************************
+void AprImpl::getAs( index_t iSampleIndex, void *iIntoLocation,
+                     Alembic::Util::PlainOldDataType iPod,
+                     AbcA::ReadContext * iContext )
+{
+    ReadContextImpl * context = ReadContextImpl::get( iContext, m_archive );
+    if ( context == NULL )
+    {
+        // nothing to reuse, so set one up just for this read
+        ReadContextImpl local( m_archive, m_archive->getStreamID() );
+        getAs( iSampleIndex, iIntoLocation, iPod, &local );
+        return;
+    }
+
+    ReadContextImpl::Read read( *context );
+    size_t index = m_header->verifyIndex( iSampleIndex ) * 2;
+
+    std::size_t id = context->getStreamID();
+    Ogawa::IData & data = context->getData();
+    m_group->getData( index, id, data );
+
+    ReadData( iIntoLocation, data, id, m_header->header.getDataType(), iPod,
+              context->getScratch(), m_archive->getEnabledReadStats() );
+}
+
+//-*****************************************************************************
+void AprImpl::getRangeAs( index_t iSampleIndex, size_t iStart, size_t iCount,
+                          void *iIntoLocation,
+                          Alembic::Util::PlainOldDataType iPod,
+                          AbcA::ReadContext * iContext )
+{
+    ReadContextImpl * context = ReadContextImpl::get( iContext, m_archive );
+    if ( context == NULL )
+    {
+        // nothing to reuse, so set one up just for this read
+        ReadContextImpl local( m_archive, m_archive->getStreamID() );
+        getRangeAs( iSampleIndex, iStart, iCount, iIntoLocation, iPod,
+                    &local );
+        return;
+    }
+
+    ReadContextImpl::Read read( *context );
     size_t index = m_header->verifyIndex( iSampleIndex ) * 2;
 
-    StreamIDPtr streamId = Alembic::Util::dynamic_pointer_cast< ArImpl,
-        AbcA::ArchiveReader > ( getObject()->getArchive() )->getStreamID();
+    std::size_t id = context->getStreamID();
+    Ogawa::IData & data = context->getData();
+    m_group->getData( index, id, data );
 
-    std::size_t id = streamId->getID();
-    Ogawa::IDataPtr data = m_group->getData( index, id );
-    ReadData( iIntoLocation, data, id, m_header->header.getDataType(), iPod );
+    ReadDataRange( iIntoLocation, data, id, m_header->header.getDataType(),
+                   iPod, iStart, iCount, context->getScratch(),
+                   m_archive->getEnabledReadStats() );
 }
 
 } // End namespace ALEMBIC_VERSION_NS
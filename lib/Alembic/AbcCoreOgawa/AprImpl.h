@@ -43,6 +43,9 @@ namespace Alembic {
 namespace AbcCoreOgawa {
 namespace ALEMBIC_VERSION_NS {
 
+class ArImpl;
+class ReadContextImpl;
+
 //-*****************************************************************************
 class AprImpl :
     public AbcA::ArrayPropertyReader,
@@ -74,8 +77,38 @@ public:
     virtual void getAs( index_t iSample, void *iIntoLocation,
                         Alembic::Util::PlainOldDataType iPod );
 
+    virtual void getSample( index_t iSampleIndex,
+                            AbcA::ArraySamplePtr &oSample,
+                            AbcA::ReadContext * iContext );
+    virtual bool getKey( index_t iSampleIndex, AbcA::ArraySampleKey & oKey,
+                         AbcA::ReadContext * iContext );
+    virtual void getDimensions( index_t iSampleIndex,
+                                Alembic::Util::Dimensions & oDim,
+                                AbcA::ReadContext * iContext );
+    virtual void getAs( index_t iSample, void *iIntoLocation,
+                        Alembic::Util::PlainOldDataType iPod,
+                        AbcA::ReadContext * iContext );
+    virtual void getRangeAs( index_t iSample, size_t iStart, size_t iCount,
+                             void *iIntoLocation,
+                             Alembic::Util::PlainOldDataType iPod,
+                             AbcA::ReadContext * iContext );
+
+    // reads the sample into the archive's prefetched samples, through
+    // iStreamID, which the caller holds
+    void prefetchSample( index_t iSampleIndex, std::size_t iStreamID );
+
+    // points oData at the block, key followed by data, that the sample is
+    // stored in, returns false if there isn't one
+    bool getSampleData( index_t iSampleIndex, ReadContextImpl & iContext,
+                        Ogawa::IData & oData );
+
 private:
 
+    // the prefetched sample if there is one, otherwise reads it, and when
+    // iStore is set hands what was read to the prefetcher
+    void readSample( index_t iSampleIndex, AbcA::ArraySamplePtr &oSample,
+                     ReadContextImpl & iContext, bool iStore );
+
     // Parent compound property writer. It must exist.
     AbcA::CompoundPropertyReaderPtr m_parent;
 
@@ -84,6 +117,9 @@ private:
 
     // Stores the PropertyHeader and other info
     PropertyHeaderPtr m_header;
+
+    // The archive we were read from, m_parent keeps it alive
+    ArImpl * m_archive;
 };
 
 } // End namespace ALEMBIC_VERSION_NS
@@ -38,6 +38,10 @@
 #include <Alembic/AbcCoreOgawa/OrData.h>
 #include <Alembic/AbcCoreOgawa/OrImpl.h>
 #include <Alembic/AbcCoreOgawa/ReadUtil.h>
+#include <Alembic/AbcCoreOgawa/ReadContextImpl.h>
+#include <Alembic/AbcCoreOgawa/AprImpl.h>
+
+#include <algorithm>
 
 namespace Alembic {
 namespace AbcCoreOgawa {
@@ -45,11 +49,17 @@ namespace ALEMBIC_VERSION_NS {
 
 //-*****************************************************************************
 ArImpl::ArImpl( const std::string &iFileName,
-                std::size_t iNumStreams )
+                std::size_t iNumStreams,
+                std::size_t iMaxStreams,
+                StreamPolicy iPolicy )
   : m_fileName( iFileName )
-  , m_archive( iFileName, iNumStreams )
+  // with room for the streams reserved for prefetching
+  , m_archive( iFileName, iNumStreams,
+               ( iMaxStreams > iNumStreams ? iMaxStreams : iNumStreams ) +
+               StreamManager::MAX_RESERVED_STREAMS )
   , m_header( new AbcA::ObjectHeader() )
-  , m_manager( iNumStreams )
+  , m_manager( iNumStreams, iMaxStreams, iPolicy, &m_archive )
+  , m_prefetcher( new Prefetcher( m_manager ) )
 {
     ABCA_ASSERT( m_archive.isValid(),
                  "Could not open as Ogawa file: " << m_fileName );
@@ -65,6 +75,7 @@ ArImpl::ArImpl( const std::vector< std::istream * > & iStreams )
   : m_archive( iStreams )
   , m_header( new AbcA::ObjectHeader() )
   , m_manager( iStreams.size() )
+  , m_prefetcher( new Prefetcher( m_manager ) )
 {
     ABCA_ASSERT( m_archive.isValid(),
                  "Could not open as Ogawa file from provided streams." );
@@ -164,6 +175,15 @@ AbcA::ObjectReaderPtr ArImpl::getTop()
         ret = Alembic::Util::shared_ptr<OrImpl>(
             new OrImpl( shared_from_this(), m_data, m_header ) );
         m_top = ret;
+
+        if ( m_stats.isEnabled() )
+        {
+            m_stats.addCacheMiss();
+        }
+    }
+    else if ( m_stats.isEnabled() )
+    {
+        m_stats.addCacheHit();
     }
 
     return ret;
@@ -178,6 +198,44 @@ AbcA::TimeSamplingPtr ArImpl::getTimeSampling( Util::uint32_t iIndex )
     return m_timeSamples[iIndex];
 }
 
+//-*****************************************************************************
+void ArImpl::setStatsEnabled( bool iEnabled )
+{
+    m_archive.setStatsEnabled( iEnabled );
+    m_stats.setEnabled( iEnabled );
+}
+
+//-*****************************************************************************
+bool ArImpl::getStats( AbcA::ArchiveStats & oStats )
+{
+    oStats.reset();
+
+    std::vector< Ogawa::IStreams::Stats > streams;
+    m_archive.getStats( streams );
+
+    oStats.streams.resize( streams.size() );
+    for ( std::size_t i = 0; i < streams.size(); ++i )
+    {
+        oStats.streams[i].numReads = streams[i].numReads;
+        oStats.streams[i].bytesRead = streams[i].bytesRead;
+        oStats.streams[i].lockWaitTime = streams[i].lockWaitTime;
+        oStats.streams[i].numSeeks = streams[i].numSeeks;
+        oStats.streams[i].seekDistance = streams[i].seekDistance;
+    }
+
+    oStats.numStreamFallbacks = m_manager.getNumFallbacks();
+    m_stats.get( oStats );
+    return true;
+}
+
+//-*****************************************************************************
+void ArImpl::resetStats()
+{
+    m_archive.resetStats();
+    m_manager.resetNumFallbacks();
+    m_stats.reset();
+}
+
 //-*****************************************************************************
 AbcA::ArchiveReaderPtr ArImpl::asArchivePtr()
 {
@@ -202,9 +260,114 @@ StreamIDPtr ArImpl::getStreamID()
     return m_manager.get();
 }
 
+//-*****************************************************************************
+AbcA::ReadContextPtr ArImpl::createReadContext()
+{
+    return AbcA::ReadContextPtr(
+        new ReadContextImpl( this, StreamIDPtr(), shared_from_this() ) );
+}
+
+//-*****************************************************************************
+namespace {
+
+struct TimedRead
+{
+    TimedRead( chrono_t iTime, const Prefetcher::Read & iRead )
+      : time( iTime ), read( iRead ) {}
+
+    bool operator<( const TimedRead & iRhs ) const
+    {
+        return time < iRhs.time;
+    }
+
+    chrono_t time;
+    Prefetcher::Read read;
+};
+
+} // End namespace
+
+//-*****************************************************************************
+Util::uint64_t ArImpl::prefetch(
+    const std::vector< AbcA::ArrayPropertyReaderPtr > & iProperties,
+    chrono_t iStartTime, chrono_t iEndTime, Util::int32_t iPriority )
+{
+    std::vector< TimedRead > timed;
+
+    for ( std::size_t i = 0; i < iProperties.size(); ++i )
+    {
+        AprImplPtr apr = Alembic::Util::dynamic_pointer_cast< AprImpl,
+            AbcA::ArrayPropertyReader >( iProperties[i] );
+
+        // properties of other archives aren't ours to read
+        if ( !apr || apr->getObject()->getArchive().get() != this )
+        {
+            continue;
+        }
+
+        std::size_t numSamples = apr->getNumSamples();
+        if ( numSamples == 0 )
+        {
+            continue;
+        }
+
+        AbcA::TimeSamplingPtr ts = apr->getTimeSampling();
+        index_t first = 0;
+        index_t last = 0;
+        if ( !apr->isConstant() )
+        {
+            first = ts->getFloorIndex( iStartTime, numSamples ).first;
+            last = ts->getCeilIndex( iEndTime, numSamples ).first;
+        }
+
+        for ( index_t j = first; j <= last; ++j )
+        {
+            timed.push_back( TimedRead( ts->getSampleTime( j ),
+                                        Prefetcher::Read( apr, j ) ) );
+        }
+    }
+
+    // the earliest frames are the ones wanted first
+    std::stable_sort( timed.begin(), timed.end() );
+
+    std::vector< Prefetcher::Read > reads;
+    reads.reserve( timed.size() );
+    for ( std::size_t i = 0; i < timed.size(); ++i )
+    {
+        reads.push_back( timed[i].read );
+    }
+
+    return m_prefetcher->schedule( reads, iPriority );
+}
+
+//-*****************************************************************************
+void ArImpl::cancelPrefetch( Util::uint64_t iRequest )
+{
+    m_prefetcher->cancel( iRequest );
+}
+
+//-*****************************************************************************
+void ArImpl::cancelAllPrefetches()
+{
+    m_prefetcher->cancelAll();
+}
+
+//-*****************************************************************************
+void ArImpl::waitForPrefetch( Util::uint64_t iRequest )
+{
+    m_prefetcher->wait( iRequest );
+}
+
+//-*****************************************************************************
+void ArImpl::setPrefetchLimits( std::size_t iNumThreads,
+                                std::size_t iMaxBytes )
+{
+    m_prefetcher->setLimits( iNumThreads, iMaxBytes );
+}
+
 //-*****************************************************************************
 ArImpl::~ArImpl()
 {
+    m_prefetcher->stop();
 }
 
 //-*****************************************************************************
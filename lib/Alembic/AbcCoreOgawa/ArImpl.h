@@ -39,6 +39,8 @@
 
 #include <Alembic/AbcCoreOgawa/Foundation.h>
 #include <Alembic/AbcCoreOgawa/StreamManager.h>
+#include <Alembic/AbcCoreOgawa/ReadStats.h>
+#include <Alembic/AbcCoreOgawa/Prefetcher.h>
 
 namespace Alembic {
 namespace AbcCoreOgawa {
@@ -56,7 +58,9 @@ private:
     friend class ReadArchive;
 
     ArImpl( const std::string &iFileName,
-            size_t iNumStreams=1 );
+            size_t iNumStreams=1,
+            size_t iMaxStreams=0,
+            StreamPolicy iPolicy=kFallbackStreamPolicy );
 
     ArImpl( const std::vector< std::istream * > & iStreams );
 
@@ -87,6 +91,19 @@ public:
     {
     }
 
+    //! THIS METHOD IS NOT MULTITHREAD SAFE
+    //! call it before any reads, prefetches included, start
+    virtual void
+    setArraySampleAllocator( AbcA::ArraySampleAllocatorPtr iAllocator )
+    {
+        m_allocator = iAllocator;
+    }
+
+    virtual AbcA::ArraySampleAllocatorPtr getArraySampleAllocator()
+    {
+        return m_allocator;
+    }
+
     virtual AbcA::index_t getMaxNumSamplesForTimeSamplingIndex(
         Util::uint32_t iIndex );
 
@@ -100,10 +117,57 @@ public:
         return m_archiveVersion;
     }
 
+    virtual void setStatsEnabled( bool iEnabled );
+
+    virtual bool getStats( AbcA::ArchiveStats & oStats );
+
+    virtual void resetStats();
+
+    virtual AbcA::ReadContextPtr createReadContext();
+
+    virtual Util::uint64_t prefetch(
+        const std::vector< AbcA::ArrayPropertyReaderPtr > & iProperties,
+        chrono_t iStartTime, chrono_t iEndTime, Util::int32_t iPriority );
+
+    virtual void cancelPrefetch( Util::uint64_t iRequest );
+
+    virtual void cancelAllPrefetches();
+
+    virtual void waitForPrefetch( Util::uint64_t iRequest );
+
+    virtual void setPrefetchLimits( std::size_t iNumThreads,
+                                    std::size_t iMaxBytes );
+
     StreamIDPtr getStreamID();
 
+    // see StreamManager::pin
+    bool pinStreamID( std::size_t & oStreamID )
+    { return m_manager.pin( oStreamID ); }
+
+    void unpinStreamID( std::size_t iStreamID )
+    { m_manager.unpin( iStreamID ); }
+
+    // the counters readers add to, always valid
+    ReadStats & getReadStats() { return m_stats; }
+
+    // NULL unless stats are enabled
+    ReadStats * getEnabledReadStats()
+    {
+        return m_stats.isEnabled() ? &m_stats : NULL;
+    }
+
     const std::vector< AbcA::MetaData > & getIndexedMetaData();
 
+    // what array samples are read into, may be empty, this isn't locked
+    // since it is only set before reading starts
+    const AbcA::ArraySampleAllocatorPtr & getAllocator() const
+    {
+        return m_allocator;
+    }
+
+    // where array property readers look for prefetched samples
+    Prefetcher & getPrefetcher() { return *m_prefetcher; }
+
 private:
     void init();
 
@@ -126,6 +190,12 @@ private:
     StreamManager m_manager;
 
     std::vector< AbcA::MetaData > m_indexMetaData;
+
+    ReadStats m_stats;
+
+    AbcA::ArraySampleAllocatorPtr m_allocator;
+
+    PrefetcherPtr m_prefetcher;
 };
 
 } // End namespace ALEMBIC_VERSION_NS
@@ -50,6 +50,7 @@ AwImpl::AwImpl( const std::string &iFileName,
   , m_metaData( iMetaData )
   , m_archive( iFileName )
   , m_metaDataMap( new MetaDataMap() )
+  , m_statsEnabled( false )
 {
 
     // add default time sampling
@@ -71,6 +72,7 @@ AwImpl::AwImpl( std::ostream * iStream,
   : m_metaData( iMetaData )
   , m_archive( iStream )
   , m_metaDataMap( new MetaDataMap() )
+  , m_statsEnabled( false )
 {
     // add default time sampling
     AbcA::TimeSamplingPtr ts( new AbcA::TimeSampling() );
@@ -146,6 +148,8 @@ AbcA::ArchiveWriterPtr AwImpl::asArchivePtr()
 //-*****************************************************************************
 AbcA::ObjectWriterPtr AwImpl::getTop()
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     AbcA::ObjectWriterPtr ret = m_top.lock();
     if ( ! ret )
     {
@@ -161,6 +165,8 @@ AbcA::ObjectWriterPtr AwImpl::getTop()
 //-*****************************************************************************
 Util::uint32_t AwImpl::addTimeSampling( const AbcA::TimeSampling & iTs )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     index_t numTS = m_timeSamples.size();
     for (index_t i = 0; i < numTS; ++i)
     {
@@ -185,16 +191,27 @@ Util::uint32_t AwImpl::addTimeSampling( const AbcA::TimeSampling & iTs )
 //-*****************************************************************************
 AbcA::TimeSamplingPtr AwImpl::getTimeSampling( Util::uint32_t iIndex )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     ABCA_ASSERT( iIndex < m_timeSamples.size(),
         "Invalid index provided to getTimeSampling." );
 
     return m_timeSamples[iIndex];
 }
 
+//-*****************************************************************************
+Util::uint32_t AwImpl::getNumTimeSamplings()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    return m_timeSamples.size();
+}
+
 //-*****************************************************************************
 AbcA::index_t
 AwImpl::getMaxNumSamplesForTimeSamplingIndex( Util::uint32_t iIndex )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     if ( iIndex < m_maxSamples.size() )
     {
         return m_maxSamples[iIndex];
@@ -206,12 +223,45 @@ AwImpl::getMaxNumSamplesForTimeSamplingIndex( Util::uint32_t iIndex )
 void AwImpl::setMaxNumSamplesForTimeSamplingIndex( Util::uint32_t iIndex,
                                                    AbcA::index_t iMaxIndex )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     if ( iIndex < m_maxSamples.size() )
     {
         m_maxSamples[iIndex] = iMaxIndex;
     }
 }
 
+//-*****************************************************************************
+void AwImpl::updateMaxNumSamples( Util::uint32_t iIndex,
+                                  AbcA::index_t iNumSamples )
+{
+    Alembic::Util::scoped_lock l( m_lock );
+
+    if ( iIndex < m_maxSamples.size() && m_maxSamples[iIndex] < iNumSamples )
+    {
+        m_maxSamples[iIndex] = iNumSamples;
+    }
+}
+
+//-*****************************************************************************
+void AwImpl::setStatsEnabled( bool iEnabled )
+{
+    m_statsEnabled = iEnabled;
+}
+
+//-*****************************************************************************
+bool AwImpl::getStats( AbcA::ArchiveStats & oStats )
+{
+    oStats = m_stats;
+    return true;
+}
+
+//-*****************************************************************************
+void AwImpl::resetStats()
+{
+    m_stats.reset();
+}
+
 //-*****************************************************************************
 AwImpl::~AwImpl()
 {
@@ -93,8 +93,7 @@ public:
 
     virtual AbcA::TimeSamplingPtr getTimeSampling( Util::uint32_t iIndex );
 
-    virtual Util::uint32_t getNumTimeSamplings()
-    { return m_timeSamples.size(); }
+    virtual Util::uint32_t getNumTimeSamplings();
 
     virtual AbcA::index_t getMaxNumSamplesForTimeSamplingIndex(
         Util::uint32_t iIndex );
@@ -102,6 +101,22 @@ public:
     virtual void setMaxNumSamplesForTimeSamplingIndex( Util::uint32_t iIndex,
                                                       AbcA::index_t iMaxIndex );
 
+    // raises the max to iNumSamples if it is lower
+    void updateMaxNumSamples( Util::uint32_t iIndex,
+                              AbcA::index_t iNumSamples );
+
+    virtual void setStatsEnabled( bool iEnabled );
+
+    virtual bool getStats( AbcA::ArchiveStats & oStats );
+
+    virtual void resetStats();
+
+    // NULL unless stats are enabled
+    AbcA::ArchiveStats * getEnabledWriteStats()
+    {
+        return m_statsEnabled ? &m_stats : NULL;
+    }
+
 private:
     void init();
     std::string m_fileName;
@@ -117,6 +132,14 @@ private:
 
     WrittenSampleMap m_writtenSampleMap;
     MetaDataMapPtr m_metaDataMap;
+
+    // only the write counters are used, WriteUtil locks around them
+    AbcA::ArchiveStats m_stats;
+    bool m_statsEnabled;
+
+    // guards the top object and the time samplings, which different
+    // threads writing different objects share
+    Alembic::Util::mutex m_lock;
 };
 
 } // End namespace ALEMBIC_VERSION_NS
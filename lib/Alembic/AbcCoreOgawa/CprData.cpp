@@ -55,6 +55,9 @@ CprData::CprData( Ogawa::IGroupPtr iGroup,
 {
     ABCA_ASSERT( iGroup, "invalid compound data group" );
 
+    ArImpl * archive = dynamic_cast< ArImpl * >( &iArchive );
+    m_stats = archive ? &( archive->getReadStats() ) : NULL;
+
     m_group = iGroup;
 
     std::size_t numChildren = m_group->getNumChildren();
@@ -142,6 +145,7 @@ CprData::getScalarProperty( AbcA::CompoundPropertyReaderPtr iParent,
 
     Alembic::Util::scoped_lock l( sub.lock );
     AbcA::BasePropertyReaderPtr bptr = sub.made.lock();
+    countCacheLookup( bptr );
     if ( ! bptr )
     {
         StreamIDPtr streamId = Alembic::Util::dynamic_pointer_cast< ArImpl,
@@ -189,6 +193,7 @@ CprData::getArrayProperty( AbcA::CompoundPropertyReaderPtr iParent,
 
     Alembic::Util::scoped_lock l( sub.lock );
     AbcA::BasePropertyReaderPtr bptr = sub.made.lock();
+    countCacheLookup( bptr );
     if ( ! bptr )
     {
         StreamIDPtr streamId = Alembic::Util::dynamic_pointer_cast< ArImpl,
@@ -237,6 +242,7 @@ CprData::getCompoundProperty( AbcA::CompoundPropertyReaderPtr iParent,
 
     Alembic::Util::scoped_lock l( sub.lock );
     AbcA::BasePropertyReaderPtr bptr = sub.made.lock();
+    countCacheLookup( bptr );
     if ( ! bptr )
     {
         Alembic::Util::shared_ptr<  ArImpl > implPtr =
@@ -264,6 +270,22 @@ CprData::getCompoundProperty( AbcA::CompoundPropertyReaderPtr iParent,
     return ret;
 }
 
+//-*****************************************************************************
+void CprData::countCacheLookup( bool iHit )
+{
+    if ( m_stats && m_stats->isEnabled() )
+    {
+        if ( iHit )
+        {
+            m_stats->addCacheHit();
+        }
+        else
+        {
+            m_stats->addCacheMiss();
+        }
+    }
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace AbcCoreOgawa
 } // End namespace Alembic
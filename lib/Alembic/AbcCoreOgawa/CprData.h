@@ -38,6 +38,7 @@
 #define _Alembic_AbcCoreOgawa_CprData_h_
 
 #include <Alembic/AbcCoreOgawa/Foundation.h>
+#include <Alembic/AbcCoreOgawa/ReadStats.h>
 
 namespace Alembic {
 namespace AbcCoreOgawa {
@@ -92,6 +93,12 @@ private:
 
     SubProperty * m_propertyHeaders;
     SubPropertiesMap m_subProperties;
+
+    // tallies whether an already made reader could be handed out again
+    void countCacheLookup( bool iHit );
+
+    // owned by the archive, which outlives us
+    ReadStats * m_stats;
 };
 
 typedef Alembic::Util::shared_ptr<CprData> CprDataPtr;
@@ -59,6 +59,8 @@ CpwData::~CpwData()
 //-*****************************************************************************
 size_t CpwData::getNumProperties()
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     return m_propertyHeaders.size();
 }
 
@@ -66,6 +68,8 @@ size_t CpwData::getNumProperties()
 const AbcA::PropertyHeader &
 CpwData::getPropertyHeader( size_t i )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     if ( i > m_propertyHeaders.size() )
     {
         ABCA_THROW( "Out of range index in " <<
@@ -82,6 +86,8 @@ CpwData::getPropertyHeader( size_t i )
 const AbcA::PropertyHeader *
 CpwData::getPropertyHeader( const std::string &iName )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     for ( PropertyHeaderPtrs::iterator piter = m_propertyHeaders.begin();
           piter != m_propertyHeaders.end(); ++piter )
     {
@@ -97,6 +103,8 @@ CpwData::getPropertyHeader( const std::string &iName )
 AbcA::BasePropertyWriterPtr
 CpwData::getProperty( const std::string &iName )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     MadeProperties::iterator fiter = m_madeProperties.find( iName );
     if ( fiter == m_madeProperties.end() )
     {
@@ -116,6 +124,8 @@ CpwData::createScalarProperty( AbcA::CompoundPropertyWriterPtr iParent,
                                const AbcA::DataType & iDataType,
                                Util::uint32_t iTimeSamplingIndex )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     if ( m_madeProperties.count( iName ) )
     {
         ABCA_THROW( "Already have a property named: " << iName );
@@ -155,6 +165,8 @@ CpwData::createArrayProperty( AbcA::CompoundPropertyWriterPtr iParent,
                               const AbcA::DataType & iDataType,
                               Util::uint32_t iTimeSamplingIndex )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     if ( m_madeProperties.count( iName ) )
     {
         ABCA_THROW( "Already have a property named: " << iName );
@@ -192,6 +204,8 @@ CpwData::createCompoundProperty( AbcA::CompoundPropertyWriterPtr iParent,
                                  const std::string & iName,
                                  const AbcA::MetaData & iMetaData )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     if ( m_madeProperties.count( iName ) )
     {
         ABCA_THROW( "Already have a property named: " << iName );
@@ -216,9 +230,11 @@ CpwData::createCompoundProperty( AbcA::CompoundPropertyWriterPtr iParent,
 //-*****************************************************************************
 void CpwData::writePropertyHeaders( MetaDataMapPtr iMetaDataMap )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     // pack in child header and other info
     std::vector< Util::uint8_t > data;
-    for ( size_t i = 0; i < getNumProperties(); ++i )
+    for ( size_t i = 0; i < m_propertyHeaders.size(); ++i )
     {
         PropertyHeaderPtr prop = m_propertyHeaders[i];
         WritePropertyInfo( data,
@@ -242,6 +258,7 @@ void CpwData::writePropertyHeaders( MetaDataMapPtr iMetaDataMap )
 void CpwData::fillHash( size_t iIndex, Util::uint64_t iHash0,
     Util::uint64_t iHash1 )
 {
+    Alembic::Util::scoped_lock l( m_lock );
 
     ABCA_ASSERT( iIndex < m_propertyHeaders.size() &&
                  iIndex * 2 < m_hashes.size(),
@@ -254,6 +271,8 @@ void CpwData::fillHash( size_t iIndex, Util::uint64_t iHash0,
 //-*****************************************************************************
 void CpwData::computeHash( Util::SpookyHash & ioHash )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     if ( !m_hashes.empty() )
     {
         ioHash.Update( &m_hashes.front(), m_hashes.size() * 8 );
@@ -43,6 +43,8 @@ namespace ALEMBIC_VERSION_NS {
 //-*****************************************************************************
 Util::uint32_t MetaDataMap::getIndex( const std::string & iStr )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     if ( iStr.empty() )
     {
         return 0;
@@ -75,6 +77,7 @@ Util::uint32_t MetaDataMap::getIndex( const std::string & iStr )
 //-*****************************************************************************
 void MetaDataMap::write( Ogawa::OGroupPtr iParent )
 {
+    Alembic::Util::scoped_lock l( m_lock );
 
     if ( m_map.empty() )
     {
@@ -58,6 +58,9 @@ public:
     void write( Ogawa::OGroupPtr iParent );
 private:
     std::map< std::string, Util::uint32_t > m_map;
+
+    // headers of different objects may be written from different threads
+    Alembic::Util::mutex m_lock;
 };
 
 typedef Alembic::Util::shared_ptr<MetaDataMap> MetaDataMapPtr;
@@ -0,0 +1,511 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreOgawa/Migrate.h>
+#include <Alembic/AbcCoreOgawa/Foundation.h>
+#include <Alembic/AbcCoreOgawa/ReadWrite.h>
+#include <Alembic/Util/Timer.h>
+
+#include <algorithm>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+//-*****************************************************************************
+// somewhere a scalar sample can be read into and written from
+class ScalarBuffer
+{
+public:
+    ScalarBuffer( const AbcA::DataType & iDataType )
+      : m_pod( iDataType.getPod() )
+    {
+        if ( m_pod == Alembic::Util::kStringPOD )
+        {
+            m_strings.resize( iDataType.getExtent() );
+        }
+        else if ( m_pod == Alembic::Util::kWstringPOD )
+        {
+            m_wstrings.resize( iDataType.getExtent() );
+        }
+        else
+        {
+            m_bytes.resize( iDataType.getNumBytes() );
+        }
+    }
+
+    void * get()
+    {
+        if ( m_pod == Alembic::Util::kStringPOD )
+        {
+            return &m_strings.front();
+        }
+        else if ( m_pod == Alembic::Util::kWstringPOD )
+        {
+            return &m_wstrings.front();
+        }
+        return &m_bytes.front();
+    }
+
+    Util::uint64_t numBytes() const
+    {
+        Util::uint64_t bytes = m_bytes.size();
+        for ( std::size_t i = 0; i < m_strings.size(); ++i )
+        {
+            bytes += m_strings[i].size();
+        }
+        for ( std::size_t i = 0; i < m_wstrings.size(); ++i )
+        {
+            bytes += m_wstrings[i].size() * sizeof( wchar_t );
+        }
+        return bytes;
+    }
+
+private:
+    Alembic::Util::PlainOldDataType m_pod;
+    std::vector< char > m_bytes;
+    std::vector< std::string > m_strings;
+    std::vector< std::wstring > m_wstrings;
+};
+
+//-*****************************************************************************
+// an array or scalar property being copied, only ever by one thread
+struct Property
+{
+    Property( AbcA::ArrayPropertyReaderPtr iReader )
+      : arrayReader( iReader ) {}
+
+    Property( AbcA::ScalarPropertyReaderPtr iReader )
+      : scalarReader( iReader ) {}
+
+    AbcA::ArrayPropertyReaderPtr arrayReader;
+    AbcA::ScalarPropertyReaderPtr scalarReader;
+    AbcA::ArrayPropertyWriterPtr arrayWriter;
+    AbcA::ScalarPropertyWriterPtr scalarWriter;
+};
+
+//-*****************************************************************************
+// the writers which have to stay open until every sample is written
+struct Writers
+{
+    std::vector< AbcA::ObjectWriterPtr > objects;
+    std::vector< AbcA::CompoundPropertyWriterPtr > compounds;
+};
+
+//-*****************************************************************************
+// what the copying threads share, everything but the properties themselves
+// is guarded by lock
+struct Work
+{
+    Work( std::vector< Property > & iProps, const MigrateOptions & iOptions,
+          const MigrateStats & iStats )
+      : props( iProps ), options( iOptions ), next( 0 ), stats( iStats ) {}
+
+    std::vector< Property > & props;
+    const MigrateOptions & options;
+    Util::Timer timer;
+
+    Util::mutex lock;
+    std::size_t next;
+    MigrateStats stats;
+
+    // the first thing to go wrong, which stops every thread
+    std::string error;
+};
+
+//-*****************************************************************************
+void CollectProperties( AbcA::CompoundPropertyReaderPtr iIn,
+                        AbcA::CompoundPropertyWriterPtr iOut,
+                        AbcA::ArchiveWriterPtr iArchive,
+                        std::vector< Property > & oProps,
+                        Writers & oWriters,
+                        MigrateStats & oStats )
+{
+    for ( std::size_t i = 0; i < iIn->getNumProperties(); ++i )
+    {
+        const AbcA::PropertyHeader & header = iIn->getPropertyHeader( i );
+        oStats.numProperties ++;
+
+        if ( header.isCompound() )
+        {
+            AbcA::CompoundPropertyWriterPtr out = iOut->createCompoundProperty(
+                header.getName(), header.getMetaData() );
+            oWriters.compounds.push_back( out );
+            CollectProperties( iIn->getCompoundProperty( header.getName() ),
+                               out, iArchive, oProps, oWriters, oStats );
+            continue;
+        }
+
+        // hands back the index it already has, it was copied up front
+        Alembic::Util::uint32_t tsIndex =
+            iArchive->addTimeSampling( *header.getTimeSampling() );
+
+        if ( header.isArray() )
+        {
+            oProps.push_back( Property(
+                iIn->getArrayProperty( header.getName() ) ) );
+            oProps.back().arrayWriter = iOut->createArrayProperty(
+                header.getName(), header.getMetaData(), header.getDataType(),
+                tsIndex );
+            oStats.totalSamples += oProps.back().arrayReader->getNumSamples();
+        }
+        else
+        {
+            oProps.push_back( Property(
+                iIn->getScalarProperty( header.getName() ) ) );
+            oProps.back().scalarWriter = iOut->createScalarProperty(
+                header.getName(), header.getMetaData(), header.getDataType(),
+                tsIndex );
+            oStats.totalSamples += oProps.back().scalarReader->getNumSamples();
+        }
+    }
+}
+
+//-*****************************************************************************
+void CollectObjects( AbcA::ObjectReaderPtr iIn,
+                     AbcA::ObjectWriterPtr iOut,
+                     AbcA::ArchiveWriterPtr iArchive,
+                     std::vector< Property > & oProps,
+                     Writers & oWriters,
+                     MigrateStats & oStats )
+{
+    AbcA::CompoundPropertyWriterPtr props = iOut->getProperties();
+    oWriters.compounds.push_back( props );
+    oStats.numObjects ++;
+
+    CollectProperties( iIn->getProperties(), props, iArchive, oProps,
+                       oWriters, oStats );
+
+    for ( std::size_t i = 0; i < iIn->getNumChildren(); ++i )
+    {
+        AbcA::ObjectWriterPtr child =
+            iOut->createChild( iIn->getChildHeader( i ) );
+        oWriters.objects.push_back( child );
+        CollectObjects( iIn->getChild( i ), child, iArchive, oProps,
+                        oWriters, oStats );
+    }
+}
+
+//-*****************************************************************************
+Util::uint64_t SampleBytes( const AbcA::ArraySample & iSample )
+{
+    Util::PlainOldDataType pod = iSample.getDataType().getPod();
+    std::size_t size = iSample.size() * iSample.getDataType().getExtent();
+
+    Util::uint64_t bytes = 0;
+    if ( pod == Util::kStringPOD )
+    {
+        const std::string * strs =
+            static_cast< const std::string * >( iSample.getData() );
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            bytes += strs[i].size();
+        }
+    }
+    else if ( pod == Util::kWstringPOD )
+    {
+        const std::wstring * strs =
+            static_cast< const std::wstring * >( iSample.getData() );
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            bytes += strs[i].size() * sizeof( wchar_t );
+        }
+    }
+    else
+    {
+        bytes = size * Util::PODNumBytes( pod );
+    }
+    return bytes;
+}
+
+//-*****************************************************************************
+void Report( Work & iWork, Util::uint64_t iSamples, Util::uint64_t iBytes )
+{
+    Util::scoped_lock l( iWork.lock );
+    iWork.stats.numSamples += iSamples;
+    iWork.stats.bytesCopied += iBytes;
+    iWork.stats.seconds = iWork.timer.elapsed();
+
+    if ( iWork.options.progress )
+    {
+        iWork.options.progress( iWork.stats, iWork.options.progressData );
+    }
+}
+
+//-*****************************************************************************
+// whether sample iIndex is the same as the one before it, which is known
+// without reading the data when the stored keys are the same
+bool SameAsPrevious( AbcA::ArrayPropertyReaderPtr iReader, index_t iIndex,
+                     AbcA::ArraySampleKey & ioKey, bool & ioHasKey )
+{
+    if ( iReader->isConstant() )
+    {
+        return iIndex > 0;
+    }
+
+    AbcA::ArraySampleKey key;
+    bool hasKey = iReader->getKey( iIndex, key );
+    bool same = hasKey && ioHasKey && key == ioKey;
+    if ( same )
+    {
+        // a key doesn't hold the shape, only the size
+        Util::Dimensions dims;
+        Util::Dimensions prevDims;
+        iReader->getDimensions( iIndex, dims );
+        iReader->getDimensions( iIndex - 1, prevDims );
+        same = ( dims == prevDims );
+    }
+
+    ioKey = key;
+    ioHasKey = hasKey;
+    return same;
+}
+
+//-*****************************************************************************
+// reads up to a batch worth of samples before writing them, so that the
+// dataset stays open for the reads and the hashing happens all at once
+void CopyArray( Property & iProp, Work & iWork )
+{
+    std::size_t numSamples = iProp.arrayReader->getNumSamples();
+
+    AbcA::ArraySampleKey key;
+    bool hasKey = false;
+
+    // an empty pointer where the sample is the same as the one before
+    std::vector< AbcA::ArraySamplePtr > batch;
+
+    std::size_t i = 0;
+    while ( i < numSamples )
+    {
+        batch.clear();
+        Util::uint64_t bytes = 0;
+        for ( ; i < numSamples && bytes < iWork.options.batchBytes; ++i )
+        {
+            AbcA::ArraySamplePtr sample;
+            if ( !SameAsPrevious( iProp.arrayReader, i, key, hasKey ) )
+            {
+                iProp.arrayReader->getSample( i, sample );
+                bytes += SampleBytes( *sample );
+            }
+            batch.push_back( sample );
+        }
+
+        for ( std::size_t j = 0; j < batch.size(); ++j )
+        {
+            if ( batch[j] )
+            {
+                iProp.arrayWriter->setSample( *batch[j] );
+            }
+            else
+            {
+                iProp.arrayWriter->setFromPreviousSample();
+            }
+        }
+
+        Report( iWork, batch.size(), bytes );
+    }
+}
+
+//-*****************************************************************************
+void CopyScalar( Property & iProp, Work & iWork )
+{
+    std::size_t numSamples = iProp.scalarReader->getNumSamples();
+    bool isConstant = iProp.scalarReader->isConstant();
+
+    ScalarBuffer buffer( iProp.scalarWriter->getDataType() );
+    Util::uint64_t bytes = 0;
+    for ( std::size_t i = 0; i < numSamples; ++i )
+    {
+        if ( isConstant && i > 0 )
+        {
+            iProp.scalarWriter->setFromPreviousSample();
+            continue;
+        }
+
+        iProp.scalarReader->getSample( i, buffer.get() );
+        iProp.scalarWriter->setSample( buffer.get() );
+        bytes += buffer.numBytes();
+    }
+
+    Report( iWork, numSamples, bytes );
+}
+
+//-*****************************************************************************
+void * Migrate( void * iWork )
+{
+    Work & work = *( static_cast< Work * >( iWork ) );
+
+    for ( ;; )
+    {
+        std::size_t i = 0;
+        {
+            Util::scoped_lock l( work.lock );
+            if ( work.next == work.props.size() )
+            {
+                break;
+            }
+            i = work.next ++;
+        }
+
+        Property & prop = work.props[i];
+        try
+        {
+            if ( prop.arrayReader )
+            {
+                CopyArray( prop, work );
+            }
+            else
+            {
+                CopyScalar( prop, work );
+            }
+        }
+        catch ( std::exception & e )
+        {
+            Util::scoped_lock l( work.lock );
+            if ( work.error.empty() )
+            {
+                const AbcA::PropertyHeader & header = prop.arrayReader ?
+                    prop.arrayReader->getHeader() :
+                    prop.scalarReader->getHeader();
+                work.error = header.getName() + ": " + e.what();
+            }
+            work.next = work.props.size();
+        }
+    }
+
+    return NULL;
+}
+
+} // End namespace
+
+//-*****************************************************************************
+MigrateStats MigrateArchive( AbcA::ArchiveReaderPtr iArchive,
+                             const std::string & iFileName,
+                             const MigrateOptions & iOptions )
+{
+    ABCA_ASSERT( iArchive, "Can't migrate an empty archive" );
+    ABCA_ASSERT( iArchive->getName() != iFileName,
+                 "Can't migrate an archive onto itself: " << iFileName );
+
+    AbcA::ArchiveWriterPtr archive =
+        WriteArchive()( iFileName, iArchive->getMetaData() );
+
+    // copy the time samplings up front, so they keep their indices
+    for ( Alembic::Util::uint32_t i = 1; i < iArchive->getNumTimeSamplings();
+          ++i )
+    {
+        archive->addTimeSampling( *iArchive->getTimeSampling( i ) );
+    }
+
+    std::vector< Property > props;
+    Writers writers;
+    MigrateStats stats;
+    CollectObjects( iArchive->getTop(), archive->getTop(), archive, props,
+                    writers, stats );
+
+    // the array properties, which take longest, go first so that no thread
+    // is left with one at the end while the others sit idle
+    std::vector< Property > sorted;
+    sorted.reserve( props.size() );
+    for ( std::size_t i = 0; i < props.size(); ++i )
+    {
+        if ( props[i].arrayReader )
+        {
+            sorted.push_back( props[i] );
+        }
+    }
+    for ( std::size_t i = 0; i < props.size(); ++i )
+    {
+        if ( props[i].scalarReader )
+        {
+            sorted.push_back( props[i] );
+        }
+    }
+    props.swap( sorted );
+    sorted.clear();
+
+    Work work( props, iOptions, stats );
+
+    std::size_t numThreads = std::max( iOptions.numThreads, std::size_t( 1 ) );
+    std::vector< Alembic::Util::thread * > threads;
+    for ( std::size_t i = 0; i < numThreads; ++i )
+    {
+        Alembic::Util::thread * thread =
+            new Alembic::Util::thread( Migrate, &work );
+        if ( !thread->valid() )
+        {
+            delete thread;
+            break;
+        }
+        threads.push_back( thread );
+    }
+
+    // if no thread could be started, do it all here
+    if ( threads.empty() )
+    {
+        Migrate( &work );
+    }
+
+    for ( std::size_t i = 0; i < threads.size(); ++i )
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    // close the writers from the leaves up, the archive last
+    props.clear();
+    while ( !writers.compounds.empty() )
+    {
+        writers.compounds.pop_back();
+    }
+    while ( !writers.objects.empty() )
+    {
+        writers.objects.pop_back();
+    }
+    archive.reset();
+
+    ABCA_ASSERT( work.error.empty(), "Couldn't migrate "
+                 << iArchive->getName() << ", " << work.error );
+
+    work.stats.seconds = work.timer.elapsed();
+    return work.stats;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
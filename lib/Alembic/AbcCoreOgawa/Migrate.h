@@ -0,0 +1,123 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcCoreOgawa_Migrate_h_
+#define _Alembic_AbcCoreOgawa_Migrate_h_
+
+#include <Alembic/AbcCoreAbstract/All.h>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! How far along MigrateArchive is, handed to the progress callback and
+//! returned when it is done.
+struct MigrateStats
+{
+    MigrateStats()
+      : numObjects( 0 ), numProperties( 0 ), numSamples( 0 ),
+        totalSamples( 0 ), bytesCopied( 0 ), seconds( 0.0 ) {}
+
+    Alembic::Util::uint64_t numObjects;
+    Alembic::Util::uint64_t numProperties;
+
+    //! Samples copied so far, out of totalSamples.
+    Alembic::Util::uint64_t numSamples;
+    Alembic::Util::uint64_t totalSamples;
+
+    //! Bytes of sample data read and handed to the writer, before the
+    //! writer drops the samples it already has.
+    Alembic::Util::uint64_t bytesCopied;
+
+    //! Wall clock time since the copy started.
+    double seconds;
+};
+
+//-*****************************************************************************
+//! Called by MigrateArchive as batches of samples are written, from
+//! whichever thread wrote them, but never from two threads at once.
+typedef void ( *MigrateProgressFunc )( const MigrateStats & iStats,
+                                       void * iData );
+
+//-*****************************************************************************
+//! How MigrateArchive goes about copying.
+struct MigrateOptions
+{
+    MigrateOptions()
+      : numThreads( 4 ), batchBytes( 64 * 1024 * 1024 ), progress( NULL ),
+        progressData( NULL ) {}
+
+    //! How many threads read, hash and write samples.
+    std::size_t numThreads;
+
+    //! Roughly how many bytes of one property's samples a thread reads
+    //! before it writes them, so reads of one dataset aren't broken up by
+    //! the hashing and writing of its samples.
+    Alembic::Util::uint64_t batchBytes;
+
+    //! Optional, called with progressData as batches are written.
+    MigrateProgressFunc progress;
+    void * progressData;
+};
+
+//-*****************************************************************************
+//! Copies iArchive, usually an HDF5 archive, into a new Ogawa archive at
+//! iFileName.  The hierarchy, metadata and time samplings are copied as they
+//! are, the hierarchy on the calling thread, then the samples of each
+//! property are read in batches and written by iOptions.numThreads threads,
+//! each thread taking whole properties.  The Ogawa writer hashes each
+//! sample as it is written and keeps only one copy of repeated samples, so
+//! that sharing survives the migration.
+//! iArchive must be safe to read from many threads, which AbcCoreHDF5 and
+//! AbcCoreOgawa archives are.  Opening an HDF5 archive with its cached
+//! hierarchy, see AbcCoreHDF5::ReadArchive, makes walking it much cheaper.
+//! The samples end up grouped by property, use RepackArchive afterwards
+//! for a layout suited to playback.  If this throws, what was written to
+//! iFileName is incomplete.
+MigrateStats MigrateArchive( AbcCoreAbstract::ArchiveReaderPtr iArchive,
+                             const std::string & iFileName,
+                             const MigrateOptions & iOptions =
+                                 MigrateOptions() );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
+
+#endif
@@ -39,6 +39,7 @@
 #include <Alembic/AbcCoreOgawa/CprData.h>
 #include <Alembic/AbcCoreOgawa/CprImpl.h>
 #include <Alembic/AbcCoreOgawa/ReadUtil.h>
+#include <Alembic/AbcCoreOgawa/ArImpl.h>
 
 namespace Alembic {
 namespace AbcCoreOgawa {
@@ -54,6 +55,9 @@ OrData::OrData( Ogawa::IGroupPtr iGroup,
 {
     ABCA_ASSERT( iGroup, "Invalid object data group" );
 
+    ArImpl * archive = dynamic_cast< ArImpl * >( &iArchive );
+    m_stats = archive ? &( archive->getReadStats() ) : NULL;
+
     m_group = iGroup;
 
     std::size_t numChildren = m_group->getNumChildren();
@@ -99,6 +103,7 @@ OrData::getProperties( AbcA::ObjectReaderPtr iParent )
 {
     Alembic::Util::scoped_lock l( m_cprlock );
     AbcA::CompoundPropertyReaderPtr ret = m_top.lock();
+    countCacheLookup( ret );
 
     if ( ! ret )
     {
@@ -163,6 +168,7 @@ OrData::getChild( AbcA::ObjectReaderPtr iParent, size_t i )
 
     Alembic::Util::scoped_lock l( m_children[i].lock );
     AbcA::ObjectReaderPtr optr = m_children[i].made.lock();
+    countCacheLookup( optr );
 
     if ( ! optr )
     {
@@ -175,6 +181,23 @@ OrData::getChild( AbcA::ObjectReaderPtr iParent, size_t i )
     return optr;
 }
 
+//-*****************************************************************************
+void OrData::countCacheLookup( bool iHit )
+{
+    if ( m_stats && m_stats->isEnabled() )
+    {
+        if ( iHit )
+        {
+            m_stats->addCacheHit();
+        }
+        else
+        {
+            m_stats->addCacheMiss();
+        }
+    }
+}
+
+//-*****************************************************************************
 void OrData::getPropertiesHash( Util::Digest & oDigest, size_t iThreadId )
 {
     std::size_t numChildren = m_group->getNumChildren();
@@ -38,6 +38,7 @@
 #define _Alembic_AbcCoreOgawa_OrData_h_
 
 #include <Alembic/AbcCoreOgawa/Foundation.h>
+#include <Alembic/AbcCoreOgawa/ReadStats.h>
 
 namespace Alembic {
 namespace AbcCoreOgawa {
@@ -101,6 +102,12 @@ private:
     Alembic::Util::weak_ptr< AbcA::CompoundPropertyReader > m_top;
     Alembic::Util::shared_ptr < CprData > m_data;
     Alembic::Util::mutex m_cprlock;
+
+    // tallies whether an already made reader could be handed out again
+    void countCacheLookup( bool iHit );
+
+    // owned by the archive, which outlives us
+    ReadStats * m_stats;
 };
 
 typedef Alembic::Util::shared_ptr<OrData> OrDataPtr;
@@ -64,6 +64,8 @@ OwData::~OwData()
 AbcA::CompoundPropertyWriterPtr
 OwData::getProperties( AbcA::ObjectWriterPtr iParent )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     AbcA::CompoundPropertyWriterPtr ret = m_top.lock();
     if ( ! ret )
     {
@@ -79,12 +81,16 @@ OwData::getProperties( AbcA::ObjectWriterPtr iParent )
 //-*****************************************************************************
 size_t OwData::getNumChildren()
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     return m_childHeaders.size();
 }
 
 //-*****************************************************************************
 const AbcA::ObjectHeader & OwData::getChildHeader( size_t i )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     if ( i >= m_childHeaders.size() )
     {
         ABCA_THROW( "Out of range index in OwData::getChildHeader: "
@@ -99,6 +105,8 @@ const AbcA::ObjectHeader & OwData::getChildHeader( size_t i )
 //-*****************************************************************************
 const AbcA::ObjectHeader * OwData::getChildHeader( const std::string &iName )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     size_t numChildren = m_childHeaders.size();
     for ( size_t i = 0; i < numChildren; ++i )
     {
@@ -114,6 +122,8 @@ const AbcA::ObjectHeader * OwData::getChildHeader( const std::string &iName )
 //-*****************************************************************************
 AbcA::ObjectWriterPtr OwData::getChild( const std::string &iName )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     MadeChildren::iterator fiter = m_madeChildren.find( iName );
     if ( fiter == m_madeChildren.end() )
     {
@@ -129,6 +139,8 @@ AbcA::ObjectWriterPtr OwData::createChild( AbcA::ObjectWriterPtr iParent,
                                            const std::string & iFullName,
                                            const AbcA::ObjectHeader &iHeader )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     std::string name = iHeader.getName();
 
     if ( m_madeChildren.count( name ) )
@@ -176,6 +188,8 @@ AbcA::ObjectWriterPtr OwData::createChild( AbcA::ObjectWriterPtr iParent,
 void OwData::writeHeaders( MetaDataMapPtr iMetaDataMap,
                            Util::SpookyHash & ioHash )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     std::vector< Util::uint8_t > data;
 
     // pack all object header into data here
@@ -226,6 +240,8 @@ void OwData::writeHeaders( MetaDataMapPtr iMetaDataMap,
 void OwData::fillHash( std::size_t iIndex, Util::uint64_t iHash0,
                        Util::uint64_t iHash1 )
 {
+    Alembic::Util::scoped_lock l( m_lock );
+
     ABCA_ASSERT( iIndex < m_childHeaders.size() &&
                  iIndex * 2 < m_hashes.size(),
                  "Invalid property index requested in OwData::fillHash" );
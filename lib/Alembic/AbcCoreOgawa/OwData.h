@@ -99,6 +99,10 @@ private:
 
     // child hashes
     std::vector< Util::uint64_t > m_hashes;
+
+    // guards the above, children may be made and finished from different
+    // threads
+    Alembic::Util::mutex m_lock;
 };
 
 typedef Alembic::Util::shared_ptr<OwData> OwDataPtr;
@@ -0,0 +1,382 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreOgawa/Prefetcher.h>
+#include <Alembic/AbcCoreOgawa/AprImpl.h>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+Prefetcher::Prefetcher( StreamManager & iManager )
+  : m_manager( iManager )
+  , m_numThreads( 2 )
+  , m_stop( false )
+  , m_nextRequest( 1 )
+  , m_maxBytes( 256 * 1024 * 1024 )
+{
+}
+
+//-*****************************************************************************
+Prefetcher::~Prefetcher()
+{
+    // the threads hold a reference to us, so by now they have all stopped
+}
+
+//-*****************************************************************************
+void Prefetcher::stop()
+{
+    std::vector< Alembic::Util::thread * > threads;
+
+    m_monitor.lock();
+    m_stop = true;
+    m_queue.clear();
+    m_outstanding.clear();
+    threads.swap( m_threads );
+    m_monitor.notify_all();
+    m_monitor.unlock();
+
+    for ( std::size_t i = 0; i < threads.size(); ++i )
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+}
+
+//-*****************************************************************************
+void Prefetcher::setLimits( std::size_t iNumThreads, std::size_t iMaxBytes )
+{
+    m_monitor.lock();
+    m_numThreads = iNumThreads;
+    m_maxBytes = iMaxBytes;
+
+    // start any extra threads right away if they are needed
+    if ( !m_queue.empty() )
+    {
+        startThreads();
+    }
+    m_monitor.unlock();
+}
+
+//-*****************************************************************************
+Alembic::Util::uint64_t
+Prefetcher::schedule( const std::vector< Read > & iReads,
+                      Alembic::Util::int32_t iPriority )
+{
+    m_monitor.lock();
+
+    Alembic::Util::uint64_t request = m_nextRequest ++;
+
+    if ( !iReads.empty() && !m_stop )
+    {
+        // negated so the highest priority sorts first
+        QueueKey key( -iPriority, request );
+        m_queue[key].assign( iReads.begin(), iReads.end() );
+        m_outstanding[request] = iReads.size();
+        startThreads();
+        m_monitor.notify_all();
+    }
+
+    m_monitor.unlock();
+    return request;
+}
+
+//-*****************************************************************************
+void Prefetcher::cancel( Alembic::Util::uint64_t iRequest )
+{
+    m_monitor.lock();
+
+    for ( Queue::iterator it = m_queue.begin(); it != m_queue.end(); ++it )
+    {
+        if ( it->first.second == iRequest )
+        {
+            std::map< Alembic::Util::uint64_t, std::size_t >::iterator out =
+                m_outstanding.find( iRequest );
+
+            // what is left are the reads in flight
+            out->second -= it->second.size();
+            if ( out->second == 0 )
+            {
+                m_outstanding.erase( out );
+            }
+
+            m_queue.erase( it );
+            m_monitor.notify_all();
+            break;
+        }
+    }
+
+    m_monitor.unlock();
+}
+
+//-*****************************************************************************
+void Prefetcher::cancelAll()
+{
+    m_monitor.lock();
+
+    for ( Queue::iterator it = m_queue.begin(); it != m_queue.end(); ++it )
+    {
+        std::map< Alembic::Util::uint64_t, std::size_t >::iterator out =
+            m_outstanding.find( it->first.second );
+
+        out->second -= it->second.size();
+        if ( out->second == 0 )
+        {
+            m_outstanding.erase( out );
+        }
+    }
+
+    m_queue.clear();
+    m_monitor.notify_all();
+    m_monitor.unlock();
+}
+
+//-*****************************************************************************
+void Prefetcher::wait( Alembic::Util::uint64_t iRequest )
+{
+    m_monitor.lock();
+
+    // with no threads nothing queued would ever be read, so don't wait on it
+    while ( !m_threads.empty() &&
+            m_outstanding.find( iRequest ) != m_outstanding.end() )
+    {
+        m_monitor.wait();
+    }
+
+    m_monitor.unlock();
+}
+
+//-*****************************************************************************
+Prefetcher::Shard & Prefetcher::getShard( const PrefetchKey & iKey )
+{
+    // the top bits of a multiplicative hash, since positions are often
+    // aligned
+    Alembic::Util::uint64_t hash =
+        iKey.dataPos * 0x9E3779B97F4A7C15ULL;
+    return m_shards[ hash >> 60 ];
+}
+
+//-*****************************************************************************
+void Prefetcher::release( Shard & iShard, Samples::iterator iIt )
+{
+    iShard.numBytes -= iIt->second.numBytes;
+    iShard.order.erase( iIt->second.pos );
+    iShard.samples.erase( iIt );
+    iShard.numSamples = iShard.samples.size();
+}
+
+//-*****************************************************************************
+bool Prefetcher::find( const PrefetchKey & iKey,
+                       AbcA::ArraySamplePtr & oSample )
+{
+    Shard & shard = getShard( iKey );
+    if ( shard.numSamples == 0 )
+    {
+        return false;
+    }
+
+    Alembic::Util::scoped_lock l( shard.lock );
+
+    Samples::iterator it = shard.samples.find( iKey );
+    if ( it == shard.samples.end() )
+    {
+        return false;
+    }
+
+    // whoever asked holds on to it now, or it is read again next time
+    oSample = it->second.sample;
+    release( shard, it );
+    return true;
+}
+
+//-*****************************************************************************
+void Prefetcher::store( const PrefetchKey & iKey,
+                        AbcA::ArraySamplePtr iSample )
+{
+    if ( !iSample )
+    {
+        return;
+    }
+
+    std::size_t numBytes = iSample->getDimensions().numPoints() *
+        iSample->getDataType().getNumBytes();
+    std::size_t maxBytes = m_maxBytes / NUM_SHARDS;
+
+    Shard & shard = getShard( iKey );
+    Alembic::Util::scoped_lock l( shard.lock );
+
+    Held held;
+    held.sample = iSample;
+    held.numBytes = numBytes;
+
+    std::pair< Samples::iterator, bool > inserted;
+    if ( numBytes <= maxBytes && ( inserted = shard.samples.insert(
+            Samples::value_type( iKey, held ) ) ).second )
+    {
+        inserted.first->second.pos =
+            shard.order.insert( shard.order.end(), iKey );
+        shard.numBytes += numBytes;
+
+        // let the oldest go until we fit
+        while ( shard.numBytes > maxBytes )
+        {
+            release( shard, shard.samples.find( shard.order.front() ) );
+        }
+
+        shard.numSamples = shard.samples.size();
+    }
+}
+
+//-*****************************************************************************
+void * Prefetcher::run( void * iStart )
+{
+    // we hold a reference while running, see the class comment
+    Start * start = static_cast< Start * >( iStart );
+    start->prefetcher->work( start->reserved, start->streamID );
+    delete start;
+    return NULL;
+}
+
+//-*****************************************************************************
+void Prefetcher::startThreads()
+{
+    while ( !m_stop && m_threads.size() < m_numThreads )
+    {
+        Start * start = new Start;
+        start->prefetcher = shared_from_this();
+        start->streamID = 0;
+        if ( !m_spareStreams.empty() )
+        {
+            start->reserved = true;
+            start->streamID = m_spareStreams.back();
+            m_spareStreams.pop_back();
+        }
+        else
+        {
+            start->reserved = m_manager.reserve( start->streamID );
+        }
+
+        Alembic::Util::thread * thread = new Alembic::Util::thread( run,
+                                                                    start );
+        if ( !thread->valid() )
+        {
+            // the reads just stay queued until a thread can be started, and
+            // the stream waits for it
+            if ( start->reserved )
+            {
+                m_spareStreams.push_back( start->streamID );
+            }
+            delete thread;
+            delete start;
+            break;
+        }
+        m_threads.push_back( thread );
+    }
+}
+
+//-*****************************************************************************
+void Prefetcher::work( bool iReserved, std::size_t iStreamID )
+{
+    m_monitor.lock();
+
+    while ( !m_stop )
+    {
+        if ( m_queue.empty() )
+        {
+            m_monitor.wait();
+            continue;
+        }
+
+        Queue::iterator it = m_queue.begin();
+        Alembic::Util::uint64_t request = it->first.second;
+        Read read = it->second.front();
+        it->second.pop_front();
+        if ( it->second.empty() )
+        {
+            m_queue.erase( it );
+        }
+
+        m_monitor.unlock();
+
+        // a property which has already been let go isn't worth reading,
+        // and while we hold one the archive, and m_manager, are still there
+        AprImplPtr property = read.property.lock();
+        if ( property )
+        {
+            // without a stream of our own we only read if one is free, a
+            // dropped read is just read when it is asked for
+            std::size_t streamID = iStreamID;
+            bool pinned = !iReserved && m_manager.pin( streamID );
+            if ( iReserved || pinned )
+            {
+                try
+                {
+                    property->prefetchSample( read.index, streamID );
+                }
+                catch ( ... )
+                {
+                    // the read will fail again, and be reported, when the
+                    // sample is asked for
+                }
+            }
+
+            if ( pinned )
+            {
+                m_manager.unpin( streamID );
+            }
+        }
+
+        // this may be the last reference to the archive, which stops us
+        property.reset();
+
+        m_monitor.lock();
+
+        std::map< Alembic::Util::uint64_t, std::size_t >::iterator out =
+            m_outstanding.find( request );
+        if ( out != m_outstanding.end() && -- out->second == 0 )
+        {
+            m_outstanding.erase( out );
+            m_monitor.notify_all();
+        }
+    }
+
+    m_monitor.unlock();
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
@@ -0,0 +1,218 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcCoreOgawa_Prefetcher_h_
+#define _Alembic_AbcCoreOgawa_Prefetcher_h_
+
+#include <Alembic/AbcCoreOgawa/Foundation.h>
+#include <Alembic/AbcCoreOgawa/StreamManager.h>
+
+#include <deque>
+#include <list>
+#include <map>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+class AprImpl;
+typedef Alembic::Util::shared_ptr< AprImpl > AprImplPtr;
+typedef Alembic::Util::weak_ptr< AprImpl > AprImplWeakPtr;
+
+//-*****************************************************************************
+// Where a sample lives in the file.  Samples are shared between properties
+// when they were written with the same data, so the DataType is part of the
+// key to keep an int32 array and a V3i array of the same bytes apart.
+struct PrefetchKey
+{
+    PrefetchKey( Alembic::Util::uint64_t iDataPos,
+                 Alembic::Util::uint64_t iDimsPos,
+                 const AbcA::DataType & iDataType )
+      : dataPos( iDataPos ), dimsPos( iDimsPos ), dataType( iDataType ) {}
+
+    bool operator<( const PrefetchKey & iRhs ) const
+    {
+        if ( dataPos != iRhs.dataPos ) { return dataPos < iRhs.dataPos; }
+        if ( dimsPos != iRhs.dimsPos ) { return dimsPos < iRhs.dimsPos; }
+        return dataType < iRhs.dataType;
+    }
+
+    Alembic::Util::uint64_t dataPos;
+    Alembic::Util::uint64_t dimsPos;
+    AbcA::DataType dataType;
+};
+
+//-*****************************************************************************
+// Reads array samples on background threads ahead of when they are asked
+// for, and holds on to them until the property readers ask.  Reads are
+// queued per request, highest priority first, and the threads are started
+// on the first request.  A held sample is let go once it has been asked for,
+// and otherwise they are bounded in bytes, the oldest are let go first.
+// They are held in shards with a lock each, apart from the lock the queue
+// is under, so that readers asking for different samples rarely contend.
+// Each thread reads through a stream reserved for it, so prefetching never
+// takes a stream from, or waits on, the archive's readers.  A thread which
+// couldn't reserve one reads through any stream which is free at the time,
+// and drops the read when none is.
+// The threads hold a reference to the Prefetcher, since the last reference
+// to the archive can be let go on one of them, so the archive calls stop()
+// rather than relying on the destructor.
+class Prefetcher
+    : Alembic::Util::noncopyable
+    , public Alembic::Util::enable_shared_from_this< Prefetcher >
+{
+public:
+    struct Read
+    {
+        Read( AprImplWeakPtr iProperty, index_t iIndex )
+          : property( iProperty ), index( iIndex ) {}
+
+        AprImplWeakPtr property;
+        index_t index;
+    };
+
+    // iManager must outlive the calls to stop() and setLimits() and
+    // schedule(), which are the ones which reserve its streams
+    explicit Prefetcher( StreamManager & iManager );
+    ~Prefetcher();
+
+    // stops the threads, reads which haven't started are dropped
+    void stop();
+
+    void setLimits( std::size_t iNumThreads, std::size_t iMaxBytes );
+
+    // returns the id of the request
+    Alembic::Util::uint64_t schedule( const std::vector< Read > & iReads,
+                                      Alembic::Util::int32_t iPriority );
+
+    void cancel( Alembic::Util::uint64_t iRequest );
+    void cancelAll();
+    void wait( Alembic::Util::uint64_t iRequest );
+
+    // the prefetched sample at iKey, if there is one, which is then no
+    // longer held
+    bool find( const PrefetchKey & iKey, AbcA::ArraySamplePtr & oSample );
+
+    void store( const PrefetchKey & iKey, AbcA::ArraySamplePtr iSample );
+
+private:
+    // what each thread is started with
+    struct Start
+    {
+        Alembic::Util::shared_ptr< Prefetcher > prefetcher;
+        bool reserved;
+        std::size_t streamID;
+    };
+
+    static void * run( void * iStart );
+
+    // run by each thread until stopped, reading through iStreamID if
+    // iReserved
+    void work( bool iReserved, std::size_t iStreamID );
+
+    // starts threads until there are m_numThreads, m_monitor must be held
+    void startThreads();
+
+    StreamManager & m_manager;
+
+    Alembic::Util::monitor m_monitor;
+    std::vector< Alembic::Util::thread * > m_threads;
+
+    // reserved streams no thread has yet, when a thread couldn't be started
+    std::vector< std::size_t > m_spareStreams;
+    std::size_t m_numThreads;
+    bool m_stop;
+
+    // queued reads by ( -priority, request ), so the first is read next
+    typedef std::pair< Alembic::Util::int32_t, Alembic::Util::uint64_t >
+        QueueKey;
+    typedef std::map< QueueKey, std::deque< Read > > Queue;
+    Queue m_queue;
+
+    // queued and in flight reads per request
+    std::map< Alembic::Util::uint64_t, std::size_t > m_outstanding;
+    Alembic::Util::uint64_t m_nextRequest;
+
+    // read by store without the lock, each shard holds up to a share of it
+    volatile std::size_t m_maxBytes;
+
+    typedef std::list< PrefetchKey > Order;
+    struct Held
+    {
+        AbcA::ArraySamplePtr sample;
+        std::size_t numBytes;
+
+        // where the sample is in Shard::order
+        Order::iterator pos;
+    };
+    typedef std::map< PrefetchKey, Held > Samples;
+
+    struct Shard
+    {
+        Shard() : numBytes( 0 ), numSamples( 0 ) {}
+
+        Alembic::Util::mutex lock;
+        Samples samples;
+
+        // oldest first
+        Order order;
+        std::size_t numBytes;
+
+        // read without the lock, so that find is nearly free when nothing
+        // has been prefetched
+        volatile std::size_t numSamples;
+    };
+
+    static const std::size_t NUM_SHARDS = 16;
+
+    Shard & getShard( const PrefetchKey & iKey );
+
+    // lets go of the held sample at iIt, iShard.lock must be held
+    static void release( Shard & iShard, Samples::iterator iIt );
+
+    Shard m_shards[NUM_SHARDS];
+};
+
+typedef Alembic::Util::shared_ptr< Prefetcher > PrefetcherPtr;
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,111 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreOgawa/ReadContextImpl.h>
+#include <Alembic/AbcCoreOgawa/ArImpl.h>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+ReadContextImpl::ReadContextImpl( ArImpl * iArchive, StreamIDPtr iStreamID,
+                                  AbcA::ArchiveReaderPtr iKeepAlive )
+  : m_keepAlive( iKeepAlive )
+  , m_archive( iArchive )
+  , m_streamID( iStreamID )
+  , m_id( iStreamID ? iStreamID->getID() : 0 )
+  , m_pinned( false )
+  , m_unpin( false )
+{
+}
+
+//-*****************************************************************************
+ReadContextImpl::ReadContextImpl( ArImpl * iArchive, std::size_t iStreamID )
+  : m_archive( iArchive )
+  , m_id( iStreamID )
+  , m_pinned( true )
+  , m_unpin( false )
+{
+}
+
+//-*****************************************************************************
+ReadContextImpl::~ReadContextImpl()
+{
+    // m_keepAlive is only let go after this, and m_streamID is declared
+    // after it, so the stream is given back before the archive can go
+    if ( m_unpin )
+    {
+        m_archive->unpinStreamID( m_id );
+    }
+}
+
+//-*****************************************************************************
+ReadContextImpl * ReadContextImpl::get( AbcA::ReadContext * iContext,
+                                        const ArImpl * iArchive )
+{
+    if ( iContext == NULL )
+    {
+        return NULL;
+    }
+
+    ReadContextImpl * context = dynamic_cast< ReadContextImpl * >( iContext );
+    if ( context != NULL && context->m_archive == iArchive )
+    {
+        return context;
+    }
+
+    return NULL;
+}
+
+//-*****************************************************************************
+bool ReadContextImpl::claim()
+{
+    if ( m_archive->pinStreamID( m_id ) )
+    {
+        m_pinned = true;
+        m_unpin = true;
+        return false;
+    }
+
+    m_streamID = m_archive->getStreamID();
+    m_id = m_streamID->getID();
+    return true;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
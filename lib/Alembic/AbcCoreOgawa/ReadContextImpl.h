@@ -0,0 +1,142 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef _Alembic_AbcCoreOgawa_ReadContextImpl_h_
+#define _Alembic_AbcCoreOgawa_ReadContextImpl_h_
+
+#include <Alembic/AbcCoreOgawa/Foundation.h>
+#include <Alembic/AbcCoreOgawa/StreamManager.h>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+class ArImpl;
+
+//-*****************************************************************************
+// What a sample read needs besides the property itself: the stream to read
+// through, the Ogawa data to point at the sample, and scratch memory for
+// conversions.  Handed out by ArImpl::createReadContext it is held for many
+// reads, and otherwise one is made on the stack for a single read.
+//
+// The contexts handed out pin a stream on their first read and keep it until
+// they are destroyed, so that a read through one doesn't touch the
+// StreamManager at all.  Pinning never waits, and never takes the first
+// stream, which is what keeps a thread holding a context from blocking its
+// own ordinary reads once kWaitStreamPolicy has run out of streams.  If no
+// stream can be pinned, each read claims one through a Read for just as
+// long as it takes, and the next read tries to pin again.
+class ReadContextImpl : public AbcA::ReadContext
+{
+public:
+    // iStreamID may be empty, in which case a Read pins one
+    ReadContextImpl( ArImpl * iArchive, StreamIDPtr iStreamID,
+                     AbcA::ArchiveReaderPtr iKeepAlive =
+                        AbcA::ArchiveReaderPtr() );
+
+    // reads through iStreamID, which the caller holds for longer than us
+    ReadContextImpl( ArImpl * iArchive, std::size_t iStreamID );
+
+    virtual ~ReadContextImpl();
+
+    // iContext if it was made by iArchive, otherwise NULL
+    static ReadContextImpl * get( AbcA::ReadContext * iContext,
+                                  const ArImpl * iArchive );
+
+    std::size_t getStreamID() const { return m_id; }
+
+    Ogawa::IData & getData() { return m_data; }
+    Ogawa::IData & getDims() { return m_dims; }
+
+    std::vector< char > & getScratch() { return m_scratch; }
+
+    // makes sure iContext holds a stream while it is in scope
+    class Read : Alembic::Util::noncopyable
+    {
+    public:
+        Read( ReadContextImpl & iContext )
+          : m_context( iContext )
+          , m_claimed( false )
+        {
+            if ( !m_context.m_pinned && !m_context.m_streamID )
+            {
+                m_claimed = m_context.claim();
+            }
+        }
+
+        ~Read()
+        {
+            if ( m_claimed )
+            {
+                m_context.m_streamID.reset();
+            }
+        }
+
+    private:
+        ReadContextImpl & m_context;
+        bool m_claimed;
+    };
+
+private:
+    // pins a stream, or failing that claims one for a single read, which is
+    // then let go by the Read, returns whether it has to be
+    bool claim();
+
+    // only set for the contexts handed out to users, so that the archive,
+    // and the stream manager within it, outlive the stream we hold
+    AbcA::ArchiveReaderPtr m_keepAlive;
+
+    ArImpl * m_archive;
+    StreamIDPtr m_streamID;
+    std::size_t m_id;
+
+    // m_id is held for as long as we are, and if m_unpin, was pinned by us
+    // and is given back when we are destroyed
+    bool m_pinned;
+    bool m_unpin;
+
+    Ogawa::IData m_data;
+    Ogawa::IData m_dims;
+    std::vector< char > m_scratch;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,93 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <Alembic/AbcCoreOgawa/ReadStats.h>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+ReadStats::ReadStats()
+    : m_enabled( false )
+{
+    reset();
+}
+
+//-*****************************************************************************
+void ReadStats::addCacheHit()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    m_cacheHits ++;
+}
+
+//-*****************************************************************************
+void ReadStats::addCacheMiss()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    m_cacheMisses ++;
+}
+
+//-*****************************************************************************
+void ReadStats::addDecoded( double iConversionTime )
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    m_samplesDecoded ++;
+    m_conversionTime += iConversionTime;
+}
+
+//-*****************************************************************************
+void ReadStats::get( AbcA::ArchiveStats & oStats )
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    oStats.cacheHits = m_cacheHits;
+    oStats.cacheMisses = m_cacheMisses;
+    oStats.samplesDecoded = m_samplesDecoded;
+    oStats.conversionTime = m_conversionTime;
+}
+
+//-*****************************************************************************
+void ReadStats::reset()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    m_cacheHits = 0;
+    m_cacheMisses = 0;
+    m_samplesDecoded = 0;
+    m_conversionTime = 0.0;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
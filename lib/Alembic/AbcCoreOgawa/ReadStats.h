@@ -0,0 +1,82 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef _Alembic_AbcCoreOgawa_ReadStats_h_
+#define _Alembic_AbcCoreOgawa_ReadStats_h_
+
+#include <Alembic/AbcCoreOgawa/Foundation.h>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+// The read side counters that aren't kept by Ogawa::IStreams or the
+// StreamManager.  Callers check isEnabled() before adding to them, so that
+// nothing but that check is paid while stats are off.
+class ReadStats : Alembic::Util::noncopyable
+{
+public:
+    ReadStats();
+
+    void setEnabled( bool iEnabled ) { m_enabled = iEnabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    void addCacheHit();
+    void addCacheMiss();
+    void addDecoded( double iConversionTime );
+
+    // fills in the counters of oStats that are kept here
+    void get( AbcA::ArchiveStats & oStats );
+    void reset();
+
+private:
+    volatile bool m_enabled;
+
+    Alembic::Util::mutex m_lock;
+    Util::uint64_t m_cacheHits;
+    Util::uint64_t m_cacheMisses;
+    Util::uint64_t m_samplesDecoded;
+    double m_conversionTime;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
+
+#endif
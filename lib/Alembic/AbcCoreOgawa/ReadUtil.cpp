@@ -43,22 +43,22 @@ namespace ALEMBIC_VERSION_NS {
 
 //-*****************************************************************************
 void
-ReadDimensions( Ogawa::IDataPtr iDims,
-                Ogawa::IDataPtr iData,
+ReadDimensions( Ogawa::IData & iDims,
+                Ogawa::IData & iData,
                 size_t iThreadId,
                 const AbcA::DataType &iDataType,
                 Util::Dimensions & oDim )
 {
     // find it based on of the size of the data
-    if ( iDims->getSize() == 0 )
+    if ( iDims.getSize() == 0 )
     {
-        if ( iData->getSize() == 0 )
+        if ( iData.getSize() == 0 )
         {
             oDim = Util::Dimensions( 0 );
         }
         else
         {
-            oDim = Util::Dimensions( ( iData->getSize() - 16 ) /
+            oDim = Util::Dimensions( ( iData.getSize() - 16 ) /
                                      iDataType.getNumBytes() );
         }
     }
@@ -67,12 +67,12 @@ ReadDimensions( Ogawa::IDataPtr iDims,
     {
 
         // we write them as uint64_t so / 8
-        std::size_t numRanks = iDims->getSize() / 8;
+        std::size_t numRanks = iDims.getSize() / 8;
 
         oDim.setRank( numRanks );
 
         std::vector< Util::uint64_t > dims( numRanks );
-        iDims->read( numRanks * 8, &( dims.front() ), 0, iThreadId );
+        iDims.read( numRanks * 8, &( dims.front() ), 0, iThreadId );
         for ( std::size_t i = 0; i < numRanks; ++i )
         {
             oDim[i] = dims[i];
@@ -1292,13 +1292,57 @@ ConvertData( Alembic::Util::PlainOldDataType fromPod,
     }
 }
 
+//-*****************************************************************************
+// reads iNumBytes of plain old data from iOffset bytes into iData, converting
+// from iPod to iAsPod, and returns the time spent converting if iTime is set
+double
+ReadPODs( void * iIntoLocation,
+          Ogawa::IData & iData,
+          size_t iThreadId,
+          Util::PlainOldDataType iPod,
+          Util::PlainOldDataType iAsPod,
+          std::size_t iOffset,
+          std::size_t iNumBytes,
+          std::vector< char > & ioScratch,
+          bool iTime )
+{
+    if ( iAsPod == iPod )
+    {
+        iData.read( iNumBytes, iIntoLocation, iOffset, iThreadId );
+        return 0.0;
+    }
+
+    char * buf = NULL;
+    if ( PODNumBytes( iPod ) <= PODNumBytes( iAsPod ) )
+    {
+        // there is room to convert it where it lands
+        iData.read( iNumBytes, iIntoLocation, iOffset, iThreadId );
+        buf = static_cast< char * >( iIntoLocation );
+    }
+    else
+    {
+        // read into a temporary buffer and cast them one at a time
+        ioScratch.resize( iNumBytes );
+        buf = &( ioScratch.front() );
+        iData.read( iNumBytes, buf, iOffset, iThreadId );
+    }
+
+    double decodeStart = iTime ? Util::Timer::now() : 0.0;
+
+    ConvertData( iPod, iAsPod, buf, iIntoLocation, iNumBytes );
+
+    return iTime ? Util::Timer::now() - decodeStart : 0.0;
+}
+
 //-*****************************************************************************
 void
 ReadData( void * iIntoLocation,
-          Ogawa::IDataPtr iData,
+          Ogawa::IData & iData,
           size_t iThreadId,
           const AbcA::DataType &iDataType,
-          Util::PlainOldDataType iAsPod )
+          Util::PlainOldDataType iAsPod,
+          std::vector< char > & ioScratch,
+          ReadStats * iStats )
 {
     Alembic::Util::PlainOldDataType curPod = iDataType.getPod();
     ABCA_ASSERT( ( iAsPod == curPod ) || (
@@ -1308,7 +1352,7 @@ ReadData( void * iIntoLocation,
         curPod != Alembic::Util::kWstringPOD ),
         "Cannot convert the data to or from a string, or wstring." );
 
-    std::size_t dataSize = iData->getSize();
+    std::size_t dataSize = iData.getSize();
 
     if ( dataSize < 16 )
     {
@@ -1317,6 +1361,10 @@ ReadData( void * iIntoLocation,
         return;
     }
 
+    // only the conversion work is timed, the reads are tallied by IStreams
+    double decodeStart = 0.0;
+    double decodeTime = 0.0;
+
     if ( curPod == Alembic::Util::kStringPOD )
     {
         if ( dataSize <= 16 )
@@ -1328,8 +1376,14 @@ ReadData( void * iIntoLocation,
             reinterpret_cast< std::string * > ( iIntoLocation );
 
         std::size_t numChars = dataSize - 16;
-        char * buf = new char[ numChars ];
-        iData->read( numChars, buf, 16, iThreadId );
+        ioScratch.resize( numChars );
+        char * buf = &( ioScratch.front() );
+        iData.read( numChars, buf, 16, iThreadId );
+
+        if ( iStats )
+        {
+            decodeStart = Util::Timer::now();
+        }
 
         std::size_t startStr = 0;
         std::size_t strPos = 0;
@@ -1344,7 +1398,10 @@ ReadData( void * iIntoLocation,
             }
         }
 
-        delete [] buf;
+        if ( iStats )
+        {
+            decodeTime = Util::Timer::now() - decodeStart;
+        }
     }
     else if ( curPod == Alembic::Util::kWstringPOD )
     {
@@ -1357,8 +1414,15 @@ ReadData( void * iIntoLocation,
             reinterpret_cast< std::wstring * > ( iIntoLocation );
 
         std::size_t numChars = ( dataSize - 16 ) / 4;
-        Util::uint32_t * buf = new Util::uint32_t[ numChars ];
-        iData->read( dataSize - 16, buf, 16, iThreadId );
+        ioScratch.resize( dataSize - 16 );
+        Util::uint32_t * buf =
+            reinterpret_cast< Util::uint32_t * >( &( ioScratch.front() ) );
+        iData.read( dataSize - 16, buf, 16, iThreadId );
+
+        if ( iStats )
+        {
+            decodeStart = Util::Timer::now();
+        }
 
         std::size_t strPos = 0;
 
@@ -1377,55 +1441,163 @@ ReadData( void * iIntoLocation,
             }
         }
 
-        delete [] buf;
+        if ( iStats )
+        {
+            decodeTime = Util::Timer::now() - decodeStart;
+        }
     }
-    else if ( iAsPod == curPod )
+    else
     {
-        // don't read the key
-        iData->read( dataSize - 16, iIntoLocation, 16, iThreadId );
+        // - 16 to skip the key
+        decodeTime = ReadPODs( iIntoLocation, iData, iThreadId, curPod,
+                               iAsPod, 16, dataSize - 16, ioScratch,
+                               iStats != NULL );
     }
-    else if ( PODNumBytes( curPod ) <= PODNumBytes( iAsPod ) )
+
+    if ( iStats )
     {
-        // - 16 to skip key
-        std::size_t numBytes = dataSize - 16;
-        iData->read( numBytes, iIntoLocation, 16, iThreadId );
+        iStats->addDecoded( decodeTime );
+    }
+}
 
-        char * buf = static_cast< char * >( iIntoLocation );
-        ConvertData( curPod, iAsPod, buf, iIntoLocation, numBytes );
+//-*****************************************************************************
+void
+ReadDataRange( void * iIntoLocation,
+               Ogawa::IData & iData,
+               size_t iThreadId,
+               const AbcA::DataType &iDataType,
+               Util::PlainOldDataType iAsPod,
+               std::size_t iStart,
+               std::size_t iCount,
+               std::vector< char > & ioScratch,
+               ReadStats * iStats )
+{
+    Alembic::Util::PlainOldDataType curPod = iDataType.getPod();
+    ABCA_ASSERT( ( iAsPod == curPod ) || (
+        iAsPod != Alembic::Util::kStringPOD &&
+        iAsPod != Alembic::Util::kWstringPOD &&
+        curPod != Alembic::Util::kStringPOD &&
+        curPod != Alembic::Util::kWstringPOD ),
+        "Cannot convert the data to or from a string, or wstring." );
 
+    if ( iCount == 0 )
+    {
+        return;
     }
-    else if ( PODNumBytes( curPod ) > PODNumBytes( iAsPod ) )
+
+    std::size_t dataSize = iData.getSize();
+    std::size_t extent = iDataType.getExtent();
+    double decodeTime = 0.0;
+
+    if ( curPod == Alembic::Util::kStringPOD ||
+         curPod == Alembic::Util::kWstringPOD )
     {
-        // - 16 to skip key
-        std::size_t numBytes = dataSize - 16;
+        // strings have no fixed size, so walk the whole thing and only keep
+        // the ones in the range
+        std::size_t charSize = ( curPod == Alembic::Util::kStringPOD ) ?
+            1 : 4;
+        std::size_t numChars = dataSize > 16 ? ( dataSize - 16 ) / charSize : 0;
+        std::size_t first = iStart * extent;
+        std::size_t last = first + iCount * extent;
+
+        ioScratch.resize( numChars * charSize + 1 );
+        if ( numChars > 0 )
+        {
+            iData.read( numChars * charSize, &( ioScratch.front() ), 16,
+                        iThreadId );
+        }
 
-        // read into a temporary buffer and cast them one at a time
-        char * buf = new char[ numBytes ];
-        iData->read( numBytes, buf, 16, iThreadId );
+        double decodeStart = iStats ? Util::Timer::now() : 0.0;
 
-        ConvertData( curPod, iAsPod, buf, iIntoLocation, numBytes );
+        std::size_t strPos = 0;
+        std::size_t startChar = 0;
+        for ( std::size_t i = 0; i < numChars && strPos < last; ++i )
+        {
+            bool isEnd = false;
+            if ( charSize == 1 )
+            {
+                isEnd = ioScratch[i] == 0;
+            }
+            else
+            {
+                isEnd = reinterpret_cast< Util::uint32_t * >(
+                    &( ioScratch.front() ) )[i] == 0;
+            }
+
+            if ( !isEnd )
+            {
+                continue;
+            }
 
-        delete [] buf;
+            if ( strPos >= first && charSize == 1 )
+            {
+                reinterpret_cast< std::string * >( iIntoLocation )[
+                    strPos - first ] = &( ioScratch[ startChar ] );
+            }
+            else if ( strPos >= first )
+            {
+                const Util::uint32_t * chars =
+                    reinterpret_cast< Util::uint32_t * >(
+                        &( ioScratch.front() ) );
+                std::wstring & wstr = reinterpret_cast< std::wstring * >(
+                    iIntoLocation )[ strPos - first ];
+                wstr.clear();
+                for ( std::size_t j = startChar; j < i; ++j )
+                {
+                    wstr.push_back( chars[j] );
+                }
+            }
+
+            startChar = i + 1;
+            ++strPos;
+        }
+
+        ABCA_ASSERT( strPos >= last, "Range is outside of the sample." );
+
+        if ( iStats )
+        {
+            decodeTime = Util::Timer::now() - decodeStart;
+        }
     }
+    else
+    {
+        std::size_t elementBytes = PODNumBytes( curPod ) * extent;
+        std::size_t offset = 16 + iStart * elementBytes;
+        std::size_t numBytes = iCount * elementBytes;
+
+        ABCA_ASSERT( dataSize >= 16 && offset + numBytes <= dataSize,
+                     "Range is outside of the sample." );
 
+        decodeTime = ReadPODs( iIntoLocation, iData, iThreadId, curPod,
+                               iAsPod, offset, numBytes, ioScratch,
+                               iStats != NULL );
+    }
+
+    if ( iStats )
+    {
+        iStats->addDecoded( decodeTime );
+    }
 }
 
 //-*****************************************************************************
 void
-ReadArraySample( Ogawa::IDataPtr iDims,
-                 Ogawa::IDataPtr iData,
+ReadArraySample( Ogawa::IData & iDims,
+                 Ogawa::IData & iData,
                  size_t iThreadId,
                  const AbcA::DataType &iDataType,
-                 AbcA::ArraySamplePtr &oSample )
+                 AbcA::ArraySamplePtr &oSample,
+                 std::vector< char > & ioScratch,
+                 ReadStats * iStats,
+                 const AbcA::ArraySampleAllocatorPtr & iAllocator )
 {
     // get our dimensions
     Util::Dimensions dims;
     ReadDimensions( iDims, iData, iThreadId, iDataType, dims );
 
-    oSample = AbcA::AllocateArraySample( iDataType, dims );
+    oSample = AbcA::AllocateArraySample( iDataType, dims, iAllocator );
 
     ReadData( const_cast<void*>( oSample->getData() ), iData,
-        iThreadId, iDataType, iDataType.getPod() );
+        iThreadId, iDataType, iDataType.getPod(), ioScratch, iStats );
 
 }
 
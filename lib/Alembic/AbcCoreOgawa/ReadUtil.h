@@ -38,6 +38,7 @@
 #define _Alembic_AbcCoreOgawa_ReadUtil_h_
 
 #include <Alembic/AbcCoreOgawa/Foundation.h>
+#include <Alembic/AbcCoreOgawa/ReadStats.h>
 
 namespace Alembic {
 namespace AbcCoreOgawa {
@@ -50,27 +51,52 @@ namespace ALEMBIC_VERSION_NS {
 
 //-*****************************************************************************
 void
-ReadDimensions( Ogawa::IDataPtr iDims,
-                Ogawa::IDataPtr iData,
+ReadDimensions( Ogawa::IData & iDims,
+                Ogawa::IData & iData,
                 size_t iThreadId,
                 const AbcA::DataType &iDataType,
                 Util::Dimensions & oDim );
 
 //-*****************************************************************************
+// ioScratch holds the raw data when it has to be converted or unpacked, so
+// that it can be reused from one read to the next.
+// iStats, when not NULL, is handed the decoded sample and the time spent
+// converting or unpacking it.
 void
 ReadData( void * iIntoLocation,
-          Ogawa::IDataPtr iData,
+          Ogawa::IData & iData,
           size_t iThreadId,
           const AbcA::DataType &iDataType,
-          Util::PlainOldDataType iAsPod );
+          Util::PlainOldDataType iAsPod,
+          std::vector< char > & ioScratch,
+          ReadStats * iStats = NULL );
 
 //-*****************************************************************************
+// Like ReadData, but only reads iCount elements of iDataType starting at
+// element iStart.  Only the requested bytes are read, except for strings
+// and wstrings which have to be walked from the start.
 void
-ReadArraySample( Ogawa::IDataPtr iDims,
-                 Ogawa::IDataPtr iData,
+ReadDataRange( void * iIntoLocation,
+               Ogawa::IData & iData,
+               size_t iThreadId,
+               const AbcA::DataType &iDataType,
+               Util::PlainOldDataType iAsPod,
+               std::size_t iStart,
+               std::size_t iCount,
+               std::vector< char > & ioScratch,
+               ReadStats * iStats = NULL );
+
+//-*****************************************************************************
+void
+ReadArraySample( Ogawa::IData & iDims,
+                 Ogawa::IData & iData,
                  size_t iThreadId,
                  const AbcA::DataType &iDataType,
-                 AbcA::ArraySamplePtr &oSample );
+                 AbcA::ArraySamplePtr &oSample,
+                 std::vector< char > & ioScratch,
+                 ReadStats * iStats = NULL,
+                 const AbcA::ArraySampleAllocatorPtr & iAllocator =
+                     AbcA::ArraySampleAllocatorPtr() );
 
 //-*****************************************************************************
 void
@@ -72,17 +72,31 @@ WriteArchive::operator()( std::ostream * iStream,
 ReadArchive::ReadArchive()
 {
     m_numStreams = 1;
+    m_maxStreams = 1;
+    m_policy = kFallbackStreamPolicy;
 }
 
 //-*****************************************************************************
 ReadArchive::ReadArchive( size_t iNumStreams )
 {
     m_numStreams = iNumStreams;
+    m_maxStreams = iNumStreams;
+    m_policy = kFallbackStreamPolicy;
+}
+
+//-*****************************************************************************
+ReadArchive::ReadArchive( size_t iNumStreams, size_t iMaxStreams,
+                          StreamPolicy iPolicy )
+{
+    m_numStreams = iNumStreams;
+    m_maxStreams = iMaxStreams;
+    m_policy = iPolicy;
 }
 
 //-*****************************************************************************
 ReadArchive::ReadArchive( const std::vector< std::istream * > & iStreams )
-    : m_numStreams( 1 ), m_streams( iStreams )
+    : m_numStreams( 1 ), m_maxStreams( 1 ),
+      m_policy( kFallbackStreamPolicy ), m_streams( iStreams )
 {
 }
 
@@ -95,7 +109,8 @@ ReadArchive::operator()( const std::string &iFileName ) const
     if ( m_streams.empty() )
     {
         archivePtr = Alembic::Util::shared_ptr<ArImpl>(
-            new ArImpl( iFileName, m_numStreams ) );
+            new ArImpl( iFileName, m_numStreams, m_maxStreams,
+                        m_policy ) );
     }
     else
     {
@@ -116,7 +131,8 @@ ReadArchive::operator()( const std::string &iFileName,
     if ( m_streams.empty() )
     {
         archivePtr = Alembic::Util::shared_ptr<ArImpl> (
-            new ArImpl( iFileName, m_numStreams ) );
+            new ArImpl( iFileName, m_numStreams, m_maxStreams,
+                        m_policy ) );
     }
     else
     {
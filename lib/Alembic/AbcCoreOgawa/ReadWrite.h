@@ -45,6 +45,12 @@ namespace ALEMBIC_VERSION_NS {
 
 //-*****************************************************************************
 //! Will return a shared pointer to the archive writer
+//! Different objects, and different properties, of the archive may be
+//! created and written from different threads at the same time, including
+//! children of the same parent and time samplings added along the way.
+//! A single object or property must still only be used by one thread at a
+//! time, and the last references should be let go of from one thread so the
+//! archive is closed once everything else is done.
 class WriteArchive
 {
 public:
@@ -59,6 +65,18 @@ public:
                 const ::Alembic::AbcCoreAbstract::MetaData &iMetaData ) const;
 };
 
+//-*****************************************************************************
+//! What a reader does when every stream of the archive is in use, and no
+//! more can be opened.
+enum StreamPolicy
+{
+    //! Share the first stream, readers that land on it take turns at it.
+    kFallbackStreamPolicy,
+
+    //! Block until another reader is done with its stream.
+    kWaitStreamPolicy
+};
+
 //-*****************************************************************************
 //! Will return a shared pointer to the archive reader
 //! This version creates a cache associated with the archive.
@@ -70,6 +88,12 @@ public:
     // Open the file iNumStreams times and manage them internally
     ReadArchive( size_t iNumStreams );
 
+    // Open the file iNumStreams times, and open it again as readers contend
+    // for the streams, up to iMaxStreams times.  Once that many are in use
+    // iPolicy decides whether readers share the first stream or wait.
+    ReadArchive( size_t iNumStreams, size_t iMaxStreams,
+                 StreamPolicy iPolicy );
+
     // Read from the provided streams, we do not own these, expect them
     // to remain open and all have the same data in them, and do not try to
     // delete them
@@ -87,6 +111,8 @@ public:
 
 private:
     size_t m_numStreams;
+    size_t m_maxStreams;
+    StreamPolicy m_policy;
     std::vector< std::istream * > m_streams;
 };
 
@@ -0,0 +1,419 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreOgawa/Repack.h>
+#include <Alembic/AbcCoreOgawa/Foundation.h>
+#include <Alembic/AbcCoreOgawa/ReadWrite.h>
+
+#include <algorithm>
+#include <set>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+//-*****************************************************************************
+// somewhere a scalar sample can be read into and written from
+class ScalarBuffer
+{
+public:
+    ScalarBuffer( const AbcA::DataType & iDataType )
+      : m_pod( iDataType.getPod() )
+    {
+        if ( m_pod == Alembic::Util::kStringPOD )
+        {
+            m_strings.resize( iDataType.getExtent() );
+        }
+        else if ( m_pod == Alembic::Util::kWstringPOD )
+        {
+            m_wstrings.resize( iDataType.getExtent() );
+        }
+        else
+        {
+            m_bytes.resize( iDataType.getNumBytes() );
+        }
+    }
+
+    void * get()
+    {
+        if ( m_pod == Alembic::Util::kStringPOD )
+        {
+            return &m_strings.front();
+        }
+        else if ( m_pod == Alembic::Util::kWstringPOD )
+        {
+            return &m_wstrings.front();
+        }
+        return &m_bytes.front();
+    }
+
+private:
+    Alembic::Util::PlainOldDataType m_pod;
+    std::vector< char > m_bytes;
+    std::vector< std::string > m_strings;
+    std::vector< std::wstring > m_wstrings;
+};
+
+//-*****************************************************************************
+// an array or scalar property being copied or played back
+struct Property
+{
+    Property( AbcA::ArrayPropertyReaderPtr iReader )
+      : arrayReader( iReader )
+      , timeSampling( iReader->getTimeSampling() )
+      , numSamples( iReader->getNumSamples() )
+      , isConstant( iReader->isConstant() )
+      , lastIndex( -1 ) {}
+
+    Property( AbcA::ScalarPropertyReaderPtr iReader )
+      : scalarReader( iReader )
+      , timeSampling( iReader->getTimeSampling() )
+      , numSamples( iReader->getNumSamples() )
+      , isConstant( iReader->isConstant() )
+      , lastIndex( -1 ) {}
+
+    AbcA::ArrayPropertyReaderPtr arrayReader;
+    AbcA::ScalarPropertyReaderPtr scalarReader;
+    AbcA::ArrayPropertyWriterPtr arrayWriter;
+    AbcA::ScalarPropertyWriterPtr scalarWriter;
+
+    AbcA::TimeSamplingPtr timeSampling;
+    std::size_t numSamples;
+    bool isConstant;
+
+    // the sample read on the previous frame of playback
+    index_t lastIndex;
+};
+
+//-*****************************************************************************
+// one sample to write, ordered by when it is
+struct SampleWrite
+{
+    SampleWrite( chrono_t iTime, std::size_t iProperty, index_t iIndex )
+      : time( iTime ), property( iProperty ), index( iIndex ) {}
+
+    bool operator<( const SampleWrite & iRhs ) const
+    {
+        return time < iRhs.time;
+    }
+
+    chrono_t time;
+    std::size_t property;
+    index_t index;
+};
+
+//-*****************************************************************************
+// the writers which have to stay open until every sample is written
+struct Writers
+{
+    std::vector< AbcA::ObjectWriterPtr > objects;
+    std::vector< AbcA::CompoundPropertyWriterPtr > compounds;
+};
+
+//-*****************************************************************************
+void CollectProperties( AbcA::CompoundPropertyReaderPtr iIn,
+                        AbcA::CompoundPropertyWriterPtr iOut,
+                        AbcA::ArchiveWriterPtr iArchive,
+                        std::vector< Property > & oProps,
+                        Writers & oWriters )
+{
+    for ( std::size_t i = 0; i < iIn->getNumProperties(); ++i )
+    {
+        const AbcA::PropertyHeader & header = iIn->getPropertyHeader( i );
+
+        if ( header.isCompound() )
+        {
+            AbcA::CompoundPropertyWriterPtr out;
+            if ( iOut )
+            {
+                out = iOut->createCompoundProperty( header.getName(),
+                                                    header.getMetaData() );
+                oWriters.compounds.push_back( out );
+            }
+            CollectProperties( iIn->getCompoundProperty( header.getName() ),
+                               out, iArchive, oProps, oWriters );
+            continue;
+        }
+
+        if ( header.isArray() )
+        {
+            oProps.push_back( Property(
+                iIn->getArrayProperty( header.getName() ) ) );
+        }
+        else
+        {
+            oProps.push_back( Property(
+                iIn->getScalarProperty( header.getName() ) ) );
+        }
+
+        if ( !iOut )
+        {
+            continue;
+        }
+
+        // hands back the index it already has if it was copied up front
+        Alembic::Util::uint32_t tsIndex =
+            iArchive->addTimeSampling( *header.getTimeSampling() );
+
+        Property & prop = oProps.back();
+        if ( header.isArray() )
+        {
+            prop.arrayWriter = iOut->createArrayProperty( header.getName(),
+                header.getMetaData(), header.getDataType(), tsIndex );
+        }
+        else
+        {
+            prop.scalarWriter = iOut->createScalarProperty( header.getName(),
+                header.getMetaData(), header.getDataType(), tsIndex );
+        }
+    }
+}
+
+//-*****************************************************************************
+// walks iIn depth first, copying the hierarchy to iOut if it is given
+void CollectObjects( AbcA::ObjectReaderPtr iIn,
+                     AbcA::ObjectWriterPtr iOut,
+                     AbcA::ArchiveWriterPtr iArchive,
+                     std::vector< Property > & oProps,
+                     Writers & oWriters )
+{
+    AbcA::CompoundPropertyWriterPtr props;
+    if ( iOut )
+    {
+        props = iOut->getProperties();
+        oWriters.compounds.push_back( props );
+    }
+
+    CollectProperties( iIn->getProperties(), props, iArchive, oProps,
+                       oWriters );
+
+    for ( std::size_t i = 0; i < iIn->getNumChildren(); ++i )
+    {
+        AbcA::ObjectWriterPtr child;
+        if ( iOut )
+        {
+            child = iOut->createChild( iIn->getChildHeader( i ) );
+            oWriters.objects.push_back( child );
+        }
+        CollectObjects( iIn->getChild( i ), child, iArchive, oProps,
+                        oWriters );
+    }
+}
+
+//-*****************************************************************************
+void ReadSample( Property & iProp, index_t iIndex, ScalarBuffer * iBuffer,
+                 AbcA::ArraySamplePtr & oSample )
+{
+    if ( iProp.arrayReader )
+    {
+        iProp.arrayReader->getSample( iIndex, oSample );
+    }
+    else
+    {
+        iProp.scalarReader->getSample( iIndex, iBuffer->get() );
+    }
+}
+
+} // End namespace
+
+//-*****************************************************************************
+void RepackArchive( AbcA::ArchiveReaderPtr iArchive,
+                    const std::string & iFileName,
+                    const RepackOptions & iOptions )
+{
+    ABCA_ASSERT( iArchive, "Can't repack an empty archive" );
+    ABCA_ASSERT( iArchive->getName() != iFileName,
+                 "Can't repack an archive onto itself: " << iFileName );
+
+    AbcA::ArchiveWriterPtr archive =
+        WriteArchive()( iFileName, iArchive->getMetaData() );
+
+    // copy the time samplings up front, so they keep their indices
+    for ( Alembic::Util::uint32_t i = 1; i < iArchive->getNumTimeSamplings();
+          ++i )
+    {
+        archive->addTimeSampling( *iArchive->getTimeSampling( i ) );
+    }
+
+    std::vector< Property > props;
+    Writers writers;
+    CollectObjects( iArchive->getTop(), archive->getTop(), archive, props,
+                    writers );
+
+    std::vector< SampleWrite > constants;
+    std::vector< SampleWrite > frames;
+    for ( std::size_t i = 0; i < props.size(); ++i )
+    {
+        std::vector< SampleWrite > & writes =
+            ( iOptions.constantsFirst && props[i].isConstant ) ?
+            constants : frames;
+
+        for ( std::size_t j = 0; j < props[i].numSamples; ++j )
+        {
+            writes.push_back( SampleWrite(
+                props[i].timeSampling->getSampleTime( j ), i, j ) );
+        }
+    }
+
+    // samples of the same time stay in hierarchy order
+    std::stable_sort( frames.begin(), frames.end() );
+    frames.insert( frames.begin(), constants.begin(), constants.end() );
+
+    for ( std::size_t i = 0; i < frames.size(); ++i )
+    {
+        Property & prop = props[ frames[i].property ];
+        if ( prop.arrayWriter )
+        {
+            AbcA::ArraySamplePtr sample;
+            ReadSample( prop, frames[i].index, NULL, sample );
+            prop.arrayWriter->setSample( *sample );
+        }
+        else
+        {
+            ScalarBuffer buffer( prop.scalarWriter->getDataType() );
+            AbcA::ArraySamplePtr unused;
+            ReadSample( prop, frames[i].index, &buffer, unused );
+            prop.scalarWriter->setSample( buffer.get() );
+        }
+    }
+
+    // close the writers from the leaves up, the archive last
+    props.clear();
+    while ( !writers.compounds.empty() )
+    {
+        writers.compounds.pop_back();
+    }
+    while ( !writers.objects.empty() )
+    {
+        writers.objects.pop_back();
+    }
+}
+
+//-*****************************************************************************
+PlaybackStats MeasurePlayback( AbcA::ArchiveReaderPtr iArchive )
+{
+    ABCA_ASSERT( iArchive, "Can't play back an empty archive" );
+
+    std::vector< Property > props;
+    Writers unused;
+    CollectObjects( iArchive->getTop(), AbcA::ObjectWriterPtr(),
+                    AbcA::ArchiveWriterPtr(), props, unused );
+
+    // every time any property has a sample at is a frame
+    std::set< chrono_t > times;
+    for ( std::size_t i = 0; i < props.size(); ++i )
+    {
+        std::size_t numSamples = props[i].isConstant ?
+            std::min< std::size_t >( props[i].numSamples, 1 ) :
+            props[i].numSamples;
+
+        for ( std::size_t j = 0; j < numSamples; ++j )
+        {
+            times.insert( props[i].timeSampling->getSampleTime( j ) );
+        }
+    }
+
+    // only the sample reads are measured, not opening the hierarchy
+    iArchive->setStatsEnabled( true );
+    iArchive->resetStats();
+
+    PlaybackStats stats;
+    for ( std::set< chrono_t >::iterator t = times.begin();
+          t != times.end(); ++t )
+    {
+        for ( std::size_t i = 0; i < props.size(); ++i )
+        {
+            Property & prop = props[i];
+            if ( prop.numSamples == 0 )
+            {
+                continue;
+            }
+
+            index_t index = 0;
+            if ( !prop.isConstant )
+            {
+                index = prop.timeSampling->getFloorIndex( *t,
+                    prop.numSamples ).first;
+            }
+
+            if ( index == prop.lastIndex )
+            {
+                continue;
+            }
+
+            AbcA::ArraySamplePtr sample;
+            if ( prop.arrayReader )
+            {
+                ReadSample( prop, index, NULL, sample );
+            }
+            else
+            {
+                ScalarBuffer buffer(
+                    prop.scalarReader->getHeader().getDataType() );
+                ReadSample( prop, index, &buffer, sample );
+            }
+
+            prop.lastIndex = index;
+            stats.numSamples ++;
+        }
+        stats.numFrames ++;
+    }
+
+    AbcA::ArchiveStats archiveStats;
+    if ( iArchive->getStats( archiveStats ) )
+    {
+        for ( std::size_t i = 0; i < archiveStats.streams.size(); ++i )
+        {
+            const AbcA::ArchiveStats::Stream & stream =
+                archiveStats.streams[i];
+            stats.numReads += stream.numReads;
+            stats.bytesRead += stream.bytesRead;
+            stats.numSeeks += stream.numSeeks;
+            stats.seekDistance += stream.seekDistance;
+        }
+    }
+
+    iArchive->resetStats();
+    iArchive->setStatsEnabled( false );
+
+    return stats;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
@@ -0,0 +1,102 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcCoreOgawa_Repack_h_
+#define _Alembic_AbcCoreOgawa_Repack_h_
+
+#include <Alembic/AbcCoreAbstract/All.h>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! How RepackArchive lays out the copy.
+struct RepackOptions
+{
+    RepackOptions() : constantsFirst( true ) {}
+
+    //! Whether the samples of properties which never change are all written
+    //! ahead of the first frame, rather than with the frame they start on.
+    bool constantsFirst;
+};
+
+//-*****************************************************************************
+//! What reading an archive back one frame at a time cost, see
+//! MeasurePlayback.
+struct PlaybackStats
+{
+    PlaybackStats()
+      : numFrames( 0 ), numSamples( 0 ), numReads( 0 ), bytesRead( 0 ),
+        numSeeks( 0 ), seekDistance( 0 ) {}
+
+    Alembic::Util::uint64_t numFrames;
+    Alembic::Util::uint64_t numSamples;
+    Alembic::Util::uint64_t numReads;
+    Alembic::Util::uint64_t bytesRead;
+    Alembic::Util::uint64_t numSeeks;
+    Alembic::Util::uint64_t seekDistance;
+};
+
+//-*****************************************************************************
+//! Copies iArchive, which may be of any implementation, into a new Ogawa
+//! archive at iFileName with the sample data laid out time major.  Ogawa
+//! writes sample data in the order it is set, which for most writers means
+//! every sample of one object before the next, so playing back a frame
+//! jumps all over the file.  The copy writes every sample at a time before
+//! any sample at a later time, so each frame's data is together.
+//! The hierarchy, metadata and time samplings are copied as they are.
+void RepackArchive( AbcCoreAbstract::ArchiveReaderPtr iArchive,
+                    const std::string & iFileName,
+                    const RepackOptions & iOptions = RepackOptions() );
+
+//-*****************************************************************************
+//! Reads iArchive the way playback would: a frame at a time for every time
+//! a sample is at, each frame reading the samples which changed since the
+//! previous frame.  The hierarchy is walked once up front to find the
+//! properties, and that isn't measured.  Returns what reading the frames
+//! cost, the reads and seeks are only filled in for implementations which
+//! gather statistics.  Statistics are reset, and left off, by this.
+PlaybackStats MeasurePlayback( AbcCoreAbstract::ArchiveReaderPtr iArchive );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
+
+#endif
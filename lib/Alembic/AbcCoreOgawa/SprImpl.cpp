@@ -35,6 +35,7 @@
 //-*****************************************************************************
 
 #include <Alembic/AbcCoreOgawa/SprImpl.h>
+#include <Alembic/AbcCoreOgawa/ReadContextImpl.h>
 #include <Alembic/AbcCoreOgawa/ReadUtil.h>
 #include <Alembic/AbcCoreOgawa/StreamManager.h>
 #include <Alembic/AbcCoreOgawa/OrImpl.h>
@@ -61,6 +62,9 @@ SprImpl::SprImpl( AbcA::CompoundPropertyReaderPtr iParent,
         ABCA_THROW( "Attempted to create a ScalarPropertyReader from a "
                     "non-array property type" );
     }
+
+    m_archive = dynamic_cast< ArImpl * >( getObject()->getArchive().get() );
+    ABCA_ASSERT( m_archive, "Invalid archive" );
 }
 
 //-*****************************************************************************
@@ -102,16 +106,41 @@ bool SprImpl::isConstant()
 //-*****************************************************************************
 void SprImpl::getSample( index_t iSampleIndex, void * iIntoLocation )
 {
+    getSample( iSampleIndex, iIntoLocation, NULL );
+}
+
+//-*****************************************************************************
+void SprImpl::getSample( index_t iSampleIndex, void * iIntoLocation,
+                         AbcA::ReadContext * iContext )
+{
+    ReadContextImpl * context = ReadContextImpl::get( iContext, m_archive );
+    if ( context == NULL )
+    {
+        // nothing to reuse, so set one up just for this read
+        ReadContextImpl local( m_archive, m_archive->getStreamID() );
+        getSample( iSampleIndex, iIntoLocation, &local );
+        return;
+    }
+
+    ReadContextImpl::Read read( *context );
     size_t index = m_header->verifyIndex( iSampleIndex );
 
-    StreamIDPtr streamId = Alembic::Util::dynamic_pointer_cast< ArImpl,
-        AbcA::ArchiveReader > ( getObject()->getArchive() )->getStreamID();
+    std::size_t id = context->getStreamID();
+    Ogawa::IData & data = context->getData();
+    m_group->getData( index, id, data );
 
-    std::size_t id = streamId->getID();
-    Ogawa::IDataPtr data = m_group->getData( index, id );
     ReadData( iIntoLocation, data, id,
               m_header->header.getDataType(),
-              m_header->header.getDataType().getPod() );
+              m_header->header.getDataType().getPod(),
+              context->getScratch(), m_archive->getEnabledReadStats() );
+}
+
+//-*****************************************************************************
+bool SprImpl::getSampleData( index_t iSampleIndex, ReadContextImpl & iContext,
+                             Ogawa::IData & oData )
+{
+    size_t index = m_header->verifyIndex( iSampleIndex );
+    return m_group->getData( index, iContext.getStreamID(), oData );
 }
 
 //-*****************************************************************************
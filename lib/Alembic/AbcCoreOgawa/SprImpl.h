@@ -43,6 +43,9 @@ namespace Alembic {
 namespace AbcCoreOgawa {
 namespace ALEMBIC_VERSION_NS {
 
+class ArImpl;
+class ReadContextImpl;
+
 //-*****************************************************************************
 // The Scalar Property Reader fills up bytes corresponding to memory for
 // a single scalar sample at a particular index.
@@ -70,6 +73,15 @@ public:
     virtual std::pair<index_t, chrono_t> getCeilIndex( chrono_t iTime );
     virtual std::pair<index_t, chrono_t> getNearIndex( chrono_t iTime );
 
+    virtual void getSample( index_t iSampleIndex,
+                            void * iIntoLocation,
+                            AbcA::ReadContext * iContext );
+
+    // points oData at the block, key followed by data, that the sample is
+    // stored in, returns false if there isn't one
+    bool getSampleData( index_t iSampleIndex, ReadContextImpl & iContext,
+                        Ogawa::IData & oData );
+
 private:
 
     // Parent compound property writer. It must exist.
@@ -81,6 +93,8 @@ private:
     // Stores the PropertyHeader and other info
     PropertyHeaderPtr m_header;
 
+    // The archive we were read from, m_parent keeps it alive
+    ArImpl * m_archive;
 };
 
 } // End namespace ALEMBIC_VERSION_NS
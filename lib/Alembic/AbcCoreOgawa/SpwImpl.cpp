@@ -67,9 +67,6 @@ SpwImpl::~SpwImpl()
 {
     AbcA::ArchiveWriterPtr archive = m_parent->getObject()->getArchive();
 
-    index_t maxSamples = archive->getMaxNumSamplesForTimeSamplingIndex(
-            m_header->timeSamplingIndex );
-
     Util::uint32_t numSamples = m_header->nextSampleIndex;
 
     // a constant property, we wrote the same sample over and over
@@ -78,11 +75,7 @@ SpwImpl::~SpwImpl()
         numSamples = 1;
     }
 
-    if ( maxSamples < numSamples )
-    {
-        archive->setMaxNumSamplesForTimeSamplingIndex(
-            m_header->timeSamplingIndex, numSamples );
-    }
+    UpdateMaxNumSamples( archive, m_header->timeSamplingIndex, numSamples );
 
     Util::SpookyHash hash;
     hash.Init(0, 0);
@@ -159,6 +152,9 @@ void SpwImpl::setSample( const void *iSamp )
             key == m_previousWrittenSampleID->getKey() ) )
     {
 
+        AbcA::ArchiveWriterPtr awp = this->getObject()->getArchive();
+        AbcA::ArchiveStats * stats = GetWriteStats( awp );
+
         // we only need to repeat samples if this is not the first change
         if (m_header->firstChangedIndex != 0)
         {
@@ -167,18 +163,17 @@ void SpwImpl::setSample( const void *iSamp )
                 smpI < m_header->nextSampleIndex; ++smpI )
             {
                 assert( smpI > 0 );
-                CopyWrittenData( m_group, m_previousWrittenSampleID );
+                CopyWrittenData( m_group, m_previousWrittenSampleID, stats );
             }
         }
 
         // Write this sample, which will update its internal
         // cache of what the previously written sample was.
-        AbcA::ArchiveWriterPtr awp = this->getObject()->getArchive();
-
         // Write the sample.
         // This distinguishes between string, wstring, and regular arrays.
         m_previousWrittenSampleID =
-            WriteData( GetWrittenSampleMap( awp ), m_group, samp, key );
+            WriteData( GetWrittenSampleMap( awp ), m_group, samp, key,
+                       stats );
 
         if (m_header->firstChangedIndex == 0)
         {
@@ -35,146 +35,430 @@
 //-*****************************************************************************
 
 #include <Alembic/AbcCoreOgawa/StreamManager.h>
+#include <limits>
+
+#ifndef _MSC_VER
+#include <pthread.h>
+#endif
+
+// use compare and swap to claim and return streams when we can, otherwise
+// m_lock guards the bits
+#if !defined(__APPLE__) && defined(__GNUC__) && ( __GNUC__ > 4 || \
+    ( __GNUC__ == 4 && __GNUC_MINOR__ >= 4 ) )
+#define ALEMBIC_STREAM_CAS
+#endif
+
+// the stream each thread last had, so it can be handed back to it
+#if defined(_MSC_VER)
+#define ALEMBIC_STREAM_TLS __declspec( thread )
+#elif !defined(__APPLE__) && defined(__GNUC__)
+#define ALEMBIC_STREAM_TLS __thread
+#endif
 
 namespace Alembic {
 namespace AbcCoreOgawa {
 namespace ALEMBIC_VERSION_NS {
 
-StreamManager::StreamManager( std::size_t iNumStreams )
+namespace {
+
+#ifdef ALEMBIC_STREAM_TLS
+// the manager this thread was last given a stream by, and the id of that
+// stream, which is only a hint for that manager and not any other
+ALEMBIC_STREAM_TLS const void * g_lastManager = NULL;
+ALEMBIC_STREAM_TLS std::size_t g_lastStreamID = 0;
+#endif
+
+const std::size_t kBitsPerWord = 64;
+
+Alembic::Util::uint64_t StreamBit( std::size_t iStreamID )
+{
+    return Alembic::Util::uint64_t( 1 ) << ( iStreamID % kBitsPerWord );
+}
+
+std::size_t LowestBit( Alembic::Util::uint64_t iWord )
+{
+#ifdef __GNUC__
+    return __builtin_ctzll( iWord );
+#else
+    std::size_t i = 0;
+    while ( !( iWord & 1 ) )
+    {
+        iWord >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+}
+
+//-*****************************************************************************
+#ifdef _MSC_VER
+
+class StreamManager::Waiter : Alembic::Util::noncopyable
+{
+public:
+    Waiter()
+    {
+        m_event = CreateEvent( NULL, FALSE, FALSE, NULL );
+    }
+
+    ~Waiter()
+    {
+        CloseHandle( m_event );
+    }
+
+    // a put() can land between anyFree() and the wait, so don't sleep long
+    void wait( StreamManager * iManager )
+    {
+        if ( !iManager->anyFree() )
+        {
+            WaitForSingleObject( m_event, 1 );
+        }
+    }
+
+    void notify()
+    {
+        SetEvent( m_event );
+    }
+
+private:
+    HANDLE m_event;
+};
+
+#else
+
+class StreamManager::Waiter : Alembic::Util::noncopyable
 {
+public:
+    Waiter() : m_numWaiting( 0 )
+    {
+        pthread_mutex_init( &m_mutex, NULL );
+        pthread_cond_init( &m_cond, NULL );
+    }
+
+    ~Waiter()
+    {
+        pthread_cond_destroy( &m_cond );
+        pthread_mutex_destroy( &m_mutex );
+    }
+
+    // put() frees the stream before it takes m_mutex to notify us, so
+    // checking under m_mutex means we can't miss it
+    void wait( StreamManager * iManager )
+    {
+        pthread_mutex_lock( &m_mutex );
+        if ( !iManager->anyFree() )
+        {
+            m_numWaiting ++;
+            pthread_cond_wait( &m_cond, &m_mutex );
+            m_numWaiting --;
+        }
+        pthread_mutex_unlock( &m_mutex );
+    }
+
+    void notify()
+    {
+        pthread_mutex_lock( &m_mutex );
+        if ( m_numWaiting > 0 )
+        {
+            pthread_cond_signal( &m_cond );
+        }
+        pthread_mutex_unlock( &m_mutex );
+    }
 
-    m_streams = 0;
-    m_curStream = 0;
-    m_numStreams = iNumStreams;
+private:
+    pthread_mutex_t m_mutex;
+    pthread_cond_t m_cond;
+    std::size_t m_numWaiting;
+};
+
+#endif
+
+//-*****************************************************************************
+StreamManager::StreamManager( std::size_t iNumStreams,
+                              std::size_t iMaxStreams,
+                              StreamPolicy iPolicy,
+                              Ogawa::IArchive * iArchive )
+    : m_numStreams( iNumStreams )
+    , m_maxStreams( iNumStreams )
+    , m_numReserved( 0 )
+    , m_policy( iPolicy )
+    , m_archive( iArchive )
+    , m_waiter( NULL )
+    , m_numFallbacks( 0 )
+{
+    // we can only grow if we've been given something to grow
+    if ( m_archive != NULL && iMaxStreams > iNumStreams )
+    {
+        m_maxStreams = iMaxStreams;
+    }
 
     // only do this if we have more than 1 stream
     // otherwise we can just return default
-    if ( iNumStreams > 1 )
+    if ( m_maxStreams > 1 )
     {
-        m_streamIDs.resize( m_numStreams );
+        m_free.resize( ( m_maxStreams + MAX_RESERVED_STREAMS +
+                         kBitsPerWord - 1 ) / kBitsPerWord, 0 );
         for ( std::size_t i = 0; i < m_numStreams; ++i )
         {
-            m_streamIDs[i] = i;
-            if ( m_numStreams < sizeof(m_streams) * 8 )
-            {
-                m_streams |= 1 << i;
-            }
+            m_free[ i / kBitsPerWord ] |= StreamBit( i );
+        }
+
+        if ( m_policy == kWaitStreamPolicy )
+        {
+            m_waiter = new Waiter();
         }
     }
 
     m_default = StreamIDPtr( new StreamID( NULL, 0 ) );
 }
 
+//-*****************************************************************************
 StreamManager::~StreamManager()
 {
+    delete m_waiter;
 }
 
-#if !defined(__APPLE__) && defined(__GNUC__) && __GNUC__ >= 4 && __GNUC_MINOR__ >= 4
-
+//-*****************************************************************************
 StreamIDPtr StreamManager::get()
 {
-
-    if ( m_numStreams < 2 )
+    if ( m_free.empty() )
     {
         return m_default;
     }
 
-    // we've got too many streams so use the locking version
-    if ( m_numStreams > sizeof(m_streams) * 8 )
+    // an invalid id if this thread hasn't had one from us yet
+    std::size_t hint = std::numeric_limits< std::size_t >::max();
+#ifdef ALEMBIC_STREAM_TLS
+    if ( g_lastManager == this )
     {
-        Alembic::Util::scoped_lock l( m_lock );
+        hint = g_lastStreamID;
+    }
+#endif
 
-        // we've used up more than we have, just return the default
-        if ( m_curStream >= m_numStreams )
+    std::size_t streamID = 0;
+    while ( !take( hint, streamID ) && !grow( streamID ) )
+    {
+        if ( m_policy == kFallbackStreamPolicy )
         {
+#ifdef ALEMBIC_STREAM_CAS
+            __sync_fetch_and_add( &m_numFallbacks, 1 );
+#else
+            Alembic::Util::scoped_lock l( m_lock );
+            m_numFallbacks ++;
+#endif
             return m_default;
         }
 
-        return StreamIDPtr( new StreamID( this,
-            m_streamIDs[ m_curStream ++ ] ) );
+        m_waiter->wait( this );
+    }
+
+#ifdef ALEMBIC_STREAM_TLS
+    g_lastManager = this;
+    g_lastStreamID = streamID;
+#endif
+
+    return StreamIDPtr( new StreamID( this, streamID ) );
+}
+
+//-*****************************************************************************
+bool StreamManager::pin( std::size_t & oStreamID )
+{
+    if ( m_free.empty() )
+    {
+        return false;
+    }
+
+    std::size_t hint = std::numeric_limits< std::size_t >::max();
+#ifdef ALEMBIC_STREAM_TLS
+    if ( g_lastManager == this )
+    {
+        hint = g_lastStreamID;
     }
+#endif
 
-    // CAS (compare and swap) non locking version
-    Alembic::Util::int64_t val = 0;
-    Alembic::Util::int64_t oldVal = 0;
-    Alembic::Util::int64_t newVal = 0;
+    return take( hint, oStreamID, true ) || grow( oStreamID );
+}
+
+//-*****************************************************************************
+bool StreamManager::take( std::size_t iHint, std::size_t & oStreamID,
+                          bool iSkipFirst )
+{
+    std::size_t numStreams = m_numStreams;
+    std::size_t numWords = ( numStreams + kBitsPerWord - 1 ) / kBitsPerWord;
+    std::size_t firstWord = 0;
 
-    do
+    if ( iHint < numStreams && !( iSkipFirst && iHint == 0 ) )
     {
-        oldVal = m_streams;
-        val = ffsll( oldVal );
+        firstWord = iHint / kBitsPerWord;
+        if ( claim( firstWord, StreamBit( iHint ), oStreamID ) )
+        {
+            return true;
+        }
+    }
 
-        if ( val == 0 )
+    // start from the hint, so that threads coming back for a stream spread
+    // out over the words instead of all fighting over the first one
+    for ( std::size_t i = 0; i < numWords; ++i )
+    {
+        std::size_t word = ( firstWord + i ) % numWords;
+        Alembic::Util::uint64_t mask = ~Alembic::Util::uint64_t( 0 );
+        if ( iSkipFirst && word == 0 )
         {
-            return m_default;
+            mask &= ~StreamBit( 0 );
         }
 
-        newVal = oldVal & ~( 1 << (val - 1) );
+        if ( claim( word, mask, oStreamID ) )
+        {
+            return true;
+        }
     }
-    while ( !__sync_bool_compare_and_swap( &m_streams, oldVal, newVal ) );
 
-    return StreamIDPtr( new StreamID( this, ( std::size_t ) val - 1 ) );
+    return false;
 }
 
-void StreamManager::put( std::size_t iStreamID )
+//-*****************************************************************************
+bool StreamManager::claim( std::size_t iWord, Alembic::Util::uint64_t iMask,
+                           std::size_t & oStreamID )
 {
+#ifdef ALEMBIC_STREAM_CAS
+    Alembic::Util::uint64_t oldVal = m_free[iWord];
+    while ( oldVal & iMask )
+    {
+        std::size_t bit = LowestBit( oldVal & iMask );
+        Alembic::Util::uint64_t newVal =
+            oldVal & ~( Alembic::Util::uint64_t( 1 ) << bit );
+
+        Alembic::Util::uint64_t curVal =
+            __sync_val_compare_and_swap( &m_free[iWord], oldVal, newVal );
+
+        if ( curVal == oldVal )
+        {
+            oStreamID = iWord * kBitsPerWord + bit;
+            return true;
+        }
 
-    // we've got too many streams so use the locking version
-    if ( m_numStreams > sizeof(m_streams) * 8 )
+        oldVal = curVal;
+    }
+
+    return false;
+#else
+    Alembic::Util::scoped_lock l( m_lock );
+
+    Alembic::Util::uint64_t val = m_free[iWord] & iMask;
+    if ( val == 0 )
     {
-        // shouldn't ever hit this case, it's why we have m_default
-        assert( iStreamID < m_numStreams && m_curStream > 0 );
+        return false;
+    }
 
-        Alembic::Util::scoped_lock l( m_lock );
-        m_streamIDs[ --m_curStream ] = iStreamID;
-        return;
+    std::size_t bit = LowestBit( val );
+    m_free[iWord] &= ~( Alembic::Util::uint64_t( 1 ) << bit );
+    oStreamID = iWord * kBitsPerWord + bit;
+    return true;
+#endif
+}
+
+//-*****************************************************************************
+bool StreamManager::grow( std::size_t & oStreamID )
+{
+    // reserve counts a stream as reserved before it counts it at all, so
+    // reading them in this order never sees too few reserved
+    std::size_t numReserved = m_numReserved;
+    if ( m_numStreams - numReserved >= m_maxStreams )
+    {
+        return false;
     }
 
-    // CAS (compare and swap) non locking version
-    Alembic::Util::int64_t oldVal = 0;
-    Alembic::Util::int64_t newVal = 0;
+    Alembic::Util::scoped_lock l( m_growLock );
 
-    do
+    // someone else may have grown us all the way while we waited on the lock
+    std::size_t numStreams = m_numStreams;
+    if ( numStreams - m_numReserved >= m_maxStreams )
     {
-        oldVal = m_streams;
-        newVal = oldVal | ( 1 << iStreamID );
+        return false;
+    }
 
+    if ( !m_archive->addStream() )
+    {
+        // don't keep trying
+        m_maxStreams = numStreams - m_numReserved;
+        return false;
     }
-    while ( !__sync_bool_compare_and_swap( &m_streams, oldVal, newVal ) );
-}
 
-#else
+    assert( m_archive->getNumStreams() == numStreams + 1 );
 
-StreamIDPtr StreamManager::get()
+    // the new stream is ours, so its bit stays clear until we put it back
+    oStreamID = numStreams;
+    m_numStreams = numStreams + 1;
+    return true;
+}
+
+//-*****************************************************************************
+bool StreamManager::reserve( std::size_t & oStreamID )
 {
-    // no need to lock
-    if ( m_streamIDs.empty() )
+    if ( m_archive == NULL )
     {
-        return m_default;
+        return false;
     }
 
-    Alembic::Util::scoped_lock l( m_lock );
+    Alembic::Util::scoped_lock l( m_growLock );
 
-    // we've used up more than we have, just return the default
-    if ( m_curStream >= m_numStreams )
+    std::size_t numStreams = m_numStreams;
+    if ( m_numReserved >= MAX_RESERVED_STREAMS || !m_archive->addStream() )
     {
-        return m_default;
+        return false;
     }
 
-    return StreamIDPtr( new StreamID( this, m_streamIDs[ m_curStream ++ ] ) );
+    assert( m_archive->getNumStreams() == numStreams + 1 );
+
+    // its bit is never set, so get() and pin() never hand it out
+    m_numReserved = m_numReserved + 1;
+    oStreamID = numStreams;
+    m_numStreams = numStreams + 1;
+    return true;
 }
 
-void StreamManager::put( std::size_t iStreamID )
+//-*****************************************************************************
+bool StreamManager::anyFree()
 {
-    // shouldn't ever hit this case, it's why we have m_default
-    assert( iStreamID < m_numStreams && m_curStream > 0 );
-
+#ifndef ALEMBIC_STREAM_CAS
     Alembic::Util::scoped_lock l( m_lock );
-    m_streamIDs[ --m_curStream ] = iStreamID;
+#endif
+
+    for ( std::size_t i = 0; i < m_free.size(); ++i )
+    {
+        if ( m_free[i] != 0 )
+        {
+            return true;
+        }
+    }
+
+    return false;
 }
 
+//-*****************************************************************************
+void StreamManager::put( std::size_t iStreamID )
+{
+    assert( iStreamID < m_numStreams );
+
+#ifdef ALEMBIC_STREAM_CAS
+    __sync_fetch_and_or( &m_free[ iStreamID / kBitsPerWord ],
+                         StreamBit( iStreamID ) );
+#else
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+        m_free[ iStreamID / kBitsPerWord ] |= StreamBit( iStreamID );
+    }
 #endif
 
+    if ( m_waiter != NULL )
+    {
+        m_waiter->notify();
+    }
+}
+
+//-*****************************************************************************
 StreamID::StreamID( StreamManager * iManager, std::size_t iStreamID ) :
     m_manager( iManager ), m_streamID( iStreamID )
 {
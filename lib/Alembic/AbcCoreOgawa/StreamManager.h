@@ -38,6 +38,7 @@
 #define _Alembic_AbcCoreOgawa_StreamManager_h_
 
 #include <Alembic/AbcCoreOgawa/Foundation.h>
+#include <Alembic/AbcCoreOgawa/ReadWrite.h>
 #include <Alembic/Util/Foundation.h>
 
 namespace Alembic {
@@ -48,27 +49,92 @@ class StreamID;
 typedef Alembic::Util::shared_ptr< StreamID > StreamIDPtr;
 
 //-*****************************************************************************
+// Hands out the ids of the archive streams, so that each reader has a stream
+// to itself.  Free streams are tracked with one bit per stream, and a thread
+// is given back the stream it last used when that one is free.  When they
+// are all in use more are opened via iArchive, up to iMaxStreams, and past
+// that iPolicy decides between sharing stream 0 and waiting.  Streams may
+// also be reserved for a single user, such as a prefetch thread, which are
+// opened on top of the rest and never handed out by get() or pin().
 class StreamManager : Alembic::Util::noncopyable
 {
 public:
-    StreamManager( std::size_t iNumStreams );
+    StreamManager( std::size_t iNumStreams,
+                   std::size_t iMaxStreams = 0,
+                   StreamPolicy iPolicy = kFallbackStreamPolicy,
+                   Ogawa::IArchive * iArchive = NULL );
     ~StreamManager();
     StreamIDPtr get();
+
+    // claims a stream for as long as the caller likes, without waiting or
+    // falling back, and returns false if none is free.  The first stream is
+    // never pinned, so that under kWaitStreamPolicy there is always one
+    // which is only held for the length of a read.
+    bool pin( std::size_t & oStreamID );
+
+    // gives back a stream from pin
+    void unpin( std::size_t iStreamID ) { put( iStreamID ); }
+
+    // opens another stream for the caller alone, which is kept for the life
+    // of the manager, and returns false if one can't be opened, which is
+    // also the case after the first MAX_RESERVED_STREAMS.  The archive needs
+    // room for these on top of iMaxStreams.
+    bool reserve( std::size_t & oStreamID );
+
+    static const std::size_t MAX_RESERVED_STREAMS = 64;
+
+    std::size_t getNumStreams() const { return m_numStreams; }
+
+    // how many times get() has had to hand out the shared default stream
+    // because every other stream was in use
+    Alembic::Util::uint64_t getNumFallbacks() const { return m_numFallbacks; }
+    void resetNumFallbacks() { m_numFallbacks = 0; }
+
 private:
     friend class StreamID;
     void put( std::size_t iStreamID );
 
-    std::size_t m_numStreams;
+    // claims a free stream, trying iHint first if it is a valid id, and
+    // leaving the first stream alone if iSkipFirst
+    bool take( std::size_t iHint, std::size_t & oStreamID,
+               bool iSkipFirst = false );
 
-    // for the locked implementation
-    std::vector< std::size_t > m_streamIDs;
-    std::size_t m_curStream;
+    // claims the lowest free stream in the iWord'th word of m_free which is
+    // also in iMask
+    bool claim( std::size_t iWord, Alembic::Util::uint64_t iMask,
+                std::size_t & oStreamID );
+
+    // opens another stream and claims it
+    bool grow( std::size_t & oStreamID );
+
+    // whether any stream is free, for the waiters
+    bool anyFree();
+
+    // m_numStreams includes the reserved ones, m_maxStreams doesn't
+    volatile std::size_t m_numStreams;
+    volatile std::size_t m_maxStreams;
+    volatile std::size_t m_numReserved;
+    StreamPolicy m_policy;
+    Ogawa::IArchive * m_archive;
+
+    // a set bit is a free stream, this is sized for m_maxStreams and the
+    // most that may be reserved, so it never moves while in use
+    std::vector< Alembic::Util::uint64_t > m_free;
+
+    // guards m_free when compare and swap isn't available
     Alembic::Util::mutex m_lock;
 
-    // for the CAS impl
-    Alembic::Util::int64_t m_streams;
+    // serializes grow and reserve
+    Alembic::Util::mutex m_growLock;
+
+    // for kWaitStreamPolicy
+    class Waiter;
+    friend class Waiter;
+    Waiter * m_waiter;
 
     StreamIDPtr m_default;
+
+    Alembic::Util::uint64_t m_numFallbacks;
 };
 
 //-*****************************************************************************
@@ -383,6 +383,114 @@ void readVeryEmptyArchive( const std::string & iName )
     TESTING_ASSERT(a->getTop()->getNumChildren() == 0);
 }
 
+//-*****************************************************************************
+void testArchiveStats()
+{
+    std::string archiveName = "statsArchive.abc";
+
+    size_t numVals = 64;
+    Alembic::Util::Dimensions dims( numVals );
+    ABCA::DataType i32d( Alembic::Util::kInt32POD, 1 );
+    std::vector< Alembic::Util::int32_t > vals( numVals, 3 );
+
+    {
+        AO::WriteArchive w;
+        ABCA::ArchiveWriterPtr a = w( archiveName, ABCA::MetaData() );
+
+        ABCA::ArchiveStats stats;
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.samplesWritten == 0 );
+
+        a->setStatsEnabled( true );
+
+        ABCA::CompoundPropertyWriterPtr parent = a->getTop()->getProperties();
+        ABCA::ArrayPropertyWriterPtr awp =
+            parent->createArrayProperty( "a", ABCA::MetaData(), i32d, 0 );
+
+        // written, written, and then shared with the first sample
+        awp->setSample( ABCA::ArraySample( &( vals.front() ), i32d, dims ) );
+        vals[0] = 4;
+        awp->setSample( ABCA::ArraySample( &( vals.front() ), i32d, dims ) );
+        vals[0] = 3;
+        awp->setSample( ABCA::ArraySample( &( vals.front() ), i32d, dims ) );
+
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.samplesWritten == 2 );
+        TESTING_ASSERT( stats.bytesWritten >= 2 * numVals * 4 );
+        TESTING_ASSERT( stats.samplesDeduped == 1 );
+        TESTING_ASSERT( stats.bytesDeduped >= numVals * 4 );
+
+        a->resetStats();
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.samplesWritten == 0 );
+        TESTING_ASSERT( stats.samplesDeduped == 0 );
+    }
+
+    {
+        AO::ReadArchive r;
+        ABCA::ArchiveReaderPtr a = r( archiveName );
+
+        // nothing is gathered until asked for
+        ABCA::ArchiveStats stats;
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.cacheMisses == 0 && stats.cacheHits == 0 );
+        TESTING_ASSERT( stats.streams.size() == 1 );
+        TESTING_ASSERT( stats.streams[0].numReads == 0 );
+
+        a->setStatsEnabled( true );
+
+        ABCA::ObjectReaderPtr top = a->getTop();
+        ABCA::CompoundPropertyReaderPtr parent = top->getProperties();
+        ABCA::ArrayPropertyReaderPtr ap = parent->getArrayProperty( "a" );
+        TESTING_ASSERT( ap->getNumSamples() == 3 );
+
+        // all of these readers are still alive, so they are handed out again
+        TESTING_ASSERT( a->getStats( stats ) );
+        Alembic::Util::uint64_t misses = stats.cacheMisses;
+        TESTING_ASSERT( misses >= 3 );
+        TESTING_ASSERT( stats.cacheHits == 0 );
+
+        a->getTop()->getProperties()->getArrayProperty( "a" );
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.cacheMisses == misses );
+        TESTING_ASSERT( stats.cacheHits == 3 );
+
+        for ( size_t i = 0; i < ap->getNumSamples(); ++i )
+        {
+            ABCA::ArraySamplePtr samp;
+            ap->getSample( i, samp );
+        }
+
+        std::vector< Alembic::Util::float64_t > asDoubles( numVals );
+        ap->getAs( 1, &( asDoubles.front() ), Alembic::Util::kFloat64POD );
+        TESTING_ASSERT( asDoubles[0] == 4.0 );
+
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.samplesDecoded == 4 );
+        TESTING_ASSERT( stats.conversionTime >= 0.0 );
+        TESTING_ASSERT( stats.streams[0].numReads > 0 );
+        TESTING_ASSERT( stats.streams[0].bytesRead >= 4 * numVals * 4 );
+        TESTING_ASSERT( stats.numStreamFallbacks == 0 );
+
+        std::string json = stats.toJSON();
+        TESTING_ASSERT( json.find( "\"samplesDecoded\": 4" ) !=
+                        std::string::npos );
+
+        // turning them off stops the counting, but keeps what was gathered
+        a->setStatsEnabled( false );
+        ABCA::ArraySamplePtr samp;
+        ap->getSample( 0, samp );
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.samplesDecoded == 4 );
+
+        a->resetStats();
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.samplesDecoded == 0 );
+        TESTING_ASSERT( stats.cacheHits == 0 );
+        TESTING_ASSERT( stats.streams[0].numReads == 0 );
+    }
+}
+
 int main ( int argc, char *argv[] )
 {
     testReadWriteEmptyArchive();
@@ -401,5 +509,7 @@ int main ( int argc, char *argv[] )
 
     testReadWriteMaxNumSamplesArchive();
 
+    testArchiveStats();
+
     return 0;
 }
@@ -1867,6 +1867,316 @@ void testArraySamples()
     }
 }
 
+//-*****************************************************************************
+void testReadContext()
+{
+    std::string archiveName = "readContext.abc";
+    {
+        AO::WriteArchive w;
+        ABCA::ArchiveWriterPtr a = w(archiveName, ABCA::MetaData());
+        ABCA::ObjectWriterPtr archive = a->getTop();
+        ABCA::CompoundPropertyWriterPtr parent = archive->getProperties();
+
+        ABCA::ArrayPropertyWriterPtr awp =
+            parent->createArrayProperty("int32", ABCA::MetaData(),
+                ABCA::DataType(Alembic::Util::kInt32POD, 1), 0);
+
+        ABCA::ArrayPropertyWriterPtr swp =
+            parent->createArrayProperty("str", ABCA::MetaData(),
+                ABCA::DataType(Alembic::Util::kStringPOD, 1), 0);
+
+        ABCA::ScalarPropertyWriterPtr fwp =
+            parent->createScalarProperty("float", ABCA::MetaData(),
+                ABCA::DataType(Alembic::Util::kFloat32POD, 1), 0);
+
+        std::vector< Alembic::Util::int32_t > vals;
+        std::vector< std::string > strs;
+        for ( Alembic::Util::int32_t i = 0; i < 10; ++i )
+        {
+            vals.push_back( i * 3 );
+            strs.push_back( std::string( i + 1, 'a' + i ) );
+            ABCA::ArraySample samp( &(vals.front()),
+                ABCA::DataType(Alembic::Util::kInt32POD, 1),
+                Alembic::Util::Dimensions( vals.size() ) );
+            awp->setSample( samp );
+
+            ABCA::ArraySample strSamp( &(strs.front()),
+                ABCA::DataType(Alembic::Util::kStringPOD, 1),
+                Alembic::Util::Dimensions( strs.size() ) );
+            swp->setSample( strSamp );
+
+            Alembic::Util::float32_t f = i * 0.5f;
+            fwp->setSample( &f );
+        }
+    }
+
+    {
+        AO::ReadArchive r;
+        ABCA::ArchiveReaderPtr a = r( archiveName );
+        ABCA::ArchiveReaderPtr other = r( archiveName );
+        ABCA::CompoundPropertyReaderPtr parent = a->getTop()->getProperties();
+
+        ABCA::ReadContextPtr context = a->createReadContext();
+        TESTING_ASSERT( context );
+
+        // a context from another archive is ignored rather than used
+        ABCA::ReadContextPtr otherContext = other->createReadContext();
+        TESTING_ASSERT( otherContext );
+
+        ABCA::ArrayPropertyReaderPtr ap = parent->getArrayProperty("int32");
+        ABCA::ArrayPropertyReaderPtr sp = parent->getArrayProperty("str");
+        ABCA::ScalarPropertyReaderPtr fp = parent->getScalarProperty("float");
+
+        for ( Alembic::Util::int32_t i = 0; i < 10; ++i )
+        {
+            ABCA::ArraySamplePtr withCtx, withoutCtx, withOther;
+            ap->getSample( i, withCtx, context.get() );
+            ap->getSample( i, withoutCtx );
+            ap->getSample( i, withOther, otherContext.get() );
+            TESTING_ASSERT( withCtx->size() == ( size_t )( i + 1 ) );
+            TESTING_ASSERT( withoutCtx->size() == withCtx->size() );
+            TESTING_ASSERT( withOther->size() == withCtx->size() );
+            const Alembic::Util::int32_t * data =
+                static_cast< const Alembic::Util::int32_t * >(
+                    withCtx->getData() );
+            for ( Alembic::Util::int32_t j = 0; j <= i; ++j )
+            {
+                TESTING_ASSERT( data[j] == j * 3 );
+                TESTING_ASSERT( data[j] == static_cast<
+                    const Alembic::Util::int32_t * >(
+                        withoutCtx->getData() )[j] );
+                TESTING_ASSERT( data[j] == static_cast<
+                    const Alembic::Util::int32_t * >(
+                        withOther->getData() )[j] );
+            }
+
+            ABCA::ArraySampleKey key, keyCtx;
+            TESTING_ASSERT( ap->getKey( i, key ) );
+            TESTING_ASSERT( ap->getKey( i, keyCtx, context.get() ) );
+            TESTING_ASSERT( key == keyCtx );
+
+            Alembic::Util::Dimensions dims;
+            ap->getDimensions( i, dims, context.get() );
+            TESTING_ASSERT( dims.numPoints() == ( size_t )( i + 1 ) );
+
+            // converting needs the scratch buffer
+            std::vector< Alembic::Util::float64_t > doubles( i + 1 );
+            ap->getAs( i, &doubles.front(), Alembic::Util::kFloat64POD,
+                       context.get() );
+            for ( Alembic::Util::int32_t j = 0; j <= i; ++j )
+            {
+                TESTING_ASSERT( doubles[j] == j * 3.0 );
+            }
+
+            ABCA::ArraySamplePtr strSamp;
+            sp->getSample( i, strSamp, context.get() );
+            const std::string * strData =
+                static_cast< const std::string * >( strSamp->getData() );
+            TESTING_ASSERT( strSamp->size() == ( size_t )( i + 1 ) );
+            TESTING_ASSERT( strData[i] == std::string( i + 1, 'a' + i ) );
+
+            Alembic::Util::float32_t f = -1.0f;
+            fp->getSample( i, &f, context.get() );
+            TESTING_ASSERT( f == i * 0.5f );
+        }
+
+        ABCA::ArraySamplePtr outOfRange;
+        TESTING_ASSERT_THROW( ap->getSample( 10, outOfRange, context.get() ),
+                              Alembic::Util::Exception );
+    }
+
+    {
+        // the first context holds the second stream, and the first is
+        // never held, so neither the other context nor an ordinary read
+        // wait forever on it
+        AO::ReadArchive r( 2, 2, AO::kWaitStreamPolicy );
+        ABCA::ArchiveReaderPtr a = r( archiveName );
+        ABCA::ArrayPropertyReaderPtr ap =
+            a->getTop()->getProperties()->getArrayProperty("int32");
+
+        ABCA::ReadContextPtr context = a->createReadContext();
+        ABCA::ReadContextPtr otherContext = a->createReadContext();
+
+        ABCA::ArraySamplePtr withCtx, withOther, withoutCtx;
+        ap->getSample( 3, withCtx, context.get() );
+        ap->getSample( 3, withOther, otherContext.get() );
+        ap->getSample( 3, withoutCtx );
+        TESTING_ASSERT( withCtx->size() == 4 );
+        TESTING_ASSERT( withOther->size() == 4 );
+        TESTING_ASSERT( withoutCtx->size() == 4 );
+    }
+}
+
+//-*****************************************************************************
+void testArraySampleAllocator()
+{
+    // reuses the archive written by testReadContext
+    std::string archiveName = "readContext.abc";
+
+    ABCA::ArraySampleAllocatorPtr pool(
+        new ABCA::PooledArraySampleAllocator() );
+
+    AO::ReadArchive r;
+    ABCA::ArchiveReaderPtr a = r( archiveName );
+    TESTING_ASSERT( !a->getArraySampleAllocator() );
+    a->setArraySampleAllocator( pool );
+    TESTING_ASSERT( a->getArraySampleAllocator() == pool );
+
+    ABCA::ArrayPropertyReaderPtr ap =
+        a->getTop()->getProperties()->getArrayProperty("int32");
+
+    for ( Alembic::Util::int32_t i = 0; i < 10; ++i )
+    {
+        ABCA::ArraySamplePtr samp;
+        ap->getSample( i, samp );
+        TESTING_ASSERT( samp->size() == ( size_t )( i + 1 ) );
+        const Alembic::Util::int32_t * data =
+            static_cast< const Alembic::Util::int32_t * >( samp->getData() );
+        for ( Alembic::Util::int32_t j = 0; j <= i; ++j )
+        {
+            TESTING_ASSERT( data[j] == j * 3 );
+        }
+    }
+
+    // every sample has been released, the blocks are waiting in the pool
+    ABCA::ArraySampleAllocatorStats stats;
+    TESTING_ASSERT( pool->getStats( stats ) );
+    TESTING_ASSERT( stats.numAllocations == 10 );
+    TESTING_ASSERT( stats.numDeallocations == 10 );
+    TESTING_ASSERT( stats.bytesInUse == 0 );
+    TESTING_ASSERT( stats.numThreadCacheHits > 0 );
+}
+
+//-*****************************************************************************
+void testReadRange()
+{
+    // reuses the archive written by testReadContext
+    std::string archiveName = "readContext.abc";
+
+    AO::ReadArchive r;
+    ABCA::ArchiveReaderPtr a = r( archiveName );
+    ABCA::CompoundPropertyReaderPtr parent = a->getTop()->getProperties();
+    ABCA::ReadContextPtr context = a->createReadContext();
+
+    ABCA::ArrayPropertyReaderPtr ap = parent->getArrayProperty("int32");
+    ABCA::ArrayPropertyReaderPtr sp = parent->getArrayProperty("str");
+
+    // the last sample holds 10 values, 0, 3, 6, ...
+    Alembic::Util::int32_t vals[4];
+    ap->getRangeAs( 9, 3, 4, vals, Alembic::Util::kInt32POD );
+    for ( size_t i = 0; i < 4; ++i )
+    {
+        TESTING_ASSERT( vals[i] == ( Alembic::Util::int32_t )( i + 3 ) * 3 );
+    }
+
+    Alembic::Util::float64_t dvals[2];
+    ap->getRangeAs( 9, 8, 2, dvals, Alembic::Util::kFloat64POD,
+                    context.get() );
+    TESTING_ASSERT( dvals[0] == 24.0 && dvals[1] == 27.0 );
+
+    // nothing is touched for an empty range, even at the end
+    vals[0] = -1;
+    ap->getRangeAs( 9, 10, 0, vals, Alembic::Util::kInt32POD );
+    TESTING_ASSERT( vals[0] == -1 );
+
+    TESTING_ASSERT_THROW( ap->getRangeAs( 9, 8, 3, vals,
+        Alembic::Util::kInt32POD ), Alembic::Util::Exception );
+    TESTING_ASSERT_THROW( ap->getRangeAs( 2, 0, 4, vals,
+        Alembic::Util::kInt32POD ), Alembic::Util::Exception );
+
+    std::string strs[3];
+    sp->getRangeAs( 9, 4, 3, strs, Alembic::Util::kStringPOD,
+                    context.get() );
+    TESTING_ASSERT( strs[0] == "eeeee" );
+    TESTING_ASSERT( strs[1] == "ffffff" );
+    TESTING_ASSERT( strs[2] == "ggggggg" );
+
+    TESTING_ASSERT_THROW( sp->getRangeAs( 9, 9, 2, strs,
+        Alembic::Util::kStringPOD ), Alembic::Util::Exception );
+    TESTING_ASSERT_THROW( sp->getRangeAs( 9, 0, 1, vals,
+        Alembic::Util::kInt32POD ), Alembic::Util::Exception );
+}
+
+//-*****************************************************************************
+void testPrefetch()
+{
+    // reuses the archive written by testReadContext, where sample i is at
+    // time i
+    std::string archiveName = "readContext.abc";
+
+    AO::ReadArchive r;
+    ABCA::ArchiveReaderPtr a = r( archiveName );
+    ABCA::CompoundPropertyReaderPtr parent = a->getTop()->getProperties();
+
+    std::vector< ABCA::ArrayPropertyReaderPtr > props;
+    props.push_back( parent->getArrayProperty("int32") );
+    props.push_back( parent->getArrayProperty("str") );
+
+    Alembic::Util::uint64_t request = a->prefetch( props, 2.0, 5.0 );
+    TESTING_ASSERT( request != 0 );
+    a->waitForPrefetch( request );
+
+    // prefetched samples are handed out once without being decoded again,
+    // after that, like any other, they are read every time
+    a->setStatsEnabled( true );
+    for ( Alembic::Util::int32_t i = 0; i < 10; ++i )
+    {
+        bool prefetched = ( i >= 2 && i <= 5 );
+        ABCA::ArchiveStats stats;
+
+        ABCA::ArraySamplePtr first, second;
+        a->resetStats();
+        props[0]->getSample( i, first );
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.samplesDecoded == ( prefetched ? 0 : 1 ) );
+        props[0]->getSample( i, second );
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.samplesDecoded == ( prefetched ? 1 : 2 ) );
+        TESTING_ASSERT( first != second );
+        TESTING_ASSERT( first->size() == ( size_t )( i + 1 ) );
+        TESTING_ASSERT( static_cast< const Alembic::Util::int32_t * >(
+            first->getData() )[i] == i * 3 );
+
+        a->resetStats();
+        props[1]->getSample( i, first );
+        TESTING_ASSERT( a->getStats( stats ) );
+        TESTING_ASSERT( stats.samplesDecoded == ( prefetched ? 0 : 1 ) );
+        TESTING_ASSERT( static_cast< const std::string * >(
+            first->getData() )[i] == std::string( i + 1, 'a' + i ) );
+    }
+    a->setStatsEnabled( false );
+
+    // without threads nothing gets read, so what is cancelled never arrives
+    ABCA::ArchiveReaderPtr b = r( archiveName );
+    b->setPrefetchLimits( 0, 1024 * 1024 );
+    std::vector< ABCA::ArrayPropertyReaderPtr > bprops;
+    bprops.push_back( b->getTop()->getProperties()->getArrayProperty("int32") );
+    request = b->prefetch( bprops, 7.0, 8.0, 1 );
+    Alembic::Util::uint64_t other = b->prefetch( bprops, 9.0, 9.0 );
+    b->cancelPrefetch( request );
+    b->cancelAllPrefetches();
+    b->waitForPrefetch( request );
+    b->waitForPrefetch( other );
+
+    b->setPrefetchLimits( 2, 1024 * 1024 );
+    for ( Alembic::Util::int32_t i = 7; i < 10; ++i )
+    {
+        ABCA::ArraySamplePtr first, second;
+        bprops[0]->getSample( i, first );
+        bprops[0]->getSample( i, second );
+        TESTING_ASSERT( first != second );
+    }
+
+    // properties of another archive are skipped
+    TESTING_ASSERT( a->prefetch( bprops, 0.0, 9.0 ) != 0 );
+
+    // a request can outlive the archive and the properties it was for
+    request = a->prefetch( props, 0.0, 9.0 );
+    props.clear();
+    parent.reset();
+    a.reset();
+}
+
 int main ( int argc, char *argv[] )
 {
     testEmptyArray();
@@ -1875,5 +2185,9 @@ int main ( int argc, char *argv[] )
     testExtentArrayStrings();
     testArrayStringsRepeats();
     testArraySamples();
+    testReadContext();
+    testArraySampleAllocator();
+    testReadRange();
+    testPrefetch();
     return 0;
 }
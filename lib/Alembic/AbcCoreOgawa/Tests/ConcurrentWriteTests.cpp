@@ -0,0 +1,228 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Util/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifndef _MSC_VER
+#include <pthread.h>
+#endif
+
+//-*****************************************************************************
+namespace AO = Alembic::AbcCoreOgawa;
+
+namespace ABCA = Alembic::AbcCoreAbstract;
+
+static const std::size_t kNumThreads = 8;
+static const std::size_t kObjectsPerThread = 25;
+static const std::size_t kNumSamples = 10;
+
+//-*****************************************************************************
+struct WriterArgs
+{
+    ABCA::ArchiveWriterPtr archive;
+    std::size_t thread;
+};
+
+//-*****************************************************************************
+// every thread makes its own objects under the same parent
+void * writeObjects( void * iArgs )
+{
+    WriterArgs * args = static_cast< WriterArgs * >( iArgs );
+    ABCA::ObjectWriterPtr top = args->archive->getTop();
+
+    // each thread adds the same time sampling, they should all get one index
+    ABCA::TimeSampling ts( 1.0 / 24.0, 0.0 );
+    Alembic::Util::uint32_t tsIndex = args->archive->addTimeSampling( ts );
+
+    for ( std::size_t i = 0; i < kObjectsPerThread; ++i )
+    {
+        std::ostringstream name;
+        name << "thread" << args->thread << "_" << i;
+
+        ABCA::MetaData md;
+        md.set( "thread", name.str().substr( 0, 7 ) );
+
+        ABCA::ObjectWriterPtr obj = top->createChild(
+            ABCA::ObjectHeader( name.str(), md ) );
+        ABCA::CompoundPropertyWriterPtr props = obj->getProperties();
+
+        ABCA::ArrayPropertyWriterPtr p = props->createArrayProperty( "P",
+            ABCA::MetaData(), ABCA::DataType( Alembic::Util::kInt32POD, 1 ),
+            tsIndex );
+
+        // the same on every object of every thread, so it gets deduplicated
+        ABCA::ArrayPropertyWriterPtr shared = props->createArrayProperty(
+            "shared", ABCA::MetaData(),
+            ABCA::DataType( Alembic::Util::kInt32POD, 1 ), tsIndex );
+
+        ABCA::ScalarPropertyWriterPtr id = props->createScalarProperty( "id",
+            ABCA::MetaData(), ABCA::DataType( Alembic::Util::kUint32POD, 1 ),
+            0 );
+        Alembic::Util::uint32_t idVal = args->thread * 1000 + i;
+        id->setSample( &idVal );
+
+        std::vector< Alembic::Util::int32_t > vals( 100 );
+        for ( std::size_t j = 0; j < kNumSamples; ++j )
+        {
+            for ( std::size_t k = 0; k < vals.size(); ++k )
+            {
+                vals[k] = idVal * 100 + j * 10 + k;
+            }
+            p->setSample( ABCA::ArraySample( &vals.front(), p->getDataType(),
+                Alembic::Util::Dimensions( vals.size() ) ) );
+
+            std::vector< Alembic::Util::int32_t > same( 50, j );
+            shared->setSample( ABCA::ArraySample( &same.front(),
+                shared->getDataType(),
+                Alembic::Util::Dimensions( same.size() ) ) );
+        }
+    }
+
+    return NULL;
+}
+
+//-*****************************************************************************
+void testConcurrentWrite()
+{
+    std::string archiveName = "concurrentWrite.abc";
+
+    {
+        AO::WriteArchive w;
+        ABCA::ArchiveWriterPtr a = w( archiveName, ABCA::MetaData() );
+        a->setStatsEnabled( true );
+
+        std::vector< WriterArgs > args( kNumThreads );
+        std::vector< pthread_t > threads( kNumThreads );
+        for ( std::size_t i = 0; i < kNumThreads; ++i )
+        {
+            args[i].archive = a;
+            args[i].thread = i;
+            pthread_create( &threads[i], NULL, writeObjects, &args[i] );
+        }
+
+        for ( std::size_t i = 0; i < kNumThreads; ++i )
+        {
+            pthread_join( threads[i], NULL );
+            args[i].archive.reset();
+        }
+
+        ABCA::ArchiveStats stats;
+        a->getStats( stats );
+
+        // only the first thread to write each shared sample stores it
+        TESTING_ASSERT( stats.samplesWritten <
+            kNumThreads * kObjectsPerThread * ( kNumSamples + 1 ) +
+            kNumSamples * kNumThreads );
+        TESTING_ASSERT( stats.samplesDeduped > 0 );
+    }
+
+    AO::ReadArchive r;
+    ABCA::ArchiveReaderPtr a = r( archiveName );
+    TESTING_ASSERT( a->getNumTimeSamplings() == 2 );
+    TESTING_ASSERT( a->getMaxNumSamplesForTimeSamplingIndex( 1 ) ==
+                    ( ABCA::index_t ) kNumSamples );
+
+    ABCA::ObjectReaderPtr top = a->getTop();
+    TESTING_ASSERT( top->getNumChildren() == kNumThreads * kObjectsPerThread );
+
+    std::vector< bool > found( kNumThreads * kObjectsPerThread, false );
+    for ( std::size_t c = 0; c < top->getNumChildren(); ++c )
+    {
+        ABCA::ObjectReaderPtr obj = top->getChild( c );
+        ABCA::CompoundPropertyReaderPtr props = obj->getProperties();
+        TESTING_ASSERT( props->getNumProperties() == 3 );
+
+        Alembic::Util::uint32_t idVal = 0;
+        props->getScalarProperty( "id" )->getSample( 0, &idVal );
+
+        std::size_t thread = idVal / 1000;
+        std::size_t index = idVal % 1000;
+        std::ostringstream name;
+        name << "thread" << thread << "_" << index;
+        TESTING_ASSERT( obj->getName() == name.str() );
+        TESTING_ASSERT( obj->getMetaData().get( "thread" ) ==
+                        name.str().substr( 0, 7 ) );
+
+        std::size_t flat = thread * kObjectsPerThread + index;
+        TESTING_ASSERT( flat < found.size() && !found[flat] );
+        found[flat] = true;
+
+        ABCA::ArrayPropertyReaderPtr p = props->getArrayProperty( "P" );
+        ABCA::ArrayPropertyReaderPtr shared =
+            props->getArrayProperty( "shared" );
+        TESTING_ASSERT( p->getNumSamples() == kNumSamples );
+        TESTING_ASSERT( shared->getNumSamples() == kNumSamples );
+
+        for ( std::size_t j = 0; j < kNumSamples; ++j )
+        {
+            ABCA::ArraySamplePtr samp;
+            p->getSample( j, samp );
+            TESTING_ASSERT( samp->size() == 100 );
+            const Alembic::Util::int32_t * vals =
+                static_cast< const Alembic::Util::int32_t * >(
+                    samp->getData() );
+            for ( std::size_t k = 0; k < 100; ++k )
+            {
+                TESTING_ASSERT( vals[k] ==
+                    ( Alembic::Util::int32_t )( idVal * 100 + j * 10 + k ) );
+            }
+
+            shared->getSample( j, samp );
+            TESTING_ASSERT( samp->size() == 50 );
+            vals = static_cast< const Alembic::Util::int32_t * >(
+                samp->getData() );
+            TESTING_ASSERT( vals[0] == ( Alembic::Util::int32_t ) j &&
+                            vals[49] == ( Alembic::Util::int32_t ) j );
+        }
+    }
+}
+
+//-*****************************************************************************
+int main ( int argc, char *argv[] )
+{
+#ifndef _MSC_VER
+    testConcurrentWrite();
+#endif
+    return 0;
+}
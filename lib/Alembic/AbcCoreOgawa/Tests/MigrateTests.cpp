@@ -0,0 +1,193 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/Util/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+#include <Alembic/AbcCoreAbstract/Tests/ArchiveCompare.h>
+
+#include <iostream>
+#include <sstream>
+
+//-*****************************************************************************
+namespace AO = Alembic::AbcCoreOgawa;
+
+namespace AH = Alembic::AbcCoreHDF5;
+
+namespace ABCA = Alembic::AbcCoreAbstract;
+
+static const std::size_t kNumObjects = 16;
+static const std::size_t kNumSamples = 12;
+static const std::size_t kNumPoints = 500;
+
+//-*****************************************************************************
+// every object has animated points which hold still for a few frames, the
+// same names every frame and an animated scalar, under a nested compound
+void writeHDF5( const std::string & iName )
+{
+    ABCA::MetaData md;
+    md.set( "writer", "migrateTest" );
+    ABCA::ArchiveWriterPtr a = AH::WriteArchive( true )( iName, md );
+
+    ABCA::TimeSampling ts( 1.0 / 24.0, 1.0 );
+    Alembic::Util::uint32_t tsIndex = a->addTimeSampling( ts );
+
+    std::vector< ABCA::ObjectWriterPtr > parents( 1, a->getTop() );
+    for ( std::size_t i = 0; i < kNumObjects; ++i )
+    {
+        std::ostringstream name;
+        name << "obj" << i;
+        ABCA::ObjectWriterPtr obj = parents[ i / 4 ]->createChild(
+            ABCA::ObjectHeader( name.str(), ABCA::MetaData() ) );
+        parents.push_back( obj );
+
+        ABCA::CompoundPropertyWriterPtr props = obj->getProperties();
+        ABCA::ArrayPropertyWriterPtr p = props->createArrayProperty( "P",
+            ABCA::MetaData(), ABCA::DataType( Alembic::Util::kFloat32POD, 3 ),
+            tsIndex );
+        ABCA::ScalarPropertyWriterPtr id = props->createScalarProperty( "id",
+            ABCA::MetaData(), ABCA::DataType( Alembic::Util::kInt32POD, 1 ),
+            tsIndex );
+
+        ABCA::CompoundPropertyWriterPtr arb = props->createCompoundProperty(
+            "arb", ABCA::MetaData() );
+        ABCA::ArrayPropertyWriterPtr names = arb->createArrayProperty( "names",
+            ABCA::MetaData(), ABCA::DataType( Alembic::Util::kStringPOD, 1 ),
+            tsIndex );
+
+        std::vector< std::string > strs( 3, name.str() );
+        std::vector< Alembic::Util::float32_t > vals( kNumPoints * 3 );
+        for ( std::size_t j = 0; j < kNumSamples; ++j )
+        {
+            // every object moves the same way, on every other pair of frames
+            for ( std::size_t k = 0; k < vals.size(); ++k )
+            {
+                vals[k] = ( float )( ( j / 2 ) * 1000 + k );
+            }
+
+            p->setSample( ABCA::ArraySample( &vals.front(),
+                p->getDataType(), Alembic::Util::Dimensions( kNumPoints ) ) );
+
+            Alembic::Util::int32_t idVal = i * 100 + j;
+            id->setSample( &idVal );
+
+            names->setSample( ABCA::ArraySample( &strs.front(),
+                names->getDataType(), Alembic::Util::Dimensions( 3 ) ) );
+        }
+    }
+}
+
+//-*****************************************************************************
+struct Progress
+{
+    Progress() : numCalls( 0 ), lastSamples( 0 ), ordered( true ) {}
+
+    std::size_t numCalls;
+    Alembic::Util::uint64_t lastSamples;
+    bool ordered;
+};
+
+void progress( const AO::MigrateStats & iStats, void * iData )
+{
+    Progress & p = *( static_cast< Progress * >( iData ) );
+    p.numCalls ++;
+    p.ordered = p.ordered && iStats.numSamples > p.lastSamples &&
+        iStats.numSamples <= iStats.totalSamples;
+    p.lastSamples = iStats.numSamples;
+}
+
+//-*****************************************************************************
+void testMigrate( std::size_t iNumThreads, Alembic::Util::uint64_t iBatch )
+{
+    std::string inName = "migrateIn.abc";
+    std::string outName = "migrateOut.abc";
+    writeHDF5( inName );
+
+    ABCA::ArchiveReaderPtr in = AH::ReadArchive( true )( inName );
+
+    Progress prog;
+    AO::MigrateOptions options;
+    options.numThreads = iNumThreads;
+    options.batchBytes = iBatch;
+    options.progress = progress;
+    options.progressData = &prog;
+    AO::MigrateStats stats = AO::MigrateArchive( in, outName, options );
+
+    std::cout << "threads: " << iNumThreads << " batch: " << iBatch
+              << " samples: " << stats.numSamples
+              << " bytes: " << stats.bytesCopied
+              << " seconds: " << stats.seconds << std::endl;
+
+    // the top object, and a P, id, arb and names on each of the others
+    TESTING_ASSERT( stats.numObjects == kNumObjects + 1 );
+    TESTING_ASSERT( stats.numProperties == kNumObjects * 4 );
+    TESTING_ASSERT( stats.totalSamples == kNumObjects * 3 * kNumSamples );
+    TESTING_ASSERT( stats.numSamples == stats.totalSamples );
+    TESTING_ASSERT( prog.numCalls > 0 && prog.ordered );
+    TESTING_ASSERT( prog.lastSamples == stats.totalSamples );
+
+    AO::ReadArchive r;
+    ABCA::ArchiveReaderPtr out = r( outName );
+    TESTING_ASSERT( out->getMetaData().get( "writer" ) == "migrateTest" );
+    TESTING_ASSERT( out->getNumTimeSamplings() == in->getNumTimeSamplings() );
+    TESTING_ASSERT( *out->getTimeSampling( 1 ) == *in->getTimeSampling( 1 ) );
+    TESTING_ASSERT( out->getMaxNumSamplesForTimeSamplingIndex( 1 ) ==
+                    ( ABCA::index_t ) kNumSamples );
+    checkSame( in->getTop(), out->getTop() );
+
+    // the points repeat across objects and frames, and are stored once each
+    AO::VerifyReport report = AO::VerifyArchive( outName );
+    TESTING_ASSERT( report.ok() );
+    TESTING_ASSERT( report.bytesChecked < stats.bytesCopied / 4 );
+
+    // migrating onto itself would destroy what is being read
+    TESTING_ASSERT_THROW( AO::MigrateArchive( in, inName ),
+                          Alembic::Util::Exception );
+}
+
+//-*****************************************************************************
+int main ( int argc, char *argv[] )
+{
+    testMigrate( 1, 64 * 1024 * 1024 );
+    testMigrate( 4, 64 * 1024 * 1024 );
+
+    // a batch per sample
+    testMigrate( 4, 1 );
+    return 0;
+}
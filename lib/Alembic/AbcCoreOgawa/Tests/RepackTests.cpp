@@ -0,0 +1,166 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Util/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+#include <Alembic/AbcCoreAbstract/Tests/ArchiveCompare.h>
+
+#include <iostream>
+#include <sstream>
+
+//-*****************************************************************************
+namespace AO = Alembic::AbcCoreOgawa;
+
+namespace ABCA = Alembic::AbcCoreAbstract;
+
+static const std::size_t kNumObjects = 20;
+static const std::size_t kNumSamples = 24;
+static const std::size_t kNumPoints = 1000;
+
+//-*****************************************************************************
+// writes every sample of one object before moving on to the next, like most
+// exporters do
+void writeObjectMajor( const std::string & iName )
+{
+    AO::WriteArchive w;
+    ABCA::MetaData md;
+    md.set( "writer", "objectMajor" );
+    ABCA::ArchiveWriterPtr a = w( iName, md );
+
+    ABCA::TimeSampling ts( 1.0 / 24.0, 1.0 );
+    Alembic::Util::uint32_t tsIndex = a->addTimeSampling( ts );
+    TESTING_ASSERT( tsIndex == 1 );
+
+    ABCA::ObjectWriterPtr top = a->getTop();
+
+    for ( std::size_t i = 0; i < kNumObjects; ++i )
+    {
+        std::ostringstream name;
+        name << "obj" << i;
+        ABCA::ObjectWriterPtr obj = top->createChild(
+            ABCA::ObjectHeader( name.str(), ABCA::MetaData() ) );
+
+        ABCA::CompoundPropertyWriterPtr props = obj->getProperties();
+        ABCA::ArrayPropertyWriterPtr p = props->createArrayProperty( "P",
+            ABCA::MetaData(), ABCA::DataType( Alembic::Util::kFloat32POD, 3 ),
+            tsIndex );
+        ABCA::ScalarPropertyWriterPtr id = props->createScalarProperty( "id",
+            ABCA::MetaData(), ABCA::DataType( Alembic::Util::kInt32POD, 1 ),
+            tsIndex );
+
+        ABCA::CompoundPropertyWriterPtr arb = props->createCompoundProperty(
+            "arb", ABCA::MetaData() );
+        ABCA::ArrayPropertyWriterPtr names = arb->createArrayProperty( "names",
+            ABCA::MetaData(), ABCA::DataType( Alembic::Util::kStringPOD, 1 ),
+            tsIndex );
+
+        std::vector< std::string > strs( 3, name.str() );
+        std::vector< Alembic::Util::float32_t > vals( kNumPoints * 3 );
+        for ( std::size_t j = 0; j < kNumSamples; ++j )
+        {
+            for ( std::size_t k = 0; k < vals.size(); ++k )
+            {
+                vals[k] = ( float )( i * 100000 + j * 1000 + k );
+            }
+
+            p->setSample( ABCA::ArraySample( &vals.front(),
+                p->getDataType(), Alembic::Util::Dimensions( kNumPoints ) ) );
+
+            Alembic::Util::int32_t idVal = i * 100 + j;
+            id->setSample( &idVal );
+
+            names->setSample( ABCA::ArraySample( &strs.front(),
+                names->getDataType(), Alembic::Util::Dimensions( 3 ) ) );
+        }
+    }
+}
+
+//-*****************************************************************************
+void testRepack( bool iConstantsFirst )
+{
+    std::string inName = "repackIn.abc";
+    std::string outName = "repackOut.abc";
+    writeObjectMajor( inName );
+
+    AO::ReadArchive r;
+    ABCA::ArchiveReaderPtr in = r( inName );
+
+    AO::RepackOptions options;
+    options.constantsFirst = iConstantsFirst;
+    AO::RepackArchive( in, outName, options );
+
+    ABCA::ArchiveReaderPtr out = r( outName );
+    TESTING_ASSERT( out->getMetaData().get( "writer" ) == "objectMajor" );
+    TESTING_ASSERT( out->getNumTimeSamplings() == in->getNumTimeSamplings() );
+    TESTING_ASSERT( *out->getTimeSampling( 1 ) == *in->getTimeSampling( 1 ) );
+    TESTING_ASSERT( out->getMaxNumSamplesForTimeSamplingIndex( 1 ) ==
+                    ( ABCA::index_t ) kNumSamples );
+    checkSame( in->getTop(), out->getTop() );
+
+    // repacking onto itself would destroy what is being read
+    TESTING_ASSERT_THROW( AO::RepackArchive( in, inName ),
+                          Alembic::Util::Exception );
+
+    AO::PlaybackStats before = AO::MeasurePlayback( r( inName ) );
+    AO::PlaybackStats after = AO::MeasurePlayback( r( outName ) );
+
+    std::cout << "constantsFirst: " << iConstantsFirst
+              << " seeks before: " << before.numSeeks
+              << " after: " << after.numSeeks
+              << " distance before: " << before.seekDistance
+              << " after: " << after.seekDistance << std::endl;
+
+    TESTING_ASSERT( before.numFrames == kNumSamples );
+    TESTING_ASSERT( after.numFrames == kNumSamples );
+
+    // the names never change, so they are only read once
+    TESTING_ASSERT( before.numSamples == kNumObjects * ( 2 * kNumSamples + 1 ) );
+    TESTING_ASSERT( after.numSamples == before.numSamples );
+    TESTING_ASSERT( after.bytesRead == before.bytesRead );
+    TESTING_ASSERT( after.numSeeks < before.numSeeks );
+    TESTING_ASSERT( after.seekDistance < before.seekDistance );
+}
+
+//-*****************************************************************************
+int main ( int argc, char *argv[] )
+{
+    testRepack( true );
+    testRepack( false );
+    return 0;
+}
@@ -0,0 +1,294 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcCoreOgawa/StreamManager.h>
+#include <Alembic/Util/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <iostream>
+#include <set>
+#include <vector>
+
+#ifndef _MSC_VER
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+//-*****************************************************************************
+namespace AO = Alembic::AbcCoreOgawa;
+
+namespace ABCA = Alembic::AbcCoreAbstract;
+
+//-*****************************************************************************
+void writeEmptyArchive( const std::string & iName )
+{
+    AO::WriteArchive w;
+    ABCA::ArchiveWriterPtr a = w( iName, ABCA::MetaData() );
+    a->getTop();
+}
+
+//-*****************************************************************************
+void testManyStreams()
+{
+    // more streams than fit in one word
+    std::size_t numStreams = 150;
+    AO::StreamManager manager( numStreams );
+
+    std::vector< AO::StreamIDPtr > ids;
+    std::set< std::size_t > seen;
+    for ( std::size_t i = 0; i < numStreams; ++i )
+    {
+        ids.push_back( manager.get() );
+        TESTING_ASSERT( ids.back()->getID() < numStreams );
+        seen.insert( ids.back()->getID() );
+    }
+    TESTING_ASSERT( seen.size() == numStreams );
+    TESTING_ASSERT( manager.getNumFallbacks() == 0 );
+
+    // all are in use, so we get the shared one
+    AO::StreamIDPtr shared = manager.get();
+    TESTING_ASSERT( shared->getID() == 0 );
+    TESTING_ASSERT( manager.getNumFallbacks() == 1 );
+
+    // give some back, including ones past the first word, and make sure they
+    // are handed out again instead of falling back
+    std::size_t given = ids[100]->getID();
+    ids[100].reset();
+    ids[3].reset();
+
+    AO::StreamIDPtr a = manager.get();
+    AO::StreamIDPtr b = manager.get();
+    TESTING_ASSERT( a->getID() != b->getID() );
+    TESTING_ASSERT( a->getID() == given || b->getID() == given );
+    TESTING_ASSERT( manager.getNumFallbacks() == 1 );
+
+    // dropping everything makes them all available again
+    ids.clear();
+    a.reset();
+    b.reset();
+    seen.clear();
+    for ( std::size_t i = 0; i < numStreams; ++i )
+    {
+        ids.push_back( manager.get() );
+        seen.insert( ids.back()->getID() );
+    }
+    TESTING_ASSERT( seen.size() == numStreams );
+    TESTING_ASSERT( manager.getNumFallbacks() == 1 );
+}
+
+//-*****************************************************************************
+void testAffinity()
+{
+    AO::StreamManager manager( 8 );
+
+    std::size_t id = 0;
+    {
+        AO::StreamIDPtr first = manager.get();
+        AO::StreamIDPtr second = manager.get();
+        id = second->getID();
+    }
+
+    // we are handed back the last stream we had, not the lowest free one
+    AO::StreamIDPtr again = manager.get();
+    TESTING_ASSERT( again->getID() == id );
+}
+
+//-*****************************************************************************
+void testPin()
+{
+    AO::StreamManager manager( 3, 3, AO::kWaitStreamPolicy );
+
+    // the first stream is never pinned
+    std::size_t first = 0;
+    std::size_t second = 0;
+    std::size_t third = 0;
+    TESTING_ASSERT( manager.pin( first ) );
+    TESTING_ASSERT( manager.pin( second ) );
+    TESTING_ASSERT( !manager.pin( third ) );
+    TESTING_ASSERT( first != 0 && second != 0 && first != second );
+
+    // and is still there for an ordinary read, which doesn't wait
+    {
+        AO::StreamIDPtr id = manager.get();
+        TESTING_ASSERT( id->getID() == 0 );
+    }
+
+    manager.unpin( first );
+    TESTING_ASSERT( manager.pin( third ) );
+    TESTING_ASSERT( third == first );
+
+    // a single stream can't be pinned at all
+    AO::StreamManager single( 1 );
+    TESTING_ASSERT( !single.pin( third ) );
+}
+
+//-*****************************************************************************
+void testGrowth()
+{
+    std::string archiveName = "streamGrowth.abc";
+    writeEmptyArchive( archiveName );
+
+    Alembic::Ogawa::IArchive archive( archiveName, 2, 70 );
+    TESTING_ASSERT( archive.isValid() );
+    TESTING_ASSERT( archive.getNumStreams() == 2 );
+
+    AO::StreamManager manager( 2, 70, AO::kFallbackStreamPolicy, &archive );
+
+    std::vector< AO::StreamIDPtr > ids;
+    std::set< std::size_t > seen;
+    for ( std::size_t i = 0; i < 70; ++i )
+    {
+        ids.push_back( manager.get() );
+        seen.insert( ids.back()->getID() );
+    }
+
+    TESTING_ASSERT( seen.size() == 70 );
+    TESTING_ASSERT( *seen.rbegin() == 69 );
+    TESTING_ASSERT( manager.getNumStreams() == 70 );
+    TESTING_ASSERT( archive.getNumStreams() == 70 );
+    TESTING_ASSERT( manager.getNumFallbacks() == 0 );
+
+    // the newest stream reads the same data as the first one, the first
+    // child of an AbcCoreOgawa archive is its version
+    Alembic::Ogawa::IDataPtr data = archive.getGroup()->getData( 0, 0 );
+    TESTING_ASSERT( data && data->getSize() == 4 );
+    Alembic::Util::int32_t version0 = 0;
+    Alembic::Util::int32_t version69 = 1;
+    data->read( 4, &version0, 0, 0 );
+    data->read( 4, &version69, 0, 69 );
+    TESTING_ASSERT( version0 == version69 );
+
+    // can't grow anymore
+    AO::StreamIDPtr shared = manager.get();
+    TESTING_ASSERT( shared->getID() == 0 );
+    TESTING_ASSERT( manager.getNumFallbacks() == 1 );
+
+    // the archive full of readers through AbcCoreOgawa
+    AO::ReadArchive r( 1, 4, AO::kFallbackStreamPolicy );
+    ABCA::ArchiveReaderPtr reader = r( archiveName );
+    TESTING_ASSERT( reader->getTop()->getNumChildren() == 0 );
+}
+
+//-*****************************************************************************
+void testReserve()
+{
+    std::string archiveName = "streamReserve.abc";
+    writeEmptyArchive( archiveName );
+
+    Alembic::Ogawa::IArchive archive( archiveName, 2, 4 );
+    AO::StreamManager manager( 2, 3, AO::kWaitStreamPolicy, &archive );
+
+    // a reserved stream is opened on top of the others
+    std::size_t reserved = 0;
+    TESTING_ASSERT( manager.reserve( reserved ) );
+    TESTING_ASSERT( reserved == 2 );
+    TESTING_ASSERT( archive.getNumStreams() == 3 );
+
+    // and isn't counted against the ones readers may grow to, nor handed
+    // out to them
+    std::vector< AO::StreamIDPtr > ids;
+    for ( std::size_t i = 0; i < 3; ++i )
+    {
+        ids.push_back( manager.get() );
+        TESTING_ASSERT( ids.back()->getID() != reserved );
+    }
+    TESTING_ASSERT( manager.getNumStreams() == 4 );
+
+    std::size_t pinned = 0;
+    TESTING_ASSERT( !manager.pin( pinned ) );
+
+    // the archive has no room left
+    TESTING_ASSERT( !manager.reserve( pinned ) );
+
+    // without an archive nothing can be reserved
+    AO::StreamManager fixed( 2 );
+    TESTING_ASSERT( !fixed.reserve( pinned ) );
+}
+
+#ifndef _MSC_VER
+//-*****************************************************************************
+struct HoldArgs
+{
+    AO::StreamIDPtr id;
+};
+
+void * holdThenRelease( void * iArgs )
+{
+    HoldArgs * args = static_cast< HoldArgs * >( iArgs );
+    usleep( 50000 );
+    args->id.reset();
+    return NULL;
+}
+
+//-*****************************************************************************
+void testWait()
+{
+    AO::StreamManager manager( 2, 2, AO::kWaitStreamPolicy );
+
+    AO::StreamIDPtr first = manager.get();
+
+    HoldArgs args;
+    args.id = manager.get();
+    std::size_t held = args.id->getID();
+
+    pthread_t thread;
+    pthread_create( &thread, NULL, holdThenRelease, &args );
+
+    // blocks until the other thread lets go
+    AO::StreamIDPtr waited = manager.get();
+    TESTING_ASSERT( waited->getID() == held );
+    TESTING_ASSERT( manager.getNumFallbacks() == 0 );
+
+    pthread_join( thread, NULL );
+}
+#endif
+
+//-*****************************************************************************
+int main ( int argc, char *argv[] )
+{
+    testManyStreams();
+    testAffinity();
+    testPin();
+    testGrowth();
+    testReserve();
+#ifndef _MSC_VER
+    testWait();
+#endif
+    return 0;
+}
@@ -0,0 +1,294 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreAbstract/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/Util/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+//-*****************************************************************************
+namespace AO = Alembic::AbcCoreOgawa;
+
+namespace ABCA = Alembic::AbcCoreAbstract;
+
+static const std::size_t kNumObjects = 10;
+static const std::size_t kNumSamples = 8;
+static const std::size_t kNumPoints = 100;
+
+//-*****************************************************************************
+// the first point of the positions of an object at a sample, which no other
+// sample shares
+Alembic::Util::float32_t firstPoint( std::size_t iObject, std::size_t iSample )
+{
+    return ( Alembic::Util::float32_t )( 1000000 + iObject * 1000 +
+                                         iSample * 10 );
+}
+
+//-*****************************************************************************
+void writeArchive( const std::string & iName )
+{
+    AO::WriteArchive w;
+    ABCA::ArchiveWriterPtr a = w( iName, ABCA::MetaData() );
+
+    ABCA::TimeSampling ts( 1.0 / 24.0, 0.0 );
+    Alembic::Util::uint32_t tsIndex = a->addTimeSampling( ts );
+
+    ABCA::ObjectWriterPtr top = a->getTop();
+
+    // every object writes the same ids, so they are stored just once
+    std::vector< Alembic::Util::int32_t > ids( kNumPoints );
+    for ( std::size_t i = 0; i < ids.size(); ++i )
+    {
+        ids[i] = 0x5a5a0000 + i;
+    }
+
+    for ( std::size_t i = 0; i < kNumObjects; ++i )
+    {
+        std::ostringstream name;
+        name << "obj" << i;
+        ABCA::ObjectWriterPtr obj = top->createChild(
+            ABCA::ObjectHeader( name.str(), ABCA::MetaData() ) );
+
+        ABCA::CompoundPropertyWriterPtr props = obj->getProperties();
+        ABCA::ArrayPropertyWriterPtr p = props->createArrayProperty( "P",
+            ABCA::MetaData(), ABCA::DataType( Alembic::Util::kFloat32POD, 3 ),
+            tsIndex );
+        ABCA::ArrayPropertyWriterPtr idProp = props->createArrayProperty(
+            "ids", ABCA::MetaData(),
+            ABCA::DataType( Alembic::Util::kInt32POD, 1 ), 0 );
+        ABCA::ScalarPropertyWriterPtr frame = props->createScalarProperty(
+            "frame", ABCA::MetaData(),
+            ABCA::DataType( Alembic::Util::kUint64POD, 1 ), tsIndex );
+
+        ABCA::CompoundPropertyWriterPtr arb = props->createCompoundProperty(
+            "arb", ABCA::MetaData() );
+        ABCA::ArrayPropertyWriterPtr names = arb->createArrayProperty( "names",
+            ABCA::MetaData(), ABCA::DataType( Alembic::Util::kStringPOD, 1 ),
+            0 );
+        ABCA::ArrayPropertyWriterPtr wnames = arb->createArrayProperty(
+            "wnames", ABCA::MetaData(),
+            ABCA::DataType( Alembic::Util::kWstringPOD, 1 ), 0 );
+
+        // empty samples are stored without a key
+        ABCA::ArrayPropertyWriterPtr empty = props->createArrayProperty(
+            "empty", ABCA::MetaData(),
+            ABCA::DataType( Alembic::Util::kInt64POD, 1 ), 0 );
+        empty->setSample( ABCA::ArraySample( NULL, empty->getDataType(),
+                                             Alembic::Util::Dimensions( 0 ) ) );
+
+        idProp->setSample( ABCA::ArraySample( &ids.front(),
+            idProp->getDataType(), Alembic::Util::Dimensions( ids.size() ) ) );
+
+        std::vector< std::string > strs( 2, name.str() );
+        names->setSample( ABCA::ArraySample( &strs.front(),
+            names->getDataType(), Alembic::Util::Dimensions( 2 ) ) );
+
+        std::vector< std::wstring > wstrs( 2, L"wide" );
+        wnames->setSample( ABCA::ArraySample( &wstrs.front(),
+            wnames->getDataType(), Alembic::Util::Dimensions( 2 ) ) );
+
+        std::vector< Alembic::Util::float32_t > vals( kNumPoints * 3 );
+        for ( std::size_t j = 0; j < kNumSamples; ++j )
+        {
+            vals[0] = firstPoint( i, j );
+            for ( std::size_t k = 1; k < vals.size(); ++k )
+            {
+                vals[k] = ( Alembic::Util::float32_t ) k;
+            }
+
+            p->setSample( ABCA::ArraySample( &vals.front(),
+                p->getDataType(), Alembic::Util::Dimensions( kNumPoints ) ) );
+
+            Alembic::Util::uint64_t frameVal = j;
+            frame->setSample( &frameVal );
+        }
+    }
+}
+
+//-*****************************************************************************
+std::string readFile( const std::string & iName )
+{
+    std::ifstream file( iName.c_str(), std::ios::in | std::ios::binary );
+    return std::string( std::istreambuf_iterator< char >( file ),
+                        std::istreambuf_iterator< char >() );
+}
+
+//-*****************************************************************************
+void writeFile( const std::string & iName, const std::string & iData )
+{
+    std::ofstream file( iName.c_str(), std::ios::out | std::ios::binary );
+    file.write( iData.data(), iData.size() );
+}
+
+//-*****************************************************************************
+// flips a bit in the first copy of iBytes in iData
+void corrupt( std::string & ioData, const void * iBytes, std::size_t iSize )
+{
+    std::size_t pos = ioData.find( std::string(
+        static_cast< const char * >( iBytes ), iSize ) );
+    TESTING_ASSERT( pos != std::string::npos );
+    ioData[pos + iSize - 1] ^= 0x10;
+}
+
+//-*****************************************************************************
+void testClean( const std::string & iName )
+{
+    for ( std::size_t numThreads = 1; numThreads < 9; numThreads *= 2 )
+    {
+        AO::VerifyOptions options;
+        options.numThreads = numThreads;
+        AO::VerifyReport report = AO::VerifyArchive( iName, options );
+
+        TESTING_ASSERT( report.ok() );
+        TESTING_ASSERT( report.valid && report.frozen );
+        TESTING_ASSERT( report.errors.empty() );
+        TESTING_ASSERT( report.corruptObjects.empty() );
+        TESTING_ASSERT( report.numObjects == kNumObjects + 1 );
+
+        // P, ids, empty, frame, arb, names and wnames
+        TESTING_ASSERT( report.numProperties == kNumObjects * 7 );
+        TESTING_ASSERT( report.numSamples ==
+                        kNumObjects * ( 2 * kNumSamples + 4 ) );
+        TESTING_ASSERT( report.bytesChecked > kNumObjects * kNumSamples *
+                        kNumPoints * 3 * sizeof( Alembic::Util::float32_t ) );
+        TESTING_ASSERT( report.numCorruptSamples == 0 );
+        TESTING_ASSERT( report.corruptBytes == 0 );
+    }
+}
+
+//-*****************************************************************************
+void testCorruptSample( const std::string & iName )
+{
+    std::string data = readFile( iName );
+    Alembic::Util::float32_t val = firstPoint( 3, 5 );
+    corrupt( data, &val, sizeof( val ) );
+    writeFile( "verifyCorruptSample.abc", data );
+
+    AO::VerifyReport report = AO::VerifyArchive( "verifyCorruptSample.abc" );
+    TESTING_ASSERT( !report.ok() );
+    TESTING_ASSERT( report.numObjects == kNumObjects + 1 );
+    TESTING_ASSERT( report.numCorruptSamples == 1 );
+    TESTING_ASSERT( report.corruptBytes ==
+        16 + kNumPoints * 3 * sizeof( Alembic::Util::float32_t ) );
+    TESTING_ASSERT( report.corruptObjects.size() == 1 );
+    TESTING_ASSERT( report.corruptObjects[0] == "/obj3" );
+    TESTING_ASSERT( report.errors.size() == 1 );
+    std::cout << report.errors[0] << std::endl;
+}
+
+//-*****************************************************************************
+void testCorruptSharedSample( const std::string & iName )
+{
+    std::string data = readFile( iName );
+    Alembic::Util::int32_t val = 0x5a5a0000 + 7;
+    corrupt( data, &val, sizeof( val ) );
+    writeFile( "verifyCorruptShared.abc", data );
+
+    // the block is checked once, but every object using it is reported
+    AO::VerifyReport report = AO::VerifyArchive( "verifyCorruptShared.abc" );
+    TESTING_ASSERT( !report.ok() );
+    TESTING_ASSERT( report.numCorruptSamples == kNumObjects );
+    TESTING_ASSERT( report.corruptBytes ==
+        16 + kNumPoints * sizeof( Alembic::Util::int32_t ) );
+    TESTING_ASSERT( report.corruptObjects.size() == kNumObjects );
+}
+
+//-*****************************************************************************
+void testCorruptString( const std::string & iName )
+{
+    std::string data = readFile( iName );
+    std::string name( "obj6\0obj6", 9 );
+    corrupt( data, name.data(), name.size() );
+    writeFile( "verifyCorruptString.abc", data );
+
+    AO::VerifyReport report = AO::VerifyArchive( "verifyCorruptString.abc" );
+    TESTING_ASSERT( report.numCorruptSamples == 1 );
+    TESTING_ASSERT( report.corruptObjects.size() == 1 );
+    TESTING_ASSERT( report.corruptObjects[0] == "/obj6" );
+}
+
+//-*****************************************************************************
+void testTruncated( const std::string & iName )
+{
+    std::string data = readFile( iName );
+    writeFile( "verifyTruncated.abc", data.substr( 0, data.size() / 2 ) );
+
+    AO::VerifyReport report = AO::VerifyArchive( "verifyTruncated.abc" );
+    TESTING_ASSERT( !report.ok() );
+    TESTING_ASSERT( report.valid && report.frozen );
+    TESTING_ASSERT( !report.errors.empty() );
+    std::cout << report.errors[0] << std::endl;
+}
+
+//-*****************************************************************************
+void testNotFrozen( const std::string & iName )
+{
+    std::string data = readFile( iName );
+    data[5] = 0;
+    writeFile( "verifyNotFrozen.abc", data );
+
+    AO::VerifyReport report = AO::VerifyArchive( "verifyNotFrozen.abc" );
+    TESTING_ASSERT( !report.ok() );
+    TESTING_ASSERT( report.valid && !report.frozen );
+
+    report = AO::VerifyArchive( "verifyDoesNotExist.abc" );
+    TESTING_ASSERT( !report.ok() );
+    TESTING_ASSERT( !report.valid );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string name = "verifyTest.abc";
+    writeArchive( name );
+
+    testClean( name );
+    testCorruptSample( name );
+    testCorruptSharedSample( name );
+    testCorruptString( name );
+    testTruncated( name );
+    testNotFrozen( name );
+
+    return 0;
+}
@@ -0,0 +1,514 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcCoreOgawa/Verify.h>
+#include <Alembic/AbcCoreOgawa/ArImpl.h>
+#include <Alembic/AbcCoreOgawa/AprImpl.h>
+#include <Alembic/AbcCoreOgawa/SprImpl.h>
+#include <Alembic/AbcCoreOgawa/ReadContextImpl.h>
+#include <Alembic/AbcCoreOgawa/ReadWrite.h>
+#include <Alembic/Util/Murmur3.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+//-*****************************************************************************
+// Checks that the children of every group reachable from the top one lie
+// within the file, without going through Ogawa, whose streams don't
+// recover from a read past the end.  Returns whether all of them do.
+bool CheckOffsets( std::istream & iStream, Util::uint64_t iFileSize,
+                   Util::uint64_t iTopPos, std::vector< std::string > & oErrors )
+{
+    std::vector< Util::uint64_t > groups( 1, iTopPos );
+    std::set< Util::uint64_t > seen;
+    std::size_t numErrors = oErrors.size();
+
+    while ( !groups.empty() )
+    {
+        Util::uint64_t pos = groups.back();
+        groups.pop_back();
+
+        if ( pos == Ogawa::EMPTY_GROUP || !seen.insert( pos ).second )
+        {
+            continue;
+        }
+
+        Util::uint64_t numChildren = 0;
+        if ( pos > iFileSize - 8 )
+        {
+            std::ostringstream msg;
+            msg << "group at " << pos << " is past the end of the file";
+            oErrors.push_back( msg.str() );
+            continue;
+        }
+
+        iStream.seekg( pos );
+        iStream.read( ( char * ) &numChildren, 8 );
+        if ( numChildren > ( iFileSize - pos - 8 ) / 8 )
+        {
+            std::ostringstream msg;
+            msg << "group at " << pos << " has " << numChildren
+                << " children, more than fit in the file";
+            oErrors.push_back( msg.str() );
+            continue;
+        }
+
+        std::vector< Util::uint64_t > children( numChildren );
+        if ( numChildren > 0 )
+        {
+            iStream.read( ( char * ) &children.front(), numChildren * 8 );
+        }
+
+        for ( std::size_t i = 0; i < children.size(); ++i )
+        {
+            if ( ( children[i] & Ogawa::EMPTY_DATA ) == 0 )
+            {
+                groups.push_back( children[i] );
+                continue;
+            }
+
+            Util::uint64_t dataPos = children[i] & ~Ogawa::EMPTY_DATA;
+            if ( dataPos == 0 )
+            {
+                continue;
+            }
+
+            Util::uint64_t size = 0;
+            if ( dataPos <= iFileSize - 8 )
+            {
+                iStream.seekg( dataPos );
+                iStream.read( ( char * ) &size, 8 );
+            }
+
+            if ( dataPos > iFileSize - 8 || size > iFileSize - dataPos - 8 )
+            {
+                std::ostringstream msg;
+                msg << "data " << i << " of the group at " << pos
+                    << " runs past the end of the file";
+                oErrors.push_back( msg.str() );
+            }
+        }
+    }
+
+    return oErrors.size() == numErrors;
+}
+
+//-*****************************************************************************
+struct Sample
+{
+    Sample( std::size_t iObject, AprImplPtr iArray,
+            Util::shared_ptr< SprImpl > iScalar, index_t iIndex )
+      : object( iObject ), array( iArray ), scalar( iScalar ),
+        index( iIndex ), pos( 0 ), readable( false ) {}
+
+    // into the object names
+    std::size_t object;
+
+    // one of these is set
+    AprImplPtr array;
+    Util::shared_ptr< SprImpl > scalar;
+
+    index_t index;
+
+    // where its block is, once it has been found
+    Util::uint64_t pos;
+    bool readable;
+};
+
+//-*****************************************************************************
+struct Block
+{
+    Block( Util::uint64_t iSize = 0 ) : size( iSize ), corrupt( false ) {}
+
+    Util::uint64_t size;
+    bool corrupt;
+};
+
+//-*****************************************************************************
+// what the verifying threads share, everything but the samples themselves
+// is guarded by lock
+struct Work
+{
+    Work( ArImpl * iArchive, std::vector< Sample > & iSamples )
+      : archive( iArchive ), samples( iSamples ), next( 0 ) {}
+
+    ArImpl * archive;
+    std::vector< Sample > & samples;
+
+    Util::mutex lock;
+    std::size_t next;
+
+    // by position, each block is hashed by whichever thread gets to it first
+    std::map< Util::uint64_t, Block > blocks;
+};
+
+//-*****************************************************************************
+void CollectProperties( AbcA::CompoundPropertyReaderPtr iParent,
+                        std::size_t iObject,
+                        std::vector< Sample > & oSamples,
+                        VerifyReport & oReport )
+{
+    for ( std::size_t i = 0; i < iParent->getNumProperties(); ++i )
+    {
+        const AbcA::PropertyHeader & header = iParent->getPropertyHeader( i );
+        oReport.numProperties ++;
+
+        if ( header.isCompound() )
+        {
+            CollectProperties( iParent->getCompoundProperty( i ), iObject,
+                               oSamples, oReport );
+        }
+        else if ( header.isArray() )
+        {
+            AprImplPtr apr = Util::dynamic_pointer_cast< AprImpl,
+                AbcA::ArrayPropertyReader >( iParent->getArrayProperty( i ) );
+            for ( std::size_t j = 0; j < apr->getNumSamples(); ++j )
+            {
+                oSamples.push_back( Sample( iObject, apr,
+                    Util::shared_ptr< SprImpl >(), j ) );
+            }
+        }
+        else
+        {
+            Util::shared_ptr< SprImpl > spr = Util::dynamic_pointer_cast<
+                SprImpl, AbcA::ScalarPropertyReader >(
+                    iParent->getScalarProperty( i ) );
+            for ( std::size_t j = 0; j < spr->getNumSamples(); ++j )
+            {
+                oSamples.push_back( Sample( iObject, AprImplPtr(), spr, j ) );
+            }
+        }
+    }
+}
+
+//-*****************************************************************************
+// a header which can't be read takes what is below it with it, so the
+// object is reported and the walk goes on with its siblings
+void CollectObject( AbcA::ObjectReaderPtr iObject,
+                    std::vector< std::string > & ioNames,
+                    std::vector< Sample > & oSamples,
+                    VerifyReport & oReport )
+{
+    std::size_t index = ioNames.size();
+    ioNames.push_back( iObject->getFullName() );
+    oReport.numObjects ++;
+
+    try
+    {
+        CollectProperties( iObject->getProperties(), index, oSamples,
+                           oReport );
+    }
+    catch ( std::exception & e )
+    {
+        oReport.corruptObjects.push_back( ioNames[index] );
+        oReport.errors.push_back( ioNames[index] + ": " + e.what() );
+    }
+
+    for ( std::size_t i = 0; i < iObject->getNumChildren(); ++i )
+    {
+        AbcA::ObjectReaderPtr child;
+        try
+        {
+            child = iObject->getChild( i );
+        }
+        catch ( std::exception & e )
+        {
+            std::ostringstream name;
+            name << iObject->getFullName() << " child " << i;
+            oReport.corruptObjects.push_back( name.str() );
+            oReport.errors.push_back( name.str() + ": " + e.what() );
+            continue;
+        }
+
+        CollectObject( child, ioNames, oSamples, oReport );
+    }
+}
+
+//-*****************************************************************************
+// whether the data of the block iData points at hashes to the key in front
+// of it
+bool HashMatches( Ogawa::IData & iData, Util::PlainOldDataType iPod,
+                  std::size_t iStreamID, std::vector< char > & ioBuffer )
+{
+    // empty samples are written without a key
+    Util::uint64_t size = iData.getSize();
+    if ( size == 0 )
+    {
+        return true;
+    }
+    else if ( size < 16 )
+    {
+        return false;
+    }
+
+    ioBuffer.resize( size );
+    iData.read( size, &ioBuffer.front(), 0, iStreamID );
+
+    std::size_t podSize = 1;
+    if ( iPod == Util::kWstringPOD )
+    {
+        podSize = sizeof( Util::int32_t );
+    }
+    else if ( iPod != Util::kStringPOD )
+    {
+        podSize = Util::PODNumBytes( iPod );
+    }
+
+    Util::Digest digest;
+    Util::MurmurHash3_x64_128( size > 16 ? &ioBuffer[16] : NULL, size - 16,
+                               podSize, digest.words );
+    if ( std::memcmp( digest.d, &ioBuffer.front(), 16 ) == 0 )
+    {
+        return true;
+    }
+
+    // wstring keys have always been written as the hash of nothing
+    if ( iPod == Util::kWstringPOD )
+    {
+        Util::MurmurHash3_x64_128( NULL, 0, podSize, digest.words );
+        return std::memcmp( digest.d, &ioBuffer.front(), 16 ) == 0;
+    }
+
+    return false;
+}
+
+//-*****************************************************************************
+void * Verify( void * iWork )
+{
+    Work & work = *( static_cast< Work * >( iWork ) );
+    ReadContextImpl context( work.archive, work.archive->getStreamID() );
+    std::vector< char > buffer;
+
+    for ( ;; )
+    {
+        std::size_t i = 0;
+        {
+            Util::scoped_lock l( work.lock );
+            if ( work.next == work.samples.size() )
+            {
+                break;
+            }
+            i = work.next ++;
+        }
+
+        Sample & sample = work.samples[i];
+        Ogawa::IData & data = context.getData();
+        Util::PlainOldDataType pod = Util::kUnknownPOD;
+        try
+        {
+            if ( sample.array )
+            {
+                sample.readable = sample.array->getSampleData(
+                    sample.index, context, data );
+                pod = sample.array->getHeader().getDataType().getPod();
+            }
+            else
+            {
+                sample.readable = sample.scalar->getSampleData(
+                    sample.index, context, data );
+                pod = sample.scalar->getHeader().getDataType().getPod();
+            }
+        }
+        catch ( std::exception & )
+        {
+            sample.readable = false;
+        }
+
+        if ( !sample.readable )
+        {
+            continue;
+        }
+
+        sample.pos = data.getPos();
+        {
+            Util::scoped_lock l( work.lock );
+            if ( !work.blocks.insert( std::make_pair( sample.pos,
+                     Block( data.getSize() ) ) ).second )
+            {
+                continue;
+            }
+        }
+
+        bool corrupt = !HashMatches( data, pod, context.getStreamID(),
+                                     buffer );
+        if ( corrupt )
+        {
+            Util::scoped_lock l( work.lock );
+            work.blocks[sample.pos].corrupt = true;
+        }
+    }
+
+    return NULL;
+}
+
+} // End namespace
+
+//-*****************************************************************************
+VerifyReport VerifyArchive( const std::string & iFileName,
+                            const VerifyOptions & iOptions )
+{
+    VerifyReport report;
+
+    std::ifstream file( iFileName.c_str(), std::ios::in | std::ios::binary );
+    char header[16];
+    std::memset( header, 0, 16 );
+    file.read( header, 16 );
+    if ( !file || std::string( header, 5 ) != "Ogawa" )
+    {
+        report.errors.push_back( "not an Ogawa file: " + iFileName );
+        return report;
+    }
+
+    report.valid = true;
+    report.frozen = ( header[5] == char( 0xff ) );
+    if ( !report.frozen )
+    {
+        report.errors.push_back( "the file wasn't cleanly closed while it "
+                                 "was being written" );
+        return report;
+    }
+
+    file.seekg( 0, std::ios::end );
+    Util::uint64_t fileSize = file.tellg();
+    Util::uint64_t topPos = 0;
+    std::memcpy( &topPos, &header[8], 8 );
+
+    if ( !CheckOffsets( file, fileSize, topPos, report.errors ) )
+    {
+        // reading through offsets like these isn't safe
+        return report;
+    }
+    file.close();
+
+    std::size_t numThreads = std::max( iOptions.numThreads, std::size_t( 1 ) );
+
+    AbcA::ArchiveReaderPtr archive;
+    std::vector< std::string > names;
+    std::vector< Sample > samples;
+    try
+    {
+        archive = ReadArchive( numThreads, numThreads,
+                               kWaitStreamPolicy )( iFileName );
+        CollectObject( archive->getTop(), names, samples, report );
+    }
+    catch ( std::exception & e )
+    {
+        report.errors.push_back( e.what() );
+        return report;
+    }
+
+    Work work( dynamic_cast< ArImpl * >( archive.get() ), samples );
+
+    std::vector< Util::thread * > threads;
+    for ( std::size_t i = 0; i < numThreads; ++i )
+    {
+        Util::thread * thread = new Util::thread( Verify, &work );
+        if ( !thread->valid() )
+        {
+            delete thread;
+            break;
+        }
+        threads.push_back( thread );
+    }
+
+    // without any threads, do the work here
+    if ( threads.empty() )
+    {
+        Verify( &work );
+    }
+
+    for ( std::size_t i = 0; i < threads.size(); ++i )
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    std::set< std::size_t > corruptObjects;
+    for ( std::size_t i = 0; i < samples.size(); ++i )
+    {
+        const Sample & sample = samples[i];
+        report.numSamples ++;
+
+        if ( sample.readable && !work.blocks[sample.pos].corrupt )
+        {
+            continue;
+        }
+
+        report.numCorruptSamples ++;
+        corruptObjects.insert( sample.object );
+
+        const AbcA::PropertyHeader & header = sample.array ?
+            sample.array->getHeader() : sample.scalar->getHeader();
+        std::ostringstream msg;
+        msg << names[sample.object] << ": sample " << sample.index
+            << " of " << header.getName()
+            << ( sample.readable ? " doesn't match its key" :
+                                   " couldn't be read" );
+        report.errors.push_back( msg.str() );
+    }
+
+    std::map< Util::uint64_t, Block >::iterator it;
+    for ( it = work.blocks.begin(); it != work.blocks.end(); ++it )
+    {
+        report.bytesChecked += it->second.size;
+        if ( it->second.corrupt )
+        {
+            report.corruptBytes += it->second.size;
+        }
+    }
+
+    std::set< std::size_t >::iterator ct;
+    for ( ct = corruptObjects.begin(); ct != corruptObjects.end(); ++ct )
+    {
+        report.corruptObjects.push_back( names[*ct] );
+    }
+
+    return report;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
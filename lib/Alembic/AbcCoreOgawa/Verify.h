@@ -0,0 +1,120 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcCoreOgawa_Verify_h_
+#define _Alembic_AbcCoreOgawa_Verify_h_
+
+#include <Alembic/AbcCoreAbstract/All.h>
+
+namespace Alembic {
+namespace AbcCoreOgawa {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! How VerifyArchive goes about checking.
+struct VerifyOptions
+{
+    VerifyOptions() : numThreads( 4 ) {}
+
+    //! How many threads, each reading through a stream of its own, hash
+    //! the sample data.
+    std::size_t numThreads;
+};
+
+//-*****************************************************************************
+//! What VerifyArchive found.
+struct VerifyReport
+{
+    VerifyReport()
+      : valid( false ), frozen( false ), numObjects( 0 ), numProperties( 0 ),
+        numSamples( 0 ), bytesChecked( 0 ), numCorruptSamples( 0 ),
+        corruptBytes( 0 ) {}
+
+    //! Whether nothing wrong was found.
+    bool ok() const
+    {
+        return valid && frozen && numCorruptSamples == 0 && errors.empty();
+    }
+
+    //! Whether the file is an Ogawa file at all.
+    bool valid;
+
+    //! Whether the file was cleanly closed when written.
+    bool frozen;
+
+    Alembic::Util::uint64_t numObjects;
+    Alembic::Util::uint64_t numProperties;
+
+    //! Samples checked, a sample which is stored once and used by many
+    //! properties, or repeated in time, counts for each.
+    Alembic::Util::uint64_t numSamples;
+
+    //! Sample bytes hashed, each stored block counted once.
+    Alembic::Util::uint64_t bytesChecked;
+
+    //! Samples whose data didn't match the key stored with it, or which
+    //! couldn't be read at all.
+    Alembic::Util::uint64_t numCorruptSamples;
+
+    //! Bytes of the stored blocks behind those samples.
+    Alembic::Util::uint64_t corruptBytes;
+
+    //! Full names of the objects with corrupt samples, or whose headers
+    //! couldn't be read.
+    std::vector< std::string > corruptObjects;
+
+    //! What went wrong, one message each.
+    std::vector< std::string > errors;
+};
+
+//-*****************************************************************************
+//! Checks the Ogawa archive at iFileName for damage.  The header, the
+//! frozen flag and every group's offsets are checked against the size of
+//! the file first, then every object and property header is read, and the
+//! data of every sample is hashed again and compared to the key which was
+//! stored with it when it was written.  The hashing is spread across
+//! iOptions.numThreads threads.  Problems are reported rather than thrown.
+VerifyReport VerifyArchive( const std::string & iFileName,
+                            const VerifyOptions & iOptions = VerifyOptions() );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcCoreOgawa
+} // End namespace Alembic
+
+#endif
@@ -41,6 +41,11 @@ namespace Alembic {
 namespace AbcCoreOgawa {
 namespace ALEMBIC_VERSION_NS {
 
+//-*****************************************************************************
+// samples may be written from several threads, since the counters are only
+// kept when asked for one lock shared by every archive is plenty
+static Alembic::Util::mutex g_statsLock;
+
 //-*****************************************************************************
 void pushUint32WithHint( std::vector< Util::uint8_t > & ioData,
                          Util::uint32_t iVal, Util::uint32_t iHint )
@@ -156,6 +161,25 @@ GetWrittenSampleMap( AbcA::ArchiveWriterPtr iVal )
     return ptr->getWrittenSampleMap();
 }
 
+//-*****************************************************************************
+void UpdateMaxNumSamples( AbcA::ArchiveWriterPtr iArchive,
+                          Util::uint32_t iIndex,
+                          Util::uint32_t iNumSamples )
+{
+    AwImpl *ptr = dynamic_cast<AwImpl*>( iArchive.get() );
+    ABCA_ASSERT( ptr, "NULL Impl Ptr" );
+    ptr->updateMaxNumSamples( iIndex, iNumSamples );
+}
+
+//-*****************************************************************************
+AbcA::ArchiveStats *
+GetWriteStats( AbcA::ArchiveWriterPtr iVal )
+{
+    AwImpl *ptr = dynamic_cast<AwImpl*>( iVal.get() );
+    ABCA_ASSERT( ptr, "NULL Impl Ptr" );
+    return ptr->getEnabledWriteStats();
+}
+
 //-*****************************************************************************
 void WriteDimensions( Ogawa::OGroupPtr iGroup,
                       const AbcA::Dimensions & iDims,
@@ -183,7 +207,8 @@ WrittenSampleIDPtr
 WriteData( WrittenSampleMap &iMap,
            Ogawa::OGroupPtr iGroup,
            const AbcA::ArraySample &iSamp,
-           const AbcA::ArraySample::Key &iKey )
+           const AbcA::ArraySample::Key &iKey,
+           AbcA::ArchiveStats * iStats )
 {
 
     // Okay, need to actually store it.
@@ -195,7 +220,7 @@ WriteData( WrittenSampleMap &iMap,
     WrittenSampleIDPtr writeID = iMap.find( iKey );
     if ( writeID )
     {
-        CopyWrittenData( iGroup, writeID );
+        CopyWrittenData( iGroup, writeID, iStats );
         return writeID;
     }
 
@@ -269,13 +294,21 @@ WriteData( WrittenSampleMap &iMap,
                         dataType.getExtent() * dims.numPoints() ) );
     iMap.store( writeID );
 
+    if ( iStats )
+    {
+        Alembic::Util::scoped_lock l( g_statsLock );
+        iStats->samplesWritten ++;
+        iStats->bytesWritten += dataPtr->getSize();
+    }
+
     // Return the reference.
     return writeID;
 }
 
 //-*****************************************************************************
 void CopyWrittenData( Ogawa::OGroupPtr iGroup,
-                      WrittenSampleIDPtr iRef )
+                      WrittenSampleIDPtr iRef,
+                      AbcA::ArchiveStats * iStats )
 {
     ABCA_ASSERT( ( bool )iRef,
                   "CopyWrittenData() passed a bogus ref" );
@@ -284,6 +317,13 @@ void CopyWrittenData( Ogawa::OGroupPtr iGroup,
                 "CopyWrittenData() passed in a bogus OGroupPtr" );
 
     iGroup->addData(iRef->getObjectLocation());
+
+    if ( iStats )
+    {
+        Alembic::Util::scoped_lock l( g_statsLock );
+        iStats->samplesDeduped ++;
+        iStats->bytesDeduped += iRef->getObjectLocation()->getSize();
+    }
 }
 
 //-*****************************************************************************
@@ -59,23 +59,37 @@ void HashDimensions( const AbcA::Dimensions & iDims,
 WrittenSampleMap& GetWrittenSampleMap(
     AbcA::ArchiveWriterPtr iArchive );
 
+//-*****************************************************************************
+// Raises the max number of samples recorded for the time sampling at iIndex
+// to iNumSamples, if it is lower.  Properties of different objects may be
+// finished on different threads, so the check and the raise happen together.
+void UpdateMaxNumSamples( AbcA::ArchiveWriterPtr iArchive,
+                          Util::uint32_t iIndex,
+                          Util::uint32_t iNumSamples );
+
 //-*****************************************************************************
 void
 WriteDimensions( Ogawa::OGroupPtr iGroup,
                  const AbcA::Dimensions & iDims,
                  Alembic::Util::PlainOldDataType iPod );
 
+//-*****************************************************************************
+// NULL unless the archive is gathering stats.
+AbcA::ArchiveStats * GetWriteStats( AbcA::ArchiveWriterPtr iArchive );
+
 //-*****************************************************************************
 void
 CopyWrittenData( Ogawa::OGroupPtr iParent,
-                 WrittenSampleIDPtr iRef );
+                 WrittenSampleIDPtr iRef,
+                 AbcA::ArchiveStats * iStats = NULL );
 
 //-*****************************************************************************
 WrittenSampleIDPtr
 WriteData( WrittenSampleMap &iMap,
            Ogawa::OGroupPtr iGroup,
            const AbcA::ArraySample &iSamp,
-           const AbcA::ArraySample::Key &iKey );
+           const AbcA::ArraySample::Key &iKey,
+           AbcA::ArchiveStats * iStats = NULL );
 
 //-*****************************************************************************
 void
@@ -88,6 +88,9 @@ typedef Alembic::Util::shared_ptr<WrittenSampleID> WrittenSampleIDPtr;
 
 //-*****************************************************************************
 // This class handles the mapping.
+// Properties may be written from different threads at the same time, so the
+// map is split into shards by key, each with its own lock, which keeps those
+// threads from waiting on each other most of the time.
 class WrittenSampleMap
 {
 protected:
@@ -100,8 +103,11 @@ public:
     // Returns 0 if it can't find it
     WrittenSampleIDPtr find( const AbcA::ArraySample::Key &key ) const
     {
-        Map::const_iterator miter = m_map.find( key );
-        if ( miter != m_map.end() )
+        Shard & shard = getShard( key );
+        Alembic::Util::scoped_lock l( shard.lock );
+
+        Map::const_iterator miter = shard.map.find( key );
+        if ( miter != shard.map.end() )
         {
             return (*miter).second;
         }
@@ -119,17 +125,38 @@ public:
             ABCA_THROW( "Invalid WrittenSampleIDPtr" );
         }
 
-        m_map[r->getKey()] = r;
+        Shard & shard = getShard( r->getKey() );
+        Alembic::Util::scoped_lock l( shard.lock );
+        shard.map[r->getKey()] = r;
     }
 
     void clear()
     {
-        m_map.clear();
+        for ( std::size_t i = 0; i < NUM_SHARDS; ++i )
+        {
+            Alembic::Util::scoped_lock l( m_shards[i].lock );
+            m_shards[i].map.clear();
+        }
     }
 
 protected:
     typedef AbcA::UnorderedMapUtil<WrittenSampleIDPtr>::umap_type Map;
-    Map m_map;
+
+    struct Shard
+    {
+        Alembic::Util::mutex lock;
+        Map map;
+    };
+
+    static const std::size_t NUM_SHARDS = 16;
+
+    Shard & getShard( const AbcA::ArraySample::Key &key ) const
+    {
+        // the digest is already a good hash
+        return m_shards[ key.digest.words[0] % NUM_SHARDS ];
+    }
+
+    mutable Shard m_shards[NUM_SHARDS];
 };
 
 } // End namespace ALEMBIC_VERSION_NS
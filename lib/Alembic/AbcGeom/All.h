@@ -38,6 +38,8 @@
 #define _Alembic_AbcGeom_All_h_
 
 #include <Alembic/AbcGeom/ArchiveBounds.h>
+#include <Alembic/AbcGeom/BakeBounds.h>
+#include <Alembic/AbcGeom/MeshLod.h>
 
 #include <Alembic/AbcGeom/GeometryScope.h>
 
@@ -0,0 +1,367 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcGeom/BakeBounds.h>
+#include <Alembic/AbcGeom/ArchiveBounds.h>
+#include <Alembic/AbcGeom/IGeomBase.h>
+#include <Alembic/AbcGeom/IXform.h>
+
+#include <ImathBoxAlgo.h>
+
+#include <algorithm>
+#include <set>
+
+namespace Alembic {
+namespace AbcGeom {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+//-*****************************************************************************
+struct Node
+{
+    Node() : isXform( false ) {}
+
+    std::string name;
+    std::vector< std::size_t > children;
+
+    bool isXform;
+    IXformSchema xform;
+
+    // only valid for geometry
+    Abc::IBox3dProperty selfBounds;
+
+    // one per baked time
+    std::vector< Abc::Box3d > childBoundsAt;
+    std::vector< Abc::Box3d > selfBoundsAt;
+};
+
+//-*****************************************************************************
+void CollectNodes( IObject iObject, std::vector< Node > & oNodes )
+{
+    std::size_t index = oNodes.size();
+    oNodes.push_back( Node() );
+    oNodes[index].name = iObject.getName();
+
+    const AbcA::MetaData & md = iObject.getMetaData();
+    if ( IXform::matches( md ) )
+    {
+        oNodes[index].isXform = true;
+        oNodes[index].xform = IXform( iObject, kWrapExisting ).getSchema();
+    }
+    else if ( IGeomBase::matches( md ) )
+    {
+        IGeomBase geom = IGeomBaseObject( iObject, kWrapExisting ).getSchema();
+        oNodes[index].selfBounds = geom.getSelfBoundsProperty();
+    }
+
+    for ( std::size_t i = 0; i < iObject.getNumChildren(); ++i )
+    {
+        std::size_t child = oNodes.size();
+        oNodes[index].children.push_back( child );
+        CollectNodes( iObject.getChild( i ), oNodes );
+    }
+}
+
+//-*****************************************************************************
+void CollectTimes( AbcA::TimeSamplingPtr iTs, std::size_t iNumSamples,
+                   std::set< chrono_t > & oTimes )
+{
+    for ( std::size_t i = 0; i < iNumSamples; ++i )
+    {
+        oTimes.insert( iTs->getSampleTime( i ) );
+    }
+}
+
+//-*****************************************************************************
+// Returns the bounds of the descendants of iNodes[iIndex] in its own space,
+// which is iWorld in world space, and stores them along the way.
+Abc::Box3d Gather( std::vector< Node > & iNodes, std::size_t iIndex,
+                   std::size_t iTimeIndex, const Abc::ISampleSelector & iSS,
+                   const Abc::M44d & iWorld )
+{
+    Abc::Box3d bounds;
+
+    const std::vector< std::size_t > & children = iNodes[iIndex].children;
+    for ( std::size_t i = 0; i < children.size(); ++i )
+    {
+        Node & child = iNodes[children[i]];
+
+        if ( child.isXform )
+        {
+            XformSample samp = child.xform.getValue( iSS );
+            Abc::M44d local = samp.getMatrix();
+            bool inherits = samp.getInheritsXforms();
+
+            Abc::Box3d childBounds = Gather( iNodes, children[i], iTimeIndex,
+                iSS, inherits ? local * iWorld : local );
+
+            if ( !childBounds.isEmpty() )
+            {
+                // xforms which don't inherit are placed in world space, so
+                // bring them back into ours
+                bounds.extendBy( Imath::transform( childBounds,
+                    inherits ? local : local * iWorld.inverse() ) );
+            }
+        }
+        else
+        {
+            bounds.extendBy(
+                Gather( iNodes, children[i], iTimeIndex, iSS, iWorld ) );
+
+            if ( child.selfBounds.valid() &&
+                 child.selfBounds.getNumSamples() > 0 )
+            {
+                child.selfBoundsAt[iTimeIndex] =
+                    child.selfBounds.getValue( iSS );
+                bounds.extendBy( child.selfBoundsAt[iTimeIndex] );
+            }
+        }
+    }
+
+    iNodes[iIndex].childBoundsAt[iTimeIndex] = bounds;
+    return bounds;
+}
+
+//-*****************************************************************************
+struct Work
+{
+    Work( std::vector< Node > & iNodes,
+          const std::vector< chrono_t > & iTimes )
+      : nodes( iNodes ), times( iTimes ), next( 0 ) {}
+
+    std::vector< Node > & nodes;
+    const std::vector< chrono_t > & times;
+
+    Util::mutex lock;
+    std::size_t next;
+    std::string error;
+};
+
+//-*****************************************************************************
+// Each call gathers the bounds at a different time, so the values they
+// store never overlap.
+void * Bake( void * iWork )
+{
+    Work & work = *static_cast< Work * >( iWork );
+
+    for ( ;; )
+    {
+        std::size_t t = 0;
+        {
+            Util::scoped_lock l( work.lock );
+            if ( work.next >= work.times.size() || !work.error.empty() )
+            {
+                break;
+            }
+            t = work.next ++;
+        }
+
+        try
+        {
+            Abc::ISampleSelector ss( work.times[t],
+                                     Abc::ISampleSelector::kFloorIndex );
+            Gather( work.nodes, 0, t, ss, Abc::M44d() );
+        }
+        catch ( std::exception & e )
+        {
+            Util::scoped_lock l( work.lock );
+            if ( work.error.empty() )
+            {
+                work.error = e.what();
+            }
+        }
+    }
+
+    return NULL;
+}
+
+//-*****************************************************************************
+void WriteNode( const std::vector< Node > & iNodes, std::size_t iIndex,
+                OObject & iObject, Util::uint32_t iTsIndex )
+{
+    const Node & node = iNodes[iIndex];
+
+    Abc::OBox3dProperty childBounds( iObject.getProperties(), ".childBnds",
+                                     iTsIndex );
+    for ( std::size_t i = 0; i < node.childBoundsAt.size(); ++i )
+    {
+        childBounds.set( node.childBoundsAt[i] );
+    }
+
+    if ( node.selfBounds.valid() )
+    {
+        Abc::OBox3dProperty selfBounds( iObject.getProperties(), ".selfBnds",
+                                        iTsIndex );
+        for ( std::size_t i = 0; i < node.selfBoundsAt.size(); ++i )
+        {
+            selfBounds.set( node.selfBoundsAt[i] );
+        }
+    }
+
+    for ( std::size_t i = 0; i < node.children.size(); ++i )
+    {
+        OObject child( iObject, iNodes[node.children[i]].name );
+        WriteNode( iNodes, node.children[i], child, iTsIndex );
+    }
+}
+
+//-*****************************************************************************
+Abc::IBox3dProperty GetBakedBounds( IArchive & iSidecar,
+                                    const IObject & iObject,
+                                    const std::string & iName )
+{
+    IObject obj = iSidecar.getTop();
+
+    const std::string & fullName = iObject.getFullName();
+    std::size_t start = 1;
+    while ( obj.valid() && start < fullName.size() )
+    {
+        std::size_t end = fullName.find( '/', start );
+        if ( end == std::string::npos )
+        {
+            end = fullName.size();
+        }
+
+        obj = obj.getChild( fullName.substr( start, end - start ) );
+        start = end + 1;
+    }
+
+    if ( !obj.valid() || !obj.getProperties().getPropertyHeader( iName ) )
+    {
+        return Abc::IBox3dProperty();
+    }
+
+    return Abc::IBox3dProperty( obj.getProperties(), iName );
+}
+
+} // End namespace
+
+//-*****************************************************************************
+void BakeBounds( IArchive & iArchive, OArchive & oSidecar,
+                 const BakeBoundsOptions & iOptions )
+{
+    std::vector< Node > nodes;
+    CollectNodes( iArchive.getTop(), nodes );
+
+    std::set< chrono_t > timeSet;
+    for ( std::size_t i = 0; i < nodes.size(); ++i )
+    {
+        if ( nodes[i].isXform )
+        {
+            CollectTimes( nodes[i].xform.getTimeSampling(),
+                          nodes[i].xform.getNumSamples(), timeSet );
+        }
+        else if ( nodes[i].selfBounds.valid() )
+        {
+            CollectTimes( nodes[i].selfBounds.getTimeSampling(),
+                          nodes[i].selfBounds.getNumSamples(), timeSet );
+        }
+    }
+
+    // nothing animated, or nothing at all, still gets bounds at 0
+    if ( timeSet.empty() )
+    {
+        timeSet.insert( 0.0 );
+    }
+
+    std::vector< chrono_t > times( timeSet.begin(), timeSet.end() );
+    for ( std::size_t i = 0; i < nodes.size(); ++i )
+    {
+        nodes[i].childBoundsAt.resize( times.size() );
+        if ( nodes[i].selfBounds.valid() )
+        {
+            nodes[i].selfBoundsAt.resize( times.size() );
+        }
+    }
+
+    Work work( nodes, times );
+    std::size_t numThreads = std::min( std::max( iOptions.numThreads,
+        std::size_t( 1 ) ), times.size() );
+
+    std::vector< Util::thread * > threads;
+    for ( std::size_t i = 0; numThreads > 1 && i < numThreads; ++i )
+    {
+        Util::thread * thread = new Util::thread( Bake, &work );
+        if ( !thread->valid() )
+        {
+            delete thread;
+            break;
+        }
+        threads.push_back( thread );
+    }
+
+    // without any threads, do the work here
+    if ( threads.empty() )
+    {
+        Bake( &work );
+    }
+
+    for ( std::size_t i = 0; i < threads.size(); ++i )
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    ABCA_ASSERT( work.error.empty(),
+                 "Couldn't bake the bounds of " << iArchive.getName() <<
+                 ": " << work.error );
+
+    Util::uint32_t tsIndex = oSidecar.addTimeSampling( AbcA::TimeSampling(
+        AbcA::TimeSamplingType( AbcA::TimeSamplingType::kAcyclic ), times ) );
+
+    // the top object's ".childBnds" is the archive bounds
+    OObject top = oSidecar.getTop();
+    WriteNode( nodes, 0, top, tsIndex );
+}
+
+//-*****************************************************************************
+Abc::IBox3dProperty GetBakedChildBounds( IArchive & iSidecar,
+                                         const IObject & iObject )
+{
+    return GetBakedBounds( iSidecar, iObject, ".childBnds" );
+}
+
+//-*****************************************************************************
+Abc::IBox3dProperty GetBakedSelfBounds( IArchive & iSidecar,
+                                        const IObject & iObject )
+{
+    return GetBakedBounds( iSidecar, iObject, ".selfBnds" );
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcGeom
+} // End namespace Alembic
@@ -0,0 +1,82 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcGeom_BakeBounds_h_
+#define _Alembic_AbcGeom_BakeBounds_h_
+
+#include <Alembic/AbcGeom/Foundation.h>
+
+namespace Alembic {
+namespace AbcGeom {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+struct BakeBoundsOptions
+{
+    BakeBoundsOptions() : numThreads( 4 ) {}
+
+    //! How many threads the sample times are spread across.
+    std::size_t numThreads;
+};
+
+//-*****************************************************************************
+//! Computes the bounds of every object of iArchive, at every time any of
+//! its xforms or geometry has a sample, and writes them to oSidecar.
+//! The sidecar mirrors the hierarchy of iArchive with plain objects of the
+//! same names, each with a ".childBnds" property holding the bounds of its
+//! descendants in its own space, and geometry with a ".selfBnds" one too.
+//! Xforms which don't inherit are accounted for.  The top object gets the
+//! archive bounds, so GetIArchiveBounds works on the sidecar.
+void BakeBounds( IArchive & iArchive, OArchive & oSidecar,
+                 const BakeBoundsOptions & iOptions = BakeBoundsOptions() );
+
+//! Returns the ".childBnds" property baked into iSidecar for iObject, or
+//! an invalid property if the sidecar has no object at its full name.
+Abc::IBox3dProperty GetBakedChildBounds( IArchive & iSidecar,
+                                         const IObject & iObject );
+
+//! The same for ".selfBnds", which only geometry has.
+Abc::IBox3dProperty GetBakedSelfBounds( IArchive & iSidecar,
+                                        const IObject & iObject );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcGeom
+} // End namespace Alembic
+
+#endif
@@ -71,6 +71,27 @@ MeshTopologyVariance ICurvesSchema::getTopologyVariance() const
     return kHeterogenousTopology;
 }
 
+//-*****************************************************************************
+bool ICurvesSchema::getInto( Abc::V3f *oPositions, size_t &ioNumPositions,
+                             Abc::int32_t *oNumVertices, size_t &ioNumCurves,
+                             const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "ICurvesSchema::getInto()" );
+
+    size_t capacity = ioNumPositions;
+    ioNumPositions = m_positionsProperty.getInto( oPositions, capacity, iSS );
+    bool fits = ioNumPositions <= capacity;
+
+    capacity = ioNumCurves;
+    ioNumCurves = m_nVerticesProperty.getInto( oNumVertices, capacity, iSS );
+    return fits && ioNumCurves <= capacity;
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw
+    return false;
+}
+
 //-*****************************************************************************
 void ICurvesSchema::init( const Abc::Argument &iArg0,
                           const Abc::Argument &iArg1 )
@@ -225,6 +225,16 @@ public:
         return smp;
     }
 
+    //! Reads the positions and the number of vertices per curve into caller
+    //! owned buffers, without allocating.  Each ioNum starts as the capacity
+    //! of its buffer in values and is replaced with the number of values in
+    //! the sample.  A buffer that is too small is left alone and false is
+    //! returned.  See Abc::IArrayProperty::getInto.
+    bool getInto( Abc::V3f *oPositions, size_t &ioNumPositions,
+                  Abc::int32_t *oNumVertices, size_t &ioNumCurves,
+                  const Abc::ISampleSelector &iSS =
+                  Abc::ISampleSelector() ) const;
+
     Abc::IV3fArrayProperty getVelocitiesProperty() const
     {
         return m_velocitiesProperty;
@@ -376,7 +376,7 @@ public:
 
         if ( iMatching == kStrictMatching || iMatching == kSchemaTitleMatching )
         {
-            return iMetaData.get( "schemaBaseType" ) ==
+            return iMetaData.getSchemaBaseType() ==
                 GeomBaseSchemaInfo::title();
         }
 
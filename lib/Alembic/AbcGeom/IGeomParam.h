@@ -137,6 +137,13 @@ public:
     void getExpanded( sample_type &oSamp,
                       const Abc::ISampleSelector &iSS = Abc::ISampleSelector() ) const;
 
+    //! Reads iCount expanded values, starting at value iStart, into
+    //! caller owned storage.  Only that range of the values, or of the
+    //! indices when this param is indexed, is read.
+    void getExpandedRange( value_type *oBuffer, size_t iStart, size_t iCount,
+                           const Abc::ISampleSelector &iSS =
+                           Abc::ISampleSelector() ) const;
+
     sample_type getIndexedValue( const Abc::ISampleSelector &iSS = \
                                  Abc::ISampleSelector() ) const
     {
@@ -398,6 +405,48 @@ ITypedGeomParam<TRAITS>::getExpanded( typename ITypedGeomParam<TRAITS>::Sample &
 
 }
 
+//-*****************************************************************************
+template <class TRAITS>
+void
+ITypedGeomParam<TRAITS>::getExpandedRange( value_type *oBuffer,
+                                           size_t iStart, size_t iCount,
+                                           const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "ITypedGeomParam::getExpandedRange()" );
+
+    Alembic::Util::Dimensions idxDims;
+    if ( m_indicesProperty )
+    {
+        m_indicesProperty.getDimensions( idxDims, iSS );
+    }
+
+    // not indexed, or no indices, the values are what we want
+    if ( idxDims.numPoints() == 0 )
+    {
+        m_valProp.getRange( oBuffer, iStart, iCount, iSS );
+        return;
+    }
+
+    std::vector< Alembic::Util::uint32_t > indices( iCount );
+    if ( iCount > 0 )
+    {
+        m_indicesProperty.getRange( &indices.front(), iStart, iCount, iSS );
+    }
+
+    // the indexed values are usually small, so read them whole
+    Alembic::Util::shared_ptr< Abc::TypedArraySample<TRAITS> > valPtr = \
+        m_valProp.getValue( iSS );
+
+    for ( size_t i = 0 ; i < iCount ; ++i )
+    {
+        ABCA_ASSERT( indices[i] < valPtr->size(),
+                     "Index " << indices[i] << " is out of range." );
+        oBuffer[i] = (*valPtr)[ indices[i] ];
+    }
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
 //-*****************************************************************************
 template <class TRAITS>
 size_t ITypedGeomParam<TRAITS>::getNumSamples() const
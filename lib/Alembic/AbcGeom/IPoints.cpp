@@ -40,6 +40,202 @@ namespace Alembic {
 namespace AbcGeom {
 namespace ALEMBIC_VERSION_NS {
 
+namespace {
+
+//-*****************************************************************************
+// Whether any of iBox could be in view, it is only culled when all of its
+// corners are outside the same side of the clip volume.
+bool InFrustum( const Abc::Box3d &iBox, const Abc::M44d &iObjectToClip )
+{
+    const Abc::M44d &m = iObjectToClip;
+    size_t outside[6] = { 0, 0, 0, 0, 0, 0 };
+
+    for ( size_t c = 0; c < 8; ++c )
+    {
+        V3d p( ( c & 1 ) ? iBox.max.x : iBox.min.x,
+               ( c & 2 ) ? iBox.max.y : iBox.min.y,
+               ( c & 4 ) ? iBox.max.z : iBox.min.z );
+
+        double clip[4];
+        for ( size_t i = 0; i < 4; ++i )
+        {
+            clip[i] = p.x * m[0][i] + p.y * m[1][i] + p.z * m[2][i] +
+                m[3][i];
+        }
+
+        for ( size_t i = 0; i < 3; ++i )
+        {
+            if ( clip[i] < -clip[3] ) { outside[i * 2] ++; }
+            if ( clip[i] > clip[3] ) { outside[i * 2 + 1] ++; }
+        }
+    }
+
+    for ( size_t i = 0; i < 6; ++i )
+    {
+        if ( outside[i] == 8 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-*****************************************************************************
+template <class TRAITS>
+Util::shared_ptr< Abc::TypedArraySample<TRAITS> >
+ReadRuns( const Abc::ITypedArrayProperty<TRAITS> &iProp,
+          const std::vector< std::pair<size_t, size_t> > &iRuns,
+          size_t iNumPoints, const Abc::ISampleSelector &iSS )
+{
+    AbcA::ArraySamplePtr samp = AbcA::AllocateArraySample(
+        iProp.getDataType(), Util::Dimensions( iNumPoints ) );
+
+    typename TRAITS::value_type *data = static_cast<typename
+        TRAITS::value_type *>( const_cast<void *>( samp->getData() ) );
+
+    for ( size_t i = 0; i < iRuns.size(); ++i )
+    {
+        iProp.getRange( data, iRuns[i].first, iRuns[i].second, iSS );
+        data += iRuns[i].second;
+    }
+
+    return Util::static_pointer_cast< Abc::TypedArraySample<TRAITS>,
+        AbcA::ArraySample >( samp );
+}
+
+} // End namespace
+
+//-*****************************************************************************
+bool IPointsSchema::getInto( Abc::V3f *oPositions, size_t &ioNumPositions,
+                             Abc::uint64_t *oIds, size_t &ioNumIds,
+                             const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IPointsSchema::getInto()" );
+
+    size_t capacity = ioNumPositions;
+    ioNumPositions = m_positionsProperty.getInto( oPositions, capacity, iSS );
+    bool fits = ioNumPositions <= capacity;
+
+    capacity = ioNumIds;
+    ioNumIds = m_idsProperty.getInto( oIds, capacity, iSS );
+    return fits && ioNumIds <= capacity;
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw
+    return false;
+}
+
+//-*****************************************************************************
+void IPointsSchema::getRegion( Sample &oSample, const Abc::Box3d &iRegion,
+                               const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IPointsSchema::getRegion()" );
+
+    if ( !isBricked() )
+    {
+        get( oSample, iSS );
+        return;
+    }
+
+    Abc::Box3dArraySamplePtr bounds;
+    m_brickBoundsProperty.get( bounds, iSS );
+
+    std::vector<bool> selected( bounds->size() );
+    for ( size_t i = 0; i < bounds->size(); ++i )
+    {
+        selected[i] = ( *bounds )[i].intersects( iRegion );
+    }
+
+    getBricks( oSample, selected, bounds->get(), iSS );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void IPointsSchema::getFrustum( Sample &oSample,
+                                const Abc::M44d &iObjectToClip,
+                                const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IPointsSchema::getFrustum()" );
+
+    if ( !isBricked() )
+    {
+        get( oSample, iSS );
+        return;
+    }
+
+    Abc::Box3dArraySamplePtr bounds;
+    m_brickBoundsProperty.get( bounds, iSS );
+
+    std::vector<bool> selected( bounds->size() );
+    for ( size_t i = 0; i < bounds->size(); ++i )
+    {
+        selected[i] = InFrustum( ( *bounds )[i], iObjectToClip );
+    }
+
+    getBricks( oSample, selected, bounds->get(), iSS );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void IPointsSchema::getBricks( Sample &oSample,
+                               const std::vector<bool> &iSelected,
+                               const Abc::Box3d *iBounds,
+                               const Abc::ISampleSelector &iSS ) const
+{
+    Abc::UInt64ArraySamplePtr starts;
+    m_brickStartsProperty.get( starts, iSS );
+
+    ABCA_ASSERT( starts->size() == iSelected.size() + 1,
+                 "Brick bounds and starts don't agree" );
+
+    // neighbouring bricks are read together
+    std::vector< std::pair<size_t, size_t> > runs;
+    size_t numPoints = 0;
+    oSample.reset();
+
+    for ( size_t i = 0; i < iSelected.size(); ++i )
+    {
+        size_t start = ( *starts )[i];
+        size_t count = ( *starts )[i + 1] - start;
+        if ( !iSelected[i] || count == 0 )
+        {
+            continue;
+        }
+
+        if ( !runs.empty() && runs.back().first + runs.back().second == start )
+        {
+            runs.back().second += count;
+        }
+        else
+        {
+            runs.push_back( std::make_pair( start, count ) );
+        }
+
+        numPoints += count;
+        oSample.m_selfBounds.extendBy( iBounds[i] );
+    }
+
+    oSample.m_positions = ReadRuns( m_positionsProperty, runs, numPoints,
+                                    iSS );
+    oSample.m_ids = ReadRuns( m_idsProperty, runs, numPoints, iSS );
+
+    // velocities are only per point if there are as many as the points
+    if ( m_velocitiesProperty && m_velocitiesProperty.getNumSamples() > 0 )
+    {
+        Util::Dimensions dims;
+        m_velocitiesProperty.getDimensions( dims, iSS );
+        if ( dims.numPoints() == starts->get()[iSelected.size()] )
+        {
+            oSample.m_velocities = ReadRuns( m_velocitiesProperty, runs,
+                                             numPoints, iSS );
+        }
+    }
+}
+
 //-*****************************************************************************
 void IPointsSchema::init( const Abc::Argument &iArg0,
                           const Abc::Argument &iArg1 )
@@ -70,6 +266,16 @@ void IPointsSchema::init( const Abc::Argument &iArg0,
         m_widthsParam = IFloatGeomParam( _this, ".widths", iArg0, iArg1 );
     }
 
+    if ( _this->getPropertyHeader( ".brickStarts" ) != NULL )
+    {
+        m_brickBoundsProperty = Abc::IBox3dArrayProperty( _this,
+            ".brickBounds", iArg0, iArg1 );
+        m_brickIdRangesProperty = Abc::IUInt64ArrayProperty( _this,
+            ".brickIdRanges", iArg0, iArg1 );
+        m_brickStartsProperty = Abc::IUInt64ArrayProperty( _this,
+            ".brickStarts", iArg0, iArg1 );
+    }
+
     ALEMBIC_ABC_SAFE_CALL_END_RESET();
 }
 
@@ -197,6 +197,37 @@ public:
         return smp;
     }
 
+    //! Reads the positions and ids into caller owned buffers, without
+    //! allocating.  Each ioNum starts as the capacity of its buffer in
+    //! values and is replaced with the number of values in the sample.
+    //! A buffer that is too small is left alone and false is returned.
+    //! See Abc::IArrayProperty::getInto.
+    bool getInto( Abc::V3f *oPositions, size_t &ioNumPositions,
+                  Abc::uint64_t *oIds, size_t &ioNumIds,
+                  const Abc::ISampleSelector &iSS =
+                  Abc::ISampleSelector() ) const;
+
+    //! Whether the points were written in spatial bricks, see
+    //! OPointsSchema::setBrickSize.
+    bool isBricked() const { return m_brickStartsProperty.valid(); }
+
+    //! Reads the points, ids and velocities of just the bricks whose
+    //! bounds intersect iRegion.  Points of those bricks outside iRegion
+    //! are included, and the self bounds are those of the bricks read.
+    //! Points which weren't bricked are read whole.
+    void getRegion( Sample &oSample, const Abc::Box3d &iRegion,
+                    const Abc::ISampleSelector &iSS =
+                    Abc::ISampleSelector() ) const;
+
+    //! The same as getRegion, for the bricks which are at least partly
+    //! inside the view of a camera.  The bricks are in the object space of
+    //! the points, so iObjectToClip takes that to clip space: the points'
+    //! world transform, times the camera's inverse transform, times its
+    //! projection, with the visible volume at -w to w on each axis.
+    void getFrustum( Sample &oSample, const Abc::M44d &iObjectToClip,
+                     const Abc::ISampleSelector &iSS =
+                     Abc::ISampleSelector() ) const;
+
     Abc::IP3fArrayProperty getPositionsProperty() const
     {
         return m_positionsProperty;
@@ -217,6 +248,25 @@ public:
         return m_widthsParam;
     }
 
+    //! The bounds of each brick.
+    Abc::IBox3dArrayProperty getBrickBoundsProperty() const
+    {
+        return m_brickBoundsProperty;
+    }
+
+    //! The smallest and largest id of each brick, two values a brick.
+    Abc::IUInt64ArrayProperty getBrickIdRangesProperty() const
+    {
+        return m_brickIdRangesProperty;
+    }
+
+    //! The index of the first point of each brick, and the number of
+    //! points after the last brick.
+    Abc::IUInt64ArrayProperty getBrickStartsProperty() const
+    {
+        return m_brickStartsProperty;
+    }
+
     //-*************************************************************************
     // ABC BASE MECHANISMS
     // These functions are used by Abc to deal with errors, rewrapping,
@@ -231,6 +281,9 @@ public:
         m_velocitiesProperty.reset();
         m_idsProperty.reset();
         m_widthsParam.reset();
+        m_brickBoundsProperty.reset();
+        m_brickIdRangesProperty.reset();
+        m_brickStartsProperty.reset();
 
         IGeomBaseSchema<PointsSchemaInfo>::reset();
     }
@@ -252,10 +305,19 @@ protected:
     void init( const Abc::Argument &iArg0,
                const Abc::Argument &iArg1 );
 
+    // reads the bricks iSelected picks, of the iBounds read for iSS
+    void getBricks( Sample &oSample, const std::vector<bool> &iSelected,
+                    const Abc::Box3d *iBounds,
+                    const Abc::ISampleSelector &iSS ) const;
+
     Abc::IP3fArrayProperty m_positionsProperty;
     Abc::IUInt64ArrayProperty m_idsProperty;
     Abc::IV3fArrayProperty m_velocitiesProperty;
     IFloatGeomParam m_widthsParam;
+
+    Abc::IBox3dArrayProperty m_brickBoundsProperty;
+    Abc::IUInt64ArrayProperty m_brickIdRangesProperty;
+    Abc::IUInt64ArrayProperty m_brickStartsProperty;
 };
 
 //-*****************************************************************************
@@ -67,6 +67,57 @@ MeshTopologyVariance IPolyMeshSchema::getTopologyVariance() const
     return kConstantTopology;
 }
 
+//-*****************************************************************************
+bool IPolyMeshSchema::getInto( Abc::V3f *oPositions, size_t &ioNumPositions,
+                               Abc::int32_t *oFaceIndices,
+                               size_t &ioNumFaceIndices,
+                               Abc::int32_t *oFaceCounts,
+                               size_t &ioNumFaceCounts,
+                               const Abc::ISampleSelector &iSS ) const
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IPolyMeshSchema::getInto()" );
+
+    size_t capacity = ioNumPositions;
+    ioNumPositions = m_positionsProperty.getInto( oPositions, capacity, iSS );
+    bool fits = ioNumPositions <= capacity;
+
+    capacity = ioNumFaceIndices;
+    ioNumFaceIndices = m_indicesProperty.getInto( oFaceIndices, capacity,
+                                                  iSS );
+    fits = fits && ioNumFaceIndices <= capacity;
+
+    capacity = ioNumFaceCounts;
+    ioNumFaceCounts = m_countsProperty.getInto( oFaceCounts, capacity, iSS );
+    return fits && ioNumFaceCounts <= capacity;
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+
+    // Not all error handlers throw
+    return false;
+}
+
+//-*****************************************************************************
+void IPolyMeshSchema::getLod( Sample &oSample, size_t iLevel,
+                              const Abc::ISampleSelector &iSS ) const
+{
+    if ( iLevel == 0 )
+    {
+        get( oSample, iSS );
+        return;
+    }
+
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "IPolyMeshSchema::getLod()" );
+
+    oSample.reset();
+    m_lods.get( iLevel, oSample.m_positions, oSample.m_indices,
+                oSample.m_counts, iSS );
+
+    // the levels average clusters of positions, so they stay within these
+    m_selfBoundsProperty.get( oSample.m_selfBounds, iSS );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
 //-*****************************************************************************
 void IPolyMeshSchema::init( const Abc::Argument &iArg0,
                             const Abc::Argument &iArg1 )
@@ -105,6 +156,11 @@ void IPolyMeshSchema::init( const Abc::Argument &iArg0,
                                                        iArg0, iArg1 );
     }
 
+    if ( this->getPropertyHeader( ".lods" ) != NULL )
+    {
+        m_lods = IMeshLods( *this, iArg0, iArg1 );
+    }
+
     m_faceSetsLoaded = false;
 
     ALEMBIC_ABC_SAFE_CALL_END_RESET();
@@ -124,6 +180,8 @@ IPolyMeshSchema::operator=(const IPolyMeshSchema & rhs)
     m_uvsParam          = rhs.m_uvsParam;
     m_normalsParam      = rhs.m_normalsParam;
 
+    m_lods              = rhs.m_lods;
+
     // lock, reset
     Alembic::Util::scoped_lock l(m_faceSetsMutex);
     m_faceSetsLoaded = false;
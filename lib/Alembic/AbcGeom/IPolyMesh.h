@@ -42,6 +42,7 @@
 #include <Alembic/AbcGeom/IFaceSet.h>
 #include <Alembic/AbcGeom/IGeomParam.h>
 #include <Alembic/AbcGeom/IGeomBase.h>
+#include <Alembic/AbcGeom/MeshLod.h>
 
 namespace Alembic {
 namespace AbcGeom {
@@ -217,6 +218,43 @@ public:
         return smp;
     }
 
+    //! Reads the positions, face indices and face counts into caller owned
+    //! buffers, without allocating.  Each ioNum starts as the capacity of
+    //! its buffer in values and is replaced with the number of values in
+    //! the sample.  A buffer that is too small is left alone and false is
+    //! returned.  See Abc::IArrayProperty::getInto.
+    bool getInto( Abc::V3f *oPositions, size_t &ioNumPositions,
+                  Abc::int32_t *oFaceIndices, size_t &ioNumFaceIndices,
+                  Abc::int32_t *oFaceCounts, size_t &ioNumFaceCounts,
+                  const Abc::ISampleSelector &iSS =
+                  Abc::ISampleSelector() ) const;
+
+    //! The number of levels of detail, including this mesh at level 0.
+    //! The others are decimated and stored with it, see MeshLod.h.
+    size_t getNumLods() const { return m_lods.getNumLevels(); }
+
+    //! The screen size, in pixels, below which iLevel is meant to be used.
+    float getLodScreenSize( size_t iLevel ) const
+    { return m_lods.getScreenSize( iLevel ); }
+
+    //! The coarsest level meant for something iScreenSize pixels across.
+    size_t selectLod( float iScreenSize ) const
+    { return m_lods.select( iScreenSize ); }
+
+    //! Reads the positions and faces of iLevel, and its self bounds, and
+    //! none of the data of the other levels.  Level 0 is the same as get.
+    void getLod( Sample &oSample, size_t iLevel,
+                 const Abc::ISampleSelector &iSS =
+                 Abc::ISampleSelector() ) const;
+
+    //! The same as getLod, with the level selectLod picks for iScreenSize.
+    void getLodForScreenSize( Sample &oSample, float iScreenSize,
+                              const Abc::ISampleSelector &iSS =
+                              Abc::ISampleSelector() ) const
+    { getLod( oSample, selectLod( iScreenSize ), iSS ); }
+
+    IMeshLods getLods() const { return m_lods; }
+
     IV2fGeomParam getUVsParam() const
     {
         return m_uvsParam;
@@ -265,6 +303,8 @@ public:
         m_uvsParam.reset();
         m_normalsParam.reset();
 
+        m_lods.reset();
+
         IGeomBaseSchema<PolyMeshSchemaInfo>::reset();
     }
 
@@ -300,6 +340,8 @@ protected:
     IV2fGeomParam m_uvsParam;
     IN3fGeomParam m_normalsParam;
 
+    IMeshLods m_lods;
+
     // FaceSets, this starts as empty until client
     // code attempts to access facesets.
     bool                              m_faceSetsLoaded;
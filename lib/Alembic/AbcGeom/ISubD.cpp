@@ -194,6 +194,8 @@ ISubDSchema::operator=(const ISubDSchema & rhs)
     m_faceVaryingInterpolateBoundaryProperty =
         rhs.m_faceVaryingInterpolateBoundaryProperty;
 
+    m_lods = rhs.m_lods;
+
     // lock, reset
     Alembic::Util::scoped_lock l(m_faceSetsMutex);
     m_faceSetsLoaded = false;
@@ -201,6 +203,37 @@ ISubDSchema::operator=(const ISubDSchema & rhs)
     return *this;
 }
 
+//-*****************************************************************************
+void ISubDSchema::getLod( ISubDSchema::Sample &oSample, size_t iLevel,
+                          const Abc::ISampleSelector &iSS ) const
+{
+    if ( iLevel == 0 )
+    {
+        get( oSample, iSS );
+        return;
+    }
+
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "ISubDSchema::getLod()" );
+
+    oSample.reset();
+    m_lods.get( iLevel, oSample.m_positions, oSample.m_faceIndices,
+                oSample.m_faceCounts, iSS );
+
+    if ( m_interpolateBoundaryProperty )
+    {
+        m_interpolateBoundaryProperty.get( oSample.m_interpolateBoundary, iSS );
+    }
+
+    if ( m_subdSchemeProperty )
+    {
+        m_subdSchemeProperty.get( oSample.m_subdScheme, iSS );
+    }
+
+    m_selfBoundsProperty.get( oSample.m_selfBounds, iSS );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
 //-*****************************************************************************
 void ISubDSchema::init( const Abc::Argument &iArg0,
                         const Abc::Argument &iArg1 )
@@ -299,6 +332,11 @@ void ISubDSchema::init( const Abc::Argument &iArg0,
                                                        iArg0, iArg1 );
     }
 
+    if ( this->getPropertyHeader( ".lods" ) != NULL )
+    {
+        m_lods = IMeshLods( *this, iArg0, iArg1 );
+    }
+
     m_faceSetsLoaded = false;
 
     ALEMBIC_ABC_SAFE_CALL_END_RESET();
@@ -42,6 +42,7 @@
 #include <Alembic/AbcGeom/IGeomParam.h>
 #include <Alembic/AbcGeom/IFaceSet.h>
 #include <Alembic/AbcGeom/IGeomBase.h>
+#include <Alembic/AbcGeom/MeshLod.h>
 
 namespace Alembic {
 namespace AbcGeom {
@@ -273,6 +274,34 @@ public:
         return smp;
     }
 
+    //! The number of levels of detail, including this subd at level 0.
+    //! The others are decimated and stored with it, see MeshLod.h.
+    size_t getNumLods() const { return m_lods.getNumLevels(); }
+
+    //! The screen size, in pixels, below which iLevel is meant to be used.
+    float getLodScreenSize( size_t iLevel ) const
+    { return m_lods.getScreenSize( iLevel ); }
+
+    //! The coarsest level meant for something iScreenSize pixels across.
+    size_t selectLod( float iScreenSize ) const
+    { return m_lods.select( iScreenSize ); }
+
+    //! Reads the positions and faces of iLevel, its self bounds, scheme
+    //! and boundary interpolation, and none of the data of the other
+    //! levels.  Creases, corners and holes index the positions of level 0
+    //! so they are left empty.  Level 0 is the same as get.
+    void getLod( Sample &oSample, size_t iLevel,
+                 const Abc::ISampleSelector &iSS =
+                 Abc::ISampleSelector() ) const;
+
+    //! The same as getLod, with the level selectLod picks for iScreenSize.
+    void getLodForScreenSize( Sample &oSample, float iScreenSize,
+                              const Abc::ISampleSelector &iSS =
+                              Abc::ISampleSelector() ) const
+    { getLod( oSample, selectLod( iScreenSize ), iSS ); }
+
+    IMeshLods getLods() const { return m_lods; }
+
     Abc::IInt32ArrayProperty getFaceCountsProperty() const
     { return m_faceCountsProperty; }
     Abc::IInt32ArrayProperty getFaceIndicesProperty() const
@@ -346,6 +375,8 @@ public:
 
         m_uvsParam.reset();
 
+        m_lods.reset();
+
         IGeomBaseSchema<SubDSchemaInfo>::reset();
     }
 
@@ -409,6 +440,8 @@ protected:
 
     IV3fArrayProperty m_velocitiesProperty;
 
+    IMeshLods m_lods;
+
     // FaceSets, this starts as empty until client
     // code attempts to access facesets.
     bool                              m_faceSetsLoaded;
@@ -0,0 +1,597 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcGeom/MeshLod.h>
+#include <Alembic/AbcGeom/IPolyMesh.h>
+#include <Alembic/AbcGeom/ISubD.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace Alembic {
+namespace AbcGeom {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+//-*****************************************************************************
+std::string LevelName( std::size_t iLevel )
+{
+    std::ostringstream name;
+    name << "lod" << iLevel;
+    return name.str();
+}
+
+//-*****************************************************************************
+// the cell of the grid iPosition is in, along one axis
+Util::uint64_t GridCell( float iPosition, float iMin, float iSize,
+                         Util::uint64_t iResolution )
+{
+    if ( iSize <= 0.0f )
+    {
+        return 0;
+    }
+
+    double cell = ( iPosition - iMin ) / iSize * iResolution;
+    return std::min( iResolution - 1,
+                     ( Util::uint64_t ) std::max( cell, 0.0 ) );
+}
+
+} // End namespace
+
+//-*****************************************************************************
+void MeshDecimation::build( const Abc::P3fArraySample & iPositions,
+                            const Abc::Int32ArraySample & iFaceIndices,
+                            const Abc::Int32ArraySample & iFaceCounts,
+                            float iFraction )
+{
+    std::size_t numPositions = iPositions.size();
+
+    Abc::Box3f bounds;
+    for ( std::size_t i = 0; i < numPositions; ++i )
+    {
+        bounds.extendBy( iPositions[i] );
+    }
+
+    Abc::V3f size( 0.0f );
+    if ( !bounds.isEmpty() )
+    {
+        size = bounds.size();
+    }
+
+    // flat axes would make cells that nothing else falls in, so the grid
+    // only spans the others
+    float flat = std::max( size.x, std::max( size.y, size.z ) ) * 1e-4f;
+    double target = std::max( 1.0, numPositions *
+        ( double ) std::min( std::max( iFraction, 0.0f ), 1.0f ) );
+
+    double volume = 1.0;
+    int numAxes = 0;
+    for ( int a = 0; a < 3; ++a )
+    {
+        if ( size[a] > flat )
+        {
+            volume *= size[a];
+            ++numAxes;
+        }
+    }
+
+    double cellSize = numAxes > 0 ?
+        std::pow( volume / target, 1.0 / numAxes ) : 1.0;
+
+    Util::uint64_t resolution[3];
+    for ( int a = 0; a < 3; ++a )
+    {
+        resolution[a] = 1;
+        if ( size[a] > flat )
+        {
+            resolution[a] = std::min( Util::uint64_t( 1 ) << 20,
+                std::max( Util::uint64_t( 1 ),
+                          ( Util::uint64_t ) std::ceil( size[a] / cellSize ) ) );
+        }
+        else
+        {
+            size[a] = 0.0f;
+        }
+    }
+
+    // sorting by cell brings the positions of each cluster together
+    std::vector< std::pair< Util::uint64_t, Util::int32_t > > cells(
+        numPositions );
+    for ( std::size_t i = 0; i < numPositions; ++i )
+    {
+        const Abc::V3f & p = iPositions[i];
+        cells[i].first =
+            GridCell( p.x, bounds.min.x, size.x, resolution[0] ) +
+            resolution[0] * (
+            GridCell( p.y, bounds.min.y, size.y, resolution[1] ) +
+            resolution[1] *
+            GridCell( p.z, bounds.min.z, size.z, resolution[2] ) );
+        cells[i].second = ( Util::int32_t ) i;
+    }
+    std::sort( cells.begin(), cells.end() );
+
+    std::vector< Util::int32_t > grid( numPositions );
+    Util::int32_t numCells = 0;
+    for ( std::size_t i = 0; i < numPositions; ++i )
+    {
+        if ( i > 0 && cells[i].first != cells[i - 1].first )
+        {
+            ++numCells;
+        }
+        grid[cells[i].second] = numCells;
+    }
+    if ( numPositions > 0 )
+    {
+        ++numCells;
+    }
+
+    m_faceIndices.clear();
+    m_faceCounts.clear();
+
+    std::vector< Util::int32_t > face;
+    std::size_t start = 0;
+    for ( std::size_t i = 0; i < iFaceCounts.size(); ++i )
+    {
+        Util::int32_t count = iFaceCounts[i];
+        ABCA_ASSERT( count >= 0 &&
+                     start + count <= iFaceIndices.size(),
+                     "Invalid face count: " << count << " for face " << i );
+
+        face.clear();
+        for ( Util::int32_t j = 0; j < count; ++j )
+        {
+            Util::int32_t index = iFaceIndices[start + j];
+            ABCA_ASSERT( index >= 0 && ( std::size_t ) index < numPositions,
+                         "Invalid face index: " << index );
+
+            if ( face.empty() || face.back() != grid[index] )
+            {
+                face.push_back( grid[index] );
+            }
+        }
+        start += count;
+
+        while ( face.size() > 1 && face.front() == face.back() )
+        {
+            face.pop_back();
+        }
+
+        if ( face.size() >= 3 )
+        {
+            m_faceIndices.insert( m_faceIndices.end(), face.begin(),
+                                  face.end() );
+            m_faceCounts.push_back( ( Util::int32_t ) face.size() );
+        }
+    }
+
+    // number the cells the faces still use in the order they use them
+    std::vector< Util::int32_t > used( numCells, -1 );
+    Util::int32_t numUsed = 0;
+    for ( std::size_t i = 0; i < m_faceIndices.size(); ++i )
+    {
+        Util::int32_t & cell = used[m_faceIndices[i]];
+        if ( cell < 0 )
+        {
+            cell = numUsed ++;
+        }
+        m_faceIndices[i] = cell;
+    }
+
+    m_numPositions = numUsed;
+    m_clusters.resize( numPositions );
+    m_clusterSizes.assign( numUsed, 0 );
+    for ( std::size_t i = 0; i < numPositions; ++i )
+    {
+        m_clusters[i] = used[grid[i]];
+        if ( m_clusters[i] >= 0 )
+        {
+            ++m_clusterSizes[m_clusters[i]];
+        }
+    }
+}
+
+//-*****************************************************************************
+void MeshDecimation::decimate( const Abc::P3fArraySample & iPositions,
+                               std::vector< Abc::V3f > & oPositions ) const
+{
+    ABCA_ASSERT( iPositions.size() == m_clusters.size(),
+                 "Can't decimate " << iPositions.size() <<
+                 " positions with a decimation of " << m_clusters.size() );
+
+    oPositions.assign( m_numPositions, Abc::V3f( 0.0f ) );
+    for ( std::size_t i = 0; i < m_clusters.size(); ++i )
+    {
+        if ( m_clusters[i] >= 0 )
+        {
+            oPositions[m_clusters[i]] += iPositions[i];
+        }
+    }
+
+    for ( std::size_t i = 0; i < m_numPositions; ++i )
+    {
+        oPositions[i] /= ( float ) m_clusterSizes[i];
+    }
+}
+
+//-*****************************************************************************
+OMeshLods::OMeshLods( Abc::OCompoundProperty iSchema,
+                      const std::vector< float > & iScreenSizes,
+                      const Abc::Argument &iArg0,
+                      const Abc::Argument &iArg1 )
+{
+    ABCA_ASSERT( !iScreenSizes.empty(), "No mesh LODs to write" );
+
+    for ( std::size_t i = 1; i < iScreenSizes.size(); ++i )
+    {
+        ABCA_ASSERT( iScreenSizes[i] < iScreenSizes[i - 1],
+                     "The screen sizes of mesh LODs need to go down" );
+    }
+
+    Abc::OCompoundProperty lods( iSchema, ".lods" );
+
+    Abc::OFloatArrayProperty table( lods, ".screenSizes" );
+    table.set( Abc::FloatArraySample( iScreenSizes ) );
+
+    m_levels.resize( iScreenSizes.size() );
+    for ( std::size_t i = 0; i < m_levels.size(); ++i )
+    {
+        Abc::OCompoundProperty level( lods, LevelName( i + 1 ) );
+        m_levels[i].positions = Abc::OP3fArrayProperty( level, "P",
+                                                        iArg0, iArg1 );
+        m_levels[i].faceIndices = Abc::OInt32ArrayProperty( level,
+            ".faceIndices", iArg0, iArg1 );
+        m_levels[i].faceCounts = Abc::OInt32ArrayProperty( level,
+            ".faceCounts", iArg0, iArg1 );
+    }
+}
+
+//-*****************************************************************************
+void OMeshLods::set( std::size_t iLevel,
+                     const Abc::P3fArraySample & iPositions,
+                     const Abc::Int32ArraySample & iFaceIndices,
+                     const Abc::Int32ArraySample & iFaceCounts )
+{
+    ABCA_ASSERT( iLevel > 0 && iLevel <= m_levels.size(),
+                 "Invalid mesh LOD: " << iLevel );
+
+    Level & level = m_levels[iLevel - 1];
+
+    if ( level.positions.getNumSamples() == 0 )
+    {
+        ABCA_ASSERT( iFaceIndices && iFaceCounts,
+                     "The first sample of a mesh LOD needs its faces" );
+    }
+
+    level.positions.set( iPositions );
+    SetPropUsePrevIfNull( level.faceIndices, iFaceIndices );
+    SetPropUsePrevIfNull( level.faceCounts, iFaceCounts );
+}
+
+//-*****************************************************************************
+IMeshLods::IMeshLods( const Abc::ICompoundProperty & iSchema,
+                      const Abc::Argument &iArg0,
+                      const Abc::Argument &iArg1 )
+{
+    Abc::Arguments args;
+    iArg0.setInto( args );
+    iArg1.setInto( args );
+
+    // schema matching is for the mesh, not its levels
+    Abc::ErrorHandler::Policy policy = args.getErrorHandlerPolicy();
+
+    Abc::ICompoundProperty lods( iSchema, ".lods", policy );
+
+    Abc::FloatArraySamplePtr screenSizes;
+    Abc::IFloatArrayProperty( lods, ".screenSizes", policy ).get(
+        screenSizes );
+    if ( screenSizes && screenSizes->size() > 0 )
+    {
+        m_screenSizes.assign( screenSizes->get(),
+                              screenSizes->get() + screenSizes->size() );
+    }
+
+    m_levels.resize( m_screenSizes.size() );
+    for ( std::size_t i = 0; i < m_levels.size(); ++i )
+    {
+        Abc::ICompoundProperty level( lods, LevelName( i + 1 ), policy );
+
+        // no matching so V3f positions are fine too, like P of the mesh
+        m_levels[i].positions = Abc::IP3fArrayProperty( level, "P",
+            kNoMatching, policy );
+        m_levels[i].faceIndices = Abc::IInt32ArrayProperty( level,
+            ".faceIndices", policy );
+        m_levels[i].faceCounts = Abc::IInt32ArrayProperty( level,
+            ".faceCounts", policy );
+    }
+}
+
+//-*****************************************************************************
+float IMeshLods::getScreenSize( std::size_t iLevel ) const
+{
+    if ( iLevel == 0 )
+    {
+        return std::numeric_limits< float >::max();
+    }
+
+    ABCA_ASSERT( iLevel <= m_screenSizes.size(),
+                 "Invalid mesh LOD: " << iLevel );
+
+    return m_screenSizes[iLevel - 1];
+}
+
+//-*****************************************************************************
+std::size_t IMeshLods::select( float iScreenSize ) const
+{
+    std::size_t level = 0;
+    while ( level < m_screenSizes.size() && iScreenSize < m_screenSizes[level] )
+    {
+        ++level;
+    }
+
+    return level;
+}
+
+//-*****************************************************************************
+const IMeshLods::Level & IMeshLods::getLevel( std::size_t iLevel ) const
+{
+    ABCA_ASSERT( iLevel > 0 && iLevel <= m_levels.size(),
+                 "Invalid mesh LOD: " << iLevel );
+
+    return m_levels[iLevel - 1];
+}
+
+//-*****************************************************************************
+void IMeshLods::get( std::size_t iLevel, Abc::P3fArraySamplePtr & oPositions,
+                     Abc::Int32ArraySamplePtr & oFaceIndices,
+                     Abc::Int32ArraySamplePtr & oFaceCounts,
+                     const Abc::ISampleSelector &iSS ) const
+{
+    const Level & level = getLevel( iLevel );
+
+    level.positions.get( oPositions, iSS );
+    level.faceIndices.get( oFaceIndices, iSS );
+    level.faceCounts.get( oFaceCounts, iSS );
+}
+
+//-*****************************************************************************
+Abc::IP3fArrayProperty
+IMeshLods::getPositionsProperty( std::size_t iLevel ) const
+{
+    return getLevel( iLevel ).positions;
+}
+
+namespace {
+
+//-*****************************************************************************
+// an ArraySample of iValues, with data even when there are none, so that
+// OMeshLods doesn't take it for the previous sample
+Abc::Int32ArraySample FaceSample( const std::vector< Util::int32_t > & iValues )
+{
+    static const Util::int32_t none = 0;
+    return Abc::Int32ArraySample(
+        iValues.empty() ? &none : &iValues.front(), iValues.size() );
+}
+
+//-*****************************************************************************
+void WriteLods( Abc::ICompoundProperty & iSchema,
+                Abc::OCompoundProperty & oSchema,
+                const MeshLodOptions & iOptions )
+{
+    Abc::IP3fArrayProperty positions( iSchema, "P", kNoMatching );
+    Abc::IInt32ArrayProperty faceIndices( iSchema, ".faceIndices" );
+    Abc::IInt32ArrayProperty faceCounts( iSchema, ".faceCounts" );
+
+    std::size_t numSamples = positions.getNumSamples();
+    if ( iOptions.screenSizes.empty() || numSamples == 0 || faceIndices.getNumSamples() == 0 ||
+         faceCounts.getNumSamples() == 0 ||
+         positions.getValue( Abc::ISampleSelector( ( index_t ) 0 ) )->size() <
+         iOptions.minPositions )
+    {
+        return;
+    }
+
+    bool shareTopology = faceIndices.isConstant() && faceCounts.isConstant();
+
+    OMeshLods lods( oSchema, iOptions.screenSizes,
+                    positions.getTimeSampling() );
+
+    std::vector< MeshDecimation > decimations( iOptions.fractions.size() );
+    std::vector< Abc::V3f > decimated;
+
+    for ( std::size_t i = 0; i < numSamples; ++i )
+    {
+        Abc::P3fArraySamplePtr p;
+        positions.get( p, Abc::ISampleSelector( ( index_t ) i ) );
+
+        bool build = ( i == 0 || !shareTopology );
+
+        Abc::Int32ArraySamplePtr indices;
+        Abc::Int32ArraySamplePtr counts;
+        if ( build )
+        {
+            faceIndices.get( indices, Abc::ISampleSelector( ( index_t )
+                std::min( i, faceIndices.getNumSamples() - 1 ) ) );
+            faceCounts.get( counts, Abc::ISampleSelector( ( index_t )
+                std::min( i, faceCounts.getNumSamples() - 1 ) ) );
+        }
+
+        for ( std::size_t j = 0; j < decimations.size(); ++j )
+        {
+            if ( build )
+            {
+                decimations[j].build( *p, *indices, *counts,
+                                      iOptions.fractions[j] );
+            }
+
+            decimations[j].decimate( *p, decimated );
+
+            if ( build )
+            {
+                lods.set( j + 1, Abc::P3fArraySample( decimated ),
+                          FaceSample( decimations[j].getFaceIndices() ),
+                          FaceSample( decimations[j].getFaceCounts() ) );
+            }
+            else
+            {
+                lods.set( j + 1, Abc::P3fArraySample( decimated ) );
+            }
+        }
+    }
+}
+
+//-*****************************************************************************
+// iIsMesh is for the schema of a polymesh or subd, which is where its levels
+// go, and not the properties of the object, which share its metadata
+void CopyProperties( Abc::ICompoundProperty & iRead,
+                     Abc::OCompoundProperty & oWrite,
+                     bool iIsMesh, const MeshLodOptions & iOptions )
+{
+    for ( std::size_t i = 0; i < iRead.getNumProperties(); ++i )
+    {
+        const AbcA::PropertyHeader & header = iRead.getPropertyHeader( i );
+
+        // levels already there are rebuilt with the new options
+        if ( iIsMesh && header.getName() == ".lods" )
+        {
+            continue;
+        }
+
+        if ( header.isArray() )
+        {
+            Abc::IArrayProperty inProp( iRead, header.getName() );
+            Abc::OArrayProperty outProp( oWrite, header.getName(),
+                header.getDataType(), header.getMetaData(),
+                header.getTimeSampling() );
+
+            for ( std::size_t j = 0; j < inProp.getNumSamples(); ++j )
+            {
+                AbcA::ArraySamplePtr samp;
+                inProp.get( samp, Abc::ISampleSelector( ( index_t ) j ) );
+                outProp.set( *samp );
+            }
+        }
+        else if ( header.isScalar() )
+        {
+            Abc::IScalarProperty inProp( iRead, header.getName() );
+            Abc::OScalarProperty outProp( oWrite, header.getName(),
+                header.getDataType(), header.getMetaData(),
+                header.getTimeSampling() );
+
+            const AbcA::DataType & dataType = header.getDataType();
+            std::vector< std::string > strings;
+            std::vector< Util::wstring > wstrings;
+            std::vector< char > bytes;
+            void * samp = NULL;
+
+            if ( dataType.getPod() == Util::kStringPOD )
+            {
+                strings.resize( dataType.getExtent() );
+                samp = &strings.front();
+            }
+            else if ( dataType.getPod() == Util::kWstringPOD )
+            {
+                wstrings.resize( dataType.getExtent() );
+                samp = &wstrings.front();
+            }
+            else
+            {
+                bytes.resize( dataType.getNumBytes() );
+                samp = &bytes.front();
+            }
+
+            for ( std::size_t j = 0; j < inProp.getNumSamples(); ++j )
+            {
+                inProp.get( samp, Abc::ISampleSelector( ( index_t ) j ) );
+                outProp.set( samp );
+            }
+        }
+        else if ( header.isCompound() )
+        {
+            Abc::ICompoundProperty inProp( iRead, header.getName() );
+            Abc::OCompoundProperty outProp( oWrite, header.getName(),
+                                            header.getMetaData() );
+            CopyProperties( inProp, outProp,
+                IPolyMeshSchema::matches( header.getMetaData() ) ||
+                ISubDSchema::matches( header.getMetaData() ), iOptions );
+        }
+    }
+
+    if ( iIsMesh )
+    {
+        WriteLods( iRead, oWrite, iOptions );
+    }
+}
+
+//-*****************************************************************************
+void CopyObject( IObject iRead, OObject oWrite,
+                 const MeshLodOptions & iOptions )
+{
+    Abc::ICompoundProperty inProps = iRead.getProperties();
+    Abc::OCompoundProperty outProps = oWrite.getProperties();
+    CopyProperties( inProps, outProps, false, iOptions );
+
+    for ( std::size_t i = 0; i < iRead.getNumChildren(); ++i )
+    {
+        IObject child = iRead.getChild( i );
+        CopyObject( child, OObject( oWrite, child.getName(),
+                                    child.getMetaData() ), iOptions );
+    }
+}
+
+} // End namespace
+
+//-*****************************************************************************
+void BuildMeshLods( IArchive & iArchive, OArchive & oArchive,
+                    const MeshLodOptions & iOptions )
+{
+    ABCA_ASSERT( iOptions.fractions.size() == iOptions.screenSizes.size(),
+                 "Each mesh LOD needs a fraction and a screen size" );
+
+    // so the time samplings keep their indices, 0 is always there
+    for ( Util::uint32_t i = 1; i < iArchive.getNumTimeSamplings(); ++i )
+    {
+        oArchive.addTimeSampling( *iArchive.getTimeSampling( i ) );
+    }
+
+    CopyObject( iArchive.getTop(), oArchive.getTop(), iOptions );
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcGeom
+} // End namespace Alembic
@@ -0,0 +1,231 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcGeom_MeshLod_h_
+#define _Alembic_AbcGeom_MeshLod_h_
+
+#include <Alembic/AbcGeom/Foundation.h>
+
+namespace Alembic {
+namespace AbcGeom {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+// Decimated levels of detail of a polymesh or subd are stored inside its
+// schema, next to P, in a ".lods" compound.  It holds a ".screenSizes"
+// float array, the LOD table, with an entry for each stored level, and a
+// compound for each of them, "lod1", "lod2" and so on, with their own P,
+// ".faceIndices" and ".faceCounts".  Level 0 is the mesh itself.
+// Level N is meant for when the mesh is less than the Nth screen size
+// across, in pixels, so the screen sizes go down as the levels go up.
+//-*****************************************************************************
+
+//-*****************************************************************************
+//! Decimates a mesh by clustering its positions on a grid over their
+//! bounds, and rebuilding its faces over the clusters, dropping any that
+//! collapse to less than 3 vertices.
+class MeshDecimation
+{
+public:
+    MeshDecimation() : m_numPositions( 0 ) {}
+
+    //! Sizes the grid so that roughly iFraction of iPositions survive.
+    void build( const Abc::P3fArraySample & iPositions,
+                const Abc::Int32ArraySample & iFaceIndices,
+                const Abc::Int32ArraySample & iFaceCounts,
+                float iFraction );
+
+    //! Averages the positions of each cluster.  iPositions needs as many
+    //! as build was given, so the samples of a mesh whose topology doesn't
+    //! change can share a decimation.
+    void decimate( const Abc::P3fArraySample & iPositions,
+                   std::vector< Abc::V3f > & oPositions ) const;
+
+    //! The number of positions decimate returns.
+    std::size_t getNumPositions() const { return m_numPositions; }
+
+    const std::vector< Util::int32_t > & getFaceIndices() const
+    { return m_faceIndices; }
+
+    const std::vector< Util::int32_t > & getFaceCounts() const
+    { return m_faceCounts; }
+
+private:
+    // the decimated position of each position, or -1 if no face uses it
+    std::vector< Util::int32_t > m_clusters;
+    std::vector< Util::int32_t > m_clusterSizes;
+    std::size_t m_numPositions;
+
+    std::vector< Util::int32_t > m_faceIndices;
+    std::vector< Util::int32_t > m_faceCounts;
+};
+
+//-*****************************************************************************
+//! Writes the decimated levels of a polymesh or subd into its schema.
+class OMeshLods
+{
+public:
+    OMeshLods() {}
+
+    //! Creates a level for each of iScreenSizes, which need to go down.
+    //! iArg0 and iArg1 are given to the properties of each level, and are
+    //! usually the time sampling of the mesh.
+    OMeshLods( Abc::OCompoundProperty iSchema,
+               const std::vector< float > & iScreenSizes,
+               const Abc::Argument &iArg0 = Abc::Argument(),
+               const Abc::Argument &iArg1 = Abc::Argument() );
+
+    //! The number of levels, including the mesh itself.
+    std::size_t getNumLevels() const { return m_levels.size() + 1; }
+
+    //! Sets the next sample of iLevel, which starts at 1.  Face indices
+    //! and counts without any data reuse the previous ones, like they do
+    //! for OPolyMeshSchema.
+    void set( std::size_t iLevel, const Abc::P3fArraySample & iPositions,
+              const Abc::Int32ArraySample & iFaceIndices =
+              Abc::Int32ArraySample(),
+              const Abc::Int32ArraySample & iFaceCounts =
+              Abc::Int32ArraySample() );
+
+    bool valid() const { return !m_levels.empty(); }
+
+    void reset() { m_levels.clear(); }
+
+private:
+    struct Level
+    {
+        Abc::OP3fArrayProperty positions;
+        Abc::OInt32ArrayProperty faceIndices;
+        Abc::OInt32ArrayProperty faceCounts;
+    };
+
+    std::vector< Level > m_levels;
+};
+
+//-*****************************************************************************
+//! Reads the LOD table of a polymesh or subd, and the data of one level at a
+//! time.  IPolyMeshSchema and ISubDSchema each have one, see getLod on them.
+class IMeshLods
+{
+public:
+    IMeshLods() {}
+
+    //! Opens the ".lods" of iSchema, which reads its table but no levels.
+    IMeshLods( const Abc::ICompoundProperty & iSchema,
+               const Abc::Argument &iArg0 = Abc::Argument(),
+               const Abc::Argument &iArg1 = Abc::Argument() );
+
+    //! The number of levels, including the mesh itself, so 1 without any.
+    std::size_t getNumLevels() const { return m_levels.size() + 1; }
+
+    //! The screen size below which iLevel is meant to be used, or the
+    //! largest float for level 0.
+    float getScreenSize( std::size_t iLevel ) const;
+
+    //! The coarsest level meant for something iScreenSize pixels across.
+    std::size_t select( float iScreenSize ) const;
+
+    //! Reads the positions and faces of iLevel, which starts at 1.
+    void get( std::size_t iLevel, Abc::P3fArraySamplePtr & oPositions,
+              Abc::Int32ArraySamplePtr & oFaceIndices,
+              Abc::Int32ArraySamplePtr & oFaceCounts,
+              const Abc::ISampleSelector &iSS =
+              Abc::ISampleSelector() ) const;
+
+    Abc::IP3fArrayProperty getPositionsProperty( std::size_t iLevel ) const;
+
+    void reset()
+    {
+        m_screenSizes.clear();
+        m_levels.clear();
+    }
+
+private:
+    struct Level
+    {
+        Abc::IP3fArrayProperty positions;
+        Abc::IInt32ArrayProperty faceIndices;
+        Abc::IInt32ArrayProperty faceCounts;
+    };
+
+    const Level & getLevel( std::size_t iLevel ) const;
+
+    std::vector< float > m_screenSizes;
+    std::vector< Level > m_levels;
+};
+
+//-*****************************************************************************
+struct MeshLodOptions
+{
+    MeshLodOptions() : minPositions( 64 )
+    {
+        fractions.push_back( 0.5f );
+        fractions.push_back( 0.25f );
+        fractions.push_back( 0.125f );
+
+        screenSizes.push_back( 400.0f );
+        screenSizes.push_back( 200.0f );
+        screenSizes.push_back( 100.0f );
+    }
+
+    //! Roughly how many of the positions of the mesh each level keeps.
+    std::vector< float > fractions;
+
+    //! The LOD table, one for each of fractions, going down.
+    std::vector< float > screenSizes;
+
+    //! Meshes with fewer positions than this get no levels.
+    std::size_t minPositions;
+};
+
+//-*****************************************************************************
+//! Copies iArchive into oArchive, giving each polymesh and subd with enough
+//! positions the decimated levels of iOptions.  Levels iArchive already had
+//! are replaced.  Every sample of P gets a level sample, and a mesh whose
+//! topology doesn't change shares the decimation of its first sample.
+//! Only positions and faces are decimated, so normals, uvs, creases and the
+//! like stay with level 0.
+void BuildMeshLods( IArchive & iArchive, OArchive & oArchive,
+                    const MeshLodOptions & iOptions = MeshLodOptions() );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcGeom
+} // End namespace Alembic
+
+#endif
@@ -37,15 +37,223 @@
 #include <Alembic/AbcGeom/OPoints.h>
 #include <Alembic/AbcGeom/GeometryScope.h>
 
+#include <algorithm>
+
 namespace Alembic {
 namespace AbcGeom {
 namespace ALEMBIC_VERSION_NS {
 
+namespace {
+
+//-*****************************************************************************
+struct AxisLess
+{
+    AxisLess( const V3f *iPositions, int iAxis )
+      : positions( iPositions ), axis( iAxis ) {}
+
+    bool operator()( size_t iA, size_t iB ) const
+    {
+        return positions[iA][axis] < positions[iB][axis];
+    }
+
+    const V3f *positions;
+    int axis;
+};
+
+//-*****************************************************************************
+// Splits the points in ioOrder[iBegin, iEnd) at the median of the longest
+// side of their bounds until there are at most iMaxPoints in each part,
+// appending where each part starts to oStarts.
+void SplitBricks( const V3f *iPositions, std::vector<size_t> &ioOrder,
+                  size_t iBegin, size_t iEnd, size_t iMaxPoints,
+                  std::vector<Util::uint64_t> &oStarts )
+{
+    if ( iEnd - iBegin <= iMaxPoints )
+    {
+        oStarts.push_back( iBegin );
+        return;
+    }
+
+    Abc::Box3f bnds;
+    for ( size_t i = iBegin; i < iEnd; ++i )
+    {
+        bnds.extendBy( iPositions[ioOrder[i]] );
+    }
+
+    V3f size = bnds.max - bnds.min;
+    int axis = 0;
+    if ( size[1] > size[axis] ) { axis = 1; }
+    if ( size[2] > size[axis] ) { axis = 2; }
+
+    size_t mid = iBegin + ( iEnd - iBegin ) / 2;
+    std::nth_element( ioOrder.begin() + iBegin, ioOrder.begin() + mid,
+                      ioOrder.begin() + iEnd, AxisLess( iPositions, axis ) );
+
+    SplitBricks( iPositions, ioOrder, iBegin, mid, iMaxPoints, oStarts );
+    SplitBricks( iPositions, ioOrder, mid, iEnd, iMaxPoints, oStarts );
+}
+
+//-*****************************************************************************
+template <class T>
+void Reorder( const T *iVals, const std::vector<size_t> &iOrder,
+              std::vector<T> &oVals )
+{
+    oVals.resize( iOrder.size() );
+    for ( size_t i = 0; i < iOrder.size(); ++i )
+    {
+        oVals[i] = iVals[iOrder[i]];
+    }
+}
+
+//-*****************************************************************************
+// what a bricked sample is made of, which has to outlive writing it
+struct Bricks
+{
+    Bricks() : changed( false ) {}
+
+    std::vector<V3f> positions;
+    std::vector<Util::uint64_t> ids;
+    std::vector<V3f> velocities;
+    std::vector<float> widths;
+    std::vector<Util::uint32_t> widthIndices;
+
+    // set when positions were given, and so there are new bricks
+    bool changed;
+    std::vector<Abc::Box3d> bounds;
+    std::vector<Util::uint64_t> idRanges;
+    std::vector<Util::uint64_t> starts;
+};
+
+//-*****************************************************************************
+// Returns iSamp with its points reordered into bricks of at most
+// iMaxPoints, setting ioOrder to that order when it has positions, and
+// otherwise reordering whatever it has by the ioOrder of before.
+OPointsSchema::Sample BrickSample( const OPointsSchema::Sample &iSamp,
+                                   size_t iMaxPoints,
+                                   std::vector<size_t> &ioOrder,
+                                   Bricks &oBricks )
+{
+    OPointsSchema::Sample ret( iSamp );
+
+    const Abc::P3fArraySample &positions = iSamp.getPositions();
+    if ( positions )
+    {
+        const Abc::UInt64ArraySample &ids = iSamp.getIds();
+        ABCA_ASSERT( ids && ids.size() == positions.size(),
+                     "Bricked points need ids with every sample of "
+                     "positions" );
+
+        size_t numPoints = positions.size();
+        ioOrder.resize( numPoints );
+        for ( size_t i = 0; i < numPoints; ++i )
+        {
+            ioOrder[i] = i;
+        }
+
+        if ( numPoints > 0 )
+        {
+            SplitBricks( positions.get(), ioOrder, 0, numPoints, iMaxPoints,
+                         oBricks.starts );
+        }
+        oBricks.starts.push_back( numPoints );
+
+        Reorder( positions.get(), ioOrder, oBricks.positions );
+        Reorder( ids.get(), ioOrder, oBricks.ids );
+        ret.setPositions( Abc::P3fArraySample( oBricks.positions ) );
+        ret.setIds( Abc::UInt64ArraySample( oBricks.ids ) );
+
+        size_t numBricks = oBricks.starts.size() - 1;
+        oBricks.bounds.resize( numBricks );
+        oBricks.idRanges.resize( numBricks * 2 );
+        for ( size_t i = 0; i < numBricks; ++i )
+        {
+            Util::uint64_t minId = oBricks.ids[oBricks.starts[i]];
+            Util::uint64_t maxId = minId;
+            for ( size_t j = oBricks.starts[i]; j < oBricks.starts[i + 1];
+                  ++j )
+            {
+                oBricks.bounds[i].extendBy( oBricks.positions[j] );
+                minId = std::min( minId, oBricks.ids[j] );
+                maxId = std::max( maxId, oBricks.ids[j] );
+            }
+            oBricks.idRanges[i * 2] = minId;
+            oBricks.idRanges[i * 2 + 1] = maxId;
+        }
+
+        oBricks.changed = true;
+    }
+
+    // anything per point follows the positions, anything else is left be
+    const Abc::V3fArraySample &velocities = iSamp.getVelocities();
+    if ( velocities && velocities.size() == ioOrder.size() )
+    {
+        Reorder( velocities.get(), ioOrder, oBricks.velocities );
+        ret.setVelocities( Abc::V3fArraySample( oBricks.velocities ) );
+    }
+
+    const OFloatGeomParam::Sample &widths = iSamp.getWidths();
+    if ( widths && widths.getIndices() )
+    {
+        if ( widths.getIndices().size() == ioOrder.size() )
+        {
+            Reorder( widths.getIndices().get(), ioOrder,
+                     oBricks.widthIndices );
+            ret.setWidths( OFloatGeomParam::Sample( widths.getVals(),
+                Abc::UInt32ArraySample( oBricks.widthIndices ),
+                widths.getScope() ) );
+        }
+    }
+    else if ( widths && widths.getVals().size() == ioOrder.size() )
+    {
+        Reorder( widths.getVals().get(), ioOrder, oBricks.widths );
+        ret.setWidths( OFloatGeomParam::Sample(
+            Abc::FloatArraySample( oBricks.widths ), widths.getScope() ) );
+    }
+
+    return ret;
+}
+
+} // End namespace
+
 //-*****************************************************************************
 void OPointsSchema::set( const Sample &iSamp )
 {
     ALEMBIC_ABC_SAFE_CALL_BEGIN( "OPointsSchema::set()" );
 
+    if ( m_maxBrickPoints == 0 )
+    {
+        setPoints( iSamp );
+        return;
+    }
+
+    Bricks bricks;
+    Sample brickedSamp = BrickSample( iSamp, m_maxBrickPoints, m_brickOrder,
+                                      bricks );
+
+    if ( bricks.changed )
+    {
+        m_brickBoundsProperty.set( Abc::Box3dArraySample( bricks.bounds ) );
+        m_brickIdRangesProperty.set(
+            Abc::UInt64ArraySample( bricks.idRanges ) );
+        m_brickStartsProperty.set( Abc::UInt64ArraySample( bricks.starts ) );
+    }
+    else
+    {
+        m_brickBoundsProperty.setFromPrevious();
+        m_brickIdRangesProperty.setFromPrevious();
+        m_brickStartsProperty.setFromPrevious();
+    }
+
+    setPoints( brickedSamp );
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
+//-*****************************************************************************
+void OPointsSchema::setPoints( const Sample &iSamp )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "OPointsSchema::set()" );
+
     // do we need to create velocities prop?
     if ( iSamp.getVelocities() && !m_velocitiesProperty )
     {
@@ -168,6 +376,13 @@ void OPointsSchema::setFromPrevious()
         m_widthsParam.setFromPrevious();
     }
 
+    if ( m_maxBrickPoints > 0 )
+    {
+        m_brickBoundsProperty.setFromPrevious();
+        m_brickIdRangesProperty.setFromPrevious();
+        m_brickStartsProperty.setFromPrevious();
+    }
+
     ALEMBIC_ABC_SAFE_CALL_END();
 }
 
@@ -186,6 +401,13 @@ void OPointsSchema::setTimeSampling( uint32_t iIndex )
         m_widthsParam.setTimeSampling( iIndex );
     }
 
+    if ( m_maxBrickPoints > 0 )
+    {
+        m_brickBoundsProperty.setTimeSampling( iIndex );
+        m_brickIdRangesProperty.setTimeSampling( iIndex );
+        m_brickStartsProperty.setTimeSampling( iIndex );
+    }
+
     ALEMBIC_ABC_SAFE_CALL_END();
 }
 
@@ -204,6 +426,33 @@ void OPointsSchema::setTimeSampling( AbcA::TimeSamplingPtr iTime )
     ALEMBIC_ABC_SAFE_CALL_END();
 }
 
+//-*****************************************************************************
+void OPointsSchema::setBrickSize( size_t iMaxPointsPerBrick )
+{
+    ALEMBIC_ABC_SAFE_CALL_BEGIN( "OPointsSchema::setBrickSize()" );
+
+    ABCA_ASSERT( m_positionsProperty.getNumSamples() == 0,
+                 "Points can only be bricked from the first sample on" );
+
+    if ( iMaxPointsPerBrick > 0 && !m_brickStartsProperty )
+    {
+        AbcA::TimeSamplingPtr ts = m_positionsProperty.getTimeSampling();
+        m_brickBoundsProperty = Abc::OBox3dArrayProperty( this->getPtr(),
+            ".brickBounds", ts );
+        m_brickIdRangesProperty = Abc::OUInt64ArrayProperty( this->getPtr(),
+            ".brickIdRanges", ts );
+        m_brickStartsProperty = Abc::OUInt64ArrayProperty( this->getPtr(),
+            ".brickStarts", ts );
+    }
+
+    ABCA_ASSERT( iMaxPointsPerBrick > 0 || !m_brickStartsProperty,
+                 "Bricking can't be turned off once it is on" );
+
+    m_maxBrickPoints = iMaxPointsPerBrick;
+
+    ALEMBIC_ABC_SAFE_CALL_END();
+}
+
 //-*****************************************************************************
 void OPointsSchema::init( uint32_t iTsIdx )
 {
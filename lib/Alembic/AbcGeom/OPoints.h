@@ -142,7 +142,7 @@ public:
 
     //! The default constructor creates an empty OPointsSchema
     //! ...
-    OPointsSchema() {}
+    OPointsSchema() : m_maxBrickPoints( 0 ) {}
 
     //! This templated, primary constructor creates a new poly mesh writer.
     //! The first argument is any Abc (or AbcCoreAbstract) object
@@ -161,6 +161,7 @@ public:
       : OGeomBaseSchema<PointsSchemaInfo>(
                         GetCompoundPropertyWriterPtr( iParent ),
                         iName, iArg0, iArg1, iArg2 )
+      , m_maxBrickPoints( 0 )
     {
         AbcA::TimeSamplingPtr tsPtr =
             Abc::GetTimeSampling( iArg0, iArg1, iArg2 );
@@ -189,6 +190,7 @@ public:
       : OGeomBaseSchema<PointsSchemaInfo>(
                             GetCompoundPropertyWriterPtr( iParent ),
                             iArg0, iArg1, iArg2 )
+      , m_maxBrickPoints( 0 )
     {
         AbcA::TimeSamplingPtr tsPtr =
             Abc::GetTimeSampling( iArg0, iArg1, iArg2 );
@@ -245,6 +247,27 @@ public:
     void setTimeSampling( uint32_t iIndex );
     void setTimeSampling( AbcA::TimeSamplingPtr iTime );
 
+    //! Stores the points of the samples set from now on in spatial bricks
+    //! of at most iMaxPointsPerBrick points, which readers can use to read
+    //! just the points in a region, see IPointsSchema::getRegion.  The
+    //! points are reordered brick by brick, along with their ids,
+    //! velocities and per point widths, so every sample which sets
+    //! positions must set ids too.  The bounds, id range and first point
+    //! of each brick are written alongside.  Must be called before the
+    //! first sample is set, 0, the default, doesn't brick.
+    //!
+    //! Nothing else is reordered, so per point arbGeomParams and user
+    //! properties have to be written in the order of getBrickOrder after
+    //! each sample is set, or they no longer line up with their points.
+    void setBrickSize( size_t iMaxPointsPerBrick );
+
+    size_t getBrickSize() const { return m_maxBrickPoints; }
+
+    //! The order the points of the last sample with positions were
+    //! written in when bricking: the i'th point written is point
+    //! getBrickOrder()[i] of that sample.  Empty when not bricking.
+    const std::vector<size_t> &getBrickOrder() const { return m_brickOrder; }
+
     //-*************************************************************************
     // ABC BASE MECHANISMS
     // These functions are used by Abc to deal with errors, validity,
@@ -259,6 +282,11 @@ public:
         m_idsProperty.reset();
         m_velocitiesProperty.reset();
         m_widthsParam.reset();
+        m_brickBoundsProperty.reset();
+        m_brickIdRangesProperty.reset();
+        m_brickStartsProperty.reset();
+        m_maxBrickPoints = 0;
+        m_brickOrder.clear();
 
         OGeomBaseSchema<PointsSchemaInfo>::reset();
     }
@@ -279,11 +307,23 @@ public:
 protected:
     void init( uint32_t iTsIdx );
 
+    // writes a sample as it is, after any bricking
+    void setPoints( const Sample &iSamp );
+
     Abc::OP3fArrayProperty m_positionsProperty;
     Abc::OUInt64ArrayProperty m_idsProperty;
     Abc::OV3fArrayProperty m_velocitiesProperty;
     OFloatGeomParam m_widthsParam;
 
+    // only written when bricking
+    Abc::OBox3dArrayProperty m_brickBoundsProperty;
+    Abc::OUInt64ArrayProperty m_brickIdRangesProperty;
+    Abc::OUInt64ArrayProperty m_brickStartsProperty;
+    size_t m_maxBrickPoints;
+
+    // the order the points of the last positions set were written in, so
+    // velocities and widths set without positions follow them
+    std::vector<size_t> m_brickOrder;
 };
 
 //-*****************************************************************************
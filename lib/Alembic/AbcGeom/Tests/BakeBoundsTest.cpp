@@ -0,0 +1,193 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcGeom/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+namespace AbcG = Alembic::AbcGeom;
+using namespace AbcG;
+
+using Alembic::AbcCoreAbstract::chrono_t;
+using Alembic::AbcCoreAbstract::index_t;
+
+//-*****************************************************************************
+void writePoints( OObject iParent, const std::string & iName,
+                  const V3f & iMin, const V3f & iMax,
+                  TimeSamplingPtr iTs, std::size_t iNumSamples )
+{
+    OPoints points( iParent, iName, iTs );
+
+    for ( std::size_t i = 0; i < iNumSamples; ++i )
+    {
+        // each sample moves it along by 1 in z
+        std::vector< V3f > positions;
+        positions.push_back( iMin + V3f( 0.0f, 0.0f, i ) );
+        positions.push_back( iMax + V3f( 0.0f, 0.0f, i ) );
+        std::vector< Alembic::Util::uint64_t > ids;
+        ids.push_back( 0 );
+        ids.push_back( 1 );
+
+        points.getSchema().set( OPointsSchema::Sample(
+            V3fArraySample( positions ), UInt64ArraySample( ids ) ) );
+    }
+}
+
+//-*****************************************************************************
+void writeArchive( const std::string & iName )
+{
+    OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(), iName );
+
+    TimeSamplingPtr frames( new TimeSampling( 1.0 / 24.0, 0.0 ) );
+    std::vector< chrono_t > times;
+    times.push_back( 0.5 );
+    times.push_back( 1.0 );
+    TimeSamplingPtr acyclic( new TimeSampling(
+        TimeSamplingType( TimeSamplingType::kAcyclic ), times ) );
+
+    // a moves 10 along x each frame
+    OXform a( archive.getTop(), "a", frames );
+    for ( std::size_t i = 0; i < 3; ++i )
+    {
+        XformSample samp;
+        samp.setTranslation( V3d( 10.0 * ( i + 1 ), 0.0, 0.0 ) );
+        a.getSchema().set( samp );
+    }
+
+    writePoints( a, "pts", V3f( 0.0f ), V3f( 1.0f ), frames, 1 );
+
+    // b doesn't inherit, so it sits at (0, 5, 0) wherever a is
+    OXform b( a, "b" );
+    XformSample samp;
+    samp.setTranslation( V3d( 0.0, 5.0, 0.0 ) );
+    samp.setInheritsXforms( false );
+    b.getSchema().set( samp );
+
+    writePoints( b, "pts", V3f( 0.0f ), V3f( 2.0f ), frames, 1 );
+
+    OObject c( archive.getTop(), "c" );
+    writePoints( c, "pts", V3f( -1.0f ), V3f( 0.0f ), acyclic, 2 );
+}
+
+//-*****************************************************************************
+void checkBounds( IArchive & iSidecar, IObject iObject,
+                  const std::vector< Box3d > & iExpected )
+{
+    IBox3dProperty bounds = GetBakedChildBounds( iSidecar, iObject );
+    TESTING_ASSERT( bounds.valid() );
+    TESTING_ASSERT( bounds.getNumSamples() == iExpected.size() );
+
+    for ( std::size_t i = 0; i < iExpected.size(); ++i )
+    {
+        Box3d value = bounds.getValue( ISampleSelector( ( index_t ) i ) );
+        TESTING_ASSERT( value.min.equalWithAbsError( iExpected[i].min, 1e-9 ) );
+        TESTING_ASSERT( value.max.equalWithAbsError( iExpected[i].max, 1e-9 ) );
+    }
+}
+
+//-*****************************************************************************
+void bakeTest( std::size_t iNumThreads )
+{
+    IArchive archive( Alembic::AbcCoreOgawa::ReadArchive(),
+                      "bakeBoundsIn.abc" );
+
+    {
+        OArchive sidecar( Alembic::AbcCoreOgawa::WriteArchive(),
+                          "bakeBoundsSidecar.abc" );
+        BakeBoundsOptions options;
+        options.numThreads = iNumThreads;
+        BakeBounds( archive, sidecar, options );
+    }
+
+    IArchive sidecar( Alembic::AbcCoreOgawa::ReadArchive(),
+                      "bakeBoundsSidecar.abc" );
+
+    // the three frames of a, then the two samples of c
+    chrono_t times[] = { 0.0, 1.0 / 24.0, 2.0 / 24.0, 0.5, 1.0 };
+    IBox3dProperty archiveBounds = GetIArchiveBounds( sidecar );
+    TESTING_ASSERT( archiveBounds.valid() );
+    TimeSamplingPtr ts = archiveBounds.getTimeSampling();
+    TESTING_ASSERT( archiveBounds.getNumSamples() == 5 );
+    for ( index_t i = 0; i < 5; ++i )
+    {
+        TESTING_ASSERT( Imath::equalWithAbsError(
+            ts->getSampleTime( i ), times[i], 1e-9 ) );
+    }
+
+    std::vector< Box3d > aBounds, bBounds, cBounds, topBounds;
+    for ( index_t i = 0; i < 5; ++i )
+    {
+        double x = 10.0 * ( std::min( i, index_t( 2 ) ) + 1 );
+        double z = ( i < 4 ) ? 0.0 : 1.0;
+
+        // b's points are at (0, 5, 0) to (2, 7, 2) in world space
+        aBounds.push_back( Box3d( V3d( -x, 0.0, 0.0 ), V3d( 1.0, 7.0, 2.0 ) ) );
+        bBounds.push_back( Box3d( V3d( 0.0 ), V3d( 2.0 ) ) );
+        cBounds.push_back( Box3d( V3d( -1.0, -1.0, z - 1.0 ),
+                                  V3d( 0.0, 0.0, z ) ) );
+        topBounds.push_back( Box3d( V3d( -1.0, -1.0, z - 1.0 ),
+                                    V3d( x + 1.0, 7.0, 2.0 ) ) );
+    }
+
+    IObject a = archive.getTop().getChild( "a" );
+    IObject b = a.getChild( "b" );
+    IObject c = archive.getTop().getChild( "c" );
+    checkBounds( sidecar, archive.getTop(), topBounds );
+    checkBounds( sidecar, a, aBounds );
+    checkBounds( sidecar, b, bBounds );
+    checkBounds( sidecar, c, cBounds );
+
+    // geometry has its own bounds baked too
+    IBox3dProperty self = GetBakedSelfBounds( sidecar, c.getChild( "pts" ) );
+    TESTING_ASSERT( self.valid() );
+    TESTING_ASSERT( self.getValue( ISampleSelector( ( index_t ) 4 ) ) ==
+                    cBounds[4] );
+    TESTING_ASSERT( !GetBakedSelfBounds( sidecar, a ).valid() );
+
+    // and objects the sidecar doesn't have come back invalid
+    IArchive other( Alembic::AbcCoreOgawa::ReadArchive(),
+                    "bakeBoundsIn.abc" );
+    TESTING_ASSERT( !GetBakedChildBounds( other, a.getChild( "pts" ) ).valid() );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    writeArchive( "bakeBoundsIn.abc" );
+    bakeTest( 1 );
+    bakeTest( 4 );
+    return 0;
+}
@@ -0,0 +1,333 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcGeom/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+namespace AbcG = Alembic::AbcGeom;
+using namespace AbcG;
+
+using Alembic::AbcCoreAbstract::index_t;
+using Alembic::Util::int32_t;
+
+//-*****************************************************************************
+// a grid of quads iSize positions across in x and y, at iZ
+void makeGrid( std::size_t iSize, float iZ, std::vector< V3f > & oPositions,
+               std::vector< int32_t > & oIndices,
+               std::vector< int32_t > & oCounts )
+{
+    oPositions.clear();
+    oIndices.clear();
+    oCounts.clear();
+
+    for ( std::size_t y = 0; y < iSize; ++y )
+    {
+        for ( std::size_t x = 0; x < iSize; ++x )
+        {
+            oPositions.push_back( V3f( x, y, iZ ) );
+        }
+    }
+
+    for ( std::size_t y = 0; y + 1 < iSize; ++y )
+    {
+        for ( std::size_t x = 0; x + 1 < iSize; ++x )
+        {
+            int32_t corner = y * iSize + x;
+            oIndices.push_back( corner );
+            oIndices.push_back( corner + 1 );
+            oIndices.push_back( corner + iSize + 1 );
+            oIndices.push_back( corner + iSize );
+            oCounts.push_back( 4 );
+        }
+    }
+}
+
+//-*****************************************************************************
+void writeArchive( const std::string & iName )
+{
+    OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(), iName );
+    TimeSamplingPtr frames( new TimeSampling( 1.0 / 24.0, 0.0 ) );
+
+    std::vector< V3f > positions;
+    std::vector< int32_t > indices;
+    std::vector< int32_t > counts;
+
+    // moves up 1 in z each frame
+    OPolyMesh mesh( archive.getTop(), "mesh", frames );
+    for ( std::size_t i = 0; i < 3; ++i )
+    {
+        makeGrid( 33, i, positions, indices, counts );
+        OPolyMeshSchema::Sample samp;
+        samp.setPositions( P3fArraySample( positions ) );
+        if ( i == 0 )
+        {
+            samp.setFaceIndices( Int32ArraySample( indices ) );
+            samp.setFaceCounts( Int32ArraySample( counts ) );
+        }
+        mesh.getSchema().set( samp );
+    }
+
+    makeGrid( 17, 0.0f, positions, indices, counts );
+    OSubD subd( archive.getTop(), "subd" );
+    OSubDSchema::Sample subdSamp;
+    subdSamp.setPositions( P3fArraySample( positions ) );
+    subdSamp.setFaceIndices( Int32ArraySample( indices ) );
+    subdSamp.setFaceCounts( Int32ArraySample( counts ) );
+    std::vector< int32_t > corners( 1, 0 );
+    std::vector< float > sharpnesses( 1, 2.0f );
+    subdSamp.setCornerIndices( Int32ArraySample( corners ) );
+    subdSamp.setCornerSharpnesses( FloatArraySample( sharpnesses ) );
+    subd.getSchema().set( subdSamp );
+
+    // too small to bother with
+    makeGrid( 2, 0.0f, positions, indices, counts );
+    OPolyMesh small( archive.getTop(), "small" );
+    small.getSchema().set( OPolyMeshSchema::Sample( V3fArraySample( positions ),
+        Int32ArraySample( indices ), Int32ArraySample( counts ) ) );
+}
+
+//-*****************************************************************************
+void checkLevel( P3fArraySamplePtr iPositions, Int32ArraySamplePtr iIndices,
+                 Int32ArraySamplePtr iCounts, const Box3d & iBounds )
+{
+    TESTING_ASSERT( iPositions && iIndices && iCounts );
+
+    std::size_t numIndices = 0;
+    for ( std::size_t i = 0; i < iCounts->size(); ++i )
+    {
+        TESTING_ASSERT( ( *iCounts )[i] >= 3 );
+        numIndices += ( *iCounts )[i];
+    }
+    TESTING_ASSERT( numIndices == iIndices->size() );
+
+    std::vector< bool > used( iPositions->size(), false );
+    for ( std::size_t i = 0; i < iIndices->size(); ++i )
+    {
+        int32_t index = ( *iIndices )[i];
+        TESTING_ASSERT( index >= 0 &&
+                        ( std::size_t ) index < iPositions->size() );
+        used[index] = true;
+    }
+
+    // every position is used, and stays within the full mesh
+    for ( std::size_t i = 0; i < iPositions->size(); ++i )
+    {
+        TESTING_ASSERT( used[i] );
+        TESTING_ASSERT( iBounds.intersects( V3d( ( *iPositions )[i] ) ) );
+    }
+}
+
+//-*****************************************************************************
+Alembic::Util::uint64_t bytesRead( IArchive & iArchive )
+{
+    AbcA::ArchiveStats stats;
+    iArchive.getStats( stats );
+
+    Alembic::Util::uint64_t bytes = 0;
+    for ( std::size_t i = 0; i < stats.streams.size(); ++i )
+    {
+        bytes += stats.streams[i].bytesRead;
+    }
+    return bytes;
+}
+
+//-*****************************************************************************
+void meshTest()
+{
+    {
+        IArchive in( Alembic::AbcCoreOgawa::ReadArchive(), "meshLodIn.abc" );
+        OArchive out( Alembic::AbcCoreOgawa::WriteArchive(),
+                      "meshLodOut.abc" );
+        BuildMeshLods( in, out );
+    }
+
+    IArchive in( Alembic::AbcCoreOgawa::ReadArchive(), "meshLodIn.abc" );
+    IArchive archive( Alembic::AbcCoreOgawa::ReadArchive(), "meshLodOut.abc" );
+
+    IPolyMeshSchema mesh = IPolyMesh( archive.getTop(), "mesh" ).getSchema();
+    TESTING_ASSERT( mesh.getNumLods() == 4 );
+    TESTING_ASSERT( mesh.getNumSamples() == 3 );
+    TESTING_ASSERT( mesh.getLodScreenSize( 1 ) == 400.0f );
+    TESTING_ASSERT( mesh.getLodScreenSize( 3 ) == 100.0f );
+
+    TESTING_ASSERT( mesh.selectLod( 1000.0f ) == 0 );
+    TESTING_ASSERT( mesh.selectLod( 400.0f ) == 0 );
+    TESTING_ASSERT( mesh.selectLod( 300.0f ) == 1 );
+    TESTING_ASSERT( mesh.selectLod( 150.0f ) == 2 );
+    TESTING_ASSERT( mesh.selectLod( 10.0f ) == 3 );
+
+    // level 0 is the mesh, copied as it was
+    IPolyMeshSchema inMesh = IPolyMesh( in.getTop(), "mesh" ).getSchema();
+    IPolyMeshSchema::Sample full;
+    mesh.getLod( full, 0, ISampleSelector( ( index_t ) 1 ) );
+    IPolyMeshSchema::Sample original = inMesh.getValue(
+        ISampleSelector( ( index_t ) 1 ) );
+    TESTING_ASSERT( full.getPositions()->getKey() ==
+                    original.getPositions()->getKey() );
+    TESTING_ASSERT( full.getFaceIndices()->getKey() ==
+                    original.getFaceIndices()->getKey() );
+
+    std::size_t numPositions = full.getPositions()->size();
+    for ( std::size_t level = 1; level < mesh.getNumLods(); ++level )
+    {
+        IPolyMeshSchema::Sample first;
+        mesh.getLod( first, level, ISampleSelector( ( index_t ) 0 ) );
+        checkLevel( first.getPositions(), first.getFaceIndices(),
+                    first.getFaceCounts(), first.getSelfBounds() );
+
+        // each level is coarser than the last
+        TESTING_ASSERT( first.getPositions()->size() < numPositions );
+        TESTING_ASSERT( first.getFaceCounts()->size() > 0 );
+        numPositions = first.getPositions()->size();
+
+        // the topology is shared, and moves with the mesh
+        IPolyMeshSchema::Sample last;
+        mesh.getLod( last, level, ISampleSelector( ( index_t ) 2 ) );
+        checkLevel( last.getPositions(), last.getFaceIndices(),
+                    last.getFaceCounts(), last.getSelfBounds() );
+        TESTING_ASSERT( last.getFaceIndices()->getKey() ==
+                        first.getFaceIndices()->getKey() );
+        TESTING_ASSERT( last.getPositions()->size() == numPositions );
+        for ( std::size_t i = 0; i < numPositions; ++i )
+        {
+            TESTING_ASSERT( ( ( *last.getPositions() )[i] -
+                ( *first.getPositions() )[i] ).equalWithAbsError(
+                V3f( 0.0f, 0.0f, 2.0f ), 1e-5f ) );
+        }
+
+        TESTING_ASSERT( !last.getVelocities() );
+    }
+
+    // about an eighth of the positions are left at the last level
+    TESTING_ASSERT( numPositions > 33 * 33 / 16 && numPositions < 33 * 33 / 4 );
+
+    // and reading a level doesn't read the others
+    archive.setStatsEnabled( true );
+    IPolyMeshSchema::Sample samp;
+    mesh.getLodForScreenSize( samp, 50.0f, ISampleSelector( ( index_t ) 1 ) );
+    Alembic::Util::uint64_t lodBytes = bytesRead( archive );
+    TESTING_ASSERT( samp.getPositions()->size() == numPositions );
+
+    archive.resetStats();
+    mesh.getLodForScreenSize( samp, 500.0f, ISampleSelector( ( index_t ) 1 ) );
+    TESTING_ASSERT( samp.getPositions()->size() == 33 * 33 );
+    TESTING_ASSERT( lodBytes * 4 < bytesRead( archive ) );
+
+    ISubDSchema subd = ISubD( archive.getTop(), "subd" ).getSchema();
+    TESTING_ASSERT( subd.getNumLods() == 4 );
+    ISubDSchema::Sample subdSamp;
+    subd.getLod( subdSamp, 2 );
+    checkLevel( subdSamp.getPositions(), subdSamp.getFaceIndices(),
+                subdSamp.getFaceCounts(), subdSamp.getSelfBounds() );
+    TESTING_ASSERT( subdSamp.getPositions()->size() < 17 * 17 );
+    TESTING_ASSERT( subdSamp.getSubdivisionScheme() == "catmull-clark" );
+
+    // corners index level 0
+    TESTING_ASSERT( !subdSamp.getCornerIndices() );
+    subd.getLod( subdSamp, 0 );
+    TESTING_ASSERT( subdSamp.getCornerIndices()->size() == 1 );
+
+    IPolyMeshSchema small = IPolyMesh( archive.getTop(), "small" ).getSchema();
+    TESTING_ASSERT( small.getNumLods() == 1 );
+    TESTING_ASSERT( small.selectLod( 1.0f ) == 0 );
+}
+
+//-*****************************************************************************
+void writerTest()
+{
+    std::vector< V3f > positions;
+    std::vector< int32_t > indices;
+    std::vector< int32_t > counts;
+    makeGrid( 9, 0.0f, positions, indices, counts );
+
+    {
+        OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(),
+                          "meshLodWriter.abc" );
+        OPolyMesh mesh( archive.getTop(), "mesh" );
+        mesh.getSchema().set( OPolyMeshSchema::Sample(
+            V3fArraySample( positions ), Int32ArraySample( indices ),
+            Int32ArraySample( counts ) ) );
+
+        MeshDecimation decimation;
+        decimation.build( V3fArraySample( positions ),
+                          Int32ArraySample( indices ),
+                          Int32ArraySample( counts ), 0.25f );
+
+        std::vector< V3f > decimated;
+        decimation.decimate( V3fArraySample( positions ), decimated );
+        TESTING_ASSERT( decimated.size() == decimation.getNumPositions() );
+        TESTING_ASSERT( decimated.size() < positions.size() );
+
+        std::vector< float > screenSizes( 1, 32.0f );
+        OMeshLods lods( mesh.getSchema(), screenSizes );
+        TESTING_ASSERT( lods.getNumLevels() == 2 );
+        lods.set( 1, V3fArraySample( decimated ),
+                  Int32ArraySample( decimation.getFaceIndices() ),
+                  Int32ArraySample( decimation.getFaceCounts() ) );
+
+        // a single cluster has nothing left to draw
+        decimation.build( V3fArraySample( positions ),
+                          Int32ArraySample( indices ),
+                          Int32ArraySample( counts ), 0.0f );
+        TESTING_ASSERT( decimation.getNumPositions() == 0 );
+        TESTING_ASSERT( decimation.getFaceCounts().empty() );
+    }
+
+    IArchive archive( Alembic::AbcCoreOgawa::ReadArchive(),
+                      "meshLodWriter.abc" );
+    IPolyMeshSchema mesh = IPolyMesh( archive.getTop(), "mesh" ).getSchema();
+    TESTING_ASSERT( mesh.getNumLods() == 2 );
+    TESTING_ASSERT( mesh.selectLod( 31.0f ) == 1 );
+
+    IPolyMeshSchema::Sample samp;
+    mesh.getLod( samp, 1 );
+    checkLevel( samp.getPositions(), samp.getFaceIndices(),
+                samp.getFaceCounts(), samp.getSelfBounds() );
+
+    // copies share the levels
+    IPolyMeshSchema copy( mesh );
+    TESTING_ASSERT( copy.getNumLods() == 2 );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    writeArchive( "meshLodIn.abc" );
+    meshTest();
+    writerTest();
+    return 0;
+}
@@ -475,6 +475,165 @@ void optPropTest()
     }
 }
 
+//-*****************************************************************************
+void brickedPointsTest()
+{
+    std::string name = "pointsBrickedTest.abc";
+    size_t numPoints = 1000;
+
+    std::vector<V3f> verts( numPoints );
+    std::vector< Alembic::Util::uint64_t > ids( numPoints );
+    std::vector<V3f> veloc( numPoints );
+    std::vector<float> widths( numPoints );
+    for ( size_t i = 0; i < numPoints; ++i )
+    {
+        verts[i] = V3f( i % 10, ( i / 10 ) % 10, i / 100 );
+        ids[i] = 1000 + i;
+        veloc[i] = V3f( i, 0.0, 0.0 );
+        widths[i] = i;
+    }
+
+    {
+        OArchive archive( Alembic::AbcCoreHDF5::WriteArchive(), name );
+        OPoints ptObj( OObject( archive, kTop ), "pts" );
+        OPointsSchema &pt = ptObj.getSchema();
+        pt.setBrickSize( 64 );
+        TESTING_ASSERT( pt.getBrickSize() == 64 );
+
+        OFloatGeomParam::Sample widthSamp( FloatArraySample( widths ),
+                                           kVertexScope );
+        OPointsSchema::Sample samp( P3fArraySample( verts ),
+                                    UInt64ArraySample( ids ),
+                                    V3fArraySample( veloc ), widthSamp );
+        pt.set( samp );
+
+        // anything else per point is written in the order the points were
+        const std::vector<size_t> &order = pt.getBrickOrder();
+        TESTING_ASSERT( order.size() == numPoints );
+        std::vector<float> age( numPoints );
+        for ( size_t i = 0; i < numPoints; ++i )
+        {
+            age[i] = order[i];
+        }
+        OFloatGeomParam ageParam( pt.getArbGeomParams(), "age", false,
+                                  kVertexScope, 1 );
+        ageParam.set( OFloatGeomParam::Sample( FloatArraySample( age ),
+                                               kVertexScope ) );
+
+        // just velocities, which have to follow the previous order
+        for ( size_t i = 0; i < numPoints; ++i )
+        {
+            veloc[i].y = 1.0;
+        }
+        pt.set( OPointsSchema::Sample( P3fArraySample(),
+                                       V3fArraySample( veloc ) ) );
+
+        // bricking can't be changed after the first sample
+        TESTING_ASSERT_THROW( pt.setBrickSize( 32 ),
+                              Alembic::Util::Exception );
+    }
+
+    {
+        IArchive archive( Alembic::AbcCoreHDF5::ReadArchive(), name );
+        IPoints ptsObj( IObject( archive, kTop ), "pts" );
+        IPointsSchema &pts = ptsObj.getSchema();
+        TESTING_ASSERT( pts.isBricked() );
+        TESTING_ASSERT( pts.getNumSamples() == 2 );
+
+        // the points are reordered, but still all there and matched up
+        IPointsSchema::Sample full;
+        IFloatGeomParam::Sample fullWidths;
+        IFloatGeomParam ageParam( pts.getArbGeomParams(), "age" );
+        FloatArraySamplePtr age = ageParam.getExpandedValue().getVals();
+        for ( index_t s = 0; s < 2; ++s )
+        {
+            pts.get( full, s );
+            pts.getWidthsParam().getExpanded( fullWidths, s );
+            TESTING_ASSERT( full.getPositions()->size() == numPoints );
+            std::vector<bool> seen( numPoints, false );
+            for ( size_t i = 0; i < numPoints; ++i )
+            {
+                size_t orig = full.getIds()->get()[i] - 1000;
+                TESTING_ASSERT( !seen[orig] );
+                seen[orig] = true;
+                TESTING_ASSERT( full.getPositions()->get()[i] ==
+                                verts[orig] );
+                TESTING_ASSERT( full.getVelocities()->get()[i] ==
+                                V3f( orig, s, 0.0 ) );
+                TESTING_ASSERT( fullWidths.getVals()->get()[i] ==
+                                widths[orig] );
+                TESTING_ASSERT( age->get()[i] == orig );
+            }
+        }
+
+        UInt64ArraySamplePtr starts;
+        pts.getBrickStartsProperty().get( starts );
+        UInt64ArraySamplePtr idRanges;
+        pts.getBrickIdRangesProperty().get( idRanges );
+        Box3dArraySamplePtr bounds;
+        pts.getBrickBoundsProperty().get( bounds );
+        TESTING_ASSERT( bounds->size() == 16 );
+        TESTING_ASSERT( starts->size() == bounds->size() + 1 );
+        TESTING_ASSERT( idRanges->size() == bounds->size() * 2 );
+        for ( size_t b = 0; b < bounds->size(); ++b )
+        {
+            TESTING_ASSERT( ( *starts )[b + 1] - ( *starts )[b] <= 64 );
+            for ( size_t i = ( *starts )[b]; i < ( *starts )[b + 1]; ++i )
+            {
+                TESTING_ASSERT( ( *bounds )[b].intersects(
+                    V3d( full.getPositions()->get()[i] ) ) );
+                TESTING_ASSERT( full.getIds()->get()[i] >=
+                                ( *idRanges )[b * 2] );
+                TESTING_ASSERT( full.getIds()->get()[i] <=
+                                ( *idRanges )[b * 2 + 1] );
+            }
+        }
+
+        // every point in the region, and not many others
+        Box3d region( V3d( 0.0, 0.0, 0.0 ), V3d( 2.0, 2.0, 2.0 ) );
+        IPointsSchema::Sample part;
+        pts.getRegion( part, region, 1 );
+        size_t numPart = part.getPositions()->size();
+        TESTING_ASSERT( numPart < numPoints / 4 );
+        TESTING_ASSERT( part.getIds()->size() == numPart );
+        TESTING_ASSERT( part.getVelocities()->size() == numPart );
+        TESTING_ASSERT( part.getSelfBounds().intersects( region ) );
+
+        size_t numInside = 0;
+        for ( size_t i = 0; i < numPart; ++i )
+        {
+            size_t orig = part.getIds()->get()[i] - 1000;
+            TESTING_ASSERT( part.getPositions()->get()[i] == verts[orig] );
+            TESTING_ASSERT( part.getVelocities()->get()[i] ==
+                            V3f( orig, 1.0, 0.0 ) );
+            if ( region.intersects( V3d( verts[orig] ) ) )
+            {
+                numInside ++;
+            }
+        }
+        TESTING_ASSERT( numInside == 27 );
+
+        // the view of an identity clip transform is the -1 to 1 cube,
+        // which holds just the point at the origin
+        IPointsSchema::Sample viewed;
+        pts.getFrustum( viewed, M44d(), 0 );
+        TESTING_ASSERT( viewed.getPositions()->size() > 0 );
+        TESTING_ASSERT( viewed.getPositions()->size() <= 64 );
+        bool foundOrigin = false;
+        for ( size_t i = 0; i < viewed.getIds()->size(); ++i )
+        {
+            foundOrigin = foundOrigin || viewed.getIds()->get()[i] == 1000;
+        }
+        TESTING_ASSERT( foundOrigin );
+
+        // looking somewhere else entirely finds nothing
+        M44d away;
+        away.setTranslation( V3d( 100.0, 0.0, 0.0 ) );
+        pts.getFrustum( viewed, away, 0 );
+        TESTING_ASSERT( viewed.getPositions()->size() == 0 );
+    }
+}
+
 //-*****************************************************************************
 //-*****************************************************************************
 //-*****************************************************************************
@@ -511,5 +670,7 @@ int main( int argc, char *argv[] )
 
     optPropTest();
 
+    brickedPointsTest();
+
     return 0;
 }
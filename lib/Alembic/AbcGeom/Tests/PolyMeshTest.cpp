@@ -226,6 +226,21 @@ void Example1_MeshIn()
     TESTING_ASSERT( uv2 == V2f( 1.0f, 1.0f ) );
     std::cout << "2th UV: " << uv2 << std::endl;
 
+    // a range of the expanded values, both indexed and not
+    V2fArraySamplePtr uvExpanded = uv.getExpandedValue().getVals();
+    TESTING_ASSERT( uvExpanded->size() > 3 );
+    V2f uvRange[3];
+    uv.getExpandedRange( uvRange, 1, 3 );
+    for ( size_t i = 0 ; i < 3 ; ++i )
+    {
+        TESTING_ASSERT( uvRange[i] == (*uvExpanded)[i + 1] );
+    }
+
+    N3f nRange[2];
+    N.getExpandedRange( nRange, nsp->size() - 2, 2 );
+    TESTING_ASSERT( nRange[0] == (*nsp)[nsp->size() - 2] );
+    TESTING_ASSERT( nRange[1] == (*nsp)[nsp->size() - 1] );
+
     std::cout << "Mesh num vertices: "
               << mesh_samp.getPositions()->size() << std::endl;
 
@@ -234,6 +249,33 @@ void Example1_MeshIn()
 
     std::cout << "0th vertex from the mesh sample with get method: "
               << mesh_samp.getPositions()->get()[0] << std::endl;
+
+    // size the buffers, then read straight into them
+    size_t numPositions = 0, numIndices = 0, numCounts = 0;
+    TESTING_ASSERT( !mesh.getInto( NULL, numPositions, NULL, numIndices,
+                                   NULL, numCounts ) );
+    TESTING_ASSERT( numPositions == mesh_samp.getPositions()->size() );
+    TESTING_ASSERT( numIndices == mesh_samp.getFaceIndices()->size() );
+    TESTING_ASSERT( numCounts == mesh_samp.getFaceCounts()->size() );
+
+    std::vector< V3f > positions( numPositions );
+    std::vector< int32_t > indices( numIndices );
+    std::vector< int32_t > counts( numCounts );
+    TESTING_ASSERT( mesh.getInto( &positions.front(), numPositions,
+                                  &indices.front(), numIndices,
+                                  &counts.front(), numCounts ) );
+    for ( size_t i = 0; i < numPositions; ++i )
+    {
+        TESTING_ASSERT( positions[i] == (*(mesh_samp.getPositions()))[i] );
+    }
+    for ( size_t i = 0; i < numIndices; ++i )
+    {
+        TESTING_ASSERT( indices[i] == (*(mesh_samp.getFaceIndices()))[i] );
+    }
+    for ( size_t i = 0; i < numCounts; ++i )
+    {
+        TESTING_ASSERT( counts[i] == (*(mesh_samp.getFaceCounts()))[i] );
+    }
 }
 
 //-*****************************************************************************
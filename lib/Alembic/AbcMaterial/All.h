@@ -41,5 +41,6 @@
 #include <Alembic/AbcMaterial/OMaterial.h>
 #include <Alembic/AbcMaterial/MaterialAssignment.h>
 #include <Alembic/AbcMaterial/MaterialFlatten.h>
+#include <Alembic/AbcMaterial/MaterialResolver.h>
 
 #endif
@@ -216,6 +216,9 @@ public:
 
 private:
 
+    // shares the schemas of cached flattens
+    friend class MaterialResolver;
+
     SchemaVector m_schemas;
 
     void flattenNetwork();
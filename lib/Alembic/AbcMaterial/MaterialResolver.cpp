@@ -0,0 +1,314 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcMaterial/MaterialResolver.h>
+#include <Alembic/AbcMaterial/MaterialAssignment.h>
+
+namespace Alembic {
+namespace AbcMaterial {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+// the names along iPath, walked the same way MaterialFlatten does so
+// that a path resolves to the same object either way
+void splitPath( const std::string & iPath, std::vector<std::string> & oNames )
+{
+    oNames.clear();
+
+    size_t lastPos = 0;
+    bool isDone = false;
+
+    while ( ! isDone )
+    {
+        size_t curPos = iPath.find( '/', lastPos );
+        size_t length = 0;
+
+        if ( curPos == std::string::npos )
+        {
+            isDone = true;
+            length = std::string::npos;
+        }
+        // no other characters between / (starting / or multiple / in a row)
+        else if ( lastPos == curPos )
+        {
+            lastPos = curPos + 1;
+            if ( lastPos == iPath.size() )
+            {
+                isDone = true;
+            }
+            continue;
+        }
+        else
+        {
+            length = curPos - lastPos;
+        }
+
+        oNames.push_back( iPath.substr( lastPos, length ) );
+        lastPos = curPos + 1;
+    }
+}
+
+std::string joinPath( const std::vector<std::string> & iNames, size_t iEnd )
+{
+    std::string path;
+    for ( size_t i = 0; i < iEnd; ++i )
+    {
+        if ( i > 0 )
+        {
+            path += '/';
+        }
+        path += iNames[i];
+    }
+    return path;
+}
+
+}
+
+MaterialResolver::MaterialResolver( Abc::IArchive iArchive )
+: m_archive( iArchive )
+{
+    ABCA_ASSERT( m_archive.valid(),
+                 "MaterialResolver needs a valid archive" );
+}
+
+Abc::IObject MaterialResolver::getObject( const std::string & iPath )
+{
+    std::vector<std::string> names;
+    splitPath( iPath, names );
+
+    // start from the deepest parent already walked to
+    Abc::IObject parent;
+    size_t start = 0;
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+
+        for ( size_t i = names.size(); i > 0 && !parent.valid(); --i )
+        {
+            std::map<std::string, Abc::IObject>::iterator it =
+                m_objects.find( joinPath( names, i ) );
+            if ( it != m_objects.end() )
+            {
+                // a path which wasn't found is cached too
+                if ( !it->second.valid() || i == names.size() )
+                {
+                    ++m_stats.hits;
+                    return it->second;
+                }
+                parent = it->second;
+                start = i;
+            }
+        }
+        ++m_stats.misses;
+    }
+
+    if ( !parent.valid() )
+    {
+        parent = m_archive.getTop();
+    }
+
+    std::vector<Abc::IObject> walked;
+    for ( size_t i = start; i < names.size(); ++i )
+    {
+        if ( parent.getChildHeader( names[i] ) )
+        {
+            parent = parent.getChild( names[i] );
+        }
+        else
+        {
+            parent = Abc::IObject();
+        }
+
+        walked.push_back( parent );
+        if ( !parent.valid() )
+        {
+            break;
+        }
+    }
+
+    Alembic::Util::scoped_lock l( m_lock );
+    for ( size_t i = 0; i < walked.size(); ++i )
+    {
+        m_objects.insert( std::make_pair(
+            joinPath( names, start + i + 1 ), walked[i] ) );
+    }
+
+    return parent;
+}
+
+MaterialResolver::MaterialFlattenPtr
+MaterialResolver::getChain( const std::string & iPath )
+{
+    std::vector<std::string> names;
+    splitPath( iPath, names );
+    std::string key = joinPath( names, names.size() );
+
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+
+        std::map<std::string, MaterialFlattenPtr>::iterator it =
+            m_chains.find( key );
+        if ( it != m_chains.end() )
+        {
+            ++m_stats.hits;
+            return it->second;
+        }
+        ++m_stats.misses;
+    }
+
+    // read without the lock, another thread may get here first
+    Abc::IObject object = getObject( key );
+
+    Alembic::Util::shared_ptr<MaterialFlatten> chain( new MaterialFlatten() );
+    if ( object.valid() && IMaterial::matches( object.getHeader() ) )
+    {
+        chain->append( IMaterial( object, Abc::kWrapExisting ) );
+    }
+
+    // flatten the network now, since the shared copy is never changed
+    chain->getNumNetworkNodes();
+
+    Alembic::Util::scoped_lock l( m_lock );
+    return m_chains.insert( std::make_pair( key, chain ) ).first->second;
+}
+
+MaterialFlatten
+MaterialResolver::getFlatten( const std::string & iMaterialPath )
+{
+    return *getChain( iMaterialPath );
+}
+
+MaterialFlatten MaterialResolver::getFlatten( Abc::IObject iObject )
+{
+    MaterialFlatten result;
+
+    //first apply a local material
+    IMaterialSchema localMaterial;
+    if ( hasMaterial( iObject, localMaterial ) )
+    {
+        result.append( localMaterial );
+    }
+
+    //then apply the inheritance chain of an assigned material
+    std::string assignedPath;
+    if ( getMaterialAssignmentPath( iObject, assignedPath ) )
+    {
+        MaterialFlattenPtr chain = getChain( assignedPath );
+        if ( result.empty() )
+        {
+            return *chain;
+        }
+
+        for ( MaterialFlatten::SchemaVector::const_iterator i =
+              chain->m_schemas.begin(); i != chain->m_schemas.end(); ++i )
+        {
+            result.append( *i );
+        }
+    }
+
+    return result;
+}
+
+void MaterialResolver::getShaderParameters( Abc::IObject iObject,
+    const std::string & iTarget,
+    const std::string & iShaderType,
+    MaterialFlatten::ParameterEntryVector & oResult )
+{
+    // a local material is only used by this object, not worth keeping
+    IMaterialSchema localMaterial;
+    if ( hasMaterial( iObject, localMaterial ) )
+    {
+        getFlatten( iObject ).getShaderParameters( iTarget, iShaderType,
+                                                   oResult );
+        return;
+    }
+
+    std::string assignedPath;
+    if ( !getMaterialAssignmentPath( iObject, assignedPath ) )
+    {
+        oResult.clear();
+        return;
+    }
+
+    std::vector<std::string> names;
+    splitPath( assignedPath, names );
+    ParameterKey key( joinPath( names, names.size() ),
+                      std::make_pair( iTarget, iShaderType ) );
+
+    {
+        Alembic::Util::scoped_lock l( m_lock );
+
+        std::map<ParameterKey, ParameterEntryVectorPtr>::iterator it =
+            m_parameters.find( key );
+        if ( it != m_parameters.end() )
+        {
+            ++m_stats.hits;
+            oResult = *( it->second );
+            return;
+        }
+        ++m_stats.misses;
+    }
+
+    MaterialFlatten chain( *getChain( key.first ) );
+
+    Alembic::Util::shared_ptr<MaterialFlatten::ParameterEntryVector>
+        parameters( new MaterialFlatten::ParameterEntryVector() );
+    chain.getShaderParameters( iTarget, iShaderType, *parameters );
+
+    oResult = *parameters;
+
+    Alembic::Util::scoped_lock l( m_lock );
+    m_parameters.insert( std::make_pair( key, parameters ) );
+}
+
+MaterialResolver::Stats MaterialResolver::getStats()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    return m_stats;
+}
+
+void MaterialResolver::clear()
+{
+    Alembic::Util::scoped_lock l( m_lock );
+    m_objects.clear();
+    m_chains.clear();
+    m_parameters.clear();
+    m_stats = Stats();
+}
+
+}
+}
+}
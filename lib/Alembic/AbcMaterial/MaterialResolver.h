@@ -0,0 +1,128 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcMaterial_MaterialResolver_h_
+#define _Alembic_AbcMaterial_MaterialResolver_h_
+
+#include <Alembic/AbcMaterial/MaterialFlatten.h>
+
+namespace Alembic {
+namespace AbcMaterial {
+namespace ALEMBIC_VERSION_NS {
+
+//! Resolves the materials of many objects against one archive, sharing the
+//! work between objects which are assigned the same material.
+//!
+//! Each assigned path is walked from the top of the archive once, and the
+//! walks share their common parents.  The inheritance chain of a material is
+//! read and its network flattened once, and shader parameters are gathered
+//! once per material, target and shader type.  Objects with a material of
+//! their own have that put first, as MaterialFlatten does, and their
+//! parameters aren't cached.
+//!
+//! It is safe to call from many threads at once.
+class MaterialResolver : Alembic::Util::noncopyable
+{
+public:
+
+    //! Assigned material paths are looked up in iArchive, whichever
+    //! archive the objects come from.  This is the alternate search
+    //! archive of MaterialFlatten.
+    MaterialResolver( Abc::IArchive iArchive );
+
+    //! The same as MaterialFlatten( iObject, archive ).
+    MaterialFlatten getFlatten( Abc::IObject iObject );
+
+    //! The flattened material at iPath and the materials it inherits from,
+    //! empty if there is no material there.
+    MaterialFlatten getFlatten( const std::string & iMaterialPath );
+
+    //! The object at iPath, invalid if there is none.
+    Abc::IObject getObject( const std::string & iPath );
+
+    //! The same as getFlatten( iObject ).getShaderParameters.
+    void getShaderParameters( Abc::IObject iObject,
+                              const std::string & iTarget,
+                              const std::string & iShaderType,
+                              MaterialFlatten::ParameterEntryVector & oResult );
+
+    //! How often a cached path, material or set of parameters was found.
+    struct Stats
+    {
+        Stats() : hits( 0 ), misses( 0 ) {}
+
+        size_t hits;
+        size_t misses;
+    };
+
+    Stats getStats();
+
+    //! Lets go of everything cached, for instance after the archive is
+    //! done with.
+    void clear();
+
+private:
+
+    typedef Alembic::Util::shared_ptr<const MaterialFlatten> MaterialFlattenPtr;
+    typedef Alembic::Util::shared_ptr<
+        const MaterialFlatten::ParameterEntryVector > ParameterEntryVectorPtr;
+
+    MaterialFlattenPtr getChain( const std::string & iPath );
+
+    Abc::IArchive m_archive;
+
+    Alembic::Util::mutex m_lock;
+
+    // keyed by paths without empty names, "a/b" for "/a//b/"
+    std::map<std::string, Abc::IObject> m_objects;
+    std::map<std::string, MaterialFlattenPtr> m_chains;
+
+    // keyed by path, target and shader type
+    typedef std::pair< std::string,
+        std::pair< std::string, std::string > > ParameterKey;
+    std::map<ParameterKey, ParameterEntryVectorPtr> m_parameters;
+
+    Stats m_stats;
+};
+
+}
+
+using namespace ALEMBIC_VERSION_NS;
+
+}
+}
+
+#endif
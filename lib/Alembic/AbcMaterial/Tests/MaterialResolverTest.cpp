@@ -0,0 +1,310 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/Abc/All.h>
+#include <Alembic/AbcCoreHDF5/All.h>
+#include <Alembic/AbcMaterial/All.h>
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <sstream>
+
+#ifndef _MSC_VER
+#include <pthread.h>
+#endif
+
+namespace Abc = Alembic::Abc;
+namespace Mat = Alembic::AbcMaterial;
+
+static const size_t kNumGeometry = 60;
+static const size_t kNumThreads = 4;
+
+//-*****************************************************************************
+void setFloatParameter( Mat::OMaterialSchema & schema,
+                        const std::string & target,
+                        const std::string & shaderType,
+                        const std::string & paramName, float value )
+{
+    Abc::OFloatProperty prop(
+        schema.getShaderParameters( target, shaderType ), paramName );
+    prop.set( value );
+}
+
+//-*****************************************************************************
+std::string geometryName( size_t i )
+{
+    std::ostringstream name;
+    name << "geo" << i;
+    return name.str();
+}
+
+//-*****************************************************************************
+void write( const std::string & iName )
+{
+    Abc::OArchive archive( Alembic::AbcCoreHDF5::WriteArchive(), iName );
+
+    Abc::OObject root( archive, Abc::kTop );
+    Abc::OObject materials( root, "materials" );
+    Abc::OObject geometry( root, "geometry" );
+
+    Mat::OMaterial materialA( materials, "materialA" );
+    materialA.getSchema().setShader( "prman", "surface", "paintedplastic" );
+    setFloatParameter( materialA.getSchema(), "prman", "surface", "Kd", 0.5 );
+    setFloatParameter( materialA.getSchema(), "prman", "surface",
+                       "roughness", 0.1 );
+
+    Mat::OMaterial materialB( materialA, "materialB" );
+    materialB.getSchema().setShader( "prman", "displacement", "knobby" );
+    setFloatParameter( materialB.getSchema(), "prman", "surface",
+                       "roughness", 0.2 );
+
+    // a handful of materials shared by many objects, with the paths
+    // written a few different ways, and some which don't resolve
+    const char * paths[] = {
+        "/materials/materialA",
+        "/materials/materialA/materialB",
+        "materials//materialA/materialB/",
+        "/materials/materialC",
+        "/materials"
+    };
+
+    for ( size_t i = 0; i < kNumGeometry; ++i )
+    {
+        Abc::OObject geo( geometry, geometryName( i ) );
+        if ( i % 7 != 6 )
+        {
+            Mat::addMaterialAssignment( geo, paths[i % 5] );
+        }
+
+        // some have a material of their own too
+        if ( i % 4 == 3 )
+        {
+            Mat::OMaterialSchema local = Mat::addMaterial( geo );
+            setFloatParameter( local, "prman", "surface", "roughness",
+                               0.3 );
+        }
+    }
+}
+
+//-*****************************************************************************
+// what a flattened material comes to, for comparing two of them
+std::string describe( Mat::MaterialFlatten & iFlatten )
+{
+    std::ostringstream desc;
+
+    std::vector<std::string> targets;
+    iFlatten.getTargetNames( targets );
+    for ( size_t t = 0; t < targets.size(); ++t )
+    {
+        std::vector<std::string> types;
+        iFlatten.getShaderTypesForTarget( targets[t], types );
+        for ( size_t s = 0; s < types.size(); ++s )
+        {
+            std::string shader;
+            iFlatten.getShader( targets[t], types[s], shader );
+            desc << targets[t] << "." << types[s] << "=" << shader << " ";
+
+            Mat::MaterialFlatten::ParameterEntryVector params;
+            iFlatten.getShaderParameters( targets[t], types[s], params );
+            for ( size_t p = 0; p < params.size(); ++p )
+            {
+                Abc::IFloatProperty prop( params[p].parent, params[p].name );
+                desc << params[p].name << ":" << prop.getValue() << " ";
+            }
+        }
+    }
+
+    desc << "nodes:" << iFlatten.getNumNetworkNodes();
+    return desc.str();
+}
+
+//-*****************************************************************************
+std::string describe(
+    const Mat::MaterialFlatten::ParameterEntryVector & iParams )
+{
+    std::ostringstream desc;
+    for ( size_t p = 0; p < iParams.size(); ++p )
+    {
+        Abc::IFloatProperty prop( iParams[p].parent, iParams[p].name );
+        desc << iParams[p].name << ":" << prop.getValue() << " ";
+    }
+    return desc.str();
+}
+
+//-*****************************************************************************
+void testMatchesFlatten( const std::string & iName )
+{
+    Abc::IArchive archive( Alembic::AbcCoreHDF5::ReadArchive(), iName );
+    Abc::IObject geometry = archive.getTop().getChild( "geometry" );
+
+    Mat::MaterialResolver resolver( archive );
+
+    // twice, the second time everything comes from the caches
+    for ( size_t round = 0; round < 2; ++round )
+    {
+        for ( size_t i = 0; i < geometry.getNumChildren(); ++i )
+        {
+            Abc::IObject geo = geometry.getChild( i );
+
+            Mat::MaterialFlatten expected( geo, archive );
+            Mat::MaterialFlatten resolved = resolver.getFlatten( geo );
+            TESTING_ASSERT( expected.empty() == resolved.empty() );
+            TESTING_ASSERT( describe( expected ) == describe( resolved ) );
+
+            Mat::MaterialFlatten::ParameterEntryVector expectedParams;
+            Mat::MaterialFlatten::ParameterEntryVector resolvedParams;
+            expected.getShaderParameters( "prman", "surface",
+                                          expectedParams );
+            resolver.getShaderParameters( geo, "prman", "surface",
+                                          resolvedParams );
+            TESTING_ASSERT( describe( expectedParams ) ==
+                            describe( resolvedParams ) );
+        }
+    }
+
+    // the shared materials were only read once
+    Mat::MaterialResolver::Stats stats = resolver.getStats();
+    TESTING_ASSERT( stats.hits > stats.misses );
+
+    // paths are looked up the same however they are written
+    TESTING_ASSERT( resolver.getObject( "materials/materialA" ).getName()
+                    == "materialA" );
+    TESTING_ASSERT( resolver.getObject( "//materials/materialA" ).getName()
+                    == "materialA" );
+    TESTING_ASSERT( !resolver.getObject( "/materials/nope" ).valid() );
+    TESTING_ASSERT( !resolver.getObject( "/materials/nope/deeper" ).valid() );
+    TESTING_ASSERT( resolver.getFlatten( "/materials/nope" ).empty() );
+    TESTING_ASSERT( !resolver.getFlatten(
+        "materials/materialA/materialB" ).empty() );
+
+    resolver.clear();
+    TESTING_ASSERT( resolver.getStats().hits == 0 );
+    TESTING_ASSERT( resolver.getObject( "/materials/materialA" ).valid() );
+}
+
+#ifndef _MSC_VER
+//-*****************************************************************************
+struct ResolveArgs
+{
+    Mat::MaterialResolver * resolver;
+    Abc::IObject geometry;
+    std::vector<std::string> * expected;
+    size_t thread;
+    bool ok;
+};
+
+//-*****************************************************************************
+void * resolveAll( void * iArgs )
+{
+    ResolveArgs & args = *( static_cast<ResolveArgs *>( iArgs ) );
+
+    try
+    {
+        size_t numGeometry = args.geometry.getNumChildren();
+        for ( size_t j = 0; j < numGeometry; ++j )
+        {
+            // each thread starts somewhere else
+            size_t i = ( j + args.thread * 7 ) % numGeometry;
+            Abc::IObject geo = args.geometry.getChild( i );
+
+            Mat::MaterialFlatten::ParameterEntryVector params;
+            args.resolver->getShaderParameters( geo, "prman", "surface",
+                                                params );
+            if ( describe( params ) != ( *args.expected )[i] )
+            {
+                args.ok = false;
+            }
+
+            Mat::MaterialFlatten flatten = args.resolver->getFlatten( geo );
+            std::string shader;
+            flatten.getShader( "prman", "surface", shader );
+        }
+    }
+    catch ( ... )
+    {
+        args.ok = false;
+    }
+
+    return NULL;
+}
+
+//-*****************************************************************************
+void testConcurrentResolve( const std::string & iName )
+{
+    Abc::IArchive archive( Alembic::AbcCoreHDF5::ReadArchive(), iName );
+    Abc::IObject geometry = archive.getTop().getChild( "geometry" );
+
+    std::vector<std::string> expected;
+    for ( size_t i = 0; i < geometry.getNumChildren(); ++i )
+    {
+        Mat::MaterialFlatten flatten( geometry.getChild( i ), archive );
+        Mat::MaterialFlatten::ParameterEntryVector params;
+        flatten.getShaderParameters( "prman", "surface", params );
+        expected.push_back( describe( params ) );
+    }
+
+    Mat::MaterialResolver resolver( archive );
+
+    std::vector<ResolveArgs> args( kNumThreads );
+    std::vector<pthread_t> threads( kNumThreads );
+    for ( size_t i = 0; i < kNumThreads; ++i )
+    {
+        args[i].resolver = &resolver;
+        args[i].geometry = geometry;
+        args[i].expected = &expected;
+        args[i].thread = i;
+        args[i].ok = true;
+        pthread_create( &threads[i], NULL, resolveAll, &args[i] );
+    }
+
+    for ( size_t i = 0; i < kNumThreads; ++i )
+    {
+        pthread_join( threads[i], NULL );
+        TESTING_ASSERT( args[i].ok );
+    }
+}
+#endif
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string name = "MaterialResolver.abc";
+    write( name );
+    testMatchesFlatten( name );
+#ifndef _MSC_VER
+    testConcurrentResolve( name );
+#endif
+    return 0;
+}
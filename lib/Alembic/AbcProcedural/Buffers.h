@@ -0,0 +1,206 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcProcedural_Buffers_h_
+#define _Alembic_AbcProcedural_Buffers_h_
+
+#include <Alembic/AbcProcedural/Foundation.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+// The geometry of an object read at each of its sample times, in a form
+// which doesn't depend on any renderer.  Array data read from the archive
+// is held as is, without copying, while geometry parameters are expanded
+// out of their indices.
+//-*****************************************************************************
+
+//-*****************************************************************************
+//! An object's place in the expanded hierarchy.
+struct ObjectInfo
+{
+    ObjectInfo() : depth( 0 ), visible( true ) {}
+
+    Abc::IObject object;
+
+    //! 0 for the objects directly beneath the root being expanded.
+    std::size_t depth;
+
+    //! Whether the object, or the nearest parent which says, is visible.
+    //! Hidden geometry is left empty.
+    bool visible;
+
+    //! For a SubD at the end of the object path, the face set named by
+    //! the path after it, if there is one.
+    std::string faceSet;
+};
+
+//-*****************************************************************************
+struct XformBuffer
+{
+    XformBuffer() : inheritsXforms( true ) {}
+
+    bool inheritsXforms;
+
+    //! The local transform at each sample time.
+    MatrixSampleMap samples;
+};
+
+//-*****************************************************************************
+//! What PolyMeshes and SubDs have in common.
+struct MeshSample
+{
+    MeshSample()
+      : time( 0.0 )
+      , uvScope( AbcG::kUnknownScope )
+    {}
+
+    chrono_t time;
+
+    Abc::P3fArraySamplePtr positions;
+    Abc::V3fArraySamplePtr velocities;
+    Abc::Int32ArraySamplePtr faceCounts;
+    Abc::Int32ArraySamplePtr faceIndices;
+    Abc::Box3d selfBounds;
+
+    //! Expanded, and flipped in v if asked to be.
+    std::vector<Abc::V2f> uvs;
+    AbcG::GeometryScope uvScope;
+};
+
+//-*****************************************************************************
+struct PolyMeshSample : public MeshSample
+{
+    PolyMeshSample() : normalScope( AbcG::kUnknownScope ) {}
+
+    std::vector<Abc::N3f> normals;
+    AbcG::GeometryScope normalScope;
+};
+
+//-*****************************************************************************
+struct SubDSample : public MeshSample
+{
+    SubDSample()
+      : interpolateBoundary( 0 )
+      , faceVaryingInterpolateBoundary( 0 )
+      , faceVaryingPropagateCorners( 0 )
+    {}
+
+    std::string scheme;
+    int32_t interpolateBoundary;
+    int32_t faceVaryingInterpolateBoundary;
+    int32_t faceVaryingPropagateCorners;
+
+    Abc::Int32ArraySamplePtr creaseIndices;
+    Abc::Int32ArraySamplePtr creaseLengths;
+    Abc::FloatArraySamplePtr creaseSharpnesses;
+    Abc::Int32ArraySamplePtr cornerIndices;
+    Abc::FloatArraySamplePtr cornerSharpnesses;
+    Abc::Int32ArraySamplePtr holes;
+};
+
+//-*****************************************************************************
+struct CurvesSample
+{
+    CurvesSample()
+      : time( 0.0 )
+      , type( AbcG::kCubic )
+      , wrap( AbcG::kNonPeriodic )
+      , basis( AbcG::kNoBasis )
+      , widthScope( AbcG::kUnknownScope )
+      , uvScope( AbcG::kUnknownScope )
+      , normalScope( AbcG::kUnknownScope )
+    {}
+
+    chrono_t time;
+
+    Abc::P3fArraySamplePtr positions;
+    Abc::V3fArraySamplePtr velocities;
+    Abc::Int32ArraySamplePtr numVertices;
+    Abc::UcharArraySamplePtr orders;
+    Abc::FloatArraySamplePtr knots;
+    Abc::Box3d selfBounds;
+
+    AbcG::CurveType type;
+    AbcG::CurvePeriodicity wrap;
+    AbcG::BasisType basis;
+
+    std::vector<float> widths;
+    AbcG::GeometryScope widthScope;
+
+    std::vector<Abc::V2f> uvs;
+    AbcG::GeometryScope uvScope;
+
+    std::vector<Abc::N3f> normals;
+    AbcG::GeometryScope normalScope;
+};
+
+//-*****************************************************************************
+struct PointsSample
+{
+    PointsSample()
+      : time( 0.0 )
+      , widthScope( AbcG::kUnknownScope )
+    {}
+
+    chrono_t time;
+
+    Abc::P3fArraySamplePtr positions;
+    Abc::V3fArraySamplePtr velocities;
+    Abc::UInt64ArraySamplePtr ids;
+    Abc::Box3d selfBounds;
+
+    std::vector<float> widths;
+    AbcG::GeometryScope widthScope;
+};
+
+//-*****************************************************************************
+//! The samples of an object, one per sample time, in time order.
+typedef std::vector<PolyMeshSample> PolyMeshBuffer;
+typedef std::vector<SubDSample> SubDBuffer;
+typedef std::vector<CurvesSample> CurvesBuffer;
+typedef std::vector<PointsSample> PointsBuffer;
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcProcedural
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,450 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcProcedural/Deferred.h>
+#include <Alembic/AbcProcedural/Expand.h>
+#include <Alembic/AbcProcedural/ExpandGeo.h>
+#include <Alembic/AbcProcedural/SampleUtil.h>
+
+#include <ImathBoxAlgo.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+typedef std::map<std::string, Abc::Box3d> BoundsCache;
+
+//-*****************************************************************************
+// an object to plan, with what it gets from the objects above it
+struct Candidate
+{
+    Candidate( Abc::IObject iObject, std::size_t iDepth, bool iParentVisible,
+               const MatrixSampleMap &iParentXforms )
+      : object( iObject )
+      , depth( iDepth )
+      , parentVisible( iParentVisible )
+      , parentXforms( iParentXforms )
+    {}
+
+    Abc::IObject object;
+    std::size_t depth;
+    bool parentVisible;
+    MatrixSampleMap parentXforms;
+};
+
+//-*****************************************************************************
+// what the walk of Expand reads
+bool IsGeometry( const AbcA::ObjectHeader &iHeader )
+{
+    return AbcG::IPolyMesh::matches( iHeader ) ||
+        AbcG::ISubD::matches( iHeader ) ||
+        AbcG::ICurves::matches( iHeader ) ||
+        AbcG::IPoints::matches( iHeader );
+}
+
+//-*****************************************************************************
+// what the walk of Expand goes beneath
+bool IsWalkedBeneath( const AbcA::ObjectHeader &iHeader )
+{
+    return IsGeometry( iHeader ) || AbcG::IXform::matches( iHeader ) ||
+        AbcG::INuPatch::matches( iHeader );
+}
+
+//-*****************************************************************************
+bool IsVisible( Abc::IObject iObject, const ExpandArgs &iArgs,
+                bool iParentVisible )
+{
+    switch ( AbcG::GetVisibility( iObject,
+        Abc::ISampleSelector( iArgs.frame / iArgs.fps ) ) )
+    {
+    case AbcG::kVisibilityVisible:
+        return true;
+    case AbcG::kVisibilityHidden:
+        return false;
+    default:
+        return iParentVisible;
+    }
+}
+
+//-*****************************************************************************
+// counts iObject and what the walk finds beneath it into ioCount, stopping
+// once past iLimit
+void CountObjects( Abc::IObject iObject, std::size_t iLimit,
+                   std::size_t &ioCount )
+{
+    ++ioCount;
+    if ( ioCount > iLimit || !IsWalkedBeneath( iObject.getHeader() ) )
+    {
+        return;
+    }
+
+    for ( std::size_t i = 0;
+          i < iObject.getNumChildren() && ioCount <= iLimit; ++i )
+    {
+        const AbcA::ObjectHeader &header = iObject.getChildHeader( i );
+        if ( !AbcG::IFaceSet::matches( header ) )
+        {
+            CountObjects( Abc::IObject( iObject, header.getName() ), iLimit,
+                          ioCount );
+        }
+    }
+}
+
+//-*****************************************************************************
+// the world transform that the children of iObject get, as an emitter given
+// the xforms of an expansion would have it
+void GetChildXforms( Abc::IObject iObject, const ExpandArgs &iArgs,
+                     const MatrixSampleMap &iParentXforms,
+                     MatrixSampleMap &oXforms )
+{
+    if ( iArgs.excludeXform || !AbcG::IXform::matches( iObject.getHeader() ) )
+    {
+        oXforms = iParentXforms;
+        return;
+    }
+
+    AbcG::IXform xform( iObject, Abc::kWrapExisting );
+    XformBuffer buffer;
+    ExpandXform( xform, iArgs, buffer );
+
+    if ( buffer.inheritsXforms )
+    {
+        ConcatenateXformSamples( iParentXforms, buffer.samples, oXforms );
+    }
+    else
+    {
+        oXforms = buffer.samples;
+    }
+}
+
+//-*****************************************************************************
+// extends ioBounds by stored bounds in the space of iXforms, at the sample
+// times of the shutter of both
+void ExtendByStoredBounds( Abc::IBox3dProperty iProperty,
+                           const ExpandArgs &iArgs,
+                           const MatrixSampleMap &iXforms,
+                           Abc::Box3d &ioBounds )
+{
+    if ( !iProperty.valid() || iProperty.getNumSamples() == 0 )
+    {
+        return;
+    }
+
+    SampleTimeSet sampleTimes;
+    for ( MatrixSampleMap::const_iterator it = iXforms.begin();
+          it != iXforms.end(); ++it )
+    {
+        sampleTimes.insert( it->first );
+    }
+
+    if ( iProperty.getNumSamples() > 1 )
+    {
+        GetRelevantSampleTimes( iArgs, iProperty.getTimeSampling(),
+                                iProperty.getNumSamples(), sampleTimes );
+    }
+
+    if ( sampleTimes.empty() )
+    {
+        sampleTimes.insert( iArgs.frame / iArgs.fps );
+    }
+
+    for ( SampleTimeSet::const_iterator it = sampleTimes.begin();
+          it != sampleTimes.end(); ++it )
+    {
+        Abc::Box3d bounds = iProperty.getValue( Abc::ISampleSelector( *it ) );
+        if ( !bounds.isEmpty() )
+        {
+            ioBounds.extendBy( Imath::transform( bounds,
+                InterpolateXformSamples( iXforms, *it ) ) );
+        }
+    }
+}
+
+//-*****************************************************************************
+// the world space bounds of the visible geometry of iObject, from its
+// .selfBnds
+Abc::Box3d GetSelfBounds( Abc::IObject iObject, const ExpandArgs &iArgs,
+                          bool iVisible, const MatrixSampleMap &iParentXforms )
+{
+    Abc::Box3d bounds;
+    if ( iVisible && IsGeometry( iObject.getHeader() ) )
+    {
+        AbcG::IGeomBaseObject geom( iObject, Abc::kWrapExisting );
+        ExtendByStoredBounds( geom.getSchema().getSelfBoundsProperty(),
+                              iArgs, iParentXforms, bounds );
+    }
+    return bounds;
+}
+
+//-*****************************************************************************
+// the world space bounds of iObject and what the walk finds beneath it,
+// read from its .childBnds where it has one instead of from beneath it
+Abc::Box3d GetSubtreeBounds( const Candidate &iCandidate,
+                             const ExpandArgs &iArgs, BoundsCache &ioCache )
+{
+    Abc::IObject object = iCandidate.object;
+
+    BoundsCache::const_iterator found =
+        ioCache.find( object.getFullName() );
+    if ( found != ioCache.end() )
+    {
+        return found->second;
+    }
+
+    const AbcA::ObjectHeader &header = object.getHeader();
+    bool visible = IsVisible( object, iArgs, iCandidate.parentVisible );
+
+    Abc::Box3d bounds = GetSelfBounds( object, iArgs, visible,
+                                       iCandidate.parentXforms );
+
+    if ( IsWalkedBeneath( header ) )
+    {
+        MatrixSampleMap xforms;
+        GetChildXforms( object, iArgs, iCandidate.parentXforms, xforms );
+
+        Abc::IBox3dProperty childBounds;
+        if ( AbcG::IXform::matches( header ) )
+        {
+            AbcG::IXform xform( object, Abc::kWrapExisting );
+            childBounds = xform.getSchema().getChildBoundsProperty();
+        }
+        else if ( IsGeometry( header ) )
+        {
+            AbcG::IGeomBaseObject geom( object, Abc::kWrapExisting );
+            childBounds = geom.getSchema().getChildBoundsProperty();
+        }
+
+        if ( childBounds.valid() && childBounds.getNumSamples() > 0 )
+        {
+            ExtendByStoredBounds( childBounds, iArgs, xforms, bounds );
+        }
+        else
+        {
+            for ( std::size_t i = 0; i < object.getNumChildren(); ++i )
+            {
+                const AbcA::ObjectHeader &childHeader =
+                    object.getChildHeader( i );
+                if ( !AbcG::IFaceSet::matches( childHeader ) )
+                {
+                    bounds.extendBy( GetSubtreeBounds( Candidate(
+                        Abc::IObject( object, childHeader.getName() ),
+                        iCandidate.depth + 1, visible, xforms ),
+                        iArgs, ioCache ) );
+                }
+            }
+        }
+    }
+
+    ioCache[object.getFullName()] = bounds;
+    return bounds;
+}
+
+//-*****************************************************************************
+// a stub for the whole of iCandidate, unless it is too big, in which case
+// its geometry gets a stub and its children are planned in turn
+void Split( const Candidate &iCandidate, const ExpandArgs &iArgs,
+            const DeferArgs &iDeferArgs, const Abc::Box3d &iTotalBounds,
+            BoundsCache &ioCache, DeferredStubList &oStubs )
+{
+    Abc::IObject object = iCandidate.object;
+    bool visible = IsVisible( object, iArgs, iCandidate.parentVisible );
+
+    std::size_t numObjects = 0;
+    CountObjects( object, iDeferArgs.maxObjectsPerStub, numObjects );
+
+    Abc::Box3d bounds = GetSubtreeBounds( iCandidate, iArgs, ioCache );
+
+    bool split = numObjects > iDeferArgs.maxObjectsPerStub;
+    if ( !split && numObjects >= iDeferArgs.minObjectsToSplit &&
+         !bounds.isEmpty() && !iTotalBounds.isEmpty() )
+    {
+        split = bounds.size().length() >
+            iDeferArgs.maxBoundsFraction * iTotalBounds.size().length();
+    }
+
+    DeferredStub stub;
+    stub.info.object = object;
+    stub.info.depth = iCandidate.depth;
+    stub.info.visible = visible;
+    stub.parentXforms = iCandidate.parentXforms;
+
+    // a single object can't be split any further
+    if ( !split || numObjects < 2 )
+    {
+        stub.bounds = bounds;
+        stub.numObjects = numObjects;
+        oStubs.push_back( stub );
+        return;
+    }
+
+    if ( visible && IsGeometry( object.getHeader() ) )
+    {
+        stub.includeChildren = false;
+        stub.bounds = GetSelfBounds( object, iArgs, visible,
+                                     iCandidate.parentXforms );
+        stub.numObjects = 1;
+        oStubs.push_back( stub );
+    }
+
+    MatrixSampleMap xforms;
+    GetChildXforms( object, iArgs, iCandidate.parentXforms, xforms );
+
+    for ( std::size_t i = 0; i < object.getNumChildren(); ++i )
+    {
+        const AbcA::ObjectHeader &childHeader = object.getChildHeader( i );
+        if ( !AbcG::IFaceSet::matches( childHeader ) )
+        {
+            Split( Candidate( Abc::IObject( object, childHeader.getName() ),
+                              iCandidate.depth + 1, visible, xforms ),
+                   iArgs, iDeferArgs, iTotalBounds, ioCache, oStubs );
+        }
+    }
+}
+
+} // End namespace
+
+//-*****************************************************************************
+void PlanDeferred( Abc::IObject iRoot, const ExpandArgs &iArgs,
+                   const DeferArgs &iDeferArgs, DeferredStubList &oStubs )
+{
+    ABCA_ASSERT( iRoot.valid(), "PlanDeferred needs a valid object" );
+
+    std::vector<std::string> path;
+    TokenizeObjectPath( iArgs.objectpath, path );
+
+    // the objects everything is expanded beneath, at the end of the path
+    std::vector<Candidate> candidates;
+
+    if ( path.empty() )
+    {
+        for ( std::size_t i = 0; i < iRoot.getNumChildren(); ++i )
+        {
+            const AbcA::ObjectHeader &header = iRoot.getChildHeader( i );
+            if ( !AbcG::IFaceSet::matches( header ) )
+            {
+                candidates.push_back( Candidate(
+                    Abc::IObject( iRoot, header.getName() ), 0, true,
+                    MatrixSampleMap() ) );
+            }
+        }
+    }
+    else
+    {
+        // geometry along the path is expanded too, on its own
+        Abc::IObject parent = iRoot;
+        bool visible = true;
+        MatrixSampleMap xforms;
+
+        for ( std::size_t i = 0; i < path.size(); ++i )
+        {
+            const AbcA::ObjectHeader *header =
+                parent.getChildHeader( path[i] );
+            if ( header == NULL || AbcG::IFaceSet::matches( *header ) )
+            {
+                break;
+            }
+
+            Abc::IObject object( parent, path[i] );
+
+            if ( i + 1 == path.size() )
+            {
+                candidates.push_back( Candidate( object, i, visible,
+                                                 xforms ) );
+                break;
+            }
+
+            bool objectVisible = IsVisible( object, iArgs, visible );
+            if ( objectVisible && IsGeometry( *header ) )
+            {
+                DeferredStub stub;
+                stub.info.object = object;
+                stub.info.depth = i;
+                stub.info.visible = objectVisible;
+                stub.includeChildren = false;
+                stub.parentXforms = xforms;
+                stub.bounds = GetSelfBounds( object, iArgs, objectVisible,
+                                             xforms );
+                stub.numObjects = 1;
+
+                // the path may go on to one of a SubD's face sets
+                if ( AbcG::ISubD::matches( *header ) )
+                {
+                    AbcG::ISubD subd( object, Abc::kWrapExisting );
+                    if ( subd.getSchema().hasFaceSet( path[i + 1] ) )
+                    {
+                        stub.info.faceSet = path[i + 1];
+                        oStubs.push_back( stub );
+                        break;
+                    }
+                }
+
+                oStubs.push_back( stub );
+            }
+
+            if ( !IsWalkedBeneath( *header ) )
+            {
+                break;
+            }
+
+            MatrixSampleMap childXforms;
+            GetChildXforms( object, iArgs, xforms, childXforms );
+            xforms.swap( childXforms );
+            visible = objectVisible;
+            parent = object;
+        }
+    }
+
+    // the bounds fraction is of everything being planned
+    BoundsCache cache;
+    Abc::Box3d totalBounds;
+    for ( std::size_t i = 0; i < candidates.size(); ++i )
+    {
+        totalBounds.extendBy(
+            GetSubtreeBounds( candidates[i], iArgs, cache ) );
+    }
+
+    for ( std::size_t i = 0; i < candidates.size(); ++i )
+    {
+        Split( candidates[i], iArgs, iDeferArgs, totalBounds, cache,
+               oStubs );
+    }
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcProcedural
+} // End namespace Alembic
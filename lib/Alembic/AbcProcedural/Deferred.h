@@ -0,0 +1,122 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcProcedural_Deferred_h_
+#define _Alembic_AbcProcedural_Deferred_h_
+
+#include <Alembic/AbcProcedural/Buffers.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! How finely PlanDeferred splits the hierarchy into stubs.
+struct DeferArgs
+{
+    DeferArgs()
+      : maxObjectsPerStub( 256 )
+      , maxBoundsFraction( 0.25 )
+      , minObjectsToSplit( 16 )
+    {}
+
+    //! Subtrees of more objects than this are split into their children.
+    std::size_t maxObjectsPerStub;
+
+    //! Subtrees whose bounds are wider than this fraction of the bounds
+    //! of everything planned are split too, so that the renderer can cull
+    //! their parts separately...
+    double maxBoundsFraction;
+
+    //! ...unless they have fewer objects than this.
+    std::size_t minObjectsToSplit;
+};
+
+//-*****************************************************************************
+//! Stands in for an object, or an object and everything beneath it, until
+//! the renderer needs what is inside the bounds.  Nothing beneath the
+//! object has been read, other than stored bounds and transforms.
+struct DeferredStub
+{
+    DeferredStub() : includeChildren( true ), numObjects( 0 )
+    {
+        bounds.makeEmpty();
+    }
+
+    //! The object, with the depth, visibility and face set it would have
+    //! in a full expansion.
+    ObjectInfo info;
+
+    //! Whether the stub is for the object and everything beneath it, or
+    //! just for the object, its children having stubs of their own.
+    bool includeChildren;
+
+    //! The world transform of the object's parent over the shutter, which
+    //! the renderer puts the expanded stub beneath.  Empty for identity.
+    MatrixSampleMap parentXforms;
+
+    //! World space bounds of what the stub expands to, over the shutter.
+    //! Empty if no bounds are stored for any of it, in which case the
+    //! renderer can't cull it and should expand it right away.
+    Abc::Box3d bounds;
+
+    //! How many objects expanding the stub walks.
+    std::size_t numObjects;
+};
+
+typedef std::vector<DeferredStub> DeferredStubList;
+
+//-*****************************************************************************
+//! Plans the expansion of the objects beneath iRoot, as chosen by iArgs,
+//! as stubs which can each be expanded with Expand when the renderer asks.
+//! Expanding every stub emits the same geometry as expanding iRoot.
+//!
+//! Bounds come from the .selfBnds and .childBnds properties, and the
+//! transforms above them, at the sample times of the shutter.  Where a
+//! .childBnds is stored, nothing beneath it is read to plan its stub.
+//! Subtrees are split by iDeferArgs, and geometry along the object path, or
+//! above a split, gets a stub of its own.
+void PlanDeferred( Abc::IObject iRoot, const ExpandArgs &iArgs,
+                   const DeferArgs &iDeferArgs, DeferredStubList &oStubs );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcProcedural
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,89 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcProcedural_Emitter_h_
+#define _Alembic_AbcProcedural_Emitter_h_
+
+#include <Alembic/AbcProcedural/Buffers.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! What a renderer implements to be handed the expanded objects.
+//!
+//! Expand calls these from the thread which called it, one at a time, in
+//! the order of a depth first walk.  Each object gets a beginObject, then
+//! the call for its type if it is one that is expanded, then the calls for
+//! its children, then an endObject.  The buffers are only valid during the
+//! call.
+//!
+//! The prman and arnold procedurals don't go through an Emitter yet.  Only
+//! their sample times and transforms come from this library, and they
+//! still read and write the geometry themselves, in their WriteGeo.
+class Emitter
+{
+public:
+    virtual ~Emitter() {}
+
+    virtual void beginObject( const ObjectInfo &iInfo ) {}
+    virtual void endObject( const ObjectInfo &iInfo ) {}
+
+    virtual void emitXform( const ObjectInfo &iInfo,
+                            const XformBuffer &iBuffer ) {}
+
+    virtual void emitPolyMesh( const ObjectInfo &iInfo,
+                               const PolyMeshBuffer &iBuffer ) {}
+
+    virtual void emitSubD( const ObjectInfo &iInfo,
+                           const SubDBuffer &iBuffer ) {}
+
+    virtual void emitCurves( const ObjectInfo &iInfo,
+                             const CurvesBuffer &iBuffer ) {}
+
+    virtual void emitPoints( const ObjectInfo &iInfo,
+                             const PointsBuffer &iBuffer ) {}
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcProcedural
+} // End namespace Alembic
+
+#endif
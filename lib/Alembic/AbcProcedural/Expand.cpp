@@ -0,0 +1,615 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcProcedural/Expand.h>
+#include <Alembic/AbcProcedural/ExpandGeo.h>
+#include <Alembic/Util/Timer.h>
+#include <Alembic/Util/WorkerPool.h>
+
+#include <algorithm>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+typedef std::vector<std::string> PathList;
+
+//-*****************************************************************************
+enum NodeType
+{
+    kGroupNode,
+    kXformNode,
+    kPolyMeshNode,
+    kSubDNode,
+    kCurvesNode,
+    kPointsNode
+};
+
+//-*****************************************************************************
+// an object found by the walk, and once read, its samples
+struct Node
+{
+    Node() : type( kGroupNode ) {}
+
+    // hidden geometry isn't read, but what is beneath it may be shown
+    bool isRead() const
+    {
+        return type == kXformNode || ( type != kGroupNode && info.visible );
+    }
+
+    ObjectInfo info;
+    NodeType type;
+
+    XformBuffer xform;
+    PolyMeshBuffer polyMesh;
+    SubDBuffer subD;
+    CurvesBuffer curves;
+    PointsBuffer points;
+};
+
+//-*****************************************************************************
+// finds the objects to expand in the order the emitter gets them, the way
+// the procedurals have always walked: only down the object path while
+// there is one left, and not beneath objects of unknown types
+void Walk( Abc::IObject iParent, const AbcA::ObjectHeader &iHeader,
+           const ExpandArgs &iArgs, PathList::const_iterator I,
+           PathList::const_iterator E, std::size_t iDepth, bool iVisible,
+           bool iWalkChildren, std::vector<Node> &oNodes )
+{
+    // face sets go with their mesh
+    if ( AbcG::IFaceSet::matches( iHeader ) )
+    {
+        return;
+    }
+
+    Abc::IObject object( iParent, iHeader.getName() );
+
+    switch ( AbcG::GetVisibility( object,
+        Abc::ISampleSelector( iArgs.frame / iArgs.fps ) ) )
+    {
+    case AbcG::kVisibilityVisible:
+        iVisible = true;
+        break;
+    case AbcG::kVisibilityHidden:
+        iVisible = false;
+        break;
+    default:
+        break;
+    }
+
+    Node node;
+    node.info.object = object;
+    node.info.depth = iDepth;
+    node.info.visible = iVisible;
+
+    bool walkChildren = true;
+    if ( AbcG::IXform::matches( iHeader ) )
+    {
+        if ( !iArgs.excludeXform )
+        {
+            node.type = kXformNode;
+        }
+    }
+    else if ( AbcG::ISubD::matches( iHeader ) )
+    {
+        node.type = kSubDNode;
+
+        // if the object path goes on to one of its face sets, stop here
+        if ( I != E )
+        {
+            AbcG::ISubD subd( object, Abc::kWrapExisting );
+            if ( subd.getSchema().hasFaceSet( *I ) )
+            {
+                node.info.faceSet = *I;
+                walkChildren = false;
+            }
+        }
+    }
+    else if ( AbcG::IPolyMesh::matches( iHeader ) )
+    {
+        node.type = kPolyMeshNode;
+    }
+    else if ( AbcG::ICurves::matches( iHeader ) )
+    {
+        node.type = kCurvesNode;
+    }
+    else if ( AbcG::IPoints::matches( iHeader ) )
+    {
+        node.type = kPointsNode;
+    }
+    else if ( !AbcG::INuPatch::matches( iHeader ) )
+    {
+        walkChildren = false;
+    }
+
+    oNodes.push_back( node );
+
+    if ( !walkChildren || !iWalkChildren )
+    {
+        return;
+    }
+
+    if ( I == E )
+    {
+        for ( std::size_t i = 0; i < object.getNumChildren(); ++i )
+        {
+            Walk( object, object.getChildHeader( i ), iArgs, I, E,
+                  iDepth + 1, iVisible, true, oNodes );
+        }
+    }
+    else
+    {
+        const AbcA::ObjectHeader *childHeader = object.getChildHeader( *I );
+        if ( childHeader != NULL )
+        {
+            Walk( object, *childHeader, iArgs, I + 1, E, iDepth + 1,
+                  iVisible, true, oNodes );
+        }
+    }
+}
+
+//-*****************************************************************************
+// reads the samples of a node, returning how many
+std::size_t ReadNode( Node &ioNode, const ExpandArgs &iArgs )
+{
+    if ( !ioNode.isRead() )
+    {
+        return 0;
+    }
+
+    Abc::IObject &object = ioNode.info.object;
+
+    switch ( ioNode.type )
+    {
+    case kXformNode:
+    {
+        AbcG::IXform xform( object, Abc::kWrapExisting );
+        ExpandXform( xform, iArgs, ioNode.xform );
+        return ioNode.xform.samples.size();
+    }
+    case kPolyMeshNode:
+    {
+        AbcG::IPolyMesh polyMesh( object, Abc::kWrapExisting );
+        ExpandPolyMesh( polyMesh, iArgs, ioNode.polyMesh );
+        return ioNode.polyMesh.size();
+    }
+    case kSubDNode:
+    {
+        AbcG::ISubD subD( object, Abc::kWrapExisting );
+        ExpandSubD( subD, iArgs, ioNode.subD );
+        return ioNode.subD.size();
+    }
+    case kCurvesNode:
+    {
+        AbcG::ICurves curves( object, Abc::kWrapExisting );
+        ExpandCurves( curves, iArgs, ioNode.curves );
+        return ioNode.curves.size();
+    }
+    case kPointsNode:
+    {
+        AbcG::IPoints points( object, Abc::kWrapExisting );
+        ExpandPoints( points, iArgs, ioNode.points );
+        return ioNode.points.size();
+    }
+    default:
+        return 0;
+    }
+}
+
+//-*****************************************************************************
+// lets go of the samples of a node once emitted
+void ReleaseNode( Node &ioNode )
+{
+    XformBuffer().samples.swap( ioNode.xform.samples );
+    PolyMeshBuffer().swap( ioNode.polyMesh );
+    SubDBuffer().swap( ioNode.subD );
+    CurvesBuffer().swap( ioNode.curves );
+    PointsBuffer().swap( ioNode.points );
+}
+
+//-*****************************************************************************
+// The threads objects are read on, started once and kept, so that neither
+// each expansion nor each deferred stub starts and stops threads of its own.
+// It grows to the most threads any expansion has been given.
+Alembic::Util::WorkerPool g_readPool;
+
+//-*****************************************************************************
+// what the reading threads share with the emitting one
+struct Work
+{
+    enum State
+    {
+        kQueued,
+        kReading,
+        kRead
+    };
+
+    Work( std::vector<Node> &iNodes, const ExpandArgs &iArgs )
+      : nodes( iNodes )
+      , args( iArgs )
+      , states( iNodes.size(), kQueued )
+      , stop( false )
+      , numSamples( 0 )
+      , readTime( 0.0 )
+    {}
+
+    std::vector<Node> &nodes;
+    const ExpandArgs &args;
+
+    // guards everything below
+    Alembic::Util::monitor monitor;
+
+    std::vector<State> states;
+
+    // set when something goes wrong, the nodes not yet begun are left
+    bool stop;
+
+    // the first thing to go wrong
+    std::string error;
+
+    std::size_t numSamples;
+    double readTime;
+};
+
+//-*****************************************************************************
+// a node for one of the pool's threads to read
+struct ReadTask
+{
+    Work *work;
+    std::size_t index;
+};
+
+//-*****************************************************************************
+// reads a queued node, work.monitor must be held, and is held again on
+// return
+void ReadQueued( Work &ioWork, std::size_t iIndex )
+{
+    ioWork.states[iIndex] = Work::kReading;
+    ioWork.monitor.unlock();
+
+    Alembic::Util::Timer timer;
+    std::size_t numSamples = 0;
+    std::string error;
+
+    try
+    {
+        numSamples = ReadNode( ioWork.nodes[iIndex], ioWork.args );
+    }
+    catch ( std::exception &e )
+    {
+        error = e.what();
+    }
+    catch ( ... )
+    {
+        error = "unknown exception";
+    }
+
+    double readTime = timer.elapsed();
+
+    ioWork.monitor.lock();
+    ioWork.states[iIndex] = Work::kRead;
+    ioWork.numSamples += numSamples;
+    ioWork.readTime += readTime;
+
+    if ( !error.empty() && !ioWork.stop )
+    {
+        ioWork.error = error;
+        ioWork.stop = true;
+    }
+
+    ioWork.monitor.notify_all();
+}
+
+//-*****************************************************************************
+void ReadNodeTask( void * iTask )
+{
+    ReadTask &task = *( static_cast<ReadTask *>( iTask ) );
+    Work &work = *task.work;
+
+    // the emitting thread may have caught up and read it already
+    work.monitor.lock();
+    if ( !work.stop && work.states[task.index] == Work::kQueued )
+    {
+        ReadQueued( work, task.index );
+    }
+    work.monitor.unlock();
+}
+
+//-*****************************************************************************
+// returns once a node has been read, reading it here if no thread has begun
+// it, rather than waiting
+void WaitForNode( Work &ioWork, std::size_t iIndex )
+{
+    ioWork.monitor.lock();
+    if ( !ioWork.stop && ioWork.states[iIndex] == Work::kQueued )
+    {
+        ReadQueued( ioWork, iIndex );
+    }
+
+    while ( ioWork.states[iIndex] == Work::kReading )
+    {
+        ioWork.monitor.wait();
+    }
+
+    std::string error = ioWork.error;
+    ioWork.monitor.unlock();
+
+    ABCA_ASSERT( error.empty(), "Error expanding objects: " << error );
+}
+
+//-*****************************************************************************
+// stops the reads not yet begun, for when the emitter throws
+void StopWork( Work &ioWork )
+{
+    ioWork.monitor.lock();
+    ioWork.stop = true;
+    ioWork.monitor.unlock();
+}
+
+//-*****************************************************************************
+void EmitNode( const Node &iNode, Emitter &iEmitter )
+{
+    if ( !iNode.isRead() )
+    {
+        return;
+    }
+
+    switch ( iNode.type )
+    {
+    case kXformNode:
+        iEmitter.emitXform( iNode.info, iNode.xform );
+        break;
+    case kPolyMeshNode:
+        iEmitter.emitPolyMesh( iNode.info, iNode.polyMesh );
+        break;
+    case kSubDNode:
+        iEmitter.emitSubD( iNode.info, iNode.subD );
+        break;
+    case kCurvesNode:
+        iEmitter.emitCurves( iNode.info, iNode.curves );
+        break;
+    case kPointsNode:
+        iEmitter.emitPoints( iNode.info, iNode.points );
+        break;
+    default:
+        break;
+    }
+}
+
+//-*****************************************************************************
+// reads the walked nodes in batches and emits them in order
+void ExpandNodes( std::vector<Node> &ioNodes, const ExpandArgs &iArgs,
+                  Emitter &iEmitter, ExpandStats &ioStats )
+{
+    ioStats.numObjects = ioNodes.size();
+    for ( std::size_t i = 0; i < ioNodes.size(); ++i )
+    {
+        if ( !ioNodes[i].isRead() )
+        {
+            continue;
+        }
+
+        switch ( ioNodes[i].type )
+        {
+        case kXformNode: ++ioStats.numXforms; break;
+        case kPolyMeshNode: ++ioStats.numPolyMeshes; break;
+        case kSubDNode: ++ioStats.numSubDs; break;
+        case kCurvesNode: ++ioStats.numCurves; break;
+        case kPointsNode: ++ioStats.numPoints; break;
+        default: break;
+        }
+    }
+
+    Work work( ioNodes, iArgs );
+    std::size_t readAhead = std::max( iArgs.batchSize, std::size_t( 1 ) );
+    std::size_t numThreads = std::max( iArgs.numThreads, std::size_t( 1 ) );
+
+    // this thread reads too whenever the emitter catches up, so with one
+    // thread nothing is queued and each node is read just before it is
+    // emitted
+    std::vector<ReadTask> tasks( numThreads > 1 ? ioNodes.size() : 0 );
+    if ( numThreads > 1 )
+    {
+        g_readPool.reserve( numThreads - 1 );
+    }
+    Alembic::Util::TaskGroup group( g_readPool );
+    std::size_t numQueued = 0;
+
+    // the objects which have begun and not yet ended
+    std::vector<std::size_t> open;
+
+    try
+    {
+        for ( std::size_t i = 0; i < ioNodes.size(); ++i )
+        {
+            // keep the threads readAhead objects ahead of the emitter
+            for ( ; numQueued < tasks.size() && numQueued < i + readAhead;
+                  ++numQueued )
+            {
+                tasks[numQueued].work = &work;
+                tasks[numQueued].index = numQueued;
+                group.run( ReadNodeTask, &tasks[numQueued] );
+            }
+
+            WaitForNode( work, i );
+
+            Alembic::Util::Timer timer;
+            while ( !open.empty() &&
+                    ioNodes[open.back()].info.depth >= ioNodes[i].info.depth )
+            {
+                iEmitter.endObject( ioNodes[open.back()].info );
+                open.pop_back();
+            }
+
+            iEmitter.beginObject( ioNodes[i].info );
+            open.push_back( i );
+
+            EmitNode( ioNodes[i], iEmitter );
+            ReleaseNode( ioNodes[i] );
+            ioStats.emitTime += timer.elapsed();
+        }
+    }
+    catch ( ... )
+    {
+        StopWork( work );
+        group.wait();
+        throw;
+    }
+
+    group.wait();
+
+    Alembic::Util::Timer timer;
+    while ( !open.empty() )
+    {
+        iEmitter.endObject( ioNodes[open.back()].info );
+        open.pop_back();
+    }
+    ioStats.emitTime += timer.elapsed();
+
+    ioStats.numSamples = work.numSamples;
+    ioStats.readTime = work.readTime;
+}
+
+} // End namespace
+
+//-*****************************************************************************
+void TokenizeObjectPath( const std::string &iPath,
+                         std::vector<std::string> &oResult )
+{
+    std::size_t lastPos = 0;
+    while ( lastPos < iPath.size() )
+    {
+        std::size_t curPos = iPath.find( '/', lastPos );
+        if ( curPos == std::string::npos )
+        {
+            curPos = iPath.size();
+        }
+
+        if ( curPos > lastPos )
+        {
+            oResult.push_back( iPath.substr( lastPos, curPos - lastPos ) );
+        }
+        lastPos = curPos + 1;
+    }
+}
+
+//-*****************************************************************************
+ExpandStats Expand( Abc::IObject iRoot, const ExpandArgs &iArgs,
+                    Emitter &iEmitter )
+{
+    ABCA_ASSERT( iRoot.valid(), "Expand needs a valid object" );
+
+    ExpandStats stats;
+    Alembic::Util::Timer total;
+
+    std::vector<Node> nodes;
+    {
+        Alembic::Util::Timer timer;
+
+        PathList path;
+        TokenizeObjectPath( iArgs.objectpath, path );
+
+        if ( path.empty() )
+        {
+            for ( std::size_t i = 0; i < iRoot.getNumChildren(); ++i )
+            {
+                Walk( iRoot, iRoot.getChildHeader( i ), iArgs, path.end(),
+                      path.end(), 0, true, true, nodes );
+            }
+        }
+        else
+        {
+            PathList::const_iterator I = path.begin();
+            const AbcA::ObjectHeader *childHeader =
+                iRoot.getChildHeader( *I );
+            if ( childHeader != NULL )
+            {
+                Walk( iRoot, *childHeader, iArgs, I + 1, path.end(), 0,
+                      true, true, nodes );
+            }
+        }
+
+        stats.walkTime = timer.elapsed();
+    }
+
+    ExpandNodes( nodes, iArgs, iEmitter, stats );
+
+    stats.totalTime = total.elapsed();
+    return stats;
+}
+
+//-*****************************************************************************
+ExpandStats Expand( const DeferredStub &iStub, const ExpandArgs &iArgs,
+                    Emitter &iEmitter )
+{
+    Abc::IObject object = iStub.info.object;
+    ABCA_ASSERT( object.valid(), "Expand needs a stub of a valid object" );
+
+    ExpandStats stats;
+    Alembic::Util::Timer total;
+
+    std::vector<Node> nodes;
+    {
+        Alembic::Util::Timer timer;
+
+        // the face set, if there is one, is found by the walk as it would
+        // be at the end of the object path
+        PathList path;
+        if ( !iStub.info.faceSet.empty() )
+        {
+            path.push_back( iStub.info.faceSet );
+        }
+
+        // a stub's visibility is the one its parent passed down, unless
+        // the object says otherwise, which the walk will find again
+        Walk( object.getParent(), object.getHeader(), iArgs, path.begin(),
+              path.end(), iStub.info.depth, iStub.info.visible,
+              iStub.includeChildren, nodes );
+
+        stats.walkTime = timer.elapsed();
+    }
+
+    ExpandNodes( nodes, iArgs, iEmitter, stats );
+
+    stats.totalTime = total.elapsed();
+    return stats;
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcProcedural
+} // End namespace Alembic
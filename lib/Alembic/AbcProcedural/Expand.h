@@ -0,0 +1,125 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcProcedural_Expand_h_
+#define _Alembic_AbcProcedural_Expand_h_
+
+#include <Alembic/AbcProcedural/Deferred.h>
+#include <Alembic/AbcProcedural/Emitter.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! What an expansion did, and where its time went.
+struct ExpandStats
+{
+    ExpandStats()
+      : numObjects( 0 )
+      , numXforms( 0 )
+      , numPolyMeshes( 0 )
+      , numSubDs( 0 )
+      , numCurves( 0 )
+      , numPoints( 0 )
+      , numSamples( 0 )
+      , walkTime( 0.0 )
+      , readTime( 0.0 )
+      , emitTime( 0.0 )
+      , totalTime( 0.0 )
+    {}
+
+    std::size_t numObjects;
+    std::size_t numXforms;
+    std::size_t numPolyMeshes;
+    std::size_t numSubDs;
+    std::size_t numCurves;
+    std::size_t numPoints;
+
+    //! Samples read, across every object and sample time.
+    std::size_t numSamples;
+
+    //! Seconds spent finding the objects to expand.
+    double walkTime;
+
+    //! Seconds spent reading samples, added up across the threads.
+    double readTime;
+
+    //! Seconds spent in the emitter.
+    double emitTime;
+
+    //! Seconds from start to finish.
+    double totalTime;
+};
+
+//-*****************************************************************************
+//! Splits an object path into the names of the objects along it.
+void TokenizeObjectPath( const std::string &iPath,
+                         std::vector<std::string> &oResult );
+
+//-*****************************************************************************
+//! Expands the objects beneath iRoot, as chosen by iArgs, into
+//! iEmitter.
+//!
+//! The hierarchy is walked first, which reads no samples.  Then the
+//! objects have their samples read on iArgs.numThreads threads, up to
+//! iArgs.batchSize objects ahead of iEmitter, which is handed them in walk
+//! order from this thread while the ones after are read.  This thread is
+//! one of the readers, whenever the emitter catches up with them.  The
+//! calls the emitter gets are the same however many threads there are.
+//!
+//! An exception thrown while reading, or by the emitter, stops the
+//! expansion and is thrown from here.
+ExpandStats Expand( Abc::IObject iRoot, const ExpandArgs &iArgs,
+                    Emitter &iEmitter );
+
+//-*****************************************************************************
+//! Expands what a stub from PlanDeferred stands for into iEmitter, the
+//! same way.  The objects keep the depth they have beneath the planned
+//! root, and iEmitter is expected to have the stub's parentXforms applied
+//! already.  iArgs should be the ones the stub was planned with, though
+//! its objectpath is ignored.
+ExpandStats Expand( const DeferredStub &iStub, const ExpandArgs &iArgs,
+                    Emitter &iEmitter );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcProcedural
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,274 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcProcedural/ExpandGeo.h>
+#include <Alembic/AbcProcedural/SampleUtil.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+//-*****************************************************************************
+template <class GEOMPARAM, class T>
+void ExpandGeomParam( GEOMPARAM &iParam, const Abc::ISampleSelector &iSS,
+                      std::vector<T> &oValues, AbcG::GeometryScope &oScope )
+{
+    if ( !iParam.valid() )
+    {
+        return;
+    }
+
+    typename GEOMPARAM::sample_type sample = iParam.getExpandedValue( iSS );
+    oScope = sample.getScope();
+
+    typename GEOMPARAM::sample_type::samp_ptr_type vals = sample.getVals();
+    if ( vals )
+    {
+        const T *data = reinterpret_cast<const T *>( vals->get() );
+        oValues.assign( data, data + vals->size() );
+    }
+}
+
+//-*****************************************************************************
+void ExpandUVs( AbcG::IV2fGeomParam &iParam, const ExpandArgs &iArgs,
+                const Abc::ISampleSelector &iSS,
+                std::vector<Abc::V2f> &oUVs, AbcG::GeometryScope &oScope )
+{
+    ExpandGeomParam( iParam, iSS, oUVs, oScope );
+
+    if ( iArgs.flipv )
+    {
+        for ( std::size_t i = 0; i < oUVs.size(); ++i )
+        {
+            oUVs[i].y = 1.0f - oUVs[i].y;
+        }
+    }
+}
+
+} // End namespace
+
+//-*****************************************************************************
+void ExpandXform( AbcG::IXform &iXform, const ExpandArgs &iArgs,
+                  XformBuffer &oBuffer,
+                  const MatrixSampleMap *iInheritedSamples )
+{
+    AbcG::IXformSchema &xs = iXform.getSchema();
+
+    SampleTimeSet sampleTimes;
+    GetRelevantSampleTimes( iArgs, xs.getTimeSampling(), xs.getNumSamples(),
+                            sampleTimes, iInheritedSamples );
+
+    oBuffer.inheritsXforms = xs.getInheritsXforms();
+    oBuffer.samples.clear();
+
+    for ( SampleTimeSet::const_iterator it = sampleTimes.begin();
+          it != sampleTimes.end(); ++it )
+    {
+        AbcG::XformSample sample;
+        xs.get( sample, Abc::ISampleSelector( *it ) );
+        oBuffer.samples[*it] = sample.getMatrix();
+    }
+}
+
+//-*****************************************************************************
+void ExpandPolyMesh( AbcG::IPolyMesh &iPolyMesh, const ExpandArgs &iArgs,
+                     PolyMeshBuffer &oBuffer )
+{
+    AbcG::IPolyMeshSchema &ps = iPolyMesh.getSchema();
+
+    SampleTimeSet sampleTimes;
+    GetRelevantSampleTimes( iArgs, ps.getTimeSampling(), ps.getNumSamples(),
+                            sampleTimes );
+
+    AbcG::IV2fGeomParam uvParam = ps.getUVsParam();
+    AbcG::IN3fGeomParam nParam = ps.getNormalsParam();
+
+    oBuffer.clear();
+    oBuffer.resize( sampleTimes.size() );
+
+    std::size_t index = 0;
+    for ( SampleTimeSet::const_iterator it = sampleTimes.begin();
+          it != sampleTimes.end(); ++it, ++index )
+    {
+        Abc::ISampleSelector sampleSelector( *it );
+        AbcG::IPolyMeshSchema::Sample sample = ps.getValue( sampleSelector );
+
+        PolyMeshSample &out = oBuffer[index];
+        out.time = *it;
+        out.positions = sample.getPositions();
+        out.velocities = sample.getVelocities();
+        out.faceCounts = sample.getFaceCounts();
+        out.faceIndices = sample.getFaceIndices();
+        out.selfBounds = sample.getSelfBounds();
+
+        ExpandUVs( uvParam, iArgs, sampleSelector, out.uvs, out.uvScope );
+        ExpandGeomParam( nParam, sampleSelector, out.normals,
+                         out.normalScope );
+    }
+}
+
+//-*****************************************************************************
+void ExpandSubD( AbcG::ISubD &iSubD, const ExpandArgs &iArgs,
+                 SubDBuffer &oBuffer )
+{
+    AbcG::ISubDSchema &ss = iSubD.getSchema();
+
+    SampleTimeSet sampleTimes;
+    GetRelevantSampleTimes( iArgs, ss.getTimeSampling(), ss.getNumSamples(),
+                            sampleTimes );
+
+    AbcG::IV2fGeomParam uvParam = ss.getUVsParam();
+
+    oBuffer.clear();
+    oBuffer.resize( sampleTimes.size() );
+
+    std::size_t index = 0;
+    for ( SampleTimeSet::const_iterator it = sampleTimes.begin();
+          it != sampleTimes.end(); ++it, ++index )
+    {
+        Abc::ISampleSelector sampleSelector( *it );
+        AbcG::ISubDSchema::Sample sample = ss.getValue( sampleSelector );
+
+        SubDSample &out = oBuffer[index];
+        out.time = *it;
+        out.positions = sample.getPositions();
+        out.velocities = sample.getVelocities();
+        out.faceCounts = sample.getFaceCounts();
+        out.faceIndices = sample.getFaceIndices();
+        out.selfBounds = sample.getSelfBounds();
+
+        out.scheme = sample.getSubdivisionScheme();
+        out.interpolateBoundary = sample.getInterpolateBoundary();
+        out.faceVaryingInterpolateBoundary =
+            sample.getFaceVaryingInterpolateBoundary();
+        out.faceVaryingPropagateCorners =
+            sample.getFaceVaryingPropagateCorners();
+
+        out.creaseIndices = sample.getCreaseIndices();
+        out.creaseLengths = sample.getCreaseLengths();
+        out.creaseSharpnesses = sample.getCreaseSharpnesses();
+        out.cornerIndices = sample.getCornerIndices();
+        out.cornerSharpnesses = sample.getCornerSharpnesses();
+        out.holes = sample.getHoles();
+
+        ExpandUVs( uvParam, iArgs, sampleSelector, out.uvs, out.uvScope );
+    }
+}
+
+//-*****************************************************************************
+void ExpandCurves( AbcG::ICurves &iCurves, const ExpandArgs &iArgs,
+                   CurvesBuffer &oBuffer )
+{
+    AbcG::ICurvesSchema &cs = iCurves.getSchema();
+
+    SampleTimeSet sampleTimes;
+    GetRelevantSampleTimes( iArgs, cs.getTimeSampling(), cs.getNumSamples(),
+                            sampleTimes );
+
+    AbcG::IFloatGeomParam widthParam = cs.getWidthsParam();
+    AbcG::IV2fGeomParam uvParam = cs.getUVsParam();
+    AbcG::IN3fGeomParam nParam = cs.getNormalsParam();
+
+    oBuffer.clear();
+    oBuffer.resize( sampleTimes.size() );
+
+    std::size_t index = 0;
+    for ( SampleTimeSet::const_iterator it = sampleTimes.begin();
+          it != sampleTimes.end(); ++it, ++index )
+    {
+        Abc::ISampleSelector sampleSelector( *it );
+        AbcG::ICurvesSchema::Sample sample = cs.getValue( sampleSelector );
+
+        CurvesSample &out = oBuffer[index];
+        out.time = *it;
+        out.positions = sample.getPositions();
+        out.velocities = sample.getVelocities();
+        out.numVertices = sample.getCurvesNumVertices();
+        out.orders = sample.getOrders();
+        out.knots = sample.getKnots();
+        out.selfBounds = sample.getSelfBounds();
+
+        out.type = sample.getType();
+        out.wrap = sample.getWrap();
+        out.basis = sample.getBasis();
+
+        ExpandGeomParam( widthParam, sampleSelector, out.widths,
+                         out.widthScope );
+        ExpandUVs( uvParam, iArgs, sampleSelector, out.uvs, out.uvScope );
+        ExpandGeomParam( nParam, sampleSelector, out.normals,
+                         out.normalScope );
+    }
+}
+
+//-*****************************************************************************
+void ExpandPoints( AbcG::IPoints &iPoints, const ExpandArgs &iArgs,
+                   PointsBuffer &oBuffer )
+{
+    AbcG::IPointsSchema &ps = iPoints.getSchema();
+
+    SampleTimeSet sampleTimes;
+    GetRelevantSampleTimes( iArgs, ps.getTimeSampling(), ps.getNumSamples(),
+                            sampleTimes );
+
+    AbcG::IFloatGeomParam widthParam = ps.getWidthsParam();
+
+    oBuffer.clear();
+    oBuffer.resize( sampleTimes.size() );
+
+    std::size_t index = 0;
+    for ( SampleTimeSet::const_iterator it = sampleTimes.begin();
+          it != sampleTimes.end(); ++it, ++index )
+    {
+        Abc::ISampleSelector sampleSelector( *it );
+        AbcG::IPointsSchema::Sample sample = ps.getValue( sampleSelector );
+
+        PointsSample &out = oBuffer[index];
+        out.time = *it;
+        out.positions = sample.getPositions();
+        out.velocities = sample.getVelocities();
+        out.ids = sample.getIds();
+        out.selfBounds = sample.getSelfBounds();
+
+        ExpandGeomParam( widthParam, sampleSelector, out.widths,
+                         out.widthScope );
+    }
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcProcedural
+} // End namespace Alembic
@@ -0,0 +1,77 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcProcedural_ExpandGeo_h_
+#define _Alembic_AbcProcedural_ExpandGeo_h_
+
+#include <Alembic/AbcProcedural/Buffers.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+// Each of these reads one object at the sample times that iArgs needs, into
+// oBuffer.  They only read, and can be called for different objects from
+// many threads at once.
+//-*****************************************************************************
+
+//! If iInheritedSamples is given, the sample times of the transform above
+//! are read too, so that the two can be concatenated.
+void ExpandXform( AbcG::IXform &iXform, const ExpandArgs &iArgs,
+                  XformBuffer &oBuffer,
+                  const MatrixSampleMap *iInheritedSamples = NULL );
+
+void ExpandPolyMesh( AbcG::IPolyMesh &iPolyMesh, const ExpandArgs &iArgs,
+                     PolyMeshBuffer &oBuffer );
+
+void ExpandSubD( AbcG::ISubD &iSubD, const ExpandArgs &iArgs,
+                 SubDBuffer &oBuffer );
+
+void ExpandCurves( AbcG::ICurves &iCurves, const ExpandArgs &iArgs,
+                   CurvesBuffer &oBuffer );
+
+void ExpandPoints( AbcG::IPoints &iPoints, const ExpandArgs &iArgs,
+                   PointsBuffer &oBuffer );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcProcedural
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,111 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcProcedural_Foundation_h_
+#define _Alembic_AbcProcedural_Foundation_h_
+
+#include <Alembic/AbcGeom/All.h>
+
+#include <map>
+#include <set>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+namespace AbcA = ::Alembic::AbcCoreAbstract::ALEMBIC_VERSION_NS;
+namespace Abc = ::Alembic::Abc::ALEMBIC_VERSION_NS;
+namespace AbcG = ::Alembic::AbcGeom::ALEMBIC_VERSION_NS;
+
+using Abc::chrono_t;
+
+//-*****************************************************************************
+//! The sample times, in seconds, that an object is read at.
+typedef std::set<chrono_t> SampleTimeSet;
+
+//-*****************************************************************************
+//! A transform at each of its sample times, in seconds.
+typedef std::map<chrono_t, Abc::M44d> MatrixSampleMap;
+
+//-*****************************************************************************
+//! What is expanded, and at which time.  These are the arguments shared by
+//! the renderer procedurals.
+struct ExpandArgs
+{
+    ExpandArgs()
+      : frame( 0.0 )
+      , fps( 24.0 )
+      , shutterOpen( 0.0 )
+      , shutterClose( 0.0 )
+      , excludeXform( false )
+      , flipv( false )
+      , numThreads( 1 )
+      , batchSize( 256 )
+    {}
+
+    //! Only the objects along this path, and everything beneath its last
+    //! object, are expanded.  Empty expands everything.
+    std::string objectpath;
+
+    double frame;
+    double fps;
+
+    //! The shutter, in frames relative to frame.
+    double shutterOpen;
+    double shutterClose;
+
+    //! Xforms aren't expanded, though their children still are.
+    bool excludeXform;
+
+    //! Texture v coordinates are flipped, v = 1 - v.
+    bool flipv;
+
+    //! How many threads read the samples of objects at once.
+    std::size_t numThreads;
+
+    //! How many objects are read ahead of the emitter, which bounds the
+    //! samples held in memory at once.
+    std::size_t batchSize;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcProcedural
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,298 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcProcedural/MockEmitter.h>
+#include <Alembic/AbcProcedural/SampleUtil.h>
+#include <Alembic/Util/Murmur3.h>
+
+#include <ImathBoxAlgo.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+MockEmitter::MockEmitter( bool iKeepLog )
+  : m_keepLog( iKeepLog )
+  , m_numObjects( 0 )
+  , m_numGeometry( 0 )
+  , m_numSamples( 0 )
+  , m_numFaces( 0 )
+  , m_numPoints( 0 )
+  , m_checksum( 0 )
+{
+    m_bounds.makeEmpty();
+    m_xforms.push_back( MatrixSampleMap() );
+}
+
+//-*****************************************************************************
+void MockEmitter::setParentXforms( const MatrixSampleMap &iXforms )
+{
+    m_xforms.front() = iXforms;
+}
+
+//-*****************************************************************************
+void MockEmitter::beginObject( const ObjectInfo &iInfo )
+{
+    ++m_numObjects;
+
+    // until an xform says otherwise, children see the parent's transform
+    m_xforms.push_back( m_xforms.back() );
+
+    const std::string &name = iInfo.object.getFullName();
+    addToChecksum( name.c_str(), name.size() );
+    log( "begin", iInfo, 0 );
+}
+
+//-*****************************************************************************
+void MockEmitter::endObject( const ObjectInfo &iInfo )
+{
+    m_xforms.pop_back();
+    log( "end", iInfo, 0 );
+}
+
+//-*****************************************************************************
+void MockEmitter::emitXform( const ObjectInfo &iInfo,
+                             const XformBuffer &iBuffer )
+{
+    MatrixSampleMap world;
+    if ( iBuffer.inheritsXforms )
+    {
+        ConcatenateXformSamples( m_xforms[m_xforms.size() - 2],
+                                 iBuffer.samples, world );
+    }
+    else
+    {
+        world = iBuffer.samples;
+    }
+    m_xforms.back().swap( world );
+
+    for ( MatrixSampleMap::const_iterator it = iBuffer.samples.begin();
+          it != iBuffer.samples.end(); ++it )
+    {
+        addToChecksum( &( it->first ), sizeof( chrono_t ) );
+        addToChecksum( it->second.getValue(), sizeof( Abc::M44d ) );
+    }
+
+    m_numSamples += iBuffer.samples.size();
+    log( "xform", iInfo, iBuffer.samples.size() );
+}
+
+//-*****************************************************************************
+void MockEmitter::emitPolyMesh( const ObjectInfo &iInfo,
+                                const PolyMeshBuffer &iBuffer )
+{
+    ++m_numGeometry;
+    for ( std::size_t i = 0; i < iBuffer.size(); ++i )
+    {
+        const PolyMeshSample &sample = iBuffer[i];
+        addSample( sample.time, sample.selfBounds, sample.positions,
+                   sample.faceCounts ? sample.faceCounts->size() : 0,
+                   i == 0 );
+
+        if ( sample.faceIndices )
+        {
+            addToChecksum( sample.faceIndices->get(),
+                           sample.faceIndices->size() * sizeof( int32_t ) );
+        }
+
+        if ( !sample.uvs.empty() )
+        {
+            addToChecksum( &sample.uvs[0],
+                           sample.uvs.size() * sizeof( Abc::V2f ) );
+        }
+
+        if ( !sample.normals.empty() )
+        {
+            addToChecksum( &sample.normals[0],
+                           sample.normals.size() * sizeof( Abc::N3f ) );
+        }
+    }
+    log( "polymesh", iInfo, iBuffer.size() );
+}
+
+//-*****************************************************************************
+void MockEmitter::emitSubD( const ObjectInfo &iInfo,
+                            const SubDBuffer &iBuffer )
+{
+    ++m_numGeometry;
+    for ( std::size_t i = 0; i < iBuffer.size(); ++i )
+    {
+        const SubDSample &sample = iBuffer[i];
+        addSample( sample.time, sample.selfBounds, sample.positions,
+                   sample.faceCounts ? sample.faceCounts->size() : 0,
+                   i == 0 );
+
+        if ( sample.faceIndices )
+        {
+            addToChecksum( sample.faceIndices->get(),
+                           sample.faceIndices->size() * sizeof( int32_t ) );
+        }
+
+        if ( sample.creaseSharpnesses )
+        {
+            addToChecksum( sample.creaseSharpnesses->get(),
+                sample.creaseSharpnesses->size() * sizeof( float ) );
+        }
+
+        if ( !sample.uvs.empty() )
+        {
+            addToChecksum( &sample.uvs[0],
+                           sample.uvs.size() * sizeof( Abc::V2f ) );
+        }
+
+        addToChecksum( sample.scheme.c_str(), sample.scheme.size() );
+    }
+    log( "subd", iInfo, iBuffer.size() );
+}
+
+//-*****************************************************************************
+void MockEmitter::emitCurves( const ObjectInfo &iInfo,
+                              const CurvesBuffer &iBuffer )
+{
+    ++m_numGeometry;
+    for ( std::size_t i = 0; i < iBuffer.size(); ++i )
+    {
+        const CurvesSample &sample = iBuffer[i];
+        addSample( sample.time, sample.selfBounds, sample.positions,
+                   sample.numVertices ? sample.numVertices->size() : 0,
+                   i == 0 );
+
+        if ( !sample.widths.empty() )
+        {
+            addToChecksum( &sample.widths[0],
+                           sample.widths.size() * sizeof( float ) );
+        }
+    }
+    log( "curves", iInfo, iBuffer.size() );
+}
+
+//-*****************************************************************************
+void MockEmitter::emitPoints( const ObjectInfo &iInfo,
+                              const PointsBuffer &iBuffer )
+{
+    ++m_numGeometry;
+    for ( std::size_t i = 0; i < iBuffer.size(); ++i )
+    {
+        const PointsSample &sample = iBuffer[i];
+        addSample( sample.time, sample.selfBounds, sample.positions, 0,
+                   i == 0 );
+
+        if ( sample.ids )
+        {
+            addToChecksum( sample.ids->get(),
+                sample.ids->size() * sizeof( Alembic::Util::uint64_t ) );
+        }
+    }
+    log( "points", iInfo, iBuffer.size() );
+}
+
+//-*****************************************************************************
+void MockEmitter::addSample( chrono_t iTime, const Abc::Box3d &iSelfBounds,
+                             Abc::P3fArraySamplePtr iPositions,
+                             std::size_t iNumFaces, bool iFirst )
+{
+    ++m_numSamples;
+    addToChecksum( &iTime, sizeof( chrono_t ) );
+
+    if ( iPositions )
+    {
+        addToChecksum( iPositions->get(),
+                       iPositions->size() * sizeof( Abc::V3f ) );
+    }
+
+    // the rest is only counted once per object
+    if ( !iFirst )
+    {
+        return;
+    }
+
+    m_numFaces += iNumFaces;
+    m_numPoints += iPositions ? iPositions->size() : 0;
+
+    Abc::Box3d bounds = iSelfBounds;
+    if ( bounds.isEmpty() && iPositions )
+    {
+        for ( std::size_t i = 0; i < iPositions->size(); ++i )
+        {
+            bounds.extendBy( Abc::V3d( ( *iPositions )[i] ) );
+        }
+    }
+
+    if ( !bounds.isEmpty() )
+    {
+        m_bounds.extendBy( Imath::transform( bounds,
+            InterpolateXformSamples( m_xforms.back(), iTime ) ) );
+    }
+}
+
+//-*****************************************************************************
+void MockEmitter::addToChecksum( const void *iData, std::size_t iSize )
+{
+    Alembic::Util::uint64_t hash[2];
+    Alembic::Util::MurmurHash3_x64_128( iData, iSize, sizeof( char ), hash );
+    m_checksum = m_checksum * 31 + hash[0];
+}
+
+//-*****************************************************************************
+void MockEmitter::log( const char *iCall, const ObjectInfo &iInfo,
+                       std::size_t iNumSamples )
+{
+    if ( !m_keepLog )
+    {
+        return;
+    }
+
+    std::ostringstream line;
+    line << iCall << " " << iInfo.object.getFullName();
+    if ( iNumSamples > 0 )
+    {
+        line << " " << iNumSamples;
+    }
+    if ( !iInfo.visible )
+    {
+        line << " hidden";
+    }
+    if ( !iInfo.faceSet.empty() )
+    {
+        line << " faceset " << iInfo.faceSet;
+    }
+    m_log.push_back( line.str() );
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcProcedural
+} // End namespace Alembic
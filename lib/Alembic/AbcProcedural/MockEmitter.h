@@ -0,0 +1,132 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcProcedural_MockEmitter_h_
+#define _Alembic_AbcProcedural_MockEmitter_h_
+
+#include <Alembic/AbcProcedural/Emitter.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! An emitter which stands in for a renderer, for tests and benchmarks.
+//!
+//! It keeps the world space transforms of the hierarchy, the way a renderer
+//! which wants flattened transforms would, counts what it is given, and
+//! adds it all to a checksum.  It can also keep a line of text per call.
+class MockEmitter : public Emitter
+{
+public:
+    MockEmitter( bool iKeepLog = false );
+
+    //! Sets the transform that everything emitted is beneath, the way a
+    //! renderer expanding a DeferredStub places it beneath its
+    //! parentXforms.
+    void setParentXforms( const MatrixSampleMap &iXforms );
+
+    virtual void beginObject( const ObjectInfo &iInfo );
+    virtual void endObject( const ObjectInfo &iInfo );
+
+    virtual void emitXform( const ObjectInfo &iInfo,
+                            const XformBuffer &iBuffer );
+
+    virtual void emitPolyMesh( const ObjectInfo &iInfo,
+                               const PolyMeshBuffer &iBuffer );
+
+    virtual void emitSubD( const ObjectInfo &iInfo,
+                           const SubDBuffer &iBuffer );
+
+    virtual void emitCurves( const ObjectInfo &iInfo,
+                             const CurvesBuffer &iBuffer );
+
+    virtual void emitPoints( const ObjectInfo &iInfo,
+                             const PointsBuffer &iBuffer );
+
+    std::size_t getNumObjects() const { return m_numObjects; }
+    std::size_t getNumGeometry() const { return m_numGeometry; }
+
+    //! Samples given, across every object and sample time.
+    std::size_t getNumSamples() const { return m_numSamples; }
+
+    //! Faces of meshes and curves, at their first sample.
+    std::size_t getNumFaces() const { return m_numFaces; }
+
+    //! Positions of everything, at the first sample.
+    std::size_t getNumPoints() const { return m_numPoints; }
+
+    //! The world space bounds of the geometry at its first sample.
+    const Abc::Box3d &getBounds() const { return m_bounds; }
+
+    //! Changes with anything given, and with the order it is given in.
+    Alembic::Util::uint64_t getChecksum() const { return m_checksum; }
+
+    const std::vector<std::string> &getLog() const { return m_log; }
+
+private:
+    void addSample( chrono_t iTime, const Abc::Box3d &iSelfBounds,
+                    Abc::P3fArraySamplePtr iPositions,
+                    std::size_t iNumFaces, bool iFirst );
+
+    void addToChecksum( const void *iData, std::size_t iSize );
+
+    void log( const char *iCall, const ObjectInfo &iInfo,
+              std::size_t iNumSamples );
+
+    bool m_keepLog;
+    std::vector<std::string> m_log;
+
+    // the world transform at each level of the hierarchy
+    std::vector<MatrixSampleMap> m_xforms;
+
+    std::size_t m_numObjects;
+    std::size_t m_numGeometry;
+    std::size_t m_numSamples;
+    std::size_t m_numFaces;
+    std::size_t m_numPoints;
+    Abc::Box3d m_bounds;
+    Alembic::Util::uint64_t m_checksum;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcProcedural
+} // End namespace Alembic
+
+#endif
@@ -0,0 +1,272 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcProcedural/SampleUtil.h>
+
+#include <ImathMatrixAlgo.h>
+#include <ImathQuat.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+namespace {
+
+//TODO, what's a reasonable episilon?
+static const chrono_t kEpsilon = 1.0 / 10000.0;
+
+//-*****************************************************************************
+void DecomposeXform( const Abc::M44d &iMat, Abc::V3d &oScale,
+                     Abc::V3d &oShear, Imath::Quatd &oRotation,
+                     Abc::V3d &oTranslation )
+{
+    Abc::M44d remainder( iMat );
+
+    // Extract Scale, Shear
+    Imath::extractAndRemoveScalingAndShear( remainder, oScale, oShear );
+
+    // Extract translation
+    oTranslation.x = remainder[3][0];
+    oTranslation.y = remainder[3][1];
+    oTranslation.z = remainder[3][2];
+
+    // Extract rotation
+    oRotation = Imath::extractQuat( remainder );
+}
+
+//-*****************************************************************************
+Abc::M44d RecomposeXform( const Abc::V3d &iScale, const Abc::V3d &iShear,
+                          const Imath::Quatd &iRotation,
+                          const Abc::V3d &iTranslation )
+{
+    Abc::M44d scaleMtx, shearMtx, rotationMtx, translationMtx;
+
+    scaleMtx.setScale( iScale );
+    shearMtx.setShear( iShear );
+    rotationMtx = iRotation.toMatrix44();
+    translationMtx.setTranslation( iTranslation );
+
+    return scaleMtx * shearMtx * rotationMtx * translationMtx;
+}
+
+//-*****************************************************************************
+// when amt is 0, a is returned
+Abc::V3d Lerp( const Abc::V3d &iA, const Abc::V3d &iB, double iAmt )
+{
+    return iA + ( iB - iA ) * iAmt;
+}
+
+} // End namespace
+
+//-*****************************************************************************
+void GetRelevantSampleTimes( const ExpandArgs &iArgs,
+                             AbcA::TimeSamplingPtr iTimeSampling,
+                             std::size_t iNumSamples,
+                             SampleTimeSet &oTimes,
+                             const MatrixSampleMap *iInheritedSamples )
+{
+    if ( iNumSamples < 2 )
+    {
+        oTimes.insert( 0.0 );
+        return;
+    }
+
+    chrono_t frameTime = iArgs.frame / iArgs.fps;
+
+    chrono_t shutterOpenTime =
+        ( iArgs.frame + iArgs.shutterOpen ) / iArgs.fps;
+
+    chrono_t shutterCloseTime =
+        ( iArgs.frame + iArgs.shutterClose ) / iArgs.fps;
+
+    // For interpolating and concatenating samples, we need to consider
+    // possible inherited sample times outside of our natural shutter range
+    if ( iInheritedSamples && iInheritedSamples->size() > 1 )
+    {
+        shutterOpenTime = std::min( shutterOpenTime,
+                                    iInheritedSamples->begin()->first );
+        shutterCloseTime = std::max( shutterCloseTime,
+                                     iInheritedSamples->rbegin()->first );
+    }
+
+    std::pair<AbcA::index_t, chrono_t> shutterOpenFloor =
+        iTimeSampling->getFloorIndex( shutterOpenTime, iNumSamples );
+
+    std::pair<AbcA::index_t, chrono_t> shutterCloseCeil =
+        iTimeSampling->getCeilIndex( shutterCloseTime, iNumSamples );
+
+    //check to see if our second sample is really the
+    //floor that we want due to floating point slop
+    //first make sure that we have at least two samples to work with
+    if ( shutterOpenFloor.first < shutterCloseCeil.first )
+    {
+        //if our open sample is less than open time,
+        //look at the next index time
+        if ( shutterOpenFloor.second < shutterOpenTime )
+        {
+            chrono_t nextSampleTime =
+                iTimeSampling->getSampleTime( shutterOpenFloor.first + 1 );
+
+            if ( fabs( nextSampleTime - shutterOpenTime ) < kEpsilon )
+            {
+                shutterOpenFloor.first += 1;
+                shutterOpenFloor.second = nextSampleTime;
+            }
+        }
+    }
+
+    for ( AbcA::index_t i = shutterOpenFloor.first;
+          i < shutterCloseCeil.first; ++i )
+    {
+        oTimes.insert( iTimeSampling->getSampleTime( i ) );
+    }
+
+    //no samples above? put frame time in there and get out
+    if ( oTimes.size() == 0 )
+    {
+        oTimes.insert( frameTime );
+        return;
+    }
+
+    chrono_t lastSample = *( oTimes.rbegin() );
+
+    //determine whether we need the extra sample at the end
+    if ( ( fabs( lastSample - shutterCloseTime ) > kEpsilon )
+         && lastSample < shutterCloseTime )
+    {
+        oTimes.insert( shutterCloseCeil.second );
+    }
+}
+
+//-*****************************************************************************
+chrono_t GetRelativeSampleTime( const ExpandArgs &iArgs,
+                                chrono_t iSampleTime )
+{
+    chrono_t frameTime = iArgs.frame / iArgs.fps;
+
+    chrono_t result = ( iSampleTime - frameTime ) * iArgs.fps;
+
+    if ( fabs( result ) < kEpsilon )
+    {
+        result = 0.0;
+    }
+
+    return result;
+}
+
+//-*****************************************************************************
+Abc::M44d InterpolateXformSamples( const MatrixSampleMap &iSamples,
+                                   chrono_t iSampleTime )
+{
+    MatrixSampleMap::const_iterator found = iSamples.find( iSampleTime );
+    if ( found != iSamples.end() )
+    {
+        return found->second;
+    }
+
+    if ( iSamples.empty() )
+    {
+        return Abc::M44d();
+    }
+
+    if ( iSamples.size() == 1 || iSampleTime <= iSamples.begin()->first )
+    {
+        return iSamples.begin()->second;
+    }
+
+    if ( iSampleTime >= iSamples.rbegin()->first )
+    {
+        return iSamples.rbegin()->second;
+    }
+
+    // the samples on either side
+    MatrixSampleMap::const_iterator right =
+        iSamples.upper_bound( iSampleTime );
+    MatrixSampleMap::const_iterator left = right;
+    --left;
+
+    Abc::V3d scaleL, scaleR, shearL, shearR, transL, transR;
+    Imath::Quatd quatL, quatR;
+
+    DecomposeXform( left->second, scaleL, shearL, quatL, transL );
+    DecomposeXform( right->second, scaleR, shearR, quatR, transR );
+
+    chrono_t amt = ( iSampleTime - left->first ) /
+        ( right->first - left->first );
+
+    if ( ( quatL ^ quatR ) < 0 )
+    {
+        quatR = -quatR;
+    }
+
+    return RecomposeXform( Lerp( scaleL, scaleR, amt ),
+                           Lerp( shearL, shearR, amt ),
+                           Imath::slerp( quatL, quatR, amt ),
+                           Lerp( transL, transR, amt ) );
+}
+
+//-*****************************************************************************
+void ConcatenateXformSamples( const MatrixSampleMap &iParentSamples,
+                              const MatrixSampleMap &iLocalSamples,
+                              MatrixSampleMap &oSamples )
+{
+    SampleTimeSet unionOfSampleTimes;
+
+    for ( MatrixSampleMap::const_iterator it = iParentSamples.begin();
+          it != iParentSamples.end(); ++it )
+    {
+        unionOfSampleTimes.insert( it->first );
+    }
+
+    for ( MatrixSampleMap::const_iterator it = iLocalSamples.begin();
+          it != iLocalSamples.end(); ++it )
+    {
+        unionOfSampleTimes.insert( it->first );
+    }
+
+    for ( SampleTimeSet::const_iterator it = unionOfSampleTimes.begin();
+          it != unionOfSampleTimes.end(); ++it )
+    {
+        Abc::M44d parentMtx = InterpolateXformSamples( iParentSamples, *it );
+        Abc::M44d localMtx = InterpolateXformSamples( iLocalSamples, *it );
+
+        oSamples[*it] = localMtx * parentMtx;
+    }
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace AbcProcedural
+} // End namespace Alembic
@@ -0,0 +1,85 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#ifndef _Alembic_AbcProcedural_SampleUtil_h_
+#define _Alembic_AbcProcedural_SampleUtil_h_
+
+#include <Alembic/AbcProcedural/Foundation.h>
+
+namespace Alembic {
+namespace AbcProcedural {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+//! Fills oTimes with the sample times needed to cover the shutter of iArgs,
+//! for a property with numSamples samples.  A property with fewer than two
+//! samples is read at time 0.
+//!
+//! If iInheritedSamples is given, the times also cover those of the
+//! transform above, so that the two can be concatenated.
+void GetRelevantSampleTimes( const ExpandArgs &iArgs,
+                             AbcA::TimeSamplingPtr iTimeSampling,
+                             std::size_t iNumSamples,
+                             SampleTimeSet &oTimes,
+                             const MatrixSampleMap *iInheritedSamples = NULL );
+
+//-*****************************************************************************
+//! Returns iSampleTime in frames relative to the frame of iArgs, as motion
+//! blocks are given, with values very near the frame snapped to 0.
+chrono_t GetRelativeSampleTime( const ExpandArgs &iArgs,
+                                chrono_t iSampleTime );
+
+//-*****************************************************************************
+//! Returns the transform of iSamples at iSampleTime.  Between two samples
+//! the scale, shear, rotation and translation are interpolated apart.
+Abc::M44d InterpolateXformSamples( const MatrixSampleMap &iSamples,
+                                   chrono_t iSampleTime );
+
+//-*****************************************************************************
+//! Fills oSamples with iLocalSamples applied to iParentSamples at every
+//! sample time of either.
+void ConcatenateXformSamples( const MatrixSampleMap &iParentSamples,
+                              const MatrixSampleMap &iLocalSamples,
+                              MatrixSampleMap &oSamples );
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace AbcProcedural
+} // End namespace Alembic
+
+#endif
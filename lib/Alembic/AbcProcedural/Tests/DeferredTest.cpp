@@ -0,0 +1,435 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcGeom/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcProcedural/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <sstream>
+
+namespace AbcG = Alembic::AbcGeom;
+namespace AbcP = Alembic::AbcProcedural;
+using namespace AbcG;
+
+static const std::size_t kNumBlocks = 4;
+static const std::size_t kNumHouses = 6;
+
+//-*****************************************************************************
+// a unit quad, moved along z by iOffset
+void writeQuad( OPolyMesh & iMesh, float iOffset )
+{
+    std::vector< V3f > positions;
+    positions.push_back( V3f( 0.0f, 0.0f, iOffset ) );
+    positions.push_back( V3f( 1.0f, 0.0f, iOffset ) );
+    positions.push_back( V3f( 1.0f, 1.0f, iOffset ) );
+    positions.push_back( V3f( 0.0f, 1.0f, iOffset ) );
+
+    int32_t indices[] = { 0, 1, 2, 3 };
+    int32_t counts[] = { 4 };
+
+    iMesh.getSchema().set( OPolyMeshSchema::Sample(
+        V3fArraySample( positions ), Int32ArraySample( indices, 4 ),
+        Int32ArraySample( counts, 1 ) ) );
+}
+
+//-*****************************************************************************
+void writeTranslation( OXform & iXform, double iX )
+{
+    XformSample samp;
+    samp.setTranslation( V3d( iX, 0.0, 0.0 ) );
+    iXform.getSchema().set( samp );
+}
+
+//-*****************************************************************************
+void writeArchive( const std::string & iName )
+{
+    OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(), iName );
+
+    TimeSamplingPtr frames( new TimeSampling( 1.0 / 24.0, 0.0 ) );
+
+    // the city moves 1 along x each frame
+    OXform city( archive.getTop(), "city", frames );
+    for ( std::size_t i = 0; i < 5; ++i )
+    {
+        writeTranslation( city, i );
+    }
+
+    for ( std::size_t b = 0; b < kNumBlocks; ++b )
+    {
+        std::ostringstream blockName;
+        blockName << "block" << b;
+        OXform block( city, blockName.str() );
+        writeTranslation( block, 10.0 * b );
+
+        for ( std::size_t h = 0; h < kNumHouses; ++h )
+        {
+            std::ostringstream houseName;
+            houseName << "house" << h;
+            OPolyMesh house( block, houseName.str() );
+            writeQuad( house, h );
+        }
+    }
+
+    // stored child bounds, bigger than what is in the park
+    OXform park( city, "park" );
+    writeTranslation( park, 0.0 );
+    park.getSchema().getChildBoundsProperty().set(
+        Box3d( V3d( 0.0 ), V3d( 2.0 ) ) );
+    OPolyMesh tree( park, "tree" );
+    writeQuad( tree, 0.0f );
+
+    // hidden things aren't in the bounds
+    OXform hidden( city, "hidden" );
+    writeTranslation( hidden, 0.0 );
+    CreateVisibilityProperty( hidden, 0 ).set( kVisibilityHidden );
+    OPolyMesh ghost( hidden, "ghost" );
+    writeQuad( ghost, 1000.0f );
+
+    // geometry with geometry beneath it
+    OPolyMesh tower( city, "tower" );
+    writeQuad( tower, 0.0f );
+    OPolyMesh antenna( tower, "antenna" );
+    writeQuad( antenna, 2.0f );
+
+    OSubD dome( city, "dome" );
+    {
+        std::vector< V3f > positions( 4, V3f( 0.0f ) );
+        positions[1].x = 1.0f;
+        positions[2].y = 1.0f;
+        int32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+        int32_t counts[] = { 3, 3 };
+        dome.getSchema().set( OSubDSchema::Sample(
+            V3fArraySample( positions ), Int32ArraySample( indices, 6 ),
+            Int32ArraySample( counts, 2 ) ) );
+
+        int32_t faces[] = { 1 };
+        dome.getSchema().createFaceSet( "top" ).getSchema().set(
+            OFaceSetSchema::Sample( Int32ArraySample( faces, 1 ) ) );
+    }
+
+    // a few objects spread far apart
+    OXform spread( archive.getTop(), "spread" );
+    writeTranslation( spread, 0.0 );
+
+    OXform left( spread, "left" );
+    writeTranslation( left, -500.0 );
+    OPolyMesh leftMesh( left, "mesh" );
+    writeQuad( leftMesh, 0.0f );
+
+    OXform right( spread, "right" );
+    writeTranslation( right, 500.0 );
+    OPolyMesh rightMesh( right, "mesh" );
+    writeQuad( rightMesh, 0.0f );
+}
+
+//-*****************************************************************************
+const AbcP::DeferredStub * findStub( const AbcP::DeferredStubList & iStubs,
+                                     const std::string & iPath )
+{
+    for ( std::size_t i = 0; i < iStubs.size(); ++i )
+    {
+        if ( iStubs[i].info.object.getFullName() == iPath )
+        {
+            return &iStubs[i];
+        }
+    }
+    return NULL;
+}
+
+//-*****************************************************************************
+// expands every stub into an emitter of its own, the way a renderer
+// would, adding up what they are given
+struct StubTotals
+{
+    StubTotals() : numGeometry( 0 ), numFaces( 0 ), numPoints( 0 )
+    {
+        bounds.makeEmpty();
+        stubBounds.makeEmpty();
+    }
+
+    std::size_t numGeometry;
+    std::size_t numFaces;
+    std::size_t numPoints;
+    Box3d bounds;
+    Box3d stubBounds;
+    std::vector< std::string > log;
+};
+
+StubTotals expandStubs( const AbcP::DeferredStubList & iStubs,
+                        const AbcP::ExpandArgs & iArgs )
+{
+    StubTotals totals;
+    for ( std::size_t i = 0; i < iStubs.size(); ++i )
+    {
+        AbcP::MockEmitter emitter( true );
+        emitter.setParentXforms( iStubs[i].parentXforms );
+        AbcP::Expand( iStubs[i], iArgs, emitter );
+
+        totals.numGeometry += emitter.getNumGeometry();
+        totals.numFaces += emitter.getNumFaces();
+        totals.numPoints += emitter.getNumPoints();
+        totals.bounds.extendBy( emitter.getBounds() );
+        totals.stubBounds.extendBy( iStubs[i].bounds );
+        totals.log.insert( totals.log.end(), emitter.getLog().begin(),
+                           emitter.getLog().end() );
+    }
+    return totals;
+}
+
+//-*****************************************************************************
+// the stubs expand to what expanding everything does
+void checkMatches( IArchive & iArchive, const AbcP::ExpandArgs & iArgs,
+                   const AbcP::DeferredStubList & iStubs )
+{
+    AbcP::MockEmitter full( true );
+    AbcP::Expand( iArchive.getTop(), iArgs, full );
+
+    StubTotals totals = expandStubs( iStubs, iArgs );
+    TESTING_ASSERT( totals.numGeometry == full.getNumGeometry() );
+    TESTING_ASSERT( totals.numFaces == full.getNumFaces() );
+    TESTING_ASSERT( totals.numPoints == full.getNumPoints() );
+    TESTING_ASSERT( totals.bounds == full.getBounds() );
+
+    // the stubs' bounds hold everything they expand to
+    TESTING_ASSERT( totals.stubBounds.intersects( full.getBounds().min ) );
+    TESTING_ASSERT( totals.stubBounds.intersects( full.getBounds().max ) );
+}
+
+//-*****************************************************************************
+void testWhole( IArchive & iArchive )
+{
+    AbcP::ExpandArgs args;
+    args.frame = 2.0;
+
+    AbcP::DeferArgs deferArgs;
+    deferArgs.maxObjectsPerStub = 1000;
+    deferArgs.maxBoundsFraction = 2.0;
+
+    AbcP::DeferredStubList stubs;
+    AbcP::PlanDeferred( iArchive.getTop(), args, deferArgs, stubs );
+
+    TESTING_ASSERT( stubs.size() == 2 );
+    TESTING_ASSERT( stubs[0].info.object.getFullName() == "/city" );
+    TESTING_ASSERT( stubs[1].info.object.getFullName() == "/spread" );
+    TESTING_ASSERT( stubs[0].includeChildren && stubs[1].includeChildren );
+    TESTING_ASSERT( stubs[0].parentXforms.empty() );
+
+    // the blocks and houses, the park and tree, the hidden ghost, the
+    // tower and antenna, and the dome
+    std::size_t numCity = 1 + kNumBlocks * ( 1 + kNumHouses ) + 2 + 2 + 2 + 1;
+    TESTING_ASSERT( stubs[0].numObjects == numCity );
+    TESTING_ASSERT( stubs[1].numObjects == 5 );
+
+    // the city is at 2 along x at frame 2, the park's stored bounds are
+    // the biggest z, and the hidden ghost isn't counted
+    Box3d city = stubs[0].bounds;
+    TESTING_ASSERT( city.min == V3d( 2.0, 0.0, 0.0 ) );
+    TESTING_ASSERT( city.max == V3d( 2.0 + 10.0 * ( kNumBlocks - 1 ) + 1.0,
+                                     2.0, kNumHouses - 1.0 ) );
+
+    checkMatches( iArchive, args, stubs );
+
+    // whole stubs expand just like everything does, in the same order
+    AbcP::MockEmitter full( true );
+    AbcP::Expand( iArchive.getTop(), args, full );
+    TESTING_ASSERT( expandStubs( stubs, args ).log == full.getLog() );
+}
+
+//-*****************************************************************************
+void testSplit( IArchive & iArchive )
+{
+    AbcP::ExpandArgs args;
+    args.frame = 2.0;
+
+    AbcP::DeferArgs deferArgs;
+    deferArgs.maxObjectsPerStub = 5;
+    deferArgs.maxBoundsFraction = 2.0;
+
+    AbcP::DeferredStubList stubs;
+    AbcP::PlanDeferred( iArchive.getTop(), args, deferArgs, stubs );
+
+    for ( std::size_t i = 0; i < stubs.size(); ++i )
+    {
+        TESTING_ASSERT( stubs[i].numObjects <= 5 );
+    }
+
+    // the blocks are too big, their houses aren't
+    TESTING_ASSERT( findStub( stubs, "/city" ) == NULL );
+    TESTING_ASSERT( findStub( stubs, "/city/block0" ) == NULL );
+    const AbcP::DeferredStub * house =
+        findStub( stubs, "/city/block1/house3" );
+    TESTING_ASSERT( house != NULL && house->includeChildren );
+    TESTING_ASSERT( house->info.depth == 2 );
+    TESTING_ASSERT( house->bounds ==
+                    Box3d( V3d( 12.0, 0.0, 3.0 ), V3d( 13.0, 1.0, 3.0 ) ) );
+
+    // where nothing beneath is read, the stored bounds are used
+    const AbcP::DeferredStub * park = findStub( stubs, "/city/park" );
+    TESTING_ASSERT( park != NULL && park->numObjects == 2 );
+    TESTING_ASSERT( park->bounds ==
+                    Box3d( V3d( 2.0, 0.0, 0.0 ), V3d( 4.0, 2.0, 2.0 ) ) );
+
+    // hidden things still have a stub, with nothing in it to bound
+    const AbcP::DeferredStub * hidden = findStub( stubs, "/city/hidden" );
+    TESTING_ASSERT( hidden != NULL && !hidden->info.visible );
+    TESTING_ASSERT( hidden->bounds.isEmpty() );
+
+    checkMatches( iArchive, args, stubs );
+
+    // down to single objects, geometry above other objects gets a stub of
+    // its own
+    deferArgs.maxObjectsPerStub = 1;
+    stubs.clear();
+    AbcP::PlanDeferred( iArchive.getTop(), args, deferArgs, stubs );
+
+    const AbcP::DeferredStub * tower = findStub( stubs, "/city/tower" );
+    TESTING_ASSERT( tower != NULL && !tower->includeChildren );
+    TESTING_ASSERT( tower->numObjects == 1 );
+    TESTING_ASSERT( findStub( stubs, "/city/tower/antenna" ) != NULL );
+
+    for ( std::size_t i = 0; i < stubs.size(); ++i )
+    {
+        TESTING_ASSERT( stubs[i].numObjects == 1 );
+    }
+
+    checkMatches( iArchive, args, stubs );
+}
+
+//-*****************************************************************************
+void testBoundsFraction( IArchive & iArchive )
+{
+    AbcP::ExpandArgs args;
+    args.frame = 2.0;
+
+    // the spread is most of everything, the city is small beside it
+    AbcP::DeferArgs deferArgs;
+    deferArgs.maxObjectsPerStub = 1000;
+    deferArgs.maxBoundsFraction = 0.25;
+    deferArgs.minObjectsToSplit = 2;
+
+    AbcP::DeferredStubList stubs;
+    AbcP::PlanDeferred( iArchive.getTop(), args, deferArgs, stubs );
+
+    TESTING_ASSERT( stubs.size() == 3 );
+    TESTING_ASSERT( stubs[0].info.object.getFullName() == "/city" );
+    TESTING_ASSERT( stubs[1].info.object.getFullName() == "/spread/left" );
+    TESTING_ASSERT( stubs[2].info.object.getFullName() == "/spread/right" );
+    TESTING_ASSERT( stubs[2].bounds.min.x == 500.0 );
+
+    checkMatches( iArchive, args, stubs );
+
+    // unless it has too few objects to be worth it
+    deferArgs.minObjectsToSplit = 6;
+    stubs.clear();
+    AbcP::PlanDeferred( iArchive.getTop(), args, deferArgs, stubs );
+    TESTING_ASSERT( stubs.size() == 2 );
+}
+
+//-*****************************************************************************
+void testObjectPath( IArchive & iArchive )
+{
+    AbcP::ExpandArgs args;
+    args.frame = 2.0;
+    args.objectpath = "/city/tower/antenna";
+
+    AbcP::DeferredStubList stubs;
+    AbcP::PlanDeferred( iArchive.getTop(), args, AbcP::DeferArgs(), stubs );
+
+    // the tower is on the way, and is expanded on its own
+    TESTING_ASSERT( stubs.size() == 2 );
+    TESTING_ASSERT( stubs[0].info.object.getFullName() == "/city/tower" );
+    TESTING_ASSERT( !stubs[0].includeChildren );
+    TESTING_ASSERT( stubs[1].info.object.getFullName() ==
+                    "/city/tower/antenna" );
+    TESTING_ASSERT( stubs[1].info.depth == 2 );
+
+    // beneath the city's transform
+    TESTING_ASSERT( stubs[1].parentXforms.size() == 1 );
+    TESTING_ASSERT( stubs[1].bounds.min == V3d( 2.0, 0.0, 2.0 ) );
+
+    checkMatches( iArchive, args, stubs );
+
+    // a face set at the end of the path
+    args.objectpath = "/city/dome/top";
+    stubs.clear();
+    AbcP::PlanDeferred( iArchive.getTop(), args, AbcP::DeferArgs(), stubs );
+    TESTING_ASSERT( stubs.size() == 1 );
+    TESTING_ASSERT( stubs[0].info.faceSet == "top" );
+
+    StubTotals totals = expandStubs( stubs, args );
+    TESTING_ASSERT( totals.log.size() == 3 );
+    TESTING_ASSERT( totals.log[1] == "subd /city/dome 1 faceset top" );
+
+    checkMatches( iArchive, args, stubs );
+}
+
+//-*****************************************************************************
+void testShutter( IArchive & iArchive )
+{
+    AbcP::ExpandArgs args;
+    args.frame = 2.0;
+    args.shutterOpen = 0.0;
+    args.shutterClose = 1.0;
+
+    AbcP::DeferredStubList stubs;
+    AbcP::PlanDeferred( iArchive.getTop(), args, AbcP::DeferArgs(), stubs );
+
+    // the city moves from 2 to 3 along x while the shutter is open
+    const AbcP::DeferredStub * city = findStub( stubs, "/city" );
+    TESTING_ASSERT( city != NULL );
+    TESTING_ASSERT( city->bounds.min.x == 2.0 );
+    TESTING_ASSERT( city->bounds.max.x == 3.0 + 10.0 * ( kNumBlocks - 1 ) +
+                    1.0 );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string name = "deferred.abc";
+    writeArchive( name );
+
+    IArchive archive( Alembic::AbcCoreOgawa::ReadArchive(), name );
+
+    testWhole( archive );
+    testSplit( archive );
+    testBoundsFraction( archive );
+    testObjectPath( archive );
+    testShutter( archive );
+
+    return 0;
+}
@@ -0,0 +1,388 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcGeom/All.h>
+#include <Alembic/AbcCoreOgawa/All.h>
+#include <Alembic/AbcProcedural/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+#include <sstream>
+
+namespace AbcG = Alembic::AbcGeom;
+namespace AbcP = Alembic::AbcProcedural;
+using namespace AbcG;
+
+using Alembic::AbcCoreAbstract::chrono_t;
+
+static const std::size_t kNumCrowd = 40;
+
+//-*****************************************************************************
+// a unit quad, moved along z by iOffset
+void writeQuad( OPolyMesh & iMesh, float iOffset )
+{
+    std::vector< V3f > positions;
+    positions.push_back( V3f( 0.0f, 0.0f, iOffset ) );
+    positions.push_back( V3f( 1.0f, 0.0f, iOffset ) );
+    positions.push_back( V3f( 1.0f, 1.0f, iOffset ) );
+    positions.push_back( V3f( 0.0f, 1.0f, iOffset ) );
+
+    int32_t indices[] = { 0, 1, 2, 3 };
+    int32_t counts[] = { 4 };
+
+    std::vector< V2f > uvs;
+    uvs.push_back( V2f( 0.0f, 0.0f ) );
+    uvs.push_back( V2f( 1.0f, 0.0f ) );
+    uvs.push_back( V2f( 1.0f, 0.25f ) );
+    uvs.push_back( V2f( 0.0f, 0.25f ) );
+
+    OV2fGeomParam::Sample uvSample( V2fArraySample( uvs ), kVertexScope );
+
+    iMesh.getSchema().set( OPolyMeshSchema::Sample(
+        V3fArraySample( positions ), Int32ArraySample( indices, 4 ),
+        Int32ArraySample( counts, 1 ), uvSample ) );
+}
+
+//-*****************************************************************************
+void writeArchive( const std::string & iName )
+{
+    OArchive archive( Alembic::AbcCoreOgawa::WriteArchive(), iName );
+
+    TimeSamplingPtr frames( new TimeSampling( 1.0 / 24.0, 0.0 ) );
+
+    // world moves 1 along x each frame
+    OXform world( archive.getTop(), "world", frames );
+    for ( std::size_t i = 0; i < 5; ++i )
+    {
+        XformSample samp;
+        samp.setTranslation( V3d( i, 0.0, 0.0 ) );
+        world.getSchema().set( samp );
+    }
+
+    // box moves 1 along z each frame
+    OPolyMesh box( world, "box", frames );
+    for ( std::size_t i = 0; i < 5; ++i )
+    {
+        writeQuad( box, i );
+    }
+
+    OSubD subd( world, "subd" );
+    {
+        std::vector< V3f > positions( 4, V3f( 0.0f ) );
+        positions[1].x = 1.0f;
+        positions[2].y = 1.0f;
+        int32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+        int32_t counts[] = { 3, 3 };
+        int32_t creaseIndices[] = { 0, 2 };
+        int32_t creaseLengths[] = { 2 };
+        float creaseSharpnesses[] = { 3.0f };
+        subd.getSchema().set( OSubDSchema::Sample(
+            V3fArraySample( positions ), Int32ArraySample( indices, 6 ),
+            Int32ArraySample( counts, 2 ),
+            Int32ArraySample( creaseIndices, 2 ),
+            Int32ArraySample( creaseLengths, 1 ),
+            FloatArraySample( creaseSharpnesses, 1 ) ) );
+
+        int32_t faces[] = { 1 };
+        subd.getSchema().createFaceSet( "top" ).getSchema().set(
+            OFaceSetSchema::Sample( Int32ArraySample( faces, 1 ) ) );
+    }
+
+    // the ghost is hidden with its parent, the shown mesh isn't
+    XformSample identity;
+
+    OXform hidden( world, "hidden" );
+    hidden.getSchema().set( identity );
+    CreateVisibilityProperty( hidden, 0 ).set( kVisibilityHidden );
+
+    OPolyMesh ghost( hidden, "ghost" );
+    writeQuad( ghost, 0.0f );
+
+    OXform shown( hidden, "shown" );
+    shown.getSchema().set( identity );
+    CreateVisibilityProperty( shown, 0 ).set( kVisibilityVisible );
+
+    OPolyMesh shownMesh( shown, "mesh" );
+    writeQuad( shownMesh, 0.0f );
+
+    // nothing is walked beneath objects of unknown types
+    OObject other( world, "other" );
+    OPolyMesh unreached( other, "unreached" );
+    writeQuad( unreached, 0.0f );
+
+    OCurves hair( archive.getTop(), "hair" );
+    {
+        std::vector< V3f > positions;
+        for ( std::size_t i = 0; i < 4; ++i )
+        {
+            positions.push_back( V3f( 0.0f, i, 0.0f ) );
+        }
+        int32_t numVertices[] = { 4 };
+        float widths[] = { 0.1f };
+        hair.getSchema().set( OCurvesSchema::Sample(
+            V3fArraySample( positions ), Int32ArraySample( numVertices, 1 ),
+            kCubic, kNonPeriodic,
+            OFloatGeomParam::Sample( FloatArraySample( widths, 1 ),
+                                     kConstantScope ) ) );
+    }
+
+    OPoints pts( archive.getTop(), "pts" );
+    {
+        std::vector< V3f > positions( 3, V3f( -2.0f ) );
+        std::vector< Alembic::Util::uint64_t > ids;
+        ids.push_back( 7 );
+        ids.push_back( 8 );
+        ids.push_back( 9 );
+        pts.getSchema().set( OPointsSchema::Sample(
+            V3fArraySample( positions ), UInt64ArraySample( ids ) ) );
+    }
+
+    // more meshes than are read ahead at once
+    OXform crowd( archive.getTop(), "crowd" );
+    crowd.getSchema().set( identity );
+    for ( std::size_t i = 0; i < kNumCrowd; ++i )
+    {
+        std::ostringstream name;
+        name << "agent" << i;
+        OPolyMesh agent( crowd, name.str(), frames );
+        writeQuad( agent, i );
+        writeQuad( agent, i + 0.5f );
+    }
+}
+
+//-*****************************************************************************
+bool hasLine( const AbcP::MockEmitter & iEmitter, const std::string & iLine )
+{
+    const std::vector< std::string > & log = iEmitter.getLog();
+    return std::find( log.begin(), log.end(), iLine ) != log.end();
+}
+
+//-*****************************************************************************
+void testThreadsMatch( IArchive & iArchive )
+{
+    AbcP::ExpandArgs args;
+    args.frame = 2.0;
+    args.shutterOpen = 0.0;
+    args.shutterClose = 0.5;
+
+    AbcP::MockEmitter serial( true );
+    AbcP::ExpandStats serialStats =
+        AbcP::Expand( iArchive.getTop(), args, serial );
+
+    args.numThreads = 4;
+    args.batchSize = 3;
+
+    AbcP::MockEmitter threaded( true );
+    AbcP::ExpandStats threadedStats =
+        AbcP::Expand( iArchive.getTop(), args, threaded );
+
+    // the same calls in the same order, however many threads
+    TESTING_ASSERT( serial.getLog() == threaded.getLog() );
+    TESTING_ASSERT( serial.getChecksum() == threaded.getChecksum() );
+    TESTING_ASSERT( serial.getBounds() == threaded.getBounds() );
+    TESTING_ASSERT( serialStats.numSamples == threadedStats.numSamples );
+
+    // world, box, subd, hidden, ghost, shown, mesh, other, hair, pts,
+    // crowd and the agents
+    TESTING_ASSERT( serialStats.numObjects == 11 + kNumCrowd );
+    TESTING_ASSERT( serial.getNumObjects() == 11 + kNumCrowd );
+    TESTING_ASSERT( serialStats.numXforms == 4 );
+    TESTING_ASSERT( serialStats.numPolyMeshes == 2 + kNumCrowd );
+    TESTING_ASSERT( serialStats.numSubDs == 1 );
+    TESTING_ASSERT( serialStats.numCurves == 1 );
+    TESTING_ASSERT( serialStats.numPoints == 1 );
+
+    // animated things are read at the shutter open and close
+    TESTING_ASSERT( hasLine( serial, "xform /world 2" ) );
+    TESTING_ASSERT( hasLine( serial, "polymesh /world/box 2" ) );
+    TESTING_ASSERT( hasLine( serial, "polymesh /crowd/agent3 1" ) );
+    TESTING_ASSERT( hasLine( serial, "subd /world/subd 1" ) );
+    TESTING_ASSERT( hasLine( serial, "points /pts 1" ) );
+    TESTING_ASSERT( hasLine( serial, "curves /hair 1" ) );
+
+    // hidden geometry begins and ends but isn't read
+    TESTING_ASSERT( hasLine( serial, "begin /world/hidden/ghost hidden" ) );
+    TESTING_ASSERT( !hasLine( serial,
+                              "polymesh /world/hidden/ghost 1 hidden" ) );
+    TESTING_ASSERT( hasLine( serial, "polymesh /world/hidden/shown/mesh 1" ) );
+
+    TESTING_ASSERT( hasLine( serial, "begin /world/other" ) );
+    TESTING_ASSERT( !hasLine( serial, "begin /world/other/unreached" ) );
+
+    // objects end before their siblings begin
+    const std::vector< std::string > & log = serial.getLog();
+    TESTING_ASSERT( log.front() == "begin /world" );
+    std::vector< std::string >::const_iterator boxEnd =
+        std::find( log.begin(), log.end(), "end /world/box" );
+    TESTING_ASSERT( boxEnd != log.end() );
+    TESTING_ASSERT( *( boxEnd + 1 ) == "begin /world/subd" );
+    TESTING_ASSERT( log.back() == "end /crowd" );
+
+    // the box at frame 2 is moved 2 along x by world, the points reach
+    // down to -2, the hair up to 3, and the last agent holds its last
+    // sample
+    Box3d bounds = serial.getBounds();
+    TESTING_ASSERT( bounds.min == V3d( -2.0 ) );
+    TESTING_ASSERT( bounds.max == V3d( 3.0, 3.0, kNumCrowd - 0.5 ) );
+}
+
+//-*****************************************************************************
+void testObjectPath( IArchive & iArchive )
+{
+    AbcP::ExpandArgs args;
+    args.objectpath = "/world/subd/top";
+
+    AbcP::MockEmitter emitter( true );
+    AbcP::Expand( iArchive.getTop(), args, emitter );
+
+    const std::vector< std::string > & log = emitter.getLog();
+    TESTING_ASSERT( log.size() == 6 );
+    TESTING_ASSERT( log[0] == "begin /world" );
+    TESTING_ASSERT( log[1] == "xform /world 1" );
+    TESTING_ASSERT( log[2] == "begin /world/subd faceset top" );
+    TESTING_ASSERT( log[3] == "subd /world/subd 1 faceset top" );
+    TESTING_ASSERT( log[4] == "end /world/subd faceset top" );
+    TESTING_ASSERT( log[5] == "end /world" );
+
+    args.objectpath = "crowd//agent7/";
+    AbcP::MockEmitter agent( true );
+    AbcP::Expand( iArchive.getTop(), args, agent );
+    TESTING_ASSERT( agent.getNumGeometry() == 1 );
+    TESTING_ASSERT( hasLine( agent, "polymesh /crowd/agent7 1" ) );
+
+    args.objectpath = "/nothing";
+    AbcP::MockEmitter nothing( true );
+    AbcP::Expand( iArchive.getTop(), args, nothing );
+    TESTING_ASSERT( nothing.getLog().empty() );
+}
+
+//-*****************************************************************************
+class UVEmitter : public AbcP::Emitter
+{
+public:
+    virtual void emitPolyMesh( const AbcP::ObjectInfo &iInfo,
+                               const AbcP::PolyMeshBuffer &iBuffer )
+    {
+        if ( iInfo.object.getName() == "box" )
+        {
+            uvs = iBuffer[0].uvs;
+            scope = iBuffer[0].uvScope;
+            numXforms = xforms;
+        }
+    }
+
+    virtual void emitXform( const AbcP::ObjectInfo &iInfo,
+                            const AbcP::XformBuffer &iBuffer )
+    {
+        ++xforms;
+    }
+
+    UVEmitter() : scope( kUnknownScope ), xforms( 0 ), numXforms( 0 ) {}
+
+    std::vector< V2f > uvs;
+    GeometryScope scope;
+    std::size_t xforms;
+    std::size_t numXforms;
+};
+
+//-*****************************************************************************
+void testArgs( IArchive & iArchive )
+{
+    AbcP::ExpandArgs args;
+    args.frame = 1.0;
+
+    UVEmitter plain;
+    AbcP::Expand( iArchive.getTop(), args, plain );
+    TESTING_ASSERT( plain.uvs.size() == 4 );
+    TESTING_ASSERT( plain.scope == kVertexScope );
+    TESTING_ASSERT( plain.uvs[2] == V2f( 1.0f, 0.25f ) );
+    TESTING_ASSERT( plain.numXforms == 1 );
+
+    args.flipv = true;
+    args.excludeXform = true;
+
+    UVEmitter flipped;
+    AbcP::Expand( iArchive.getTop(), args, flipped );
+    TESTING_ASSERT( flipped.uvs.size() == 4 );
+    TESTING_ASSERT( flipped.uvs[2] == V2f( 1.0f, 0.75f ) );
+    TESTING_ASSERT( flipped.xforms == 0 );
+}
+
+//-*****************************************************************************
+class ThrowingEmitter : public AbcP::Emitter
+{
+public:
+    virtual void emitPoints( const AbcP::ObjectInfo &iInfo,
+                             const AbcP::PointsBuffer &iBuffer )
+    {
+        ABCA_THROW( "no points please" );
+    }
+};
+
+//-*****************************************************************************
+void testErrors( IArchive & iArchive )
+{
+    AbcP::ExpandArgs args;
+    args.numThreads = 3;
+
+    ThrowingEmitter emitter;
+    TESTING_ASSERT_THROW( AbcP::Expand( iArchive.getTop(), args, emitter ),
+                          Alembic::Util::Exception );
+
+    // the reads left queued are dropped, and the threads are free for the
+    // next expansion
+    AbcP::MockEmitter after;
+    AbcP::Expand( iArchive.getTop(), args, after );
+    TESTING_ASSERT( after.getNumObjects() == 11 + kNumCrowd );
+
+    TESTING_ASSERT_THROW( AbcP::Expand( IObject(), args, emitter ),
+                          Alembic::Util::Exception );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    std::string name = "expand.abc";
+    writeArchive( name );
+
+    IArchive archive( Alembic::AbcCoreOgawa::ReadArchive(), name );
+    testThreadsMatch( archive );
+    testObjectPath( archive );
+    testArgs( archive );
+    testErrors( archive );
+
+    return 0;
+}
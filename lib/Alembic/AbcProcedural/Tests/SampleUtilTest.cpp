@@ -0,0 +1,185 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+#include <Alembic/AbcProcedural/All.h>
+
+#include <Alembic/AbcCoreAbstract/Tests/Assert.h>
+
+namespace AbcA = Alembic::AbcCoreAbstract;
+namespace AbcP = Alembic::AbcProcedural;
+
+using AbcA::chrono_t;
+using Alembic::Abc::M44d;
+using Alembic::Abc::V3d;
+
+//-*****************************************************************************
+bool matricesMatch( const M44d & iA, const M44d & iB )
+{
+    return iA.equalWithAbsError( iB, 1e-6 );
+}
+
+//-*****************************************************************************
+void testSampleTimes()
+{
+    AbcA::TimeSamplingPtr frames( new AbcA::TimeSampling( 1.0 / 24.0, 0.0 ) );
+
+    AbcP::ExpandArgs args;
+    args.frame = 3.0;
+    args.fps = 24.0;
+
+    // too few samples to move are read at 0
+    AbcP::SampleTimeSet times;
+    AbcP::GetRelevantSampleTimes( args, frames, 1, times );
+    TESTING_ASSERT( times.size() == 1 && *times.begin() == 0.0 );
+
+    // no shutter, the frame on its own
+    times.clear();
+    AbcP::GetRelevantSampleTimes( args, frames, 10, times );
+    TESTING_ASSERT( times.size() == 1 );
+    TESTING_ASSERT( fabs( *times.begin() - 3.0 / 24.0 ) < 1e-9 );
+
+    // a shutter around the frame takes the samples either side too
+    args.shutterOpen = -0.25;
+    args.shutterClose = 0.25;
+    times.clear();
+    AbcP::GetRelevantSampleTimes( args, frames, 10, times );
+    TESTING_ASSERT( times.size() == 3 );
+    TESTING_ASSERT( fabs( *times.begin() - 2.0 / 24.0 ) < 1e-9 );
+    TESTING_ASSERT( fabs( *times.rbegin() - 4.0 / 24.0 ) < 1e-9 );
+
+    // and from the frame to the next one
+    args.shutterOpen = 0.0;
+    args.shutterClose = 1.0;
+    times.clear();
+    AbcP::GetRelevantSampleTimes( args, frames, 10, times );
+    TESTING_ASSERT( times.size() == 2 );
+
+    // times of the transform above widen the range
+    AbcP::MatrixSampleMap inherited;
+    inherited[1.0 / 24.0] = M44d();
+    inherited[5.0 / 24.0] = M44d();
+    times.clear();
+    AbcP::GetRelevantSampleTimes( args, frames, 10, times, &inherited );
+    TESTING_ASSERT( times.size() == 5 );
+
+    TESTING_ASSERT( fabs( AbcP::GetRelativeSampleTime( args, 4.0 / 24.0 ) - 1.0 )
+                    < 1e-9 );
+    TESTING_ASSERT( AbcP::GetRelativeSampleTime( args,
+                                                 3.0 / 24.0 + 1e-7 ) == 0.0 );
+}
+
+//-*****************************************************************************
+void testInterpolate()
+{
+    AbcP::MatrixSampleMap samples;
+    TESTING_ASSERT( AbcP::InterpolateXformSamples( samples, 1.0 ) == M44d() );
+
+    M44d a;
+    a.setTranslation( V3d( 0.0, 0.0, 0.0 ) );
+    M44d b;
+    b.setTranslation( V3d( 2.0, 0.0, 4.0 ) );
+    M44d c;
+    c.setTranslation( V3d( 2.0, 8.0, 4.0 ) );
+
+    samples[0.0] = a;
+    samples[1.0] = b;
+    samples[2.0] = c;
+
+    // held before and after, exact on samples
+    TESTING_ASSERT( AbcP::InterpolateXformSamples( samples, -1.0 ) == a );
+    TESTING_ASSERT( AbcP::InterpolateXformSamples( samples, 3.0 ) == c );
+    TESTING_ASSERT( AbcP::InterpolateXformSamples( samples, 1.0 ) == b );
+
+    // between the samples either side
+    M44d half;
+    half.setTranslation( V3d( 1.0, 0.0, 2.0 ) );
+    TESTING_ASSERT( matricesMatch( AbcP::InterpolateXformSamples( samples, 0.5 ),
+                          half ) );
+
+    half.setTranslation( V3d( 2.0, 2.0, 4.0 ) );
+    TESTING_ASSERT( matricesMatch( AbcP::InterpolateXformSamples( samples, 1.25 ),
+                          half ) );
+
+    // rotations are slerped, not lerped
+    AbcP::MatrixSampleMap rotations;
+    M44d quarter;
+    quarter.setAxisAngle( V3d( 0.0, 1.0, 0.0 ), M_PI / 2.0 );
+    rotations[0.0] = M44d();
+    rotations[1.0] = quarter;
+
+    M44d eighth;
+    eighth.setAxisAngle( V3d( 0.0, 1.0, 0.0 ), M_PI / 4.0 );
+    TESTING_ASSERT( matricesMatch( AbcP::InterpolateXformSamples( rotations, 0.5 ),
+                          eighth ) );
+}
+
+//-*****************************************************************************
+void testConcatenate()
+{
+    M44d parentA;
+    parentA.setTranslation( V3d( 1.0, 0.0, 0.0 ) );
+    M44d parentB;
+    parentB.setTranslation( V3d( 3.0, 0.0, 0.0 ) );
+
+    AbcP::MatrixSampleMap parent;
+    parent[0.0] = parentA;
+    parent[1.0] = parentB;
+
+    M44d scale;
+    scale.setScale( V3d( 2.0 ) );
+
+    AbcP::MatrixSampleMap local;
+    local[0.5] = scale;
+
+    AbcP::MatrixSampleMap world;
+    AbcP::ConcatenateXformSamples( parent, local, world );
+    TESTING_ASSERT( world.size() == 3 );
+
+    // the parent is interpolated to the local time
+    M44d expected;
+    expected.setTranslation( V3d( 2.0, 0.0, 0.0 ) );
+    TESTING_ASSERT( matricesMatch( world[0.5], scale * expected ) );
+    TESTING_ASSERT( matricesMatch( world[1.0], scale * parentB ) );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    testSampleTimes();
+    testInterpolate();
+    testConcatenate();
+    return 0;
+}
@@ -39,8 +39,9 @@ namespace Alembic {
 namespace Ogawa {
 namespace ALEMBIC_VERSION_NS {
 
-IArchive::IArchive(const std::string & iFileName, std::size_t iNumStreams) :
-    mStreams(new IStreams(iFileName, iNumStreams))
+IArchive::IArchive(const std::string & iFileName, std::size_t iNumStreams,
+                   std::size_t iMaxStreams) :
+    mStreams(new IStreams(iFileName, iNumStreams, iMaxStreams))
 {
     init();
 }
@@ -85,6 +86,31 @@ IGroupPtr IArchive::getGroup() const
     return mGroup;
 }
 
+std::size_t IArchive::getNumStreams() const
+{
+    return mStreams->getNumStreams();
+}
+
+bool IArchive::addStream()
+{
+    return mStreams->addStream();
+}
+
+void IArchive::setStatsEnabled(bool iEnabled)
+{
+    mStreams->setStatsEnabled(iEnabled);
+}
+
+void IArchive::getStats(std::vector< IStreams::Stats > & oStats) const
+{
+    mStreams->getStats(oStats);
+}
+
+void IArchive::resetStats()
+{
+    mStreams->resetStats();
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace Ogawa
 } // End namespace Alembic
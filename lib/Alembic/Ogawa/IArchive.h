@@ -49,7 +49,9 @@ namespace ALEMBIC_VERSION_NS {
 class IArchive
 {
 public:
-    IArchive(const std::string & iFileName, std::size_t iNumStreams=1);
+    // iMaxStreams leaves room to open more streams later, see IStreams
+    IArchive(const std::string & iFileName, std::size_t iNumStreams=1,
+             std::size_t iMaxStreams=0);
     IArchive(const std::vector< std::istream * > & iStreams);
     ~IArchive();
 
@@ -61,6 +63,16 @@ public:
 
     IGroupPtr getGroup() const;
 
+    std::size_t getNumStreams() const;
+
+    // opens another stream, see IStreams::addStream
+    bool addStream();
+
+    // optional per stream read statistics, see IStreams
+    void setStatsEnabled(bool iEnabled);
+    void getStats(std::vector< IStreams::Stats > & oStats) const;
+    void resetStats();
+
 private:
     void init();
     IStreamsPtr mStreams;
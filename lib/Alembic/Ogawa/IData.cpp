@@ -59,6 +59,13 @@ public:
     Alembic::Util::uint64_t size;
 };
 
+IData::IData() :
+    mData(new IData::PrivateData(IStreamsPtr()))
+{
+    mData->pos = 0;
+    mData->size = 0;
+}
+
 IData::~IData()
 {
 
@@ -69,6 +76,19 @@ IData::IData(IStreamsPtr iStreams,
              std::size_t iThreadId) :
     mData(new IData::PrivateData(iStreams))
 {
+    reset(iStreams, iPos, iThreadId);
+}
+
+void IData::reset(const IStreamsPtr & iStreams,
+                  Alembic::Util::uint64_t iPos,
+                  std::size_t iThreadId)
+{
+    // only touch the reference count when we are pointed at another archive
+    if (mData->streams != iStreams)
+    {
+        mData->streams = iStreams;
+    }
+
     mData->size = 0;
 
     // strip off the top bit (indicates data) to get our seek position
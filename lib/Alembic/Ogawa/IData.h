@@ -47,6 +47,10 @@ class IData
 {
 public:
 
+    // an empty data, which IGroup::getData can later point at a child, so
+    // that one IData can be reused for many reads
+    IData();
+
     ~IData();
 
     void read(Alembic::Util::uint64_t iSize, void * iData,
@@ -63,6 +67,13 @@ private:
     IData(IStreamsPtr iStreams, Alembic::Util::uint64_t iPos,
           std::size_t iThreadId);
 
+    // noncopyable
+    IData(const IData &);
+    const IData & operator=(const IData &);
+
+    void reset(const IStreamsPtr & iStreams, Alembic::Util::uint64_t iPos,
+               std::size_t iThreadId);
+
     class PrivateData;
     std::auto_ptr< PrivateData > mData;
 };
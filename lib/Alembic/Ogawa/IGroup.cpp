@@ -149,6 +149,35 @@ IDataPtr IGroup::getData(Alembic::Util::uint64_t iIndex,
     return child;
 }
 
+bool IGroup::getData(Alembic::Util::uint64_t iIndex,
+                     std::size_t iThreadIndex,
+                     IData & oData)
+{
+    Alembic::Util::uint64_t childPos = 0;
+    if (isLight())
+    {
+        if (iIndex < mData->numChildren)
+        {
+            mData->streams->read(iThreadIndex, mData->pos + 8 * iIndex + 8, 8,
+                                 &childPos);
+        }
+    }
+    else if (isChildData(iIndex))
+    {
+        childPos = mData->childVec[iIndex];
+    }
+
+    // top bit should be set for data
+    if ((childPos & EMPTY_DATA) == 0)
+    {
+        oData.reset(mData->streams, 0, iThreadIndex);
+        return false;
+    }
+
+    oData.reset(mData->streams, childPos, iThreadIndex);
+    return true;
+}
+
 Alembic::Util::uint64_t IGroup::getNumChildren() const
 {
     return mData->numChildren;
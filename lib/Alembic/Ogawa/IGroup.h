@@ -57,6 +57,11 @@ public:
 
     IDataPtr getData(Alembic::Util::uint64_t iIndex, std::size_t iThreadIndex);
 
+    // points oData at the child data instead of allocating a new IData,
+    // returns false (and empties oData) if the child isn't data
+    bool getData(Alembic::Util::uint64_t iIndex, std::size_t iThreadIndex,
+                 IData & oData);
+
     Alembic::Util::uint64_t getNumChildren() const;
 
     bool isChildGroup(Alembic::Util::uint64_t iIndex) const;
@@ -34,6 +34,7 @@
 //-*****************************************************************************
 
 #include <Alembic/Ogawa/IStreams.h>
+#include <Alembic/Util/Timer.h>
 #include <fstream>
 #include <stdexcept>
 
@@ -41,6 +42,42 @@ namespace Alembic {
 namespace Ogawa {
 namespace ALEMBIC_VERSION_NS {
 
+// the granularity the seek statistics model reads from disk at
+static const Alembic::Util::uint64_t STATS_PAGE_SIZE = 4096;
+
+// addStream stores the number of streams with release semantics once the new
+// stream is in place, and readers load it with acquire semantics, so any
+// reader which sees the stream counted also sees it opened
+static std::size_t LoadAcquire(const std::size_t & iValue)
+{
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || \
+    (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+    return __atomic_load_n(&iValue, __ATOMIC_ACQUIRE);
+#elif defined(__GNUC__)
+    std::size_t value = *(const volatile std::size_t *)(&iValue);
+    __sync_synchronize();
+    return value;
+#else
+    std::size_t value = *(const volatile std::size_t *)(&iValue);
+    MemoryBarrier();
+    return value;
+#endif
+}
+
+static void StoreRelease(std::size_t & oValue, std::size_t iValue)
+{
+#if defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || \
+    (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+    __atomic_store_n(&oValue, iValue, __ATOMIC_RELEASE);
+#elif defined(__GNUC__)
+    __sync_synchronize();
+    *(volatile std::size_t *)(&oValue) = iValue;
+#else
+    MemoryBarrier();
+    *(volatile std::size_t *)(&oValue) = iValue;
+#endif
+}
+
 class IStreams::PrivateData
 {
 public:
@@ -49,7 +86,9 @@ public:
         locks = NULL;
         valid = false;
         frozen = false;
+        statsEnabled = false;
         version = 0;
+        numStreams = 0;
     }
 
     ~PrivateData()
@@ -82,9 +121,26 @@ public:
     bool valid;
     bool frozen;
     Alembic::Util::uint16_t version;
+
+    // guarded by the matching entry in locks
+    std::vector<IStreams::Stats> stats;
+
+    // a bit per page of the file for each stream, set once the stream has
+    // read the page since the stats were reset, only allocated once the
+    // stream is read with stats on
+    std::vector< std::vector<Alembic::Util::uint64_t> > pages;
+    volatile bool statsEnabled;
+
+    // streams, offsets, locks and stats are all sized up front for the most
+    // streams we'll ever open, so that addStream never moves them out from
+    // under a reader, this is how many of them are actually in use, see
+    // LoadAcquire and StoreRelease
+    std::size_t numStreams;
+    Alembic::Util::mutex addLock;
 };
 
-IStreams::IStreams(const std::string & iFileName, std::size_t iNumStreams) :
+IStreams::IStreams(const std::string & iFileName, std::size_t iNumStreams,
+                   std::size_t iMaxStreams) :
     mData(new IStreams::PrivateData())
 {
 
@@ -120,7 +176,20 @@ IStreams::IStreams(const std::string & iFileName, std::size_t iNumStreams) :
             mData->offsets.push_back(mData->streams[i]->tellg());
         }
     }
-    mData->locks = new Alembic::Util::mutex[mData->streams.size()];
+
+    mData->numStreams = mData->streams.size();
+
+    std::size_t maxStreams = mData->numStreams;
+    if (maxStreams > 0 && iMaxStreams > maxStreams)
+    {
+        maxStreams = iMaxStreams;
+    }
+
+    mData->streams.resize(maxStreams, NULL);
+    mData->offsets.resize(maxStreams, 0);
+    mData->locks = new Alembic::Util::mutex[maxStreams];
+    mData->stats.resize(maxStreams);
+    mData->pages.resize(maxStreams);
 }
 
 IStreams::IStreams(const std::vector< std::istream * > & iStreams) :
@@ -134,7 +203,10 @@ IStreams::IStreams(const std::vector< std::istream * > & iStreams) :
         return;
     }
 
+    mData->numStreams = mData->streams.size();
     mData->locks = new Alembic::Util::mutex[mData->streams.size()];
+    mData->stats.resize(mData->streams.size());
+    mData->pages.resize(mData->streams.size());
 }
 
 void IStreams::init()
@@ -216,6 +288,43 @@ Alembic::Util::uint16_t IStreams::getVersion()
     return mData->version;
 }
 
+std::size_t IStreams::getNumStreams()
+{
+    return LoadAcquire(mData->numStreams);
+}
+
+bool IStreams::addStream()
+{
+    // we don't own the streams, so we can't make any more
+    if (mData->fileName.empty())
+    {
+        return false;
+    }
+
+    Alembic::Util::scoped_lock l(mData->addLock);
+
+    std::size_t i = mData->numStreams;
+    if (i >= mData->streams.size())
+    {
+        return false;
+    }
+
+    std::ifstream * filestream = new std::ifstream;
+    filestream->open(mData->fileName.c_str(), std::ios::binary);
+    if (!filestream->is_open())
+    {
+        delete filestream;
+        return false;
+    }
+
+    mData->streams[i] = filestream;
+    mData->offsets[i] = filestream->tellg();
+
+    // only now can anyone read from it
+    StoreRelease(mData->numStreams, i + 1);
+    return true;
+}
+
 void IStreams::read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
                     Alembic::Util::uint64_t iSize, void * oBuf)
 {
@@ -225,11 +334,69 @@ void IStreams::read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
     }
 
     std::size_t threadId = 0;
-    if (iThreadId < mData->streams.size())
+    if (iThreadId < LoadAcquire(mData->numStreams))
     {
         threadId = iThreadId;
     }
 
+    if (mData->statsEnabled)
+    {
+        Alembic::Util::Timer waitTimer;
+        Alembic::Util::scoped_lock l(mData->locks[threadId]);
+
+        Stats & stats = mData->stats[threadId];
+        stats.lockWaitTime += waitTimer.elapsed();
+        stats.numReads ++;
+        stats.bytesRead += iSize;
+
+        // model a cold cache, each page is fetched once, and fetching one
+        // which doesn't follow the last one fetched is a seek
+        std::istream * stream = mData->streams[threadId];
+        std::vector<Alembic::Util::uint64_t> & pages = mData->pages[threadId];
+        if (pages.empty())
+        {
+            stream->seekg(0, std::ios_base::end);
+            std::streamoff end = stream->tellg();
+            Alembic::Util::uint64_t fileSize = 0;
+            if (end > (std::streamoff)mData->offsets[threadId])
+            {
+                fileSize = end - mData->offsets[threadId];
+            }
+            pages.resize(fileSize / (STATS_PAGE_SIZE * 64) + 1, 0);
+        }
+
+        Alembic::Util::uint64_t lastPage = (iPos + iSize - 1) / STATS_PAGE_SIZE;
+        for (Alembic::Util::uint64_t page = iPos / STATS_PAGE_SIZE;
+             iSize > 0 && page <= lastPage; ++page)
+        {
+            // pages past the end of the file, which the read will fail on,
+            // aren't remembered
+            if (page / 64 < pages.size())
+            {
+                Alembic::Util::uint64_t mask = (Alembic::Util::uint64_t)1 <<
+                    (page % 64);
+                Alembic::Util::uint64_t & word = pages[page / 64];
+                if (word & mask)
+                {
+                    continue;
+                }
+                word |= mask;
+            }
+
+            if (page != stats.nextPage)
+            {
+                stats.numSeeks ++;
+                stats.seekDistance += STATS_PAGE_SIZE * (page < stats.nextPage ?
+                    stats.nextPage - page : page - stats.nextPage);
+            }
+            stats.nextPage = page + 1;
+        }
+
+        stream->seekg(iPos + mData->offsets[threadId]);
+        stream->read((char *)oBuf, iSize);
+        return;
+    }
+
     {
         Alembic::Util::scoped_lock l(mData->locks[threadId]);
         mData->streams[threadId]->seekg(iPos + mData->offsets[threadId]);
@@ -237,6 +404,37 @@ void IStreams::read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
     }
 }
 
+void IStreams::setStatsEnabled(bool iEnabled)
+{
+    mData->statsEnabled = iEnabled;
+}
+
+bool IStreams::isStatsEnabled()
+{
+    return mData->statsEnabled;
+}
+
+void IStreams::getStats(std::vector< Stats > & oStats)
+{
+    std::size_t numStreams = LoadAcquire(mData->numStreams);
+    oStats.resize(numStreams);
+    for (std::size_t i = 0; i < numStreams; ++i)
+    {
+        Alembic::Util::scoped_lock l(mData->locks[i]);
+        oStats[i] = mData->stats[i];
+    }
+}
+
+void IStreams::resetStats()
+{
+    for (std::size_t i = 0; i < mData->stats.size(); ++i)
+    {
+        Alembic::Util::scoped_lock l(mData->locks[i]);
+        mData->stats[i] = Stats();
+        std::vector<Alembic::Util::uint64_t>().swap(mData->pages[i]);
+    }
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace Ogawa
 } // End namespace Alembic
@@ -47,7 +47,11 @@ namespace ALEMBIC_VERSION_NS {
 class IStreams
 {
 public:
-    IStreams(const std::string & iFileName, std::size_t iNumStreams=1);
+    // opens the file iNumStreams times, and leaves room for addStream to open
+    // it up to iMaxStreams times (iMaxStreams less than iNumStreams means no
+    // room to grow)
+    IStreams(const std::string & iFileName, std::size_t iNumStreams=1,
+             std::size_t iMaxStreams=0);
     IStreams(const std::vector< std::istream * > & iStreams);
     ~IStreams();
 
@@ -55,10 +59,46 @@ public:
     bool isFrozen();
     Alembic::Util::uint16_t getVersion();
 
+    std::size_t getNumStreams();
+
+    // opens the file once more, it is safe to call this while other threads
+    // are reading from the existing streams.  The new stream gets the next
+    // id, returns false if that isn't possible because we were given the
+    // streams or because there is no more room.
+    bool addStream();
+
     // locks on the threadId, seeks to iPos, and reads iSize bytes into oBuf
     void read(std::size_t iThreadId, Alembic::Util::uint64_t iPos,
               Alembic::Util::uint64_t iSize, void * oBuf);
 
+    // per stream counters, only gathered while stats are enabled
+    struct Stats
+    {
+        Stats() : numReads(0), bytesRead(0), lockWaitTime(0.0), numSeeks(0),
+            seekDistance(0), nextPage(0) {}
+
+        Alembic::Util::uint64_t numReads;
+        Alembic::Util::uint64_t bytesRead;
+
+        // seconds spent waiting to acquire the stream lock
+        double lockWaitTime;
+
+        // pages read for the first time which didn't follow the previous
+        // page read for the first time, and how many bytes those jumped
+        Alembic::Util::uint64_t numSeeks;
+        Alembic::Util::uint64_t seekDistance;
+
+        // the page after the last one read for the first time
+        Alembic::Util::uint64_t nextPage;
+    };
+
+    void setStatsEnabled(bool iEnabled);
+    bool isStatsEnabled();
+
+    // fills oStats with one entry per stream
+    void getStats(std::vector< Stats > & oStats);
+    void resetStats();
+
 private:
     // noncopyable
     IStreams(const IStreams &);
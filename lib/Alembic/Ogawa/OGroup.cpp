@@ -61,6 +61,10 @@ public:
 
     // set after freeze
     Alembic::Util::uint64_t pos;
+
+    // guards the above, since different threads may be adding children to
+    // different groups while those groups are being frozen
+    Alembic::Util::mutex lock;
 };
 
 OGroup::OGroup(OGroupPtr iParent, Alembic::Util::uint64_t iIndex)
@@ -87,38 +91,25 @@ OGroup::~OGroup()
 OGroupPtr OGroup::addGroup()
 {
     OGroupPtr child;
-    if (!isFrozen())
+    Alembic::Util::uint64_t index = 0;
     {
+        Alembic::Util::scoped_lock l(mData->lock);
+        if (mData->pos != INVALID_GROUP)
+        {
+            return child;
+        }
+
         mData->childVec.push_back(0);
-        child.reset(new OGroup(shared_from_this(), mData->childVec.size() - 1));
+        index = mData->childVec.size() - 1;
     }
+
+    child.reset(new OGroup(shared_from_this(), index));
     return child;
 }
 
 ODataPtr OGroup::createData(Alembic::Util::uint64_t iSize, const void * iData)
 {
-    ODataPtr child;
-    if (isFrozen())
-    {
-        return child;
-    }
-
-    if (iSize == 0)
-    {
-        mData->childVec.push_back(EMPTY_DATA);
-        child.reset(new OData());
-        return child;
-    }
-
-    Alembic::Util::uint64_t pos = mData->stream->getAndSeekEndPos();
-
-    Alembic::Util::uint64_t size = iSize;
-    mData->stream->write(&size, 8);
-    mData->stream->write(iData, iSize);
-
-    child.reset(new OData(mData->stream, pos, iSize));
-
-    return child;
+    return createData(1, &iSize, &iData);
 }
 
 ODataPtr OGroup::addData(Alembic::Util::uint64_t iSize, const void * iData)
@@ -128,7 +119,7 @@ ODataPtr OGroup::addData(Alembic::Util::uint64_t iSize, const void * iData)
     {
         // flip top bit for data so we can easily distinguish between it and
         // a group
-        mData->childVec.push_back(child->getPos() | 0x8000000000000000ULL);
+        addChild(child->getPos() | 0x8000000000000000ULL);
     }
     return child;
 }
@@ -151,23 +142,24 @@ ODataPtr OGroup::createData(Alembic::Util::uint64_t iNumData,
 
     if (totalSize == 0)
     {
-        mData->childVec.push_back(EMPTY_DATA);
+        addChild(EMPTY_DATA);
         child.reset(new OData());
         return child;
     }
 
-    Alembic::Util::uint64_t pos = mData->stream->getAndSeekEndPos();
-
-    mData->stream->write(&totalSize, 8);
+    // the size goes in front of the data, and all of it is written in one
+    // go so that other threads writing to the stream can't get in between
+    std::vector<Alembic::Util::uint64_t> sizes(iNumData + 1, 8);
+    std::vector<const void *> datas(iNumData + 1, &totalSize);
     for (Alembic::Util::uint64_t i = 0; i < iNumData; ++i)
     {
-        Alembic::Util::uint64_t size = iSizes[i];
-        if (size != 0)
-        {
-            mData->stream->write(iDatas[i], size);
-        }
+        sizes[i + 1] = iSizes[i];
+        datas[i + 1] = iDatas[i];
     }
 
+    Alembic::Util::uint64_t pos = mData->stream->append(sizes.size(),
+        &sizes.front(), &datas.front());
+
     child.reset(new OData(mData->stream, pos, totalSize));
 
     return child;
@@ -182,144 +174,161 @@ ODataPtr OGroup::addData(Alembic::Util::uint64_t iNumData,
     {
         // flip top bit for data so we can easily distinguish between it and
         // a group
-        mData->childVec.push_back(child->getPos() | 0x8000000000000000ULL);
+        addChild(child->getPos() | 0x8000000000000000ULL);
     }
     return child;
 }
 
 void OGroup::addData(ODataPtr iData)
 {
-    if (!isFrozen())
-    {
-        mData->childVec.push_back(iData->getPos() | 0x8000000000000000ULL);
-    }
+    addChild(iData->getPos() | 0x8000000000000000ULL);
 }
 
 void OGroup::addGroup(OGroupPtr iGroup)
 {
-    if (!isFrozen())
+    Alembic::Util::scoped_lock l(mData->lock);
+    if (mData->pos != INVALID_GROUP)
     {
-        if (iGroup->isFrozen())
-        {
-            mData->childVec.push_back(iGroup->mData->pos);
-        }
-        else
-        {
-            mData->childVec.push_back(EMPTY_GROUP);
-            iGroup->mData->parents.push_back(
-                ParentPair(shared_from_this(), mData->childVec.size() - 1));
-        }
+        return;
     }
-}
 
-void OGroup::addEmptyGroup()
-{
-    if (!isFrozen())
+    // the child is locked after the parent, freeze never holds both
+    Alembic::Util::scoped_lock cl(iGroup->mData->lock);
+    if (iGroup->mData->pos != INVALID_GROUP)
+    {
+        mData->childVec.push_back(iGroup->mData->pos);
+    }
+    else
     {
         mData->childVec.push_back(EMPTY_GROUP);
+        iGroup->mData->parents.push_back(
+            ParentPair(shared_from_this(), mData->childVec.size() - 1));
     }
 }
 
+void OGroup::addEmptyGroup()
+{
+    addChild(EMPTY_GROUP);
+}
+
 void OGroup::addEmptyData()
 {
-    if (!isFrozen())
+    addChild(EMPTY_DATA);
+}
+
+void OGroup::addChild(Alembic::Util::uint64_t iChild)
+{
+    Alembic::Util::scoped_lock l(mData->lock);
+    if (mData->pos == INVALID_GROUP)
     {
-        mData->childVec.push_back(EMPTY_DATA);
+        mData->childVec.push_back(iChild);
     }
 }
 
 // no more children can be added, commit to the stream
 void OGroup::freeze()
 {
-    // bail if we've already done this work
-    if (isFrozen())
-    {
-        return;
-    }
+    ParentPairVec parents;
+    Alembic::Util::uint64_t pos = 0;
 
-    // we ended up not adding any children, so no need to commit this group
-    // to disk, use empty group instead
-    if (mData->childVec.empty())
-    {
-        mData->pos = 0;
-    }
-    else
     {
-        mData->pos = mData->stream->getAndSeekEndPos();
-        Alembic::Util::uint64_t size = mData->childVec.size();
-        mData->stream->write(&size, 8);
-        mData->stream->write(&mData->childVec.front(), size*8);
+        Alembic::Util::scoped_lock l(mData->lock);
+
+        // bail if we've already done this work
+        if (mData->pos != INVALID_GROUP)
+        {
+            return;
+        }
+
+        // we ended up not adding any children, so no need to commit this
+        // group to disk, use empty group instead
+        if (!mData->childVec.empty())
+        {
+            Alembic::Util::uint64_t size = mData->childVec.size();
+            Alembic::Util::uint64_t sizes[2] = { 8, size * 8 };
+            const void * datas[2] = { &size, &mData->childVec.front() };
+            pos = mData->stream->append(2, sizes, datas);
+        }
+
+        mData->pos = pos;
+        parents.swap(mData->parents);
     }
 
     // go through and update each of the parents
     ParentPairVec::iterator it;
-    for(it = mData->parents.begin(); it != mData->parents.end(); ++it)
+    for(it = parents.begin(); it != parents.end(); ++it)
     {
         // special group owned by the archive
         if (!it->first && it->second == 0)
         {
-            mData->stream->seek(8);
-            mData->stream->write(&mData->pos, 8);
+            mData->stream->writeAt(8, &pos, 8);
             continue;
         }
-        else if (it->first->isFrozen())
+
+        PrivateData * parent = it->first->mData.get();
+        Alembic::Util::scoped_lock l(parent->lock);
+        if (parent->pos != INVALID_GROUP)
         {
-            mData->stream->seek(it->first->mData->pos + (it->second + 1) * 8);
-            mData->stream->write(&mData->pos, 8);
+            mData->stream->writeAt(parent->pos + (it->second + 1) * 8,
+                                   &pos, 8);
         }
-        it->first->mData->childVec[it->second] = mData->pos;
+        parent->childVec[it->second] = pos;
     }
-
-    mData->parents.clear();
-
 }
 
 bool OGroup::isFrozen()
 {
+    Alembic::Util::scoped_lock l(mData->lock);
     return mData->pos != INVALID_GROUP;
 }
 
 Alembic::Util::uint64_t OGroup::getNumChildren() const
 {
+    Alembic::Util::scoped_lock l(mData->lock);
     return mData->childVec.size();
 }
 
 bool OGroup::isChildGroup(Alembic::Util::uint64_t iIndex) const
 {
+    Alembic::Util::scoped_lock l(mData->lock);
     return (iIndex < mData->childVec.size() &&
             (mData->childVec[iIndex] & EMPTY_DATA) == 0);
 }
 
 bool OGroup::isChildData(Alembic::Util::uint64_t iIndex) const
 {
+    Alembic::Util::scoped_lock l(mData->lock);
     return (iIndex < mData->childVec.size() &&
             (mData->childVec[iIndex] & EMPTY_DATA) != 0);
 }
 
 bool OGroup::isChildEmptyGroup(Alembic::Util::uint64_t iIndex) const
 {
+    Alembic::Util::scoped_lock l(mData->lock);
     return (iIndex < mData->childVec.size() &&
             mData->childVec[iIndex] == EMPTY_GROUP);
 }
 
 bool OGroup::isChildEmptyData(Alembic::Util::uint64_t iIndex) const
 {
+    Alembic::Util::scoped_lock l(mData->lock);
     return (iIndex < mData->childVec.size() &&
         mData->childVec[iIndex] == EMPTY_DATA);
 }
 
 void OGroup::replaceData(Alembic::Util::uint64_t iIndex, ODataPtr iData)
 {
-    if (!isChildData(iIndex))
+    Alembic::Util::scoped_lock l(mData->lock);
+    if (iIndex >= mData->childVec.size() ||
+        (mData->childVec[iIndex] & EMPTY_DATA) == 0)
     {
         return;
     }
 
     Alembic::Util::uint64_t pos = iData->getPos() | 0x8000000000000000ULL;
-    if (isFrozen())
+    if (mData->pos != INVALID_GROUP)
     {
-        mData->stream->seek(mData->pos + (iIndex + 1) * 8);
-        mData->stream->write(&pos, 8);
+        mData->stream->writeAt(mData->pos + (iIndex + 1) * 8, &pos, 8);
     }
     mData->childVec[iIndex] = pos;
 }
@@ -47,6 +47,9 @@ namespace ALEMBIC_VERSION_NS {
 class OGroup;
 typedef Alembic::Util::shared_ptr< OGroup > OGroupPtr;
 
+// Different threads may add children to, and freeze, different groups of the
+// same archive at the same time.  The data of each child is written to the
+// stream in one piece, so it never interleaves with another thread's.
 class OGroup : public Alembic::Util::enable_shared_from_this< OGroup >
 {
 public:
@@ -122,6 +125,9 @@ private:
 
     OGroup(OGroupPtr iParent, Alembic::Util::uint64_t iIndex);
 
+    // adds a child position, unless we are frozen
+    void addChild(Alembic::Util::uint64_t iChild);
+
     class PrivateData;
     Alembic::Util::auto_ptr< PrivateData > mData;
 };
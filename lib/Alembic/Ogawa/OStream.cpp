@@ -188,6 +188,47 @@ void OStream::write(const void * iBuf, Alembic::Util::uint64_t iSize)
     }
 }
 
+Alembic::Util::uint64_t OStream::append(std::size_t iNumData,
+                                        const Alembic::Util::uint64_t * iSizes,
+                                        const void ** iDatas)
+{
+    if (!isValid())
+    {
+        return 0;
+    }
+
+    Alembic::Util::scoped_lock l(mData->lock);
+    Alembic::Util::uint64_t lastp =
+        mData->stream->seekp(0, std::ios_base::end).tellp();
+    if (lastp == INVALID_DATA || lastp < mData->startPos)
+    {
+        throw std::runtime_error(
+            "Illegal position returned Ogawa::OStream::append");
+    }
+
+    for (std::size_t i = 0; i < iNumData; ++i)
+    {
+        if (iSizes[i] != 0)
+        {
+            mData->stream->write((const char *)iDatas[i], iSizes[i]);
+        }
+    }
+    mData->stream->flush();
+
+    return lastp - mData->startPos;
+}
+
+void OStream::writeAt(Alembic::Util::uint64_t iPos, const void * iBuf,
+                      Alembic::Util::uint64_t iSize)
+{
+    if (isValid())
+    {
+        Alembic::Util::scoped_lock l(mData->lock);
+        mData->stream->seekp(iPos + mData->startPos);
+        mData->stream->write((const char *)iBuf, iSize).flush();
+    }
+}
+
 } // End namespace ALEMBIC_VERSION_NS
 } // End namespace Ogawa
 } // End namespace Alembic
@@ -57,6 +57,17 @@ public:
     void write(const void * iBuf, Alembic::Util::uint64_t iSize);
     void seek(Alembic::Util::uint64_t iPos);
 
+    // writes the buffers back to back at the end of the stream and returns
+    // where the first one starts, nothing else can write in between so
+    // this is safe to call from multiple threads
+    Alembic::Util::uint64_t append(std::size_t iNumData,
+                                   const Alembic::Util::uint64_t * iSizes,
+                                   const void ** iDatas);
+
+    // seeks to iPos and writes, also safe to call from multiple threads
+    void writeAt(Alembic::Util::uint64_t iPos, const void * iBuf,
+                 Alembic::Util::uint64_t iSize);
+
 private:
     // noncopyable
     OStream(const OStream &);
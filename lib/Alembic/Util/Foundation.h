@@ -93,6 +93,8 @@
 
 // needed for mutex stuff
 #include <Windows.h>
+#else
+#include <pthread.h>
 #endif
 
 #ifndef ALEMBIC_VERSION_NS
@@ -246,6 +248,183 @@ private:
     mutex & m;
 };
 
+// a lock and a condition to wait on while holding it, similar to a
+// boost::mutex and boost::condition_variable used together
+#ifdef _MSC_VER
+
+class monitor : noncopyable
+{
+public:
+    monitor()
+    {
+        InitializeCriticalSection( &m );
+        InitializeConditionVariable( &c );
+    }
+
+    ~monitor()
+    {
+        DeleteCriticalSection( &m );
+    }
+
+    void lock()
+    {
+        EnterCriticalSection( &m );
+    }
+
+    void unlock()
+    {
+        LeaveCriticalSection( &m );
+    }
+
+    // must be called with the monitor locked
+    void wait()
+    {
+        SleepConditionVariableCS( &c, &m, INFINITE );
+    }
+
+    void notify_one()
+    {
+        WakeConditionVariable( &c );
+    }
+
+    void notify_all()
+    {
+        WakeAllConditionVariable( &c );
+    }
+
+private:
+    CRITICAL_SECTION m;
+    CONDITION_VARIABLE c;
+};
+
+#else
+
+class monitor : noncopyable
+{
+public:
+    monitor()
+    {
+        pthread_mutex_init( &m, NULL );
+        pthread_cond_init( &c, NULL );
+    }
+
+    ~monitor()
+    {
+        pthread_cond_destroy( &c );
+        pthread_mutex_destroy( &m );
+    }
+
+    void lock()
+    {
+        pthread_mutex_lock( &m );
+    }
+
+    void unlock()
+    {
+        pthread_mutex_unlock( &m );
+    }
+
+    // must be called with the monitor locked
+    void wait()
+    {
+        pthread_cond_wait( &c, &m );
+    }
+
+    void notify_one()
+    {
+        pthread_cond_signal( &c );
+    }
+
+    void notify_all()
+    {
+        pthread_cond_broadcast( &c );
+    }
+
+private:
+    pthread_mutex_t m;
+    pthread_cond_t c;
+};
+
+#endif
+
+// inspired by boost::thread, runs iFunc( iArg ) as soon as it is made.  If
+// it couldn't be started valid() is false, and the work should be done some
+// other way.  join() must be called on a valid thread before it is
+// destroyed, when called from the thread itself it doesn't wait, the thread
+// is left to finish on its own.
+#ifdef _MSC_VER
+
+class thread : noncopyable
+{
+public:
+    thread( void * ( *iFunc )( void * ), void * iArg )
+      : f( iFunc ), a( iArg )
+    {
+        h = CreateThread( NULL, 0, entry, this, 0, &id );
+    }
+
+    bool valid() const
+    {
+        return h != NULL;
+    }
+
+    void join()
+    {
+        if ( GetCurrentThreadId() != id )
+        {
+            WaitForSingleObject( h, INFINITE );
+        }
+        CloseHandle( h );
+    }
+
+private:
+    static DWORD WINAPI entry( LPVOID iThread )
+    {
+        thread * t = static_cast< thread * >( iThread );
+        t->f( t->a );
+        return 0;
+    }
+
+    void * ( *f )( void * );
+    void * a;
+    HANDLE h;
+    DWORD id;
+};
+
+#else
+
+class thread : noncopyable
+{
+public:
+    thread( void * ( *iFunc )( void * ), void * iArg )
+    {
+        v = ( pthread_create( &t, NULL, iFunc, iArg ) == 0 );
+    }
+
+    bool valid() const
+    {
+        return v;
+    }
+
+    void join()
+    {
+        if ( pthread_equal( pthread_self(), t ) )
+        {
+            pthread_detach( t );
+        }
+        else
+        {
+            pthread_join( t, NULL );
+        }
+    }
+
+private:
+    pthread_t t;
+    bool v;
+};
+
+#endif
+
 } // End namespace ALEMBIC_VERSION_NS
 
 using namespace ALEMBIC_VERSION_NS;
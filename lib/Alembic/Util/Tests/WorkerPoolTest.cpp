@@ -0,0 +1,129 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/Util/WorkerPool.h>
+
+#include <vector>
+#include <assert.h>
+
+namespace AU = Alembic::Util;
+
+//-*****************************************************************************
+struct Counter
+{
+    Counter() : count( 0 ) {}
+
+    AU::mutex lock;
+    int count;
+};
+
+//-*****************************************************************************
+void Count( void * iCounter )
+{
+    Counter & counter = *( static_cast< Counter * >( iCounter ) );
+    AU::scoped_lock l( counter.lock );
+    ++ counter.count;
+}
+
+//-*****************************************************************************
+struct Nested
+{
+    AU::WorkerPool * pool;
+    Counter * counter;
+};
+
+//-*****************************************************************************
+// adds tasks of its own and waits on them from one of the pool's threads
+void CountNested( void * iNested )
+{
+    Nested & nested = *( static_cast< Nested * >( iNested ) );
+    AU::TaskGroup group( *nested.pool );
+    for ( int i = 0; i < 10; ++i )
+    {
+        group.run( Count, nested.counter );
+    }
+    group.wait();
+}
+
+//-*****************************************************************************
+void testRun( std::size_t iNumThreads )
+{
+    AU::WorkerPool pool( iNumThreads );
+    assert( pool.getNumThreads() == iNumThreads );
+
+    Counter counter;
+    {
+        AU::TaskGroup group( pool );
+        for ( int i = 0; i < 1000; ++i )
+        {
+            group.run( Count, &counter );
+        }
+        group.wait();
+        assert( counter.count == 1000 );
+
+        // a group can be used again once waited on
+        group.run( Count, &counter );
+        group.wait();
+        assert( counter.count == 1001 );
+    }
+
+    // more nested groups than threads, which would all be stuck waiting if
+    // the waiting threads didn't run their own tasks
+    counter.count = 0;
+    std::vector< Nested > nested( 16 );
+    AU::TaskGroup group( pool );
+    for ( std::size_t i = 0; i < nested.size(); ++i )
+    {
+        nested[i].pool = &pool;
+        nested[i].counter = &counter;
+        group.run( CountNested, &nested[i] );
+    }
+    group.wait();
+    assert( counter.count == 160 );
+
+    pool.reserve( iNumThreads + 1 );
+    assert( pool.getNumThreads() == iNumThreads + 1 );
+}
+
+//-*****************************************************************************
+int main( int argc, char *argv[] )
+{
+    // without any threads, the tasks are all run by whoever waits
+    testRun( 0 );
+    testRun( 1 );
+    testRun( 4 );
+    return 0;
+}
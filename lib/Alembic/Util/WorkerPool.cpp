@@ -0,0 +1,204 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#include <Alembic/Util/WorkerPool.h>
+
+#include <algorithm>
+
+namespace Alembic {
+namespace Util {
+namespace ALEMBIC_VERSION_NS {
+
+//-*****************************************************************************
+WorkerPool::WorkerPool( std::size_t iNumThreads )
+  : m_stop( false )
+{
+    reserve( iNumThreads );
+}
+
+//-*****************************************************************************
+WorkerPool::~WorkerPool()
+{
+    m_monitor.lock();
+    m_stop = true;
+    m_monitor.notify_all();
+    m_monitor.unlock();
+
+    for ( std::size_t i = 0; i < m_threads.size(); ++i )
+    {
+        m_threads[i]->join();
+        delete m_threads[i];
+    }
+}
+
+//-*****************************************************************************
+void WorkerPool::reserve( std::size_t iNumThreads )
+{
+    m_monitor.lock();
+    while ( m_threads.size() < iNumThreads )
+    {
+        thread * t = new thread( run, this );
+        if ( !t->valid() )
+        {
+            // whoever waits runs the tasks instead
+            delete t;
+            break;
+        }
+        m_threads.push_back( t );
+    }
+    m_monitor.unlock();
+}
+
+//-*****************************************************************************
+std::size_t WorkerPool::getNumThreads()
+{
+    m_monitor.lock();
+    std::size_t numThreads = m_threads.size();
+    m_monitor.unlock();
+    return numThreads;
+}
+
+//-*****************************************************************************
+void * WorkerPool::run( void * iPool )
+{
+    static_cast< WorkerPool * >( iPool )->work();
+    return NULL;
+}
+
+//-*****************************************************************************
+void WorkerPool::work()
+{
+    m_monitor.lock();
+    while ( !m_stop )
+    {
+        if ( !runOne( NULL ) )
+        {
+            m_monitor.wait();
+        }
+    }
+    m_monitor.unlock();
+}
+
+//-*****************************************************************************
+bool WorkerPool::runOne( TaskGroup * iGroup )
+{
+    TaskGroup * group = iGroup;
+    if ( group == NULL )
+    {
+        // the tasks a waiting group ran itself leave their entries behind,
+        // those are skipped
+        while ( !m_queue.empty() && m_queue.front()->m_tasks.empty() )
+        {
+            m_queue.pop_front();
+        }
+
+        if ( m_queue.empty() )
+        {
+            return false;
+        }
+
+        group = m_queue.front();
+        m_queue.pop_front();
+    }
+    else if ( group->m_tasks.empty() )
+    {
+        return false;
+    }
+
+    std::pair< TaskGroup::Task, void * > task = group->m_tasks.front();
+    group->m_tasks.pop_front();
+
+    m_monitor.unlock();
+    task.first( task.second );
+    m_monitor.lock();
+
+    if ( -- group->m_pending == 0 )
+    {
+        m_monitor.notify_all();
+    }
+
+    return true;
+}
+
+//-*****************************************************************************
+TaskGroup::TaskGroup( WorkerPool & iPool )
+  : m_pool( iPool )
+  , m_pending( 0 )
+{
+}
+
+//-*****************************************************************************
+TaskGroup::~TaskGroup()
+{
+    wait();
+}
+
+//-*****************************************************************************
+void TaskGroup::run( Task iTask, void * iArg )
+{
+    m_pool.m_monitor.lock();
+    m_tasks.push_back( std::make_pair( iTask, iArg ) );
+    m_pool.m_queue.push_back( this );
+    ++ m_pending;
+
+    // a waiting group may be woken as well as the threads, so wake them all
+    m_pool.m_monitor.notify_all();
+    m_pool.m_monitor.unlock();
+}
+
+//-*****************************************************************************
+void TaskGroup::wait()
+{
+    m_pool.m_monitor.lock();
+    while ( m_pending > 0 )
+    {
+        // what is left is being run by the pool's threads
+        if ( !m_pool.runOne( this ) )
+        {
+            m_pool.m_monitor.wait();
+        }
+    }
+
+    // the tasks we ran ourselves left their entries in the pool's queue,
+    // which mustn't outlive us
+    m_pool.m_queue.erase( std::remove( m_pool.m_queue.begin(),
+        m_pool.m_queue.end(), this ), m_pool.m_queue.end() );
+    m_pool.m_monitor.unlock();
+}
+
+} // End namespace ALEMBIC_VERSION_NS
+} // End namespace Util
+} // End namespace Alembic
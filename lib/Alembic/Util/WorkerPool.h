@@ -0,0 +1,127 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _Alembic_Util_WorkerPool_h_
+#define _Alembic_Util_WorkerPool_h_
+
+#include <Alembic/Util/Foundation.h>
+
+#include <deque>
+
+namespace Alembic {
+namespace Util {
+namespace ALEMBIC_VERSION_NS {
+
+class TaskGroup;
+
+//-*****************************************************************************
+// A set of threads which are started once and then run tasks from a queue,
+// oldest first, for as long as the pool lives.  Tasks are added through a
+// TaskGroup.  If threads can't be started the tasks are still run, by
+// whoever waits on their group.
+class WorkerPool : noncopyable
+{
+public:
+    explicit WorkerPool( std::size_t iNumThreads = 0 );
+
+    // tasks still queued are dropped, the groups they belong to must have
+    // been waited on already
+    ~WorkerPool();
+
+    // starts more threads until there are at least iNumThreads
+    void reserve( std::size_t iNumThreads );
+
+    std::size_t getNumThreads();
+
+private:
+    friend class TaskGroup;
+
+    static void * run( void * iPool );
+
+    // run by each thread until the pool is destroyed
+    void work();
+
+    // runs the oldest task of iGroup, or of any group when iGroup is NULL,
+    // m_monitor must be held, and is held again on return
+    bool runOne( TaskGroup * iGroup );
+
+    monitor m_monitor;
+    std::vector< thread * > m_threads;
+    bool m_stop;
+
+    // an entry per task added, naming the group it was added to, which is
+    // left behind when the group runs the task itself
+    std::deque< TaskGroup * > m_queue;
+};
+
+//-*****************************************************************************
+// Tasks added to a WorkerPool which are waited on together.  The thread
+// waiting runs the group's queued tasks itself rather than sleeping, so a
+// task may add tasks of its own and wait on them without the pool running
+// out of threads.  A task must not throw, and wait must be called before
+// the group is destroyed.
+class TaskGroup : noncopyable
+{
+public:
+    typedef void ( *Task )( void * );
+
+    explicit TaskGroup( WorkerPool & iPool );
+    ~TaskGroup();
+
+    // queues iTask( iArg ) to be run on one of the pool's threads
+    void run( Task iTask, void * iArg );
+
+    // returns once every task added so far has run
+    void wait();
+
+private:
+    friend class WorkerPool;
+
+    WorkerPool & m_pool;
+
+    // guarded by the pool's monitor
+    std::deque< std::pair< Task, void * > > m_tasks;
+    std::size_t m_pending;
+};
+
+} // End namespace ALEMBIC_VERSION_NS
+
+using namespace ALEMBIC_VERSION_NS;
+
+} // End namespace Util
+} // End namespace Alembic
+
+#endif
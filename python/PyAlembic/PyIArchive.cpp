@@ -35,17 +35,29 @@
 //-*****************************************************************************
 
 #include <Foundation.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
 //-*****************************************************************************
 static Abc::IArchive* mkIArchive( const std::string &iName )
 {
-    Abc::IArchive archive;
+    // Ogawa archives can be opened without holding the GIL, HDF5 ones can't,
+    // so look at which one it is before opening it only as that.
+    AbcF::IFactory::CoreType requested = AbcF::IFactory::getCoreType( iName );
+
     AbcF::IFactory factory;
     factory.setPolicy(Abc::ErrorHandler::kQuietNoopPolicy);
     AbcF::IFactory::CoreType coreType;
-    archive = factory.getArchive(iName, coreType);
+    Abc::IArchive archive;
+    if ( requested == AbcF::IFactory::kOgawa ) {
+        AllowThreads allowThreads;
+        archive = factory.getArchive( iName, requested, coreType );
+    }
+    else {
+        archive = factory.getArchive( iName, requested, coreType );
+    }
+
     if ( coreType == AbcF::IFactory::kUnknown ) {
         throwPythonException( "Unknown core type" );
     }
@@ -38,6 +38,7 @@
 #include <PyIBaseProperty.h>
 #include <PyIPropertyUtil.h>
 #include <PyTypeBindingUtil.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -63,30 +64,29 @@ case TPTraits::pod_enum:                                   \
 }
 
 //-*****************************************************************************
-template<>
-object getValue ( Abc::IArrayProperty &p, 
-                         const Abc::ISampleSelector &iSS,
-                         const ReturnTypeEnum returnType )
+static void checkDataType( Abc::IArrayProperty &p )
 {
-    // Determine the type & extent of the array property and return its value.
     const AbcA::DataType &dt = p.getDataType();
     AbcU::PlainOldDataType pod = dt.getPod();
-    const AbcU::uint8_t extent = dt.getExtent();
-    AbcU::Dimensions dims;
-    p.getDimensions( dims, iSS );
 
     // POD data types
     if( pod < 0 || pod >= AbcU::kNumPlainOldDataTypes )
     {
         std::stringstream stream;
         stream << "ERROR: Unhandled type " << AbcU::PODName (pod)
-               << " with extent " << (int)extent;
+               << " with extent " << (int)dt.getExtent();
         throwPythonException( stream.str().c_str() );
-        return object(); // Returns None object
     }
+}
 
-    AbcA::ArraySamplePtr ptr;
-    p.get( ptr, iSS );
+//-*****************************************************************************
+static object convertSample( Abc::IArrayProperty &p,
+                             AbcA::ArraySamplePtr &ptr )
+{
+    // Determine the type & extent of the array property and return its value.
+    const AbcA::DataType &dt = p.getDataType();
+    AbcU::PlainOldDataType pod = dt.getPod();
+    const AbcU::uint8_t extent = dt.getExtent();
 
     if (extent == 1)
     {
@@ -215,12 +215,63 @@ object getValue ( Abc::IArrayProperty &p,
     return object(); // Returns None object
 }
 
+//-*****************************************************************************
+template<>
+object getValue ( Abc::IArrayProperty &p, 
+                         const Abc::ISampleSelector &iSS,
+                         const ReturnTypeEnum returnType )
+{
+    checkDataType( p );
+
+    AbcA::ArraySamplePtr ptr;
+    {
+        AllowThreads allowThreads( p );
+        p.get( ptr, iSS );
+    }
+
+    return convertSample( p, ptr );
+}
+
+//-*****************************************************************************
+// Reads all of the requested samples with the GIL released, and only then
+// converts them, so a whole batch costs a single trip through Python.
+static list getSamples( Abc::IArrayProperty &p, object iIndices )
+{
+    checkDataType( p );
+
+    std::vector<AbcA::index_t> indices;
+    stl_input_iterator<AbcA::index_t> it( iIndices ), end;
+    for ( ; it != end; ++it )
+    {
+        indices.push_back( *it );
+    }
+
+    std::vector<AbcA::ArraySamplePtr> samples( indices.size() );
+    {
+        AllowThreads allowThreads( p );
+        for ( size_t i = 0; i < indices.size(); ++i )
+        {
+            p.get( samples[i], Abc::ISampleSelector( indices[i] ) );
+        }
+    }
+
+    list ret;
+    for ( size_t i = 0; i < samples.size(); ++i )
+    {
+        ret.append( convertSample( p, samples[i] ) );
+    }
+    return ret;
+}
+
 //-*****************************************************************************
 static object getDimension( Abc::IArrayProperty& p, 
                             const Abc::ISampleSelector& iSS )
 {
     AbcU::Dimensions oDim;
-    p.getDimensions( oDim, iSS );
+    {
+        AllowThreads allowThreads( p );
+        p.getDimensions( oDim, iSS );
+    }
 
     return_by_value::apply<AbcU::Dimensions>::type converter;
 
@@ -232,7 +283,12 @@ static std::string getKey( Abc::IArrayProperty &p,
                            const Abc::ISampleSelector &iSS )
 {
     AbcA::ArraySampleKey oKey;
-    if ( p.getKey( oKey, iSS ) ) {
+    bool found = false;
+    {
+        AllowThreads allowThreads( p );
+        found = p.getKey( oKey, iSS );
+    }
+    if ( found ) {
         return oKey.digest.str();
     };
     return std::string();
@@ -309,6 +365,11 @@ void register_iarrayproperty()
               Overloads::getAllValue,
               ( arg( "iSS" ) = Abc::ISampleSelector() ),
               "Return the sample with the given ISampleSelector" )
+        .def( "getSamples",
+              &getSamples,
+              ( arg( "indices" ) ),
+              "Return a list of the samples at the given indices, reading "
+              "them all in one call" )
         .def( "getDimension", &getDimension )
         .def( "getParent",
               &Abc::IArrayProperty::getParent,
@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyISchemaObject.h>
 #include <PyISchema.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -82,7 +83,8 @@ void register_icamera()
         .def( "getChildBoundsProperty",
               &AbcG::ICameraSchema::getChildBoundsProperty )
         .def( "getValue", 
-              &AbcG::ICameraSchema::getValue,
+              &getSchemaValue<AbcG::ICameraSchema,
+                              AbcG::CameraSample>,
               ( arg( "iSS" ) = Abc::ISampleSelector() ) )
         .def( "valid", &AbcG::ICameraSchema::valid )
         .def( "reset", &AbcG::ICameraSchema::reset )
@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyISchemaObject.h>
 #include <PyIGeomBaseSchema.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -86,7 +87,8 @@ void register_icurves()
               &AbcG::ICurvesSchema::get,
               ( arg( "sample" ), arg( "iSS" ) = Abc::ISampleSelector() ) )
         .def( "getValue",
-              &AbcG::ICurvesSchema::getValue,
+              &getSchemaValue<AbcG::ICurvesSchema,
+                              AbcG::ICurvesSchema::Sample>,
               ( arg( "iSampSelector" ) = Abc::ISampleSelector() ) )
         .def( "getVelocitiesProperty",
               &AbcG::ICurvesSchema::getVelocitiesProperty )
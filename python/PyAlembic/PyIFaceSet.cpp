@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyISchemaObject.h>
 #include <PyIGeomBaseSchema.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -78,7 +79,8 @@ void register_ifaceset()
         .def( "getNumSamples",
               &AbcG::IFaceSetSchema::getNumSamples )
         .def( "getValue",
-              &AbcG::IFaceSetSchema::getValue,
+              &getSchemaValue<AbcG::IFaceSetSchema,
+                              AbcG::IFaceSetSchema::Sample>,
               ( arg( "iSS" ) = Abc::ISampleSelector() ) )
         .def( "getFaceExclusivity",
               &AbcG::IFaceSetSchema::getFaceExclusivity )
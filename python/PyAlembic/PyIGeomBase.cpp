@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyISchemaObject.h>
 #include <PyIGeomBaseSchema.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -97,7 +98,8 @@ void register_igeombase()
               &AbcG::IGeomBase::get,
               ( arg( "oSample" ), arg( "iSS" ) = Abc::ISampleSelector() ) )
         .def( "getValue",
-              &AbcG::IGeomBase::getValue,
+              &getSchemaValue<AbcG::IGeomBase,
+                              AbcG::IGeomBase::Sample>,
               ( arg( "iSS" ) = Abc::ISampleSelector() ) )
         .def( "getArbGeomParams",
               &AbcG::IGeomBase::getArbGeomParams )
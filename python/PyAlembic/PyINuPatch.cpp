@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyISchemaObject.h>
 #include <PyIGeomBaseSchema.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -86,7 +87,8 @@ void register_inupatch()
               &AbcG::INuPatchSchema::get,
               ( arg( "sample" ), arg( "iSS" ) = Abc::ISampleSelector() ) )
         .def( "getValue",
-              &AbcG::INuPatchSchema::getValue,
+              &getSchemaValue<AbcG::INuPatchSchema,
+                              AbcG::INuPatchSchema::Sample>,
               ( arg( "iSampSelector" ) = Abc::ISampleSelector() ) )
         .def( "getPositionsProperty",
               &AbcG::INuPatchSchema::getPositionsProperty )
@@ -38,6 +38,7 @@
 #include <PyISchema.h>
 #include <PyIGeomBaseSchema.h>
 #include <PyISchemaObject.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -84,7 +85,8 @@ void register_ipoints()
         .def( "getWidthsParam",
               &AbcG::IPointsSchema::getWidthsParam )
         .def( "getValue",
-              &AbcG::IPointsSchema::getValue,
+              &getSchemaValue<AbcG::IPointsSchema,
+                              AbcG::IPointsSchema::Sample>,
               ( arg( "iSS" ) = Abc::ISampleSelector() ) )
         .def( "getTimeSampling",
               &AbcG::IPointsSchema::getTimeSampling )
@@ -38,6 +38,7 @@
 #include <PyISchemaObject.h>
 #include <PyIGeomBaseSchema.h>
 #include <PyImathStringArray.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -104,7 +105,8 @@ void register_ipolymesh()
         .def( "getTimeSampling",
               &AbcG::IPolyMeshSchema::getTimeSampling )
         .def( "getValue",
-              &AbcG::IPolyMeshSchema::getValue,
+              &getSchemaValue<AbcG::IPolyMeshSchema,
+                              AbcG::IPolyMeshSchema::Sample>,
               ( arg( "iSampSelector" ) = Abc::ISampleSelector() ) )
         .def( "getUVsParam",
               &AbcG::IPolyMeshSchema::getUVsParam )
@@ -38,6 +38,7 @@
 #include <PyIBaseProperty.h>
 #include <PyIPropertyUtil.h>
 #include <PyTypeBindingTraits.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -52,7 +53,10 @@ static object getPODValue( Abc::IScalarProperty &p,
 
     // Return the scalar property's value of type T.
     U val;
-    p.get( reinterpret_cast<void*>( &val ), iSS );
+    {
+        AllowThreads allowThreads( p );
+        p.get( reinterpret_cast<void*>( &val ), iSS );
+    }
 
     typename return_by_value::apply<T>::type converter;
 
@@ -73,7 +77,10 @@ static object getSmallArrayValue( Abc::IScalarProperty &p,
     AbcU::Dimensions dims( iExtent );
     AbcA::ArraySamplePtr sampPtr =
         AbcA::AllocateArraySample( TPTraits::dataType(), dims );
-    p.get( const_cast<void*>( sampPtr->getData() ), iSS );
+    {
+        AllowThreads allowThreads( p );
+        p.get( const_cast<void*>( sampPtr->getData() ), iSS );
+    }
 
     samp_ptr_type typedSampPtr =
         AbcU::static_pointer_cast<samp_type>( sampPtr ); 
@@ -296,6 +303,21 @@ void register_iscalarproperty()
             return getValue<Abc::IScalarProperty>( iProp, iSS, kReturnArray );
         }
 
+        // Scalar samples are small enough that the read itself is what
+        // matters, so each one still drops the GIL on its own.
+        static list getSamples( Abc::IScalarProperty& iProp,
+                                object iIndices )
+        {
+            list ret;
+            stl_input_iterator<AbcA::index_t> it( iIndices ), end;
+            for ( ; it != end; ++it )
+            {
+                ret.append( getValue<Abc::IScalarProperty>( iProp, *it,
+                                                            kReturnAll ) );
+            }
+            return ret;
+        }
+
         static SampleList<Abc::IScalarProperty>
         getAllSampleList( Abc::IScalarProperty& iProp )
         {
@@ -352,6 +374,10 @@ void register_iscalarproperty()
               Overloads::getArrayValue,
               ( arg( "iSS" ) = Abc::ISampleSelector() ),
               "Return the array sample with the given ISampleSelector" )
+        .def( "getSamples",
+              Overloads::getSamples,
+              ( arg( "indices" ) ),
+              "Return a list of the samples at the given indices" )
         .add_property( "samples", Overloads::getAllSampleList )
         .add_property( "scalarSamples", Overloads::getScalarSampleList )
         .add_property( "arraySamples", Overloads::getArraySampleList )
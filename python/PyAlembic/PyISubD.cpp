@@ -38,6 +38,7 @@
 #include <PyISchemaObject.h>
 #include <PyIGeomBaseSchema.h>
 #include <PyImathStringArray.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -102,7 +103,8 @@ void register_isubd()
         .def( "getTimeSampling",
               &AbcG::ISubDSchema::getTimeSampling )
         .def( "getValue",
-              &AbcG::ISubDSchema::getValue,
+              &getSchemaValue<AbcG::ISubDSchema,
+                              AbcG::ISubDSchema::Sample>,
               ( arg( "iSS" ) = Abc::ISampleSelector() ) )
         .def( "getFaceCountsProperty",
               &AbcG::ISubDSchema::getFaceCountsProperty )
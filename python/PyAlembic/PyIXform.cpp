@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyISchema.h>
 #include <PyISchemaObject.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -81,7 +82,8 @@ void register_ixform()
         .def( "getNumSamples",
               &AbcG::IXformSchema::getNumSamples )
         .def( "getValue",
-              &AbcG::IXformSchema::getValue,
+              &getSchemaValue<AbcG::IXformSchema,
+                              AbcG::XformSample>,
               ( arg( "iSS" ) = Abc::ISampleSelector() ) )
         .def( "getChildBoundsProperty",
               &AbcG::IXformSchema::getChildBoundsProperty )
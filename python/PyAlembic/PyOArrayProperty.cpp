@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyOBaseProperty.h>
 #include <PyTypeBindingTraits.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -48,16 +49,29 @@ case TPTraits::pod_enum:                                        \
     typedef AbcU::shared_ptr<samp_type>     samp_ptr_type;      \
     if ( TypeBindingTraits<TPTraits>::memCopyable )             \
     {                                                           \
-        iProp.set( extract<samp_type>( iFixedArray ) );         \
+        samp_type samp = extract<samp_type>( iFixedArray );     \
+        AllowThreads allowThreads( iProp );                     \
+        iProp.set( samp );                                      \
     }                                                           \
     else                                                        \
     {                                                           \
        samp_ptr_type sampPtr = extract<samp_ptr_type> ( iFixedArray ); \
+       AllowThreads allowThreads( iProp );                      \
        iProp.set( *sampPtr );                                   \
     }                                                           \
     return;                                                     \
 }
 
+//-*****************************************************************************
+template<class TPTraits>
+static void setInterpretedArrayValue( Abc::OArrayProperty &p, PyObject *val )
+{
+    Abc::TypedArraySample<TPTraits> samp =
+        extract<Abc::TypedArraySample<TPTraits> >( val );
+    AllowThreads allowThreads( p );
+    p.set( samp );
+}
+
 //-*****************************************************************************
 static void setArrayValue( Abc::OArrayProperty &p, PyObject *val )
 {
@@ -123,12 +137,12 @@ static void setArrayValue( Abc::OArrayProperty &p, PyObject *val )
                 std::string interp (p.getMetaData().get ("interpretation"));
                 if (!interp.compare (Abc::C3fTPTraits::interpretation()))
                 {
-                    p.set( extract<Abc::TypedArraySample<Abc::C3fTPTraits> >( val ) );
+                    setInterpretedArrayValue<Abc::C3fTPTraits>( p, val );
                     return;
                 }
                 else
                 {
-                    p.set( extract<Abc::TypedArraySample<Abc::V3fTPTraits> >( val ) );
+                    setInterpretedArrayValue<Abc::V3fTPTraits>( p, val );
                     return;
                 }
             }
@@ -149,17 +163,17 @@ static void setArrayValue( Abc::OArrayProperty &p, PyObject *val )
                 std::string interp (p.getMetaData().get ("interpretation"));
                 if (!interp.compare (Abc::C4fTPTraits::interpretation()))
                 {
-                    p.set( extract<Abc::TypedArraySample<Abc::C4fTPTraits> >( val ) );
+                    setInterpretedArrayValue<Abc::C4fTPTraits>( p, val );
                     return;
                 }
                 else if (!interp.compare (Abc::QuatfTPTraits::interpretation()))
                 {
-                    p.set( extract<Abc::TypedArraySample<Abc::QuatfTPTraits> >( val ) );
+                    setInterpretedArrayValue<Abc::QuatfTPTraits>( p, val );
                     return;
                 }
                 else if (!interp.compare (Abc::Box2fTPTraits::interpretation()))
                 {
-                    p.set( extract<Abc::TypedArraySample<Abc::Box2fTPTraits> >( val ) );
+                    setInterpretedArrayValue<Abc::Box2fTPTraits>( p, val );
                     return;
                 }
             }
@@ -168,12 +182,12 @@ static void setArrayValue( Abc::OArrayProperty &p, PyObject *val )
                 std::string interp (p.getMetaData().get ("interpretation"));
                 if (!interp.compare (Abc::QuatdTPTraits::interpretation()))
                 {
-                    p.set( extract<Abc::TypedArraySample<Abc::QuatdTPTraits> >( val ) );
+                    setInterpretedArrayValue<Abc::QuatdTPTraits>( p, val );
                     return;
                 }
                 else if (!interp.compare (Abc::Box2dTPTraits::interpretation()))
                 {
-                    p.set( extract<Abc::TypedArraySample<Abc::Box2dTPTraits> >( val ) );
+                    setInterpretedArrayValue<Abc::Box2dTPTraits>( p, val );
                     return;
                 }
             }
@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyOSchemaObject.h>
 #include <PyOGeomBaseSchema.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -92,7 +93,8 @@ void register_ocamera()
         .def( "getChildBoundsProperty",
               &AbcG::OCameraSchema::getChildBoundsProperty )
         .def( "set",
-              &AbcG::OCameraSchema::set,
+              &setSchemaValue<AbcG::OCameraSchema,
+                              const AbcG::CameraSample>,
               ( arg( "iSamp" ) ) )
         .def( "setFromPrevious",
               &AbcG::OCameraSchema::setFromPrevious )
@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyOSchemaObject.h>
 #include <PyOGeomBaseSchema.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -81,7 +82,8 @@ void register_ocurves()
         .def( "getNumSamples",
               &AbcG::OCurvesSchema::getNumSamples )
         .def( "set",
-              &AbcG::OCurvesSchema::set,
+              &setSchemaValue<AbcG::OCurvesSchema,
+                              const AbcG::OCurvesSchema::Sample>,
               ( arg( "iSamp" ) ) )
         .def( "setFromPrevious",
               &AbcG::OCurvesSchema::setFromPrevious )
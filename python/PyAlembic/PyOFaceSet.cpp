@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyOSchemaObject.h>
 #include <PyOGeomBaseSchema.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -86,7 +87,8 @@ void register_ofaceset()
         .def( "getNumSamples",
               &AbcG::OFaceSetSchema::getNumSamples )
         .def( "set",
-              &AbcG::OFaceSetSchema::set,
+              &setSchemaValue<AbcG::OFaceSetSchema,
+                              const AbcG::OFaceSetSchema::Sample>,
               ( arg( "iSamp" ) ) )
         .def( "setTimeSampling",
               setTimeSamplingByIndex,
@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyOSchemaObject.h>
 #include <PyOGeomBaseSchema.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -81,7 +82,8 @@ void register_onupatch()
         .def( "getNumSamples",
               &AbcG::ONuPatchSchema::getNumSamples )
         .def( "set",
-              &AbcG::ONuPatchSchema::set,
+              &setSchemaValue<AbcG::ONuPatchSchema,
+                              const AbcG::ONuPatchSchema::Sample>,
               ( arg( "iSamp" ) ) )
         .def( "setFromPrevious",
               &AbcG::ONuPatchSchema::setFromPrevious )
@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyOGeomBaseSchema.h>
 #include <PyOSchemaObject.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -103,6 +104,7 @@ void register_opoints()
 
             samp.setSelfBounds( iSamp.getSelfBounds() );
 
+            AllowThreads allowThreads( iSchema );
             iSchema.set( samp );
         }
     };
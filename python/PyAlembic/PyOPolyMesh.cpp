@@ -38,6 +38,7 @@
 #include <PyOSchemaObject.h>
 #include <PyOGeomBaseSchema.h>
 #include <PyImathStringArray.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -107,7 +108,8 @@ void register_opolymesh()
         .def( "getNumSamples",
               &AbcG::OPolyMeshSchema::getNumSamples )
         .def( "set",
-              &AbcG::OPolyMeshSchema::set,
+              &setSchemaValue<AbcG::OPolyMeshSchema,
+                              const AbcG::OPolyMeshSchema::Sample>,
               ( arg( "iSamp" ) ) )
         .def( "setFromPrevious",
               &AbcG::OPolyMeshSchema::setFromPrevious )
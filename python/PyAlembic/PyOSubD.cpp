@@ -38,6 +38,7 @@
 #include <PyOSchemaObject.h>
 #include <PyOGeomBaseSchema.h>
 #include <PyImathStringArray.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -108,7 +109,8 @@ void register_osubd()
         .def( "getNumSamples",
               &AbcG::OSubDSchema::getNumSamples )
         .def( "set",
-              &AbcG::OSubDSchema::set,
+              &setSchemaValue<AbcG::OSubDSchema,
+                              const AbcG::OSubDSchema::Sample>,
               ( arg( "iSamp" ) ) )
         .def( "setFromPrevious",
               &AbcG::OSubDSchema::setFromPrevious )
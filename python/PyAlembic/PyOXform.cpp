@@ -37,6 +37,7 @@
 #include <Foundation.h>
 #include <PyOSchema.h>
 #include <PyOSchemaObject.h>
+#include <PyThreadUtil.h>
 
 using namespace boost::python;
 
@@ -89,7 +90,8 @@ void register_oxform()
               &AbcG::OXformSchema::getNumSamples,
               "Return the number of samples contained in this object" )
         .def( "set",
-              &AbcG::OXformSchema::set,
+              &setSchemaValue<AbcG::OXformSchema,
+                              AbcG::XformSample>,
               ( arg( "sample" ) ) )
         .def( "setFromPrevious",
               &AbcG::OXformSchema::setFromPrevious )
@@ -0,0 +1,119 @@
+//-*****************************************************************************
+//
+// Copyright (c) 2013,
+//  Sony Pictures Imageworks Inc. and
+//  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are
+// met:
+// *       Redistributions of source code must retain the above copyright
+// notice, this list of conditions and the following disclaimer.
+// *       Redistributions in binary form must reproduce the above
+// copyright notice, this list of conditions and the following disclaimer
+// in the documentation and/or other materials provided with the
+// distribution.
+// *       Neither the name of Sony Pictures Imageworks, nor
+// Industrial Light & Magic, nor the names of their contributors may be used
+// to endorse or promote products derived from this software without specific
+// prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+// "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+// LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+// A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+// OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+// LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//-*****************************************************************************
+
+#ifndef _PyAlembic_PyThreadUtil_h_
+#define _PyAlembic_PyThreadUtil_h_
+
+#include <Foundation.h>
+
+//-*****************************************************************************
+// Archives which aren't reentrant (HDF5 ones) keep holding the GIL, which is
+// what serializes calls into their core.  That includes HDF5 reads even
+// though AbcCoreHDF5 locks them against each other: its writes don't take
+// that lock, so a read let go of the GIL could run inside HDF5 alongside a
+// write from another thread.
+inline bool canReleaseGIL( const AbcA::ArchiveReaderPtr &iArchive )
+{
+    return iArchive && iArchive->isReentrant();
+}
+
+inline bool canReleaseGIL( const AbcA::ArchiveWriterPtr &iArchive )
+{
+    return iArchive && iArchive->isReentrant();
+}
+
+//-*****************************************************************************
+//
+// AllowThreads
+//
+// Releases the GIL for its lifetime so that other Python threads can run
+// while we are reading from or writing to an archive.  It must not outlive
+// the scope that touches nothing but C++ data, and any Python objects we
+// read from (like the arrays that back a sample being written) have to be
+// converted before it is constructed.
+//
+class AllowThreads : AbcU::noncopyable
+{
+public:
+    explicit AllowThreads( bool iRelease = true )
+        : _state( iRelease ? PyEval_SaveThread() : NULL ) {}
+
+    explicit AllowThreads( Abc::IArchive &iArchive )
+        : _state( iArchive.valid() && canReleaseGIL( iArchive.getPtr() ) ?
+                  PyEval_SaveThread() : NULL ) {}
+
+    explicit AllowThreads( Abc::OArchive &iArchive )
+        : _state( iArchive.valid() && canReleaseGIL( iArchive.getPtr() ) ?
+                  PyEval_SaveThread() : NULL ) {}
+
+    //! Works for any reader or writer property (including schemas), the
+    //! archive it belongs to decides whether the GIL can be released.
+    template <class PROP>
+    explicit AllowThreads( const PROP &iProp )
+        : _state( iProp.valid() &&
+                  canReleaseGIL( iProp.getPtr()->getObject()->getArchive() ) ?
+                  PyEval_SaveThread() : NULL ) {}
+
+    ~AllowThreads()
+    {
+        if ( _state )
+        {
+            PyEval_RestoreThread( _state );
+        }
+    }
+
+private:
+    PyThreadState *_state;
+};
+
+//-*****************************************************************************
+// Stand-ins for SCHEMA::getValue and SCHEMA::set that don't hold the GIL
+// while the sample is read or written.
+template <class SCHEMA, class SAMPLE>
+SAMPLE getSchemaValue( SCHEMA &iSchema, const Abc::ISampleSelector &iSS )
+{
+    AllowThreads allowThreads( iSchema );
+    return iSchema.getValue( iSS );
+}
+
+template <class SCHEMA, class SAMPLE>
+void setSchemaValue( SCHEMA &iSchema, SAMPLE &iSamp )
+{
+    AllowThreads allowThreads( iSchema );
+    iSchema.set( iSamp );
+}
+
+#endif
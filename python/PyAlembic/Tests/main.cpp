@@ -98,6 +98,14 @@ runTests (int argc, char *argv[])
 
         PyRun_SimpleString (code.c_str());
     }
+
+    // Test 7: Reading from several Python threads at once
+    {
+        std::string code =
+            "import testThreads\n";
+
+        PyRun_SimpleString (code.c_str());
+    }
   
     Py_Finalize();
 }
@@ -0,0 +1,124 @@
+#-******************************************************************************
+#
+# Copyright (c) 2013,
+#  Sony Pictures Imageworks Inc. and
+#  Industrial Light & Magic, a division of Lucasfilm Entertainment Company Ltd.
+#
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met:
+# *       Redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer.
+# *       Redistributions in binary form must reproduce the above
+# copyright notice, this list of conditions and the following disclaimer
+# in the documentation and/or other materials provided with the
+# distribution.
+# *       Neither the name of Sony Pictures Imageworks, nor
+# Industrial Light & Magic, nor the names of their contributors may be used
+# to endorse or promote products derived from this software without specific
+# prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#-******************************************************************************
+
+import threading
+from imath import *
+from alembic.Abc import *
+from alembic.AbcGeom import *
+
+testList = []
+
+numSamples = 32
+numPoints = 1000
+
+def threadsOut(filename):
+    """write out an archive with an animated points object"""
+
+    # only Ogawa archives are read without holding the GIL
+    archive = OArchive(filename, asOgawa = True)
+    ptsObj = OPoints(archive.getTop(), "somePoints")
+
+    positions = V3fArray(numPoints)
+    ids = IntArray(numPoints)
+
+    for i in range(numSamples):
+        for j in range(numPoints):
+            positions[j] = V3f(i, j, 0)
+            ids[j] = i * numPoints + j
+
+        psamp = OPointsSchemaSample()
+        psamp.setPositions(positions)
+        psamp.setIds(ids)
+        ptsObj.getSchema().set(psamp)
+
+def readSamples(filename, results, index):
+    """read every sample of the points from a worker thread"""
+
+    archive = IArchive(filename)
+    points = IPoints(archive.getTop(), "somePoints")
+    schema = points.getSchema()
+
+    ids = schema.getIdsProperty()
+    samps = ids.getSamples(range(numSamples))
+
+    ok = len(samps) == numSamples
+    for i in range(numSamples):
+        ok = ok and samps[i][numPoints - 1] == i * numPoints + numPoints - 1
+        pos = schema.getValue(ISampleSelector(i)).getPositions()
+        ok = ok and pos[numPoints - 1] == V3f(i, numPoints - 1, 0)
+
+    results[index] = ok
+
+def testThreads():
+    filename = 'threads.abc'
+    threadsOut(filename)
+
+    numThreads = 4
+    results = [False] * numThreads
+    threads = [threading.Thread(target = readSamples,
+                                args = (filename, results, i))
+               for i in range(numThreads)]
+
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    assert results == [True] * numThreads
+
+    # a batched read returns the same thing as reading one at a time
+    archive = IArchive(filename)
+    points = IPoints(archive.getTop(), "somePoints")
+    ids = points.getSchema().getIdsProperty()
+    batch = ids.getSamples([3, 1, 3])
+    assert len(batch) == 3
+    assert batch[0][0] == ids.getValue(3)[0]
+    assert batch[1][0] == ids.getValue(1)[0]
+    assert batch[2][0] == batch[0][0]
+
+testList.append(('testThreads', testThreads))
+
+# -------------------------------------------------------------------------
+# Main loop
+
+for test in testList:
+    funcName = test[0]
+    print ""
+    print "Running %s" % funcName
+    test[1]()
+    print "passed"
+
+print ""